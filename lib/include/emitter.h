@@ -0,0 +1,160 @@
+/*
+Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef LIB_INCLUDE_EMITTER_H_
+#define LIB_INCLUDE_EMITTER_H_
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+//  CodeEmitter collects the source text of generated kernels. The text is
+//  appended to one buffer, reserved up front and grown geometrically, and
+//  integers and floating point constants are formatted in place, so emitting
+//  a kernel allocates once per growth of the buffer rather than once per
+//  number. operator<< takes text, characters, integers in decimal,
+//  doubles in the %.16e form of FloatToStr() and floats in the %g form of
+//  std::ostream; operator+= takes text only, as std::string does
+class CodeEmitter {
+ public:
+  // Large enough for most kernels of a single pass
+  static const size_t kDefaultCapacity = 16384;
+
+  // Longest text an integer or a double formats to, terminator included
+  static const size_t kNumberChars = 32;
+
+  explicit CodeEmitter(size_t capacity = kDefaultCapacity) {
+    text.reserve(capacity);
+  }
+
+  CodeEmitter& operator<<(const std::string& s) {
+    text.append(s);
+    return *this;
+  }
+
+  CodeEmitter& operator<<(const char* s) {
+    text.append(s);
+    return *this;
+  }
+
+  CodeEmitter& operator<<(char c) {
+    text.push_back(c);
+    return *this;
+  }
+
+  CodeEmitter& operator<<(int v) { return Signed(v); }
+
+  CodeEmitter& operator<<(long v) { return Signed(v); }
+
+  CodeEmitter& operator<<(long long v) { return Signed(v); }
+
+  CodeEmitter& operator<<(unsigned v) { return Unsigned(v); }
+
+  CodeEmitter& operator<<(unsigned long v) { return Unsigned(v); }
+
+  CodeEmitter& operator<<(unsigned long long v) { return Unsigned(v); }
+
+  CodeEmitter& operator<<(double v) {
+    char digits[kNumberChars];
+    text.append(digits, FormatDouble(v, digits));
+    return *this;
+  }
+
+  // floats as a default std::ostream writes them, %g, for the expressions
+  // of the transpose generators
+  CodeEmitter& operator<<(float v) {
+    char digits[kNumberChars];
+    int count = snprintf(digits, kNumberChars, "%g", v);
+    text.append(digits, (count < 0) ? 0 : static_cast<size_t>(count));
+    return *this;
+  }
+
+  CodeEmitter& operator+=(const std::string& s) { return *this << s; }
+
+  CodeEmitter& operator+=(const char* s) { return *this << s; }
+
+  CodeEmitter& operator+=(char c) { return *this << c; }
+
+  // count spaces, the std::setw(count) << "" of stream based generators
+  CodeEmitter& Indent(size_t count) {
+    text.append(count, ' ');
+    return *this;
+  }
+
+  // count tabs
+  CodeEmitter& Tabs(size_t count) {
+    text.append(count, '\t');
+    return *this;
+  }
+
+  const std::string& str() const { return text; }
+
+  size_t size() const { return text.size(); }
+
+  bool empty() const { return text.empty(); }
+
+  void clear() { text.clear(); }
+
+  // Writes the decimal digits of v to digits and returns their count
+  static size_t FormatUnsigned(unsigned long long v, char* digits) {
+    char reversed[kNumberChars];
+    size_t count = 0;
+
+    do {
+      reversed[count++] = static_cast<char>('0' + v % 10);
+      v /= 10;
+    } while (v != 0);
+
+    for (size_t i = 0; i < count; i++) {
+      digits[i] = reversed[count - 1 - i];
+    }
+
+    return count;
+  }
+
+  // Writes v as %.16e to digits and returns the length
+  static size_t FormatDouble(double v, char* digits) {
+    int count = snprintf(digits, kNumberChars, "%.16e", v);
+    return (count < 0) ? 0 : static_cast<size_t>(count);
+  }
+
+ private:
+  std::string text;
+
+  CodeEmitter& Signed(long long v) {
+    if (v < 0) {
+      text.push_back('-');
+      // negate in unsigned arithmetic, which is defined for the minimum
+      return Unsigned(0ULL - static_cast<unsigned long long>(v));
+    }
+
+    return Unsigned(static_cast<unsigned long long>(v));
+  }
+
+  CodeEmitter& Unsigned(unsigned long long v) {
+    char digits[kNumberChars];
+    text.append(digits, FormatUnsigned(v, digits));
+    return *this;
+  }
+};
+
+#endif  // LIB_INCLUDE_EMITTER_H_
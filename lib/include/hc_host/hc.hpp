@@ -0,0 +1,715 @@
+/*
+Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+//  Host emulation of the part of hc that hcFFT and its generated kernels use,
+//  so that both build with a plain host compiler and run on the CPU.
+//
+//  parallel_for_each hands the tiles of a launch to a pool of threads. The
+//  work-items of a tile run as fibers of one thread: a barrier switches to the
+//  next work-item of the tile, and the tile moves past the barrier once every
+//  work-item has reached it. tile_static variables are thread local, so all
+//  the work-items of a tile, and only they, share them.
+//
+//  Accelerators, views and am_alloc memory all live in host memory; copies
+//  are memcpy and complete before they return.
+
+#ifndef LIB_INCLUDE_HC_HOST_HC_HPP_
+#define LIB_INCLUDE_HC_HOST_HC_HPP_
+
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <unistd.h>
+#if !defined(__x86_64__)
+#include <ucontext.h>
+#endif
+#if defined(__SANITIZE_ADDRESS__)
+#include <sanitizer/asan_interface.h>
+#endif
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "./hc_short_vector.hpp"
+
+// Sources built against the emulation test this to tell it from hcc
+#define HC_HOST_EMULATION 1
+
+// Memory shared by the work-items of a tile
+#define tile_static static thread_local
+
+// hcc features hcFFT checks for
+#ifndef __has_feature
+#define __has_feature(x) HC_HOST_FEATURE_##x
+#define HC_HOST_FEATURE_cxx_thread_local 1
+#endif
+
+// hcc's half precision storage type
+#if !defined(__clang__)
+typedef _Float16 __fp16;
+#endif
+
+namespace hc {
+
+class accelerator_view;
+
+class completion_future {
+ public:
+  // Emulated copies and launches have finished when they return
+  void wait() const {}
+  bool is_ready() const { return true; }
+};
+
+class accelerator {
+ public:
+  // The default accelerator is the emulated device
+  accelerator() : device(kDevice) {}
+
+  // The CPU accelerator first, as hcc lists it, then the emulated device
+  static std::vector<accelerator> get_all() {
+    std::vector<accelerator> accs;
+    accs.push_back(accelerator(kCPU));
+    accs.push_back(accelerator(kDevice));
+    return accs;
+  }
+
+  accelerator_view get_default_view() const;
+  accelerator_view create_view() const;
+  bool get_is_emulated() const { return device == kCPU; }
+
+  // Host memory in KB
+  size_t get_dedicated_memory() const {
+    return (size_t)sysconf(_SC_PHYS_PAGES) / 1024 *
+           (size_t)sysconf(_SC_PAGE_SIZE);
+  }
+
+  std::wstring get_description() const {
+    return device == kCPU ? L"CPU" : L"hc host emulation";
+  }
+
+  std::wstring get_device_path() const {
+    return device == kCPU ? L"cpu" : L"host";
+  }
+
+  bool operator==(const accelerator& other) const {
+    return device == other.device;
+  }
+
+  bool operator!=(const accelerator& other) const {
+    return device != other.device;
+  }
+
+ private:
+  enum { kCPU = 0, kDevice = 1 };
+
+  explicit accelerator(int deviceVal) : device(deviceVal) {}
+
+  int device;
+};
+
+class accelerator_view {
+ public:
+  explicit accelerator_view(const accelerator& accVal) : acc(accVal) {}
+
+  accelerator get_accelerator() const { return acc; }
+  void wait() const {}
+
+  void copy(const void* src, void* dst, size_t sizeBytes) const {
+    memmove(dst, src, sizeBytes);
+  }
+
+  completion_future copy_async(const void* src, void* dst,
+                               size_t sizeBytes) const {
+    copy(src, dst, sizeBytes);
+    return completion_future();
+  }
+
+  bool operator==(const accelerator_view& other) const {
+    return acc == other.acc;
+  }
+
+ private:
+  accelerator acc;
+};
+
+inline accelerator_view accelerator::get_default_view() const {
+  return accelerator_view(*this);
+}
+
+inline accelerator_view accelerator::create_view() const {
+  return accelerator_view(*this);
+}
+
+template <int N>
+class index {
+ public:
+  index() { std::fill(v, v + N, 0); }
+
+  explicit index(int i0) {
+    static_assert(N == 1, "index<N> takes N components");
+    v[0] = i0;
+  }
+
+  index(int i0, int i1) {
+    static_assert(N == 2, "index<N> takes N components");
+    v[0] = i0;
+    v[1] = i1;
+  }
+
+  index(int i0, int i1, int i2) {
+    static_assert(N == 3, "index<N> takes N components");
+    v[0] = i0;
+    v[1] = i1;
+    v[2] = i2;
+  }
+
+  explicit index(const int* components) {
+    std::copy(components, components + N, v);
+  }
+
+  int operator[](int d) const { return v[d]; }
+  int& operator[](int d) { return v[d]; }
+
+ private:
+  int v[N];
+};
+
+template <int N>
+class tiled_extent;
+
+template <int N>
+class extent : public index<N> {
+ public:
+  extent() {}
+  explicit extent(int e0) : index<N>(e0) {}
+  extent(int e0, int e1) : index<N>(e0, e1) {}
+  extent(int e0, int e1, int e2) : index<N>(e0, e1, e2) {}
+  explicit extent(const int* components) : index<N>(components) {}
+
+  size_t size() const {
+    size_t n = 1;
+
+    for (int d = 0; d < N; d++) {
+      n *= (*this)[d];
+    }
+
+    return n;
+  }
+
+  tiled_extent<N> tile(int t0) const {
+    return tiled_extent<N>(*this, extent<N>(t0));
+  }
+
+  tiled_extent<N> tile(int t0, int t1) const {
+    return tiled_extent<N>(*this, extent<N>(t0, t1));
+  }
+
+  tiled_extent<N> tile(int t0, int t1, int t2) const {
+    return tiled_extent<N>(*this, extent<N>(t0, t1, t2));
+  }
+};
+
+template <int N>
+class tiled_extent : public extent<N> {
+ public:
+  tiled_extent(const extent<N>& ext, const extent<N>& tileExt)
+      : extent<N>(ext) {
+    for (int d = 0; d < N; d++) {
+      tile_dim[d] = tileExt[d];
+    }
+  }
+
+  int tile_dim[N];
+};
+
+class tile_barrier;
+
+namespace detail {
+
+//  Stack of every work-item fiber, with a guard page at its low end
+static const size_t kFiberStackBytes = 256 * 1024;
+
+//  Saved state of a suspended fiber or of the thread that runs them
+struct Context {
+#if defined(__x86_64__)
+  void* sp;
+#else
+  ucontext_t uc;
+#endif
+};
+
+#if defined(__x86_64__)
+//  Push the callee saved registers, store the stack pointer to *from, load
+//  the one of to and pop its registers; ret then resumes the fiber of to
+__attribute__((naked, noinline)) inline void SwitchStack(void** from,
+                                                         void* to) {
+  asm volatile(
+      "pushq %rbp\n\t"
+      "pushq %rbx\n\t"
+      "pushq %r12\n\t"
+      "pushq %r13\n\t"
+      "pushq %r14\n\t"
+      "pushq %r15\n\t"
+      "movq %rsp, (%rdi)\n\t"
+      "movq %rsi, %rsp\n\t"
+      "popq %r15\n\t"
+      "popq %r14\n\t"
+      "popq %r13\n\t"
+      "popq %r12\n\t"
+      "popq %rbx\n\t"
+      "popq %rbp\n\t"
+      "ret\n\t");
+}
+#endif
+
+inline void Switch(Context* from, Context* to) {
+#if defined(__x86_64__)
+  SwitchStack(&from->sp, to->sp);
+#else
+  swapcontext(&from->uc, &to->uc);
+#endif
+}
+
+//  Runs the work-items of one tile after the other on the calling thread.
+//  Every work-item runs on a stack of its own until it reaches a barrier or
+//  ends; the runner then resumes the next one
+class TileRunner {
+ public:
+  typedef void (*ItemFunc)(const void* launch, size_t item);
+
+  TileRunner() : stacks(NULL), capacity(0), items(0), current(0) {}
+
+  ~TileRunner() {
+    if (stacks != NULL) {
+      munmap(stacks, capacity * kFiberStackBytes);
+    }
+  }
+
+  // The runner of the calling thread
+  static TileRunner& Get() {
+    static thread_local TileRunner runner;
+    return runner;
+  }
+
+  void Run(size_t itemCount, ItemFunc funcVal, const void* launchVal) {
+    Reserve(itemCount);
+    items = itemCount;
+    func = funcVal;
+    launch = launchVal;
+    finished.assign(items, false);
+
+    for (size_t i = 0; i < items; i++) {
+      Start(i);
+    }
+
+    size_t running = items;
+
+    // Each round takes every work-item to its next barrier or to its end
+    while (running > 0) {
+      for (current = 0; current < items; current++) {
+        if (!finished[current]) {
+          Switch(&thread, &fibers[current]);
+          running -= finished[current] ? 1 : 0;
+        }
+      }
+    }
+  }
+
+  // Suspend the calling work-item until the others reach the barrier
+  void Barrier() { Switch(&fibers[current], &thread); }
+
+ private:
+  TileRunner(const TileRunner&);
+  TileRunner& operator=(const TileRunner&);
+
+  static void Entry() {
+    TileRunner& runner = Get();
+    runner.func(runner.launch, runner.current);
+    runner.finished[runner.current] = true;
+    Switch(&runner.fibers[runner.current], &runner.thread);
+  }
+
+  void Reserve(size_t itemCount) {
+    if (itemCount <= capacity) {
+      return;
+    }
+
+    if (stacks != NULL) {
+      munmap(stacks, capacity * kFiberStackBytes);
+    }
+
+    capacity = itemCount;
+    stacks = static_cast<char*>(mmap(NULL, capacity * kFiberStackBytes,
+                                     PROT_READ | PROT_WRITE,
+                                     MAP_PRIVATE | MAP_ANONYMOUS |
+                                     MAP_NORESERVE, -1, 0));
+
+    if (stacks == MAP_FAILED) {
+      abort();
+    }
+
+    for (size_t i = 0; i < capacity; i++) {
+      mprotect(stacks + i * kFiberStackBytes, sysconf(_SC_PAGE_SIZE),
+               PROT_NONE);
+    }
+
+    fibers.resize(capacity);
+  }
+
+  void Start(size_t item) {
+    char* base = stacks + item * kFiberStackBytes;
+#if defined(__SANITIZE_ADDRESS__)
+    // Frames of the previous tile never returned, so their poison remains
+    ASAN_UNPOISON_MEMORY_REGION(base, kFiberStackBytes);
+#endif
+#if defined(__x86_64__)
+    // Frame that SwitchStack pops: six registers, then Entry as the return
+    // address, above it a null return address for Entry itself
+    void** sp = reinterpret_cast<void**>(base + kFiberStackBytes);
+    *--sp = NULL;
+    *--sp = reinterpret_cast<void*>(&Entry);
+
+    for (int r = 0; r < 6; r++) {
+      *--sp = NULL;
+    }
+
+    fibers[item].sp = sp;
+#else
+    getcontext(&fibers[item].uc);
+    fibers[item].uc.uc_stack.ss_sp = base;
+    fibers[item].uc.uc_stack.ss_size = kFiberStackBytes;
+    fibers[item].uc.uc_link = NULL;
+    makecontext(&fibers[item].uc, &Entry, 0);
+#endif
+  }
+
+  char* stacks;
+  size_t capacity;
+  std::vector<Context> fibers;
+  std::vector<bool> finished;
+  Context thread;
+  size_t items;
+  size_t current;
+  ItemFunc func;
+  const void* launch;
+};
+
+//  Threads that run the tasks of one launch at a time. The thread that
+//  launches takes part and returns once every task has run
+class ThreadPool {
+ public:
+  typedef void (*TaskFunc)(const void* launch, size_t task);
+
+  static ThreadPool& Get() {
+    static ThreadPool pool;
+    return pool;
+  }
+
+  void Run(size_t taskCount, TaskFunc funcVal, const void* launchVal) {
+    std::lock_guard<std::mutex> launchLock(launchMutex);
+
+    if (workers.empty() || taskCount == 1) {
+      for (size_t t = 0; t < taskCount; t++) {
+        funcVal(launchVal, t);
+      }
+
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      tasks = taskCount;
+      func = funcVal;
+      launch = launchVal;
+      next = 0;
+      busy = workers.size();
+      generation++;
+    }
+
+    wake.notify_all();
+    Drain();
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return busy == 0; });
+  }
+
+ private:
+  ThreadPool() : tasks(0), busy(0), generation(0), stop(false) {
+    size_t threads = std::thread::hardware_concurrency();
+    const char* env = getenv("HC_HOST_THREADS");
+
+    if (env != NULL && atoi(env) > 0) {
+      threads = atoi(env);
+    }
+
+    for (size_t i = 1; i < threads; i++) {
+      workers.push_back(std::thread(&ThreadPool::Work, this));
+    }
+  }
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stop = true;
+    }
+
+    wake.notify_all();
+
+    for (size_t i = 0; i < workers.size(); i++) {
+      workers[i].join();
+    }
+  }
+
+  ThreadPool(const ThreadPool&);
+  ThreadPool& operator=(const ThreadPool&);
+
+  void Drain() {
+    for (size_t t = next++; t < tasks; t = next++) {
+      func(launch, t);
+    }
+  }
+
+  void Work() {
+    size_t seen = 0;
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (true) {
+      wake.wait(lock, [this, seen] { return stop || generation != seen; });
+
+      if (stop) {
+        return;
+      }
+
+      seen = generation;
+      lock.unlock();
+      Drain();
+      lock.lock();
+
+      if (--busy == 0) {
+        done.notify_one();
+      }
+    }
+  }
+
+  std::vector<std::thread> workers;
+  std::mutex launchMutex;
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable done;
+  std::atomic<size_t> next;
+  size_t tasks;
+  TaskFunc func;
+  const void* launch;
+  size_t busy;
+  size_t generation;
+  bool stop;
+};
+
+//  Position of item in a box of the given sizes, the last dimension fastest
+template <int N>
+index<N> Unflatten(size_t item, const int* sizes) {
+  index<N> idx;
+
+  for (int d = N - 1; d >= 0; d--) {
+    idx[d] = item % sizes[d];
+    item /= sizes[d];
+  }
+
+  return idx;
+}
+
+}  // namespace detail
+
+class tile_barrier {
+ public:
+  tile_barrier() {}
+
+  void wait() const { detail::TileRunner::Get().Barrier(); }
+  void wait_with_all_memory_fence() const { wait(); }
+  void wait_with_global_memory_fence() const { wait(); }
+  void wait_with_tile_static_memory_fence() const { wait(); }
+};
+
+template <int N>
+class tiled_index {
+ public:
+  tiled_index(const index<N>& globalVal, const index<N>& localVal,
+              const index<N>& tileVal, const index<N>& originVal,
+              const extent<N>& tileDimVal)
+      : global(globalVal),
+        local(localVal),
+        tile(tileVal),
+        tile_origin(originVal),
+        tile_dim(tileDimVal) {}
+
+  const index<N> global;
+  const index<N> local;
+  const index<N> tile;
+  const index<N> tile_origin;
+  const extent<N> tile_dim;
+  const tile_barrier barrier;
+};
+
+namespace detail {
+
+//  One launch over a tiled extent: a task per tile, a fiber per work-item.
+//  Tiles at the end of a dimension that the extent does not fill hold only
+//  the work-items inside the extent
+template <int N, typename Kernel>
+class TiledLaunch {
+ public:
+  TiledLaunch(const tiled_extent<N>& extVal, const Kernel& kernelVal)
+      : ext(extVal), kernel(kernelVal) {
+    for (int d = 0; d < N; d++) {
+      tiles[d] = (ext[d] + ext.tile_dim[d] - 1) / ext.tile_dim[d];
+    }
+  }
+
+  size_t Tiles() const { return extent<N>(tiles).size(); }
+
+  static void RunTile(const void* self, size_t tile) {
+    TileState state;
+    state.launch = static_cast<const TiledLaunch*>(self);
+    state.tile = Unflatten<N>(tile, state.launch->tiles);
+    size_t items = 1;
+
+    for (int d = 0; d < N; d++) {
+      int tileDim = state.launch->ext.tile_dim[d];
+      state.origin[d] = state.tile[d] * tileDim;
+      state.sizes[d] =
+          std::min(tileDim, state.launch->ext[d] - state.origin[d]);
+      items *= state.sizes[d];
+    }
+
+    TileRunner::Get().Run(items, &RunItem, &state);
+  }
+
+ private:
+  struct TileState {
+    const TiledLaunch* launch;
+    index<N> tile;
+    index<N> origin;
+    int sizes[N];
+  };
+
+  static void RunItem(const void* tileState, size_t item) {
+    const TileState& state = *static_cast<const TileState*>(tileState);
+    index<N> local = Unflatten<N>(item, state.sizes);
+    index<N> global;
+
+    for (int d = 0; d < N; d++) {
+      global[d] = state.origin[d] + local[d];
+    }
+
+    tiled_index<N> tidx(global, local, state.tile, state.origin,
+                        extent<N>(state.launch->ext.tile_dim));
+    state.launch->kernel(tidx);
+  }
+
+  const tiled_extent<N>& ext;
+  const Kernel& kernel;
+  int tiles[N];
+};
+
+//  One launch over a plain extent: work-items run in chunks, straight on the
+//  pool threads since they cannot wait at barriers
+template <int N, typename Kernel>
+class FlatLaunch {
+ public:
+  static const size_t kChunk = 1024;
+
+  FlatLaunch(const extent<N>& extVal, const Kernel& kernelVal)
+      : ext(extVal), kernel(kernelVal) {
+    for (int d = 0; d < N; d++) {
+      sizes[d] = ext[d];
+    }
+  }
+
+  size_t Chunks() const { return (ext.size() + kChunk - 1) / kChunk; }
+
+  static void RunChunk(const void* self, size_t chunk) {
+    const FlatLaunch& launch = *static_cast<const FlatLaunch*>(self);
+    size_t end = std::min(launch.ext.size(), (chunk + 1) * kChunk);
+
+    for (size_t item = chunk * kChunk; item < end; item++) {
+      launch.kernel(Unflatten<N>(item, launch.sizes));
+    }
+  }
+
+ private:
+  const extent<N>& ext;
+  const Kernel& kernel;
+  int sizes[N];
+};
+
+}  // namespace detail
+
+template <int N, typename Kernel>
+completion_future parallel_for_each(const accelerator_view& av,
+                                    const tiled_extent<N>& ext,
+                                    const Kernel& kernel) {
+  if (ext.size() == 0) {
+    return completion_future();
+  }
+
+  detail::TiledLaunch<N, Kernel> launch(ext, kernel);
+  detail::ThreadPool::Get().Run(launch.Tiles(),
+                                &detail::TiledLaunch<N, Kernel>::RunTile,
+                                &launch);
+  return completion_future();
+}
+
+template <int N, typename Kernel>
+completion_future parallel_for_each(const accelerator_view& av,
+                                    const extent<N>& ext,
+                                    const Kernel& kernel) {
+  if (ext.size() == 0) {
+    return completion_future();
+  }
+
+  detail::FlatLaunch<N, Kernel> launch(ext, kernel);
+  detail::ThreadPool::Get().Run(launch.Chunks(),
+                                &detail::FlatLaunch<N, Kernel>::RunChunk,
+                                &launch);
+  return completion_future();
+}
+
+template <int N, typename Kernel>
+completion_future parallel_for_each(const tiled_extent<N>& ext,
+                                    const Kernel& kernel) {
+  return parallel_for_each(accelerator().get_default_view(), ext, kernel);
+}
+
+template <int N, typename Kernel>
+completion_future parallel_for_each(const extent<N>& ext,
+                                    const Kernel& kernel) {
+  return parallel_for_each(accelerator().get_default_view(), ext, kernel);
+}
+
+}  // namespace hc
+
+#endif  // LIB_INCLUDE_HC_HOST_HC_HPP_
@@ -0,0 +1,84 @@
+/*
+Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+//  Host emulation of hc_am: every allocation is host memory, whatever the
+//  accelerator and flags
+
+#ifndef LIB_INCLUDE_HC_HOST_HC_AM_HPP_
+#define LIB_INCLUDE_HC_HOST_HC_AM_HPP_
+
+#include <cstdlib>
+#include <cstring>
+#include "./hc.hpp"
+
+#define AM_SUCCESS 0
+#define AM_ERROR_MISC -1
+
+#define amHostPinned 0x1
+
+typedef int am_status_t;
+
+namespace hc {
+
+// Converts to any pointer type, as the am_alloc result of hc_am does
+struct auto_voidp {
+  void* _ptr;
+
+  auto_voidp(void* ptr) : _ptr(ptr) {}
+
+  template <class T>
+  operator T*() {
+    return static_cast<T*>(_ptr);
+  }
+};
+
+inline auto_voidp am_alloc(size_t size, const accelerator& acc,
+                           unsigned flags) {
+  void* ptr = NULL;
+
+  if (size == 0 || posix_memalign(&ptr, 64, size) != 0) {
+    return auto_voidp(NULL);
+  }
+
+  return auto_voidp(ptr);
+}
+
+inline am_status_t am_free(void* ptr) {
+  free(ptr);
+  return AM_SUCCESS;
+}
+
+inline am_status_t am_copy(void* dst, const void* src, size_t size) {
+  memmove(dst, src, size);
+  return AM_SUCCESS;
+}
+
+// Memory of every accelerator is visible to all of them
+inline am_status_t am_map_to_peers(void* ptr, size_t num_peer,
+                                   const accelerator* peers) {
+  return AM_SUCCESS;
+}
+
+}  // namespace hc
+
+#endif  // LIB_INCLUDE_HC_HOST_HC_AM_HPP_
@@ -0,0 +1,74 @@
+/*
+Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+//  Host emulation of the hc math functions; both flavours are the standard
+//  library functions
+
+#ifndef LIB_INCLUDE_HC_HOST_HC_MATH_HPP_
+#define LIB_INCLUDE_HC_HOST_HC_MATH_HPP_
+
+#include <cmath>
+
+namespace hc {
+namespace precise_math {
+
+using std::ceil;
+using std::cos;
+using std::exp;
+using std::fabs;
+using std::floor;
+using std::fma;
+using std::fmax;
+using std::fmin;
+using std::log;
+using std::pow;
+using std::sin;
+using std::sqrt;
+using std::tan;
+
+inline float rsqrt(float x) { return 1.0f / std::sqrt(x); }
+inline double rsqrt(double x) { return 1.0 / std::sqrt(x); }
+
+}  // namespace precise_math
+
+namespace fast_math {
+
+using precise_math::ceil;
+using precise_math::cos;
+using precise_math::exp;
+using precise_math::fabs;
+using precise_math::floor;
+using precise_math::fma;
+using precise_math::fmax;
+using precise_math::fmin;
+using precise_math::log;
+using precise_math::pow;
+using precise_math::rsqrt;
+using precise_math::sin;
+using precise_math::sqrt;
+using precise_math::tan;
+
+}  // namespace fast_math
+}  // namespace hc
+
+#endif  // LIB_INCLUDE_HC_HOST_HC_MATH_HPP_
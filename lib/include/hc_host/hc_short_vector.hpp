@@ -0,0 +1,187 @@
+/*
+Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+//  Host emulation of the hc short vectors: plain structs of 2 to 4
+//  components with component-wise arithmetic
+
+#ifndef LIB_INCLUDE_HC_HOST_HC_SHORT_VECTOR_HPP_
+#define LIB_INCLUDE_HC_HOST_HC_SHORT_VECTOR_HPP_
+
+namespace hc {
+namespace short_vector {
+
+template <typename T, int N>
+struct __vector_components;
+
+template <typename T>
+struct __vector_components<T, 2> {
+  T x, y;
+};
+
+template <typename T>
+struct __vector_components<T, 3> {
+  T x, y, z;
+};
+
+template <typename T>
+struct __vector_components<T, 4> {
+  T x, y, z, w;
+};
+
+template <typename T, int N>
+class __vector : public __vector_components<T, N> {
+ public:
+  typedef T value_type;
+  static const int size = N;
+
+  __vector() { Fill(T()); }
+  explicit __vector(T value) { Fill(value); }
+
+  __vector(T v0, T v1) {
+    static_assert(N == 2, "__vector<T, N> takes N components");
+    (*this)[0] = v0;
+    (*this)[1] = v1;
+  }
+
+  __vector(T v0, T v1, T v2) {
+    static_assert(N == 3, "__vector<T, N> takes N components");
+    (*this)[0] = v0;
+    (*this)[1] = v1;
+    (*this)[2] = v2;
+  }
+
+  __vector(T v0, T v1, T v2, T v3) {
+    static_assert(N == 4, "__vector<T, N> takes N components");
+    (*this)[0] = v0;
+    (*this)[1] = v1;
+    (*this)[2] = v2;
+    (*this)[3] = v3;
+  }
+
+  template <typename U>
+  explicit __vector(const __vector<U, N>& other) {
+    for (int i = 0; i < N; i++) {
+      (*this)[i] = static_cast<T>(other[i]);
+    }
+  }
+
+  T& operator[](int i) { return reinterpret_cast<T*>(this)[i]; }
+
+  const T& operator[](int i) const {
+    return reinterpret_cast<const T*>(this)[i];
+  }
+
+  T get_x() const { return (*this)[0]; }
+  T get_y() const { return (*this)[1]; }
+  void set_x(T value) { (*this)[0] = value; }
+  void set_y(T value) { (*this)[1] = value; }
+
+  __vector operator-() const {
+    __vector r;
+
+    for (int i = 0; i < N; i++) {
+      r[i] = -(*this)[i];
+    }
+
+    return r;
+  }
+
+#define HC_HOST_VECTOR_ASSIGN(op)                      \
+  __vector& operator op(const __vector& other) {       \
+    for (int i = 0; i < N; i++) {                      \
+      (*this)[i] op other[i];                          \
+    }                                                  \
+    return *this;                                      \
+  }                                                    \
+  __vector& operator op(T value) {                     \
+    for (int i = 0; i < N; i++) {                      \
+      (*this)[i] op value;                             \
+    }                                                  \
+    return *this;                                      \
+  }
+
+  HC_HOST_VECTOR_ASSIGN(+=)
+  HC_HOST_VECTOR_ASSIGN(-=)
+  HC_HOST_VECTOR_ASSIGN(*=)
+  HC_HOST_VECTOR_ASSIGN(/=)
+#undef HC_HOST_VECTOR_ASSIGN
+
+  bool operator==(const __vector& other) const {
+    for (int i = 0; i < N; i++) {
+      if ((*this)[i] != other[i]) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  bool operator!=(const __vector& other) const { return !(*this == other); }
+
+ private:
+  void Fill(T value) {
+    for (int i = 0; i < N; i++) {
+      (*this)[i] = value;
+    }
+  }
+};
+
+// The scalar of a mixed operation converts to the component type
+#define HC_HOST_VECTOR_OPERATOR(op)                                        \
+  template <typename T, int N>                                             \
+  __vector<T, N> operator op(__vector<T, N> a, const __vector<T, N>& b) {  \
+    return a op## = b;                                                     \
+  }                                                                        \
+  template <typename T, int N>                                             \
+  __vector<T, N> operator op(__vector<T, N> a,                             \
+                             typename __vector<T, N>::value_type b) {      \
+    return a op## = b;                                                     \
+  }                                                                        \
+  template <typename T, int N>                                             \
+  __vector<T, N> operator op(typename __vector<T, N>::value_type a,        \
+                             const __vector<T, N>& b) {                    \
+    return __vector<T, N>(a) op## = b;                                     \
+  }
+
+HC_HOST_VECTOR_OPERATOR(+)
+HC_HOST_VECTOR_OPERATOR(-)
+HC_HOST_VECTOR_OPERATOR(*)
+HC_HOST_VECTOR_OPERATOR(/)
+#undef HC_HOST_VECTOR_OPERATOR
+
+typedef __vector<int, 2> int_2;
+typedef __vector<int, 3> int_3;
+typedef __vector<int, 4> int_4;
+typedef __vector<unsigned int, 2> uint_2;
+typedef __vector<unsigned int, 3> uint_3;
+typedef __vector<unsigned int, 4> uint_4;
+typedef __vector<float, 2> float_2;
+typedef __vector<float, 3> float_3;
+typedef __vector<float, 4> float_4;
+typedef __vector<double, 2> double_2;
+typedef __vector<double, 3> double_3;
+typedef __vector<double, 4> double_4;
+
+}  // namespace short_vector
+}  // namespace hc
+
+#endif  // LIB_INCLUDE_HC_HOST_HC_SHORT_VECTOR_HPP_
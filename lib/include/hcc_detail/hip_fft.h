@@ -34,6 +34,8 @@ typedef hipComplex hipfftComplex;
 typedef hipDoubleComplex hipfftDoubleComplex;
 typedef hcfftReal hipfftReal;
 typedef hcfftDoubleReal hipfftDoubleReal;
+typedef hcfftHalf hipfftHalf;
+typedef hcfftHalfComplex hipfftHalfComplex;
 
 hipfftResult hipHCFFTResultToHIPFFTResult(hcfftResult hcResult);
 
@@ -150,6 +152,15 @@ hipfftResult hipfftExecC2R(hipfftHandle plan, hipfftComplex *idata,
 hipfftResult hipfftExecZ2D(hipfftHandle plan, hipfftDoubleComplex *idata,
                            hipfftDoubleReal *odata);
 
+hipfftResult hipfftExecC2CHalf(hipfftHandle plan, hipfftHalfComplex *idata,
+                               hipfftHalfComplex *odata, int direction);
+
+hipfftResult hipfftExecR2CHalf(hipfftHandle plan, hipfftHalf *idata,
+                               hipfftHalfComplex *odata);
+
+hipfftResult hipfftExecC2RHalf(hipfftHandle plan, hipfftHalfComplex *idata,
+                               hipfftHalf *odata);
+
 #ifdef __cplusplus
 }
 #endif
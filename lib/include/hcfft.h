@@ -23,6 +23,8 @@ THE SOFTWARE.
 #ifndef LIB_INCLUDE_HCFFT_H_
 #define LIB_INCLUDE_HCFFT_H_
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif  // (__cplusplus)
@@ -44,10 +46,18 @@ struct double_2_ {
   double y;
 };
 
+struct half_2_ {
+  unsigned short x;
+  unsigned short y;
+};
+
 typedef float hcfftReal;
 typedef float_2_ hcfftComplex;
 typedef double hcfftDoubleReal;
 typedef double_2_ hcfftDoubleComplex;
+// IEEE 754 binary16 bit patterns
+typedef unsigned short hcfftHalf;
+typedef half_2_ hcfftHalfComplex;
 
 /* hcfft API Specification */
 
@@ -65,7 +75,10 @@ typedef enum hcfftType_t {
   HCFFT_C2C = 0x29,  // Complex to complex (interleaved)
   HCFFT_D2Z = 0x6a,  // Double to double-complex (interleaved)
   HCFFT_Z2D = 0x6c,  // Double-complex (interleaved) to double
-  HCFFT_Z2Z = 0x69   // Double-complex to double-complex (interleaved)
+  HCFFT_Z2Z = 0x69,  // Double-complex to double-complex (interleaved)
+  HCFFT_R2C_HALF = 0x0a,  // Half to half-complex, computed in fp32
+  HCFFT_C2R_HALF = 0x0c,  // Half-complex to half, computed in fp32
+  HCFFT_C2C_HALF = 0x09   // Half-complex to half-complex, computed in fp32
 } hcfftType;
 
 typedef enum hcfftResult_t {
@@ -193,6 +206,43 @@ hcfftResult hcfftPlan2d(hcfftHandle* plan, int nx, int ny, hcfftType type);
 hcfftResult hcfftPlan3d(hcfftHandle* plan, int nx, int ny, int nz,
                         hcfftType type);
 
+/*
+ * <iv> Function hcfftPlanNd()
+   Description:
+      Creates a rank-N FFT plan configuration from a length vector and optional
+   stride vectors. Axis 0 is the fastest varying, as nx is for hcfftPlan3d().
+   Ranks above 3 are executed as one strided 1D pass per axis.
+
+   Input:
+   ----------------------------------------------------------------------------------------------
+   #1 plan       Pointer to a hcfftHandle object
+   #2 rank       Number of dimensions, 1 to HCFFT_MAXDIM (15)
+   #3 n          Array of rank transform sizes, n[0] being the fastest axis
+   #4 inStride   Array of rank input strides in elements, or NULL for packed data
+   #5 iDist      Distance between input batches, or 0 to derive it from the strides
+   #6 outStride  Array of rank output strides in elements, or NULL for packed data
+   #7 oDist      Distance between output batches, or 0 to derive it from the strides
+   #8 batch      Number of transforms
+   #9 type       The transform data type (e.g., HCFFT_C2C for single precision complex
+                 to complex)
+
+   Output:
+   ----------------------------------------------------------------------------------------------
+   #1 plan       Contains a hcFFT plan handle value
+
+   Return Values:
+   ----------------------------------------------------------------------------------------------
+   HCFFT_SUCCESS         hcFFT successfully created the FFT plan.
+   HCFFT_ALLOC_FAILED    The allocation of GPU resources for the plan failed.
+   HCFFT_INVALID_VALUE   One or more invalid parameters were passed to the API.
+   HCFFT_SETUP_FAILED    The hcFFT library failed to initialize.
+   HCFFT_INVALID_SIZE    The rank, one of the sizes or batch is not supported.
+*/
+
+hcfftResult hcfftPlanNd(hcfftHandle* plan, int rank, const int* n,
+                        const int* inStride, int iDist, const int* outStride,
+                        int oDist, int batch, hcfftType type);
+
 /* Function hcfftDestroy()
    Description:
       Frees all GPU resources associated with a hcFFT plan and destroys the
@@ -329,6 +379,747 @@ hcfftResult hcfftExecC2R(hcfftHandle plan, hcfftComplex* idata,
 hcfftResult hcfftExecZ2D(hcfftHandle plan, hcfftDoubleComplex* idata,
                          hcfftDoubleReal* odata);
 
+/*
+  Functions hcfftExecR2CHalf(), hcfftExecC2RHalf() and hcfftExecC2CHalf()
+
+  Description:
+       Execute a plan created with HCFFT_R2C_HALF, HCFFT_C2R_HALF or
+  HCFFT_C2C_HALF. Input and output are stored as fp16 (half the bytes of a
+  single precision transform), while butterflies and twiddles are computed in
+  fp32 registers. The semantics otherwise match hcfftExecR2C(),
+  hcfftExecC2R() and hcfftExecC2C().
+
+  Multi-dimensional half precision plans run one strided pass per axis, as
+  the transpose kernels have no fp16 storage. Plans with an axis too long for
+  a single pass fail with HCFFT_SETUP_FAILED.
+
+  Input:
+  -----------------------------------------------------------------------------------------------------------
+  plan       hcfftHandle created for one of the half precision types
+  idata      Pointer to the fp16 input data (in GPU memory) to transform
+  odata      Pointer to the fp16 output data (in GPU memory)
+  direction  HCFFT_FORWARD or HCFFT_BACKWARD (hcfftExecC2CHalf() only)
+
+  Return Values:
+  ------------------------------------------------------------------------------------------------------------
+  HCFFT_SUCCESS         hcFFT successfully executed the FFT plan.
+  HCFFT_INVALID_VALUE   A pointer is not valid or the plan is not a half
+                        precision plan.
+  HCFFT_EXEC_FAILED     hcFFT failed to execute the transform on the GPU.
+  HCFFT_SETUP_FAILED    The plan cannot be generated for half precision.
+*/
+
+hcfftResult hcfftExecR2CHalf(hcfftHandle plan, hcfftHalf* idata,
+                             hcfftHalfComplex* odata);
+
+hcfftResult hcfftExecC2RHalf(hcfftHandle plan, hcfftHalfComplex* idata,
+                             hcfftHalf* odata);
+
+hcfftResult hcfftExecC2CHalf(hcfftHandle plan, hcfftHalfComplex* idata,
+                             hcfftHalfComplex* odata, int direction);
+
+/* Flags for hcfftSpectralMAC() and hcfftSpectralMACZ() */
+typedef enum hcfftMacFlags_t {
+  HCFFT_MAC_DEFAULT = 0x0,     //  odata = sum over channels of idata * wdata
+  HCFFT_MAC_ACCUMULATE = 0x1,  //  odata += sum over channels of idata * wdata
+  HCFFT_MAC_CONJUGATE = 0x2    //  Multiply by conj(wdata) (cross-correlation)
+} hcfftMacFlags;
+
+/*
+  Functions hcfftSpectralMAC() and hcfftSpectralMACZ()
+
+  Description:
+       Multi-channel spectral multiply-accumulate for FFT based convolution.
+  For every frequency bin f it computes the batched complex GEMM
+
+       odata[b][k][f] = sum_c idata[b][c][f] * wdata[k][c][f]
+
+  The spectra are read and written in the layout of the plan: the
+  hermitian output of a R2C/D2Z plan, the hermitian input of a C2R/Z2D plan
+  or the complex output of a C2C/Z2Z plan. Consecutive spectra are the plan
+  distance apart, so the output of hcfftExecR2C() with a batch of
+  nImages * nChannels can be passed directly.
+
+  Input:
+  -----------------------------------------------------------------------------------------------------------
+  plan       hcfftHandle whose layout describes the spectra
+  nImages    Number of images (b)
+  nChannels  Number of input channels to reduce over (c)
+  nFilters   Number of filters (k)
+  idata      Pointer to nImages * nChannels input spectra (in GPU memory)
+  wdata      Pointer to nFilters * nChannels weight spectra (in GPU memory)
+  odata      Pointer to nImages * nFilters output spectra (in GPU memory)
+  flags      Bitwise or of hcfftMacFlags
+
+  Output:
+  -----------------------------------------------------------------------------------------------------------
+  odata      Contains the multiply-accumulated spectra
+
+  Return Values:
+  ------------------------------------------------------------------------------------------------------------
+  HCFFT_SUCCESS         hcFFT successfully executed the multiply-accumulate.
+  HCFFT_INVALID_VALUE   The plan, a pointer or the precision is not valid, or
+                        odata aliases idata or wdata.
+  HCFFT_INVALID_SIZE    One of nImages, nChannels or nFilters is not positive.
+  HCFFT_EXEC_FAILED     hcFFT failed to build or execute the kernel on the GPU.
+*/
+
+hcfftResult hcfftSpectralMAC(hcfftHandle plan, int nImages, int nChannels,
+                             int nFilters, hcfftComplex* idata,
+                             hcfftComplex* wdata, hcfftComplex* odata,
+                             int flags);
+
+hcfftResult hcfftSpectralMACZ(hcfftHandle plan, int nImages, int nChannels,
+                              int nFilters, hcfftDoubleComplex* idata,
+                              hcfftDoubleComplex* wdata,
+                              hcfftDoubleComplex* odata, int flags);
+
+/* Callback kinds for hcfftXtSetCallback() and hcfftXtClearCallback() */
+typedef enum hcfftXtCallbackType_t {
+  HCFFT_CB_LD = 0x0,  //  Called for every element the plan reads from idata
+  HCFFT_CB_ST = 0x1   //  Called for every element the plan writes to odata
+} hcfftXtCallbackType;
+
+/*
+  Functions hcfftXtSetCallback() and hcfftXtClearCallback()
+
+  Description:
+       Fuse a user defined load or store operation into the generated
+  kernels of the plan. The callback is given as HC source and is compiled
+  together with the kernels the next time the plan is executed, so no extra
+  pass over global memory is needed for windowing, scaling, type conversion
+  and similar pre/post processing.
+
+  A load callback must define
+
+       [[hc]] T hcfft_load_callback(T* buffer, size_t offset, void* callerInfo)
+
+  and a store callback must define
+
+       [[hc]] void hcfft_store_callback(T* buffer, size_t offset, T value,
+                                        void* callerInfo)
+
+  where T is float_2 (double_2, hcfft_half_2) for interleaved complex data
+  and float (double, hcfft_half) for real data. Offsets are in elements of T and relative to the
+  start of the user buffer, also in row and column passes, so a callback can
+  depend on the position of an element in the whole array. Several overloads may be
+  given in one source. A load callback can be invoked more than once for
+  the same element and must not have side effects.
+
+  Callbacks are supported for transforms that are computed by a single
+  kernel and for 2D/3D C2C transforms decomposed into row and column
+  passes. Plans that need a transpose or a copy stage fail with
+  HCFFT_SETUP_FAILED at execution.
+
+  Input:
+  -----------------------------------------------------------------------------------------------------------
+  plan            hcfftHandle returned by hcfftCreate
+  callbackSource  HC source defining the callback
+  cbType          Whether the callback is a load or a store callback
+  callerInfo      Pointer in GPU memory handed to every call of the callback
+
+  Return Values:
+  ------------------------------------------------------------------------------------------------------------
+  HCFFT_SUCCESS         hcFFT successfully attached/removed the callback.
+  HCFFT_INVALID_VALUE   The callback source or type is not valid.
+  HCFFT_SETUP_FAILED    hcFFT failed to update the plan.
+*/
+
+hcfftResult hcfftXtSetCallback(hcfftHandle plan, const char* callbackSource,
+                               hcfftXtCallbackType cbType, void* callerInfo);
+
+hcfftResult hcfftXtClearCallback(hcfftHandle plan, hcfftXtCallbackType cbType);
+
+/* Column methods for hcfftXtSetColumnMethod() */
+typedef enum hcfftXtColumnMethod_t {
+  HCFFT_XT_COLUMNS_AUTO = 0x0,       //  Chosen by the planner's cost model
+  HCFFT_XT_COLUMNS_TRANSPOSE = 0x1,  //  Transpose, row FFT, transpose back
+  HCFFT_XT_COLUMNS_STRIDED = 0x2     //  Blocked strided column FFT in place
+} hcfftXtColumnMethod;
+
+/*
+  Function hcfftXtSetColumnMethod()
+
+  Description:
+       Select how the column and depth passes of a 2D or 3D complex plan are
+  computed. Strided column kernels transform blocks of neighbouring columns
+  in place, reading and writing coalesced row segments, and save the memory
+  traffic of the transposes. By default the planner estimates the memory
+  transactions and occupancy of both methods and picks the cheaper one.
+
+  A method is only used where it is available: strided columns need
+  power-of-2 column lengths from 8 to 256, interleaved data with unit
+  stride rows and a row length that is a multiple of the block width.
+  Transposes are used for packed power-of-2 2D plans. Other plans keep
+  their default decomposition.
+
+  Large complex 1D plans whose two factors each fit a single kernel run as
+  a four-step in two kernels by default; HCFFT_XT_COLUMNS_TRANSPOSE keeps
+  the transpose chain for them.
+
+  Input:
+  -----------------------------------------------------------------------------------------------------------
+  plan            hcfftHandle returned by hcfftCreate
+  method          The column method
+
+  Return Values:
+  ------------------------------------------------------------------------------------------------------------
+  HCFFT_SUCCESS         hcFFT successfully updated the plan.
+  HCFFT_INVALID_VALUE   The method is not valid.
+  HCFFT_SETUP_FAILED    hcFFT failed to update the plan.
+*/
+
+hcfftResult hcfftXtSetColumnMethod(hcfftHandle plan,
+                                   hcfftXtColumnMethod method);
+
+/*
+  Functions hcfftXtExecOutOfCoreC2C() and hcfftXtExecOutOfCoreZ2Z()
+
+  Description:
+       Execute a C2C (Z2Z) plan on data in host memory that may be larger
+  than the memory of the accelerator. The transform is computed in passes
+  over the host buffers, each streaming device sized chunks: leading axes
+  whose volume fits a chunk are transformed as slabs, every further axis as
+  pencils of neighbouring columns, and an axis 0 longer than a chunk as a
+  four-step of two pencil passes. Uploads, transforms and downloads of
+  consecutive chunks overlap on separate accelerator views.
+
+  The plan has to be packed. A four-step needs odata to differ from idata;
+  otherwise idata and odata may be the same buffer. odata is used as the
+  intermediate storage between passes.
+
+  Input:
+  -----------------------------------------------------------------------------------------------------------
+  plan       hcfftHandle returned by hcfftCreate
+  idata      Pointer to the complex input data (in host memory)
+  odata      Pointer to the complex output data (in host memory)
+  direction  HCFFT_FORWARD or HCFFT_BACKWARD
+
+  Return Values:
+  ------------------------------------------------------------------------------------------------------------
+  HCFFT_SUCCESS         hcFFT successfully executed the FFT plan.
+  HCFFT_INVALID_VALUE   The plan is not a packed C2C (Z2Z) plan, a pointer is
+                        not valid or an axis cannot be split into chunks.
+  HCFFT_EXEC_FAILED     hcFFT failed to execute the transform on the GPU.
+*/
+
+hcfftResult hcfftXtExecOutOfCoreC2C(hcfftHandle plan, hcfftComplex* idata,
+                                    hcfftComplex* odata, int direction);
+
+hcfftResult hcfftXtExecOutOfCoreZ2Z(hcfftHandle plan,
+                                    hcfftDoubleComplex* idata,
+                                    hcfftDoubleComplex* odata, int direction);
+
+/*
+  Functions hcfftExecHostC2C(), hcfftExecHostZ2Z(), hcfftExecHostR2C(),
+  hcfftExecHostD2Z(), hcfftExecHostC2R() and hcfftExecHostZ2D()
+
+  Description:
+       Same as the hcfftExec* function of the same type, on data in host
+  memory. The batch is split into chunks of whole transforms that are staged
+  through pinned buffers owned by the plan: the upload of the next chunk and
+  the download of the previous one overlap the transform of the current
+  one. A C2C (Z2Z) plan whose single transform does not fit on the
+  accelerator is executed as with hcfftXtExecOutOfCoreC2C().
+  hcfftXtSetAccelerators() spreads the batch over several accelerators.
+
+  In-place execution needs the input and output distances to cover the same
+  number of bytes.
+
+  Input:
+  -----------------------------------------------------------------------------------------------------------
+  plan       hcfftHandle returned by hcfftCreate
+  idata      Pointer to the input data (in host memory)
+  odata      Pointer to the output data (in host memory)
+  direction  HCFFT_FORWARD or HCFFT_BACKWARD (C2C and Z2Z only)
+
+  Return Values:
+  ------------------------------------------------------------------------------------------------------------
+  HCFFT_SUCCESS         hcFFT successfully executed the FFT plan.
+  HCFFT_INVALID_VALUE   A pointer is not valid or the plan cannot be split
+                        into chunks.
+  HCFFT_SETUP_FAILED    hcFFT failed to set up the plan.
+  HCFFT_EXEC_FAILED     hcFFT failed to execute the transform on the GPU.
+*/
+
+hcfftResult hcfftExecHostC2C(hcfftHandle plan, hcfftComplex* idata,
+                             hcfftComplex* odata, int direction);
+
+hcfftResult hcfftExecHostZ2Z(hcfftHandle plan, hcfftDoubleComplex* idata,
+                             hcfftDoubleComplex* odata, int direction);
+
+hcfftResult hcfftExecHostR2C(hcfftHandle plan, hcfftReal* idata,
+                             hcfftComplex* odata);
+
+hcfftResult hcfftExecHostD2Z(hcfftHandle plan, hcfftDoubleReal* idata,
+                             hcfftDoubleComplex* odata);
+
+hcfftResult hcfftExecHostC2R(hcfftHandle plan, hcfftComplex* idata,
+                             hcfftReal* odata);
+
+hcfftResult hcfftExecHostZ2D(hcfftHandle plan, hcfftDoubleComplex* idata,
+                             hcfftDoubleReal* odata);
+
+/*
+  Function hcfftXtSetAccelerators()
+
+  Description:
+       Distribute the batch of the hcfftExecHost* functions over several
+  accelerators. Every accelerator gets a contiguous share of the batch and
+  runs it through a sub-plan, staging buffers and device buffers of its own,
+  managed by the library. Device pointer execution stays on the accelerator
+  of the plan. nAccelerators = 0 returns to that accelerator.
+
+  Input:
+  -----------------------------------------------------------------------------------------------------------
+  plan               hcfftHandle returned by hcfftCreate
+  nAccelerators      Number of accelerators
+  whichAccelerators  Indices of the accelerators among the GPU accelerators
+                     of hc::accelerator::get_all(), without repetition
+
+  Return Values:
+  ------------------------------------------------------------------------------------------------------------
+  HCFFT_SUCCESS         hcFFT successfully updated the plan.
+  HCFFT_INVALID_VALUE   An index is out of range or repeated.
+  HCFFT_SETUP_FAILED    hcFFT failed to update the plan.
+*/
+
+hcfftResult hcfftXtSetAccelerators(hcfftHandle plan, int nAccelerators,
+                                   const int* whichAccelerators);
+
+/*
+  Function hcfftXtSetSimulatedAccelerators()
+
+  Description:
+       Same as hcfftXtSetAccelerators() with nAccelerators devices simulated
+  on the default accelerator, each with an accelerator_view of its own. The
+  batch is split in proportion to the weights. Meant to exercise multi-device
+  scheduling on a machine with a single accelerator.
+
+  Input:
+  -----------------------------------------------------------------------------------------------------------
+  plan           hcfftHandle returned by hcfftCreate
+  nAccelerators  Number of simulated accelerators
+  weights        Relative throughput of every accelerator, or NULL for equal
+                 shares
+
+  Return Values:
+  ------------------------------------------------------------------------------------------------------------
+  HCFFT_SUCCESS         hcFFT successfully updated the plan.
+  HCFFT_INVALID_VALUE   A weight is negative or all of them are 0.
+  HCFFT_SETUP_FAILED    hcFFT failed to update the plan.
+*/
+
+hcfftResult hcfftXtSetSimulatedAccelerators(hcfftHandle plan,
+                                            int nAccelerators,
+                                            const int* weights);
+
+/*
+  Distributed 3D transforms
+
+  A hcfftXtDistributedArray holds a 3D C2C or Z2Z array spread over the
+  accelerators set with hcfftXtSetAccelerators() or
+  hcfftXtSetSimulatedAccelerators(), one slab of z planes per accelerator.
+  Transforming it runs the x and y passes on every slab, exchanges the slabs
+  between all accelerators and runs the z pass, which leaves the array in
+  slabs of y planes. The next transform of the array runs the passes in the
+  opposite order and returns it to slabs of z planes. Copies to and from the
+  host take either layout into account.
+*/
+
+typedef struct hcfftXtDistributedArray hcfftXtDistributedArray;
+
+typedef enum hcfftXtExchange_t {
+  HCFFT_XT_EXCHANGE_DEVICE = 0,        // Copies between accelerators
+  HCFFT_XT_EXCHANGE_SHARED_MEMORY = 1  // Copies through a host mailbox
+} hcfftXtExchange;
+
+/*
+  Function hcfftXtMallocDistributed()
+
+  Description:
+       Allocate a distributed array for a 3D C2C or Z2Z plan with a batch of
+  1 and a set of accelerators. Every accelerator holds its slab and a scratch
+  slab of the same size.
+
+  Input:
+  -----------------------------------------------------------------------------------------------------------
+  plan       hcfftHandle returned by hcfftCreate
+  array      Pointer to the distributed array
+
+  Return Values:
+  ------------------------------------------------------------------------------------------------------------
+  HCFFT_SUCCESS         hcFFT successfully allocated the array.
+  HCFFT_INVALID_VALUE   The plan does not support distributed execution.
+  HCFFT_ALLOC_FAILED    The allocation failed.
+*/
+
+hcfftResult hcfftXtMallocDistributed(hcfftHandle plan,
+                                     hcfftXtDistributedArray** array);
+
+/*
+  Function hcfftXtFreeDistributed()
+
+  Description:
+       Free a distributed array.
+
+  Return Values:
+  ------------------------------------------------------------------------------------------------------------
+  HCFFT_SUCCESS         hcFFT successfully freed the array.
+  HCFFT_INVALID_VALUE   array is NULL.
+*/
+
+hcfftResult hcfftXtFreeDistributed(hcfftXtDistributedArray* array);
+
+/*
+  Functions hcfftXtCopyToDistributed() and hcfftXtCopyFromDistributed()
+
+  Description:
+       Copy a host array of Nx x Ny x Nz elements (x fastest) to or from a
+  distributed array.
+
+  Return Values:
+  ------------------------------------------------------------------------------------------------------------
+  HCFFT_SUCCESS         hcFFT successfully copied the array.
+  HCFFT_INVALID_VALUE   A pointer is NULL or the array was not allocated for
+                        the plan.
+*/
+
+hcfftResult hcfftXtCopyToDistributed(hcfftHandle plan,
+                                     hcfftXtDistributedArray* array,
+                                     const void* host);
+
+hcfftResult hcfftXtCopyFromDistributed(hcfftHandle plan, void* host,
+                                       hcfftXtDistributedArray* array);
+
+/*
+  Functions hcfftXtExecDistributedC2C() and hcfftXtExecDistributedZ2Z()
+
+  Description:
+       Transform a distributed array in place.
+
+  Input:
+  -----------------------------------------------------------------------------------------------------------
+  plan       hcfftHandle returned by hcfftCreate
+  array      Distributed array allocated for the plan
+  direction  HCFFT_FORWARD or HCFFT_BACKWARD
+
+  Return Values:
+  ------------------------------------------------------------------------------------------------------------
+  HCFFT_SUCCESS         hcFFT successfully executed the FFT plan.
+  HCFFT_INVALID_VALUE   The array was not allocated for the plan.
+  HCFFT_EXEC_FAILED     hcFFT failed to execute the transform.
+*/
+
+hcfftResult hcfftXtExecDistributedC2C(hcfftHandle plan,
+                                      hcfftXtDistributedArray* array,
+                                      int direction);
+
+hcfftResult hcfftXtExecDistributedZ2Z(hcfftHandle plan,
+                                      hcfftXtDistributedArray* array,
+                                      int direction);
+
+/*
+  Function hcfftXtSetExchange()
+
+  Description:
+       Select how distributed transforms move slabs between accelerators.
+  HCFFT_XT_EXCHANGE_DEVICE, the default, copies between the memories of the
+  accelerators. HCFFT_XT_EXCHANGE_SHARED_MEMORY posts every block to a host
+  mailbox and collects it from there, the way processes sharing memory
+  would; it is meant for testing.
+
+  Return Values:
+  ------------------------------------------------------------------------------------------------------------
+  HCFFT_SUCCESS         hcFFT successfully updated the plan.
+  HCFFT_INVALID_VALUE   exchange is not a hcfftXtExchange.
+  HCFFT_SETUP_FAILED    hcFFT failed to update the plan.
+*/
+
+hcfftResult hcfftXtSetExchange(hcfftHandle plan, hcfftXtExchange exchange);
+
+typedef enum hcfftXtBackend_t {
+  HCFFT_XT_BACKEND_AUTO = 0,         // Host when no accelerator is usable or
+                                     // for small transforms of host data
+  HCFFT_XT_BACKEND_ACCELERATOR = 1,  // Always the accelerator
+  HCFFT_XT_BACKEND_HOST = 2          // Always the host CPU
+} hcfftXtBackend;
+
+/*
+  Function hcfftXtSetBackend()
+
+  Description:
+       Select where the plan executes. The host backend runs the same
+  decomposition and radices as the generated kernels on the CPU, vectorized
+  and multithreaded, and bakes no kernel. Device pointers given to the
+  hcfftExec* functions are copied to the host and back unless the
+  accelerator of the plan is emulated on the host. HCFFT_XT_BACKEND_AUTO, the
+  default, runs on the host when the accelerator is emulated, and runs
+  hcfftExecHost* calls of at most 2048 elements on the host.
+
+  Input:
+  -----------------------------------------------------------------------------------------------------------
+  plan       hcfftHandle returned by hcfftCreate
+  backend    HCFFT_XT_BACKEND_AUTO, HCFFT_XT_BACKEND_ACCELERATOR or
+             HCFFT_XT_BACKEND_HOST
+
+  Return Values:
+  ------------------------------------------------------------------------------------------------------------
+  HCFFT_SUCCESS         hcFFT successfully updated the plan.
+  HCFFT_INVALID_VALUE   backend is not a hcfftXtBackend.
+  HCFFT_SETUP_FAILED    hcFFT failed to update the plan.
+*/
+
+hcfftResult hcfftXtSetBackend(hcfftHandle plan, hcfftXtBackend backend);
+
+/*
+  Function hcfftXtSetOutOfCoreMemory()
+
+  Description:
+       Limit the device memory used by hcfftXtExecOutOfCoreC2C(),
+  hcfftXtExecOutOfCoreZ2Z() and the hcfftExecHost* functions on the plan. The default, 0, uses up to half of
+  the dedicated memory of the accelerator.
+
+  Input:
+  -----------------------------------------------------------------------------------------------------------
+  plan       hcfftHandle returned by hcfftCreate
+  bytes      Device memory budget in bytes, 0 for the default
+
+  Return Values:
+  ------------------------------------------------------------------------------------------------------------
+  HCFFT_SUCCESS         hcFFT successfully updated the plan.
+  HCFFT_SETUP_FAILED    hcFFT failed to update the plan.
+*/
+
+hcfftResult hcfftXtSetOutOfCoreMemory(hcfftHandle plan, size_t bytes);
+
+// Static cost of one generated kernel of a plan
+typedef struct hcfftKernelCost_t {
+  char name[64];        // kernel entry point, e.g. fft_fwd or transpose_gcn
+  int radices[16];      // radix of each FFT pass, 0 terminated
+  size_t globalSize;    // work-items of the launch
+  size_t localSize;     // work-items per work-group
+  double flops;         // floating point operations
+  double bytesRead;     // global memory read, twiddle tables included
+  double bytesWritten;  // global memory written
+  double ldsBytes;      // LDS traffic of all work-groups
+  size_t barriers;      // barriers each work-group waits on
+  size_t registers;     // estimate of 32-bit registers per work-item
+  double seconds;       // predicted time of the launch
+} hcfftKernelCost;
+
+// Peak rates of the device kernel times are predicted for
+typedef struct hcfftDeviceRoofline_t {
+  double singleGflops;  // fp32 arithmetic, also used for half precision
+  double doubleGflops;  // fp64 arithmetic
+  double memoryGBs;     // global memory bandwidth
+  double ldsGBs;        // LDS bandwidth of all compute units together
+  double launchUs;      // fixed cost of a kernel launch in microseconds
+} hcfftDeviceRoofline;
+
+/*
+  Function hcfftGetPlanCostReport()
+
+  Description:
+       Report the static cost of every kernel the plan runs, in the order of
+  the plan tree, without executing anything. Flops are counted in the
+  generated butterflies, global and LDS traffic, barriers and registers
+  follow from the passes and work sizes, and the predicted time of each
+  launch is its launch cost plus the slowest of arithmetic, memory and LDS
+  traffic on the given device. The plan is baked first if it is not yet.
+
+  Input:
+  -----------------------------------------------------------------------------------------------------------
+  plan       hcfftHandle returned by hcfftCreate
+  device     Peak rates of the device, NULL for a gfx900 class GPU
+  kernels    Array of *count entries to fill, NULL to only query the count
+  count      Pointer to the capacity of kernels; receives the number of
+             kernels of the plan
+
+  Return Values:
+  ------------------------------------------------------------------------------------------------------------
+  HCFFT_SUCCESS         hcFFT successfully reported the kernels; at most the
+                        capacity given in *count are written.
+  HCFFT_INVALID_VALUE   count is NULL.
+  HCFFT_SETUP_FAILED    The plan could not be baked or costed.
+*/
+
+hcfftResult hcfftGetPlanCostReport(hcfftHandle plan,
+                                   const hcfftDeviceRoofline* device,
+                                   hcfftKernelCost* kernels, int* count);
+
+/*
+  Function hcfftExplainPlan()
+
+  Description:
+       Describe the decomposition a plan was baked into as a JSON object. Every
+  node of the tree gives the sub-plan member holding it (planX, planTX,
+  planRCcopy, ...), its generator, lengths, strides, distances and batch, the
+  blockCompute and realSpecial settings and its scratch buffers. Leaves run a
+  kernel and add its name, pass radices and work sizes; every node gives the
+  flops and global bytes of the kernels below it, as hcfftGetPlanCostReport()
+  counts them. The plan is baked first if it is not yet.
+
+  Input:
+  -----------------------------------------------------------------------------------------------------------
+  plan       hcfftHandle returned by hcfftCreate
+  json       Buffer of *size bytes receiving the NUL terminated JSON, NULL
+             to only query the size
+  size       Pointer to the size of json; receives the size the whole JSON
+             needs, terminator included
+
+  Return Values:
+  ------------------------------------------------------------------------------------------------------------
+  HCFFT_SUCCESS         hcFFT successfully described the plan; the JSON is
+                        truncated to fit the given size.
+  HCFFT_INVALID_VALUE   size is NULL.
+  HCFFT_SETUP_FAILED    The plan could not be baked or described.
+*/
+
+hcfftResult hcfftExplainPlan(hcfftHandle plan, char* json, size_t* size);
+
+/*
+  Functions hcfftProfileStart() and hcfftProfileStop()
+
+  Description:
+       Time every kernel the plans launch from hcfftProfileStart() on. Each
+  launch is recorded with its kernel, generator, sub-plan lengths and batch,
+  the bytes and flops hcfftGetPlanCostReport() counts for the kernel and the
+  resulting GB/s and GFLOP/s. hcfftProfileStop() writes the records to path as
+  Chrome trace-event JSON and to the same path with a .csv extension as CSV.
+  Setting HCFFT_PROFILE=<path> in the environment profiles the whole process
+  and writes the files at exit.
+
+  Input:
+  -----------------------------------------------------------------------------------------------------------
+  path       File the trace is written to; a trailing .json is replaced by
+             .csv for the CSV file
+
+  Return Values:
+  ------------------------------------------------------------------------------------------------------------
+  HCFFT_SUCCESS         hcFFT successfully started profiling or wrote the
+                        records.
+  HCFFT_INVALID_VALUE   path is NULL or empty, or profiling is not running.
+  HCFFT_EXEC_FAILED     The records could not be written.
+*/
+
+hcfftResult hcfftProfileStart(const char* path);
+
+hcfftResult hcfftProfileStop();
+
+// Phases of baking a plan and of loading its kernels
+typedef enum hcfftBakePhase_t {
+  HCFFT_BAKE_CACHE_LOOKUP = 0,  // search of the kernel cache
+  HCFFT_BAKE_GENERATE,          // kernel source generation
+  HCFFT_BAKE_WRITE,             // write of the source to the kernel cache
+  HCFFT_BAKE_COMPILE,           // compiler invocation
+  HCFFT_BAKE_DLOPEN,            // load of the kernel library
+  HCFFT_BAKE_DLSYM,             // lookup of the kernel entry points
+  HCFFT_BAKE_TWIDDLES,          // twiddle table computation and upload
+  HCFFT_BAKE_SCRATCH,           // allocation of the scratch buffers
+  HCFFT_BAKE_PHASES
+} hcfftBakePhase;
+
+// Time spent in each phase, exclusive of the phases nested in it
+typedef struct hcfftBakeTimes_t {
+  double seconds[HCFFT_BAKE_PHASES];
+  size_t calls[HCFFT_BAKE_PHASES];
+  size_t cacheHits;    // bakes that found their kernel library built
+  size_t cacheMisses;  // bakes that generated and compiled it
+} hcfftBakeTimes;
+
+/*
+  Functions hcfftGetPlanBakeTimes() and hcfftGetBakeTimes()
+
+  Description:
+       Report where baking and the first execution spent their time, phase by
+  phase, for one plan or for the whole process. The times of a plan include
+  its sub-plans and the variants it was baked into for the other placement,
+  out-of-core or multi-device execution. Each phase is charged its own time:
+  the twiddle tables computed while a kernel is generated are not counted as
+  generation. With HCFFT_BAKE_LOG=1 in the environment every bake and first
+  execution prints its phases to stderr.
+
+  Input:
+  -----------------------------------------------------------------------------------------------------------
+  plan       hcfftHandle returned by hcfftCreate
+  times      Pointer to the times to fill
+
+  Return Values:
+  ------------------------------------------------------------------------------------------------------------
+  HCFFT_SUCCESS         hcFFT successfully reported the times.
+  HCFFT_INVALID_VALUE   times is NULL.
+  HCFFT_INVALID_PLAN    plan is not a valid handle.
+*/
+
+hcfftResult hcfftGetPlanBakeTimes(hcfftHandle plan, hcfftBakeTimes* times);
+
+hcfftResult hcfftGetBakeTimes(hcfftBakeTimes* times);
+
+// Generators of the kernels counted in hcfftMetrics
+typedef enum hcfftKernelKind_t {
+  HCFFT_KERNEL_STOCKHAM = 0,
+  HCFFT_KERNEL_TRANSPOSE_GCN,
+  HCFFT_KERNEL_TRANSPOSE_SQUARE,
+  HCFFT_KERNEL_TRANSPOSE_NONSQUARE,
+  HCFFT_KERNEL_COPY,
+  HCFFT_KERNEL_STOCKHAM_LDS,
+  HCFFT_KERNEL_STOCKHAM_LIBRARY,
+  HCFFT_KERNEL_KINDS
+} hcfftKernelKind;
+
+// Buckets of the execution latency histogram, bounded by 10us, 100us, 1ms,
+// 10ms, 100ms, 1s and 10s; the last one counts the slower executions
+#define HCFFT_EXEC_BUCKETS 8
+
+// Counters of the whole process since it started
+typedef struct hcfftMetrics_t {
+  size_t kernelsLaunched[HCFFT_KERNEL_KINDS];
+  double kernelBytes;  // global memory read and written by the kernels
+  size_t execs;        // plan executions
+  double execSeconds;  // time of the executions
+  size_t execBuckets[HCFFT_EXEC_BUCKETS];  // executions per latency bucket
+  size_t plansCreated;
+  size_t plansBaked;
+  size_t cacheHits;     // bakes that found their kernel library built
+  size_t cacheMisses;   // bakes that generated it
+  size_t compiles;      // kernel libraries compiled
+  size_t scratchBytes;  // device scratch held by the plans now
+  size_t twiddleBytes;  // twiddle tables uploaded
+} hcfftMetrics;
+
+/*
+  Functions hcfftGetMetrics() and hcfftGetMetricsPrometheus()
+
+  Description:
+       Report what the library did since the process started: kernels
+  launched per generator and the global memory they moved, as
+  hcfftGetPlanCostReport() counts it, plan executions and a histogram of their
+  latency, plans created and baked, kernel cache hits, misses and
+  compilations, the device scratch the plans hold and the twiddle bytes
+  uploaded. Counting takes no lock on the execution path.
+  hcfftGetMetricsPrometheus() writes the same metrics in the Prometheus text
+  exposition format, ready to be served to a scraper.
+
+  Input:
+  -----------------------------------------------------------------------------------------------------------
+  metrics    Pointer to the metrics to fill
+  text       Buffer of *size bytes receiving the NUL terminated text, NULL
+             to only query the size
+  size       Pointer to the size of text; receives the size the whole text
+             needs, terminator included
+
+  Return Values:
+  ------------------------------------------------------------------------------------------------------------
+  HCFFT_SUCCESS         hcFFT successfully reported the metrics; the text is
+                        truncated to fit the given size.
+  HCFFT_INVALID_VALUE   metrics or size is NULL.
+*/
+
+hcfftResult hcfftGetMetrics(hcfftMetrics* metrics);
+
+hcfftResult hcfftGetMetricsPrometheus(char* text, size_t* size);
+
 #ifdef __cplusplus
 }
 #endif  // (__cplusplus)
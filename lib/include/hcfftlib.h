@@ -28,11 +28,15 @@ THE SOFTWARE.
 #include <dirent.h>
 #include <hc.hpp>
 #include <hc_short_vector.hpp>
+#include <chrono>
 #include <iostream>
+#include <map>
 #include <stdio.h>
 #include <sys/stat.h>
 #include <unistd.h>
+#include <thread>
 #include <utility>
+#include "./emitter.h"
 #include "./lock.h"
 
 #define HCFFT_CB_NY 0
@@ -117,10 +121,20 @@ typedef size_t hcfftPlanHandle;
 typedef enum hcfftPrecision_ {
   HCFFT_SINGLE = 1,
   HCFFT_DOUBLE,
+  HCFFT_HALF,  // fp16 storage, fp32 compute
 } hcfftPrecision;
 
 typedef enum hcfftDim_ { HCFFT_1D = 1, HCFFT_2D, HCFFT_3D } hcfftDim;
 
+// Highest rank of a plan. Ranks above HCFFT_3D have no hcfftDim of their own:
+// their plans keep HCFFT_3D and hold one length per axis, see FFTPlan::Rank()
+#define HCFFT_MAXDIM 15
+
+// hcfftDim of a plan of the given rank
+inline hcfftDim DimOfRank(size_t rank) {
+  return (rank < HCFFT_3D) ? static_cast<hcfftDim>(rank) : HCFFT_3D;
+}
+
 typedef enum hcfftLayout_ {
   HCFFT_COMPLEX_INTERLEAVED = 1,  // An array of complex numbers, with real and
   //                                 imaginary components together (default).
@@ -153,6 +167,21 @@ typedef enum hcfftResTransposed_ {
   HCFFT_TRANSPOSED,
 } hcfftResTransposed;
 
+// How the column (and depth) passes of 2D and 3D plans are computed
+typedef enum hcfftColumnMethod_ {
+  HCFFT_COLUMNS_AUTO = 0,   // chosen by the planner's cost model
+  HCFFT_COLUMNS_TRANSPOSE,  // transpose, row FFT, transpose back
+  HCFFT_COLUMNS_STRIDED,    // blocked strided column kernel, in place
+} hcfftColumnMethod;
+
+// Where a plan executes
+typedef enum hcfftBackend_ {
+  HCFFT_BACKEND_AUTO = 0,     // the host when no accelerator is usable or for
+  //                             small transforms of host data
+  HCFFT_BACKEND_ACCELERATOR,  // always the accelerator of the plan
+  HCFFT_BACKEND_HOST,         // always the host CPU
+} hcfftBackend;
+
 typedef enum hcfftStatus_ {
   HCFFT_SUCCEEDS = 0,
   HCFFT_INVALID = -1,
@@ -165,6 +194,8 @@ typedef enum hcfftGenerators_ {
   Transpose_SQUARE,
   Transpose_NONSQUARE,
   Copy,
+  Stockham_LDS,
+  Stockham_Library,
 } hcfftGenerators;
 
 static inline bool IsPo2(size_t u) { return (u != 0) && (0 == (u & (u - 1))); }
@@ -237,9 +268,8 @@ inline size_t FloorPo2(size_t n) {
 
 // Convert unsigned integers to string
 inline std::string SztToStr(size_t i) {
-  std::stringstream ss;
-  ss << i;
-  return ss.str();
+  char digits[CodeEmitter::kNumberChars];
+  return std::string(digits, CodeEmitter::FormatUnsigned(i, digits));
 }
 
 inline std::string hcHeader() {
@@ -251,7 +281,17 @@ inline std::string hcHeader() {
          "#include <iostream>\n"
          "using namespace hc;\n"
          "using namespace hc::fast_math;\n"
-         "using namespace hc::short_vector;\n";
+         "using namespace hc::short_vector;\n"
+         "#ifndef HCFFT_HALF_TYPES\n"
+         "#define HCFFT_HALF_TYPES\n"
+         "typedef __fp16 hcfft_half;\n"
+         "struct hcfft_half_2 {\n"
+         "  __fp16 x, y;\n"
+         "  hcfft_half_2() [[cpu, hc]] {}\n"
+         "  hcfft_half_2(const float_2 &v) [[cpu, hc]] : x(v.x), y(v.y) {}\n"
+         "  operator float_2() const [[cpu, hc]] { return float_2(x, y); }\n"
+         "};\n"
+         "#endif\n";
 }
 
 static size_t width(hcfftPrecision precision) {
@@ -262,6 +302,10 @@ static size_t width(hcfftPrecision precision) {
     case HCFFT_DOUBLE:
       return 2;
 
+    // fp16 storage, computed in fp32 registers
+    case HCFFT_HALF:
+      return 1;
+
     default:
       assert(false);
       return 1;
@@ -274,14 +318,75 @@ inline std::string getHomeDir() {
   return pwd;
 }
 
+// Generated kernels run on the host when hcFFT is built against the hc
+// emulation headers. They are then built with the host compiler against those
+// headers.
+inline bool HostEmulation() {
+#ifdef HC_HOST_EMULATION
+  return true;
+#else
+  return false;
+#endif
+}
+
+// HCFFT_HOST_EMULATION set to a non zero number asks for host kernels. Only
+// an emulated build runs them; an hcc built library hands its kernels
+// accelerator views and device buffers the emulation headers cannot take.
+inline bool HostEmulationRequested() {
+  const char* value = getenv("HCFFT_HOST_EMULATION");
+  return value != NULL && atoi(value) != 0;
+}
+
+// Directory of generated kernel sources and libraries; host built libraries
+// are kept apart from hcc built ones
+inline std::string getKernelCacheDir() {
+  return getHomeDir() + (HostEmulation() ? "/kernCacheHost" : "/kernCache");
+}
+
+// am_alloc flags of buffers the generated kernels access; host pinned memory
+// when they run on the host
+inline unsigned KernelAllocFlags() {
+  return HostEmulation() ? amHostPinned : 0;
+}
+
+// Build a generated kernel source file into a loadable shared object
+hcfftStatus CompileSharedObject(const std::string& filename,
+                                const std::string& kernellib);
+
+// With the kernel build stubbed, bakes generate the kernel sources but skip
+// the kernel cache, the source files and the compiler, so plans bake on
+// machines without a compiler or an accelerator. Such plans cannot execute;
+// host benchmarks of plan generation bake with it. A non-empty
+// HCFFT_KERNEL_BUILD_STUB in the environment stubs it as well
+void SetKernelBuildStub(bool stub);
+
+bool KernelBuildStubbed();
+
+// Radices of one axis of a single kernel multi-dimensional transform
+bool LdsAxisRadices(size_t length, std::vector<size_t>* radices);
+
+// Consecutive columns a blocked column kernel of this length loads per row,
+// 0 when there is no blocked kernel for the length
+size_t StockhamBlockWidth(hcfftPrecision precision, size_t length);
+
+// Radices of the passes of the single kernel generated for a length, in the
+// order the kernel runs them
+void StockhamRadices(hcfftPrecision precision, size_t maxWorkGroupSize,
+                     size_t length, std::vector<size_t>* radices);
+
+// Names reports give the generators and precisions
+const char* GeneratorName(hcfftGenerators gen);
+
+const char* PrecisionName(hcfftPrecision precision);
+
 namespace ARBITRARY {
 // TODO(Neelakandan):  These arbitrary parameters should be tuned for the type
 // of GPU being used.  These values are probably OK for Radeon 58xx and 68xx.
 enum {
-  MAX_DIMS = 3,
-  //  The # of dimensions is arbitrary, but limited by the OpenCL implementation
-  //  usually to 3 dimensions. The kernel generator also assumes a limit on
-  //  the # of dimensions.
+  MAX_DIMS = HCFFT_MAXDIM,
+  //  The # of dimensions is arbitrary, but limited by the kernel generator
+  //  key, whose 16 length/stride slots also have to hold the batch. Ranks
+  //  above 3 are composed of one strided 1D pass per axis.
 
   SIMD_WIDTH = 64,
   //  Workgroup size.  This is the # of work items that share
@@ -320,6 +425,14 @@ enum {
 
   TWIDDLE_DEE = 8,
   //  4 bits per row of matrix.
+
+  TRANSACTION_BYTES = 128,
+  //  Bytes of global memory moved by one memory transaction. Strided column
+  //  kernels that touch fewer consecutive bytes per row waste the rest.
+
+  MIN_WORK_GROUPS = 64,
+  //  Kernels launching fewer work groups than this leave compute units idle.
+  //  The column planner charges them proportionally more.
 };
 };  // namespace ARBITRARY
 
@@ -422,6 +535,13 @@ struct FFTKernelGenKeyParams {
   NON_SQUARE_KERNEL_ORDER nonSquareKernelOrder;
 
   bool fft_RCsimple;
+  bool fft_realPair;          //  copy kernel packs/splits two real transforms
+  //                              carried by one complex transform
+
+  bool fft_hasLoadCallback;   //  global reads go through the user load
+  //                              callback
+  bool fft_hasStoreCallback;  //  global writes go through the user store
+  //                              callback
 
   ulong limit_LocalMemSize;
 
@@ -450,6 +570,9 @@ struct FFTKernelGenKeyParams {
     fft_realSpecial = false;
     fft_realSpecial_Nr = 0;
     fft_RCsimple = false;
+    fft_realPair = false;
+    fft_hasLoadCallback = false;
+    fft_hasStoreCallback = false;
     blockCompute = false;
     blockComputeType = BCT_R2C;
     blockSIMD = 0;
@@ -461,6 +584,442 @@ struct FFTKernelGenKeyParams {
   }
 };
 
+//  Static cost of one launch of a generated kernel, derived from the plan
+//  and the generator without running anything
+struct FFTKernelCost {
+  hcfftGenerators gen;
+  std::string name;             // entry point, without the kernel number
+  std::vector<size_t> radices;  // radix of each pass, empty for data movement
+  size_t globalSize;            // work-items of the launch
+  size_t localSize;             // work-items per work-group
+  double flops;                 // floating point operations
+  double bytesRead;             // global memory read, twiddle tables included
+  double bytesWritten;          // global memory written
+  double ldsBytes;              // LDS written and read by all work-groups
+  size_t barriers;              // barriers each work-group waits on
+  size_t registers;             // estimate of 32-bit registers per work-item
+  double seconds;               // predicted by FFTRoofline::Seconds
+
+  FFTKernelCost()
+      : gen(Stockham),
+        globalSize(0),
+        localSize(0),
+        flops(0),
+        bytesRead(0),
+        bytesWritten(0),
+        ldsBytes(0),
+        barriers(0),
+        registers(0),
+        seconds(0) {}
+};
+
+//  Peak rates of the device the cost report predicts kernel times for; the
+//  defaults describe a gfx900 class GPU
+struct FFTRoofline {
+  double singleGflops;  // fp32 arithmetic, also used for fp16 storage
+  double doubleGflops;  // fp64 arithmetic
+  double memoryGBs;     // global memory bandwidth
+  double ldsGBs;        // LDS bandwidth of all compute units together
+  double launchUs;      // fixed cost of a kernel launch
+
+  FFTRoofline()
+      : singleGflops(12288.0),
+        doubleGflops(768.0),
+        memoryGBs(484.0),
+        ldsGBs(12288.0),
+        launchUs(5.0) {}
+
+  //  Launch cost plus the slowest of arithmetic, memory and LDS traffic
+  double Seconds(const FFTKernelCost& cost, hcfftPrecision precision) const;
+};
+
+//  Snapshot of one plan of a baked plan tree, as hcfftExplainPlan describes
+//  it. Leaves run a generated kernel, the other nodes only sequence their
+//  children
+struct FFTPlanNode {
+  std::string role;  // member of the parent holding the plan, "plan" at root
+  hcfftPlanHandle handle;
+  hcfftGenerators gen;
+  size_t dimension;
+  hcfftPrecision precision;
+  hcfftDirection direction;
+  hcfftIpLayout ipLayout;
+  hcfftOpLayout opLayout;
+  hcfftResLocation location;
+  hcfftBackend backend;
+  std::vector<size_t> length;
+  std::vector<size_t> inStride, outStride;
+  size_t iDist;
+  size_t oDist;
+  size_t batchSize;
+  size_t large1D;
+  bool large2D;
+  bool twiddleFront;
+  bool transflag;
+  bool blockCompute;
+  BlockComputeType blockComputeType;
+  bool realSpecial;
+  size_t realSpecial_Nr;
+  bool realPair;
+  bool RCsimple;
+  size_t tmpBufSize;  // scratch buffers, in bytes
+  size_t tmpBufSizeRC;
+  size_t tmpBufSizeC2R;
+  std::vector<size_t> globalws, localws;  // leaves only
+  FFTKernelCost cost;                     // leaves only
+  double flops;  // of the kernels of the node and its descendants
+  double bytes;  // global memory read and written by the same kernels
+  std::vector<FFTPlanNode> children;
+
+  FFTPlanNode() : handle(0), flops(0), bytes(0) {}
+
+  //  Whether the node runs a kernel of its own
+  bool Leaf() const { return children.empty(); }
+
+  //  The node and its descendants as a JSON object
+  std::string Json() const;
+};
+
+//  One kernel launch timed by FFTProfiler
+struct FFTProfileRecord {
+  std::string name;  // entry point, without the kernel number
+  hcfftGenerators gen;
+  hcfftPlanHandle plan;  // sub-plan that launched the kernel
+  hcfftPrecision precision;
+  std::vector<size_t> length;
+  size_t batchSize;
+  size_t thread;    // launching thread, numbered in order of appearance
+  double start;     // microseconds since profiling started
+  double duration;  // microseconds
+  double bytes;     // global memory read and written, from FFTKernelCost
+  double flops;
+
+  FFTProfileRecord()
+      : gen(Stockham),
+        plan(0),
+        precision(HCFFT_SINGLE),
+        batchSize(0),
+        thread(0),
+        start(0),
+        duration(0),
+        bytes(0),
+        flops(0) {}
+};
+
+class FFTPlan;
+
+//  Opt-in timing of every kernel the plans launch, enabled by
+//  HCFFT_PROFILE=<path> or Start(). The generated kernels wait for their
+//  launch to complete, so the wall time around a launch is the time of the
+//  kernel. The records are written when profiling stops or at exit, as a
+//  Chrome trace-event JSON file at the path and a CSV file next to it
+class FFTProfiler {
+  lockRAII lock;
+  bool enabled;
+  std::string path;
+  std::chrono::steady_clock::time_point epoch;
+  std::vector<FFTProfileRecord> records;
+  std::map<std::thread::id, size_t> threads;
+  //  Kernel of each plan launched, described on its first launch
+  std::map<hcfftPlanHandle, FFTProfileRecord> kernels;
+
+  FFTProfiler();
+
+  FFTProfiler(const FFTProfiler&);
+
+  FFTProfiler& operator=(const FFTProfiler&);
+
+ public:
+  static FFTProfiler& getInstance() {
+    static FFTProfiler profiler;
+    return profiler;
+  }
+
+  bool Enabled() const { return enabled; }
+
+  //  Drop the records so far and time the launches that follow
+  hcfftStatus Start(const std::string& tracePath);
+
+  //  Write the records and stop timing
+  hcfftStatus Stop();
+
+  //  Microseconds since profiling started
+  double Now() const;
+
+  //  Record a launch of the kernel of fftPlan
+  void Record(const FFTPlan* fftPlan, double start, double duration);
+
+  //  Record one of several launches of fftPlan, described by cost
+  void Record(const FFTPlan* fftPlan, const FFTKernelCost& cost, double start,
+              double duration);
+
+  hcfftStatus WriteTrace(const std::string& tracePath) const;
+
+  hcfftStatus WriteCsv(const std::string& csvPath) const;
+
+  ~FFTProfiler();
+};
+
+//  Phases of baking a plan and of loading its kernels on the first execution
+enum FFTBakePhase {
+  BAKE_CACHE_LOOKUP,  // search of the kernel cache for a built library
+  BAKE_GENERATE,      // kernel source generation
+  BAKE_WRITE,         // write of the source to the kernel cache
+  BAKE_COMPILE,       // compiler invocation
+  BAKE_DLOPEN,        // load of the kernel library
+  BAKE_DLSYM,         // lookup of the kernel entry points
+  BAKE_TWIDDLES,      // twiddle table computation and upload
+  BAKE_SCRATCH,       // allocation of the scratch buffers
+  BAKE_PHASES
+};
+
+const char* BakePhaseName(FFTBakePhase phase);
+
+//  Time spent in each bake phase, exclusive of the phases timed inside it
+struct FFTBakeTimes {
+  double seconds[BAKE_PHASES];
+  size_t calls[BAKE_PHASES];
+  size_t allocations[BAKE_PHASES];  // with an allocation counter installed
+  size_t cacheHits;    // bakes that found their kernel library built
+  size_t cacheMisses;  // bakes that generated and compiled it
+
+  FFTBakeTimes() : cacheHits(0), cacheMisses(0) {
+    for (int p = 0; p < BAKE_PHASES; p++) {
+      seconds[p] = 0;
+      calls[p] = 0;
+      allocations[p] = 0;
+    }
+  }
+
+  void Add(const FFTBakeTimes& other);
+
+  double Total() const;
+};
+
+//  Times one bake phase until destroyed. The time is added to the process
+//  totals and to the innermost FFTBakeScope of the thread, if any
+class FFTBakeTimer {
+  FFTBakePhase phase;
+  std::chrono::steady_clock::time_point start;
+  double nested;  // seconds of the timers running inside this one
+  size_t startAllocations;
+  size_t nestedAllocations;
+  FFTBakeTimer* parent;
+
+  FFTBakeTimer(const FFTBakeTimer&);
+
+  FFTBakeTimer& operator=(const FFTBakeTimer&);
+
+ public:
+  explicit FFTBakeTimer(FFTBakePhase phase);
+
+  ~FFTBakeTimer();
+
+  //  Count a bake that found (hit) or built its kernel library
+  static void CountCache(bool hit);
+
+  //  Totals of all bakes of the process
+  static FFTBakeTimes Process();
+
+  //  Count the heap allocations of each phase with counter, a running total
+  //  of the allocations of the process, as a benchmark replacing operator new
+  //  keeps. NULL stops counting
+  static void SetAllocationCounter(size_t (*counter)());
+};
+
+//  Collects the bake phases the thread times into the bake times of a plan
+//  until destroyed. Scopes opened inside another one leave the times to the
+//  outer scope, the bake or first execution the user asked for. With
+//  HCFFT_BAKE_LOG=1 the outer scope prints what it collected to stderr
+class FFTBakeScope {
+  hcfftPlanHandle plHandle;
+  FFTBakeTimes* planTimes;
+  const char* action;
+  FFTBakeTimes collected;
+  bool outer;
+
+  FFTBakeScope(const FFTBakeScope&);
+
+  FFTBakeScope& operator=(const FFTBakeScope&);
+
+ public:
+  FFTBakeScope(hcfftPlanHandle plHandle, FFTBakeTimes* planTimes,
+               const char* action);
+
+  ~FFTBakeScope();
+};
+
+//  Upper bounds in seconds of the buckets of the execution latency histogram,
+//  the last bucket counting everything slower
+#define FFT_EXEC_BUCKETS 8
+extern const double FFTExecBucketBounds[FFT_EXEC_BUCKETS - 1];
+
+//  Process-wide counters, see FFTMetrics
+enum FFTMetric {
+  METRIC_KERNELS = 0,  // kernels launched, one slot per hcfftGenerators value
+  METRIC_KERNEL_BYTES = METRIC_KERNELS + Stockham_Library + 1,  // global memory
+  METRIC_EXECS,             // plan executions
+  METRIC_EXEC_NANOSECONDS,  // time of the executions
+  METRIC_EXEC_BUCKETS,      // executions per latency bucket
+  METRIC_PLANS_CREATED = METRIC_EXEC_BUCKETS + FFT_EXEC_BUCKETS,
+  METRIC_PLANS_BAKED,
+  METRIC_CACHE_HITS,     // bakes that found their kernel library built
+  METRIC_CACHE_MISSES,   // bakes that generated it
+  METRIC_COMPILES,       // kernel libraries compiled
+  METRIC_SCRATCH_BYTES,  // device scratch held by the plans, a gauge
+  METRIC_TWIDDLE_BYTES,  // twiddle tables uploaded
+  METRIC_COUNT
+};
+
+//  Counters of the whole process. Every thread adds to a shard of its own
+//  without locking or read-modify-write atomics; readers sum the shards of
+//  the live threads and what the exited ones left behind.
+class FFTMetrics {
+ public:
+  static void Add(FFTMetric metric, int64_t value = 1);
+
+  //  Count an execution that took seconds
+  static void AddExec(double seconds);
+
+  static void Read(int64_t values[METRIC_COUNT]);
+
+  //  All metrics in the Prometheus text exposition format
+  static std::string Prometheus();
+};
+
+//  Counts a plan execution and its latency until destroyed
+class FFTExecMetric {
+  std::chrono::steady_clock::time_point start;
+
+  FFTExecMetric(const FFTExecMetric&);
+
+  FFTExecMetric& operator=(const FFTExecMetric&);
+
+ public:
+  FFTExecMetric() : start(std::chrono::steady_clock::now()) {}
+
+  ~FFTExecMetric() {
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    FFTMetrics::AddExec(elapsed.count());
+  }
+};
+
+//  Keys of the plans in FFTPlan::streamPlans start with their kind
+enum StreamPlanKind {
+  STREAM_CHUNK_PLAN = 0,  // out-of-core chunk
+  STREAM_BATCH_PLAN = 1,  // part of the batch of host execution
+  STREAM_SLAB_PLAN = 2    // local pass of a distributed transform
+};
+
+//  Accelerators a plan distributes the batch of host execution over. Devices
+//  are numbered from 0; every device gets a share of the batch in proportion
+//  to its weight and runs it through a sub-plan of its own.
+class FFTDeviceSet {
+ public:
+  virtual ~FFTDeviceSet() {}
+
+  virtual size_t Count() const = 0;
+
+  virtual hc::accelerator Accelerator(size_t device) const = 0;
+
+  //  Queue the transforms of the device run on
+  virtual hc::accelerator_view View(size_t device) const = 0;
+
+  //  Relative throughput of the device
+  virtual size_t Weight(size_t device) const { return 1; }
+
+  //  Device memory streamed execution may use, in bytes. 0 selects the
+  //  default of the plan
+  virtual size_t Memory(size_t device) const { return 0; }
+
+  //  Transforms of a batch given to every device, in device order
+  std::vector<size_t> Split(size_t batch) const;
+};
+
+//  Physical accelerators
+class FFTAcceleratorSet : public FFTDeviceSet {
+  std::vector<hc::accelerator> accs;
+  std::vector<hc::accelerator_view> views;
+
+ public:
+  explicit FFTAcceleratorSet(const std::vector<hc::accelerator>& accsVal);
+
+  size_t Count() const { return accs.size(); }
+
+  hc::accelerator Accelerator(size_t device) const { return accs[device]; }
+
+  hc::accelerator_view View(size_t device) const { return views[device]; }
+};
+
+//  Devices simulated on one accelerator, each with a queue of its own. The
+//  splitting and scheduling of a multi-device configuration run unchanged
+//  on a machine with a single accelerator.
+class FFTSimulatedDeviceSet : public FFTDeviceSet {
+  hc::accelerator acc;
+  std::vector<hc::accelerator_view> views;
+  std::vector<size_t> weights;
+
+ public:
+  FFTSimulatedDeviceSet(const hc::accelerator& accVal,
+                        const std::vector<size_t>& weightsVal);
+
+  size_t Count() const { return weights.size(); }
+
+  hc::accelerator Accelerator(size_t device) const { return acc; }
+
+  hc::accelerator_view View(size_t device) const { return views[device]; }
+
+  size_t Weight(size_t device) const { return weights[device]; }
+};
+
+//  One contiguous copy of an all-to-all exchange between devices
+struct FFTExchangeBlock {
+  size_t srcDevice;
+  const void* src;
+  size_t dstDevice;
+  void* dst;
+  size_t bytes;
+};
+
+//  Transport of the exchanges of distributed transforms. Every block is
+//  delivered when AllToAll() returns.
+class FFTExchange {
+ public:
+  virtual ~FFTExchange() {}
+
+  virtual hcfftStatus AllToAll(FFTDeviceSet* devices,
+                               const std::vector<FFTExchangeBlock>& blocks) = 0;
+};
+
+//  Direct device to device copies, queued on the source device
+class FFTDeviceExchange : public FFTExchange {
+ public:
+  hcfftStatus AllToAll(FFTDeviceSet* devices,
+                       const std::vector<FFTExchangeBlock>& blocks);
+};
+
+//  Blocks pass through host memory shared by the threads of the devices:
+//  every device posts the blocks it sends, then collects the blocks it
+//  receives. Works whether or not the devices can reach each other.
+class FFTSharedMemoryExchange : public FFTExchange {
+  std::vector<char> mailbox;
+
+ public:
+  hcfftStatus AllToAll(FFTDeviceSet* devices,
+                       const std::vector<FFTExchangeBlock>& blocks);
+};
+
+//  A 3D array distributed over the devices of a plan in slabs of z planes,
+//  or of y planes after a transform (see hcfftXtMallocDistributed())
+struct hcfftXtDistributedArray {
+  std::vector<size_t> length;  // Nx, Ny, Nz
+  size_t elemBytes;
+  std::vector<void*> data;     // slab of every device
+  std::vector<void*> scratch;  // exchange buffer of every device
+  bool shuffled;               // slabs of y planes
+};
+
 class FFTRepo;
 
 class FFTPlan {
@@ -483,6 +1042,7 @@ class FFTPlan {
   hcfftDirection direction;
   hcfftResLocation location;
   hcfftResTransposed transposeType;
+  hcfftColumnMethod columnMethod;
   hcfftPrecision precision;
   void* input;
   void* output;
@@ -513,6 +1073,44 @@ class FFTPlan {
   hcfftPlanHandle planRCcopy;
   hcfftPlanHandle planCopy;
 
+  //  One strided 1D pass per axis, used by plans above 3 dimensions
+  std::vector<hcfftPlanHandle> axisPlans;
+
+  //  Copy of a user plan baked for the placement it was not baked for, so
+  //  in-place and out-of-place execution share the handle without re-baking
+  hcfftPlanHandle placementPlan;
+
+  //  In-core plans run on the chunks of streamed and distributed execution,
+  //  keyed by their kind and geometry
+  std::map<std::vector<size_t>, hcfftPlanHandle> streamPlans;
+
+  //  Device memory out-of-core execution may use, in bytes. 0 selects half of
+  //  the dedicated memory of the accelerator
+  size_t streamMemory;
+
+  //  Accelerators host execution distributes the batch over, owned by the
+  //  plan. NULL runs on the accelerator of the plan
+  FFTDeviceSet* deviceSet;
+
+  //  Copy of the plan per device of deviceSet, for the share of the device
+  std::vector<hcfftPlanHandle> devicePlans;
+
+  //  Transport of distributed transforms, owned by the plan. NULL copies
+  //  between devices directly
+  FFTExchange* exchange;
+
+  //  Accelerator or host execution, see RunsOnHost()
+  hcfftBackend backend;
+
+  //  Time spent baking the plan and loading its kernels, see FFTBakeScope
+  FFTBakeTimes bakeTimes;
+
+  //  Scratch allocated by the plan and global memory one launch of its kernel
+  //  moves, for FFTMetrics. launchBytes is costed on the first launch after
+  //  each bake
+  size_t scratchBytes;
+  double launchBytes;
+
   hcfftPlanHandle plHandle;
   hcfftPlanHandle plHandleOrigin;
 
@@ -532,6 +1130,10 @@ class FFTPlan {
   size_t tmpBufSizeC2R;
   void* intBufferC2R;
 
+  //  Pinned host memory chunks are packed into by streamed execution
+  size_t stagingBufSize;
+  void* stagingBuffer;
+
   void* twiddles;
   void* twiddleslarge;
 
@@ -540,6 +1142,8 @@ class FFTPlan {
 
   size_t large1D;
   bool large2D;
+  // 2D columns run in place on the output with a blocked strided kernel
+  bool stridedColumns;
   size_t cacheSize;
 
   // Real-Complex simple flag
@@ -557,6 +1161,13 @@ class FFTPlan {
                           // matrix in the 4th step
   // length[1] should be 1 + N0/2
 
+  // Paired real transforms
+  // On a real plan it means pairs of batched real signals run as the real and
+  // imaginary parts of one complex transform (planX). On its Copy sub-plans it
+  // selects the kernels packing the pairs (planCopy) and splitting the complex
+  // result (planRCcopy)
+  bool realPair;
+
   // User created plan
   bool userPlan;
 
@@ -587,6 +1198,13 @@ class FFTPlan {
   // Store the type of transform
   hcfftLibType hcfftlibtype;
 
+  // User load/store callbacks: device function source and caller info that is
+  // handed to every invocation
+  std::string loadCallback;
+  std::string storeCallback;
+  void* loadCallbackInfo;
+  void* storeCallbackInfo;
+
   FFTPlan()
       : dimension(HCFFT_1D),
         ipLayout(HCFFT_COMPLEX_INTERLEAVED),
@@ -594,6 +1212,7 @@ class FFTPlan {
         direction(HCFFT_FORWARD),
         location(HCFFT_INPLACE),
         transposeType(HCFFT_NOTRANSPOSE),
+        columnMethod(HCFFT_COLUMNS_AUTO),
         precision(HCFFT_SINGLE),
         batchSize(1),
         iDist(1),
@@ -611,6 +1230,11 @@ class FFTPlan {
         planTZ(0),
         planRCcopy(0),
         planCopy(0),
+        placementPlan(0),
+        streamMemory(0),
+        deviceSet(NULL),
+        exchange(NULL),
+        backend(HCFFT_BACKEND_AUTO),
         plHandle(0),
         plHandleOrigin(0),
         bLdsComplex(false),
@@ -623,6 +1247,8 @@ class FFTPlan {
         intBufferRC(NULL),
         tmpBufSizeC2R(0),
         intBufferC2R(NULL),
+        stagingBufSize(0),
+        stagingBuffer(NULL),
         transflag(false),
         transpose_in_2d_inplace(false),
         twiddles(NULL),
@@ -630,9 +1256,11 @@ class FFTPlan {
         transOutHorizontal(false),
         large1D(0),
         large2D(false),
+        stridedColumns(false),
         RCsimple(false),
         realSpecial(false),
         realSpecial_Nr(0),
+        realPair(false),
         userPlan(false),
         allOpsInplace(false),
         blockCompute(false),
@@ -642,12 +1270,24 @@ class FFTPlan {
         nonSquareKernelOrder(NOT_A_TRANSPOSE),
         hcfftlibtype(HCFFT_R2CD2Z),
         exist(false),
-        transformed(false) {
+        transformed(false),
+        scratchBytes(0),
+        launchBytes(0),
+        loadCallbackInfo(NULL),
+        storeCallbackInfo(NULL) {
     originalLength.clear();
   }
 
-  hcfftStatus hcfftCreateDefaultPlan(hcfftPlanHandle* plHandle,
-                                     hcfftDim dimension, const size_t* length,
+  //  Rank of the transform; plans above HCFFT_3D keep HCFFT_3D in dimension
+  //  and hold one length per axis
+  size_t Rank() const {
+    return (dimension == HCFFT_3D && length.size() > 3)
+               ? length.size()
+               : static_cast<size_t>(dimension);
+  }
+
+  hcfftStatus hcfftCreateDefaultPlan(hcfftPlanHandle* plHandle, size_t rank,
+                                     const size_t* length,
                                      hcfftDirection dir,
                                      hcfftPrecision precision,
                                      hcfftLibType libType);
@@ -668,6 +1308,68 @@ class FFTPlan {
                                             hcfftDirection dir, T* inputBuffers,
                                             T* outputBuffers, T* tmpBuffer);
 
+  template <typename T>
+  hcfftStatus hcfftEnqueueOutOfCore(hcfftPlanHandle plHandle,
+                                    hcfftDirection dir, T* hostInput,
+                                    T* hostOutput);
+
+  template <typename T>
+  hcfftStatus hcfftEnqueueDevices(hcfftPlanHandle plHandle,
+                                  hcfftDirection dir, hcfftIpLayout iLayout,
+                                  hcfftOpLayout oLayout, T* hostInput,
+                                  T* hostOutput);
+
+  template <typename T>
+  hcfftStatus hcfftEnqueueDistributed(hcfftPlanHandle plHandle,
+                                      hcfftDirection dir,
+                                      hcfftXtDistributedArray* array);
+
+  hcfftStatus hcfftMallocDistributed(hcfftPlanHandle plHandle,
+                                     hcfftXtDistributedArray** array);
+
+  hcfftStatus hcfftFreeDistributed(hcfftXtDistributedArray* array);
+
+  hcfftStatus hcfftCopyDistributed(hcfftPlanHandle plHandle,
+                                   hcfftXtDistributedArray* array, void* host,
+                                   bool toArray);
+
+  template <typename T>
+  hcfftStatus hcfftEnqueueHost(hcfftPlanHandle plHandle, hcfftDirection dir,
+                               hcfftIpLayout iLayout, hcfftOpLayout oLayout,
+                               T* hostInput, T* hostOutput);
+
+  //  Run the plan on the CPU. deviceData tells the buffers are accelerator
+  //  memory, copied to and from the host around the transform
+  template <typename T>
+  hcfftStatus hcfftEnqueueOnHost(hcfftPlanHandle plHandle, hcfftDirection dir,
+                                 T* input, T* output, bool deviceData);
+
+  //  Whether the plan runs on the host, for data in accelerator memory or, if
+  //  hostData, in host memory
+  bool RunsOnHost(bool hostData) const;
+
+  //  Whether the precompiled kernels of libhcfft cover the plan, so baking it
+  //  generates and compiles nothing, see kernellibrary.cpp
+  bool LibraryPossible() const;
+
+  //  Bake the plan for the precompiled kernels: upload their twiddle table
+  hcfftStatus hcfftBakeLibrary();
+
+  //  Run a plan baked by hcfftBakeLibrary(), one launch per axis
+  template <typename T>
+  hcfftStatus hcfftEnqueueLibrary(hcfftPlanHandle plHandle, hcfftDirection dir,
+                                  T* input, T* output);
+
+  template <typename T>
+  hcfftStatus hcfftSpectralMAC(hcfftPlanHandle plHandle, size_t nImages,
+                               size_t nChannels, size_t nFilters, T* inSpectra,
+                               T* weights, T* outSpectra, bool accumulate,
+                               bool conjWeights);
+
+  hcfftStatus hcfftSetPlanCallback(hcfftPlanHandle plHandle,
+                                   const char* source, bool store,
+                                   void* callerInfo);
+
   hcfftStatus hcfftSetAcclView(hcfftPlanHandle plHandle,
                                hc::accelerator_view accl_view);
 
@@ -694,25 +1396,25 @@ class FFTPlan {
   hcfftStatus hcfftGetPlanDim(const hcfftPlanHandle plHandle, hcfftDim* dim,
                               int* size);
 
-  hcfftStatus hcfftSetPlanDim(hcfftPlanHandle plHandle, const hcfftDim dim);
+  hcfftStatus hcfftSetPlanDim(hcfftPlanHandle plHandle, const size_t rank);
 
   hcfftStatus hcfftGetPlanLength(const hcfftPlanHandle plHandle,
-                                 const hcfftDim dim, size_t* hcLengths);
+                                 const size_t rank, size_t* hcLengths);
 
-  hcfftStatus hcfftSetPlanLength(hcfftPlanHandle plHandle, const hcfftDim dim,
+  hcfftStatus hcfftSetPlanLength(hcfftPlanHandle plHandle, const size_t rank,
                                  const size_t* hcLengths);
 
   hcfftStatus hcfftGetPlanInStride(const hcfftPlanHandle plHandle,
-                                   const hcfftDim dim, size_t* hcStrides);
+                                   const size_t rank, size_t* hcStrides);
 
-  hcfftStatus hcfftSetPlanInStride(hcfftPlanHandle plHandle, const hcfftDim dim,
+  hcfftStatus hcfftSetPlanInStride(hcfftPlanHandle plHandle, const size_t rank,
                                    size_t* hcStrides);
 
   hcfftStatus hcfftGetPlanOutStride(const hcfftPlanHandle plHandle,
-                                    const hcfftDim dim, size_t* hcStrides);
+                                    const size_t rank, size_t* hcStrides);
 
   hcfftStatus hcfftSetPlanOutStride(hcfftPlanHandle plHandle,
-                                    const hcfftDim dim, size_t* hcStrides);
+                                    const size_t rank, size_t* hcStrides);
 
   hcfftStatus hcfftGetPlanDistance(const hcfftPlanHandle plHandle,
                                    size_t* iDist, size_t* oDist);
@@ -732,12 +1434,50 @@ class FFTPlan {
   hcfftStatus hcfftSetResultLocation(hcfftPlanHandle plHandle,
                                      hcfftResLocation placeness);
 
+  hcfftStatus hcfftGetExecPlan(hcfftPlanHandle plHandle,
+                               hcfftResLocation placeness,
+                               hcfftIpLayout iLayout, hcfftOpLayout oLayout,
+                               hcfftPlanHandle* execHandle);
+
   hcfftStatus hcfftGetPlanTransposeResult(const hcfftPlanHandle plHandle,
                                           hcfftResTransposed* transposed);
 
   hcfftStatus hcfftSetPlanTransposeResult(hcfftPlanHandle plHandle,
                                           hcfftResTransposed transposed);
 
+  hcfftStatus hcfftGetPlanColumnMethod(const hcfftPlanHandle plHandle,
+                                       hcfftColumnMethod* method);
+
+  hcfftStatus hcfftSetPlanColumnMethod(hcfftPlanHandle plHandle,
+                                       hcfftColumnMethod method);
+
+  hcfftStatus hcfftGetPlanStreamMemory(const hcfftPlanHandle plHandle,
+                                       size_t* bytes);
+
+  hcfftStatus hcfftSetPlanStreamMemory(hcfftPlanHandle plHandle,
+                                       size_t bytes);
+
+  hcfftStatus hcfftSetPlanDeviceSet(hcfftPlanHandle plHandle,
+                                    FFTDeviceSet* devices);
+
+  hcfftStatus hcfftSetPlanExchange(hcfftPlanHandle plHandle,
+                                   FFTExchange* transport);
+
+  hcfftStatus hcfftGetPlanBackend(const hcfftPlanHandle plHandle,
+                                  hcfftBackend* backend);
+
+  hcfftStatus hcfftSetPlanBackend(hcfftPlanHandle plHandle,
+                                  hcfftBackend backend);
+
+  hcfftStatus hcfftGetPlanCost(hcfftPlanHandle plHandle,
+                               const FFTRoofline& roofline,
+                               std::vector<FFTKernelCost>* costs);
+
+  hcfftStatus hcfftExplainPlan(hcfftPlanHandle plHandle, FFTPlanNode* root);
+
+  hcfftStatus hcfftGetPlanBakeTimes(hcfftPlanHandle plHandle,
+                                    FFTBakeTimes* times);
+
   hcfftStatus GetEnvelope(const FFTEnvelope**) const;
 
   hcfftStatus SetEnvelope();
@@ -757,6 +1497,9 @@ class FFTPlan {
                                 FFTRepo& fftRepo, size_t count,
                                 bool exist) const;
 
+  template <hcfftGenerators G>
+  hcfftStatus GetKernelCostPvt(FFTKernelCost* cost) const;
+
   hcfftStatus GetMax1DLength(size_t* longtest) const;
 
   hcfftStatus GetKernelGenKey(FFTKernelGenKeyParams& params) const;
@@ -767,9 +1510,14 @@ class FFTPlan {
   hcfftStatus GenerateKernel(const hcfftPlanHandle plHandle, FFTRepo& fftRepo,
                              size_t count, bool exist) const;
 
+  hcfftStatus GetKernelCost(FFTKernelCost* cost) const;
+
   hcfftStatus ReleaseBuffers();
 
   size_t ElementSize() const;
+
+  //  Bytes of 'elements' values stored in 'layout'
+  double LayoutBytes(hcfftIpLayout layout, double elements) const;
 };
 
 class FFTRepo {
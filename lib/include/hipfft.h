@@ -43,7 +43,10 @@ typedef enum hipfftType_t {
   HIPFFT_C2C = 0x29,  // Complex to complex (interleaved)
   HIPFFT_D2Z = 0x6a,  // Double to double-complex (interleaved)
   HIPFFT_Z2D = 0x6c,  // Double-complex (interleaved) to double
-  HIPFFT_Z2Z = 0x69   // Double-complex to double-complex (interleaved)
+  HIPFFT_Z2Z = 0x69,  // Double-complex to double-complex (interleaved)
+  HIPFFT_R2C_HALF = 0x0a,  // Half to half-complex, computed in fp32
+  HIPFFT_C2R_HALF = 0x0c,  // Half-complex to half, computed in fp32
+  HIPFFT_C2C_HALF = 0x09   // Half-complex to half-complex, computed in fp32
 } hipfftType;
 
 typedef enum hipfftResult_t {
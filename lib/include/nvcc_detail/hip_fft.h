@@ -34,6 +34,12 @@ typedef cufftComplex hipfftComplex;
 typedef cufftDoubleComplex hipfftDoubleComplex;
 typedef cufftReal hipfftReal;
 typedef cufftDoubleReal hipfftDoubleReal;
+// IEEE 754 binary16 bit patterns
+typedef unsigned short hipfftHalf;
+typedef struct {
+  unsigned short x;
+  unsigned short y;
+} hipfftHalfComplex;
 typedef cudaStream_t hipStream_t;
 
 hipfftResult hipCUFFTResultToHIPFFTResult(cufftResult cuResult);
@@ -151,6 +157,15 @@ hipfftResult hipfftExecC2R(hipfftHandle plan, hipfftComplex *idata,
 hipfftResult hipfftExecZ2D(hipfftHandle plan, hipfftDoubleComplex *idata,
                            hipfftDoubleReal *odata);
 
+hipfftResult hipfftExecC2CHalf(hipfftHandle plan, hipfftHalfComplex *idata,
+                               hipfftHalfComplex *odata, int direction);
+
+hipfftResult hipfftExecR2CHalf(hipfftHandle plan, hipfftHalf *idata,
+                               hipfftHalfComplex *odata);
+
+hipfftResult hipfftExecC2RHalf(hipfftHandle plan, hipfftHalfComplex *idata,
+                               hipfftHalf *odata);
+
 #ifdef __cplusplus
 }
 #endif
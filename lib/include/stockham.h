@@ -24,7 +24,10 @@ THE SOFTWARE.
 #define LIB_INCLUDE_STOCKHAM_H_
 
 #include "include/hcfftlib.h"
+#include <algorithm>
 #include <cassert>
+#include <cctype>
+#include <cstring>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -62,11 +65,13 @@ inline std::stringstream& hcKernWrite(std::stringstream& rhs,
   return rhs;
 }
 
+inline CodeEmitter& hcKernWrite(CodeEmitter& rhs, const size_t tabIndex) {
+  return rhs.Indent(tabIndex);
+}
+
 inline std::string FloatToStr(double f) {
-  std::stringstream ss;
-  ss.precision(16);
-  ss << std::scientific << f;
-  return ss.str();
+  char digits[CodeEmitter::kNumberChars];
+  return std::string(digits, CodeEmitter::FormatDouble(f, digits));
 }
 
 typedef std::pair<std::string, std::string> stringpair;
@@ -162,6 +167,22 @@ inline std::string FloatSuffix() {
   return sfx;
 }
 
+// Global memory types of half precision storage. Registers, LDS and
+// twiddles stay in fp32, conversions happen on every global access.
+inline std::string HalfBaseType(size_t count) {
+  switch (count) {
+    case 1:
+      return "hcfft_half";
+
+    case 2:
+      return "hcfft_half_2";
+
+    default:
+      assert(false);
+      return "";
+  }
+}
+
 inline std::string ButterflyName(size_t radix, size_t count, bool fwd,
                                  const hcfftPlanHandle plHandle) {
   std::string str;
@@ -203,6 +224,323 @@ inline std::string TwTableLargeName() { return "twiddle_dee"; }
 
 inline std::string TwTableLargeFunc() { return "TW3step"; }
 
+// Entries of the TwiddleTableLarge of a transform of length N
+inline size_t TwTableLargeSize(size_t N) {
+  return (size_t(1) << ARBITRARY::TWIDDLE_DEE) *
+         DivRoundingUp<size_t>(CeilPo2(N), ARBITRARY::TWIDDLE_DEE);
+}
+
+// Namespace holding the user load/store callback snippets of a kernel
+inline std::string CallbackScope(size_t count) {
+  std::string str = "hcfftCallbacks";
+  str += SztToStr(count);
+  return str;
+}
+
+// Wrap the user callback snippets into the namespace of a kernel, so that
+// several kernels of a plan can share one source file
+inline std::string CallbackSource(const std::string& loadSrc,
+                                  const std::string& storeSrc, size_t count) {
+  std::string str;
+
+  if (loadSrc.empty() && storeSrc.empty()) {
+    return str;
+  }
+
+  str += "\nnamespace ";
+  str += CallbackScope(count);
+  str += " {\n";
+  str += loadSrc;
+  str += "\n";
+  str += storeSrc;
+  str += "\n}\n\n";
+  return str;
+}
+
+// Offset of buffer[offset] from base, the start of the user buffer that
+// buffer points into
+inline std::string CallbackOffset(const std::string& buffer,
+                                  const std::string& offset,
+                                  const std::string& base) {
+  return "(" + buffer + " - (decltype(" + buffer + "))" + base + ") + (" +
+         offset + ")";
+}
+
+// Expression reading buffer[offset], through the load callback if requested.
+// The callback is given the user input buffer cbIn and the offset from its
+// start.
+inline std::string CallbackLoad(const std::string& buffer,
+                                const std::string& offset, size_t count,
+                                bool callback) {
+  std::string str;
+
+  if (callback) {
+    str += CallbackScope(count);
+    str += "::hcfft_load_callback((decltype(";
+    str += buffer;
+    str += "))cbIn, ";
+    str += CallbackOffset(buffer, offset, "cbIn");
+    str += ", loadInfo)";
+  } else {
+    str += buffer;
+    str += "[";
+    str += offset;
+    str += "]";
+  }
+
+  return str;
+}
+
+// Statement writing value to buffer[offset], through the store callback if
+// requested. The callback is given the user output buffer cbOut and the offset
+// from its start.
+inline std::string CallbackStore(const std::string& buffer,
+                                 const std::string& offset,
+                                 const std::string& value, size_t count,
+                                 bool callback) {
+  std::string str;
+
+  if (callback) {
+    str += CallbackScope(count);
+    str += "::hcfft_store_callback((decltype(";
+    str += buffer;
+    str += "))cbOut, ";
+    str += CallbackOffset(buffer, offset, "cbOut");
+    str += ", ";
+    str += value;
+    str += ", storeInfo);";
+  } else {
+    str += buffer;
+    str += "[";
+    str += offset;
+    str += "] = ";
+    str += value;
+    str += ";";
+  }
+
+  return str;
+}
+
+// Components of a register type, 0 for integer types and -1 for a token that
+// is not a type
+inline int TypeWidth(const std::string& token) {
+  if ((token == "float") || (token == "double")) {
+    return 1;
+  }
+
+  if ((token == "float_2") || (token == "double_2")) {
+    return 2;
+  }
+
+  if ((token == "float_4") || (token == "double_4")) {
+    return 4;
+  }
+
+  if ((token == "int") || (token == "uint") || (token == "unsigned") ||
+      (token == "size_t") || (token == "bool")) {
+    return 0;
+  }
+
+  return -1;
+}
+
+// Binary arithmetic operators of expr, each counted 'width' times unless it is
+// inside the arguments of a call like float_2(a.x * b.x, ...), where it works
+// on a single component. Index expressions and unary signs are not counted
+inline size_t ExprFlops(const std::string& expr, size_t width) {
+  std::vector<bool> parens;  // true for parentheses that open a call
+  size_t brackets = 0;
+  bool operand = false;  // the previous token ends an operand
+  size_t flops = 0;
+
+  for (size_t i = 0; i < expr.size(); i++) {
+    char c = expr[i];
+
+    if (isalpha(c) || (c == '_')) {
+      while ((i + 1 < expr.size()) &&
+             (isalnum(expr[i + 1]) || (expr[i + 1] == '_'))) {
+        i++;
+      }
+
+      operand = true;
+    } else if (isdigit(c) || ((c == '.') && (i + 1 < expr.size()) &&
+                              isdigit(expr[i + 1]))) {
+      // Numeric literal, the sign of an exponent included
+      while ((i + 1 < expr.size()) &&
+             (isalnum(expr[i + 1]) || (expr[i + 1] == '.') ||
+              (((expr[i + 1] == '+') || (expr[i + 1] == '-')) &&
+               ((expr[i] == 'e') || (expr[i] == 'E'))))) {
+        i++;
+      }
+
+      operand = true;
+    } else if (c == '(') {
+      parens.push_back(operand);
+      operand = false;
+    } else if (c == ')') {
+      if (!parens.empty()) {
+        parens.pop_back();
+      }
+
+      operand = true;
+    } else if (c == '[') {
+      brackets++;
+      operand = false;
+    } else if (c == ']') {
+      if (brackets > 0) {
+        brackets--;
+      }
+
+      operand = true;
+    } else if ((c == '+') || (c == '-') || (c == '*') || (c == '/')) {
+      if (operand && (brackets == 0)) {
+        bool scalar = std::find(parens.begin(), parens.end(), true) !=
+                      parens.end();
+        flops += scalar ? 1 : width;
+      }
+
+      operand = false;
+    } else if ((c != '.') && !isspace(c)) {
+      operand = false;
+    }
+  }
+
+  return flops;
+}
+
+// Floating point operations of straight-line generated code such as a
+// butterfly function. Assignments to integers are skipped, vector operations
+// count once per component
+inline size_t CountFlops(const std::string& code) {
+  std::string src;
+
+  // Drop the comments
+  for (size_t i = 0; i < code.size(); i++) {
+    if (code.compare(i, 2, "/*") == 0) {
+      size_t end = code.find("*/", i + 2);
+      i = (end == std::string::npos) ? code.size() : end + 1;
+    } else if (code.compare(i, 2, "//") == 0) {
+      size_t end = code.find('\n', i);
+      i = (end == std::string::npos) ? code.size() : end;
+    } else {
+      src += code[i];
+    }
+  }
+
+  // Widths of the declared variables and pointer parameters
+  std::map<std::string, int> widths;
+  int declWidth = -1;
+
+  for (size_t i = 0; i < src.size(); i++) {
+    char c = src[i];
+
+    if (isalpha(c) || (c == '_')) {
+      size_t start = i;
+
+      while ((i + 1 < src.size()) &&
+             (isalnum(src[i + 1]) || (src[i + 1] == '_'))) {
+        i++;
+      }
+
+      std::string token = src.substr(start, i - start + 1);
+      int width = TypeWidth(token);
+
+      if (width >= 0) {
+        declWidth = width;
+      } else if (declWidth >= 0) {
+        widths[token] = declWidth;
+      }
+    } else if (!isspace(c) && (c != '*') && (c != ',')) {
+      declWidth = -1;
+    }
+  }
+
+  size_t flops = 0;
+  size_t begin = 0;
+
+  while (begin < src.size()) {
+    size_t end = src.find(';', begin);
+
+    if (end == std::string::npos) {
+      end = src.size();
+    }
+
+    std::string stmt = src.substr(begin, end - begin);
+    begin = end + 1;
+    size_t brace = stmt.find_last_of("{}");
+
+    if (brace != std::string::npos) {
+      stmt = stmt.substr(brace + 1);
+    }
+
+    // The assignment at the top level, loop headers have none
+    size_t depth = 0;
+    size_t assign = std::string::npos;
+
+    for (size_t i = 0; i < stmt.size(); i++) {
+      char c = stmt[i];
+
+      if ((c == '(') || (c == '[')) {
+        depth++;
+      } else if (((c == ')') || (c == ']')) && (depth > 0)) {
+        depth--;
+      } else if ((c == '=') && (depth == 0)) {
+        bool cmp = ((i + 1 < stmt.size()) && (stmt[i + 1] == '=')) ||
+                   ((i > 0) && (strchr("=!<>", stmt[i - 1]) != NULL));
+
+        if (!cmp) {
+          assign = i;
+          break;
+        }
+      }
+    }
+
+    if ((assign == std::string::npos) || (assign == 0)) {
+      continue;
+    }
+
+    bool compound = strchr("+-*/", stmt[assign - 1]) != NULL;
+    std::string lhs = stmt.substr(0, compound ? assign - 1 : assign);
+    std::istringstream tokens(lhs);
+    std::string first;
+    tokens >> first;
+    int width = TypeWidth(first);
+
+    if (width < 0) {
+      size_t last = lhs.find_last_not_of(" \t\n");
+      size_t name = lhs.find_first_not_of(" \t\n(");
+      size_t nameEnd = lhs.find_first_of(" \t\n()[.", name);
+      std::string var = lhs.substr(name, nameEnd - name);
+
+      if ((last >= 1) && (lhs[last - 1] == '.')) {
+        width = 1;  // .x or .y of a register
+      } else if (widths.find(var) != widths.end()) {
+        width = widths[var];
+      } else {
+        width = 1;
+      }
+    } else {
+      std::string type;
+
+      // The last type of a declaration like "unsigned int b = ..."
+      while (tokens >> type) {
+        if (TypeWidth(type) >= 0) {
+          width = TypeWidth(type);
+        }
+      }
+    }
+
+    if (width == 0) {
+      continue;
+    }
+
+    flops += ExprFlops(stmt.substr(assign + 1), width);
+    flops += compound ? width : 0;
+  }
+
+  return flops;
+}
+
 // Twiddle factors table for large N
 // used in 3-step algorithm
 template <typename T, Precision PR>
@@ -227,6 +565,7 @@ class TwiddleTableLarge {
   }
 
   void TwiddleLargeAV(void** twiddleslarge, hc::accelerator acc) {
+    FFTBakeTimer timer(BAKE_TWIDDLES);
     const double TWO_PI = -6.283185307179586476925286766559;
     // Generate the table
     size_t nt = 0;
@@ -250,21 +589,20 @@ class TwiddleTableLarge {
     hc::accelerator_view accl_view = acc.get_default_view();
     accl_view.copy(wc, *twiddleslarge, Y * X * sizeof(T));
     assert(*twiddleslarge != NULL);
+    FFTMetrics::Add(METRIC_TWIDDLE_BYTES, Y * X * sizeof(T));
   }
 
-  void GenerateTwiddleTable(std::string& twStr,
-                            const hcfftPlanHandle plHandle) {
-    std::stringstream ss;
+  void GenerateTwiddleTable(CodeEmitter& ss, const hcfftPlanHandle plHandle) {
     // Twiddle calc function
     ss << "inline ";
     ss << RegBaseType<PR>(2);
     ss << "\n" << TwTableLargeFunc();
-    ss << SztToStr(plHandle);
+    ss << plHandle;
     ss << "(size_t u, ";
     ss << RegBaseType<PR>(2);
     ss << " *";
     ss << TwTableLargeName();
-    ss << ")  __attribute__((hc))\n{\n";
+    ss << ")  [[hc]]\n{\n";
     ss << "\t"
           "size_t j = u & "
        << unsigned(X - 1) << ";\n";
@@ -275,10 +613,7 @@ class TwiddleTableLarge {
     ss << "[j];\n";
 
     for (size_t iY = 1; iY < Y; ++iY) {
-      std::string phasor = TwTableLargeName();
-      phasor += "[";
-      phasor += SztToStr(iY * X);
-      phasor += "+ j]";
+      std::string phasor = TwTableLargeName() + "[" + SztToStr(iY * X) + "+ j]";
       stringpair product =
           ComplexMul((RegBaseType<PR>(2)).c_str(), "result", phasor.c_str());
       ss << "\t"
@@ -297,7 +632,6 @@ class TwiddleTableLarge {
 
     ss << "\t"
           "return result;\n}\n\n";
-    twStr += ss.str();
   }
 };
 
@@ -313,7 +647,7 @@ class Butterfly {
     return (N < 2) ? n : (BitReverse(n >> 1, N >> 1) |
                           ((n & 1) != 0 ? (N >> 1) : 0));
   }
-  void GenerateButterflyStr(std::string& bflyStr,
+  void GenerateButterflyStr(CodeEmitter& bflyStr,
                             const hcfftPlanHandle plHandle) const {
     std::string regType = cReg ? RegBaseType<PR>(2) : RegBaseType<PR>(count);
     // Function attribute
@@ -329,18 +663,18 @@ class Butterfly {
         bflyStr += " *R";
 
         if (radix & (radix - 1)) {
-          bflyStr += SztToStr(i);
+          bflyStr << i;
         } else {
-          bflyStr += SztToStr(BitReverse(i, radix));
+          bflyStr << BitReverse(i, radix);
         }
       } else {
         bflyStr += regType;
         bflyStr += " *R";
-        bflyStr += SztToStr(i);
+        bflyStr << i;
         bflyStr += ", ";  // real arguments
         bflyStr += regType;
         bflyStr += " *I";
-        bflyStr += SztToStr(i);  // imaginary arguments
+        bflyStr << i;  // imaginary arguments
       }
 
       if (i == radix - 1) {
@@ -351,7 +685,7 @@ class Butterfly {
       }
     }
 
-    bflyStr += " __attribute__((hc))\n{\n\n";
+    bflyStr += " [[hc]]\n{\n\n";
 
     // Temporary variables
     // Allocate temporary variables if we are not using complex registers (cReg
@@ -370,10 +704,10 @@ class Butterfly {
 
         for (size_t i = 0;; i++) {
           bflyStr += " TR";
-          bflyStr += SztToStr(i);
+          bflyStr << i;
           bflyStr += ",";  // real arguments
           bflyStr += " TI";
-          bflyStr += SztToStr(i);  // imaginary arguments
+          bflyStr << i;  // imaginary arguments
 
           if (i == radix - 1) {
             bflyStr += ";";
@@ -1753,13 +2087,11 @@ class Butterfly {
 
         if (!cReg) {
           for (size_t i = 0; i < 10; i++) {
-            bflyStr +=
-                regType + " pr" + SztToStr(i) + ", pi" + SztToStr(i) + ";\n\t";
+            bflyStr << regType << " pr" << i << ", pi" << i << ";\n\t";
           }
 
           for (size_t i = 0; i < 9; i++) {
-            bflyStr +=
-                regType + " qr" + SztToStr(i) + ", qi" + SztToStr(i) + ";\n\t";
+            bflyStr << regType << " qr" << i << ", qi" << i << ";\n\t";
           }
 
           if (fwd) {
@@ -1769,11 +2101,11 @@ class Butterfly {
           }
         } else {
           for (size_t i = 0; i < 10; i++) {
-            bflyStr += regType + " p" + SztToStr(i) + ";\n\t";
+            bflyStr << regType << " p" << i << ";\n\t";
           }
 
           for (size_t i = 0; i < 9; i++) {
-            bflyStr += regType + " q" + SztToStr(i) + ";\n\t";
+            bflyStr << regType << " q" << i << ";\n\t";
           }
 
           if (fwd) {
@@ -3816,26 +4148,26 @@ class Butterfly {
           if (cReg) {
             if ((radix != 7) && (radix != 11) && (radix != 13)) {
               bflyStr += "((R";
-              bflyStr += SztToStr(i);
+              bflyStr << i;
               bflyStr += "[0]).x) = TR";
-              bflyStr += SztToStr(i);
+              bflyStr << i;
               bflyStr += "; ";
               bflyStr += "((R";
-              bflyStr += SztToStr(i);
+              bflyStr << i;
               bflyStr += "[0]).y) = TI";
-              bflyStr += SztToStr(i);
+              bflyStr << i;
               bflyStr += ";\n\t";
             }
           } else {
             bflyStr += "(R";
-            bflyStr += SztToStr(i);
+            bflyStr << i;
             bflyStr += "[0]) = TR";
-            bflyStr += SztToStr(i);
+            bflyStr << i;
             bflyStr += "; ";
             bflyStr += "(I";
-            bflyStr += SztToStr(i);
+            bflyStr << i;
             bflyStr += "[0]) = TI";
-            bflyStr += SztToStr(i);
+            bflyStr << i;
             bflyStr += ";\n\t";
           }
         }
@@ -3846,13 +4178,13 @@ class Butterfly {
 
         if (i < j) {
           bflyStr += "T = (R";
-          bflyStr += SztToStr(i);
+          bflyStr << i;
           bflyStr += "[0]); (R";
-          bflyStr += SztToStr(i);
+          bflyStr << i;
           bflyStr += "[0]) = (R";
-          bflyStr += SztToStr(j);
+          bflyStr << j;
           bflyStr += "[0]); (R";
-          bflyStr += SztToStr(j);
+          bflyStr << j;
           bflyStr += "[0]) = T;\n\t";
         }
       }
@@ -3865,7 +4197,7 @@ class Butterfly {
   Butterfly(size_t radixVal, size_t countVal, bool fwdVal, bool cRegVal)
       : radix(radixVal), count(countVal), fwd(fwdVal), cReg(cRegVal) {}
 
-  void GenerateButterfly(std::string& bflyStr,
+  void GenerateButterfly(CodeEmitter& bflyStr,
                          const hcfftPlanHandle plHandle) const {
     assert(count <= 4);
 
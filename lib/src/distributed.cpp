@@ -0,0 +1,735 @@
+/*
+Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "include/stockham.h"
+#include <dlfcn.h>
+#include <map>
+#include <thread>
+
+// Distributed 3D transforms
+//
+//   A 3D C2C (Z2Z) transform of Nx x Ny x Nz is spread over the devices of
+//   the plan in slabs. Device d holds the z planes [z0(d), z0(d) + nz(d)) in
+//   natural order ([z][y][x], x fastest) and transforms them with a local 2D
+//   plan batched over its planes. An all-to-all exchange then gives device e
+//   the y planes [y0(e), y0(e) + ny(e)) of the whole volume, z fastest
+//   ([y][x][z]), and a local 1D plan transforms along z. The array is left
+//   in these y slabs ("shuffled"); transforming a shuffled array runs the
+//   passes in the opposite order and returns it to z slabs.
+//
+//   An exchange packs, on every source device, one contiguous block per
+//   destination; the transport delivers every block into the data buffer of
+//   its destination, which is free once all devices have packed; every
+//   destination then unpacks its blocks into its scratch buffer, and data and
+//   scratch swap. Packing and unpacking are strided copies run by a
+//   generated kernel.
+//
+//   Shares of planes follow the weights of the device set.
+
+namespace Distributed {
+//  Slab decomposition of a plan over its devices
+struct Slabs {
+  size_t nx, ny, nz;
+  std::vector<size_t> zFirst, zCount;  // z planes of every device
+  std::vector<size_t> yFirst, yCount;  // y planes of every device
+
+  size_t Capacity(size_t d) const {
+    return std::max(nx * ny * zCount[d], nx * yCount[d] * nz);
+  }
+};
+
+static std::vector<size_t> Prefix(const std::vector<size_t>& counts) {
+  std::vector<size_t> first(counts.size(), 0);
+
+  for (size_t d = 1; d < counts.size(); d++) {
+    first[d] = first[d - 1] + counts[d - 1];
+  }
+
+  return first;
+}
+
+static hcfftStatus GetSlabs(const FFTPlan* fftPlan, Slabs* slabs) {
+  if (fftPlan->dimension != HCFFT_3D ||
+      fftPlan->hcfftlibtype != HCFFT_C2CZ2Z ||
+      fftPlan->precision == HCFFT_HALF || fftPlan->batchSize != 1 ||
+      fftPlan->deviceSet == NULL) {
+    return HCFFT_INVALID;
+  }
+
+  slabs->nx = fftPlan->length[0];
+  slabs->ny = fftPlan->length[1];
+  slabs->nz = fftPlan->length[2];
+  slabs->zCount = fftPlan->deviceSet->Split(slabs->nz);
+  slabs->yCount = fftPlan->deviceSet->Split(slabs->ny);
+  slabs->zFirst = Prefix(slabs->zCount);
+  slabs->yFirst = Prefix(slabs->yCount);
+  return HCFFT_SUCCEEDS;
+}
+
+//  dst[i0 * d0 + i1 * d1 + i2 * d2] = src[i0 * s0 + i1 * s1 + i2 * s2] for
+//  every i in [0, n0) x [0, n1) x [0, n2)
+template <StockhamGenerator::Precision PR>
+class CopyKernel {
+ public:
+  void GenerateKernel(std::string& str) {
+    std::string r2Type = StockhamGenerator::RegBaseType<PR>(2);
+    // Kernel begin
+    str += "extern \"C\"\n { void exchange_copy";
+    str +=
+        "(std::map<int, void*> vectArr, uint batchSize, accelerator_view "
+        "&acc_view, accelerator &acc)";
+    str += "{\n\t";
+    str += r2Type + " *src = static_cast<" + r2Type + "*> (vectArr[0]);\n\t";
+    str += r2Type + " *dst = static_cast<" + r2Type + "*> (vectArr[1]);\n\t";
+    // Extents and strides are passed by value
+    str += "unsigned long *g = ";
+    str += "static_cast<unsigned long*> (vectArr[2]);\n\t";
+    str += "unsigned long n0 = g[0], n1 = g[1];\n\t";
+    str += "unsigned long count = g[0] * g[1] * g[2];\n\t";
+    str += "unsigned long s0 = g[3], s1 = g[4], s2 = g[5];\n\t";
+    str += "unsigned long d0 = g[6], d1 = g[7], d2 = g[8];\n";
+    str += "\thc::extent<2> grdExt( ((count + 63) / 64) * 64, 1 ); \n";
+    str += "\thc::tiled_extent<2> t_ext = grdExt.tile( 64, 1);\n";
+    str +=
+        "\thc::parallel_for_each(acc_view, t_ext, [=] (hc::tiled_index<2> "
+        "tidx) [[hc]]\n\t {\n\t";
+    str += "unsigned long i = tidx.global[0];\n\t";
+    str += "if (i < count)\n\t{\n\t";
+    str += "unsigned long i0 = i % n0;\n\t";
+    str += "unsigned long i1 = (i / n0) % n1;\n\t";
+    str += "unsigned long i2 = i / (n0 * n1);\n\t";
+    str += "dst[i0 * d0 + i1 * d1 + i2 * d2] = ";
+    str += "src[i0 * s0 + i1 * s1 + i2 * s2];\n\t";
+    str += "}\n";
+    str += " }).wait();\n}}\n\n";
+  }
+};
+
+typedef void(FUNC_ExchangeCopy)(std::map<int, void*>* vectArr,
+                                uint batchSize,
+                                hc::accelerator_view& acc_view,
+                                hc::accelerator& acc);
+//  Kernels already loaded in this process, keyed by shared object name
+static std::map<std::string, FUNC_ExchangeCopy*> copyKernels;
+static lockRAII copyLock(_T("exchangeCopy"));
+
+static hcfftStatus GetCopyKernel(hcfftPrecision precision,
+                                 FUNC_ExchangeCopy** kernel) {
+  std::string kernellib = getKernelCacheDir();
+  kernellib += "/libexchange";
+  kernellib += (precision == HCFFT_DOUBLE) ? "D_" : "F_";
+  kernellib += ".so";
+  scopedLock kLock(copyLock, _T(" exchange copy kernels"));
+  std::map<std::string, FUNC_ExchangeCopy*>::iterator it =
+      copyKernels.find(kernellib);
+
+  if (it != copyKernels.end()) {
+    *kernel = it->second;
+    return HCFFT_SUCCEEDS;
+  }
+
+  if (access(kernellib.c_str(), F_OK) == -1) {
+    std::string programCode = hcHeader();
+
+    if (precision == HCFFT_DOUBLE) {
+      CopyKernel<StockhamGenerator::P_DOUBLE> copyKernel;
+      copyKernel.GenerateKernel(programCode);
+    } else {
+      CopyKernel<StockhamGenerator::P_SINGLE> copyKernel;
+      copyKernel.GenerateKernel(programCode);
+    }
+
+    std::string pwd = getKernelCacheDir();
+    pwd += "/";
+    struct stat st = {0};
+
+    if (stat(pwd.c_str(), &st) == -1) {
+      mkdir(pwd.c_str(), 0777);
+    }
+
+    std::string filename = kernellib.substr(0, kernellib.size() - 3);
+    filename.replace(filename.rfind("libexchange"), 11, "exchange");
+    filename += ".cpp";
+    FILE* fp = fopen(filename.c_str(), "w");
+
+    if (!fp) {
+      std::cout << " File " << filename << " open failed for writing "
+                << std::endl;
+      return HCFFT_ERROR;
+    }
+
+    fwrite(programCode.c_str(), programCode.size(), 1, fp);
+    fclose(fp);
+    hcfftStatus status = CompileSharedObject(filename, kernellib);
+    remove(filename.c_str());
+
+    if (status != HCFFT_SUCCEEDS) {
+      return HCFFT_ERROR;
+    }
+  }
+
+  void* handle = dlopen(kernellib.c_str(), RTLD_NOW);
+
+  if (!handle) {
+    std::cout << "Failed to load Kernel: " << kernellib << std::endl;
+    return HCFFT_ERROR;
+  }
+
+  *kernel = (FUNC_ExchangeCopy*)dlsym(handle, "exchange_copy");
+
+  if (!*kernel) {
+    std::cout << "failed to locate exchange_copy(): " << dlerror();
+    return HCFFT_ERROR;
+  }
+
+  copyKernels[kernellib] = *kernel;
+  return HCFFT_SUCCEEDS;
+}
+
+//  One strided copy on a device, offsets in elements
+struct StridedCopy {
+  size_t device;
+  void* src;
+  size_t srcOffset;
+  void* dst;
+  size_t dstOffset;
+  unsigned long geometry[9];  // n0..n2, source and destination strides
+};
+
+static StridedCopy MakeCopy(size_t device, void* src, size_t srcOffset,
+                            void* dst, size_t dstOffset, size_t n0, size_t n1,
+                            size_t n2, size_t s0, size_t s1, size_t s2,
+                            size_t d0, size_t d1, size_t d2) {
+  StridedCopy copy = {device, src, srcOffset, dst, dstOffset,
+                      {n0, n1, n2, s0, s1, s2, d0, d1, d2}};
+  return copy;
+}
+
+//  Run the copies of every device, devices in parallel
+static void RunCopies(FFTDeviceSet* devices, FUNC_ExchangeCopy* kernel,
+                      size_t elemBytes, std::vector<StridedCopy>* copies,
+                      size_t device) {
+  hc::accelerator acc = devices->Accelerator(device);
+  hc::accelerator_view view = devices->View(device);
+
+  for (size_t c = 0; c < copies->size(); c++) {
+    StridedCopy& copy = (*copies)[c];
+
+    if (copy.device != device) {
+      continue;
+    }
+
+    std::map<int, void*> vectArr;
+    vectArr.insert(std::make_pair(
+        0, static_cast<char*>(copy.src) + copy.srcOffset * elemBytes));
+    vectArr.insert(std::make_pair(
+        1, static_cast<char*>(copy.dst) + copy.dstOffset * elemBytes));
+    vectArr.insert(std::make_pair(2, copy.geometry));
+    kernel(&vectArr, 1, view, acc);
+  }
+}
+
+static void RunAllCopies(FFTDeviceSet* devices, FUNC_ExchangeCopy* kernel,
+                         size_t elemBytes, std::vector<StridedCopy>* copies) {
+  std::vector<std::thread> workers;
+
+  for (size_t d = 0; d < devices->Count(); d++) {
+    workers.push_back(
+        std::thread(RunCopies, devices, kernel, elemBytes, copies, d));
+  }
+
+  for (size_t w = 0; w < workers.size(); w++) {
+    workers[w].join();
+  }
+}
+
+//  Move the array between z slabs and y slabs
+static hcfftStatus Exchange(FFTPlan* fftPlan, const Slabs& slabs,
+                            hcfftXtDistributedArray* array) {
+  FFTDeviceSet* devices = fftPlan->deviceSet;
+  FUNC_ExchangeCopy* kernel = NULL;
+  hcfftStatus status = GetCopyKernel(fftPlan->precision, &kernel);
+
+  if (status != HCFFT_SUCCEEDS) {
+    return status;
+  }
+
+  const size_t nx = slabs.nx, ny = slabs.ny, nz = slabs.nz;
+  const size_t devCount = devices->Count();
+  std::vector<StridedCopy> packs, unpacks;
+  std::vector<FFTExchangeBlock> blocks;
+
+  // Block (d, e) of nz(d) x ny(e) x nx elements sits at offset
+  // y0(e) * nx * nz(d) among the blocks of z slab d and at offset
+  // z0(d) * nx * ny(e) among the blocks of y slab e
+  for (size_t d = 0; d < devCount; d++) {
+    for (size_t e = 0; e < devCount; e++) {
+      size_t zc = slabs.zCount[d], yc = slabs.yCount[e];
+
+      if (zc == 0 || yc == 0) {
+        continue;
+      }
+
+      size_t zBlock = slabs.yFirst[e] * nx * zc;
+      size_t yBlock = slabs.zFirst[d] * nx * yc;
+      FFTExchangeBlock block;
+      block.bytes = zc * yc * nx * array->elemBytes;
+
+      if (!array->shuffled) {
+        // [z][y][x] planes of d to a [y][x][z] block
+        packs.push_back(MakeCopy(d, array->data[d], slabs.yFirst[e] * nx,
+                                 array->scratch[d], zBlock, zc, nx, yc,
+                                 nx * ny, 1, nx, 1, zc, nx * zc));
+        block.srcDevice = d;
+        block.src = static_cast<char*>(array->scratch[d]) +
+                    zBlock * array->elemBytes;
+        block.dstDevice = e;
+        block.dst = static_cast<char*>(array->data[e]) +
+                    yBlock * array->elemBytes;
+        // The block into the [y][x][z] planes of e
+        unpacks.push_back(MakeCopy(e, array->data[e], yBlock,
+                                   array->scratch[e], slabs.zFirst[d], zc, nx,
+                                   yc, 1, zc, nx * zc, 1, nz, nx * nz));
+      } else {
+        // [y][x][z] planes of e to a [z][y][x] block
+        packs.push_back(MakeCopy(e, array->data[e], slabs.zFirst[d],
+                                 array->scratch[e], yBlock, nx, yc, zc, nz,
+                                 nx * nz, 1, 1, nx, nx * yc));
+        block.srcDevice = e;
+        block.src = static_cast<char*>(array->scratch[e]) +
+                    yBlock * array->elemBytes;
+        block.dstDevice = d;
+        block.dst = static_cast<char*>(array->data[d]) +
+                    zBlock * array->elemBytes;
+        // The block into the [z][y][x] planes of d
+        unpacks.push_back(MakeCopy(d, array->data[d], zBlock,
+                                   array->scratch[d], slabs.yFirst[e] * nx, nx,
+                                   yc, zc, 1, nx, nx * yc, 1, nx, nx * ny));
+      }
+
+      blocks.push_back(block);
+    }
+  }
+
+  RunAllCopies(devices, kernel, array->elemBytes, &packs);
+  FFTDeviceExchange direct;
+  FFTExchange* transport = fftPlan->exchange ? fftPlan->exchange : &direct;
+  status = transport->AllToAll(devices, blocks);
+
+  if (status != HCFFT_SUCCEEDS) {
+    return status;
+  }
+
+  RunAllCopies(devices, kernel, array->elemBytes, &unpacks);
+  array->data.swap(array->scratch);
+  array->shuffled = !array->shuffled;
+  return HCFFT_SUCCEEDS;
+}
+
+//  Bake (once) the local plan of a pass on a device
+static hcfftStatus GetSlabPlan(FFTPlan* fftPlan, size_t device,
+                               const std::vector<size_t>& lengths,
+                               size_t batch, bool scaled,
+                               FFTPlan** slabPlan,
+                               hcfftPlanHandle* execHandle) {
+  std::vector<size_t> key(1, STREAM_SLAB_PLAN);
+  key.push_back(device);
+  key.insert(key.end(), lengths.begin(), lengths.end());
+  key.push_back(batch);
+  FFTRepo& fftRepo = FFTRepo::getInstance();
+  std::map<std::vector<size_t>, hcfftPlanHandle>::iterator it =
+      fftPlan->streamPlans.find(key);
+  hcfftPlanHandle slabHandle;
+  lockRAII* slabLock = NULL;
+
+  if (it != fftPlan->streamPlans.end()) {
+    slabHandle = it->second;
+    fftRepo.getPlan(slabHandle, *slabPlan, slabLock);
+  } else {
+    hcfftStatus status = fftPlan->hcfftCreateDefaultPlan(
+        &slabHandle, lengths.size(), &lengths[0], HCFFT_BOTH,
+        fftPlan->precision, HCFFT_C2CZ2Z);
+
+    if (status != HCFFT_SUCCEEDS) {
+      return status;
+    }
+
+    fftRepo.getPlan(slabHandle, *slabPlan, slabLock);
+    (*slabPlan)->precision = fftPlan->precision;
+    (*slabPlan)->batchSize = batch;
+    (*slabPlan)->acc = fftPlan->deviceSet->Accelerator(device);
+    (*slabPlan)->acc_view = fftPlan->deviceSet->View(device);
+    fftPlan->streamPlans[key] = slabHandle;
+  }
+
+  // Only the z pass carries the scale of the user plan
+  double forwardScale = scaled ? fftPlan->forwardScale : 1.0;
+  double backwardScale = scaled ? fftPlan->backwardScale : 1.0;
+  FFTPlan* plan = *slabPlan;
+
+  if (plan->forwardScale != forwardScale ||
+      plan->backwardScale != backwardScale ||
+      plan->columnMethod != fftPlan->columnMethod) {
+    plan->forwardScale = forwardScale;
+    plan->backwardScale = backwardScale;
+    plan->columnMethod = fftPlan->columnMethod;
+    plan->baked = false;
+  }
+
+  return fftPlan->hcfftGetExecPlan(slabHandle, HCFFT_INPLACE,
+                                   HCFFT_COMPLEX_INTERLEAVED,
+                                   HCFFT_COMPLEX_INTERLEAVED, execHandle);
+}
+
+template <typename T>
+static void RunLocal(FFTPlan* slabPlan, hcfftPlanHandle execHandle,
+                     hcfftDirection dir, void* data, hcfftStatus* status) {
+  T* buffer = static_cast<T*>(data);
+  *status =
+      slabPlan->hcfftEnqueueTransform<T>(execHandle, dir, buffer, buffer, NULL);
+}
+
+//  Local transforms of every device: x and y over z slabs, or z over y slabs
+template <typename T>
+static hcfftStatus LocalPass(FFTPlan* fftPlan, const Slabs& slabs,
+                             hcfftXtDistributedArray* array,
+                             hcfftDirection dir) {
+  const size_t devCount = fftPlan->deviceSet->Count();
+  std::vector<FFTPlan*> plans(devCount, NULL);
+  std::vector<hcfftPlanHandle> handles(devCount, 0);
+  std::vector<hcfftStatus> status(devCount, HCFFT_SUCCEEDS);
+
+  // Bake every device before any of them starts
+  for (size_t d = 0; d < devCount; d++) {
+    std::vector<size_t> lengths;
+    size_t batch;
+
+    if (array->shuffled) {
+      lengths.push_back(slabs.nz);
+      batch = slabs.yCount[d] * slabs.nx;
+    } else {
+      lengths.push_back(slabs.nx);
+      lengths.push_back(slabs.ny);
+      batch = slabs.zCount[d];
+    }
+
+    if (batch == 0) {
+      continue;
+    }
+
+    hcfftStatus result = GetSlabPlan(fftPlan, d, lengths, batch,
+                                     array->shuffled, &plans[d], &handles[d]);
+
+    if (result != HCFFT_SUCCEEDS) {
+      return result;
+    }
+  }
+
+  std::vector<std::thread> workers;
+
+  for (size_t d = 0; d < devCount; d++) {
+    if (plans[d] != NULL) {
+      workers.push_back(std::thread(RunLocal<T>, plans[d], handles[d], dir,
+                                    array->data[d], &status[d]));
+    }
+  }
+
+  for (size_t w = 0; w < workers.size(); w++) {
+    workers[w].join();
+  }
+
+  for (size_t d = 0; d < devCount; d++) {
+    if (status[d] != HCFFT_SUCCEEDS) {
+      return status[d];
+    }
+  }
+
+  return HCFFT_SUCCEEDS;
+}
+
+static bool Matches(const Slabs& slabs, const hcfftXtDistributedArray* array,
+                    size_t elemBytes) {
+  return array->length.size() == 3 && array->length[0] == slabs.nx &&
+         array->length[1] == slabs.ny && array->length[2] == slabs.nz &&
+         array->elemBytes == elemBytes &&
+         array->data.size() == slabs.zCount.size();
+}
+};  // namespace Distributed
+
+hcfftStatus FFTDeviceExchange::AllToAll(
+    FFTDeviceSet* devices, const std::vector<FFTExchangeBlock>& blocks) {
+  std::vector<hc::completion_future> pending;
+
+  for (size_t b = 0; b < blocks.size(); b++) {
+    hc::accelerator_view view = devices->View(blocks[b].srcDevice);
+    pending.push_back(
+        view.copy_async(blocks[b].src, blocks[b].dst, blocks[b].bytes));
+  }
+
+  for (size_t p = 0; p < pending.size(); p++) {
+    pending[p].wait();
+  }
+
+  return HCFFT_SUCCEEDS;
+}
+
+//  Post the blocks a device sends, or collect the blocks it receives
+static void ServeMailbox(FFTDeviceSet* devices,
+                         const std::vector<FFTExchangeBlock>* blocks,
+                         const std::vector<size_t>* offsets, char* mailbox,
+                         size_t device, bool send) {
+  hc::accelerator_view view = devices->View(device);
+
+  for (size_t b = 0; b < blocks->size(); b++) {
+    const FFTExchangeBlock& block = (*blocks)[b];
+
+    if (send && block.srcDevice == device) {
+      view.copy(block.src, mailbox + (*offsets)[b], block.bytes);
+    } else if (!send && block.dstDevice == device) {
+      view.copy(mailbox + (*offsets)[b], block.dst, block.bytes);
+    }
+  }
+}
+
+hcfftStatus FFTSharedMemoryExchange::AllToAll(
+    FFTDeviceSet* devices, const std::vector<FFTExchangeBlock>& blocks) {
+  std::vector<size_t> offsets(blocks.size(), 0);
+  size_t total = 0;
+
+  for (size_t b = 0; b < blocks.size(); b++) {
+    offsets[b] = total;
+    total += blocks[b].bytes;
+  }
+
+  if (mailbox.size() < total) {
+    mailbox.resize(total);
+  }
+
+  // Every block is posted before any is collected
+  for (int send = 1; send >= 0; send--) {
+    std::vector<std::thread> workers;
+
+    for (size_t d = 0; d < devices->Count(); d++) {
+      workers.push_back(std::thread(ServeMailbox, devices, &blocks, &offsets,
+                                    &mailbox[0], d, send == 1));
+    }
+
+    for (size_t w = 0; w < workers.size(); w++) {
+      workers[w].join();
+    }
+  }
+
+  return HCFFT_SUCCEEDS;
+}
+
+hcfftStatus FFTPlan::hcfftMallocDistributed(hcfftPlanHandle plHandle,
+                                            hcfftXtDistributedArray** array) {
+  FFTRepo& fftRepo = FFTRepo::getInstance();
+  FFTPlan* fftPlan = NULL;
+  lockRAII* planLock = NULL;
+
+  if (fftRepo.getPlan(plHandle, fftPlan, planLock) != HCFFT_SUCCEEDS) {
+    return HCFFT_INVALID;
+  }
+
+  scopedLock sLock(*planLock, _T(" hcfftMallocDistributed"));
+  ARG_CHECK(array != NULL)
+  Distributed::Slabs slabs;
+
+  if (Distributed::GetSlabs(fftPlan, &slabs) != HCFFT_SUCCEEDS) {
+    return HCFFT_INVALID;
+  }
+
+  FFTDeviceSet* devices = fftPlan->deviceSet;
+  hcfftXtDistributedArray* result = new hcfftXtDistributedArray;
+  result->length = fftPlan->length;
+  result->elemBytes = fftPlan->ElementSize();
+  result->data.assign(devices->Count(), NULL);
+  result->scratch.assign(devices->Count(), NULL);
+  result->shuffled = false;
+
+  for (size_t d = 0; d < devices->Count(); d++) {
+    size_t bytes = slabs.Capacity(d) * result->elemBytes;
+
+    if (bytes == 0) {
+      continue;
+    }
+
+    hc::accelerator acc = devices->Accelerator(d);
+    result->data[d] = hc::am_alloc(bytes, acc, KernelAllocFlags());
+    result->scratch[d] = hc::am_alloc(bytes, acc, KernelAllocFlags());
+
+    if (result->data[d] == NULL || result->scratch[d] == NULL) {
+      hcfftFreeDistributed(result);
+      return HCFFT_ERROR;
+    }
+
+    // Direct exchanges write into the slabs of the other accelerators
+    std::vector<hc::accelerator> peers;
+
+    for (size_t p = 0; p < devices->Count(); p++) {
+      if (!(devices->Accelerator(p) == acc)) {
+        peers.push_back(devices->Accelerator(p));
+      }
+    }
+
+    if (!peers.empty()) {
+      hc::am_map_to_peers(result->data[d], peers.size(), &peers[0]);
+      hc::am_map_to_peers(result->scratch[d], peers.size(), &peers[0]);
+    }
+  }
+
+  *array = result;
+  return HCFFT_SUCCEEDS;
+}
+
+hcfftStatus FFTPlan::hcfftFreeDistributed(hcfftXtDistributedArray* array) {
+  ARG_CHECK(array != NULL)
+
+  for (size_t d = 0; d < array->data.size(); d++) {
+    if (array->data[d]) {
+      hc::am_free(array->data[d]);
+    }
+
+    if (array->scratch[d]) {
+      hc::am_free(array->scratch[d]);
+    }
+  }
+
+  delete array;
+  return HCFFT_SUCCEEDS;
+}
+
+hcfftStatus FFTPlan::hcfftCopyDistributed(hcfftPlanHandle plHandle,
+                                          hcfftXtDistributedArray* array,
+                                          void* host, bool toArray) {
+  FFTRepo& fftRepo = FFTRepo::getInstance();
+  FFTPlan* fftPlan = NULL;
+  lockRAII* planLock = NULL;
+
+  if (fftRepo.getPlan(plHandle, fftPlan, planLock) != HCFFT_SUCCEEDS) {
+    return HCFFT_INVALID;
+  }
+
+  scopedLock sLock(*planLock, _T(" hcfftCopyDistributed"));
+  ARG_CHECK(array != NULL && host != NULL)
+  Distributed::Slabs slabs;
+
+  if (Distributed::GetSlabs(fftPlan, &slabs) != HCFFT_SUCCEEDS ||
+      !Distributed::Matches(slabs, array, fftPlan->ElementSize())) {
+    return HCFFT_INVALID;
+  }
+
+  FFTDeviceSet* devices = fftPlan->deviceSet;
+  const size_t nx = slabs.nx, ny = slabs.ny, nz = slabs.nz;
+  const size_t elemBytes = array->elemBytes;
+  char* hostBytes = static_cast<char*>(host);
+
+  if (toArray) {
+    // z slabs are contiguous in natural order
+    array->shuffled = false;
+
+    for (size_t d = 0; d < devices->Count(); d++) {
+      devices->View(d).copy(hostBytes + slabs.zFirst[d] * nx * ny * elemBytes,
+                            array->data[d],
+                            slabs.zCount[d] * nx * ny * elemBytes);
+    }
+
+    return HCFFT_SUCCEEDS;
+  }
+
+  for (size_t d = 0; d < devices->Count(); d++) {
+    if (!array->shuffled) {
+      devices->View(d).copy(array->data[d],
+                            hostBytes + slabs.zFirst[d] * nx * ny * elemBytes,
+                            slabs.zCount[d] * nx * ny * elemBytes);
+      continue;
+    }
+
+    // y slabs ([y][x][z]) are reordered on the host
+    size_t yc = slabs.yCount[d];
+    std::vector<char> slab(yc * nx * nz * elemBytes);
+
+    if (slab.empty()) {
+      continue;
+    }
+
+    devices->View(d).copy(array->data[d], &slab[0], slab.size());
+
+    for (size_t y = 0; y < yc; y++) {
+      for (size_t x = 0; x < nx; x++) {
+        for (size_t z = 0; z < nz; z++) {
+          size_t to = (z * ny + slabs.yFirst[d] + y) * nx + x;
+          size_t from = (y * nx + x) * nz + z;
+          memcpy(hostBytes + to * elemBytes, &slab[from * elemBytes],
+                 elemBytes);
+        }
+      }
+    }
+  }
+
+  return HCFFT_SUCCEEDS;
+}
+
+template <typename T>
+hcfftStatus FFTPlan::hcfftEnqueueDistributed(hcfftPlanHandle plHandle,
+                                             hcfftDirection dir,
+                                             hcfftXtDistributedArray* array) {
+  FFTRepo& fftRepo = FFTRepo::getInstance();
+  FFTPlan* fftPlan = NULL;
+  lockRAII* planLock = NULL;
+
+  if (fftRepo.getPlan(plHandle, fftPlan, planLock) != HCFFT_SUCCEEDS) {
+    return HCFFT_INVALID;
+  }
+
+  scopedLock sLock(*planLock, _T(" hcfftEnqueueDistributed"));
+  ARG_CHECK(array != NULL)
+  Distributed::Slabs slabs;
+
+  if ((sizeof(T) == sizeof(double)) != (fftPlan->precision == HCFFT_DOUBLE) ||
+      Distributed::GetSlabs(fftPlan, &slabs) != HCFFT_SUCCEEDS ||
+      !Distributed::Matches(slabs, array, fftPlan->ElementSize())) {
+    return HCFFT_INVALID;
+  }
+
+  // The pass of the current slabs, the exchange, the pass of the others
+  hcfftStatus status = Distributed::LocalPass<T>(fftPlan, slabs, array, dir);
+
+  if (status == HCFFT_SUCCEEDS) {
+    status = Distributed::Exchange(fftPlan, slabs, array);
+  }
+
+  if (status == HCFFT_SUCCEEDS) {
+    status = Distributed::LocalPass<T>(fftPlan, slabs, array, dir);
+  }
+
+  return status;
+}
+
+// Template Initialization supporting just float and double types
+template hcfftStatus FFTPlan::hcfftEnqueueDistributed<float>(
+    hcfftPlanHandle plHandle, hcfftDirection dir,
+    hcfftXtDistributedArray* array);
+template hcfftStatus FFTPlan::hcfftEnqueueDistributed<double>(
+    hcfftPlanHandle plHandle, hcfftDirection dir,
+    hcfftXtDistributedArray* array);
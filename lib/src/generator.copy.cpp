@@ -68,6 +68,52 @@ class CopyKernel {
     return str;
   }
 
+  // Load one complex element into register R, through the user load
+  // callback if the plan has one
+  inline std::string ReadR(bool ilvd, const std::string& off,
+                           const std::string& offRe, const std::string& offIm,
+                           const std::string& sep, size_t count) {
+    std::string str;
+    bool cb = params.fft_hasLoadCallback;
+
+    if (ilvd) {
+      str += "R = ";
+      str += StockhamGenerator::CallbackLoad("gbIn", off, count, cb);
+      str += ";";
+    } else {
+      str += "R.x = ";
+      str += StockhamGenerator::CallbackLoad("gbInRe", offRe, count, cb);
+      str += ";";
+      str += sep;
+      str += "R.y = ";
+      str += StockhamGenerator::CallbackLoad("gbInIm", offIm, count, cb);
+      str += ";";
+    }
+
+    return str;
+  }
+
+  // Store register R as one complex element, through the user store callback
+  // if the plan has one
+  inline std::string WriteR(bool ilvd, const std::string& off,
+                            const std::string& offRe, const std::string& offIm,
+                            const std::string& sep, size_t count) {
+    std::string str;
+    bool cb = params.fft_hasStoreCallback;
+
+    if (ilvd) {
+      str += StockhamGenerator::CallbackStore("gbOut", off, "R", count, cb);
+    } else {
+      str += StockhamGenerator::CallbackStore("gbOutRe", offRe, "R.x", count,
+                                              cb);
+      str += sep;
+      str += StockhamGenerator::CallbackStore("gbOutIm", offIm, "R.y", count,
+                                              cb);
+    }
+
+    return str;
+  }
+
  public:
   explicit CopyKernel(const FFTKernelGenKeyParams& paramsVal)
       : params(paramsVal) {
@@ -86,11 +132,15 @@ class CopyKernel {
     assert(params.fft_placeness == HCFFT_OUTOFPLACE);
   }
 
-  void GenerateKernel(const hcfftPlanHandle plHandle, std::string& str,
+  void GenerateKernel(const hcfftPlanHandle plHandle, CodeEmitter& str,
                       std::vector<size_t> gWorkSize,
                       std::vector<size_t> lWorkSize, size_t count) {
-    std::string rType = StockhamGenerator::RegBaseType<PR>(1);
-    std::string r2Type = StockhamGenerator::RegBaseType<PR>(2);
+    // Global buffer types, fp16 for half precision storage
+    bool halfStorage = (params.fft_precision == HCFFT_HALF);
+    std::string rType = halfStorage ? StockhamGenerator::HalfBaseType(1)
+                                    : StockhamGenerator::RegBaseType<PR>(1);
+    std::string r2Type = halfStorage ? StockhamGenerator::HalfBaseType(2)
+                                     : StockhamGenerator::RegBaseType<PR>(2);
     bool inIlvd;   // Input is interleaved format
     bool outIlvd;  // Output is interleaved format
     inIlvd = ((params.fft_inputLayout == HCFFT_COMPLEX_INTERLEAVED) ||
@@ -117,7 +167,7 @@ class CopyKernel {
       }
     }
 
-    str += SztToStr(count);
+    str << count;
     str +=
         "(std::map<int, void*> vectArr, uint batchSize, accelerator_view "
         "&acc_view, accelerator &acc)";
@@ -129,7 +179,7 @@ class CopyKernel {
       str += " *gbIn = static_cast<";
       str += r2Type;
       str += "*> (vectArr[";
-      str += SztToStr(arg);
+      str << arg;
       str += "]);\n";
       arg++;
     } else {
@@ -137,14 +187,14 @@ class CopyKernel {
       str += " *gbInRe = static_cast<";
       str += rType;
       str += "*> (vectArr[";
-      str += SztToStr(arg);
+      str << arg;
       str += "]);\n";
       arg++;
       str += rType;
       str += " *gbInIm = static_cast";
       str += rType;
       str += "*> (vectArr[";
-      str += SztToStr(arg);
+      str << arg;
       str += "]);\n";
       arg++;
     }
@@ -154,7 +204,7 @@ class CopyKernel {
       str += " *gbOut = static_cast<";
       str += r2Type;
       str += "*> (vectArr[";
-      str += SztToStr(arg);
+      str << arg;
       str += "]);\n";
       arg++;
     } else {
@@ -162,23 +212,35 @@ class CopyKernel {
       str += " *gbInRe = static_cast<";
       str += rType;
       str += "*> (vectArr[";
-      str += SztToStr(arg);
+      str << arg;
       str += "]);\n";
       arg++;
       str += rType;
       str += " *gbOutIm = static_cast<";
       str += rType;
       str += "*> (vectArr[";
-      str += SztToStr(arg);
+      str << arg;
       str += "]);\n";
       arg++;
     }
 
+    // caller info of the load/store callbacks
+    if (params.fft_hasLoadCallback || params.fft_hasStoreCallback) {
+      str += "\tvoid *loadInfo = vectArr[";
+      str << arg;
+      str += "];\n";
+      arg++;
+      str += "\tvoid *storeInfo = vectArr[";
+      str << arg;
+      str += "];\n";
+      arg++;
+    }
+
     str += "\thc::extent<2> grdExt( ";
-    str += SztToStr(gWorkSize[0]);
+    str << gWorkSize[0];
     str += ", 1 ); \n";
     str += "\thc::tiled_extent<2> t_ext = grdExt.tile( ";
-    str += SztToStr(lWorkSize[0]);
+    str << lWorkSize[0];
     str += ", 1);\n";
     str +=
         "\thc::parallel_for_each(acc_view, t_ext, [=] (hc::tiled_index<2> "
@@ -234,18 +296,18 @@ class CopyKernel {
       // Setup variables
       str += "\tuint batch, meg, mel, mel2;\n\t";
       str += "batch = me/";
-      str += SztToStr(NtRounded64);
+      str << NtRounded64;
       str += ";\n\t";
       str += "meg = me%";
-      str += SztToStr(NtRounded64);
+      str << NtRounded64;
       str += ";\n\t";
       str += "mel = me%";
-      str += SztToStr(Nt);
+      str << Nt;
       str += ";\n\t";
       str += "mel2 = (";
-      str += SztToStr(N);
+      str << N;
       str += " - mel)%";
-      str += SztToStr(N);
+      str << N;
       str += ";\n\n";
     }
 
@@ -324,62 +386,36 @@ class CopyKernel {
     // Do the copy
     if (general) {
       str += "for(uint t=0; t<";
-      str += SztToStr(N / 64);
+      str << N / 64;
       str += "; t++)\n\t{\n\t\t";
-
-      if (inIlvd) {
-        str += "R = gbIn[inOffset + me + t*64];\n\t\t";
-      } else {
-        str += "R.x = gbInRe[inReOffset + me + t*64];\n\t\t";
-        str += "R.y = gbInIm[inImOffset + me + t*64];\n\t\t";
-      }
-
-      if (outIlvd) {
-        str += "gbOut[outOffset + me + t*64] = R;\n";
-      } else {
-        str += "gbOutRe[outReOffset + me + t*64] = R.x;\n\t\t";
-        str += "gbOutIm[outImOffset + me + t*64] = R.y;\n";
-      }
-
+      str += ReadR(inIlvd, "inOffset + me + t*64", "inReOffset + me + t*64",
+                   "inImOffset + me + t*64", "\n\t\t", count);
+      str += "\n\t\t";
+      str += WriteR(outIlvd, "outOffset + me + t*64",
+                    "outReOffset + me + t*64", "outImOffset + me + t*64",
+                    "\n\t\t", count);
+      str += "\n";
       str += "\t}\n\n";
     } else {
       str += "if(meg < ";
-      str += SztToStr(Nt);
+      str << Nt;
       str += ")\n\t{\n\t";
+      str += ReadR(inIlvd, "inOffset", "inReOffset", "inImOffset", "\n\t",
+                   count);
+      str += "\n\t";
 
       if (c2h) {
-        if (inIlvd) {
-          str += "R = gbIn[inOffset];\n\t";
-        } else {
-          str += "R.x = gbInRe[inReOffset];\n\t";
-          str += "R.y = gbInIm[inImOffset];\n\t";
-        }
-
-        if (outIlvd) {
-          str += "gbOut[outOffset] = R;\n\n";
-        } else {
-          str += "gbOutRe[outReOffset] = R.x;\n\t";
-          str += "gbOutIm[outImOffset] = R.y;\n\t";
-        }
+        str += WriteR(outIlvd, "outOffset", "outReOffset", "outImOffset",
+                      "\n\t", count);
+        str += outIlvd ? "\n\n" : "\n\t";
       } else {
-        if (inIlvd) {
-          str += "R = gbIn[inOffset];\n\t";
-        } else {
-          str += "R.x = gbInRe[inReOffset];\n\t";
-          str += "R.y = gbInIm[inImOffset];\n\t";
-        }
-
-        if (outIlvd) {
-          str += "gbOut[outOffset] = R;\n\t";
-          str += "R.y = -R.y;\n\t";
-          str += "gbOut[outOffset2] = R;\n\n";
-        } else {
-          str += "gbOutRe[outReOffset] = R.x;\n\t";
-          str += "gbOutIm[outImOffset] = R.y;\n\t";
-          str += "R.y = -R.y;\n\t";
-          str += "gbOutRe[outReOffset2] = R.x;\n\t";
-          str += "gbOutIm[outImOffset2] = R.y;\n\n";
-        }
+        str += WriteR(outIlvd, "outOffset", "outReOffset", "outImOffset",
+                      "\n\t", count);
+        str += "\n\t";
+        str += "R.y = -R.y;\n\t";
+        str += WriteR(outIlvd, "outOffset2", "outReOffset2", "outImOffset2",
+                      "\n\t", count);
+        str += "\n\n";
       }
 
       str += "}\n\n";
@@ -387,6 +423,122 @@ class CopyKernel {
 
     str += " }).wait();\n}}\n\n";
   }
+
+  // Paired real transforms: signals 2p and 2p+1 of a real batch travel as the
+  // real and imaginary parts of complex signal p. Forward, "pack" interleaves
+  // the pair and "split" separates the spectra of the complex result
+  //
+  //        Xa[k] = (Z[k] + conj(Z[N-k])) / 2
+  //        Xb[k] = (Z[k] - conj(Z[N-k])) / 2i
+  //
+  // Backward, "pack" rebuilds Z[k] = Xa[k] + i Xb[k] over the full length from
+  // the two hermitian halves and "split" takes the real and imaginary parts of
+  // the inverse transform apart. An odd batch leaves the last imaginary part
+  // at zero.
+  void GeneratePairKernel(const hcfftPlanHandle plHandle, CodeEmitter& str,
+                          std::vector<size_t> gWorkSize,
+                          std::vector<size_t> lWorkSize, size_t count,
+                          size_t batchSize) {
+    bool halfStorage = (params.fft_precision == HCFFT_HALF);
+    std::string rType = halfStorage ? StockhamGenerator::HalfBaseType(1)
+                                    : StockhamGenerator::RegBaseType<PR>(1);
+    std::string r2Type = halfStorage ? StockhamGenerator::HalfBaseType(2)
+                                     : StockhamGenerator::RegBaseType<PR>(2);
+    bool r2p = (params.fft_inputLayout == HCFFT_REAL);
+    bool p2r = (params.fft_outputLayout == HCFFT_REAL);
+    size_t M = c2h ? Nt : N;  // work items per pair
+    size_t MRounded64 = DivRoundingUp<size_t>(M, 64) * 64;
+    std::string inS = SztToStr(params.fft_inStride[0]);
+    std::string inD = SztToStr(params.fft_inStride[1]);
+    std::string outS = SztToStr(params.fft_outStride[0]);
+    std::string outD = SztToStr(params.fft_outStride[1]);
+    str += "extern \"C\"\n { void copy_pair";
+    str << count;
+    str +=
+        "(std::map<int, void*> vectArr, uint batchSize, accelerator_view "
+        "&acc_view, accelerator &acc)";
+    str += "{\n\t";
+    str += r2p ? rType : r2Type;
+    str += " *gbIn = static_cast<";
+    str += r2p ? rType : r2Type;
+    str += "*> (vectArr[0]);\n\t";
+    str += p2r ? rType : r2Type;
+    str += " *gbOut = static_cast<";
+    str += p2r ? rType : r2Type;
+    str += "*> (vectArr[1]);\n";
+    str += "\thc::extent<2> grdExt( ";
+    str << gWorkSize[0];
+    str += ", 1 ); \n";
+    str += "\thc::tiled_extent<2> t_ext = grdExt.tile( ";
+    str << lWorkSize[0];
+    str += ", 1);\n";
+    str +=
+        "\thc::parallel_for_each(acc_view, t_ext, [=] (hc::tiled_index<2> "
+        "tidx) [[hc]]\n\t {\n";
+    str += "\tuint me = tidx.global[0];\n";
+    str += "\tuint pair = me/";
+    str << MRounded64;
+    str += ";\n";
+    str += "\tuint k = me%";
+    str << MRounded64;
+    str += ";\n";
+    str += "\tbool hasB = (2*pair + 1) < ";
+    str << batchSize;
+    str += ";\n";
+    str += "\tif(k >= ";
+    str << M;
+    str += ") return;\n\t";
+    str += StockhamGenerator::RegBaseType<PR>(2);
+    str += " A, B, R;\n";
+
+    if (r2p) {
+      // Forward pack: two real signals into one complex signal
+      str += "\tR.x = gbIn[(2*pair)*" + inD + " + k*" + inS + "];\n";
+      str += "\tR.y = hasB ? (" + StockhamGenerator::RegBaseType<PR>(1) +
+             ")gbIn[(2*pair + 1)*" + inD + " + k*" + inS + "] : 0;\n";
+      str += "\tgbOut[pair*" + outD + " + k*" + outS + "] = R;\n";
+    } else if (c2h) {
+      // Forward split: separate the two hermitian spectra
+      str += "\tA = gbIn[pair*" + inD + " + k*" + inS + "];\n";
+      str += "\tB = gbIn[pair*" + inD + " + ((" + SztToStr(N) +
+             " - k)%" + SztToStr(N) + ")*" + inS + "];\n";
+      str += "\tR.x = 0.5" + StockhamGenerator::FloatSuffix<PR>() +
+             "*(A.x + B.x);\n";
+      str += "\tR.y = 0.5" + StockhamGenerator::FloatSuffix<PR>() +
+             "*(A.y - B.y);\n";
+      str += "\tgbOut[(2*pair)*" + outD + " + k*" + outS + "] = R;\n";
+      str += "\tif(hasB)\n\t{\n";
+      str += "\tR.x = 0.5" + StockhamGenerator::FloatSuffix<PR>() +
+             "*(A.y + B.y);\n";
+      str += "\tR.y = 0.5" + StockhamGenerator::FloatSuffix<PR>() +
+             "*(B.x - A.x);\n";
+      str += "\tgbOut[(2*pair + 1)*" + outD + " + k*" + outS + "] = R;\n";
+      str += "\t}\n";
+    } else if (h2c) {
+      // Backward pack: expand both hermitian halves and combine them
+      str += "\tuint kh = (k < " + SztToStr(Nt) + ") ? k : (" +
+             SztToStr(N) + " - k);\n";
+      str += "\tA = gbIn[(2*pair)*" + inD + " + kh*" + inS + "];\n";
+      str += "\tB.x = 0; B.y = 0;\n";
+      str += "\tif(hasB) B = gbIn[(2*pair + 1)*" + inD + " + kh*" + inS +
+             "];\n";
+      str += "\tif(k != kh)\n\t{\n";
+      str += "\tA.y = -A.y;\n";
+      str += "\tB.y = -B.y;\n";
+      str += "\t}\n";
+      str += "\tR.x = A.x - B.y;\n";
+      str += "\tR.y = A.y + B.x;\n";
+      str += "\tgbOut[pair*" + outD + " + k*" + outS + "] = R;\n";
+    } else {
+      // Backward split: real and imaginary parts are the two real signals
+      str += "\tR = gbIn[pair*" + inD + " + k*" + inS + "];\n";
+      str += "\tgbOut[(2*pair)*" + outD + " + k*" + outS + "] = R.x;\n";
+      str += "\tif(hasB) gbOut[(2*pair + 1)*" + outD + " + k*" + outS +
+             "] = R.y;\n";
+    }
+
+    str += " }).wait();\n}}\n\n";
+  }
 };
 };  // namespace CopyGenerator
 
@@ -420,6 +572,9 @@ hcfftStatus FFTPlan::GetKernelGenKeyPvt<Copy>(
   params.fft_outStride[i] = this->oDist;
   params.fft_fwdScale = this->forwardScale;
   params.fft_backScale = this->backwardScale;
+  params.fft_realPair = this->realPair;
+  params.fft_hasLoadCallback = !this->loadCallback.empty();
+  params.fft_hasStoreCallback = !this->storeCallback.empty();
   params.limit_LocalMemSize = this->envelope.limit_LocalMemSize;
   return HCFFT_SUCCEEDS;
 }
@@ -437,6 +592,16 @@ hcfftStatus FFTPlan::GetWorkSizesPvt<Copy>(std::vector<size_t>& globalWS,
   bool general = !(h2c || c2h);
   size_t count = this->batchSize;
 
+  if (fftParams.fft_realPair) {
+    // One work item per element of every pair; the split only needs the
+    // non-redundant half
+    size_t M = c2h ? (1 + fftParams.fft_N[0] / 2) : fftParams.fft_N[0];
+    globalWS.push_back(DivRoundingUp<size_t>(count, 2) *
+                       DivRoundingUp<size_t>(M, 64) * 64);
+    localWS.push_back(64);
+    return HCFFT_SUCCEEDS;
+  }
+
   switch (fftParams.fft_DataDim) {
     case 5:
       assert(false);
@@ -464,6 +629,45 @@ hcfftStatus FFTPlan::GetWorkSizesPvt<Copy>(std::vector<size_t>& globalWS,
   return HCFFT_SUCCEEDS;
 }
 
+template <>
+hcfftStatus FFTPlan::GetKernelCostPvt<Copy>(FFTKernelCost* cost) const {
+  std::vector<size_t> globalWS, localWS;
+  this->GetWorkSizesPvt<Copy>(globalWS, localWS);
+  bool h2c = ((this->ipLayout == HCFFT_HERMITIAN_PLANAR) ||
+              (this->ipLayout == HCFFT_HERMITIAN_INTERLEAVED));
+  double rows = static_cast<double>(this->batchSize);
+
+  for (size_t u = 1; u < this->length.size(); u++) {
+    rows *= this->length[u];
+  }
+
+  // Hermitian rows hold the non-redundant half, complex rows all of it
+  double half = rows * (this->length[0] / 2 + 1);
+  double full = rows * this->length[0];
+  cost->gen = Copy;
+  cost->name = this->realPair ? "copy_pair" : (h2c ? "copy_h2c" : "copy_c2h");
+  cost->globalSize = globalWS[0];
+  cost->localSize = localWS[0];
+  cost->registers = 2 * ((this->precision == HCFFT_DOUBLE) ? 2 : 1) * 2 + 16;
+
+  if (this->realPair) {
+    // Complex rows carry a pair of real transforms each, split or joined
+    // with an add, a subtract and a halving per element
+    full /= 2;
+    cost->flops = 4.0 * half;
+  }
+
+  cost->bytesRead = LayoutBytes(this->ipLayout, h2c ? half : full);
+  cost->bytesWritten = LayoutBytes(this->opLayout, h2c ? full : half);
+
+  // The plain copy to hermitian storage only reads the half it keeps
+  if (!h2c && !this->realPair) {
+    cost->bytesRead = LayoutBytes(this->ipLayout, half);
+  }
+
+  return HCFFT_SUCCEEDS;
+}
+
 // using namespace CopyGenerator;
 
 template <>
@@ -482,27 +686,44 @@ hcfftStatus FFTPlan::GenerateKernelPvt<Copy>(const hcfftPlanHandle plHandle,
     c2h = ((params.fft_outputLayout == HCFFT_HERMITIAN_PLANAR) ||
            (params.fft_outputLayout == HCFFT_HERMITIAN_INTERLEAVED));
     bool general = !(h2c || c2h);
-    std::string programCode;
-    programCode = hcHeader();
-    StockhamGenerator::Precision pr = (params.fft_precision == HCFFT_SINGLE) ? StockhamGenerator::P_SINGLE : StockhamGenerator::P_DOUBLE;
+    CodeEmitter programCode;
+    programCode << hcHeader();
+    programCode << StockhamGenerator::CallbackSource(loadCallback,
+                                                     storeCallback, count);
+    StockhamGenerator::Precision pr = (params.fft_precision == HCFFT_DOUBLE) ? StockhamGenerator::P_DOUBLE : StockhamGenerator::P_SINGLE;
 
     switch (pr) {
       case StockhamGenerator::P_SINGLE: {
         CopyGenerator::CopyKernel<StockhamGenerator::P_SINGLE> kernel(params);
-        kernel.GenerateKernel(plHandle, programCode, gWorkSize, lWorkSize,
-                              count);
+
+        if (params.fft_realPair) {
+          kernel.GeneratePairKernel(plHandle, programCode, gWorkSize,
+                                    lWorkSize, count, batchSize);
+        } else {
+          kernel.GenerateKernel(plHandle, programCode, gWorkSize, lWorkSize,
+                                count);
+        }
       } break;
 
       case StockhamGenerator::P_DOUBLE: {
         CopyGenerator::CopyKernel<StockhamGenerator::P_DOUBLE> kernel(params);
-        kernel.GenerateKernel(plHandle, programCode, gWorkSize, lWorkSize,
-                              count);
+
+        if (params.fft_realPair) {
+          kernel.GeneratePairKernel(plHandle, programCode, gWorkSize,
+                                    lWorkSize, count, batchSize);
+        } else {
+          kernel.GenerateKernel(plHandle, programCode, gWorkSize, lWorkSize,
+                                count);
+        }
       } break;
     }
 
-    fftRepo.setProgramCode(Copy, plHandle, params, programCode);
+    fftRepo.setProgramCode(Copy, plHandle, params, programCode.str());
 
-    if (general) {
+    if (params.fft_realPair) {
+      fftRepo.setProgramEntryPoints(Copy, plHandle, params, "copy_pair",
+                                    "copy_pair");
+    } else if (general) {
       fftRepo.setProgramEntryPoints(Copy, plHandle, params, "copy_general",
                                     "copy_general");
     } else {
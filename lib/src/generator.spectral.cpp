@@ -0,0 +1,432 @@
+/*
+Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "include/stockham.h"
+#include <dlfcn.h>
+#include <map>
+
+// Spectral Multiply-Accumulate
+//
+//   FFT based convolution layers reduce over input channels in the frequency
+//   domain
+//
+//        out[b][k][f] = sum_c in[b][c][f] * w[k][c][f]
+//
+//   For every frequency bin f this is a complex (B x C) * (C x K) GEMM. The
+//   generated kernel assigns one bin to a work item and keeps a tileB x tileK
+//   block of outputs in registers. Neighbouring work items own neighbouring
+//   bins, so every global read and write is coalesced without going through
+//   LDS. Spectra are read in the layout produced by the plan, i.e. one
+//   spectrum of 'bins' complex values every 'dist' elements.
+
+namespace SpectralGenerator {
+template <StockhamGenerator::Precision PR>
+class SpectralMacKernel {
+  size_t bins;       // complex values per spectrum
+  size_t dist;       // distance between consecutive spectra
+  size_t nImages;    // B
+  size_t nChannels;  // C
+  size_t nFilters;   // K
+  size_t tileB, tileK;
+  bool accumulate;   // out += instead of out =
+  bool conjWeights;  // multiply by conj(w), i.e. cross-correlation
+
+  static size_t TileSize(size_t n) {
+    size_t cTile[] = {4, 2, 1};  // Must be in descending order
+
+    for (size_t t = 0; t < (sizeof(cTile) / sizeof(cTile[0])); t++) {
+      if (n % cTile[t] == 0) {
+        return cTile[t];
+      }
+    }
+
+    return 1;
+  }
+
+ public:
+  SpectralMacKernel(size_t binsVal, size_t distVal, size_t nImagesVal,
+                    size_t nChannelsVal, size_t nFiltersVal,
+                    bool accumulateVal, bool conjWeightsVal)
+      : bins(binsVal),
+        dist(distVal),
+        nImages(nImagesVal),
+        nChannels(nChannelsVal),
+        nFilters(nFiltersVal),
+        accumulate(accumulateVal),
+        conjWeights(conjWeightsVal) {
+    tileB = TileSize(nImages);
+    tileK = TileSize(nFilters);
+  }
+
+  void GetWorkSizes(std::vector<size_t>& globalWS,
+                    std::vector<size_t>& localWS) const {
+    size_t binsRounded = DivRoundingUp<size_t>(bins, 64) * 64;
+    size_t tiles = (nImages / tileB) * (nFilters / tileK);
+    globalWS.push_back(binsRounded * tiles);
+    localWS.push_back(64);
+  }
+
+  void GenerateKernel(CodeEmitter& str) {
+    std::string r2Type = StockhamGenerator::RegBaseType<PR>(2);
+    std::string sfx = StockhamGenerator::FloatSuffix<PR>();
+    std::vector<size_t> gWorkSize;
+    std::vector<size_t> lWorkSize;
+    GetWorkSizes(gWorkSize, lWorkSize);
+    size_t binsRounded = DivRoundingUp<size_t>(bins, 64) * 64;
+    size_t kTiles = nFilters / tileK;
+    std::string chanDist = SztToStr(nChannels * dist);
+    // Kernel begin
+    str += "extern \"C\"\n { void spectral_mac";
+    str +=
+        "(std::map<int, void*> vectArr, uint batchSize, accelerator_view "
+        "&acc_view, accelerator &acc)";
+    str += "{\n\t";
+    str += r2Type;
+    str += " *gbIn = static_cast<";
+    str += r2Type;
+    str += "*> (vectArr[0]);\n\t";
+    str += r2Type;
+    str += " *gbW = static_cast<";
+    str += r2Type;
+    str += "*> (vectArr[1]);\n\t";
+    str += r2Type;
+    str += " *gbOut = static_cast<";
+    str += r2Type;
+    str += "*> (vectArr[2]);\n";
+    str += "\thc::extent<2> grdExt( ";
+    str << gWorkSize[0];
+    str += ", 1 ); \n";
+    str += "\thc::tiled_extent<2> t_ext = grdExt.tile( ";
+    str << lWorkSize[0];
+    str += ", 1);\n";
+    str +=
+        "\thc::parallel_for_each(acc_view, t_ext, [=] (hc::tiled_index<2> "
+        "tidx) [[hc]]\n\t {\n\t";
+    // Work item to (bin, output tile) mapping
+    str += "uint f = tidx.global[0] % ";
+    str << binsRounded;
+    str += ";\n\t";
+    str += "uint tile = tidx.global[0] / ";
+    str << binsRounded;
+    str += ";\n\t";
+    str += "if (f < ";
+    str << bins;
+    str += ")\n\t{\n\t";
+    str += "unsigned long b0 = (tile / ";
+    str << kTiles;
+    str += ") * ";
+    str << tileB;
+    str += ";\n\t";
+    str += "unsigned long k0 = (tile % ";
+    str << kTiles;
+    str += ") * ";
+    str << tileK;
+    str += ";\n\t";
+    str += r2Type;
+    str += " *pIn = gbIn + b0 * ";
+    str += chanDist;
+    str += " + f;\n\t";
+    str += r2Type;
+    str += " *pW = gbW + k0 * ";
+    str += chanDist;
+    str += " + f;\n\t";
+    str += r2Type;
+    str += " *pOut = gbOut + (b0 * ";
+    str << nFilters;
+    str += " + k0) * ";
+    str << dist;
+    str += " + f;\n\n\t";
+
+    // Setup registers
+    for (size_t b = 0; b < tileB; b++) {
+      for (size_t k = 0; k < tileK; k++) {
+        str += r2Type;
+        str += " acc";
+        str << b;
+        str += "_";
+        str << k;
+        str += " = ";
+        str += r2Type;
+        str += "(0.0";
+        str += sfx;
+        str += ", 0.0";
+        str += sfx;
+        str += ");\n\t";
+      }
+    }
+
+    str += "\n\tfor(uint c=0; c<";
+    str << nChannels;
+    str += "; c++)\n\t{\n\t\t";
+    str += "unsigned long cOffset = c * ";
+    str << dist;
+    str += ";\n\t\t";
+
+    for (size_t b = 0; b < tileB; b++) {
+      str += r2Type;
+      str += " x";
+      str << b;
+      str += " = pIn[cOffset + ";
+      str << b * nChannels * dist;
+      str += "];\n\t\t";
+    }
+
+    for (size_t k = 0; k < tileK; k++) {
+      str += r2Type;
+      str += " w";
+      str << k;
+      str += " = pW[cOffset + ";
+      str << k * nChannels * dist;
+      str += "];\n\t\t";
+    }
+
+    for (size_t b = 0; b < tileB; b++) {
+      for (size_t k = 0; k < tileK; k++) {
+        std::string x = "x" + SztToStr(b);
+        std::string w = "w" + SztToStr(k);
+        str += "acc";
+        str << b;
+        str += "_";
+        str << k;
+        str += " += ";
+        str += r2Type;
+        str += "(";
+        str += x + ".x * " + w + ".x";
+        str += conjWeights ? " + " : " - ";
+        str += x + ".y * " + w + ".y, ";
+        str += x + ".y * " + w + ".x";
+        str += conjWeights ? " - " : " + ";
+        str += x + ".x * " + w + ".y);\n\t\t";
+      }
+    }
+
+    str += "\n\t}\n\n\t";
+
+    // Write the output tile
+    for (size_t b = 0; b < tileB; b++) {
+      for (size_t k = 0; k < tileK; k++) {
+        str += "pOut[";
+        str << (b * nFilters + k) * dist;
+        str += accumulate ? "] += acc" : "] = acc";
+        str << b;
+        str += "_";
+        str << k;
+        str += ";\n\t";
+      }
+    }
+
+    str += "}\n";
+    str += " }).wait();\n}}\n\n";
+  }
+};
+};  // namespace SpectralGenerator
+
+typedef void(FUNC_SpectralMac)(std::map<int, void*>* vectArr, uint batchSize,
+                               hc::accelerator_view& acc_view,
+                               hc::accelerator& acc);
+//  Kernels already loaded in this process, keyed by shared object name
+static std::map<std::string, FUNC_SpectralMac*> spectralKernels;
+static lockRAII spectralLock(_T("spectralMAC"));
+
+template <typename T>
+hcfftStatus FFTPlan::hcfftSpectralMAC(hcfftPlanHandle plHandle, size_t nImages,
+                                      size_t nChannels, size_t nFilters,
+                                      T* inSpectra, T* weights, T* outSpectra,
+                                      bool accumulate, bool conjWeights) {
+  FFTRepo& fftRepo = FFTRepo::getInstance();
+  FFTPlan* fftPlan = NULL;
+  lockRAII* planLock = NULL;
+
+  if (fftRepo.getPlan(plHandle, fftPlan, planLock) != HCFFT_SUCCEEDS) {
+    return HCFFT_INVALID;
+  }
+
+  scopedLock sLock(*planLock, _T(" hcfftSpectralMAC"));
+  ARG_CHECK(inSpectra != NULL && weights != NULL && outSpectra != NULL)
+  ARG_CHECK(nImages > 0 && nChannels > 0 && nFilters > 0)
+
+  if ((sizeof(T) == sizeof(double)) != (fftPlan->precision == HCFFT_DOUBLE)) {
+    return HCFFT_INVALID;
+  }
+
+  // Spectra of fp16 plans are not supported
+  if (fftPlan->precision == HCFFT_HALF) {
+    return HCFFT_INVALID;
+  }
+
+  // The spectra are laid out the way the plan produces (R2C, C2C) or consumes
+  // (C2R) them
+  hcfftIpLayout layout;
+  const std::vector<size_t>* strides;
+  size_t dist;
+
+  switch (fftPlan->hcfftlibtype) {
+    case HCFFT_R2CD2Z:
+      layout = HCFFT_HERMITIAN_INTERLEAVED;
+      strides = &fftPlan->outStride;
+      dist = fftPlan->oDist;
+      break;
+
+    case HCFFT_C2RZ2D:
+      layout = HCFFT_HERMITIAN_INTERLEAVED;
+      strides = &fftPlan->inStride;
+      dist = fftPlan->iDist;
+      break;
+
+    case HCFFT_C2CZ2Z:
+      layout = HCFFT_COMPLEX_INTERLEAVED;
+      strides = &fftPlan->outStride;
+      dist = fftPlan->oDist;
+      break;
+
+    default:
+      return HCFFT_INVALID;
+  }
+
+  if ((fftPlan->ipLayout == HCFFT_COMPLEX_PLANAR) ||
+      (fftPlan->ipLayout == HCFFT_HERMITIAN_PLANAR) ||
+      (fftPlan->opLayout == HCFFT_COMPLEX_PLANAR) ||
+      (fftPlan->opLayout == HCFFT_HERMITIAN_PLANAR)) {
+    //  Planar spectra are not supported
+    return HCFFT_INVALID;
+  }
+
+  //  Bins of a spectrum have to be contiguous: the kernel indexes them as one
+  //  packed run, so every stride is the product of the lengths below it
+  if (strides->size() < fftPlan->length.size()) {
+    return HCFFT_INVALID;
+  }
+
+  size_t bins = 1;
+
+  for (size_t i = 0; i < fftPlan->length.size(); i++) {
+    if ((*strides)[i] != bins) {
+      return HCFFT_INVALID;
+    }
+
+    if ((i == 0) && (layout == HCFFT_HERMITIAN_INTERLEAVED)) {
+      bins *= 1 + fftPlan->length[0] / 2;
+    } else {
+      bins *= fftPlan->length[i];
+    }
+  }
+
+  if (dist < bins) {
+    return HCFFT_INVALID;
+  }
+
+  std::string kernellib = getKernelCacheDir();
+  kernellib += "/libspectral";
+  kernellib += (fftPlan->precision == HCFFT_DOUBLE) ? "D_" : "F_";
+  kernellib += SztToStr(bins) + "_" + SztToStr(dist) + "_";
+  kernellib += SztToStr(nImages) + "_" + SztToStr(nChannels) + "_" +
+               SztToStr(nFilters) + "_";
+  kernellib += SztToStr((accumulate ? 1 : 0) | (conjWeights ? 2 : 0));
+  kernellib += "_.so";
+  FUNC_SpectralMac* FFTcall = NULL;
+  {
+    scopedLock kLock(spectralLock, _T(" hcfftSpectralMAC kernels"));
+    std::map<std::string, FUNC_SpectralMac*>::iterator it =
+        spectralKernels.find(kernellib);
+
+    if (it != spectralKernels.end()) {
+      FFTcall = it->second;
+    } else {
+      if (access(kernellib.c_str(), F_OK) == -1) {
+        CodeEmitter programCode;
+        programCode << hcHeader();
+
+        if (fftPlan->precision == HCFFT_DOUBLE) {
+          SpectralGenerator::SpectralMacKernel<StockhamGenerator::P_DOUBLE>
+              kernel(bins, dist, nImages, nChannels, nFilters, accumulate,
+                     conjWeights);
+          kernel.GenerateKernel(programCode);
+        } else {
+          SpectralGenerator::SpectralMacKernel<StockhamGenerator::P_SINGLE>
+              kernel(bins, dist, nImages, nChannels, nFilters, accumulate,
+                     conjWeights);
+          kernel.GenerateKernel(programCode);
+        }
+
+        std::string pwd = getKernelCacheDir();
+        pwd += "/";
+        struct stat st = {0};
+
+        if (stat(pwd.c_str(), &st) == -1) {
+          mkdir(pwd.c_str(), 0777);
+        }
+
+        std::string filename = kernellib.substr(0, kernellib.size() - 3);
+        filename.replace(filename.rfind("libspectral"), 11, "spectral");
+        filename += ".cpp";
+        FILE* fp = fopen(filename.c_str(), "w");
+
+        if (!fp) {
+          std::cout << " File " << filename << " open failed for writing "
+                    << std::endl;
+          return HCFFT_ERROR;
+        }
+
+        fwrite(programCode.str().c_str(), programCode.size(), 1, fp);
+        fclose(fp);
+        hcfftStatus status = CompileSharedObject(filename, kernellib);
+        remove(filename.c_str());
+
+        if (status != HCFFT_SUCCEEDS) {
+          return HCFFT_ERROR;
+        }
+      }
+
+      void* handle = dlopen(kernellib.c_str(), RTLD_NOW);
+
+      if (!handle) {
+        std::cout << "Failed to load Kernel: " << kernellib << std::endl;
+        return HCFFT_ERROR;
+      }
+
+      FFTcall = (FUNC_SpectralMac*)dlsym(handle, "spectral_mac");
+
+      if (!FFTcall) {
+        std::cout << "failed to locate spectral_mac(): " << dlerror();
+        return HCFFT_ERROR;
+      }
+
+      spectralKernels[kernellib] = FFTcall;
+    }
+  }
+  std::map<int, void*> vectArr;
+  vectArr.insert(std::make_pair(0, inSpectra));
+  vectArr.insert(std::make_pair(1, weights));
+  vectArr.insert(std::make_pair(2, outSpectra));
+  FFTcall(&vectArr, 1, fftPlan->acc_view, fftPlan->acc);
+  return HCFFT_SUCCEEDS;
+}
+
+// Template Initialization supporting just float and double types
+template hcfftStatus FFTPlan::hcfftSpectralMAC<float>(
+    hcfftPlanHandle plHandle, size_t nImages, size_t nChannels,
+    size_t nFilters, float* inSpectra, float* weights, float* outSpectra,
+    bool accumulate, bool conjWeights);
+template hcfftStatus FFTPlan::hcfftSpectralMAC<double>(
+    hcfftPlanHandle plHandle, size_t nImages, size_t nChannels,
+    size_t nFilters, double* inSpectra, double* weights, double* outSpectra,
+    bool accumulate, bool conjWeights);
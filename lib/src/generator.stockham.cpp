@@ -360,6 +360,24 @@ void DetermineSizes(const size_t &MAX_WGS, const size_t &length,
   assert(workGroupSize <= MAX_WGS);
 }
 
+// Work group size and transforms per work group of the kernel for a length:
+// the tuned table when the device allows it, DetermineSizes() otherwise
+template <StockhamGenerator::Precision PR>
+void KernelWorkSizes(const size_t &MAX_WGS, const size_t &length,
+                     size_t &workGroupSize, size_t &numTrans) {
+  KernelCoreSpecs<PR> kcs;
+  size_t t_wgs, t_nt;
+  kcs.GetWGSAndNT(length, t_wgs, t_nt);
+
+  if ((t_wgs != 0) && (t_nt != 0) && (MAX_WGS >= 256)) {
+    workGroupSize = t_wgs;
+    numTrans = t_nt;
+  } else {
+    StockhamGenerator::Precision pr = PR;
+    DetermineSizes(MAX_WGS, length, workGroupSize, numTrans, pr);
+  }
+}
+
 // Twiddle factors table
 template <class T>
 class TwiddleTable {
@@ -381,6 +399,7 @@ class TwiddleTable {
 
   void GenerateTwiddleTable(void **twiddles, hc::accelerator acc,
                             const std::vector<size_t> &radices) {
+    FFTBakeTimer timer(BAKE_TWIDDLES);
     const double TWO_PI = -6.283185307179586476925286766559;
     // Make sure the radices vector sums up to N
     size_t sz = 1;
@@ -416,10 +435,11 @@ class TwiddleTable {
       }
     }
 
-    *twiddles = (T *)hc::am_alloc(N * sizeof(T), acc, 0);
+    *twiddles = (T *)hc::am_alloc(N * sizeof(T), acc, KernelAllocFlags());
     hc::accelerator_view accl_view = acc.get_default_view();
     accl_view.copy(wc, *twiddles, N * sizeof(T));
     assert(twiddles != NULL);
+    FFTMetrics::Add(METRIC_TWIDDLE_BYTES, N * sizeof(T));
   }
 };
 
@@ -454,6 +474,10 @@ class Pass {
   bool halfLds;
   bool enableGrouping;
   bool linearRegs;
+  bool loadCallback;   // first pass reads global memory via the load callback
+  bool storeCallback;  // last pass writes global memory via the store callback
+  size_t cbCount;      // kernel count that scopes the callback snippets
+  bool halfStorage;    // global buffers hold fp16 data, registers stay fp32
   Pass<PR> *nextPass;
 
   inline void RegBase(size_t regC, std::string &str) const {
@@ -480,7 +504,7 @@ class Pass {
   }
 
   void DeclareRegs(const std::string &regType, size_t regC, size_t numB,
-                   std::string &passStr) const {
+                   CodeEmitter &passStr) const {
     std::string regBase;
     RegBase(regC, regBase);
 
@@ -556,8 +580,9 @@ class Pass {
                  bool interleaved, size_t stride, size_t component,
                  double scale, bool frontTwiddle, const std::string &bufferRe,
                  const std::string &bufferIm, const std::string &offset,
-                 size_t regC, size_t numB, size_t numPrev, std::string &passStr,
-                 bool isPrecallVector = false, bool oddt = false) const {
+                 size_t regC, size_t numB, size_t numPrev, CodeEmitter &passStr,
+                 bool isPrecallVector = false, bool oddt = false,
+                 bool callback = false) const {
     assert((flag == SR_READ) || (flag == SR_TWMUL) ||
            (flag == SR_TWMUL_3STEP) || (flag == SR_WRITE));
     const std::string twTable = TwTableName();
@@ -624,7 +649,7 @@ class Pass {
     if (numB && (numB % 2 == 0) && (regC == 1) && (stride == 1) &&
         (numButterfly % 2 == 0) && (algLS % 2 == 0) && (flag == SR_WRITE) &&
         (nextPass == NULL) && interleaved && (component == SR_COMP_BOTH) &&
-        linearRegs && enableGrouping) {
+        linearRegs && enableGrouping && !callback) {
       assert((numButterfly * workGroupSize) == algLS);
       assert(bufferRe.compare(bufferIm) == 0);  // Make sure Real & Imag buffer
                                                 // strings are same for
@@ -651,11 +676,11 @@ class Pass {
           passStr += "\n\t";
           passStr += "buff4g";
           passStr += "[ ";
-          passStr += SztToStr(numButterfly / 2);
+          passStr << numButterfly / 2;
           passStr += "*me + ";
-          passStr += SztToStr(butterflyIndex);
+          passStr << butterflyIndex;
           passStr += " + ";
-          passStr += SztToStr(r * (algLS / 2));
+          passStr << r * (algLS / 2);
           passStr += " ]";
           passStr += " = ";
           passStr += RegBaseType<PR>(4);
@@ -673,7 +698,7 @@ class Pass {
             passStr += " * ";
             passStr += RegBaseType<PR>(4);
             passStr += "(";
-            passStr += FloatToStr(scale);
+            passStr << scale;
             passStr += FloatSuffix<PR>();
             passStr += ")";
           }
@@ -764,10 +789,7 @@ class Pass {
             passStr += "\n\t";
             passStr += regIndex;
             passStr += " = ";
-            passStr += buffer;
-            passStr += "[";
-            passStr += bufOffset;
-            passStr += "]";
+            passStr += CallbackLoad(buffer, bufOffset, cbCount, callback);
             passStr += tail;
 
             // Since we read real & imag at once, we break the loop
@@ -846,7 +868,7 @@ class Pass {
               bufOffset += ")/";
               bufOffset += SztToStr(algLS);
               bufOffset += ")*";
-              passStr += SztToStr(algL);
+              passStr << algL;
               bufOffset += " + (";
               bufOffset += SztToStr(numButterfly);
               bufOffset += "*me + ";
@@ -879,14 +901,22 @@ class Pass {
             }
 
             passStr += "\n\t";
-            passStr += buffer;
-            passStr += "[";
-            passStr += bufOffset;
-            passStr += "]";
-            passStr += tail;
-            passStr += " = ";
-            passStr += regIndex;
-            passStr += ";";
+
+            if (callback) {
+              // the store callback always receives whole elements
+              assert(tail.empty());
+              passStr += CallbackStore(buffer, bufOffset, regIndex, cbCount,
+                                       callback);
+            } else {
+              passStr += buffer;
+              passStr += "[";
+              passStr += bufOffset;
+              passStr += "]";
+              passStr += tail;
+              passStr += " = ";
+              passStr += regIndex;
+              passStr += ";";
+            }
 
             // Since we write real & imag at once, we break the loop
             if (interleaved && (component == SR_COMP_BOTH)) {
@@ -986,10 +1016,7 @@ class Pass {
               passStr += "\n\t";
               passStr += regIndexSub;
               passStr += " = ";
-              passStr += buffer;
-              passStr += "[";
-              passStr += bufOffset;
-              passStr += "]";
+              passStr += CallbackLoad(buffer, bufOffset, cbCount, callback);
               passStr += tail;
             }
 
@@ -1036,45 +1063,45 @@ class Pass {
               passStr += " W = ";
               passStr += twTable;
               passStr += "[";
-              passStr += SztToStr(algLS - 1);
+              passStr << algLS - 1;
               passStr += " + ";
-              passStr += SztToStr(radix - 1);
+              passStr << radix - 1;
               passStr += "*((";
-              passStr += SztToStr(numButterfly);
+              passStr << numButterfly;
               passStr += "*me + ";
-              passStr += SztToStr(butterflyIndex);
+              passStr << butterflyIndex;
               passStr += ")%";
-              passStr += SztToStr(algLS);
+              passStr << algLS;
               passStr += ") + ";
-              passStr += SztToStr(r - 1);
+              passStr << r - 1;
               passStr += "];\n\t\t";
             } else {  // 3-step twiddle
               passStr += "\n\t{\n\t\t";
               passStr += twType;
               passStr += " W = ";
               passStr += tw3StepFunc;
-              passStr += SztToStr(plHandle);
+              passStr << plHandle;
               passStr += "( ";
 
               if (frontTwiddle) {
                 assert(linearRegs);
                 passStr += "(";
                 passStr += "me*";
-                passStr += SztToStr(numButterfly);
+                passStr << numButterfly;
                 passStr += " + ";
-                passStr += SztToStr(i);
+                passStr << i;
                 passStr += " + ";
-                passStr += SztToStr(r * length / radix);
+                passStr << r * length / radix;
                 passStr += ") * b";
               } else {
                 passStr += "((";
-                passStr += SztToStr(numButterfly);
+                passStr << numButterfly;
                 passStr += "*me + ";
-                passStr += SztToStr(butterflyIndex);
+                passStr << butterflyIndex;
                 passStr += ")%";
-                passStr += SztToStr(algLS);
+                passStr << algLS;
                 passStr += " + ";
-                passStr += SztToStr(r * algLS);
+                passStr << r * algLS;
                 passStr += ") * b";
               }
 
@@ -1188,6 +1215,7 @@ class Pass {
             }
 
             std::string regIndexC0;
+            std::string regRealC0;
 
             for (size_t c = cStart; c < cEnd;
                  c++) {  // component loop: 0 - real, 1 - imaginary
@@ -1238,6 +1266,12 @@ class Pass {
 
               passStr += "\n\t";
 
+              if (c == cStart) {
+                regRealC0 = regIndex;
+              }
+
+              std::string regRaw(regIndex);
+
               if (scale != 1.0f) {
                 regIndex += " * ";
                 regIndex += RegBaseType<PR>(2);
@@ -1281,14 +1315,45 @@ class Pass {
               bufOffset += SztToStr(r * algLS);
               bufOffset += " )*";
               bufOffset += SztToStr(stride);
-              passStr += buffer;
-              passStr += "[";
-              passStr += bufOffset;
-              passStr += "]";
-              passStr += tail;
-              passStr += " = ";
-              passStr += regIndex;
-              passStr += ";";
+
+              if (callback && !tail.empty()) {
+                // Interleaved elements are handed to the store callback
+                // whole, once both components are available
+                assert(component == SR_COMP_BOTH);
+
+                if (c == 1) {
+                  std::string value = RegBaseType<PR>(2);
+                  value += "(";
+                  value += regRealC0;
+                  value += ", ";
+                  value += regRaw;
+                  value += ")";
+
+                  if (scale != 1.0f) {
+                    value += " * ";
+                    value += RegBaseType<PR>(2);
+                    value += "(";
+                    value += FloatToStr(scale);
+                    value += FloatSuffix<PR>();
+                    value += ")";
+                  }
+
+                  passStr += CallbackStore(buffer, bufOffset, value, cbCount,
+                                           callback);
+                }
+              } else if (callback) {
+                passStr += CallbackStore(buffer, bufOffset, regIndex, cbCount,
+                                         callback);
+              } else {
+                passStr += buffer;
+                passStr += "[";
+                passStr += bufOffset;
+                passStr += "]";
+                passStr += tail;
+                passStr += " = ";
+                passStr += regIndex;
+                passStr += ";";
+              }
 
               // Since we write real & imag at once, we break the loop
               if (interleaved && (component == SR_COMP_BOTH) && linearRegs) {
@@ -1315,7 +1380,7 @@ class Pass {
                    size_t component, double scale, bool setZero, bool batch2,
                    bool oddt, const std::string &bufferRe,
                    const std::string &bufferIm, const std::string &offset,
-                   std::string &passStr) const {
+                   CodeEmitter &passStr, bool callback = false) const {
     assert((flag == SR_READ) || (flag == SR_WRITE));
     // component: 0 - real, 1 - imaginary, 2 - both
     size_t cStart, cEnd;
@@ -1435,35 +1500,35 @@ class Pass {
               passStr += "0;";
             }
           } else {
+            std::string bufOffset;
+
             if (act) {
-              passStr += buffer;
-              passStr += "[";
-              passStr += offset;
-              passStr += " + ( ";
+              bufOffset += offset;
+              bufOffset += " + ( ";
             }
 
             if (fwd) {
               if (cid == 0) {
-                passStr += idxStr;
+                bufOffset += idxStr;
               } else {
-                passStr += idxStrRev;
+                bufOffset += idxStrRev;
               }
             } else {
               if (cid == 0) {
                 if (!batch2) {
-                  passStr += idxStr;
+                  bufOffset += idxStr;
                 }
               } else {
                 if (batch2) {
-                  passStr += idxStr;
+                  bufOffset += idxStr;
                 }
               }
             }
 
             if (act) {
-              passStr += " )*";
-              passStr += SztToStr(stride);
-              passStr += "]";
+              bufOffset += " )*";
+              bufOffset += SztToStr(stride);
+              passStr += CallbackLoad(buffer, bufOffset, cbCount, callback);
 
               if (fwd) {
                 passStr += tail;
@@ -1559,29 +1624,17 @@ class Pass {
               idxStrRev += " - (";
               idxStrRev += idxStr;
               idxStrRev += " )";
-              std::string val1Str, val2Str;
-              val1Str += "\n\t";
-              val1Str += buffer;
-              val1Str += "[";
-              val1Str += offset;
-              val1Str += " + ( ";
-              val1Str += idxStr;
-              val1Str += " )*";
-              val1Str += SztToStr(stride);
-              val1Str += "]";
-              val1Str += tail;
-              val1Str += " = ";
-              val2Str += "\n\t";
-              val2Str += buffer;
-              val2Str += "[";
-              val2Str += offset;
-              val2Str += " + ( ";
-              val2Str += idxStrRev;
-              val2Str += " )*";
-              val2Str += SztToStr(stride);
-              val2Str += "]";
-              val2Str += tail;
-              val2Str += " = ";
+              std::string off1Str, off2Str, val1Str, val2Str;
+              off1Str += offset;
+              off1Str += " + ( ";
+              off1Str += idxStr;
+              off1Str += " )*";
+              off1Str += SztToStr(stride);
+              off2Str += offset;
+              off2Str += " + ( ";
+              off2Str += idxStrRev;
+              off2Str += " )*";
+              off2Str += SztToStr(stride);
               std::string real1, imag1, real2, imag2;
               real1 += "(";
               real1 += regIndex;
@@ -1664,12 +1717,40 @@ class Pass {
 
               val1Str += sclStr;
               val2Str += sclStr;
-              val1Str += ";";
-              passStr += val1Str;
 
-              if (rcFull) {
-                passStr += val2Str;
+              if (callback) {
+                assert(tail.empty());
+                passStr += "\n\t";
+                passStr += CallbackStore(buffer, off1Str, val1Str, cbCount,
+                                         callback);
+
+                if (rcFull) {
+                  passStr += "\n\t";
+                  passStr += CallbackStore(buffer, off2Str, val2Str, cbCount,
+                                           callback);
+                }
+              } else {
+                passStr += "\n\t";
+                passStr += buffer;
+                passStr += "[";
+                passStr += off1Str;
+                passStr += "]";
+                passStr += tail;
+                passStr += " = ";
+                passStr += val1Str;
                 passStr += ";";
+
+                if (rcFull) {
+                  passStr += "\n\t";
+                  passStr += buffer;
+                  passStr += "[";
+                  passStr += off2Str;
+                  passStr += "]";
+                  passStr += tail;
+                  passStr += " = ";
+                  passStr += val2Str;
+                  passStr += ";";
+                }
               }
             } else {
               std::string idxStr, idxStrRev;
@@ -1702,7 +1783,7 @@ class Pass {
               }
 
               passStr += " )*";
-              passStr += SztToStr(stride);
+              passStr << stride;
               passStr += "]";
               passStr += tail;
               passStr += " = ";
@@ -1752,8 +1833,59 @@ class Pass {
     }
   }
 
+  // Write the purely real DC term of a real-to-complex transform, read from
+  // the first element of 'src'
+  void WriteRealDC(const std::string &bufferRe, const std::string &bufferIm,
+                   const std::string &src, bool interleaved, double scale,
+                   bool callback, CodeEmitter &passStr) const {
+    std::string val = src;
+    val += "[inOffset]";
+
+    if (scale != 1.0) {
+      val += " * ";
+      val += RegBaseType<PR>(2);
+      val += "(";
+      val += FloatToStr(scale);
+      val += FloatSuffix<PR>();
+      val += ")";
+    }
+
+    if (callback) {
+      if (interleaved) {
+        std::string cVal = RegBaseType<PR>(2);
+        cVal += "(";
+        cVal += src;
+        cVal += "[inOffset]";
+
+        if (scale != 1.0) {
+          cVal += " * ";
+          cVal += FloatToStr(scale);
+          cVal += FloatSuffix<PR>();
+        }
+
+        cVal += ", 0)";
+        passStr += CallbackStore(bufferRe, "outOffset", cVal, cbCount, true);
+      } else {
+        passStr += CallbackStore(bufferRe, "outOffset", val, cbCount, true);
+        passStr += "\n\t";
+        passStr += CallbackStore(bufferIm, "outOffset", "0", cbCount, true);
+      }
+
+      passStr += "\n\t}";
+      return;
+    }
+
+    passStr += bufferRe;
+    passStr += interleaved ? "[outOffset].x = " : "[outOffset] = ";
+    passStr += val;
+    passStr += ";\n\t";
+    passStr += bufferIm;
+    passStr += interleaved ? "[outOffset].y = " : "[outOffset] = ";
+    passStr += "0;\n\t}";
+  }
+
   void CallButterfly(const std::string &bflyName, size_t regC, size_t numB,
-                     std::string &passStr) const {
+                     CodeEmitter &passStr) const {
     std::string regBase;
     RegBase(regC, regBase);
 
@@ -1814,6 +1946,10 @@ class Pass {
         halfLds(halfLdsVal),
         enableGrouping(true),
         linearRegs(linearRegsVal),
+        loadCallback(false),
+        storeCallback(false),
+        cbCount(0),
+        halfStorage(false),
         nextPass(NULL) {
     assert(radix <= length);
     assert(length % radix == 0);
@@ -1853,8 +1989,14 @@ class Pass {
 
   void SetNextPass(Pass<PR> *np) { nextPass = np; }
   void SetGrouping(bool grp) { enableGrouping = grp; }
+  void SetCallbacks(bool load, bool store, size_t count) {
+    loadCallback = load;
+    storeCallback = store;
+    cbCount = count;
+  }
+  void SetHalfStorage(bool half) { halfStorage = half; }
   void GeneratePass(const hcfftPlanHandle plHandle, bool fwd,
-                    std::string &passStr, bool fft_3StepTwiddle,
+                    CodeEmitter &passStr, bool fft_3StepTwiddle,
                     bool twiddleFront, bool inInterleaved, bool outInterleaved,
                     bool inReal, bool outReal, size_t inStride,
                     size_t outStride, double scale, size_t lWorkSize,
@@ -1876,6 +2018,9 @@ class Pass {
     const std::string bufferOutIm2 =
         (outReal || outInterleaved) ? "bufOut2" : "bufOutIm2";
     std::string twType = RegBaseType<PR>(2);
+    // User callbacks replace only the accesses to global memory
+    const bool cbLoad = gIn && loadCallback;
+    const bool cbStore = gOut && storeCallback;
 
     // for real transforms we use only B1 butteflies (regC = 1)
     if (r2c || c2r) {
@@ -1899,6 +2044,9 @@ class Pass {
     std::string regB1Type = RegBaseType<PR>(1);
     std::string regB2Type = RegBaseType<PR>(2);
     std::string regB4Type = RegBaseType<PR>(4);
+    // Global buffer types
+    std::string memB1Type = halfStorage ? HalfBaseType(1) : regB1Type;
+    std::string memB2Type = halfStorage ? HalfBaseType(2) : regB2Type;
     // Function attribute
     passStr += "inline void\n";
     // Function name
@@ -1924,50 +2072,50 @@ class Pass {
 
       if (gIn) {
         if (inInterleaved) {
-          passStr += regB2Type;
+          passStr += memB2Type;
           passStr += " *";
           passStr += bufferInRe;
           passStr += ", ";
 
           if (!rcSimple) {
-            passStr += regB2Type;
+            passStr += memB2Type;
             passStr += " *";
             passStr += bufferInRe2;
             passStr += ", ";
           }
         } else if (inReal) {
-          passStr += regB1Type;
+          passStr += memB1Type;
           passStr += " *";
           passStr += bufferInRe;
           passStr += ", ";
 
           if (!rcSimple) {
-            passStr += regB1Type;
+            passStr += memB1Type;
             passStr += " *";
             passStr += bufferInRe2;
             passStr += ", ";
           }
         } else {
-          passStr += regB1Type;
+          passStr += memB1Type;
           passStr += " *";
           passStr += bufferInRe;
           passStr += ", ";
 
           if (!rcSimple) {
-            passStr += regB1Type;
+            passStr += memB1Type;
             passStr += " *";
             passStr += bufferInRe2;
             passStr += ", ";
             passStr += "unsigned int iOffset2,";
           }
 
-          passStr += regB1Type;
+          passStr += memB1Type;
           passStr += " *";
           passStr += bufferInIm;
           passStr += ", ";
 
           if (!rcSimple) {
-            passStr += regB1Type;
+            passStr += memB1Type;
             passStr += " *";
             passStr += bufferInIm2;
             passStr += ", ";
@@ -1986,47 +2134,47 @@ class Pass {
 
       if (gOut) {
         if (outInterleaved) {
-          passStr += regB2Type;
+          passStr += memB2Type;
           passStr += " *";
           passStr += bufferOutRe;
 
           if (!rcSimple) {
             passStr += ", ";
-            passStr += regB2Type;
+            passStr += memB2Type;
             passStr += " *";
             passStr += bufferOutRe2;
           }
         } else if (outReal) {
-          passStr += regB1Type;
+          passStr += memB1Type;
           passStr += " *";
           passStr += bufferOutRe;
 
           if (!rcSimple) {
             passStr += ", ";
-            passStr += regB1Type;
+            passStr += memB1Type;
             passStr += " *";
             passStr += bufferOutRe2;
           }
         } else {
-          passStr += regB1Type;
+          passStr += memB1Type;
           passStr += " *";
           passStr += bufferOutRe;
           passStr += ", ";
 
           if (!rcSimple) {
-            passStr += regB1Type;
+            passStr += memB1Type;
             passStr += " *";
             passStr += bufferOutRe2;
             passStr += ", ";
           }
 
-          passStr += regB1Type;
+          passStr += memB1Type;
           passStr += " *";
           passStr += bufferOutIm;
 
           if (!rcSimple) {
             passStr += ", ";
-            passStr += regB1Type;
+            passStr += memB1Type;
             passStr += " *";
             passStr += bufferOutIm2;
           }
@@ -2043,16 +2191,16 @@ class Pass {
     } else {
       if (gIn) {
         if (inInterleaved) {
-          passStr += regB2Type;
+          passStr += memB2Type;
           passStr += " *";
           passStr += bufferInRe;
           passStr += ", ";
         } else {
-          passStr += regB1Type;
+          passStr += memB1Type;
           passStr += " *";
           passStr += bufferInRe;
           passStr += ", ";
-          passStr += regB1Type;
+          passStr += memB1Type;
           passStr += " *";
           passStr += bufferInIm;
           passStr += ", ";
@@ -2077,15 +2225,15 @@ class Pass {
 
       if (gOut) {
         if (outInterleaved) {
-          passStr += regB2Type;
+          passStr += memB2Type;
           passStr += " *";
           passStr += bufferOutRe;
         } else {
-          passStr += regB1Type;
+          passStr += memB1Type;
           passStr += " *";
           passStr += bufferOutRe;
           passStr += ", ";
-          passStr += regB1Type;
+          passStr += memB1Type;
           passStr += " *";
           passStr += bufferOutIm;
         }
@@ -2126,6 +2274,10 @@ class Pass {
       passStr += TwTableLargeName();
     }
 
+    if (loadCallback || storeCallback) {
+      passStr += ", void *loadInfo, void *storeInfo, void *cbIn, void *cbOut";
+    }
+
     passStr += ", hc::tiled_index<2> &tidx) [[hc]]\n{\n";
 
     // Register Declarations
@@ -2147,13 +2299,13 @@ class Pass {
       passStr += "\n\t";
       passStr += regB2Type;
       passStr += " R";
-      passStr += SztToStr(cnPerWI);
+      passStr << cnPerWI;
       passStr += "[1];\n\t";
       passStr += "(R";
-      passStr += SztToStr(cnPerWI);
+      passStr << cnPerWI;
       passStr += "[0]).x = 0; ";
       passStr += "(R";
-      passStr += SztToStr(cnPerWI);
+      passStr << cnPerWI;
       passStr += "[0]).y = 0;\n";
     }
 
@@ -2163,7 +2315,7 @@ class Pass {
       passStr += "\n\t";
       passStr += regB1Type;
       passStr += " mpvt[";
-      passStr += SztToStr(length);
+      passStr << length;
       passStr += "];\n";
     }
 
@@ -2175,7 +2327,7 @@ class Pass {
         passStr += "\n\tif(rw)\n\t{";
         SweepRegs(plHandle, SR_READ, fwd, inInterleaved, inStride, SR_COMP_REAL,
                   1.0f, false, bufferInRe, bufferInIm, "inOffset", 1, numB1, 0,
-                  passStr);
+                  passStr, false, false, cbLoad);
         passStr += "\n\t}\n";
 
         if (rcSimple) {
@@ -2188,7 +2340,7 @@ class Pass {
           passStr += "\n\tif(rw > 1)\n\t{";
           SweepRegs(plHandle, SR_READ, fwd, inInterleaved, inStride,
                     SR_COMP_IMAG, 1.0f, false, bufferInRe2, bufferInIm2,
-                    "inOffset", 1, numB1, 0, passStr);
+                    "inOffset", 1, numB1, 0, passStr, false, false, cbLoad);
           passStr += "\n\t}\n";
           passStr += "\telse\n\t{";
           SweepRegsRC(SR_READ, fwd, inInterleaved, inStride, SR_COMP_IMAG, 1.0f,
@@ -2216,8 +2368,7 @@ class Pass {
         passStr += "[";
         passStr += processBufOffset;
         passStr += "] = ";
-        passStr += bufferInRe;
-        passStr += "[inOffset]";
+        passStr += CallbackLoad(bufferInRe, "inOffset", cbCount, cbLoad);
 
         if (inInterleaved) {
           passStr += ".x;\n\t}";
@@ -2229,28 +2380,28 @@ class Pass {
           passStr += "\n\n\tif(rw)\n\t{";
           SweepRegsRC(SR_READ, fwd, inInterleaved, inStride, SR_COMP_REAL, 1.0f,
                       false, false, false, bufferInRe, bufferInRe, "inOffset",
-                      passStr);
+                      passStr, cbLoad);
           passStr += "\n\t}\n";
           passStr += "\n\tif(rw > 1)\n\t{";
           SweepRegsRC(SR_READ, fwd, inInterleaved, inStride, SR_COMP_REAL, 1.0f,
                       false, true, false, bufferInIm2, bufferInIm2, "inOffset",
-                      passStr);
+                      passStr, cbLoad);
           passStr += "\n\t}\n\telse\n\t{";
           SweepRegsRC(SR_READ, fwd, inInterleaved, inStride, SR_COMP_REAL, 1.0f,
                       true, true, false, bufferInIm2, bufferInIm2, "inOffset",
-                      passStr);
+                      passStr, cbLoad);
           passStr += "\n\t}\n";
 
           if (oddp) {
             passStr += "\n\tif(rw && (me%2))\n\t{";
             SweepRegsRC(SR_READ, fwd, inInterleaved, inStride, SR_COMP_REAL,
                         1.0f, false, false, true, bufferInRe, bufferInRe,
-                        "inOffset", passStr);
+                        "inOffset", passStr, cbLoad);
             passStr += "\n\t}";
             passStr += "\n\tif((rw > 1) && (me%2))\n\t{";
             SweepRegsRC(SR_READ, fwd, inInterleaved, inStride, SR_COMP_REAL,
                         1.0f, false, true, true, bufferInIm2, bufferInIm2,
-                        "inOffset", passStr);
+                        "inOffset", passStr, cbLoad);
             passStr += "\n\t}\n";
           }
 
@@ -2289,8 +2440,7 @@ class Pass {
         passStr += "[";
         passStr += processBufOffset;
         passStr += "] = ";
-        passStr += bufferInRe2;
-        passStr += "[inOffset]";
+        passStr += CallbackLoad(bufferInRe2, "inOffset", cbCount, cbLoad);
 
         if (inInterleaved) {
           passStr += ".x;\n\t}";
@@ -2308,28 +2458,28 @@ class Pass {
           passStr += "\n\n\tif(rw)\n\t{";
           SweepRegsRC(SR_READ, fwd, inInterleaved, inStride, SR_COMP_IMAG, 1.0f,
                       false, false, false, bufferInIm, bufferInIm, "inOffset",
-                      passStr);
+                      passStr, cbLoad);
           passStr += "\n\t}\n";
           passStr += "\n\tif(rw > 1)\n\t{";
           SweepRegsRC(SR_READ, fwd, inInterleaved, inStride, SR_COMP_IMAG, 1.0f,
                       false, true, false, bufferInRe2, bufferInRe2, "inOffset",
-                      passStr);
+                      passStr, cbLoad);
           passStr += "\n\t}\n\telse\n\t{";
           SweepRegsRC(SR_READ, fwd, inInterleaved, inStride, SR_COMP_IMAG, 1.0f,
                       true, true, false, bufferInRe2, bufferInRe2, "inOffset",
-                      passStr);
+                      passStr, cbLoad);
           passStr += "\n\t}\n";
 
           if (oddp) {
             passStr += "\n\tif(rw && (me%2))\n\t{";
             SweepRegsRC(SR_READ, fwd, inInterleaved, inStride, SR_COMP_IMAG,
                         1.0f, false, false, true, bufferInIm, bufferInIm,
-                        "inOffset", passStr);
+                        "inOffset", passStr, cbLoad);
             passStr += "\n\t}";
             passStr += "\n\tif((rw > 1) && (me%2))\n\t{";
             SweepRegsRC(SR_READ, fwd, inInterleaved, inStride, SR_COMP_IMAG,
                         1.0f, false, true, true, bufferInRe2, bufferInRe2,
-                        "inOffset", passStr);
+                        "inOffset", passStr, cbLoad);
             passStr += "\n\t}";
           }
 
@@ -2371,13 +2521,13 @@ class Pass {
         passStr += "\n\tif(rw)\n\t{";
         SweepRegs(plHandle, SR_READ, fwd, inInterleaved, inStride, SR_COMP_BOTH,
                   1.0f, false, bufferInRe, bufferInIm, "inOffset", 1, numB1, 0,
-                  passStr, isPrecallVector);
+                  passStr, isPrecallVector, false, cbLoad);
         SweepRegs(plHandle, SR_READ, fwd, inInterleaved, inStride, SR_COMP_BOTH,
                   1.0f, false, bufferInRe, bufferInIm, "inOffset", 2, numB2,
-                  numB1, passStr, isPrecallVector);
+                  numB1, passStr, isPrecallVector, false, cbLoad);
         SweepRegs(plHandle, SR_READ, fwd, inInterleaved, inStride, SR_COMP_BOTH,
                   1.0f, false, bufferInRe, bufferInIm, "inOffset", 4, numB4,
-                  2 * numB2 + numB1, passStr, isPrecallVector);
+                  2 * numB2 + numB1, passStr, isPrecallVector, false, cbLoad);
         passStr += "\n\t}\n";
       }
     }
@@ -2484,45 +2634,8 @@ class Pass {
 
             passStr += "\n\n\n\tif(rw && !me)\n\t{\n\t";
 
-            if (outInterleaved) {
-              passStr += bufferOutRe;
-              passStr += "[outOffset].x = ";
-              passStr += bufferInRe;
-              passStr += "[inOffset]";
-
-              if (scale != 1.0) {
-                passStr += " * ";
-                passStr += RegBaseType<PR>(2);
-                passStr += "(";
-                passStr += FloatToStr(scale);
-                passStr += FloatSuffix<PR>();
-                passStr += ")";
-              }
-
-              passStr += ";\n\t";
-              passStr += bufferOutIm;
-              passStr += "[outOffset].y = ";
-              passStr += "0;\n\t}";
-            } else {
-              passStr += bufferOutRe;
-              passStr += "[outOffset] = ";
-              passStr += bufferInRe;
-              passStr += "[inOffset]";
-
-              if (scale != 1.0) {
-                passStr += " * ";
-                passStr += RegBaseType<PR>(2);
-                passStr += "(";
-                passStr += FloatToStr(scale);
-                passStr += FloatSuffix<PR>();
-                passStr += ")";
-              }
-
-              passStr += ";\n\t";
-              passStr += bufferOutIm;
-              passStr += "[outOffset] = ";
-              passStr += "0;\n\t}";
-            }
+            WriteRealDC(bufferOutRe, bufferOutIm, bufferInRe, outInterleaved, scale, cbStore,
+                        passStr);
 
             passStr +=
                 "\n\ntidx.barrier.wait_with_tile_static_memory_fence();\n";
@@ -2545,45 +2658,8 @@ class Pass {
 
             passStr += "\n\tif((rw > 1) && !me)\n\t{\n\t";
 
-            if (outInterleaved) {
-              passStr += bufferOutRe2;
-              passStr += "[outOffset].x = ";
-              passStr += bufferInIm;
-              passStr += "[inOffset]";
-
-              if (scale != 1.0) {
-                passStr += " * ";
-                passStr += RegBaseType<PR>(2);
-                passStr += "(";
-                passStr += FloatToStr(scale);
-                passStr += FloatSuffix<PR>();
-                passStr += ")";
-              }
-
-              passStr += ";\n\t";
-              passStr += bufferOutIm2;
-              passStr += "[outOffset].y = ";
-              passStr += "0;\n\t}";
-            } else {
-              passStr += bufferOutRe2;
-              passStr += "[outOffset] = ";
-              passStr += bufferInIm;
-              passStr += "[inOffset]";
-
-              if (scale != 1.0) {
-                passStr += " * ";
-                passStr += RegBaseType<PR>(2);
-                passStr += "(";
-                passStr += FloatToStr(scale);
-                passStr += FloatSuffix<PR>();
-                passStr += ")";
-              }
-
-              passStr += ";\n\t";
-              passStr += bufferOutIm2;
-              passStr += "[outOffset] = ";
-              passStr += "0;\n\t}";
-            }
+            WriteRealDC(bufferOutRe2, bufferOutIm2, bufferInIm, outInterleaved, scale, cbStore,
+                        passStr);
 
             passStr +=
                 "\n\ntidx.barrier.wait_with_tile_static_memory_fence();\n";
@@ -2592,7 +2668,7 @@ class Pass {
           passStr += "\n\n\tif(rw)\n\t{";
           SweepRegsRC(SR_WRITE, fwd, outInterleaved, outStride, SR_COMP_BOTH,
                       scale, false, false, false, bufferOutRe, bufferOutIm,
-                      "outOffset", passStr);
+                      "outOffset", passStr, cbStore);
           passStr += "\n\t}\n";
 
           if (oddp) {
@@ -2600,14 +2676,14 @@ class Pass {
             passStr += "if(brv)\n\t{";
             SweepRegsRC(SR_WRITE, fwd, outInterleaved, outStride, SR_COMP_BOTH,
                         scale, false, false, true, bufferOutRe, bufferOutIm,
-                        "outOffset", passStr);
+                        "outOffset", passStr, cbStore);
             passStr += "\n\t}\n";
           }
 
           passStr += "\n\n\tif(rw > 1)\n\t{";
           SweepRegsRC(SR_WRITE, fwd, outInterleaved, outStride, SR_COMP_BOTH,
                       scale, false, true, false, bufferOutRe2, bufferOutIm2,
-                      "outOffset", passStr);
+                      "outOffset", passStr, cbStore);
           passStr += "\n\t}\n";
 
           if (oddp) {
@@ -2615,28 +2691,29 @@ class Pass {
             passStr += "if(brv)\n\t{";
             SweepRegsRC(SR_WRITE, fwd, outInterleaved, outStride, SR_COMP_BOTH,
                         scale, false, true, true, bufferOutRe2, bufferOutIm2,
-                        "outOffset", passStr);
+                        "outOffset", passStr, cbStore);
             passStr += "\n\t}\n";
           }
         } else if (c2r) {
           passStr += "\n\tif(rw)\n\t{";
           SweepRegs(plHandle, SR_WRITE, fwd, outInterleaved, outStride,
                     SR_COMP_REAL, scale, false, bufferOutRe, bufferOutIm,
-                    "outOffset", 1, numB1, 0, passStr);
+                    "outOffset", 1, numB1, 0, passStr, false, false, cbStore);
           passStr += "\n\t}\n";
 
           if (!rcSimple) {
             passStr += "\n\tif(rw > 1)\n\t{";
             SweepRegs(plHandle, SR_WRITE, fwd, outInterleaved, outStride,
                       SR_COMP_IMAG, scale, false, bufferOutRe2, bufferOutIm2,
-                      "outOffset", 1, numB1, 0, passStr);
+                      "outOffset", 1, numB1, 0, passStr, false, false,
+                      cbStore);
             passStr += "\n\t}\n";
           }
         } else {
           passStr += "\n\tif(rw)\n\t{";
           SweepRegs(plHandle, SR_WRITE, fwd, outInterleaved, outStride,
                     SR_COMP_BOTH, scale, false, bufferOutRe, bufferOutIm,
-                    "outOffset", 1, numB1, 0, passStr);
+                    "outOffset", 1, numB1, 0, passStr, false, false, cbStore);
           passStr += "\n\t}\n";
         }
       } else {
@@ -2671,13 +2748,14 @@ class Pass {
       passStr += "\n\tif(rw)\n\t{";
       SweepRegs(plHandle, SR_WRITE, fwd, outInterleaved, outStride,
                 SR_COMP_BOTH, scale, false, bufferOutRe, bufferOutIm,
-                "outOffset", 1, numB1, 0, passStr);
+                "outOffset", 1, numB1, 0, passStr, false, false, cbStore);
       SweepRegs(plHandle, SR_WRITE, fwd, outInterleaved, outStride,
                 SR_COMP_BOTH, scale, false, bufferOutRe, bufferOutIm,
-                "outOffset", 2, numB2, numB1, passStr);
+                "outOffset", 2, numB2, numB1, passStr, false, false, cbStore);
       SweepRegs(plHandle, SR_WRITE, fwd, outInterleaved, outStride,
                 SR_COMP_BOTH, scale, false, bufferOutRe, bufferOutIm,
-                "outOffset", 4, numB4, 2 * numB2 + numB1, passStr);
+                "outOffset", 4, numB4, 2 * numB2 + numB1, passStr, false,
+                false, cbStore);
       passStr += "\n\t}\n";
     }
 
@@ -2758,6 +2836,11 @@ class Kernel {
       return false;
     }
 
+    // Grouped accesses reinterpret the global buffers as fp32 vectors
+    if (params.fft_precision == HCFFT_HALF) {
+      return false;
+    }
+
     if (params.fft_placeness == HCFFT_INPLACE) {
       iStride = oStride = params.fft_inStride;
     } else {
@@ -2895,6 +2978,56 @@ class Kernel {
   }
 
  public:
+  const std::vector<size_t> &Radices() const { return radices; }
+
+  // Static cost of 'count' transforms of the kernel. Butterfly arithmetic is
+  // counted in the generated source, twiddle multiplies and LDS traffic follow
+  // from the passes; barriers are per work-group and registers per work-item
+  void Cost(size_t count, double *flops, double *ldsBytes, size_t *barriers,
+            size_t *registers) const {
+    // Real transforms go in pairs through one complex FFT
+    size_t ffts = (r2c2r && !rcSimple) ? DivRoundingUp<size_t>(count, 2)
+                                       : count;
+    double fftFlops = 0;
+    size_t maxRadix = 1;
+
+    for (size_t p = 0; p < numPasses; p++) {
+      size_t radix = radices[p];
+      CodeEmitter bfly;
+      Butterfly<PR>(radix, 1, true, true).GenerateButterfly(bfly, 0);
+      fftFlops +=
+          static_cast<double>(length / radix) * CountFlops(bfly.str());
+
+      if (p > 0) {
+        fftFlops += 6.0 * (length / radix) * (radix - 1);
+      }
+
+      maxRadix = std::max(maxRadix, radix);
+    }
+
+    // Splitting the pair into the two real results
+    if (r2c2r && !rcSimple) {
+      fftFlops += 4.0 * length;
+    }
+
+    if (params.fft_3StepTwiddle) {
+      fftFlops += 12.0 * length;
+    }
+
+    double elementBytes = 2.0 * PrecisionWidth<PR>() * sizeof(float);
+    double fftLds = 2.0 * (numPasses - 1) * length * elementBytes;
+    *barriers = (numPasses - 1) * (halfLds ? 4 : 2);
+
+    if (blockCompute) {
+      fftLds += 2.0 * length * elementBytes;
+      *barriers += 2;
+    }
+
+    *flops = fftFlops * ffts;
+    *ldsBytes = fftLds * ffts;
+    *registers = 2 * PrecisionWidth<PR>() * (cnPerWI + maxRadix) + 16;
+  }
+
   explicit Kernel(const FFTKernelGenKeyParams &paramsVal)
       : r2c2r(false),
         params(paramsVal) {
@@ -3127,11 +3260,13 @@ class Kernel {
 
   void GenerateKernel(void **twiddles, void **twiddleslarge,
                       hc::accelerator acc, const hcfftPlanHandle plHandle,
-                      std::string &str, std::vector<size_t> gWorkSize,
+                      CodeEmitter &str, std::vector<size_t> gWorkSize,
                       std::vector<size_t> lWorkSize, size_t count) {
     std::string twType = RegBaseType<PR>(2);
-    std::string rType = RegBaseType<PR>(1);
-    std::string r2Type = RegBaseType<PR>(2);
+    // Global buffer types, fp16 for half precision storage
+    bool halfStorage = (params.fft_precision == HCFFT_HALF);
+    std::string rType = halfStorage ? HalfBaseType(1) : RegBaseType<PR>(1);
+    std::string r2Type = halfStorage ? HalfBaseType(2) : RegBaseType<PR>(2);
     bool inInterleaved;   // Input is interleaved format
     bool outInterleaved;  // Output is interleaved format
     inInterleaved = ((params.fft_inputLayout == HCFFT_COMPLEX_INTERLEAVED) ||
@@ -3151,6 +3286,8 @@ class Kernel {
     inReal = (params.fft_inputLayout == HCFFT_REAL) ? true : false;
     outReal = (params.fft_outputLayout == HCFFT_REAL) ? true : false;
     size_t large1D = 0;
+    bool hasCallbacks =
+        params.fft_hasLoadCallback || params.fft_hasStoreCallback;
 
     if (params.fft_realSpecial) {
       large1D = params.fft_N[0] * params.fft_realSpecial_Nr;
@@ -3406,6 +3543,14 @@ class Kernel {
       }
     }
 
+    // Route the global accesses of the first and last pass through the user
+    // callbacks
+    for (size_t i = 0; i < numPasses; i++) {
+      passes[i].SetCallbacks(params.fft_hasLoadCallback,
+                             params.fft_hasStoreCallback, count);
+      passes[i].SetHalfStorage(params.fft_precision == HCFFT_HALF);
+    }
+
     // Generate passes
     for (size_t d = 0; d < 2; d++) {
       bool fwd;
@@ -3495,10 +3640,10 @@ class Kernel {
       // Function name
       if (fwd) {
         str += "fft_fwd";
-        str += SztToStr(count);
+        str << count;
       } else {
         str += "fft_back";
-        str += SztToStr(count);
+        str << count;
       }
 
       str +=
@@ -3513,7 +3658,7 @@ class Kernel {
             str += " *gb = static_cast<";
             str += r2Type;
             str += "*> (vectArr[";
-            str += SztToStr(arg);
+            str << arg;
             str += "]);\n";
             arg++;
           } else {
@@ -3521,7 +3666,7 @@ class Kernel {
             str += " *gb = static_cast<";
             str += rType;
             str += "*> (vectArr[";
-            str += SztToStr(arg);
+            str << arg;
             str += "]);\n";
             arg++;
           }
@@ -3535,7 +3680,7 @@ class Kernel {
             str += " *gb = static_cast<";
             str += r2Type;
             str += "*> (vectArr[";
-            str += SztToStr(arg);
+            str << arg;
             str += "]);\n";
             arg++;
           } else {
@@ -3543,14 +3688,14 @@ class Kernel {
             str += " *gbRe = static_cast<";
             str += rType;
             str += "*> (vectArr[";
-            str += SztToStr(arg);
+            str << arg;
             str += "]);\n";
             arg++;
             str += rType;
             str += " *gbIm = static_cast<";
             str += rType;
             str += "*> (vectArr[";
-            str += SztToStr(arg);
+            str << arg;
             str += "]);\n";
             arg++;
           }
@@ -3678,11 +3823,11 @@ class Kernel {
       // Twiddle table
       if (length > 1) {
         str += "\n\n";
-        str += r2Type;
+        str += twType;
         str += " *";
         str += TwTableName();
         str += " = static_cast< ";
-        str += r2Type;
+        str += twType;
         str += " *> (vectArr[";
         str += SztToStr(arg);
         str += "]);\n";
@@ -3706,17 +3851,47 @@ class Kernel {
       // twiddle factors for 1d-large 3-step algorithm
       if (params.fft_3StepTwiddle) {
         str += "\n\n";
-        str += r2Type;
+        str += twType;
         str += " *";
         str += TwTableLargeName();
         str += " = static_cast< ";
-        str += r2Type;
+        str += twType;
         str += " *> (vectArr[";
         str += SztToStr(arg);
         str += "]);\n";
         arg++;
       }
 
+      // caller info of the load/store callbacks
+      if (hasCallbacks) {
+        str += "\tvoid *loadInfo = vectArr[";
+        str += SztToStr(arg);
+        str += "];\n";
+        arg++;
+        str += "\tvoid *storeInfo = vectArr[";
+        str += SztToStr(arg);
+        str += "];\n";
+        arg++;
+
+        // Callbacks are given offsets from the start of the user buffers, not
+        // of the row or column a kernel works on
+        std::string cbIn, cbOut;
+
+        if (params.fft_placeness == HCFFT_INPLACE) {
+          cbIn = cbOut = (r2c2r || inInterleaved) ? "gb" : "gbRe";
+        } else {
+          cbIn = (inInterleaved || (r2c2r && inReal)) ? "gbIn" : "gbInRe";
+          cbOut = (outInterleaved || (r2c2r && outReal)) ? "gbOut" : "gbOutRe";
+        }
+
+        str += "\tvoid *cbIn = ";
+        str += cbIn;
+        str += ";\n";
+        str += "\tvoid *cbOut = ";
+        str += cbOut;
+        str += ";\n";
+      }
+
       str += "\thc::extent<2> grdExt( ";
       str += SztToStr(gWorkSize[0]);
       str += ", 1 ); \n";
@@ -3736,7 +3911,7 @@ class Kernel {
       if (blockCompute) {
         str += "\n\t";
         str += "tile_static ";
-        str += r2Type;
+        str += RegBaseType<PR>(2);
         str += " lds[";
         str += SztToStr(blockLDS);
         str += "];\n";
@@ -3747,7 +3922,7 @@ class Kernel {
         if (numPasses > 1) {
           str += "\n\t";
           str += "tile_static ";
-          str += ldsInterleaved ? r2Type : rType;
+          str += ldsInterleaved ? RegBaseType<PR>(2) : RegBaseType<PR>(1);
           str += " lds[";
           str += SztToStr(ldsSize);
           str += "];\n";
@@ -4120,23 +4295,19 @@ class Kernel {
             bufOffset += " + t*";
             bufOffset +=
                 SztToStr(params.fft_inStride[0] * blockWGS / blockWidth);
-            str += "\t\tR0";
-            str += comp;
-            str += " = ";
-            str += readBuf;
-            str += "[";
-            str += bufOffset;
-            str += "];\n";
           } else {
-            str += "\t\tR0";
-            str += comp;
-            str += " = ";
-            str += readBuf;
-            str += "[me + t*";
-            str += SztToStr(blockWGS);
-            str += "];\n";
+            bufOffset.clear();
+            bufOffset += "me + t*";
+            bufOffset += SztToStr(blockWGS);
           }
 
+          str += "\t\tR0";
+          str += comp;
+          str += " = ";
+          str += CallbackLoad(readBuf, bufOffset, count,
+                              params.fft_hasLoadCallback);
+          str += ";\n";
+
           if (inInterleaved) {
             break;
           }
@@ -4268,6 +4439,9 @@ class Kernel {
       }
 
       // Call passes
+      std::string cbArgs =
+          hasCallbacks ? ", loadInfo, storeInfo, cbIn, cbOut" : "";
+
       if (numPasses == 1) {
         str += "\t";
         str += PassName(count, 0, fwd);
@@ -4289,6 +4463,7 @@ class Kernel {
           str += TwTableLargeName();
         }
 
+        str += cbArgs;
         str += ",tidx);\n";
       } else {
         for (typename std::vector<Pass<PR> >::const_iterator p = passes.begin();
@@ -4375,6 +4550,7 @@ class Kernel {
               str += TwTableLargeName();
             }
 
+            str += cbArgs;
             str += ",tidx);\n";
 
             if (!halfLds) {
@@ -4401,6 +4577,7 @@ class Kernel {
               str += TwTableLargeName();
             }
 
+            str += cbArgs;
             str += ",tidx);\n";
 
             if (!halfLds) {
@@ -4427,6 +4604,7 @@ class Kernel {
               str += TwTableLargeName();
             }
 
+            str += cbArgs;
             str += ",tidx);\n";
 
             if (!halfLds) {
@@ -4499,31 +4677,29 @@ class Kernel {
                            : (c ? "lwbOutIm" : "lwbOutRe");
           }
 
+          std::string bufOffset;
+
           if ((blockComputeType == BCT_C2C) || (blockComputeType == BCT_R2C)) {
-            str += "\t\t";
-            str += writeBuf;
-            str += "[(me%";
-            str += SztToStr(blockWidth);
-            str += ") + ";
-            str += "(me/";
-            str += SztToStr(blockWidth);
-            str += ")*";
-            str += SztToStr(params.fft_outStride[0]);
-            str += " + t*";
-            str += SztToStr(params.fft_outStride[0] * blockWGS / blockWidth);
-            str += "] = R0";
-            str += comp;
-            str += ";\n";
+            bufOffset += "(me%";
+            bufOffset += SztToStr(blockWidth);
+            bufOffset += ") + ";
+            bufOffset += "(me/";
+            bufOffset += SztToStr(blockWidth);
+            bufOffset += ")*";
+            bufOffset += SztToStr(params.fft_outStride[0]);
+            bufOffset += " + t*";
+            bufOffset +=
+                SztToStr(params.fft_outStride[0] * blockWGS / blockWidth);
           } else {
-            str += "\t\t";
-            str += writeBuf;
-            str += "[me + t*";
-            str += SztToStr(blockWGS);
-            str += "] = R0";
-            str += comp;
-            str += ";\n";
+            bufOffset += "me + t*";
+            bufOffset += SztToStr(blockWGS);
           }
 
+          str += "\t\t";
+          str += CallbackStore(writeBuf, bufOffset, "R0" + comp, count,
+                               params.fft_hasStoreCallback);
+          str += "\n";
+
           if (outInterleaved) {
             break;
           }
@@ -4545,6 +4721,52 @@ class Kernel {
 
 // using namespace StockhamGenerator;
 
+template <StockhamGenerator::Precision PR>
+static void KernelRadices(size_t maxWorkGroupSize, size_t length,
+                          std::vector<size_t>* radices) {
+  FFTKernelGenKeyParams params;
+  size_t wgs, nt;
+  StockhamGenerator::KernelWorkSizes<PR>(maxWorkGroupSize, length, wgs, nt);
+  params.fft_DataDim = 2;
+  params.fft_N[0] = length;
+  params.fft_precision = (PR == StockhamGenerator::P_DOUBLE) ? HCFFT_DOUBLE
+                                                             : HCFFT_SINGLE;
+  params.fft_MaxWorkGroupSize = maxWorkGroupSize;
+  params.fft_R = (nt * length) / wgs;
+  params.fft_SIMD = wgs;
+  StockhamGenerator::Kernel<PR> kernel(params);
+  *radices = kernel.Radices();
+}
+
+void StockhamRadices(hcfftPrecision precision, size_t maxWorkGroupSize,
+                     size_t length, std::vector<size_t>* radices) {
+  if (precision == HCFFT_DOUBLE) {
+    KernelRadices<StockhamGenerator::P_DOUBLE>(maxWorkGroupSize, length,
+                                               radices);
+  } else {
+    KernelRadices<StockhamGenerator::P_SINGLE>(maxWorkGroupSize, length,
+                                               radices);
+  }
+}
+
+size_t StockhamBlockWidth(hcfftPrecision precision, size_t length) {
+  // Blocked columns are generated for power of 2 lengths from 8 to 256
+  if (!IsPo2(length) || (length < 8) || (length > 256)) {
+    return 0;
+  }
+
+  switch (precision) {
+    case HCFFT_SINGLE:
+      return StockhamGenerator::Kernel<StockhamGenerator::P_SINGLE>::BlockSizes::BlockWidth(length);
+
+    case HCFFT_DOUBLE:
+      return StockhamGenerator::Kernel<StockhamGenerator::P_DOUBLE>::BlockSizes::BlockWidth(length);
+
+    default:
+      return 0;
+  }
+}
+
 template <>
 hcfftStatus FFTPlan::GetMax1DLengthPvt<Stockham>(size_t *longest) const {
   // TODO(Neelakandan)  The caller has already acquired the lock on *this
@@ -4615,14 +4837,15 @@ hcfftStatus FFTPlan::GetKernelGenKeyPvt<Stockham>(
   params.blockCompute = this->blockCompute;
   params.blockComputeType = this->blockComputeType;
   params.fft_twiddleFront = this->twiddleFront;
+  params.fft_hasLoadCallback = !this->loadCallback.empty();
+  params.fft_hasStoreCallback = !this->storeCallback.empty();
   size_t wgs, nt;
-  size_t t_wgs, t_nt;
-  StockhamGenerator::Precision pr = (params.fft_precision == HCFFT_SINGLE) ? StockhamGenerator::P_SINGLE : StockhamGenerator::P_DOUBLE;
+  StockhamGenerator::Precision pr = (params.fft_precision == HCFFT_DOUBLE) ? StockhamGenerator::P_DOUBLE : StockhamGenerator::P_SINGLE;
 
   switch (pr) {
     case StockhamGenerator::P_SINGLE: {
-      StockhamGenerator::KernelCoreSpecs<StockhamGenerator::P_SINGLE> kcs;
-      kcs.GetWGSAndNT(params.fft_N[0], t_wgs, t_nt);
+      StockhamGenerator::KernelWorkSizes<StockhamGenerator::P_SINGLE>(
+          this->envelope.limit_WorkGroupSize, params.fft_N[0], wgs, nt);
 
       if (params.blockCompute) {
         params.blockSIMD =
@@ -4633,8 +4856,8 @@ hcfftStatus FFTPlan::GetKernelGenKeyPvt<Stockham>(
     } break;
 
     case StockhamGenerator::P_DOUBLE: {
-      StockhamGenerator::KernelCoreSpecs<StockhamGenerator::P_DOUBLE> kcs;
-      kcs.GetWGSAndNT(params.fft_N[0], t_wgs, t_nt);
+      StockhamGenerator::KernelWorkSizes<StockhamGenerator::P_DOUBLE>(
+          this->envelope.limit_WorkGroupSize, params.fft_N[0], wgs, nt);
 
       if (params.blockCompute) {
         params.blockSIMD =
@@ -4645,15 +4868,6 @@ hcfftStatus FFTPlan::GetKernelGenKeyPvt<Stockham>(
     } break;
   }
 
-  if ((t_wgs != 0) && (t_nt != 0) &&
-      (this->envelope.limit_WorkGroupSize >= 256)) {
-    wgs = t_wgs;
-    nt = t_nt;
-  } else {
-    DetermineSizes(this->envelope.limit_WorkGroupSize, params.fft_N[0], wgs, nt,
-                   pr);
-  }
-
   assert((nt * params.fft_N[0]) >= wgs);
   assert((nt * params.fft_N[0]) % wgs == 0);
   params.fft_R = (nt * params.fft_N[0]) / wgs;
@@ -4721,6 +4935,58 @@ hcfftStatus FFTPlan::GetWorkSizesPvt<Stockham>(
   return HCFFT_SUCCEEDS;
 }
 
+template <>
+hcfftStatus FFTPlan::GetKernelCostPvt<Stockham>(FFTKernelCost *cost) const {
+  FFTKernelGenKeyParams params;
+  std::vector<size_t> globalWS, localWS;
+  this->GetKernelGenKeyPvt<Stockham>(params);
+  this->GetWorkSizesPvt<Stockham>(globalWS, localWS);
+  size_t count = this->batchSize;
+
+  for (size_t u = 1; u < this->length.size(); u++) {
+    count *= this->length[u];
+  }
+
+  cost->gen = Stockham;
+  cost->name = "fft_fwd";
+  cost->globalSize = globalWS[0];
+  cost->localSize = localWS[0];
+
+  if (params.fft_precision == HCFFT_DOUBLE) {
+    StockhamGenerator::Kernel<StockhamGenerator::P_DOUBLE> kernel(params);
+    cost->radices = kernel.Radices();
+    kernel.Cost(count, &cost->flops, &cost->ldsBytes, &cost->barriers,
+                &cost->registers);
+  } else {
+    StockhamGenerator::Kernel<StockhamGenerator::P_SINGLE> kernel(params);
+    cost->radices = kernel.Radices();
+    kernel.Cost(count, &cost->flops, &cost->ldsBytes, &cost->barriers,
+                &cost->registers);
+  }
+
+  // Hermitian data holds the non-redundant half of each row
+  size_t n = this->length[0];
+  bool inHermitian = (this->ipLayout == HCFFT_HERMITIAN_INTERLEAVED) ||
+                     (this->ipLayout == HCFFT_HERMITIAN_PLANAR);
+  bool outHermitian = (this->opLayout == HCFFT_HERMITIAN_INTERLEAVED) ||
+                      (this->opLayout == HCFFT_HERMITIAN_PLANAR);
+  double inElements = static_cast<double>(count) * (inHermitian ? n / 2 + 1
+                                                                : n);
+  double outElements = static_cast<double>(count) * (outHermitian ? n / 2 + 1
+                                                                  : n);
+  cost->bytesRead = LayoutBytes(this->ipLayout, inElements) +
+                    static_cast<double>(n) * this->ElementSize();
+  cost->bytesWritten = LayoutBytes(this->opLayout, outElements);
+
+  if (params.fft_3StepTwiddle) {
+    cost->bytesRead += static_cast<double>(
+        StockhamGenerator::TwTableLargeSize(this->large1D) *
+        this->ElementSize());
+  }
+
+  return HCFFT_SUCCEEDS;
+}
+
 template <>
 hcfftStatus FFTPlan::GenerateKernelPvt<Stockham>(const hcfftPlanHandle plHandle,
                                                  FFTRepo &fftRepo, size_t count,
@@ -4732,9 +4998,11 @@ hcfftStatus FFTPlan::GenerateKernelPvt<Stockham>(const hcfftPlanHandle plHandle,
     std::vector<size_t> gWorkSize;
     std::vector<size_t> lWorkSize;
     this->GetWorkSizesPvt<Stockham>(gWorkSize, lWorkSize);
-    std::string programCode;
-    programCode = hcHeader();
-    StockhamGenerator::Precision pr = (params.fft_precision == HCFFT_SINGLE) ? StockhamGenerator::P_SINGLE : StockhamGenerator::P_DOUBLE;
+    CodeEmitter programCode;
+    programCode << hcHeader();
+    programCode << StockhamGenerator::CallbackSource(loadCallback,
+                                                     storeCallback, count);
+    StockhamGenerator::Precision pr = (params.fft_precision == HCFFT_DOUBLE) ? StockhamGenerator::P_DOUBLE : StockhamGenerator::P_SINGLE;
 
     switch (pr) {
       case StockhamGenerator::P_SINGLE: {
@@ -4752,7 +5020,7 @@ hcfftStatus FFTPlan::GenerateKernelPvt<Stockham>(const hcfftPlanHandle plHandle,
       } break;
     }
 
-    fftRepo.setProgramCode(Stockham, plHandle, params, programCode);
+    fftRepo.setProgramCode(Stockham, plHandle, params, programCode.str());
     fftRepo.setProgramEntryPoints(Stockham, plHandle, params, "fft_fwd",
                                   "fft_back");
   } else {
@@ -4816,7 +5084,8 @@ hcfftStatus FFTPlan::GenerateKernelPvt<Stockham>(const hcfftPlanHandle plHandle,
       }
     }
 
-    if (params.fft_precision == HCFFT_SINGLE) {
+    // Half precision storage keeps fp32 twiddles
+    if (params.fft_precision != HCFFT_DOUBLE) {
       // Twiddle table
       if (length > 1) {
         StockhamGenerator::TwiddleTable<hc::short_vector::float_2> twTable(length);
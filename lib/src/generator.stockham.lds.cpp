@@ -0,0 +1,580 @@
+/*
+Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "include/stockham.h"
+#include <math.h>
+
+// Single kernel 2D and 3D transforms
+//
+//   A work group loads one whole 2D tile (or 3D cube) into LDS and runs the
+//   Stockham passes of every axis on it, fastest axis first. A pass over axis
+//   'a' sees the tile as a set of lines of length N[a] that are S[a] elements
+//   apart, S[a] being the product of the lengths below 'a', so the column
+//   passes need no transpose. Each pass reads all of its butterfly inputs into
+//   registers before the barrier and writes the results after it, which lets
+//   the passes work in place on a single LDS buffer.
+//
+//   Pass with radix R on a line of length L, Ns being the product of the
+//   radices of the earlier passes on the same axis, for butterfly j < L/R
+//
+//        v[r]  = line[j + r*L/R] * W(k*r, Ns*R)       k = j % Ns
+//        v     = DFT_R(v)
+//        line[(j/Ns)*Ns*R + k + r*Ns] = v[r]
+//
+//   which leaves the result of the last pass in natural order.
+
+// Radices of one axis of a single kernel transform; fails for lengths with a
+// prime factor there is no butterfly for
+bool LdsAxisRadices(size_t length, std::vector<size_t>* radices) {
+  size_t cRad[] = {4, 2, 3, 5, 7, 11, 13};
+  size_t cRadSize = (sizeof(cRad) / sizeof(cRad[0]));
+  radices->clear();
+
+  while (length > 1) {
+    size_t r = 0;
+
+    while ((r < cRadSize) && (length % cRad[r])) {
+      r++;
+    }
+
+    if (r == cRadSize) {
+      return false;
+    }
+
+    radices->push_back(cRad[r]);
+    length /= cRad[r];
+  }
+
+  return true;
+}
+
+namespace StockhamGenerator {
+template <Precision PR>
+class LdsKernel {
+  struct LdsPass {
+    size_t axis;
+    size_t length;   // L
+    size_t stride;   // distance of line elements in the tile
+    size_t ns;       // product of the earlier radices of this axis
+    size_t radix;    // R
+    size_t twStart;  // first twiddle of the pass, Ns * (R - 1) entries
+  };
+
+  const FFTKernelGenKeyParams& params;
+  size_t dim;
+  size_t count;  // elements in the tile
+  size_t workGroupSize;
+  size_t twCount;
+  std::vector<LdsPass> passes;
+
+  static std::string Const(double value) {
+    return FloatToStr(value) + FloatSuffix<PR>();
+  }
+
+  // Offset of tile element 'i' in global memory
+  std::string GlobalOffset(const size_t* stride) const {
+    std::string offset = "(i % " + SztToStr(params.fft_N[0]) + ") * " +
+                         SztToStr(stride[0]);
+
+    if (dim == 2) {
+      offset += " + (i / " + SztToStr(params.fft_N[0]) + ") * " +
+                SztToStr(stride[1]);
+    } else {
+      offset += " + ((i / " + SztToStr(params.fft_N[0]) + ") % " +
+                SztToStr(params.fft_N[1]) + ") * " + SztToStr(stride[1]);
+      offset += " + (i / " + SztToStr(params.fft_N[0] * params.fft_N[1]) +
+                ") * " + SztToStr(stride[2]);
+    }
+
+    return offset;
+  }
+
+  // Append "+ coef * term" with the trivial coefficients folded
+  static void AddTerm(std::string& sum, double coef, const std::string& term) {
+    if (fabs(coef) < 1.0e-15) {
+      return;
+    }
+
+    if (fabs(coef - 1.0) < 1.0e-15) {
+      sum += sum.empty() ? term : " + " + term;
+    } else if (fabs(coef + 1.0) < 1.0e-15) {
+      sum += " - " + term;
+    } else if (sum.empty()) {
+      sum += Const(coef) + " * " + term;
+    } else {
+      sum += (coef < 0.0) ? " - " : " + ";
+      sum += Const(fabs(coef)) + " * " + term;
+    }
+  }
+
+  void GenerateButterflyAddressing(CodeEmitter& str, size_t slot,
+                                   const LdsPass& pass) const {
+    size_t perLine = pass.length / pass.radix;
+    str += "\t\t\tunsigned int b = me + ";
+    str << slot * workGroupSize;
+    str += ";\n";
+    str += "\t\t\tunsigned int j = b % ";
+    str << perLine;
+    str += ";\n";
+    str += "\t\t\tunsigned int base = ((b / ";
+    str << perLine;
+    str += ") % ";
+    str << pass.stride;
+    str += ") + ((b / ";
+    str << perLine;
+    str += ") / ";
+    str << pass.stride;
+    str += ") * ";
+    str << pass.stride * pass.length;
+    str += ";\n";
+  }
+
+  // Twiddle multiplies and radix R DFT of butterfly j of the pass, reading
+  // registers 'v' and writing LDS
+  void GenerateButterfly(CodeEmitter& str, const std::string& v,
+                         const LdsPass& pass, bool fwd) const {
+    std::string r2Type = RegBaseType<PR>(2);
+
+    // Twiddle the inputs, the first pass of an axis has none
+    if (pass.ns > 1) {
+      for (size_t r = 1; r < pass.radix; r++) {
+        std::string reg = v + SztToStr(r);
+        str += "\t\t\t{\n\t\t\t\t" + r2Type + " W = twiddles[";
+        str << pass.twStart + r - 1;
+        str += " + k * ";
+        str << pass.radix - 1;
+        str += "];\n\t\t\t\t";
+        stringpair mul = ComplexMul(r2Type.c_str(), reg.c_str(), "W", fwd);
+        str += reg + " = " + mul.first + mul.second + ";\n\t\t\t}\n";
+      }
+    }
+
+    str += "\t\t\tunsigned int dst = base + ((j / ";
+    str << pass.ns;
+    str += ") * ";
+    str << pass.ns * pass.radix;
+    str += " + k) * ";
+    str << pass.stride;
+    str += ";\n";
+
+    // Radix R DFT straight into LDS
+    const double TWO_PI = 6.283185307179586476925286766559;
+
+    for (size_t q = 0; q < pass.radix; q++) {
+      std::string re, im;
+
+      for (size_t r = 0; r < pass.radix; r++) {
+        double theta = TWO_PI * static_cast<double>((r * q) % pass.radix) /
+                       static_cast<double>(pass.radix);
+        double c = cos(theta);
+        double sn = fwd ? -sin(theta) : sin(theta);
+        std::string reg = v + SztToStr(r);
+        AddTerm(re, c, reg + ".x");
+        AddTerm(re, -sn, reg + ".y");
+        AddTerm(im, sn, reg + ".x");
+        AddTerm(im, c, reg + ".y");
+      }
+
+      str += "\t\t\tlds[dst + ";
+      str << q * pass.ns * pass.stride;
+      str += "] = " + r2Type + "(" + (re.empty() ? Const(0.0) : re) +
+             ", " + (im.empty() ? Const(0.0) : im) + ");\n";
+    }
+  }
+
+  void GeneratePass(CodeEmitter& str, const LdsPass& pass, bool fwd) const {
+    std::string r2Type = RegBaseType<PR>(2);
+    size_t butterflies = count / pass.radix;
+    size_t slots = DivRoundingUp<size_t>(butterflies, workGroupSize);
+    bool guard = (butterflies % workGroupSize) != 0;
+    size_t perLine = pass.length / pass.radix;
+    str += "\n\t\t// Axis ";
+    str << pass.axis;
+    str += ", radix ";
+    str << pass.radix;
+    str += "\n\t\t{\n";
+
+    for (size_t s = 0; s < slots; s++) {
+      str += "\t\t";
+
+      for (size_t r = 0; r < pass.radix; r++) {
+        str += r2Type + " v" + SztToStr(s) + "_" + SztToStr(r) + ";";
+        str += (r + 1 < pass.radix) ? " " : "\n";
+      }
+    }
+
+    // Read every input of the pass before anything is overwritten
+    for (size_t s = 0; s < slots; s++) {
+      bool lastSlot = (s + 1 == slots);
+      str += (guard && lastSlot) ? "\t\tif (me + " +
+                                       SztToStr(s * workGroupSize) + " < " +
+                                       SztToStr(butterflies) + ") {\n"
+                                 : "\t\t{\n";
+      GenerateButterflyAddressing(str, s, pass);
+
+      for (size_t r = 0; r < pass.radix; r++) {
+        str += "\t\t\tv" + SztToStr(s) + "_" + SztToStr(r);
+        str += " = lds[base + (j + " + SztToStr(r * perLine) + ") * " +
+               SztToStr(pass.stride) + "];\n";
+      }
+
+      str += "\t\t}\n";
+    }
+
+    str += "\t\ttidx.barrier.wait_with_tile_static_memory_fence();\n";
+
+    for (size_t s = 0; s < slots; s++) {
+      bool lastSlot = (s + 1 == slots);
+      std::string v = "v" + SztToStr(s) + "_";
+      str += (guard && lastSlot) ? "\t\tif (me + " +
+                                       SztToStr(s * workGroupSize) + " < " +
+                                       SztToStr(butterflies) + ") {\n"
+                                 : "\t\t{\n";
+      GenerateButterflyAddressing(str, s, pass);
+      str += "\t\t\tunsigned int k = j % ";
+      str << pass.ns;
+      str += ";\n";
+
+      GenerateButterfly(str, v, pass, fwd);
+      str += "\t\t}\n";
+    }
+
+    str += "\t\ttidx.barrier.wait_with_tile_static_memory_fence();\n";
+    str += "\t\t}\n";
+  }
+
+ public:
+  explicit LdsKernel(const FFTKernelGenKeyParams& paramsVal)
+      : params(paramsVal), twCount(0) {
+    dim = params.fft_DataDim - 1;
+    count = 1;
+
+    for (size_t a = 0; a < dim; a++) {
+      count *= params.fft_N[a];
+    }
+
+    size_t stride = 1;
+
+    for (size_t a = 0; a < dim; a++) {
+      std::vector<size_t> radices;
+      LdsAxisRadices(params.fft_N[a], &radices);
+      size_t ns = 1;
+
+      for (size_t p = 0; p < radices.size(); p++) {
+        LdsPass pass;
+        pass.axis = a;
+        pass.length = params.fft_N[a];
+        pass.stride = stride;
+        pass.ns = ns;
+        pass.radix = radices[p];
+        pass.twStart = twCount;
+
+        if (ns > 1) {
+          twCount += ns * (radices[p] - 1);
+        }
+
+        passes.push_back(pass);
+        ns *= radices[p];
+      }
+
+      stride *= params.fft_N[a];
+    }
+
+    workGroupSize = params.fft_SIMD;
+  }
+
+  size_t TwiddleCount() const { return twCount; }
+
+  // Static cost of 'batch' transforms: the tile is loaded into LDS, every pass
+  // reads and writes it and the last one is stored from there
+  void Cost(size_t batch, std::vector<size_t>* radices, double* flops,
+            double* ldsBytes, size_t* barriers, size_t* registers) const {
+    double elementBytes = 2.0 * PrecisionWidth<PR>() * sizeof(float);
+    double tileFlops = 0;
+    size_t maxRegs = 0;
+    radices->clear();
+
+    for (size_t p = 0; p < passes.size(); p++) {
+      const LdsPass& pass = passes[p];
+      CodeEmitter bfly;
+      GenerateButterfly(bfly, "v0_", pass, true);
+      tileFlops +=
+          static_cast<double>(count / pass.radix) * CountFlops(bfly.str());
+      radices->push_back(pass.radix);
+      size_t slots = DivRoundingUp<size_t>(count / pass.radix, workGroupSize);
+      maxRegs = std::max(maxRegs, slots * pass.radix);
+    }
+
+    *flops = tileFlops * batch;
+    *ldsBytes = 2.0 * (passes.size() + 1) * count * elementBytes * batch;
+    *barriers = 1 + 2 * passes.size();
+    *registers = 2 * PrecisionWidth<PR>() * maxRegs + 16;
+  }
+
+  // Twiddles of all passes back to back, computed in double precision
+  template <class T>
+  void GenerateTwiddleTable(void** twiddles, hc::accelerator acc) const {
+    if (twCount == 0) {
+      return;
+    }
+
+    FFTBakeTimer timer(BAKE_TWIDDLES);
+    const double TWO_PI = -6.283185307179586476925286766559;
+    std::vector<T> wc(twCount);
+
+    for (size_t p = 0; p < passes.size(); p++) {
+      const LdsPass& pass = passes[p];
+
+      if (pass.ns == 1) {
+        continue;
+      }
+
+      for (size_t k = 0; k < pass.ns; k++) {
+        for (size_t r = 1; r < pass.radix; r++) {
+          double theta = (TWO_PI * static_cast<double>(k * r)) /
+                         static_cast<double>(pass.ns * pass.radix);
+          T& w = wc[pass.twStart + k * (pass.radix - 1) + r - 1];
+          w.x = cos(theta);
+          w.y = sin(theta);
+        }
+      }
+    }
+
+    *twiddles =
+        (T*)hc::am_alloc(twCount * sizeof(T), acc, KernelAllocFlags());
+    assert(*twiddles != NULL);
+    hc::accelerator_view accl_view = acc.get_default_view();
+    accl_view.copy(&wc[0], *twiddles, twCount * sizeof(T));
+    FFTMetrics::Add(METRIC_TWIDDLE_BYTES, twCount * sizeof(T));
+  }
+
+  void GenerateKernel(CodeEmitter& str, const std::vector<size_t>& gWorkSize,
+                      const std::vector<size_t>& lWorkSize,
+                      size_t kernelCount) const {
+    std::string r2Type = RegBaseType<PR>(2);
+    bool inplace = (params.fft_placeness == HCFFT_INPLACE);
+
+    for (size_t d = 0; d < 2; d++) {
+      bool fwd = (d == 0);
+      double scale = fwd ? params.fft_fwdScale : params.fft_backScale;
+      int arg = 0;
+      str += "extern \"C\" {";
+      str += "\nvoid ";
+      str += fwd ? "fft_fwd" : "fft_back";
+      str << kernelCount;
+      str +=
+          "( std::map<int, void*> vectArr, uint batchSize, accelerator_view "
+          "&acc_view, accelerator &acc )\n\t{\n\t";
+      str += r2Type + " *gbIn = static_cast<" + r2Type + "*> (vectArr[" +
+             SztToStr(arg++) + "]);\n\t";
+
+      if (inplace) {
+        str += r2Type + " *gbOut = gbIn;\n\t";
+      } else {
+        str += r2Type + " *gbOut = static_cast<" + r2Type + "*> (vectArr[" +
+               SztToStr(arg++) + "]);\n\t";
+      }
+
+      if (twCount > 0) {
+        str += r2Type + " *twiddles = static_cast<" + r2Type +
+               "*> (vectArr[" + SztToStr(arg++) + "]);\n\t";
+      }
+
+      str += "hc::extent<2> grdExt( ";
+      str << gWorkSize[0];
+      str += ", 1 ); \n";
+      str += "\thc::tiled_extent<2> t_ext = grdExt.tile(";
+      str << lWorkSize[0];
+      str += ",1);\n";
+      str +=
+          "\thc::parallel_for_each(acc_view, t_ext, [=] (hc::tiled_index<2> "
+          "tidx) [[hc]]\n\t {\n";
+      str += "\t\tunsigned int me = tidx.local[0];\n";
+      str += "\t\tunsigned long batch = tidx.tile[0];\n";
+      str += "\t\ttile_static " + r2Type + " lds[" + SztToStr(count) + "];\n";
+      // Load the tile
+      str += "\t\tfor (unsigned int i = me; i < ";
+      str << count;
+      str += "; i += ";
+      str << workGroupSize;
+      str += ") {\n\t\t\tlds[i] = gbIn[batch * ";
+      str << params.fft_inStride[dim];
+      str += " + " + GlobalOffset(params.fft_inStride) + "];\n\t\t}\n";
+      str += "\t\ttidx.barrier.wait_with_tile_static_memory_fence();\n";
+
+      for (size_t p = 0; p < passes.size(); p++) {
+        GeneratePass(str, passes[p], fwd);
+      }
+
+      // Store the tile
+      str += "\n\t\tfor (unsigned int i = me; i < ";
+      str << count;
+      str += "; i += ";
+      str << workGroupSize;
+      str += ") {\n\t\t\tgbOut[batch * ";
+      str << params.fft_outStride[dim];
+      str += " + " + GlobalOffset(params.fft_outStride) + "] = ";
+
+      if (scale != 1.0) {
+        str += r2Type + "(lds[i].x * " + Const(scale) + ", lds[i].y * " +
+               Const(scale) + ");\n\t\t}\n";
+      } else {
+        str += "lds[i];\n\t\t}\n";
+      }
+
+      str += "\t }).wait();\n}}\n\n";
+    }
+  }
+};
+};  // namespace StockhamGenerator
+
+template <>
+hcfftStatus FFTPlan::GetKernelGenKeyPvt<Stockham_LDS>(
+    FFTKernelGenKeyParams& params) const {
+  ::memset(static_cast<void*>(&params), 0, sizeof(params));
+  params.fft_precision = this->precision;
+  params.fft_placeness = this->location;
+  params.fft_inputLayout = this->ipLayout;
+  params.fft_outputLayout = this->opLayout;
+  params.fft_MaxWorkGroupSize = this->envelope.limit_WorkGroupSize;
+  params.fft_DataDim = this->length.size() + 1;
+  size_t count = 1;
+  size_t minRadix = 0;
+  size_t i = 0;
+
+  for (i = 0; i < (params.fft_DataDim - 1); i++) {
+    params.fft_N[i] = this->length[i];
+    params.fft_inStride[i] = this->inStride[i];
+    params.fft_outStride[i] = this->outStride[i];
+    count *= this->length[i];
+    std::vector<size_t> radices;
+    ARG_CHECK(LdsAxisRadices(this->length[i], &radices))
+
+    for (size_t p = 0; p < radices.size(); p++) {
+      if ((minRadix == 0) || (radices[p] < minRadix)) {
+        minRadix = radices[p];
+      }
+    }
+  }
+
+  params.fft_inStride[i] = this->iDist;
+  params.fft_outStride[i] = this->oDist;
+  params.fft_fwdScale = this->forwardScale;
+  params.fft_backScale = this->backwardScale;
+  // Enough work items for the widest pass, in whole wavefronts
+  size_t butterflies = (minRadix == 0) ? 1 : count / minRadix;
+  size_t wgs = DivRoundingUp<size_t>(butterflies, 64) * 64;
+  params.fft_SIMD = std::min<size_t>(wgs, params.fft_MaxWorkGroupSize);
+  params.fft_R = 1;
+  return HCFFT_SUCCEEDS;
+}
+
+template <>
+hcfftStatus FFTPlan::GetWorkSizesPvt<Stockham_LDS>(
+    std::vector<size_t>& globalWS, std::vector<size_t>& localWS) const {
+  FFTKernelGenKeyParams fftParams;
+  this->GetKernelGenKeyPvt<Stockham_LDS>(fftParams);
+  // One work group per transform
+  size_t batch = std::max<size_t>(1, this->batchSize);
+  globalWS.push_back(batch * fftParams.fft_SIMD);
+  localWS.push_back(fftParams.fft_SIMD);
+  return HCFFT_SUCCEEDS;
+}
+
+template <>
+hcfftStatus FFTPlan::GetKernelCostPvt<Stockham_LDS>(
+    FFTKernelCost* cost) const {
+  FFTKernelGenKeyParams params;
+  std::vector<size_t> globalWS, localWS;
+  this->GetKernelGenKeyPvt<Stockham_LDS>(params);
+  this->GetWorkSizesPvt<Stockham_LDS>(globalWS, localWS);
+  size_t batch = std::max<size_t>(1, this->batchSize);
+  size_t twiddles = 0;
+  cost->gen = Stockham_LDS;
+  cost->name = "fft_fwd";
+  cost->globalSize = globalWS[0];
+  cost->localSize = localWS[0];
+
+  if (params.fft_precision == HCFFT_DOUBLE) {
+    StockhamGenerator::LdsKernel<StockhamGenerator::P_DOUBLE> kernel(params);
+    kernel.Cost(batch, &cost->radices, &cost->flops, &cost->ldsBytes,
+                &cost->barriers, &cost->registers);
+    twiddles = kernel.TwiddleCount();
+  } else {
+    StockhamGenerator::LdsKernel<StockhamGenerator::P_SINGLE> kernel(params);
+    kernel.Cost(batch, &cost->radices, &cost->flops, &cost->ldsBytes,
+                &cost->barriers, &cost->registers);
+    twiddles = kernel.TwiddleCount();
+  }
+
+  double elements = static_cast<double>(batch);
+
+  for (size_t u = 0; u < this->length.size(); u++) {
+    elements *= this->length[u];
+  }
+
+  cost->bytesRead = LayoutBytes(this->ipLayout, elements) +
+                    static_cast<double>(twiddles) * this->ElementSize();
+  cost->bytesWritten = LayoutBytes(this->opLayout, elements);
+  return HCFFT_SUCCEEDS;
+}
+
+template <>
+hcfftStatus FFTPlan::GenerateKernelPvt<Stockham_LDS>(
+    const hcfftPlanHandle plHandle, FFTRepo& fftRepo, size_t count,
+    bool exist) const {
+  FFTKernelGenKeyParams params;
+  this->GetKernelGenKeyPvt<Stockham_LDS>(params);
+  std::vector<size_t> gWorkSize;
+  std::vector<size_t> lWorkSize;
+  this->GetWorkSizesPvt<Stockham_LDS>(gWorkSize, lWorkSize);
+  CodeEmitter programCode;
+  programCode << hcHeader();
+
+  // The twiddle table is needed whether or not the kernels are cached
+  if (params.fft_precision == HCFFT_DOUBLE) {
+    StockhamGenerator::LdsKernel<StockhamGenerator::P_DOUBLE> kernel(params);
+    kernel.GenerateTwiddleTable<hc::short_vector::double_2>(
+        (void**)&twiddles, acc);
+
+    if (!exist) {
+      kernel.GenerateKernel(programCode, gWorkSize, lWorkSize, count);
+    }
+  } else {
+    StockhamGenerator::LdsKernel<StockhamGenerator::P_SINGLE> kernel(params);
+    kernel.GenerateTwiddleTable<hc::short_vector::float_2>(
+        (void**)&twiddles, acc);
+
+    if (!exist) {
+      kernel.GenerateKernel(programCode, gWorkSize, lWorkSize, count);
+    }
+  }
+
+  if (!exist) {
+    fftRepo.setProgramCode(Stockham_LDS, plHandle, params,
+                            programCode.str());
+    fftRepo.setProgramEntryPoints(Stockham_LDS, plHandle, params, "fft_fwd",
+                                  "fft_back");
+  }
+
+  return HCFFT_SUCCEEDS;
+}
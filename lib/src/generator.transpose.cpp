@@ -27,60 +27,57 @@ THE SOFTWARE.
 namespace hcfft_transpose_generator {
 // generating string for calculating offset within sqaure transpose kernels
 // (genTransposeKernelBatched)
-void OffsetCalculation(std::stringstream& transKernel,
+void OffsetCalculation(CodeEmitter& transKernel,
                        const FFTKernelGenKeyParams& params, bool input) {
   const size_t* stride = input ? params.fft_inStride : params.fft_outStride;
   std::string offset = input ? "iOffset" : "oOffset";
 
-  StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t " << offset << " = 0;" << std::endl;
-  StockhamGenerator::hcKernWrite(transKernel, 3) << "g_index = tidx.tile[0];" << std::endl;
+  StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t " << offset << " = 0;\n";
+  StockhamGenerator::hcKernWrite(transKernel, 3) << "g_index = tidx.tile[0];\n";
 
   for (size_t i = params.fft_DataDim - 2; i > 0; i--) {
     StockhamGenerator::hcKernWrite(transKernel, 3) << offset << " += (g_index/numGroupsY_" << i
-                                << ")*" << stride[i + 1] << ";" << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "g_index = g_index % numGroupsY_" << i << ";"
-                                << std::endl;
+                                << ")*" << stride[i + 1] << ";\n";
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "g_index = g_index % numGroupsY_" << i << ";\n";
   }
 
-  StockhamGenerator::hcKernWrite(transKernel, 3) << std::endl;
+  StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
 }
 
 // generating string for calculating offset within sqaure transpose kernels
 // (genTransposeKernelLeadingDimensionBatched)
-void OffsetCalcLeadingDimensionBatched(std::stringstream& transKernel,
+void OffsetCalcLeadingDimensionBatched(CodeEmitter& transKernel,
                                        const FFTKernelGenKeyParams& params) {
   const size_t* stride = params.fft_inStride;
   std::string offset = "iOffset";
 
-  StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t " << offset << " = 0;" << std::endl;
-  StockhamGenerator::hcKernWrite(transKernel, 3) << "g_index = tidx.tile[0];" << std::endl;
+  StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t " << offset << " = 0;\n";
+  StockhamGenerator::hcKernWrite(transKernel, 3) << "g_index = tidx.tile[0];\n";
 
   for (size_t i = params.fft_DataDim - 2; i > 0; i--) {
     StockhamGenerator::hcKernWrite(transKernel, 3) << offset << " += (g_index/numGroupsY_" << i
-                                << ")*" << stride[i + 1] << ";" << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "g_index = g_index % numGroupsY_" << i << ";"
-                                << std::endl;
+                                << ")*" << stride[i + 1] << ";\n";
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "g_index = g_index % numGroupsY_" << i << ";\n";
   }
 
-  StockhamGenerator::hcKernWrite(transKernel, 3) << std::endl;
+  StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
 }
 
 // generating string for calculating offset within swap kernels (genSwapKernel)
-void Swap_OffsetCalc(std::stringstream& transKernel,
+void Swap_OffsetCalc(CodeEmitter& transKernel,
                      const FFTKernelGenKeyParams& params) {
   const size_t* stride = params.fft_inStride;
   std::string offset = "iOffset";
 
-  StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t " << offset << " = 0;" << std::endl;
+  StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t " << offset << " = 0;\n";
 
   for (size_t i = params.fft_DataDim - 2; i > 0; i--) {
     StockhamGenerator::hcKernWrite(transKernel, 3) << offset << " += (g_index/numGroupsY_" << i
-                                << ")*" << stride[i + 1] << ";" << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "g_index = g_index % numGroupsY_" << i << ";"
-                                << std::endl;
+                                << ")*" << stride[i + 1] << ";\n";
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "g_index = g_index % numGroupsY_" << i << ";\n";
   }
 
-  StockhamGenerator::hcKernWrite(transKernel, 3) << std::endl;
+  StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
 }
 
 // Small snippet of code that multiplies the twiddle factors into the
@@ -89,51 +86,51 @@ void Swap_OffsetCalc(std::stringstream& transKernel,
 // transpose
 hcfftStatus genTwiddleMath(const hcfftPlanHandle plHandle,
                            const FFTKernelGenKeyParams& params,
-                           std::stringstream& transKernel,
+                           CodeEmitter& transKernel,
                            const std::string& dtComplex, bool fwd) {
-  StockhamGenerator::hcKernWrite(transKernel, 9) << std::endl;
+  StockhamGenerator::hcKernWrite(transKernel, 9) << "\n";
 
   StockhamGenerator::hcKernWrite(transKernel, 9)
       << dtComplex << " Wm = TW3step" << plHandle
-      << "( (t_gx_p*32 + lidx) * (t_gy_p*32 + lidy + loop*8)" << std::endl;
+      << "( (t_gx_p*32 + lidx) * (t_gy_p*32 + lidy + loop*8)\n";
   StockhamGenerator::hcKernWrite(transKernel, 9) << ", ";
-  StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << std::endl;
-  StockhamGenerator::hcKernWrite(transKernel, 9) << ");" << std::endl;
+  StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << "\n";
+  StockhamGenerator::hcKernWrite(transKernel, 9) << ");\n";
   StockhamGenerator::hcKernWrite(transKernel, 9)
       << dtComplex << " Wt = TW3step" << plHandle
-      << "( (t_gy_p*32 + lidx) * (t_gx_p*32 + lidy + loop*8)" << std::endl;
+      << "( (t_gy_p*32 + lidx) * (t_gx_p*32 + lidy + loop*8)\n";
   StockhamGenerator::hcKernWrite(transKernel, 9) << ", ";
-  StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << std::endl;
-  StockhamGenerator::hcKernWrite(transKernel, 9) << ");" << std::endl;
+  StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << "\n";
+  StockhamGenerator::hcKernWrite(transKernel, 9) << ");\n";
 
-  StockhamGenerator::hcKernWrite(transKernel, 9) << dtComplex << " Tm, Tt;" << std::endl;
+  StockhamGenerator::hcKernWrite(transKernel, 9) << dtComplex << " Tm, Tt;\n";
 
   if (fwd) {
     StockhamGenerator::hcKernWrite(transKernel, 9)
-        << "Tm.x = ( Wm.x * tmpm.x ) - ( Wm.y * tmpm.y );" << std::endl;
+        << "Tm.x = ( Wm.x * tmpm.x ) - ( Wm.y * tmpm.y );\n";
     StockhamGenerator::hcKernWrite(transKernel, 9)
-        << "Tm.y = ( Wm.y * tmpm.x ) + ( Wm.x * tmpm.y );" << std::endl;
+        << "Tm.y = ( Wm.y * tmpm.x ) + ( Wm.x * tmpm.y );\n";
     StockhamGenerator::hcKernWrite(transKernel, 9)
-        << "Tt.x = ( Wt.x * tmpt.x ) - ( Wt.y * tmpt.y );" << std::endl;
+        << "Tt.x = ( Wt.x * tmpt.x ) - ( Wt.y * tmpt.y );\n";
     StockhamGenerator::hcKernWrite(transKernel, 9)
-        << "Tt.y = ( Wt.y * tmpt.x ) + ( Wt.x * tmpt.y );" << std::endl;
+        << "Tt.y = ( Wt.y * tmpt.x ) + ( Wt.x * tmpt.y );\n";
   } else {
     StockhamGenerator::hcKernWrite(transKernel, 9)
-        << "Tm.x =  ( Wm.x * tmpm.x ) + ( Wm.y * tmpm.y );" << std::endl;
+        << "Tm.x =  ( Wm.x * tmpm.x ) + ( Wm.y * tmpm.y );\n";
     StockhamGenerator::hcKernWrite(transKernel, 9)
-        << "Tm.y = -( Wm.y * tmpm.x ) + ( Wm.x * tmpm.y );" << std::endl;
+        << "Tm.y = -( Wm.y * tmpm.x ) + ( Wm.x * tmpm.y );\n";
     StockhamGenerator::hcKernWrite(transKernel, 9)
-        << "Tt.x =  ( Wt.x * tmpt.x ) + ( Wt.y * tmpt.y );" << std::endl;
+        << "Tt.x =  ( Wt.x * tmpt.x ) + ( Wt.y * tmpt.y );\n";
     StockhamGenerator::hcKernWrite(transKernel, 9)
-        << "Tt.y = -( Wt.y * tmpt.x ) + ( Wt.x * tmpt.y );" << std::endl;
+        << "Tt.y = -( Wt.y * tmpt.x ) + ( Wt.x * tmpt.y );\n";
   }
 
-  StockhamGenerator::hcKernWrite(transKernel, 9) << "tmpm.x = Tm.x;" << std::endl;
-  StockhamGenerator::hcKernWrite(transKernel, 9) << "tmpm.y = Tm.y;" << std::endl;
-  StockhamGenerator::hcKernWrite(transKernel, 9) << "tmpt.x = Tt.x;" << std::endl;
-  StockhamGenerator::hcKernWrite(transKernel, 9) << "tmpt.y = Tt.y;" << std::endl;
+  StockhamGenerator::hcKernWrite(transKernel, 9) << "tmpm.x = Tm.x;\n";
+  StockhamGenerator::hcKernWrite(transKernel, 9) << "tmpm.y = Tm.y;\n";
+  StockhamGenerator::hcKernWrite(transKernel, 9) << "tmpt.x = Tt.x;\n";
+  StockhamGenerator::hcKernWrite(transKernel, 9) << "tmpt.y = Tt.y;\n";
 
-  StockhamGenerator::hcKernWrite(transKernel, 9) << std::endl;
+  StockhamGenerator::hcKernWrite(transKernel, 9) << "\n";
 
   return HCFFT_SUCCEEDS;
 }
@@ -144,70 +141,68 @@ hcfftStatus genTwiddleMath(const hcfftPlanHandle plHandle,
 // transpose
 hcfftStatus genTwiddleMathLeadingDimensionBatched(
     const hcfftPlanHandle plHandle, const FFTKernelGenKeyParams& params,
-    std::stringstream& transKernel, const std::string& dtComplex, bool fwd) {
+    CodeEmitter& transKernel, const std::string& dtComplex, bool fwd) {
 
-  StockhamGenerator::hcKernWrite(transKernel, 9) << std::endl;
+  StockhamGenerator::hcKernWrite(transKernel, 9) << "\n";
   if (params.fft_N[0] > params.fft_N[1]) {
     StockhamGenerator::hcKernWrite(transKernel, 9) << dtComplex << " Wm = TW3step" << plHandle
                                 << " ( (" << params.fft_N[1]
                                 << " * square_matrix_index + t_gx_p*32 + lidx) "
-                                   "* (t_gy_p*32 + lidy + loop*8) "
-                                << std::endl;
+                                   "* (t_gy_p*32 + lidy + loop*8) \n";
     StockhamGenerator::hcKernWrite(transKernel, 9) << ", ";
-    StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 9) << ");" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << "\n";
+    StockhamGenerator::hcKernWrite(transKernel, 9) << ");\n";
     StockhamGenerator::hcKernWrite(transKernel, 9) << dtComplex << " Wt = TW3step" << plHandle
                                 << " ( (" << params.fft_N[1]
                                 << " * square_matrix_index + t_gy_p*32 + lidx) "
-                                   "* (t_gx_p*32 + lidy + loop*8) "
-                                << std::endl;
+                                   "* (t_gx_p*32 + lidy + loop*8) \n";
     StockhamGenerator::hcKernWrite(transKernel, 9) << ", ";
-    StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 9) << ");" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << "\n";
+    StockhamGenerator::hcKernWrite(transKernel, 9) << ");\n";
   } else {
     StockhamGenerator::hcKernWrite(transKernel, 9)
         << dtComplex << " Wm = TW3step" << plHandle
         << " ( (t_gx_p*32 + lidx) * (" << params.fft_N[0]
-        << " * square_matrix_index + t_gy_p*32 + lidy + loop*8) " << std::endl;
+        << " * square_matrix_index + t_gy_p*32 + lidy + loop*8) \n";
     StockhamGenerator::hcKernWrite(transKernel, 9) << ", ";
-    StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 9) << ");" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << "\n";
+    StockhamGenerator::hcKernWrite(transKernel, 9) << ");\n";
     StockhamGenerator::hcKernWrite(transKernel, 9)
         << dtComplex << " Wt = TW3step" << plHandle
         << " ( (t_gy_p*32 + lidx) * (" << params.fft_N[0]
-        << " * square_matrix_index + t_gx_p*32 + lidy + loop*8) " << std::endl;
+        << " * square_matrix_index + t_gx_p*32 + lidy + loop*8) \n";
     StockhamGenerator::hcKernWrite(transKernel, 9) << ", ";
-    StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 9) << ");" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << "\n";
+    StockhamGenerator::hcKernWrite(transKernel, 9) << ");\n";
   }
-  StockhamGenerator::hcKernWrite(transKernel, 9) << dtComplex << " Tm, Tt;" << std::endl;
+  StockhamGenerator::hcKernWrite(transKernel, 9) << dtComplex << " Tm, Tt;\n";
 
   if (fwd) {
     StockhamGenerator::hcKernWrite(transKernel, 9)
-        << "Tm.x = ( Wm.x * tmpm.x ) - ( Wm.y * tmpm.y );" << std::endl;
+        << "Tm.x = ( Wm.x * tmpm.x ) - ( Wm.y * tmpm.y );\n";
     StockhamGenerator::hcKernWrite(transKernel, 9)
-        << "Tm.y = ( Wm.y * tmpm.x ) + ( Wm.x * tmpm.y );" << std::endl;
+        << "Tm.y = ( Wm.y * tmpm.x ) + ( Wm.x * tmpm.y );\n";
     StockhamGenerator::hcKernWrite(transKernel, 9)
-        << "Tt.x = ( Wt.x * tmpt.x ) - ( Wt.y * tmpt.y );" << std::endl;
+        << "Tt.x = ( Wt.x * tmpt.x ) - ( Wt.y * tmpt.y );\n";
     StockhamGenerator::hcKernWrite(transKernel, 9)
-        << "Tt.y = ( Wt.y * tmpt.x ) + ( Wt.x * tmpt.y );" << std::endl;
+        << "Tt.y = ( Wt.y * tmpt.x ) + ( Wt.x * tmpt.y );\n";
   } else {
     StockhamGenerator::hcKernWrite(transKernel, 9)
-        << "Tm.x =  ( Wm.x * tmpm.x ) + ( Wm.y * tmpm.y );" << std::endl;
+        << "Tm.x =  ( Wm.x * tmpm.x ) + ( Wm.y * tmpm.y );\n";
     StockhamGenerator::hcKernWrite(transKernel, 9)
-        << "Tm.y = -( Wm.y * tmpm.x ) + ( Wm.x * tmpm.y );" << std::endl;
+        << "Tm.y = -( Wm.y * tmpm.x ) + ( Wm.x * tmpm.y );\n";
     StockhamGenerator::hcKernWrite(transKernel, 9)
-        << "Tt.x =  ( Wt.x * tmpt.x ) + ( Wt.y * tmpt.y );" << std::endl;
+        << "Tt.x =  ( Wt.x * tmpt.x ) + ( Wt.y * tmpt.y );\n";
     StockhamGenerator::hcKernWrite(transKernel, 9)
-        << "Tt.y = -( Wt.y * tmpt.x ) + ( Wt.x * tmpt.y );" << std::endl;
+        << "Tt.y = -( Wt.y * tmpt.x ) + ( Wt.x * tmpt.y );\n";
   }
 
-  StockhamGenerator::hcKernWrite(transKernel, 9) << "tmpm.x = Tm.x;" << std::endl;
-  StockhamGenerator::hcKernWrite(transKernel, 9) << "tmpm.y = Tm.y;" << std::endl;
-  StockhamGenerator::hcKernWrite(transKernel, 9) << "tmpt.x = Tt.x;" << std::endl;
-  StockhamGenerator::hcKernWrite(transKernel, 9) << "tmpt.y = Tt.y;" << std::endl;
+  StockhamGenerator::hcKernWrite(transKernel, 9) << "tmpm.x = Tm.x;\n";
+  StockhamGenerator::hcKernWrite(transKernel, 9) << "tmpm.y = Tm.y;\n";
+  StockhamGenerator::hcKernWrite(transKernel, 9) << "tmpt.x = Tt.x;\n";
+  StockhamGenerator::hcKernWrite(transKernel, 9) << "tmpt.y = Tt.y;\n";
 
-  StockhamGenerator::hcKernWrite(transKernel, 9) << std::endl;
+  StockhamGenerator::hcKernWrite(transKernel, 9) << "\n";
 
   return HCFFT_SUCCEEDS;
 }
@@ -215,11 +210,11 @@ hcfftStatus genTwiddleMathLeadingDimensionBatched(
 hcfftStatus genTransposePrototype(
     const FFTKernelGenKeyParams& params, const size_t& lwSize,
     const std::string& dtPlanar, const std::string& dtComplex,
-    const std::string& funcName, std::stringstream& transKernel,
+    const std::string& funcName, CodeEmitter& transKernel,
     std::string& dtInput, std::string& dtOutput, bool twiddleTransposeKernel) {
   uint arg = 0;
   // Declare and define the function
-  StockhamGenerator::hcKernWrite(transKernel, 0) << "extern \"C\"\n { void" << std::endl;
+  StockhamGenerator::hcKernWrite(transKernel, 0) << "extern \"C\"\n { void\n";
   StockhamGenerator::hcKernWrite(transKernel, 0)
       << funcName << "(  std::map<int, void*> vectArr, uint batchSize, "
                      "accelerator_view &acc_view, accelerator &acc) \n {";
@@ -301,12 +296,12 @@ hcfftStatus genTransposePrototype(
 hcfftStatus genTransposePrototypeLeadingDimensionBatched(
     const FFTKernelGenKeyParams& params, const size_t& lwSize,
     const std::string& dtPlanar, const std::string& dtComplex,
-    const std::string& funcName, std::stringstream& transKernel,
+    const std::string& funcName, CodeEmitter& transKernel,
     std::string& dtInput, std::string& dtOutput, bool genTwiddle) {
 
   uint arg = 0;
   // Declare and define the function
-  StockhamGenerator::hcKernWrite(transKernel, 0) << "extern \"C\"\n { void" << std::endl;
+  StockhamGenerator::hcKernWrite(transKernel, 0) << "extern \"C\"\n { void\n";
   StockhamGenerator::hcKernWrite(transKernel, 0)
       << funcName << "(  std::map<int, void*> vectArr, uint batchSize, "
                      "accelerator_view &acc_view, accelerator &acc) \n {";
@@ -451,7 +446,7 @@ hcfftStatus genSwapKernel(const FFTKernelGenKeyParams& params,
                           std::vector<size_t> gWorkSize,
                           std::vector<size_t> lWorkSize, size_t count) {
   strKernel.reserve(4096);
-  std::stringstream transKernel(std::stringstream::out);
+  CodeEmitter transKernel;
 
   // These strings represent the various data types we read or write in the
   // kernel, depending on how the plan
@@ -543,7 +538,7 @@ hcfftStatus genSwapKernel(const FFTKernelGenKeyParams& params,
 
     std::string funcName;
 
-    StockhamGenerator::hcKernWrite(transKernel, 0) << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 0) << "\n";
 
     size_t* cycle_map = new size_t[num_reduced_row * num_reduced_col * 2];
     /* The memory required by cycle_map cannot exceed 2 times row*col by
@@ -552,16 +547,15 @@ hcfftStatus genSwapKernel(const FFTKernelGenKeyParams& params,
     get_cycles(cycle_map, num_reduced_row, num_reduced_col);
 
     size_t *cycle_stat = new size_t[cycle_map[0] * 2], stat_idx = 0;
-    StockhamGenerator::hcKernWrite(transKernel, 0) << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 0) << "\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 0) << "size_t swap_table[][3] = {" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 0) << "size_t swap_table[][3] = {\n";
 
     size_t inx = 0, start_inx, swap_inx = 0, num_swaps = 0;
     for (size_t i = 0; i < cycle_map[0]; i++) {
       start_inx = cycle_map[++inx];
       StockhamGenerator::hcKernWrite(transKernel, 0) << "{  " << start_inx << ",  "
-                                  << cycle_map[inx + 1] << ",  0},"
-                                  << std::endl;
+                                  << cycle_map[inx + 1] << ",  0},\n";
       cycle_stat[stat_idx++] = num_swaps;
       num_swaps++;
 
@@ -569,34 +563,34 @@ hcfftStatus genSwapKernel(const FFTKernelGenKeyParams& params,
         size_t action_var = (cycle_map[inx + 1] == start_inx) ? 2 : 1;
         StockhamGenerator::hcKernWrite(transKernel, 0) << "{  " << cycle_map[inx] << ",  "
                                     << cycle_map[inx + 1] << ",  " << action_var
-                                    << "}," << std::endl;
+                                    << "},\n";
         if (action_var == 2) cycle_stat[stat_idx++] = num_swaps;
         num_swaps++;
       }
     }
     /*Appending swap table for touching corner elements for post call back*/
     size_t last_datablk_idx = num_reduced_row * num_reduced_col - 1;
-    StockhamGenerator::hcKernWrite(transKernel, 0) << "{  0,  0,  0}," << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 0) << "{  0,  0,  0},\n";
     StockhamGenerator::hcKernWrite(transKernel, 0) << "{  " << last_datablk_idx << ",  "
-                                << last_datablk_idx << ",  0}," << std::endl;
+                                << last_datablk_idx << ",  0},\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 0) << "};" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 0) << "};\n";
     /*cycle_map[0] + 2, + 2 is added for post callback table appending*/
     size_t num_cycles_minus_1 = cycle_map[0] - 1;
 
     StockhamGenerator::hcKernWrite(transKernel, 0) << "size_t cycle_stat[" << cycle_map[0]
-                                << "][2] = {" << std::endl;
+                                << "][2] = {\n";
     for (size_t i = 0; i < num_cycles_minus_1; i++) {
       StockhamGenerator::hcKernWrite(transKernel, 0) << "{  " << cycle_stat[i * 2] << ",  "
-                                  << cycle_stat[i * 2 + 1] << "}," << std::endl;
+                                  << cycle_stat[i * 2 + 1] << "},\n";
     }
     StockhamGenerator::hcKernWrite(transKernel, 0)
         << "{  " << cycle_stat[num_cycles_minus_1 * 2] << ",  "
-        << (cycle_stat[num_cycles_minus_1 * 2 + 1] + 2) << "}," << std::endl;
+        << (cycle_stat[num_cycles_minus_1 * 2 + 1] + 2) << "},\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 0) << "};" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 0) << "};\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 0) << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 0) << "\n";
 
     switch (params.fft_inputLayout) {
       case HCFFT_COMPLEX_INTERLEAVED:
@@ -628,75 +622,75 @@ hcfftStatus genSwapKernel(const FFTKernelGenKeyParams& params,
         return HCFFT_INVALID;
     }
 
-    StockhamGenerator::hcKernWrite(transKernel, 0) << "){" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 0) << "){\n";
 
     StockhamGenerator::hcKernWrite(transKernel, 3)
         << "for (size_t j = tidx.local[0]; j < end_indx; j += "
-        << local_work_size_swap << "){" << std::endl;
+        << local_work_size_swap << "){\n";
 
     switch (params.fft_inputLayout) {
       case HCFFT_REAL:
       case HCFFT_COMPLEX_INTERLEAVED:
-        StockhamGenerator::hcKernWrite(transKernel, 6) << "if (pos == 0){" << std::endl;
+        StockhamGenerator::hcKernWrite(transKernel, 6) << "if (pos == 0){\n";
         StockhamGenerator::hcKernWrite(transKernel, 9)
             << "Ls[j] = inputA[inOffset + is *" << smaller_dim << " + "
-            << num_elements_loaded << " * work_id + j];" << std::endl;
+            << num_elements_loaded << " * work_id + j];\n";
         StockhamGenerator::hcKernWrite(transKernel, 9)
             << "Ld[j] = inputA[inOffset + id *" << smaller_dim << " + "
-            << num_elements_loaded << " * work_id + j];" << std::endl;
-        StockhamGenerator::hcKernWrite(transKernel, 6) << "}" << std::endl;
+            << num_elements_loaded << " * work_id + j];\n";
+        StockhamGenerator::hcKernWrite(transKernel, 6) << "}\n";
 
-        StockhamGenerator::hcKernWrite(transKernel, 6) << "else if (pos == 1){" << std::endl;
+        StockhamGenerator::hcKernWrite(transKernel, 6) << "else if (pos == 1){\n";
         StockhamGenerator::hcKernWrite(transKernel, 9)
             << "Ld[j] = inputA[inOffset + id *" << smaller_dim << " + "
-            << num_elements_loaded << " * work_id + j];" << std::endl;
-        StockhamGenerator::hcKernWrite(transKernel, 6) << "}" << std::endl;
+            << num_elements_loaded << " * work_id + j];\n";
+        StockhamGenerator::hcKernWrite(transKernel, 6) << "}\n";
 
         StockhamGenerator::hcKernWrite(transKernel, 6) << "inputA[inOffset + id*" << smaller_dim
                                     << " + " << num_elements_loaded
-                                    << " * work_id + j] = Ls[j];" << std::endl;
+                                    << " * work_id + j] = Ls[j];\n";
         break;
       case HCFFT_HERMITIAN_INTERLEAVED:
       case HCFFT_HERMITIAN_PLANAR:
         return HCFFT_INVALID;
       case HCFFT_COMPLEX_PLANAR:
-        StockhamGenerator::hcKernWrite(transKernel, 6) << "if (pos == 0){" << std::endl;
+        StockhamGenerator::hcKernWrite(transKernel, 6) << "if (pos == 0){\n";
         StockhamGenerator::hcKernWrite(transKernel, 9)
             << "Ls[j].x = inputA_R[inOffset + is*" << smaller_dim << " + "
-            << num_elements_loaded << " * work_id + j];" << std::endl;
+            << num_elements_loaded << " * work_id + j];\n";
         StockhamGenerator::hcKernWrite(transKernel, 9)
             << "Ls[j].y = inputA_I[inOffset + is*" << smaller_dim << " + "
-            << num_elements_loaded << " * work_id + j];" << std::endl;
+            << num_elements_loaded << " * work_id + j];\n";
         StockhamGenerator::hcKernWrite(transKernel, 9)
             << "Ld[j].x = inputA_R[inOffset + id*" << smaller_dim << " + "
-            << num_elements_loaded << " * work_id + j];" << std::endl;
+            << num_elements_loaded << " * work_id + j];\n";
         StockhamGenerator::hcKernWrite(transKernel, 9)
             << "Ld[j].y = inputA_I[inOffset + id*" << smaller_dim << " + "
-            << num_elements_loaded << " * work_id + j];" << std::endl;
-        StockhamGenerator::hcKernWrite(transKernel, 6) << "}" << std::endl;
+            << num_elements_loaded << " * work_id + j];\n";
+        StockhamGenerator::hcKernWrite(transKernel, 6) << "}\n";
 
-        StockhamGenerator::hcKernWrite(transKernel, 6) << "else if (pos == 1){" << std::endl;
+        StockhamGenerator::hcKernWrite(transKernel, 6) << "else if (pos == 1){\n";
         StockhamGenerator::hcKernWrite(transKernel, 9)
             << "Ld[j].x = inputA_R[inOffset + id*" << smaller_dim << " + "
-            << num_elements_loaded << " * work_id + j];" << std::endl;
+            << num_elements_loaded << " * work_id + j];\n";
         StockhamGenerator::hcKernWrite(transKernel, 9)
             << "Ld[j].y = inputA_I[inOffset + id*" << smaller_dim << " + "
-            << num_elements_loaded << " * work_id + j];" << std::endl;
-        StockhamGenerator::hcKernWrite(transKernel, 6) << "}" << std::endl;
+            << num_elements_loaded << " * work_id + j];\n";
+        StockhamGenerator::hcKernWrite(transKernel, 6) << "}\n";
 
         StockhamGenerator::hcKernWrite(transKernel, 6)
             << "inputA_R[inOffset + id*" << smaller_dim << " + "
-            << num_elements_loaded << " * work_id + j] = Ls[j].x;" << std::endl;
+            << num_elements_loaded << " * work_id + j] = Ls[j].x;\n";
         StockhamGenerator::hcKernWrite(transKernel, 6)
             << "inputA_I[inOffset + id*" << smaller_dim << " + "
-            << num_elements_loaded << " * work_id + j] = Ls[j].y;" << std::endl;
+            << num_elements_loaded << " * work_id + j] = Ls[j].y;\n";
         break;
       default:
         return HCFFT_INVALID;
     }
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "}" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "}\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 0) << "}" << std::endl << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 0) << "}\n" << "\n";
 
     funcName = "swap_nonsquare";
     funcName += SztToStr(count);
@@ -717,16 +711,15 @@ hcfftStatus genSwapKernel(const FFTKernelGenKeyParams& params,
                                    "[=] (hc::tiled_index<2> tidx) [[hc]]\n\t "
                                    "{ ";
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t g_index = tidx.tile[0];"
-                                << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t g_index = tidx.tile[0];\n";
 
     StockhamGenerator::hcKernWrite(transKernel, 3)
         << "const size_t numGroupsY_1 = " << cycle_map[0] * num_grps_pro_row
-        << " ;" << std::endl;
+        << " ;\n";
     for (size_t i = 2; i < params.fft_DataDim - 1; i++) {
       StockhamGenerator::hcKernWrite(transKernel, 3) << "const size_t numGroupsY_" << i
                                   << " = numGroupsY_" << i - 1 << " * "
-                                  << params.fft_N[i] << ";" << std::endl;
+                                  << params.fft_N[i] << ";\n";
     }
 
     delete[] cycle_map;
@@ -741,33 +734,31 @@ hcfftStatus genSwapKernel(const FFTKernelGenKeyParams& params,
 
         StockhamGenerator::hcKernWrite(transKernel, 3)
             << "tile_static " << dtInput << " tmp_tot_mem["
-            << (num_elements_loaded * 2) << "];" << std::endl;
+            << (num_elements_loaded * 2) << "];\n";
         StockhamGenerator::hcKernWrite(transKernel, 3) << tmpBuffType << " " << dtInput
-                                    << " *te = tmp_tot_mem;" << std::endl;
+                                    << " *te = tmp_tot_mem;\n";
 
         StockhamGenerator::hcKernWrite(transKernel, 3) << tmpBuffType << " " << dtInput
                                     << " *to = (tmp_tot_mem + "
-                                    << num_elements_loaded << ");" << std::endl;
+                                    << num_elements_loaded << ");\n";
 
         StockhamGenerator::hcKernWrite(transKernel, 3)
-            << "uint inOffset = iOffset;"
-            << std::endl;  // Set A ptr to the start of each slice
+            << "uint inOffset = iOffset;\n";  // Set A ptr to the start of each slice
         break;
       case HCFFT_COMPLEX_PLANAR:
 
         StockhamGenerator::hcKernWrite(transKernel, 3)
             << "tile_static " << dtComplex << " tmp_tot_mem["
-            << (num_elements_loaded * 2) << "];" << std::endl;
+            << (num_elements_loaded * 2) << "];\n";
         StockhamGenerator::hcKernWrite(transKernel, 3) << tmpBuffType << " " << dtComplex
-                                    << " *te = tmp_tot_mem;" << std::endl;
+                                    << " *te = tmp_tot_mem;\n";
 
         StockhamGenerator::hcKernWrite(transKernel, 3) << tmpBuffType << " " << dtComplex
                                     << " *to = (tmp_tot_mem + "
-                                    << num_elements_loaded << ");" << std::endl;
+                                    << num_elements_loaded << ");\n";
 
         StockhamGenerator::hcKernWrite(transKernel, 3)
-            << "uint inOffset = iOffset;"
-            << std::endl;  // Set A ptr to the start of each slice
+            << "uint inOffset = iOffset;\n";  // Set A ptr to the start of each slice
         break;
       case HCFFT_HERMITIAN_INTERLEAVED:
       case HCFFT_HERMITIAN_PLANAR:
@@ -781,41 +772,40 @@ hcfftStatus genSwapKernel(const FFTKernelGenKeyParams& params,
       case HCFFT_COMPLEX_INTERLEAVED:
       case HCFFT_COMPLEX_PLANAR:
         StockhamGenerator::hcKernWrite(transKernel, 3) << tmpBuffType << " " << dtComplex
-                                    << " *tmp_swap_ptr[2];" << std::endl;
+                                    << " *tmp_swap_ptr[2];\n";
         break;
       case HCFFT_REAL:
         StockhamGenerator::hcKernWrite(transKernel, 3) << tmpBuffType << " " << dtPlanar
-                                    << " *tmp_swap_ptr[2];" << std::endl;
+                                    << " *tmp_swap_ptr[2];\n";
       case HCFFT_HERMITIAN_INTERLEAVED:
       case HCFFT_HERMITIAN_PLANAR:
         break;
     }
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "tmp_swap_ptr[0] = te;" << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "tmp_swap_ptr[1] = to;" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "tmp_swap_ptr[0] = te;\n";
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "tmp_swap_ptr[1] = to;\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t swap_inx = 0;" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t swap_inx = 0;\n";
 
     StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t start = cycle_stat[g_index / "
-                                << num_grps_pro_row << "][0];" << std::endl;
+                                << num_grps_pro_row << "][0];\n";
     StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t end = cycle_stat[g_index / "
-                                << num_grps_pro_row << "][1];" << std::endl;
+                                << num_grps_pro_row << "][1];\n";
 
     StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t end_indx = " << num_elements_loaded
-                                << ";" << std::endl;
+                                << ";\n";
     StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t work_id = g_index % "
-                                << num_grps_pro_row << ";" << std::endl;
+                                << num_grps_pro_row << ";\n";
 
     StockhamGenerator::hcKernWrite(transKernel, 3) << "if( work_id == " << (num_grps_pro_row - 1)
-                                << " ){" << std::endl;
+                                << " ){\n";
     StockhamGenerator::hcKernWrite(transKernel, 6)
         << "end_indx = "
-        << smaller_dim - num_elements_loaded * (num_grps_pro_row - 1) << ";"
-        << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "}" << std::endl;
+        << smaller_dim - num_elements_loaded * (num_grps_pro_row - 1) << ";\n";
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "}\n";
 
     StockhamGenerator::hcKernWrite(transKernel, 3)
-        << "for (size_t loop = start; loop <= end; loop ++){" << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 6) << "swap_inx = 1 - swap_inx;" << std::endl;
+        << "for (size_t loop = start; loop <= end; loop ++){\n";
+    StockhamGenerator::hcKernWrite(transKernel, 6) << "swap_inx = 1 - swap_inx;\n";
 
     switch (params.fft_inputLayout) {
       case HCFFT_COMPLEX_INTERLEAVED:
@@ -836,11 +826,11 @@ hcfftStatus genSwapKernel(const FFTKernelGenKeyParams& params,
       case HCFFT_HERMITIAN_INTERLEAVED:
         break;
     }
-    StockhamGenerator::hcKernWrite(transKernel, 0) << ");" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 0) << ");\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "}" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "}\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 0) << "}).wait();\n}}\n" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 0) << "}).wait();\n}}\n\n";
     strKernel = transKernel.str();
   }
   return HCFFT_SUCCEEDS;
@@ -878,7 +868,7 @@ hcfftStatus genSwapKernelGeneral(
   }
 
   strKernel.reserve(4096);
-  std::stringstream transKernel(std::stringstream::out);
+  CodeEmitter transKernel;
 
   // These strings represent the various data types we read or write in the
   // kernel, depending on how the plan
@@ -971,11 +961,9 @@ hcfftStatus genSwapKernelGeneral(
   permutation_calculation(dim_ratio, smaller_dim, permutationTable);
 
   StockhamGenerator::hcKernWrite(transKernel, 0) << "size_t swap_table["
-                              << permutationTable.size() + 2 << "][1] = {"
-                              << std::endl;
-  StockhamGenerator::hcKernWrite(transKernel, 0) << "{0}," << std::endl;
-  StockhamGenerator::hcKernWrite(transKernel, 0) << "{" << smaller_dim * dim_ratio - 1 << "},"
-                              << std::endl;  // add the first and last row to
+                              << permutationTable.size() + 2 << "][1] = {\n";
+  StockhamGenerator::hcKernWrite(transKernel, 0) << "{0},\n";
+  StockhamGenerator::hcKernWrite(transKernel, 0) << "{" << smaller_dim * dim_ratio - 1 << "},\n";  // add the first and last row to
                                              // the swap table. needed for
                                              // twiddling
   for (std::vector<std::vector<size_t> >::iterator itor =
@@ -983,15 +971,15 @@ hcfftStatus genSwapKernelGeneral(
        itor != permutationTable.end(); itor++) {
     StockhamGenerator::hcKernWrite(transKernel, 0) << "{" << (*itor)[0] << "}";
     if (itor == (permutationTable.end() - 1))  // last vector
-      StockhamGenerator::hcKernWrite(transKernel, 0) << std::endl << "};" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 0) << "\n" << "};\n";
     else
-      StockhamGenerator::hcKernWrite(transKernel, 0) << "," << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 0) << ",\n";
   }
 
   // twiddle in swap kernel
   // twiddle in or out should be using the same twiddling table
   if (twiddleSwapKernel) {
-    std::string str;
+    CodeEmitter str;
     if (params.fft_precision == HCFFT_SINGLE) {
       StockhamGenerator::TwiddleTableLarge<hc::short_vector::float_2,
                                            StockhamGenerator::P_SINGLE>
@@ -1005,8 +993,8 @@ hcfftStatus genSwapKernelGeneral(
       twLarge.GenerateTwiddleTable(str, plHandle);
       twLarge.TwiddleLargeAV((void**)&twiddleslarge, acc);
     }
-    StockhamGenerator::hcKernWrite(transKernel, 0) << str << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 0) << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 0) << str.str() << "\n";
+    StockhamGenerator::hcKernWrite(transKernel, 0) << "\n";
   }
 
   // std::string funcName = "swap_nonsquare_" + std::to_string(smaller_dim) +
@@ -1051,33 +1039,28 @@ hcfftStatus genSwapKernelGeneral(
                                    "{ ";
 
     StockhamGenerator::hcKernWrite(transKernel, 3) << "//each wg handles 1/" << WG_per_line
-                                << " row of " << LDS_per_WG << " in memory"
-                                << std::endl;
+                                << " row of " << LDS_per_WG << " in memory\n";
     StockhamGenerator::hcKernWrite(transKernel, 3)
         << "const size_t num_wg_per_batch = "
-        << (permutationTable.size() + 2) * WG_per_line << ";"
-        << std::endl;  // number of wg per batch = number of independent cycles
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t group_id = tidx.tile[0];"
-                                << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t idx = tidx.local[0];" << std::endl;
+        << (permutationTable.size() + 2) * WG_per_line << ";\n";  // number of wg per batch = number of independent cycles
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t group_id = tidx.tile[0];\n";
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t idx = tidx.local[0];\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
     StockhamGenerator::hcKernWrite(transKernel, 3)
-        << "size_t batch_offset = group_id / num_wg_per_batch;" << std::endl;
+        << "size_t batch_offset = group_id / num_wg_per_batch;\n";
     switch (params.fft_inputLayout) {
       case HCFFT_REAL:
       case HCFFT_COMPLEX_INTERLEAVED:
         StockhamGenerator::hcKernWrite(transKernel, 3) << " uint inOffset = batch_offset*"
-                                    << smaller_dim * bigger_dim << ";"
-                                    << std::endl;
+                                    << smaller_dim * bigger_dim << ";\n";
         break;
       case HCFFT_HERMITIAN_INTERLEAVED:
       case HCFFT_HERMITIAN_PLANAR:
         return HCFFT_INVALID;
       case HCFFT_COMPLEX_PLANAR: {
         StockhamGenerator::hcKernWrite(transKernel, 3) << "uint inOffset = batch_offset*"
-                                    << smaller_dim * bigger_dim << ";"
-                                    << std::endl;
+                                    << smaller_dim * bigger_dim << ";\n";
         break;
       }
       default:
@@ -1085,38 +1068,34 @@ hcfftStatus genSwapKernelGeneral(
     }
     StockhamGenerator::hcKernWrite(transKernel, 3) << "group_id -= batch_offset*"
                                 << (permutationTable.size() + 2) * WG_per_line
-                                << ";" << std::endl;
+                                << ";\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
     if (WG_per_line == 1)
-      StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t prev = swap_table[group_id][0];"
-                                  << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t prev = swap_table[group_id][0];\n";
     else
       StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t prev = swap_table[group_id/"
-                                  << WG_per_line << "][0];" << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t next = 0;" << std::endl;
+                                  << WG_per_line << "][0];\n";
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t next = 0;\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
     switch (params.fft_inputLayout) {
       case HCFFT_REAL:
       case HCFFT_COMPLEX_INTERLEAVED: {
         StockhamGenerator::hcKernWrite(transKernel, 3)
-            << "tile_static " << dtInput << " prevValue[" << LDS_per_WG << "];"
-            << std::endl;  // lds within each wg should be able to store a row
+            << "tile_static " << dtInput << " prevValue[" << LDS_per_WG << "];\n";  // lds within each wg should be able to store a row
                            // block (smaller_dim) of element
         StockhamGenerator::hcKernWrite(transKernel, 3) << "tile_static " << dtInput
-                                    << " nextValue[" << LDS_per_WG << "];"
-                                    << std::endl;
+                                    << " nextValue[" << LDS_per_WG << "];\n";
         break;
       }
       case HCFFT_COMPLEX_PLANAR: {
         StockhamGenerator::hcKernWrite(transKernel, 3)
             << "tile_static " << dtComplex << " prevValue[" << LDS_per_WG
-            << "];" << std::endl;  // lds within each wg should be able to store
+            << "];\n";  // lds within each wg should be able to store
                                    // a row block (smaller_dim) of element
         StockhamGenerator::hcKernWrite(transKernel, 3) << "tile_static " << dtComplex
-                                    << " nextValue[" << LDS_per_WG << "];"
-                                    << std::endl;
+                                    << " nextValue[" << LDS_per_WG << "];\n";
         break;
       }
       case HCFFT_HERMITIAN_INTERLEAVED:
@@ -1126,7 +1105,7 @@ hcfftStatus genSwapKernelGeneral(
         return HCFFT_INVALID;
     }
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
     if (params.fft_N[0] >
         params.fft_N[1]) {  // decides whether we have a tall or wide rectangle
       if (WG_per_line == 1) {
@@ -1134,7 +1113,7 @@ hcfftStatus genSwapKernelGeneral(
         StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t group_offset = (prev/"
                                     << dim_ratio << ")*" << smaller_dim << "*"
                                     << dim_ratio << " + (prev%" << dim_ratio
-                                    << ")*" << smaller_dim << ";" << std::endl;
+                                    << ")*" << smaller_dim << ";\n";
       } else {
         // if smaller_dim is 2187 > 1024 this should look like size_t
         // group_offset = (prev/3)*2187*3 + (prev%3)*2187 + (group_id % 3)*729;
@@ -1142,27 +1121,25 @@ hcfftStatus genSwapKernelGeneral(
             << "size_t group_offset = (prev/" << dim_ratio << ")*"
             << smaller_dim << "*" << dim_ratio << " + (prev%" << dim_ratio
             << ")*" << smaller_dim << " + (group_id % " << WG_per_line << ")*"
-            << LDS_per_WG << ";" << std::endl;
+            << LDS_per_WG << ";\n";
       }
     } else {
       if (WG_per_line == 1)  // might look like: size_t group_offset = prev*729;
         StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t group_offset = (prev*"
-                                    << smaller_dim << ");" << std::endl;
+                                    << smaller_dim << ");\n";
       else  // if smaller_dim is 2187 > 1024 this should look like size_t
             // group_offset = prev*2187 + (group_id % 3)*729;
         StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t group_offset = (prev*"
                                     << smaller_dim << ") + (group_id % "
-                                    << WG_per_line << ")*" << LDS_per_WG << ";"
-                                    << std::endl;
+                                    << WG_per_line << ")*" << LDS_per_WG << ";\n";
     }
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
     // move to that row block and load that row block to LDS
     if (twiddleSwapKernelIn) {
-      StockhamGenerator::hcKernWrite(transKernel, 6) << "size_t p;" << std::endl;
-      StockhamGenerator::hcKernWrite(transKernel, 6) << "size_t q;" << std::endl;
-      StockhamGenerator::hcKernWrite(transKernel, 6) << dtComplex << " twiddle_factor;"
-                                  << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 6) << "size_t p;\n";
+      StockhamGenerator::hcKernWrite(transKernel, 6) << "size_t q;\n";
+      StockhamGenerator::hcKernWrite(transKernel, 6) << dtComplex << " twiddle_factor;\n";
     }
     switch (params.fft_inputLayout) {
       case HCFFT_REAL:
@@ -1175,25 +1152,21 @@ hcfftStatus genSwapKernelGeneral(
                                                       // rectangle
                 // input is wide; output is tall; read input index realted
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "p = (group_offset+idx+" << i
-                                            << ")/" << bigger_dim << ";"
-                                            << std::endl;
+                                            << ")/" << bigger_dim << ";\n";
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "q = (group_offset+idx+" << i
-                                            << ")%" << bigger_dim << ";"
-                                            << std::endl;
+                                            << ")%" << bigger_dim << ";\n";
               } else {
                 // input is tall; output is wide; read input index realted
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "p = (group_offset+idx+" << i
-                                            << ")/" << smaller_dim << ";"
-                                            << std::endl;
+                                            << ")/" << smaller_dim << ";\n";
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "q = (group_offset+idx+" << i
-                                            << ")%" << smaller_dim << ";"
-                                            << std::endl;
+                                            << ")%" << smaller_dim << ";\n";
               }
               StockhamGenerator::hcKernWrite(transKernel, 6) << "twiddle_factor = TW3step"
-                                          << plHandle << "(p*q" << std::endl;
+                                          << plHandle << "(p*q\n";
               StockhamGenerator::hcKernWrite(transKernel, 9) << ", ";
-              StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << std::endl;
-              StockhamGenerator::hcKernWrite(transKernel, 9) << ");" << std::endl;
+              StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << "\n";
+              StockhamGenerator::hcKernWrite(transKernel, 9) << ");\n";
               if (fwd) {
                 // forward
                 StockhamGenerator::hcKernWrite(transKernel, 3)
@@ -1201,13 +1174,13 @@ hcfftStatus genSwapKernelGeneral(
                     << "].x = inputA[inOffset + group_offset+idx+" << i
                     << "].x * twiddle_factor.x - inputA[inOffset + "
                        "group_offset+idx+"
-                    << i << "].y * twiddle_factor.y;" << std::endl;
+                    << i << "].y * twiddle_factor.y;\n";
                 StockhamGenerator::hcKernWrite(transKernel, 3)
                     << "prevValue[idx+" << i
                     << "].y = inputA[inOffset + group_offset+idx+" << i
                     << "].x * twiddle_factor.y + inputA[inOffset + "
                        "group_offset+idx+"
-                    << i << "].y * twiddle_factor.x;" << std::endl;
+                    << i << "].y * twiddle_factor.x;\n";
               } else {
                 // backward
                 StockhamGenerator::hcKernWrite(transKernel, 3)
@@ -1215,49 +1188,44 @@ hcfftStatus genSwapKernelGeneral(
                     << "].x = inputA[inOffset + group_offset+idx+" << i
                     << "].x * twiddle_factor.x + inputA[inOffset + "
                        "group_offset+idx+"
-                    << i << "].y * twiddle_factor.y;" << std::endl;
+                    << i << "].y * twiddle_factor.y;\n";
                 StockhamGenerator::hcKernWrite(transKernel, 3)
                     << "prevValue[idx+" << i
                     << "].y = inputA[inOffset + group_offset+idx+" << i
                     << "].y * twiddle_factor.x - inputA[inOffset + "
                        "group_offset+idx+"
-                    << i << "].x * twiddle_factor.y;" << std::endl;
+                    << i << "].x * twiddle_factor.y;\n";
               }
             } else {
               StockhamGenerator::hcKernWrite(transKernel, 3)
                   << "prevValue[idx+" << i
-                  << "] = inputA[inOffset + group_offset+idx+" << i << "];"
-                  << std::endl;
+                  << "] = inputA[inOffset + group_offset+idx+" << i << "];\n";
             }
           } else {
             // need to handle boundary
             StockhamGenerator::hcKernWrite(transKernel, 3) << "if(idx+" << i << "<" << LDS_per_WG
-                                        << "){" << std::endl;
+                                        << "){\n";
             if (twiddleSwapKernelIn) {
               if (params.fft_N[0] > params.fft_N[1]) {  // decides whether we
                                                       // have a tall or wide
                                                       // rectangle
                 // input is wide; output is tall; read input index realted
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "p = (group_offset+idx+" << i
-                                            << ")/" << bigger_dim << ";"
-                                            << std::endl;
+                                            << ")/" << bigger_dim << ";\n";
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "q = (group_offset+idx+" << i
-                                            << ")%" << bigger_dim << ";"
-                                            << std::endl;
+                                            << ")%" << bigger_dim << ";\n";
               } else {
                 // input is tall; output is wide; read input index realted
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "p = (group_offset+idx+" << i
-                                            << ")/" << smaller_dim << ";"
-                                            << std::endl;
+                                            << ")/" << smaller_dim << ";\n";
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "q = (group_offset+idx+" << i
-                                            << ")%" << smaller_dim << ";"
-                                            << std::endl;
+                                            << ")%" << smaller_dim << ";\n";
               }
               StockhamGenerator::hcKernWrite(transKernel, 6) << "twiddle_factor = TW3step"
-                                          << plHandle << "(p*q" << std::endl;
+                                          << plHandle << "(p*q\n";
               StockhamGenerator::hcKernWrite(transKernel, 9) << ", ";
-              StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << std::endl;
-              StockhamGenerator::hcKernWrite(transKernel, 9) << ");" << std::endl;
+              StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << "\n";
+              StockhamGenerator::hcKernWrite(transKernel, 9) << ");\n";
               if (fwd) {
                 // forward
                 StockhamGenerator::hcKernWrite(transKernel, 3)
@@ -1265,13 +1233,13 @@ hcfftStatus genSwapKernelGeneral(
                     << "].x = inputA[inOffset + group_offset+idx+" << i
                     << "].x * twiddle_factor.x - inputA[inOffset + "
                        "group_offset+idx+"
-                    << i << "].y * twiddle_factor.y;" << std::endl;
+                    << i << "].y * twiddle_factor.y;\n";
                 StockhamGenerator::hcKernWrite(transKernel, 3)
                     << "prevValue[idx+" << i
                     << "].y = inputA[inOffset + group_offset+idx+" << i
                     << "].x * twiddle_factor.y + inputA[inOffset + "
                        "group_offset+idx+"
-                    << i << "].y * twiddle_factor.x;" << std::endl;
+                    << i << "].y * twiddle_factor.x;\n";
               } else {
                 // backward
                 StockhamGenerator::hcKernWrite(transKernel, 3)
@@ -1279,21 +1247,20 @@ hcfftStatus genSwapKernelGeneral(
                     << "].x = inputA[inOffset + group_offset+idx+" << i
                     << "].x * twiddle_factor.x + inputA[inOffset + "
                        "group_offset+idx+"
-                    << i << "].y * twiddle_factor.y;" << std::endl;
+                    << i << "].y * twiddle_factor.y;\n";
                 StockhamGenerator::hcKernWrite(transKernel, 3)
                     << "prevValue[idx+" << i
                     << "].y = inputA[inOffset + group_offset+idx+" << i
                     << "].y * twiddle_factor.x - inputA[inOffset + "
                        "group_offset+idx+"
-                    << i << "].x * twiddle_factor.y;" << std::endl;
+                    << i << "].x * twiddle_factor.y;\n";
               }
             } else {
               StockhamGenerator::hcKernWrite(transKernel, 6)
                   << "prevValue[idx+" << i
-                  << "] = inputA[inOffset + group_offset+idx+" << i << "];"
-                  << std::endl;
+                  << "] = inputA[inOffset + group_offset+idx+" << i << "];\n";
             }
-            StockhamGenerator::hcKernWrite(transKernel, 3) << "}" << std::endl;
+            StockhamGenerator::hcKernWrite(transKernel, 3) << "}\n";
           }
         }
         break;
@@ -1310,25 +1277,21 @@ hcfftStatus genSwapKernelGeneral(
                                                       // rectangle
                 // input is wide; output is tall; read input index realted
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "p = (group_offset+idx+" << i
-                                            << ")/" << bigger_dim << ";"
-                                            << std::endl;
+                                            << ")/" << bigger_dim << ";\n";
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "q = (group_offset+idx+" << i
-                                            << ")%" << bigger_dim << ";"
-                                            << std::endl;
+                                            << ")%" << bigger_dim << ";\n";
               } else {
                 // input is tall; output is wide; read input index realted
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "p = (group_offset+idx+" << i
-                                            << ")/" << smaller_dim << ";"
-                                            << std::endl;
+                                            << ")/" << smaller_dim << ";\n";
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "q = (group_offset+idx+" << i
-                                            << ")%" << smaller_dim << ";"
-                                            << std::endl;
+                                            << ")%" << smaller_dim << ";\n";
               }
               StockhamGenerator::hcKernWrite(transKernel, 6) << "twiddle_factor = TW3step"
-                                          << plHandle << "(p*q" << std::endl;
+                                          << plHandle << "(p*q\n";
               StockhamGenerator::hcKernWrite(transKernel, 9) << ", ";
-              StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << std::endl;
-              StockhamGenerator::hcKernWrite(transKernel, 9) << ");" << std::endl;
+              StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << "\n";
+              StockhamGenerator::hcKernWrite(transKernel, 9) << ");\n";
               if (fwd) {
                 // forward
                 StockhamGenerator::hcKernWrite(transKernel, 3)
@@ -1336,13 +1299,13 @@ hcfftStatus genSwapKernelGeneral(
                     << "].x = inputA_R[inOffset + group_offset+idx+" << i
                     << "] * twiddle_factor.x - inputA_I[inOffset + "
                        "group_offset+idx+"
-                    << i << "] * twiddle_factor.y;" << std::endl;
+                    << i << "] * twiddle_factor.y;\n";
                 StockhamGenerator::hcKernWrite(transKernel, 3)
                     << "prevValue[idx+" << i
                     << "].y = inputA_R[inOffset + group_offset+idx+" << i
                     << "] * twiddle_factor.y + inputA_I[inOffset + "
                        "group_offset+idx+"
-                    << i << "] * twiddle_factor.x;" << std::endl;
+                    << i << "] * twiddle_factor.x;\n";
               } else {
                 // backward
                 StockhamGenerator::hcKernWrite(transKernel, 3)
@@ -1350,53 +1313,47 @@ hcfftStatus genSwapKernelGeneral(
                     << "].x = inputA_R[inOffset + group_offset+idx+" << i
                     << "] * twiddle_factor.x + inputA_I[inOffset + "
                        "group_offset+idx+"
-                    << i << "] * twiddle_factor.y;" << std::endl;
+                    << i << "] * twiddle_factor.y;\n";
                 StockhamGenerator::hcKernWrite(transKernel, 3)
                     << "prevValue[idx+" << i
                     << "].y = inputA_I[inOffset + group_offset+idx+" << i
                     << "] * twiddle_factor.x - inputA_R[inOffset + "
                        "group_offset+idx+"
-                    << i << "] * twiddle_factor.y;" << std::endl;
+                    << i << "] * twiddle_factor.y;\n";
               }
             } else {
               StockhamGenerator::hcKernWrite(transKernel, 3)
                   << "prevValue[idx+" << i
-                  << "].x = inputA_R[inOffset + group_offset+idx+" << i << "];"
-                  << std::endl;
+                  << "].x = inputA_R[inOffset + group_offset+idx+" << i << "];\n";
               StockhamGenerator::hcKernWrite(transKernel, 3)
                   << "prevValue[idx+" << i
-                  << "].y = inputA_I[inOffset + group_offset+idx+" << i << "];"
-                  << std::endl;
+                  << "].y = inputA_I[inOffset + group_offset+idx+" << i << "];\n";
             }
           } else {
             // need to handle boundary
             StockhamGenerator::hcKernWrite(transKernel, 3) << "if(idx+" << i << "<" << LDS_per_WG
-                                        << "){" << std::endl;
+                                        << "){\n";
             if (twiddleSwapKernelIn) {
               if (params.fft_N[0] > params.fft_N[1]) {  // decides whether we
                                                       // have a tall or wide
                                                       // rectangle
                 // input is wide; output is tall; read input index realted
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "p = (group_offset+idx+" << i
-                                            << ")/" << bigger_dim << ";"
-                                            << std::endl;
+                                            << ")/" << bigger_dim << ";\n";
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "q = (group_offset+idx+" << i
-                                            << ")%" << bigger_dim << ";"
-                                            << std::endl;
+                                            << ")%" << bigger_dim << ";\n";
               } else {
                 // input is tall; output is wide; read input index realted
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "p = (group_offset+idx+" << i
-                                            << ")/" << smaller_dim << ";"
-                                            << std::endl;
+                                            << ")/" << smaller_dim << ";\n";
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "q = (group_offset+idx+" << i
-                                            << ")%" << smaller_dim << ";"
-                                            << std::endl;
+                                            << ")%" << smaller_dim << ";\n";
               }
               StockhamGenerator::hcKernWrite(transKernel, 6) << "twiddle_factor = TW3step"
-                                          << plHandle << "(p*q" << std::endl;
+                                          << plHandle << "(p*q\n";
               StockhamGenerator::hcKernWrite(transKernel, 9) << ", ";
-              StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << std::endl;
-              StockhamGenerator::hcKernWrite(transKernel, 9) << ");" << std::endl;
+              StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << "\n";
+              StockhamGenerator::hcKernWrite(transKernel, 9) << ");\n";
               if (fwd) {
                 // forward
                 StockhamGenerator::hcKernWrite(transKernel, 3)
@@ -1404,13 +1361,13 @@ hcfftStatus genSwapKernelGeneral(
                     << "].x = inputA_R[inOffset + group_offset+idx+" << i
                     << "] * twiddle_factor.x - inputA_I[inOffset + "
                        "group_offset+idx+"
-                    << i << "] * twiddle_factor.y;" << std::endl;
+                    << i << "] * twiddle_factor.y;\n";
                 StockhamGenerator::hcKernWrite(transKernel, 3)
                     << "prevValue[idx+" << i
                     << "].y = inputA_R[inOffset + group_offset+idx+" << i
                     << "] * twiddle_factor.y + inputA_I[inOffset + "
                        "group_offset+idx+"
-                    << i << "] * twiddle_factor.x;" << std::endl;
+                    << i << "] * twiddle_factor.x;\n";
               } else {
                 // backward
                 StockhamGenerator::hcKernWrite(transKernel, 3)
@@ -1418,25 +1375,23 @@ hcfftStatus genSwapKernelGeneral(
                     << "].x = inputA_R[inOffset + group_offset+idx+" << i
                     << "] * twiddle_factor.x + inputA_I[inOffset + "
                        "group_offset+idx+"
-                    << i << "] * twiddle_factor.y;" << std::endl;
+                    << i << "] * twiddle_factor.y;\n";
                 StockhamGenerator::hcKernWrite(transKernel, 3)
                     << "prevValue[idx+" << i
                     << "].y = inputA_I[inOffset + group_offset+idx+" << i
                     << "] * twiddle_factor.x - inputA_R[inOffset + "
                        "group_offset+idx+"
-                    << i << "] * twiddle_factor.y;" << std::endl;
+                    << i << "] * twiddle_factor.y;\n";
               }
             } else {
               StockhamGenerator::hcKernWrite(transKernel, 3)
                   << "prevValue[idx+" << i
-                  << "].x = inputA_R[inOffset + group_offset+idx+" << i << "];"
-                  << std::endl;
+                  << "].x = inputA_R[inOffset + group_offset+idx+" << i << "];\n";
               StockhamGenerator::hcKernWrite(transKernel, 3)
                   << "prevValue[idx+" << i
-                  << "].y = inputA_I[inOffset + group_offset+idx+" << i << "];"
-                  << std::endl;
+                  << "].y = inputA_I[inOffset + group_offset+idx+" << i << "];\n";
             }
-            StockhamGenerator::hcKernWrite(transKernel, 3) << "}" << std::endl;
+            StockhamGenerator::hcKernWrite(transKernel, 3) << "}\n";
           }
         }
         break;
@@ -1444,27 +1399,25 @@ hcfftStatus genSwapKernelGeneral(
       default:
         return HCFFT_INVALID;
     }
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "tidx.barrier.wait();" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "tidx.barrier.wait();\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "do{" << std::endl;  // begining of do-while
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "do{\n";  // begining of do-while
     // calculate the next location p(k) = (k*n)mod(m*n-1), if 0 < k < m*n-1
     if (params.fft_N[0] >
         params.fft_N[1]) {  // decides whether we have a tall or wide rectangle
       StockhamGenerator::hcKernWrite(transKernel, 6) << "next = (prev*" << smaller_dim << ")%"
-                                  << smaller_dim * dim_ratio - 1 << ";"
-                                  << std::endl;
+                                  << smaller_dim * dim_ratio - 1 << ";\n";
       // takes care the last row
       StockhamGenerator::hcKernWrite(transKernel, 6)
-          << "if (prev == " << smaller_dim * dim_ratio - 1 << ")" << std::endl;
+          << "if (prev == " << smaller_dim * dim_ratio - 1 << ")\n";
       StockhamGenerator::hcKernWrite(transKernel, 9) << "next = " << smaller_dim * dim_ratio - 1
-                                  << ";" << std::endl;
+                                  << ";\n";
       if (WG_per_line == 1) {
         StockhamGenerator::hcKernWrite(transKernel, 6)
             << "group_offset = (next/" << dim_ratio << ")*" << smaller_dim
             << "*" << dim_ratio << " + (next%" << dim_ratio << ")*"
-            << smaller_dim << ";"
-            << std::endl;  // might look like: group_offset = (next/3)*729*3 +
+            << smaller_dim << ";\n";  // might look like: group_offset = (next/3)*729*3 +
                            // (next%3)*729;
       } else {
         // if smaller_dim is 2187 > 1024 this should look like size_t
@@ -1473,28 +1426,27 @@ hcfftStatus genSwapKernelGeneral(
             << "group_offset = (next/" << dim_ratio << ")*" << smaller_dim
             << "*" << dim_ratio << " + (next%" << dim_ratio << ")*"
             << smaller_dim << " + (group_id % " << WG_per_line << ")*"
-            << LDS_per_WG << ";" << std::endl;
+            << LDS_per_WG << ";\n";
       }
     } else {
       StockhamGenerator::hcKernWrite(transKernel, 6) << "next = (prev*" << dim_ratio << ")%"
-                                  << smaller_dim * dim_ratio - 1 << ";"
-                                  << std::endl;
+                                  << smaller_dim * dim_ratio - 1 << ";\n";
       // takes care the last row
       StockhamGenerator::hcKernWrite(transKernel, 6)
-          << "if (prev == " << smaller_dim * dim_ratio - 1 << ")" << std::endl;
+          << "if (prev == " << smaller_dim * dim_ratio - 1 << ")\n";
       StockhamGenerator::hcKernWrite(transKernel, 9) << "next = " << smaller_dim * dim_ratio - 1
-                                  << ";" << std::endl;
+                                  << ";\n";
       if (WG_per_line == 1)  // might look like: size_t group_offset = prev*729;
         StockhamGenerator::hcKernWrite(transKernel, 6) << "group_offset = (next*" << smaller_dim
-                                    << ");" << std::endl;
+                                    << ");\n";
       else  // if smaller_dim is 2187 > 1024 this should look like size_t
             // group_offset = next*2187 + (group_id % 3)*729;
         StockhamGenerator::hcKernWrite(transKernel, 6) << "group_offset = (next*" << smaller_dim
                                     << ") + (group_id % " << WG_per_line << ")*"
-                                    << LDS_per_WG << ";" << std::endl;
+                                    << LDS_per_WG << ";\n";
     }
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
     switch (params.fft_inputLayout) {
       case HCFFT_REAL:
       case HCFFT_COMPLEX_INTERLEAVED: {
@@ -1506,25 +1458,21 @@ hcfftStatus genSwapKernelGeneral(
                                                       // rectangle
                 // input is wide; output is tall; read input index realted
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "p = (group_offset+idx+" << i
-                                            << ")/" << bigger_dim << ";"
-                                            << std::endl;
+                                            << ")/" << bigger_dim << ";\n";
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "q = (group_offset+idx+" << i
-                                            << ")%" << bigger_dim << ";"
-                                            << std::endl;
+                                            << ")%" << bigger_dim << ";\n";
               } else {
                 // input is tall; output is wide; read input index realted
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "p = (group_offset+idx+" << i
-                                            << ")/" << smaller_dim << ";"
-                                            << std::endl;
+                                            << ")/" << smaller_dim << ";\n";
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "q = (group_offset+idx+" << i
-                                            << ")%" << smaller_dim << ";"
-                                            << std::endl;
+                                            << ")%" << smaller_dim << ";\n";
               }
               StockhamGenerator::hcKernWrite(transKernel, 6) << "twiddle_factor = TW3step"
-                                          << plHandle << "(p*q" << std::endl;
+                                          << plHandle << "(p*q\n";
               StockhamGenerator::hcKernWrite(transKernel, 9) << ", ";
-              StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << std::endl;
-              StockhamGenerator::hcKernWrite(transKernel, 9) << ");" << std::endl;
+              StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << "\n";
+              StockhamGenerator::hcKernWrite(transKernel, 9) << ");\n";
               if (fwd) {
                 // forward
                 StockhamGenerator::hcKernWrite(transKernel, 3)
@@ -1532,13 +1480,13 @@ hcfftStatus genSwapKernelGeneral(
                     << "].x = inputA[inOffset + group_offset+idx+" << i
                     << "].x * twiddle_factor.x - inputA[inOffset + "
                        "group_offset+idx+"
-                    << i << "].y * twiddle_factor.y;" << std::endl;
+                    << i << "].y * twiddle_factor.y;\n";
                 StockhamGenerator::hcKernWrite(transKernel, 3)
                     << "nextValue[idx+" << i
                     << "].y = inputA[inOffset + group_offset+idx+" << i
                     << "].x * twiddle_factor.y + inputA[inOffset + "
                        "group_offset+idx+"
-                    << i << "].y * twiddle_factor.x;" << std::endl;
+                    << i << "].y * twiddle_factor.x;\n";
               } else {
                 // backward
                 StockhamGenerator::hcKernWrite(transKernel, 3)
@@ -1546,49 +1494,44 @@ hcfftStatus genSwapKernelGeneral(
                     << "].x = inputA[inOffset + group_offset+idx+" << i
                     << "].x * twiddle_factor.x + inputA[inOffset + "
                        "group_offset+idx+"
-                    << i << "].y * twiddle_factor.y;" << std::endl;
+                    << i << "].y * twiddle_factor.y;\n";
                 StockhamGenerator::hcKernWrite(transKernel, 3)
                     << "nextValue[idx+" << i
                     << "].y = inputA[inOffset + group_offset+idx+" << i
                     << "].y * twiddle_factor.x - inputA[inOffset + "
                        "group_offset+idx+"
-                    << i << "].x * twiddle_factor.y;" << std::endl;
+                    << i << "].x * twiddle_factor.y;\n";
               }
             } else {
               StockhamGenerator::hcKernWrite(transKernel, 6)
                   << "nextValue[idx+" << i
-                  << "] = inputA[inOffset + group_offset+idx+" << i << "];"
-                  << std::endl;
+                  << "] = inputA[inOffset + group_offset+idx+" << i << "];\n";
             }
           } else {
             // need to handle boundary
             StockhamGenerator::hcKernWrite(transKernel, 6) << "if(idx+" << i << "<" << LDS_per_WG
-                                        << "){" << std::endl;
+                                        << "){\n";
             if (twiddleSwapKernelIn) {
               if (params.fft_N[0] > params.fft_N[1]) {  // decides whether we
                                                       // have a tall or wide
                                                       // rectangle
                 // input is wide; output is tall; read input index realted
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "p = (group_offset+idx+" << i
-                                            << ")/" << bigger_dim << ";"
-                                            << std::endl;
+                                            << ")/" << bigger_dim << ";\n";
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "q = (group_offset+idx+" << i
-                                            << ")%" << bigger_dim << ";"
-                                            << std::endl;
+                                            << ")%" << bigger_dim << ";\n";
               } else {
                 // input is tall; output is wide; read input index realted
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "p = (group_offset+idx+" << i
-                                            << ")/" << smaller_dim << ";"
-                                            << std::endl;
+                                            << ")/" << smaller_dim << ";\n";
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "q = (group_offset+idx+" << i
-                                            << ")%" << smaller_dim << ";"
-                                            << std::endl;
+                                            << ")%" << smaller_dim << ";\n";
               }
               StockhamGenerator::hcKernWrite(transKernel, 6) << "twiddle_factor = TW3step"
-                                          << plHandle << "(p*q" << std::endl;
+                                          << plHandle << "(p*q\n";
               StockhamGenerator::hcKernWrite(transKernel, 9) << ", ";
-              StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << std::endl;
-              StockhamGenerator::hcKernWrite(transKernel, 9) << ");" << std::endl;
+              StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << "\n";
+              StockhamGenerator::hcKernWrite(transKernel, 9) << ");\n";
               if (fwd) {
                 // forward
                 StockhamGenerator::hcKernWrite(transKernel, 3)
@@ -1596,13 +1539,13 @@ hcfftStatus genSwapKernelGeneral(
                     << "].x = inputA[inOffset + group_offset+idx+" << i
                     << "].x * twiddle_factor.x - inputA[inOffset + "
                        "group_offset+idx+"
-                    << i << "].y * twiddle_factor.y;" << std::endl;
+                    << i << "].y * twiddle_factor.y;\n";
                 StockhamGenerator::hcKernWrite(transKernel, 3)
                     << "nextValue[idx+" << i
                     << "].y = inputA[inOffset + group_offset+idx+" << i
                     << "].x * twiddle_factor.y + inputA[inOffset + "
                        "group_offset+idx+"
-                    << i << "].y * twiddle_factor.x;" << std::endl;
+                    << i << "].y * twiddle_factor.x;\n";
               } else {
                 // backward
                 StockhamGenerator::hcKernWrite(transKernel, 3)
@@ -1610,20 +1553,19 @@ hcfftStatus genSwapKernelGeneral(
                     << "].x = inputA[inOffset + group_offset+idx+" << i
                     << "].x * twiddle_factor.x + inputA[inOffset + "
                        "group_offset+idx+"
-                    << i << "].y * twiddle_factor.y;" << std::endl;
+                    << i << "].y * twiddle_factor.y;\n";
                 StockhamGenerator::hcKernWrite(transKernel, 3)
                     << "nextValue[idx+" << i
                     << "].y = inputA[inOffset + group_offset+idx+" << i
                     << "].y * twiddle_factor.x - inputA[inOffset + "
                        "group_offset+idx+"
-                    << i << "].x * twiddle_factor.y;" << std::endl;
+                    << i << "].x * twiddle_factor.y;\n";
               }
             } else {
               StockhamGenerator::hcKernWrite(transKernel, 9)
                   << "nextValue[idx+" << i
-                  << "] = inputA[inOffset + group_offset+idx+" << i << "];"
-                  << std::endl;
-            StockhamGenerator::hcKernWrite(transKernel, 6) << "}" << std::endl;
+                  << "] = inputA[inOffset + group_offset+idx+" << i << "];\n";
+            StockhamGenerator::hcKernWrite(transKernel, 6) << "}\n";
             }
           }
         }
@@ -1641,25 +1583,21 @@ hcfftStatus genSwapKernelGeneral(
                                                     // rectangle
                 // input is wide; output is tall; read input index realted
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "p = (group_offset+idx+" << i
-                                            << ")/" << bigger_dim << ";"
-                                            << std::endl;
+                                            << ")/" << bigger_dim << ";\n";
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "q = (group_offset+idx+" << i
-                                            << ")%" << bigger_dim << ";"
-                                            << std::endl;
+                                            << ")%" << bigger_dim << ";\n";
           } else {
                 // input is tall; output is wide; read input index realted
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "p = (group_offset+idx+" << i
-                                            << ")/" << smaller_dim << ";"
-                                            << std::endl;
+                                            << ")/" << smaller_dim << ";\n";
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "q = (group_offset+idx+" << i
-                                            << ")%" << smaller_dim << ";"
-                                            << std::endl;
+                                            << ")%" << smaller_dim << ";\n";
               }
               StockhamGenerator::hcKernWrite(transKernel, 6) << "twiddle_factor = TW3step"
-                                          << plHandle << "(p*q" << std::endl;
+                                          << plHandle << "(p*q\n";
               StockhamGenerator::hcKernWrite(transKernel, 9) << ", ";
-              StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << std::endl;
-              StockhamGenerator::hcKernWrite(transKernel, 9) << ");" << std::endl;
+              StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << "\n";
+              StockhamGenerator::hcKernWrite(transKernel, 9) << ");\n";
               if (fwd) {
                 // forward
                 StockhamGenerator::hcKernWrite(transKernel, 3)
@@ -1667,13 +1605,13 @@ hcfftStatus genSwapKernelGeneral(
                     << "].x = inputA_R[inOffset + group_offset+idx+" << i
                     << "] * twiddle_factor.x - inputA_I[inOffset + "
                        "group_offset+idx+"
-                    << i << "] * twiddle_factor.y;" << std::endl;
+                    << i << "] * twiddle_factor.y;\n";
                 StockhamGenerator::hcKernWrite(transKernel, 3)
                     << "nextValue[idx+" << i
                     << "].y = inputA_R[inOffset + group_offset+idx+" << i
                     << "] * twiddle_factor.y + inputA_I[inOffset + "
                        "group_offset+idx+"
-                    << i << "] * twiddle_factor.x;" << std::endl;
+                    << i << "] * twiddle_factor.x;\n";
               } else {
                 // backward
                 StockhamGenerator::hcKernWrite(transKernel, 3)
@@ -1681,53 +1619,47 @@ hcfftStatus genSwapKernelGeneral(
                     << "].x = inputA_R[inOffset + group_offset+idx+" << i
                     << "] * twiddle_factor.x + inputA_I[inOffset + "
                        "group_offset+idx+"
-                    << i << "] * twiddle_factor.y;" << std::endl;
+                    << i << "] * twiddle_factor.y;\n";
                 StockhamGenerator::hcKernWrite(transKernel, 3)
                     << "nextValue[idx+" << i
                     << "].y = inputA_I[inOffset + group_offset+idx+" << i
                     << "] * twiddle_factor.x - inputA_R[inOffset + "
                        "group_offset+idx+"
-                    << i << "] * twiddle_factor.y;" << std::endl;
+                    << i << "] * twiddle_factor.y;\n";
               }
         } else {
               StockhamGenerator::hcKernWrite(transKernel, 6)
                   << "nextValue[idx+" << i
-                  << "].x = inputA_R[inOffset + group_offset+idx+" << i << "];"
-                  << std::endl;
+                  << "].x = inputA_R[inOffset + group_offset+idx+" << i << "];\n";
               StockhamGenerator::hcKernWrite(transKernel, 6)
                   << "nextValue[idx+" << i
-                  << "].y = inputA_I[inOffset + group_offset+idx+" << i << "];"
-                  << std::endl;
+                  << "].y = inputA_I[inOffset + group_offset+idx+" << i << "];\n";
             }
       } else {
             // need to handle boundary
             StockhamGenerator::hcKernWrite(transKernel, 6) << "if(idx+" << i << "<" << LDS_per_WG
-                                        << "){" << std::endl;
+                                        << "){\n";
             if (twiddleSwapKernelIn) {
               if (params.fft_N[0] > params.fft_N[1]) {  // decides whether we
                                                       // have a tall or wide
                                                       // rectangle
                 // input is wide; output is tall; read input index realted
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "p = (group_offset+idx+" << i
-                                            << ")/" << bigger_dim << ";"
-                                            << std::endl;
+                                            << ")/" << bigger_dim << ";\n";
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "q = (group_offset+idx+" << i
-                                            << ")%" << bigger_dim << ";"
-                                            << std::endl;
+                                            << ")%" << bigger_dim << ";\n";
               } else {
                 // input is tall; output is wide; read input index realted
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "p = (group_offset+idx+" << i
-                                            << ")/" << smaller_dim << ";"
-                                            << std::endl;
+                                            << ")/" << smaller_dim << ";\n";
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "q = (group_offset+idx+" << i
-                                            << ")%" << smaller_dim << ";"
-                                            << std::endl;
+                                            << ")%" << smaller_dim << ";\n";
               }
               StockhamGenerator::hcKernWrite(transKernel, 6) << "twiddle_factor = TW3step"
-                                          << plHandle << "(p*q" << std::endl;
+                                          << plHandle << "(p*q\n";
               StockhamGenerator::hcKernWrite(transKernel, 9) << ", ";
-              StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << std::endl;
-              StockhamGenerator::hcKernWrite(transKernel, 9) << ");" << std::endl;
+              StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << "\n";
+              StockhamGenerator::hcKernWrite(transKernel, 9) << ");\n";
               if (fwd) {
                 // forward
                 StockhamGenerator::hcKernWrite(transKernel, 3)
@@ -1735,13 +1667,13 @@ hcfftStatus genSwapKernelGeneral(
                     << "].x = inputA_R[inOffset + group_offset+idx+" << i
                     << "] * twiddle_factor.x - inputA_I[inOffset + "
                        "group_offset+idx+"
-                    << i << "] * twiddle_factor.y;" << std::endl;
+                    << i << "] * twiddle_factor.y;\n";
                 StockhamGenerator::hcKernWrite(transKernel, 3)
                     << "nextValue[idx+" << i
                     << "].y = inputA_R[inOffset + group_offset+idx+" << i
                     << "] * twiddle_factor.y + inputA_I[inOffset + "
                        "group_offset+idx+"
-                    << i << "] * twiddle_factor.x;" << std::endl;
+                    << i << "] * twiddle_factor.x;\n";
               } else {
                 // backward
                 StockhamGenerator::hcKernWrite(transKernel, 3)
@@ -1749,25 +1681,23 @@ hcfftStatus genSwapKernelGeneral(
                     << "].x = inputA_R[inOffset + group_offset+idx+" << i
                     << "] * twiddle_factor.x + inputA_I[inOffset + "
                        "group_offset+idx+"
-                    << i << "] * twiddle_factor.y;" << std::endl;
+                    << i << "] * twiddle_factor.y;\n";
                 StockhamGenerator::hcKernWrite(transKernel, 3)
                     << "nextValue[idx+" << i
                     << "].y = inputA_I[inOffset + group_offset+idx+" << i
                     << "] * twiddle_factor.x - inputA_R[inOffset + "
                        "group_offset+idx+"
-                    << i << "] * twiddle_factor.y;" << std::endl;
+                    << i << "] * twiddle_factor.y;\n";
               }
             } else {
               StockhamGenerator::hcKernWrite(transKernel, 6)
                   << "nextValue[idx+" << i
-                  << "].x = inputA_R[inOffset + group_offset+idx+" << i << "];"
-                  << std::endl;
+                  << "].x = inputA_R[inOffset + group_offset+idx+" << i << "];\n";
               StockhamGenerator::hcKernWrite(transKernel, 6)
                   << "nextValue[idx+" << i
-                  << "].y = inputA_I[inOffset + group_offset+idx+" << i << "];"
-                  << std::endl;
+                  << "].y = inputA_I[inOffset + group_offset+idx+" << i << "];\n";
             }
-            StockhamGenerator::hcKernWrite(transKernel, 6) << "}" << std::endl;
+            StockhamGenerator::hcKernWrite(transKernel, 6) << "}\n";
           }
         }
         break;
@@ -1776,17 +1706,16 @@ hcfftStatus genSwapKernelGeneral(
         return HCFFT_INVALID;
     }
 
-    StockhamGenerator::hcKernWrite(transKernel, 6) << "tidx.barrier.wait();" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 6) << "tidx.barrier.wait();\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
     switch (params.fft_inputLayout) {
       case HCFFT_REAL:  // for real case this is different
       case HCFFT_COMPLEX_INTERLEAVED: {
         if (twiddleSwapKernelOut) {
-          StockhamGenerator::hcKernWrite(transKernel, 6) << "size_t p;" << std::endl;
-          StockhamGenerator::hcKernWrite(transKernel, 6) << "size_t q;" << std::endl;
-          StockhamGenerator::hcKernWrite(transKernel, 6) << dtComplex << " twiddle_factor;"
-                                      << std::endl;
+          StockhamGenerator::hcKernWrite(transKernel, 6) << "size_t p;\n";
+          StockhamGenerator::hcKernWrite(transKernel, 6) << "size_t q;\n";
+          StockhamGenerator::hcKernWrite(transKernel, 6) << dtComplex << " twiddle_factor;\n";
 
           for (size_t i = 0; i < LDS_per_WG; i = i + 256) {
             if (i + 256 < LDS_per_WG) {
@@ -1795,49 +1724,45 @@ hcfftStatus genSwapKernelGeneral(
                                                       // rectangle
                 // input is wide; output is tall
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "p = (group_offset+idx+" << i
-                                            << ")/" << smaller_dim << ";"
-                                            << std::endl;
+                                            << ")/" << smaller_dim << ";\n";
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "q = (group_offset+idx+" << i
-                                            << ")%" << smaller_dim << ";"
-                                            << std::endl;
+                                            << ")%" << smaller_dim << ";\n";
               } else {
                 // input is tall; output is wide
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "p = (group_offset+idx+" << i
-                                            << ")/" << bigger_dim << ";"
-                                            << std::endl;
+                                            << ")/" << bigger_dim << ";\n";
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "q = (group_offset+idx+" << i
-                                            << ")%" << bigger_dim << ";"
-                                            << std::endl;
+                                            << ")%" << bigger_dim << ";\n";
               }
               StockhamGenerator::hcKernWrite(transKernel, 6) << "twiddle_factor = TW3step"
-                                          << plHandle << "(p*q" << std::endl;
+                                          << plHandle << "(p*q\n";
               StockhamGenerator::hcKernWrite(transKernel, 9) << ", ";
-              StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << std::endl;
-              StockhamGenerator::hcKernWrite(transKernel, 9) << ");" << std::endl;
+              StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << "\n";
+              StockhamGenerator::hcKernWrite(transKernel, 9) << ");\n";
               if (fwd) {
                 // forward
                 StockhamGenerator::hcKernWrite(transKernel, 6)
                     << "inputA[inOffset + group_offset+idx+" << i
                     << "].x = prevValue[idx+" << i
                     << "].x * twiddle_factor.x - prevValue[idx+" << i
-                    << "].y * twiddle_factor.y;" << std::endl;
+                    << "].y * twiddle_factor.y;\n";
                 StockhamGenerator::hcKernWrite(transKernel, 6)
                     << "inputA[inOffset + group_offset+idx+" << i
                     << "].y = prevValue[idx+" << i
                     << "].x * twiddle_factor.y + prevValue[idx+" << i
-                    << "].y * twiddle_factor.x;" << std::endl;
+                    << "].y * twiddle_factor.x;\n";
               } else {
                 // backward
                 StockhamGenerator::hcKernWrite(transKernel, 6)
                     << "inputA[inOffset + group_offset+idx+" << i
                     << "].x = prevValue[idx+" << i
                     << "].x * twiddle_factor.x + prevValue[idx+" << i
-                    << "].y * twiddle_factor.y;" << std::endl;
+                    << "].y * twiddle_factor.y;\n";
                 StockhamGenerator::hcKernWrite(transKernel, 6)
                     << "inputA[inOffset + group_offset+idx+" << i
                     << "].y = prevValue[idx+" << i
                     << "].y * twiddle_factor.x - prevValue[idx+" << i
-                    << "].x * twiddle_factor.y;" << std::endl;
+                    << "].x * twiddle_factor.y;\n";
               }
               // StockhamGenerator::hcKernWrite(transKernel, 6) << "inputA[inOffset +
               // group_offset+idx+" << i << "] = prevValue[idx+" << i << "];" <<
@@ -1845,60 +1770,56 @@ hcfftStatus genSwapKernelGeneral(
             } else {
               // need to handle boundary
               StockhamGenerator::hcKernWrite(transKernel, 6) << "if(idx+" << i << "<" << LDS_per_WG
-                                          << "){" << std::endl;
+                                          << "){\n";
               if (params.fft_N[0] > params.fft_N[1])  {  // decides whether we
                                                       // have a tall or wide
                                                       // rectangle
                 // input is wide; output is tall
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "p = (group_offset+idx+" << i
-                                            << ")/" << smaller_dim << ";"
-                                            << std::endl;
+                                            << ")/" << smaller_dim << ";\n";
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "q = (group_offset+idx+" << i
-                                            << ")%" << smaller_dim << ";"
-                                            << std::endl;
+                                            << ")%" << smaller_dim << ";\n";
               } else {
                 // input is tall; output is wide
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "p = (group_offset+idx+" << i
-                                            << ")/" << bigger_dim << ";"
-                                            << std::endl;
+                                            << ")/" << bigger_dim << ";\n";
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "q = (group_offset+idx+" << i
-                                            << ")%" << bigger_dim << ";"
-                                            << std::endl;
+                                            << ")%" << bigger_dim << ";\n";
               }
               StockhamGenerator::hcKernWrite(transKernel, 6) << "twiddle_factor = TW3step"
-                                          << plHandle << "(p*q" << std::endl;
+                                          << plHandle << "(p*q\n";
               StockhamGenerator::hcKernWrite(transKernel, 9) << ", ";
-              StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << std::endl;
-              StockhamGenerator::hcKernWrite(transKernel, 9) << ");" << std::endl;
+              StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << "\n";
+              StockhamGenerator::hcKernWrite(transKernel, 9) << ");\n";
               if (fwd) {
                 // forward
                 StockhamGenerator::hcKernWrite(transKernel, 6)
                     << "inputA[inOffset + group_offset+idx+" << i
                     << "].x = prevValue[idx+" << i
                     << "].x * twiddle_factor.x - prevValue[idx+" << i
-                    << "].y * twiddle_factor.y;" << std::endl;
+                    << "].y * twiddle_factor.y;\n";
                 StockhamGenerator::hcKernWrite(transKernel, 6)
                     << "inputA[inOffset + group_offset+idx+" << i
                     << "].y = prevValue[idx+" << i
                     << "].x * twiddle_factor.y + prevValue[idx+" << i
-                    << "].y * twiddle_factor.x;" << std::endl;
+                    << "].y * twiddle_factor.x;\n";
               } else {
                 // backward
                 StockhamGenerator::hcKernWrite(transKernel, 6)
                     << "inputA[inOffset + group_offset+idx+" << i
                     << "].x = prevValue[idx+" << i
                     << "].x * twiddle_factor.x + prevValue[idx+" << i
-                    << "].y * twiddle_factor.y;" << std::endl;
+                    << "].y * twiddle_factor.y;\n";
                 StockhamGenerator::hcKernWrite(transKernel, 6)
                     << "inputA[inOffset + group_offset+idx+" << i
                     << "].y = prevValue[idx+" << i
                     << "].y * twiddle_factor.x - prevValue[idx+" << i
-                    << "].x * twiddle_factor.y;" << std::endl;
+                    << "].x * twiddle_factor.y;\n";
               }
               // StockhamGenerator::hcKernWrite(transKernel, 9) << "inputA[inOffset +
               // group_offset+idx+" << i << "] = prevValue[idx+" << i << "];" <<
               // std::endl;
-              StockhamGenerator::hcKernWrite(transKernel, 6) << "}" << std::endl;
+              StockhamGenerator::hcKernWrite(transKernel, 6) << "}\n";
             }
           }
         } else if (!twiddleSwapKernelOut)  {  // could be twiddleSwapKernelIn
@@ -1906,15 +1827,15 @@ hcfftStatus genSwapKernelGeneral(
             if (i + 256 < LDS_per_WG) {
               StockhamGenerator::hcKernWrite(transKernel, 6)
                   << "inputA[inOffset + group_offset+idx+" << i
-                  << "] = prevValue[idx+" << i << "];" << std::endl;
+                  << "] = prevValue[idx+" << i << "];\n";
             } else {
               // need to handle boundary
               StockhamGenerator::hcKernWrite(transKernel, 6) << "if(idx+" << i << "<" << LDS_per_WG
-                                          << "){" << std::endl;
+                                          << "){\n";
               StockhamGenerator::hcKernWrite(transKernel, 9)
                   << "inputA[inOffset + group_offset+idx+" << i
-                  << "] = prevValue[idx+" << i << "];" << std::endl;
-              StockhamGenerator::hcKernWrite(transKernel, 6) << "}" << std::endl;
+                  << "] = prevValue[idx+" << i << "];\n";
+              StockhamGenerator::hcKernWrite(transKernel, 6) << "}\n";
             }
           }
         }
@@ -1925,10 +1846,9 @@ hcfftStatus genSwapKernelGeneral(
         return HCFFT_INVALID;
       case HCFFT_COMPLEX_PLANAR: {
         if (twiddleSwapKernelOut) {
-          StockhamGenerator::hcKernWrite(transKernel, 6) << "size_t p;" << std::endl;
-          StockhamGenerator::hcKernWrite(transKernel, 6) << "size_t q;" << std::endl;
-          StockhamGenerator::hcKernWrite(transKernel, 6) << dtComplex << " twiddle_factor;"
-                                      << std::endl;
+          StockhamGenerator::hcKernWrite(transKernel, 6) << "size_t p;\n";
+          StockhamGenerator::hcKernWrite(transKernel, 6) << "size_t q;\n";
+          StockhamGenerator::hcKernWrite(transKernel, 6) << dtComplex << " twiddle_factor;\n";
           for (size_t i = 0; i < LDS_per_WG; i = i + 256) {
             if (i + 256 < LDS_per_WG) {
               if (params.fft_N[0] > params.fft_N[1]) {  // decides whether we
@@ -1936,127 +1856,119 @@ hcfftStatus genSwapKernelGeneral(
                                                       // rectangle
                 // input is wide; output is tall
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "p = (group_offset+idx+" << i
-                                            << ")/" << smaller_dim << ";"
-                                            << std::endl;
+                                            << ")/" << smaller_dim << ";\n";
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "q = (group_offset+idx+" << i
-                                            << ")%" << smaller_dim << ";"
-                                            << std::endl;
+                                            << ")%" << smaller_dim << ";\n";
               } else {
                 // input is tall; output is wide
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "p = (group_offset+idx+" << i
-                                            << ")/" << bigger_dim << ";"
-                                            << std::endl;
+                                            << ")/" << bigger_dim << ";\n";
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "q = (group_offset+idx+" << i
-                                            << ")%" << bigger_dim << ";"
-                                            << std::endl;
+                                            << ")%" << bigger_dim << ";\n";
               }
               StockhamGenerator::hcKernWrite(transKernel, 6) << "twiddle_factor = TW3step"
-                                          << plHandle << "(p*q" << std::endl;
+                                          << plHandle << "(p*q\n";
               StockhamGenerator::hcKernWrite(transKernel, 9) << ", ";
-              StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << std::endl;
-              StockhamGenerator::hcKernWrite(transKernel, 9) << ");" << std::endl;
+              StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << "\n";
+              StockhamGenerator::hcKernWrite(transKernel, 9) << ");\n";
               if (fwd) {
                 // forward
                 StockhamGenerator::hcKernWrite(transKernel, 6)
                     << "inputA_R[inOffset + group_offset+idx+" << i
                     << "] = prevValue[idx+" << i
                     << "].x * twiddle_factor.x - prevValue[idx+" << i
-                    << "].y * twiddle_factor.y;" << std::endl;
+                    << "].y * twiddle_factor.y;\n";
                 StockhamGenerator::hcKernWrite(transKernel, 6)
                     << "inputA_I[inOffset + group_offset+idx+" << i
                     << "] = prevValue[idx+" << i
                     << "].x * twiddle_factor.y + prevValue[idx+" << i
-                    << "].y * twiddle_factor.x;" << std::endl;
+                    << "].y * twiddle_factor.x;\n";
               } else {
                 // backward
                 StockhamGenerator::hcKernWrite(transKernel, 6)
                     << "inputA_R[inOffset + group_offset+idx+" << i
                     << "] = prevValue[idx+" << i
                     << "].x * twiddle_factor.x + prevValue[idx+" << i
-                    << "].y * twiddle_factor.y;" << std::endl;
+                    << "].y * twiddle_factor.y;\n";
                 StockhamGenerator::hcKernWrite(transKernel, 6)
                     << "inputA_I[inOffset + group_offset+idx+" << i
                     << "] = prevValue[idx+" << i
                     << "].y * twiddle_factor.x - prevValue[idx+" << i
-                    << "].x * twiddle_factor.y;" << std::endl;
+                    << "].x * twiddle_factor.y;\n";
               }
             } else {
               // need to handle boundary
               StockhamGenerator::hcKernWrite(transKernel, 6) << "if(idx+" << i << "<" << LDS_per_WG
-                                          << "){" << std::endl;
+                                          << "){\n";
               if (params.fft_N[0] > params.fft_N[1]) {  // decides whether we
                                                       // have a tall or wide
                                                       // rectangle
                 // input is wide; output is tall
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "p = (group_offset+idx+" << i
-                                            << ")/" << smaller_dim << ";"
-                                            << std::endl;
+                                            << ")/" << smaller_dim << ";\n";
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "q = (group_offset+idx+" << i
-                                            << ")%" << smaller_dim << ";"
-                                            << std::endl;
+                                            << ")%" << smaller_dim << ";\n";
               } else {
                 // input is tall; output is wide
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "p = (group_offset+idx+" << i
-                                            << ")/" << bigger_dim << ";"
-                                            << std::endl;
+                                            << ")/" << bigger_dim << ";\n";
                 StockhamGenerator::hcKernWrite(transKernel, 6) << "q = (group_offset+idx+" << i
-                                            << ")%" << bigger_dim << ";"
-                                            << std::endl;
+                                            << ")%" << bigger_dim << ";\n";
               }
               StockhamGenerator::hcKernWrite(transKernel, 6) << "twiddle_factor = TW3step"
-                                          << plHandle << "(p*q" << std::endl;
+                                          << plHandle << "(p*q\n";
               StockhamGenerator::hcKernWrite(transKernel, 9) << ", ";
-              StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << std::endl;
-              StockhamGenerator::hcKernWrite(transKernel, 9) << ");" << std::endl;
+              StockhamGenerator::hcKernWrite(transKernel, 9) << StockhamGenerator::TwTableLargeName() << "\n";
+              StockhamGenerator::hcKernWrite(transKernel, 9) << ");\n";
               if (fwd) {
                 // forward
                 StockhamGenerator::hcKernWrite(transKernel, 6)
                     << "inputA_R[inOffset + group_offset+idx+" << i
                     << "] = prevValue[idx+" << i
                     << "].x * twiddle_factor.x - prevValue[idx+" << i
-                    << "].y * twiddle_factor.y;" << std::endl;
+                    << "].y * twiddle_factor.y;\n";
                 StockhamGenerator::hcKernWrite(transKernel, 6)
                     << "inputA_I[inOffset + group_offset+idx+" << i
                     << "] = prevValue[idx+" << i
                     << "].x * twiddle_factor.y + prevValue[idx+" << i
-                    << "].y * twiddle_factor.x;" << std::endl;
+                    << "].y * twiddle_factor.x;\n";
               } else {
                 // backward
                 StockhamGenerator::hcKernWrite(transKernel, 6)
                     << "inputA_R[inOffset + group_offset+idx+" << i
                     << "] = prevValue[idx+" << i
                     << "].x * twiddle_factor.x + prevValue[idx+" << i
-                    << "].y * twiddle_factor.y;" << std::endl;
+                    << "].y * twiddle_factor.y;\n";
                 StockhamGenerator::hcKernWrite(transKernel, 6)
                     << "inputA_I[inOffset + group_offset+idx+" << i
                     << "] = prevValue[idx+" << i
                     << "].y * twiddle_factor.x - prevValue[idx+" << i
-                    << "].x * twiddle_factor.y;" << std::endl;
+                    << "].x * twiddle_factor.y;\n";
               }
-              StockhamGenerator::hcKernWrite(transKernel, 6) << "}" << std::endl;
+              StockhamGenerator::hcKernWrite(transKernel, 6) << "}\n";
             }
-            StockhamGenerator::hcKernWrite(transKernel, 3) << std::endl;
+            StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
           }
         } else if (!twiddleSwapKernelOut) {  // could be twiddleSwapKernelIn
           for (size_t i = 0; i < LDS_per_WG; i = i + 256) {
             if (i + 256 < LDS_per_WG) {
               StockhamGenerator::hcKernWrite(transKernel, 6)
                   << "inputA_R[inOffset + group_offset+idx+" << i
-                  << "] = prevValue[idx+" << i << "].x;" << std::endl;
+                  << "] = prevValue[idx+" << i << "].x;\n";
               StockhamGenerator::hcKernWrite(transKernel, 6)
                   << "inputA_I[inOffset + group_offset+idx+" << i
-                  << "] = prevValue[idx+" << i << "].y;" << std::endl;
+                  << "] = prevValue[idx+" << i << "].y;\n";
             } else {
               // need to handle boundary
               StockhamGenerator::hcKernWrite(transKernel, 6) << "if(idx+" << i << "<" << LDS_per_WG
-                                          << "){" << std::endl;
+                                          << "){\n";
               StockhamGenerator::hcKernWrite(transKernel, 6)
                   << "inputA_R[inOffset + group_offset+idx+" << i
-                  << "] = prevValue[idx+" << i << "].x;" << std::endl;
+                  << "] = prevValue[idx+" << i << "].x;\n";
               StockhamGenerator::hcKernWrite(transKernel, 6)
                   << "inputA_I[inOffset + group_offset+idx+" << i
-                  << "] = prevValue[idx+" << i << "].y;" << std::endl;
-              StockhamGenerator::hcKernWrite(transKernel, 6) << "}" << std::endl;
+                  << "] = prevValue[idx+" << i << "].y;\n";
+              StockhamGenerator::hcKernWrite(transKernel, 6) << "}\n";
             }
           }
         }
@@ -2065,9 +1977,9 @@ hcfftStatus genSwapKernelGeneral(
       default:
         return HCFFT_INVALID;
     }
-    StockhamGenerator::hcKernWrite(transKernel, 6) << "tidx.barrier.wait();" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 6) << "tidx.barrier.wait();\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
     switch (params.fft_inputLayout) {
       case HCFFT_REAL:
       case HCFFT_COMPLEX_INTERLEAVED:
@@ -2075,16 +1987,14 @@ hcfftStatus genSwapKernelGeneral(
         for (size_t i = 0; i < LDS_per_WG; i = i + 256) {
           if (i + 256 < LDS_per_WG) {
             StockhamGenerator::hcKernWrite(transKernel, 6) << "prevValue[idx+" << i
-                                        << "] = nextValue[idx+" << i << "];"
-                                        << std::endl;
+                                        << "] = nextValue[idx+" << i << "];\n";
           } else {
             // need to handle boundary
             StockhamGenerator::hcKernWrite(transKernel, 6) << "if(idx+" << i << "<" << LDS_per_WG
-                                        << "){" << std::endl;
+                                        << "){\n";
             StockhamGenerator::hcKernWrite(transKernel, 9) << "prevValue[idx + " << i
-                                        << "] = nextValue[idx + " << i << "]; "
-                                        << std::endl;
-            StockhamGenerator::hcKernWrite(transKernel, 6) << "}" << std::endl;
+                                        << "] = nextValue[idx + " << i << "]; \n";
+            StockhamGenerator::hcKernWrite(transKernel, 6) << "}\n";
           }
         }
         break;
@@ -2096,19 +2006,16 @@ hcfftStatus genSwapKernelGeneral(
         return HCFFT_INVALID;
     }
 
-    StockhamGenerator::hcKernWrite(transKernel, 6) << "tidx.barrier.wait();" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 6) << "tidx.barrier.wait();\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "prev = next;" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "prev = next;\n";
     if (WG_per_line == 1)
-      StockhamGenerator::hcKernWrite(transKernel, 3) << "}while(next!=swap_table[group_id][0]);"
-                                  << std::endl;  // end of do-while
+      StockhamGenerator::hcKernWrite(transKernel, 3) << "}while(next!=swap_table[group_id][0]);\n";  // end of do-while
     else
       StockhamGenerator::hcKernWrite(transKernel, 3) << "}while(next!=swap_table[group_id/"
-                                  << WG_per_line << "][0]);"
-                                  << std::endl;  // end of do-while
-    StockhamGenerator::hcKernWrite(transKernel, 0) << "}).wait();\n}}\n"
-                                << std::endl;  // end of kernel
+                                  << WG_per_line << "][0]);\n";  // end of do-while
+    StockhamGenerator::hcKernWrite(transKernel, 0) << "}).wait();\n}}\n\n";  // end of kernel
 
     if (!twiddleSwapKernel)
       break;  // break for bothDir only need one kernel if twiddle is not done
@@ -2136,7 +2043,7 @@ hcfftStatus genTransposeKernelBatched(
     std::vector<size_t> gWorkSize, std::vector<size_t> lWorkSize,
     size_t count) {
   strKernel.reserve(4096);
-  std::stringstream transKernel(std::stringstream::out);
+  CodeEmitter transKernel;
 
   // These strings represent the various data types we read or write in the
   // kernel, depending on how the plan
@@ -2171,7 +2078,7 @@ hcfftStatus genTransposeKernelBatched(
   // If twiddle computation has been requested, generate the lookup function
 
   if (twiddleTransposeKernel) {
-    std::string str;
+    CodeEmitter str;
     if (params.fft_precision == HCFFT_SINGLE) {
       StockhamGenerator::TwiddleTableLarge<hc::short_vector::float_2,
                                            StockhamGenerator::P_SINGLE>
@@ -2185,8 +2092,8 @@ hcfftStatus genTransposeKernelBatched(
       twLarge.GenerateTwiddleTable(str, plHandle);
       twLarge.TwiddleLargeAV((void**)&twiddleslarge, acc);
     }
-    StockhamGenerator::hcKernWrite(transKernel, 0) << str << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 0) << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 0) << str.str() << "\n";
+    StockhamGenerator::hcKernWrite(transKernel, 0) << "\n";
   }
 
   // This detects whether the input matrix is square
@@ -2232,16 +2139,16 @@ hcfftStatus genTransposeKernelBatched(
       wgPerBatch = (params.fft_N[0] / (16 * reShapeFactor) + 1) *
                    (params.fft_N[0] / (16 * reShapeFactor) + 1 + 1) / 2;
     StockhamGenerator::hcKernWrite(transKernel, 3) << "const size_t numGroupsY_1 = " << wgPerBatch
-                                << ";" << std::endl;
+                                << ";\n";
 
     for (size_t i = 2; i < params.fft_DataDim - 1; i++) {
       StockhamGenerator::hcKernWrite(transKernel, 3) << "const size_t numGroupsY_" << i
                                   << " = numGroupsY_" << i - 1 << " * "
-                                  << params.fft_N[i] << ";" << std::endl;
+                                  << params.fft_N[i] << ";\n";
     }
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t g_index;" << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 3) << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t g_index;\n";
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
 
     OffsetCalculation(transKernel, params, true);
 
@@ -2251,14 +2158,11 @@ hcfftStatus genTransposeKernelBatched(
     if (params.fft_placeness == HCFFT_INPLACE) {
       switch (params.fft_inputLayout) {
         case HCFFT_COMPLEX_INTERLEAVED:
-          StockhamGenerator::hcKernWrite(transKernel, 3) << dtInput << " *outputA = inputA;"
-                                      << std::endl;
+          StockhamGenerator::hcKernWrite(transKernel, 3) << dtInput << " *outputA = inputA;\n";
           break;
         case HCFFT_COMPLEX_PLANAR:
-          StockhamGenerator::hcKernWrite(transKernel, 3) << dtInput << " *outputA_R = inputA_R;"
-                                      << std::endl;
-          StockhamGenerator::hcKernWrite(transKernel, 3) << dtInput << " *outputA_I = inputA_I;"
-                                      << std::endl;
+          StockhamGenerator::hcKernWrite(transKernel, 3) << dtInput << " *outputA_R = inputA_R;\n";
+          StockhamGenerator::hcKernWrite(transKernel, 3) << dtInput << " *outputA_I = inputA_I;\n";
           break;
         case HCFFT_HERMITIAN_INTERLEAVED:
         case HCFFT_HERMITIAN_PLANAR:
@@ -2270,7 +2174,7 @@ hcfftStatus genTransposeKernelBatched(
       }
     }
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
 
     // Now compute the corresponding y,x coordinates
     // for a triangular indexing
@@ -2280,7 +2184,7 @@ hcfftStatus genTransposeKernelBatched(
           << "+sqrt(("
           << 4.0f * params.fft_N[0] / 16 / reShapeFactor *
                  (params.fft_N[0] / 16 / reShapeFactor + 1)
-          << "-8.0f*g_index- 7)))/ (-2.0f);" << std::endl;
+          << "-8.0f*g_index- 7)))/ (-2.0f);\n";
     else
       StockhamGenerator::hcKernWrite(transKernel, 3)
           << "float row = ("
@@ -2288,71 +2192,64 @@ hcfftStatus genTransposeKernelBatched(
           << "+sqrt(("
           << 4.0f * (params.fft_N[0] / (16 * reShapeFactor) + 1) *
                  (params.fft_N[0] / (16 * reShapeFactor) + 1 + 1)
-          << "-8.0f*g_index- 7)))/ (-2.0f);" << std::endl;
+          << "-8.0f*g_index- 7)))/ (-2.0f);\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "if (row == (float)(size_t)row) row -= 1; "
-                                << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "const size_t t_gy = (size_t)row;"
-                                << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "if (row == (float)(size_t)row) row -= 1; \n";
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "const size_t t_gy = (size_t)row;\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
 
     if (mult_of_16)
       StockhamGenerator::hcKernWrite(transKernel, 3) << "const long t_gx_p = g_index - "
                                   << (params.fft_N[0] / 16 / reShapeFactor)
-                                  << "*t_gy + t_gy*(t_gy + 1) / 2;"
-                                  << std::endl;
+                                  << "*t_gy + t_gy*(t_gy + 1) / 2;\n";
     else
       StockhamGenerator::hcKernWrite(transKernel, 3)
           << "const long t_gx_p = g_index - "
           << (params.fft_N[0] / (16 * reShapeFactor) + 1)
-          << "*t_gy + t_gy*(t_gy + 1) / 2;" << std::endl;
+          << "*t_gy + t_gy*(t_gy + 1) / 2;\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "const long t_gy_p = t_gx_p - t_gy;"
-                                << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "const long t_gy_p = t_gx_p - t_gy;\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "const size_t d_lidx = tidx.local[0] % 16;"
-                                << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "const size_t d_lidy = tidx.local[0] / 16;"
-                                << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "const size_t d_lidx = tidx.local[0] % 16;\n";
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "const size_t d_lidy = tidx.local[0] / 16;\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
 
     StockhamGenerator::hcKernWrite(transKernel, 3)
         << "const size_t lidy = (d_lidy * 16 + d_lidx) /"
-        << (16 * reShapeFactor) << ";" << std::endl;
+        << (16 * reShapeFactor) << ";\n";
     StockhamGenerator::hcKernWrite(transKernel, 3)
         << "const size_t lidx = (d_lidy * 16 + d_lidx) %"
-        << (16 * reShapeFactor) << ";" << std::endl;
+        << (16 * reShapeFactor) << ";\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
 
     StockhamGenerator::hcKernWrite(transKernel, 3) << "const size_t idx = lidx + t_gx_p*"
-                                << 16 * reShapeFactor << ";" << std::endl;
+                                << 16 * reShapeFactor << ";\n";
     StockhamGenerator::hcKernWrite(transKernel, 3) << "const size_t idy = lidy + t_gy_p*"
-                                << 16 * reShapeFactor << ";" << std::endl;
+                                << 16 * reShapeFactor << ";\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
 
     StockhamGenerator::hcKernWrite(transKernel, 3) << "const size_t starting_index_yx = t_gy_p*"
                                 << 16 * reShapeFactor << " + t_gx_p*"
-                                << 16 * reShapeFactor * params.fft_N[0] << ";"
-                                << std::endl;
+                                << 16 * reShapeFactor * params.fft_N[0] << ";\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
 
     StockhamGenerator::hcKernWrite(transKernel, 3) << "tile_static " << dtComplex << " xy_s["
                                 << 16 * reShapeFactor * 16 * reShapeFactor
-                                << "];" << std::endl;
+                                << "];\n";
     StockhamGenerator::hcKernWrite(transKernel, 3) << "tile_static " << dtComplex << " yx_s["
                                 << 16 * reShapeFactor * 16 * reShapeFactor
-                                << "];" << std::endl;
+                                << "];\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << dtComplex << " tmpm, tmpt;" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << dtComplex << " tmpm, tmpt;\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
 
     // Step 1: Load both blocks into local memory
     // Here I load inputA for both blocks contiguously and write it contigously
@@ -2363,44 +2260,41 @@ hcfftStatus genTransposeKernelBatched(
     // back into the arrays
 
     if (mult_of_16) {
-      StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t index;" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t index;\n";
       StockhamGenerator::hcKernWrite(transKernel, 3) << "for (size_t loop = 0; loop<"
                                   << reShapeFactor * reShapeFactor
-                                  << "; ++loop){" << std::endl;
+                                  << "; ++loop){\n";
       StockhamGenerator::hcKernWrite(transKernel, 6) << "index = lidy*" << 16 * reShapeFactor
-                                  << " + lidx + loop*256;" << std::endl;
+                                  << " + lidx + loop*256;\n";
 
       // Handle planar and interleaved right here
       switch (params.fft_inputLayout) {
         case HCFFT_COMPLEX_INTERLEAVED: {
           StockhamGenerator::hcKernWrite(transKernel, 6)
               << "tmpm = inputA[iOffset + (idy + loop *" << 16 / reShapeFactor
-              << ")*" << params.fft_N[0] << " + idx];" << std::endl;
+              << ")*" << params.fft_N[0] << " + idx];\n";
           StockhamGenerator::hcKernWrite(transKernel, 6)
               << "tmpt = inputA[iOffset + (lidy + loop *" << 16 / reShapeFactor
-              << ")*" << params.fft_N[0] << " + lidx + starting_index_yx];"
-              << std::endl;
+              << ")*" << params.fft_N[0] << " + lidx + starting_index_yx];\n";
         } break;
         case HCFFT_COMPLEX_PLANAR:
           dtInput = dtPlanar;
           dtOutput = dtPlanar;
           StockhamGenerator::hcKernWrite(transKernel, 6)
               << "tmpm.x = inputA_R[iOffset + (idy + loop *"
-              << 16 / reShapeFactor << ")*" << params.fft_N[0] << " + idx];"
-              << std::endl;
+              << 16 / reShapeFactor << ")*" << params.fft_N[0] << " + idx];\n";
           StockhamGenerator::hcKernWrite(transKernel, 6)
               << "tmpm.y = inputA_I[iOffset + (idy + loop *"
-              << 16 / reShapeFactor << ")*" << params.fft_N[0] << " + idx];"
-              << std::endl;
+              << 16 / reShapeFactor << ")*" << params.fft_N[0] << " + idx];\n";
 
           StockhamGenerator::hcKernWrite(transKernel, 6)
               << "tmpt.x = inputA_R[iOffset + (lidy + loop *"
               << 16 / reShapeFactor << ")*" << params.fft_N[0]
-              << " + lidx + starting_index_yx];" << std::endl;
+              << " + lidx + starting_index_yx];\n";
           StockhamGenerator::hcKernWrite(transKernel, 6)
               << "tmpt.y = inputA_I[iOffset + (lidy + loop *"
               << 16 / reShapeFactor << ")*" << params.fft_N[0]
-              << " + lidx + starting_index_yx];" << std::endl;
+              << " + lidx + starting_index_yx];\n";
           break;
         case HCFFT_HERMITIAN_INTERLEAVED:
         case HCFFT_HERMITIAN_PLANAR:
@@ -2416,54 +2310,51 @@ hcfftStatus genTransposeKernelBatched(
       if (twiddleTransposeKernel)
         genTwiddleMath(plHandle, params, transKernel, dtComplex, fwd);
 
-      StockhamGenerator::hcKernWrite(transKernel, 6) << "xy_s[index] = tmpm; " << std::endl;
-      StockhamGenerator::hcKernWrite(transKernel, 6) << "yx_s[index] = tmpt; " << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 6) << "xy_s[index] = tmpm; \n";
+      StockhamGenerator::hcKernWrite(transKernel, 6) << "yx_s[index] = tmpt; \n";
 
-      StockhamGenerator::hcKernWrite(transKernel, 3) << "}" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 3) << "}\n";
 
-      StockhamGenerator::hcKernWrite(transKernel, 3) << "" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
 
-      StockhamGenerator::hcKernWrite(transKernel, 3) << "tidx.barrier.wait();" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 3) << "tidx.barrier.wait();\n";
 
-      StockhamGenerator::hcKernWrite(transKernel, 3) << "" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
 
       // Step2: Write from shared to global
       StockhamGenerator::hcKernWrite(transKernel, 3) << "for (size_t loop = 0; loop<"
                                   << reShapeFactor * reShapeFactor
-                                  << "; ++loop){" << std::endl;
+                                  << "; ++loop){\n";
       StockhamGenerator::hcKernWrite(transKernel, 6) << "index = lidx*" << 16 * reShapeFactor
                                   << " + lidy + " << 16 / reShapeFactor
-                                  << "*loop;" << std::endl;
+                                  << "*loop;\n";
 
       // Handle planar and interleaved right here
       switch (params.fft_outputLayout) {
         case HCFFT_COMPLEX_INTERLEAVED:
           StockhamGenerator::hcKernWrite(transKernel, 6)
               << "outputA[iOffset + (idy + loop*" << 16 / reShapeFactor << ")*"
-              << params.fft_N[0] << " + idx] = yx_s[index];" << std::endl;
+              << params.fft_N[0] << " + idx] = yx_s[index];\n";
           StockhamGenerator::hcKernWrite(transKernel, 6)
               << "outputA[iOffset + (lidy + loop*" << 16 / reShapeFactor << ")*"
-              << params.fft_N[0] << " + lidx+ starting_index_yx] = xy_s[index];"
-              << std::endl;
+              << params.fft_N[0] << " + lidx+ starting_index_yx] = xy_s[index];\n";
           break;
         case HCFFT_COMPLEX_PLANAR:
           StockhamGenerator::hcKernWrite(transKernel, 6)
               << "outputA_R[iOffset + (idy + loop*" << 16 / reShapeFactor
-              << ")*" << params.fft_N[0] << " + idx] = yx_s[index].x;"
-              << std::endl;
+              << ")*" << params.fft_N[0] << " + idx] = yx_s[index].x;\n";
           StockhamGenerator::hcKernWrite(transKernel, 6)
               << "outputA_I[iOffset + (idy + loop*" << 16 / reShapeFactor
-              << ")*" << params.fft_N[0] << " + idx] = yx_s[index].y;"
-              << std::endl;
+              << ")*" << params.fft_N[0] << " + idx] = yx_s[index].y;\n";
 
           StockhamGenerator::hcKernWrite(transKernel, 6)
               << "outputA_R[iOffset + (lidy + loop*" << 16 / reShapeFactor
               << ")*" << params.fft_N[0]
-              << " + lidx+ starting_index_yx] = xy_s[index].x;" << std::endl;
+              << " + lidx+ starting_index_yx] = xy_s[index].x;\n";
           StockhamGenerator::hcKernWrite(transKernel, 6)
               << "outputA_I[iOffset + (lidy + loop*" << 16 / reShapeFactor
               << ")*" << params.fft_N[0]
-              << " + lidx+ starting_index_yx] = xy_s[index].y;" << std::endl;
+              << " + lidx+ starting_index_yx] = xy_s[index].y;\n";
           break;
         case HCFFT_HERMITIAN_INTERLEAVED:
         case HCFFT_HERMITIAN_PLANAR:
@@ -2474,49 +2365,46 @@ hcfftStatus genTransposeKernelBatched(
           return HCFFT_INVALID;
       }
 
-      StockhamGenerator::hcKernWrite(transKernel, 3) << "}" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 3) << "}\n";
     } else {  // mult_of_16
-      StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t index;" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t index;\n";
       StockhamGenerator::hcKernWrite(transKernel, 3) << "if (" << params.fft_N[0]
                                   << " - (t_gx_p + 1) *" << 16 * reShapeFactor
-                                  << ">0){" << std::endl;
+                                  << ">0){\n";
       StockhamGenerator::hcKernWrite(transKernel, 6) << "for (size_t loop = 0; loop<"
                                   << reShapeFactor * reShapeFactor
-                                  << "; ++loop){" << std::endl;
+                                  << "; ++loop){\n";
       StockhamGenerator::hcKernWrite(transKernel, 9) << "index = lidy*" << 16 * reShapeFactor
-                                  << " + lidx + loop*256;" << std::endl;
+                                  << " + lidx + loop*256;\n";
 
       // Handle planar and interleaved right here
       switch (params.fft_inputLayout) {
         case HCFFT_COMPLEX_INTERLEAVED:
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "tmpm = inputA[iOffset + (idy + loop*" << 16 / reShapeFactor
-              << ")*" << params.fft_N[0] << " + idx];" << std::endl;
+              << ")*" << params.fft_N[0] << " + idx];\n";
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "tmpt = inputA[iOffset + (lidy + loop*" << 16 / reShapeFactor
-              << ")*" << params.fft_N[0] << " + lidx + starting_index_yx];"
-              << std::endl;
+              << ")*" << params.fft_N[0] << " + lidx + starting_index_yx];\n";
           break;
         case HCFFT_COMPLEX_PLANAR:
           dtInput = dtPlanar;
           dtOutput = dtPlanar;
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "tmpm.x = inputA_R[iOffset + (idy + loop*"
-              << 16 / reShapeFactor << ")*" << params.fft_N[0] << " + idx];"
-              << std::endl;
+              << 16 / reShapeFactor << ")*" << params.fft_N[0] << " + idx];\n";
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "tmpm.y = inputA_I[iOffset + (idy + loop*"
-              << 16 / reShapeFactor << ")*" << params.fft_N[0] << " + idx];"
-              << std::endl;
+              << 16 / reShapeFactor << ")*" << params.fft_N[0] << " + idx];\n";
 
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "tmpt.x = inputA_R[iOffset + (lidy + loop*"
               << 16 / reShapeFactor << ")*" << params.fft_N[0]
-              << " + lidx + starting_index_yx];" << std::endl;
+              << " + lidx + starting_index_yx];\n";
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "tmpt.y = inputA_I[iOffset + (lidy + loop*"
               << 16 / reShapeFactor << ")*" << params.fft_N[0]
-              << " + lidx + starting_index_yx];" << std::endl;
+              << " + lidx + starting_index_yx];\n";
           break;
         case HCFFT_HERMITIAN_INTERLEAVED:
         case HCFFT_HERMITIAN_PLANAR:
@@ -2532,66 +2420,61 @@ hcfftStatus genTransposeKernelBatched(
       if (twiddleTransposeKernel)
         genTwiddleMath(plHandle, params, transKernel, dtComplex, fwd);
 
-      StockhamGenerator::hcKernWrite(transKernel, 9) << "xy_s[index] = tmpm;" << std::endl;
-      StockhamGenerator::hcKernWrite(transKernel, 9) << "yx_s[index] = tmpt;" << std::endl;
-      StockhamGenerator::hcKernWrite(transKernel, 6) << "}" << std::endl;
-      StockhamGenerator::hcKernWrite(transKernel, 3) << "}" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 9) << "xy_s[index] = tmpm;\n";
+      StockhamGenerator::hcKernWrite(transKernel, 9) << "yx_s[index] = tmpt;\n";
+      StockhamGenerator::hcKernWrite(transKernel, 6) << "}\n";
+      StockhamGenerator::hcKernWrite(transKernel, 3) << "}\n";
 
-      StockhamGenerator::hcKernWrite(transKernel, 3) << "else{" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 3) << "else{\n";
       StockhamGenerator::hcKernWrite(transKernel, 6) << "for (size_t loop = 0; loop<"
                                   << reShapeFactor * reShapeFactor
-                                  << "; ++loop){" << std::endl;
+                                  << "; ++loop){\n";
       StockhamGenerator::hcKernWrite(transKernel, 9) << "index = lidy*" << 16 * reShapeFactor
-                                  << " + lidx + loop*256;" << std::endl;
+                                  << " + lidx + loop*256;\n";
 
       // Handle planar and interleaved right here
       switch (params.fft_inputLayout) {
         case HCFFT_COMPLEX_INTERLEAVED:
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "if ((idy + loop*" << 16 / reShapeFactor << ")<"
-              << params.fft_N[0] << "&& idx<" << params.fft_N[0] << ")"
-              << std::endl;
+              << params.fft_N[0] << "&& idx<" << params.fft_N[0] << ")\n";
           StockhamGenerator::hcKernWrite(transKernel, 12)
               << "tmpm = inputA[iOffset + (idy + loop*" << 16 / reShapeFactor
-              << ")*" << params.fft_N[0] << " + idx];" << std::endl;
+              << ")*" << params.fft_N[0] << " + idx];\n";
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "if ((t_gy_p *" << 16 * reShapeFactor << " + lidx)<"
               << params.fft_N[0] << " && (t_gx_p * " << 16 * reShapeFactor
               << " + lidy + loop*" << 16 / reShapeFactor << ")<"
-              << params.fft_N[0] << ") " << std::endl;
+              << params.fft_N[0] << ") \n";
           StockhamGenerator::hcKernWrite(transKernel, 12)
               << "tmpt = inputA[iOffset + (lidy + loop*" << 16 / reShapeFactor
-              << ")*" << params.fft_N[0] << " + lidx + starting_index_yx];"
-              << std::endl;
+              << ")*" << params.fft_N[0] << " + lidx + starting_index_yx];\n";
           break;
         case HCFFT_COMPLEX_PLANAR:
           dtInput = dtPlanar;
           dtOutput = dtPlanar;
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "if ((idy + loop*" << 16 / reShapeFactor << ")<"
-              << params.fft_N[0] << "&& idx<" << params.fft_N[0] << ") {"
-              << std::endl;
+              << params.fft_N[0] << "&& idx<" << params.fft_N[0] << ") {\n";
           StockhamGenerator::hcKernWrite(transKernel, 12)
               << "tmpm.x = inputA_R[iOffset + (idy + loop*"
-              << 16 / reShapeFactor << ")*" << params.fft_N[0] << " + idx];"
-              << std::endl;
+              << 16 / reShapeFactor << ")*" << params.fft_N[0] << " + idx];\n";
           StockhamGenerator::hcKernWrite(transKernel, 12)
               << "tmpm.y = inputA_I[iOffset + (idy + loop*"
-              << 16 / reShapeFactor << ")*" << params.fft_N[0] << " + idx]; }"
-              << std::endl;
+              << 16 / reShapeFactor << ")*" << params.fft_N[0] << " + idx]; }\n";
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "if ((t_gy_p *" << 16 * reShapeFactor << " + lidx)<"
               << params.fft_N[0] << " && (t_gx_p * " << 16 * reShapeFactor
               << " + lidy + loop*" << 16 / reShapeFactor << ")<"
-              << params.fft_N[0] << ") {" << std::endl;
+              << params.fft_N[0] << ") {\n";
           StockhamGenerator::hcKernWrite(transKernel, 12)
               << "tmpt.x = inputA_R[iOffset + (lidy + loop*"
               << 16 / reShapeFactor << ")*" << params.fft_N[0]
-              << " + lidx + starting_index_yx];" << std::endl;
+              << " + lidx + starting_index_yx];\n";
           StockhamGenerator::hcKernWrite(transKernel, 12)
               << "tmpt.y = inputA_I[iOffset + (lidy + loop*"
               << 16 / reShapeFactor << ")*" << params.fft_N[0]
-              << " + lidx + starting_index_yx]; }" << std::endl;
+              << " + lidx + starting_index_yx]; }\n";
           break;
         case HCFFT_HERMITIAN_INTERLEAVED:
         case HCFFT_HERMITIAN_PLANAR:
@@ -2606,56 +2489,54 @@ hcfftStatus genTransposeKernelBatched(
       if (twiddleTransposeKernel)
         genTwiddleMath(plHandle, params, transKernel, dtComplex, fwd);
 
-      StockhamGenerator::hcKernWrite(transKernel, 9) << "xy_s[index] = tmpm;" << std::endl;
-      StockhamGenerator::hcKernWrite(transKernel, 9) << "yx_s[index] = tmpt;" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 9) << "xy_s[index] = tmpm;\n";
+      StockhamGenerator::hcKernWrite(transKernel, 9) << "yx_s[index] = tmpt;\n";
 
-      StockhamGenerator::hcKernWrite(transKernel, 9) << "}" << std::endl;
-      StockhamGenerator::hcKernWrite(transKernel, 3) << "}" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 9) << "}\n";
+      StockhamGenerator::hcKernWrite(transKernel, 3) << "}\n";
 
-      StockhamGenerator::hcKernWrite(transKernel, 3) << "" << std::endl;
-      StockhamGenerator::hcKernWrite(transKernel, 3) << "tidx.barrier.wait();" << std::endl;
-      StockhamGenerator::hcKernWrite(transKernel, 3) << "" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
+      StockhamGenerator::hcKernWrite(transKernel, 3) << "tidx.barrier.wait();\n";
+      StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
 
       // Step2: Write from shared to global
 
       StockhamGenerator::hcKernWrite(transKernel, 3) << "if (" << params.fft_N[0]
                                   << " - (t_gx_p + 1) *" << 16 * reShapeFactor
-                                  << ">0){" << std::endl;
+                                  << ">0){\n";
       StockhamGenerator::hcKernWrite(transKernel, 6) << "for (size_t loop = 0; loop<"
                                   << reShapeFactor * reShapeFactor
-                                  << "; ++loop){" << std::endl;
+                                  << "; ++loop){\n";
       StockhamGenerator::hcKernWrite(transKernel, 9) << "index = lidx*" << 16 * reShapeFactor
                                   << " + lidy + " << 16 / reShapeFactor
-                                  << "*loop ;" << std::endl;
+                                  << "*loop ;\n";
 
       // Handle planar and interleaved right here
       switch (params.fft_outputLayout) {
         case HCFFT_COMPLEX_INTERLEAVED:
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "outputA[iOffset + (idy + loop*" << 16 / reShapeFactor << ")*"
-              << params.fft_N[0] << " + idx] = yx_s[index];" << std::endl;
+              << params.fft_N[0] << " + idx] = yx_s[index];\n";
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "outputA[iOffset + (lidy + loop*" << 16 / reShapeFactor << ")*"
               << params.fft_N[0]
-              << " + lidx + starting_index_yx] = xy_s[index]; " << std::endl;
+              << " + lidx + starting_index_yx] = xy_s[index]; \n";
           break;
         case HCFFT_COMPLEX_PLANAR:
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "outputA_R[iOffset + (idy + loop*" << 16 / reShapeFactor
-              << ")*" << params.fft_N[0] << " + idx] = yx_s[index].x;"
-              << std::endl;
+              << ")*" << params.fft_N[0] << " + idx] = yx_s[index].x;\n";
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "outputA_I[iOffset + (idy + loop*" << 16 / reShapeFactor
-              << ")*" << params.fft_N[0] << " + idx] = yx_s[index].y;"
-              << std::endl;
+              << ")*" << params.fft_N[0] << " + idx] = yx_s[index].y;\n";
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "outputA_R[iOffset + (lidy + loop*" << 16 / reShapeFactor
               << ")*" << params.fft_N[0]
-              << " + lidx + starting_index_yx] = xy_s[index].x; " << std::endl;
+              << " + lidx + starting_index_yx] = xy_s[index].x; \n";
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "outputA_I[iOffset + (lidy + loop*" << 16 / reShapeFactor
               << ")*" << params.fft_N[0]
-              << " + lidx + starting_index_yx] = xy_s[index].y; " << std::endl;
+              << " + lidx + starting_index_yx] = xy_s[index].y; \n";
           break;
         case HCFFT_HERMITIAN_INTERLEAVED:
         case HCFFT_HERMITIAN_PLANAR:
@@ -2666,64 +2547,60 @@ hcfftStatus genTransposeKernelBatched(
           return HCFFT_INVALID;
       }
 
-      StockhamGenerator::hcKernWrite(transKernel, 6) << "}" << std::endl;
-      StockhamGenerator::hcKernWrite(transKernel, 3) << "}" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 6) << "}\n";
+      StockhamGenerator::hcKernWrite(transKernel, 3) << "}\n";
 
-      StockhamGenerator::hcKernWrite(transKernel, 3) << "else{" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 3) << "else{\n";
       StockhamGenerator::hcKernWrite(transKernel, 6) << "for (size_t loop = 0; loop<"
                                   << reShapeFactor * reShapeFactor
-                                  << "; ++loop){" << std::endl;
+                                  << "; ++loop){\n";
 
       StockhamGenerator::hcKernWrite(transKernel, 9) << "index = lidx*" << 16 * reShapeFactor
                                   << " + lidy + " << 16 / reShapeFactor
-                                  << "*loop;" << std::endl;
+                                  << "*loop;\n";
 
       // Handle planar and interleaved right here
       switch (params.fft_outputLayout) {
         case HCFFT_COMPLEX_INTERLEAVED:
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "if ((idy + loop*" << 16 / reShapeFactor << ")<"
-              << params.fft_N[0] << " && idx<" << params.fft_N[0] << ")"
-              << std::endl;
+              << params.fft_N[0] << " && idx<" << params.fft_N[0] << ")\n";
           StockhamGenerator::hcKernWrite(transKernel, 12)
               << "outputA[iOffset + (idy + loop*" << 16 / reShapeFactor << ")*"
-              << params.fft_N[0] << " + idx] = yx_s[index]; " << std::endl;
+              << params.fft_N[0] << " + idx] = yx_s[index]; \n";
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "if ((t_gy_p * " << 16 * reShapeFactor << " + lidx)<"
               << params.fft_N[0] << " && (t_gx_p * " << 16 * reShapeFactor
               << " + lidy + loop*" << 16 / reShapeFactor << ")<"
-              << params.fft_N[0] << ")" << std::endl;
+              << params.fft_N[0] << ")\n";
           StockhamGenerator::hcKernWrite(transKernel, 12)
               << "outputA[iOffset + (lidy + loop*" << 16 / reShapeFactor << ")*"
               << params.fft_N[0]
-              << " + lidx + starting_index_yx] = xy_s[index];" << std::endl;
+              << " + lidx + starting_index_yx] = xy_s[index];\n";
           break;
         case HCFFT_COMPLEX_PLANAR:
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "if ((idy + loop*" << 16 / reShapeFactor << ")<"
-              << params.fft_N[0] << " && idx<" << params.fft_N[0] << ") {"
-              << std::endl;
+              << params.fft_N[0] << " && idx<" << params.fft_N[0] << ") {\n";
           StockhamGenerator::hcKernWrite(transKernel, 12)
               << "outputA_R[iOffset + (idy + loop*" << 16 / reShapeFactor
-              << ")*" << params.fft_N[0] << " + idx] = yx_s[index].x; "
-              << std::endl;
+              << ")*" << params.fft_N[0] << " + idx] = yx_s[index].x; \n";
           StockhamGenerator::hcKernWrite(transKernel, 12)
               << "outputA_I[iOffset + (idy + loop*" << 16 / reShapeFactor
-              << ")*" << params.fft_N[0] << " + idx] = yx_s[index].y; }"
-              << std::endl;
+              << ")*" << params.fft_N[0] << " + idx] = yx_s[index].y; }\n";
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "if ((t_gy_p * " << 16 * reShapeFactor << " + lidx)<"
               << params.fft_N[0] << " && (t_gx_p * " << 16 * reShapeFactor
               << " + lidy + loop*" << 16 / reShapeFactor << ")<"
-              << params.fft_N[0] << ") {" << std::endl;
+              << params.fft_N[0] << ") {\n";
           StockhamGenerator::hcKernWrite(transKernel, 12)
               << "outputA_R[iOffset + (lidy + loop*" << 16 / reShapeFactor
               << ")*" << params.fft_N[0]
-              << " + lidx + starting_index_yx] = xy_s[index].x;" << std::endl;
+              << " + lidx + starting_index_yx] = xy_s[index].x;\n";
           StockhamGenerator::hcKernWrite(transKernel, 12)
               << "outputA_I[iOffset + (lidy + loop*" << 16 / reShapeFactor
               << ")*" << params.fft_N[0]
-              << " + lidx + starting_index_yx] = xy_s[index].y; }" << std::endl;
+              << " + lidx + starting_index_yx] = xy_s[index].y; }\n";
           break;
         case HCFFT_HERMITIAN_INTERLEAVED:
         case HCFFT_HERMITIAN_PLANAR:
@@ -2734,10 +2611,10 @@ hcfftStatus genTransposeKernelBatched(
           return HCFFT_INVALID;
       }
 
-      StockhamGenerator::hcKernWrite(transKernel, 6) << "}" << std::endl;  // end for
-      StockhamGenerator::hcKernWrite(transKernel, 3) << "}" << std::endl;  // end else
+      StockhamGenerator::hcKernWrite(transKernel, 6) << "}\n";  // end for
+      StockhamGenerator::hcKernWrite(transKernel, 3) << "}\n";  // end else
     }
-    StockhamGenerator::hcKernWrite(transKernel, 0) << "}).wait();\n}}\n" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 0) << "}).wait();\n}}\n\n";
 
     strKernel = transKernel.str();
 
@@ -2760,7 +2637,7 @@ hcfftStatus genTransposeKernelLeadingDimensionBatched(
     std::vector<size_t> gWorkSize, std::vector<size_t> lWorkSize,
     size_t count) {
   strKernel.reserve(4096);
-  std::stringstream transKernel(std::stringstream::out);
+  CodeEmitter transKernel;
 
   // These strings represent the various data types we read or write in the
   // kernel, depending on how the plan
@@ -2788,7 +2665,7 @@ hcfftStatus genTransposeKernelLeadingDimensionBatched(
   // If twiddle computation has been requested, generate the lookup function
   if (params.fft_3StepTwiddle) {
     genTwiddle = true;
-    std::string str;
+    CodeEmitter str;
     if (params.fft_precision == HCFFT_SINGLE) {
       StockhamGenerator::TwiddleTableLarge<hc::short_vector::float_2,
                                            StockhamGenerator::P_SINGLE>
@@ -2802,8 +2679,8 @@ hcfftStatus genTransposeKernelLeadingDimensionBatched(
       twLarge.GenerateTwiddleTable(str, plHandle);
       twLarge.TwiddleLargeAV((void**)&twiddleslarge, acc);
     }
-    StockhamGenerator::hcKernWrite(transKernel, 0) << str << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 0) << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 0) << str.str() << "\n";
+    StockhamGenerator::hcKernWrite(transKernel, 0) << "\n";
   }
 
   size_t smaller_dim =
@@ -2863,63 +2740,58 @@ hcfftStatus genTransposeKernelLeadingDimensionBatched(
           << "const size_t  numGroups_square_matrix_Y_1 = "
           << (smaller_dim / 16 / reShapeFactor) *
                  (smaller_dim / 16 / reShapeFactor + 1) / 2
-          << ";" << std::endl;
+          << ";\n";
     else
       StockhamGenerator::hcKernWrite(transKernel, 3)
           << "const size_t  numGroups_square_matrix_Y_1 = "
           << (smaller_dim / (16 * reShapeFactor) + 1) *
                  (smaller_dim / (16 * reShapeFactor) + 1 + 1) / 2
-          << ";" << std::endl;
+          << ";\n";
 
     StockhamGenerator::hcKernWrite(transKernel, 3)
         << "const size_t  numGroupsY_1 =  numGroups_square_matrix_Y_1 * "
-        << dim_ratio << ";" << std::endl;
+        << dim_ratio << ";\n";
 
     for (size_t i = 2; i < params.fft_DataDim - 1; i++) {
       StockhamGenerator::hcKernWrite(transKernel, 3) << "const size_t numGroupsY_" << i
                                   << " = numGroupsY_" << i - 1 << " * "
-                                  << params.fft_N[i] << ";" << std::endl;
+                                  << params.fft_N[i] << ";\n";
     }
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t g_index;" << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t square_matrix_index;" << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t square_matrix_offset;" << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 3) << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t g_index;\n";
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t square_matrix_index;\n";
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t square_matrix_offset;\n";
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
 
     OffsetCalcLeadingDimensionBatched(transKernel, params);
 
     StockhamGenerator::hcKernWrite(transKernel, 3)
-        << "square_matrix_index = (g_index / numGroups_square_matrix_Y_1) ;"
-        << std::endl;
+        << "square_matrix_index = (g_index / numGroups_square_matrix_Y_1) ;\n";
     StockhamGenerator::hcKernWrite(transKernel, 3)
         << "g_index = g_index % numGroups_square_matrix_Y_1"
-        << ";" << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 3) << std::endl;
+        << ";\n";
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
 
     if (smaller_dim == params.fft_N[1]) {
       StockhamGenerator::hcKernWrite(transKernel, 3)
           << "square_matrix_offset = square_matrix_index * " << smaller_dim
-          << ";" << std::endl;
+          << ";\n";
     } else {
       StockhamGenerator::hcKernWrite(transKernel, 3)
           << "square_matrix_offset = square_matrix_index *"
-          << smaller_dim * smaller_dim << ";" << std::endl;
+          << smaller_dim * smaller_dim << ";\n";
     }
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "iOffset += square_matrix_offset ;"
-                                << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "iOffset += square_matrix_offset ;\n";
 
     switch (params.fft_inputLayout) {
       case HCFFT_COMPLEX_INTERLEAVED:
       case HCFFT_REAL:
-        StockhamGenerator::hcKernWrite(transKernel, 3) << dtInput << " *outputA = inputA;"
-                                    << std::endl;
+        StockhamGenerator::hcKernWrite(transKernel, 3) << dtInput << " *outputA = inputA;\n";
         break;
       case HCFFT_COMPLEX_PLANAR:
-        StockhamGenerator::hcKernWrite(transKernel, 3) << dtInput << " *outputA_R = inputA_R;"
-                                    << std::endl;
-        StockhamGenerator::hcKernWrite(transKernel, 3) << dtInput << " *outputA_I = inputA_I;"
-                                    << std::endl;
+        StockhamGenerator::hcKernWrite(transKernel, 3) << dtInput << " *outputA_R = inputA_R;\n";
+        StockhamGenerator::hcKernWrite(transKernel, 3) << dtInput << " *outputA_I = inputA_I;\n";
         break;
       case HCFFT_HERMITIAN_INTERLEAVED:
       case HCFFT_HERMITIAN_PLANAR:
@@ -2928,7 +2800,7 @@ hcfftStatus genTransposeKernelLeadingDimensionBatched(
         return HCFFT_INVALID;
     }
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
 
     // Now compute the corresponding y,x coordinates
     // for a triangular indexing
@@ -2938,93 +2810,86 @@ hcfftStatus genTransposeKernelLeadingDimensionBatched(
           << "+sqrt(("
           << 4.0f * smaller_dim / 16 / reShapeFactor *
                  (smaller_dim / 16 / reShapeFactor + 1)
-          << "-8.0f*g_index- 7)))/ (-2.0f);" << std::endl;
+          << "-8.0f*g_index- 7)))/ (-2.0f);\n";
     else
       StockhamGenerator::hcKernWrite(transKernel, 3)
           << "float row = ("
           << -2.0f * (smaller_dim / (16 * reShapeFactor) + 1) - 1 << "+sqrt(("
           << 4.0f * (smaller_dim / (16 * reShapeFactor) + 1) *
                  (smaller_dim / (16 * reShapeFactor) + 1 + 1)
-          << "-8.0f*g_index- 7)))/ (-2.0f);" << std::endl;
+          << "-8.0f*g_index- 7)))/ (-2.0f);\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "if (row == (float)(int)row) row -= 1; "
-                                << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "const size_t t_gy = (int)row;" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "if (row == (float)(int)row) row -= 1; \n";
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "const size_t t_gy = (int)row;\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
 
     if (mult_of_16)
       StockhamGenerator::hcKernWrite(transKernel, 3) << "const long t_gx_p = g_index - "
                                   << (smaller_dim / 16 / reShapeFactor)
-                                  << "*t_gy + t_gy*(t_gy + 1) / 2;"
-                                  << std::endl;
+                                  << "*t_gy + t_gy*(t_gy + 1) / 2;\n";
     else
       StockhamGenerator::hcKernWrite(transKernel, 3) << "const long t_gx_p = g_index - "
                                   << (smaller_dim / (16 * reShapeFactor) + 1)
-                                  << "*t_gy + t_gy*(t_gy + 1) / 2;"
-                                  << std::endl;
+                                  << "*t_gy + t_gy*(t_gy + 1) / 2;\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "const long t_gy_p = t_gx_p - t_gy;"
-                                << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "const long t_gy_p = t_gx_p - t_gy;\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "const size_t d_lidx = tidx.local[0] % 16;"
-                                << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "const size_t d_lidy = tidx.local[0] / 16;"
-                                << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "const size_t d_lidx = tidx.local[0] % 16;\n";
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "const size_t d_lidy = tidx.local[0] / 16;\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
 
     StockhamGenerator::hcKernWrite(transKernel, 3)
         << "const size_t lidy = (d_lidy * 16 + d_lidx) /"
-        << (16 * reShapeFactor) << ";" << std::endl;
+        << (16 * reShapeFactor) << ";\n";
     StockhamGenerator::hcKernWrite(transKernel, 3)
         << "const size_t lidx = (d_lidy * 16 + d_lidx) %"
-        << (16 * reShapeFactor) << ";" << std::endl;
+        << (16 * reShapeFactor) << ";\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
 
     StockhamGenerator::hcKernWrite(transKernel, 3) << "const size_t idx = lidx + t_gx_p*"
-                                << 16 * reShapeFactor << ";" << std::endl;
+                                << 16 * reShapeFactor << ";\n";
     StockhamGenerator::hcKernWrite(transKernel, 3) << "const size_t idy = lidy + t_gy_p*"
-                                << 16 * reShapeFactor << ";" << std::endl;
+                                << 16 * reShapeFactor << ";\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
 
     StockhamGenerator::hcKernWrite(transKernel, 3) << "const size_t starting_index_yx = t_gy_p*"
                                 << 16 * reShapeFactor << " + t_gx_p*"
-                                << 16 * reShapeFactor * params.fft_N[0] << ";"
-                                << std::endl;
+                                << 16 * reShapeFactor * params.fft_N[0] << ";\n";
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
 
     switch (params.fft_inputLayout) {
       case HCFFT_REAL:
       case HCFFT_COMPLEX_INTERLEAVED:
         StockhamGenerator::hcKernWrite(transKernel, 3) << "tile_static " << dtInput << " xy_s["
                                     << 16 * reShapeFactor * 16 * reShapeFactor
-                                    << "];" << std::endl;
+                                    << "];\n";
         StockhamGenerator::hcKernWrite(transKernel, 3) << "tile_static " << dtInput << " yx_s["
                                     << 16 * reShapeFactor * 16 * reShapeFactor
-                                    << "];" << std::endl;
+                                    << "];\n";
 
-        StockhamGenerator::hcKernWrite(transKernel, 3) << dtInput << " tmpm, tmpt;" << std::endl;
+        StockhamGenerator::hcKernWrite(transKernel, 3) << dtInput << " tmpm, tmpt;\n";
         break;
       case HCFFT_COMPLEX_PLANAR:
         StockhamGenerator::hcKernWrite(transKernel, 3) << "tile_static " << dtComplex << " xy_s["
                                     << 16 * reShapeFactor * 16 * reShapeFactor
-                                    << "];" << std::endl;
+                                    << "];\n";
         StockhamGenerator::hcKernWrite(transKernel, 3) << "tile_static " << dtComplex << " yx_s["
                                     << 16 * reShapeFactor * 16 * reShapeFactor
-                                    << "];" << std::endl;
+                                    << "];\n";
 
-        StockhamGenerator::hcKernWrite(transKernel, 3) << dtComplex << " tmpm, tmpt;" << std::endl;
+        StockhamGenerator::hcKernWrite(transKernel, 3) << dtComplex << " tmpm, tmpt;\n";
         break;
       default:
         return HCFFT_INVALID;
     }
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
 
     // Step 1: Load both blocks into local memory
     // Here I load inputA for both blocks contiguously and write it contigously
@@ -3035,12 +2900,12 @@ hcfftStatus genTransposeKernelLeadingDimensionBatched(
     // back into the arrays
 
     if (mult_of_16) {
-      StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t index;" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t index;\n";
       StockhamGenerator::hcKernWrite(transKernel, 3) << "for (size_t loop = 0; loop<"
                                   << reShapeFactor * reShapeFactor
-                                  << "; ++loop){" << std::endl;
+                                  << "; ++loop){\n";
       StockhamGenerator::hcKernWrite(transKernel, 6) << "index = lidy*" << 16 * reShapeFactor
-                                  << " + lidx + loop*256;" << std::endl;
+                                  << " + lidx + loop*256;\n";
 
       // Handle planar and interleaved right here
       switch (params.fft_inputLayout) {
@@ -3048,32 +2913,29 @@ hcfftStatus genTransposeKernelLeadingDimensionBatched(
         case HCFFT_REAL: {
           StockhamGenerator::hcKernWrite(transKernel, 6)
               << "tmpm = inputA[iOffset + (idy + loop *" << 16 / reShapeFactor
-              << ")*" << params.fft_N[0] << " + idx];" << std::endl;
+              << ")*" << params.fft_N[0] << " + idx];\n";
           StockhamGenerator::hcKernWrite(transKernel, 6)
               << "tmpt = inputA[iOffset + (lidy + loop *" << 16 / reShapeFactor
-              << ")*" << params.fft_N[0] << " + lidx + starting_index_yx];"
-              << std::endl;
+              << ")*" << params.fft_N[0] << " + lidx + starting_index_yx];\n";
         } break;
         case HCFFT_COMPLEX_PLANAR:
           dtInput = dtPlanar;
           dtOutput = dtPlanar;
           StockhamGenerator::hcKernWrite(transKernel, 6)
               << "tmpm.x = inputA_R[iOffset + (idy + loop *"
-              << 16 / reShapeFactor << ")*" << params.fft_N[0] << " + idx];"
-              << std::endl;
+              << 16 / reShapeFactor << ")*" << params.fft_N[0] << " + idx];\n";
           StockhamGenerator::hcKernWrite(transKernel, 6)
               << "tmpm.y = inputA_I[iOffset + (idy + loop *"
-              << 16 / reShapeFactor << ")*" << params.fft_N[0] << " + idx];"
-              << std::endl;
+              << 16 / reShapeFactor << ")*" << params.fft_N[0] << " + idx];\n";
 
           StockhamGenerator::hcKernWrite(transKernel, 6)
               << "tmpt.x = inputA_R[iOffset + (lidy + loop *"
               << 16 / reShapeFactor << ")*" << params.fft_N[0]
-              << " + lidx + starting_index_yx];" << std::endl;
+              << " + lidx + starting_index_yx];\n";
           StockhamGenerator::hcKernWrite(transKernel, 6)
               << "tmpt.y = inputA_I[iOffset + (lidy + loop *"
               << 16 / reShapeFactor << ")*" << params.fft_N[0]
-              << " + lidx + starting_index_yx];" << std::endl;
+              << " + lidx + starting_index_yx];\n";
           break;
         case HCFFT_HERMITIAN_INTERLEAVED:
         case HCFFT_HERMITIAN_PLANAR:
@@ -3087,54 +2949,51 @@ hcfftStatus genTransposeKernelLeadingDimensionBatched(
         genTwiddleMathLeadingDimensionBatched(plHandle, params, transKernel,
                                               dtComplex, fwd);
 
-      StockhamGenerator::hcKernWrite(transKernel, 6) << "xy_s[index] = tmpm; " << std::endl;
-      StockhamGenerator::hcKernWrite(transKernel, 6) << "yx_s[index] = tmpt; " << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 6) << "xy_s[index] = tmpm; \n";
+      StockhamGenerator::hcKernWrite(transKernel, 6) << "yx_s[index] = tmpt; \n";
 
-      StockhamGenerator::hcKernWrite(transKernel, 3) << "}" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 3) << "}\n";
 
-      StockhamGenerator::hcKernWrite(transKernel, 3) << "" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
 
-      StockhamGenerator::hcKernWrite(transKernel, 3) << "tidx.barrier.wait();" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 3) << "tidx.barrier.wait();\n";
 
-      StockhamGenerator::hcKernWrite(transKernel, 3) << "" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
 
       // Step2: Write from shared to global
       StockhamGenerator::hcKernWrite(transKernel, 3) << "for (size_t loop = 0; loop<"
                                   << reShapeFactor * reShapeFactor
-                                  << "; ++loop){" << std::endl;
+                                  << "; ++loop){\n";
       StockhamGenerator::hcKernWrite(transKernel, 6) << "index = lidx*" << 16 * reShapeFactor
                                   << " + lidy + " << 16 / reShapeFactor
-                                  << "*loop;" << std::endl;
+                                  << "*loop;\n";
 
       // Handle planar and interleaved right here
       switch (params.fft_outputLayout) {
         case HCFFT_COMPLEX_INTERLEAVED:
           StockhamGenerator::hcKernWrite(transKernel, 6)
               << "outputA[iOffset + (idy + loop*" << 16 / reShapeFactor << ")*"
-              << params.fft_N[0] << " + idx] = yx_s[index];" << std::endl;
+              << params.fft_N[0] << " + idx] = yx_s[index];\n";
           StockhamGenerator::hcKernWrite(transKernel, 6)
               << "outputA[iOffset + (lidy + loop*" << 16 / reShapeFactor << ")*"
-              << params.fft_N[0] << " + lidx+ starting_index_yx] = xy_s[index];"
-              << std::endl;
+              << params.fft_N[0] << " + lidx+ starting_index_yx] = xy_s[index];\n";
           break;
         case HCFFT_COMPLEX_PLANAR:
           StockhamGenerator::hcKernWrite(transKernel, 6)
               << "outputA_R[iOffset + (idy + loop*" << 16 / reShapeFactor
-              << ")*" << params.fft_N[0] << " + idx] = yx_s[index].x;"
-              << std::endl;
+              << ")*" << params.fft_N[0] << " + idx] = yx_s[index].x;\n";
           StockhamGenerator::hcKernWrite(transKernel, 6)
               << "outputA_I[iOffset + (idy + loop*" << 16 / reShapeFactor
-              << ")*" << params.fft_N[0] << " + idx] = yx_s[index].y;"
-              << std::endl;
+              << ")*" << params.fft_N[0] << " + idx] = yx_s[index].y;\n";
 
           StockhamGenerator::hcKernWrite(transKernel, 6)
               << "outputA_R[iOffset + (lidy + loop*" << 16 / reShapeFactor
               << ")*" << params.fft_N[0]
-              << " + lidx+ starting_index_yx] = xy_s[index].x;" << std::endl;
+              << " + lidx+ starting_index_yx] = xy_s[index].x;\n";
           StockhamGenerator::hcKernWrite(transKernel, 6)
               << "outputA_I[iOffset + (lidy + loop*" << 16 / reShapeFactor
               << ")*" << params.fft_N[0]
-              << " + lidx+ starting_index_yx] = xy_s[index].y;" << std::endl;
+              << " + lidx+ starting_index_yx] = xy_s[index].y;\n";
           break;
         case HCFFT_HERMITIAN_INTERLEAVED:
         case HCFFT_HERMITIAN_PLANAR:
@@ -3144,17 +3003,17 @@ hcfftStatus genTransposeKernelLeadingDimensionBatched(
         default:
           return HCFFT_INVALID;
       }
-      StockhamGenerator::hcKernWrite(transKernel, 3) << "}" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 3) << "}\n";
     } else {
-      StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t index;" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t index;\n";
       StockhamGenerator::hcKernWrite(transKernel, 3) << "if (" << smaller_dim
                                   << " - (t_gx_p + 1) *" << 16 * reShapeFactor
-                                  << ">0){" << std::endl;
+                                  << ">0){\n";
       StockhamGenerator::hcKernWrite(transKernel, 6) << "for (size_t loop = 0; loop<"
                                   << reShapeFactor * reShapeFactor
-                                  << "; ++loop){" << std::endl;
+                                  << "; ++loop){\n";
       StockhamGenerator::hcKernWrite(transKernel, 9) << "index = lidy*" << 16 * reShapeFactor
-                                  << " + lidx + loop*256;" << std::endl;
+                                  << " + lidx + loop*256;\n";
 
       // Handle planar and interleaved right here
       switch (params.fft_inputLayout) {
@@ -3162,32 +3021,29 @@ hcfftStatus genTransposeKernelLeadingDimensionBatched(
         case HCFFT_REAL:
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "tmpm = inputA[iOffset + (idy + loop*" << 16 / reShapeFactor
-              << ")*" << params.fft_N[0] << " + idx];" << std::endl;
+              << ")*" << params.fft_N[0] << " + idx];\n";
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "tmpt = inputA[iOffset + (lidy + loop*" << 16 / reShapeFactor
-              << ")*" << params.fft_N[0] << " + lidx + starting_index_yx];"
-              << std::endl;
+              << ")*" << params.fft_N[0] << " + lidx + starting_index_yx];\n";
           break;
         case HCFFT_COMPLEX_PLANAR:
           dtInput = dtPlanar;
           dtOutput = dtPlanar;
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "tmpm.x = inputA_R[iOffset + (idy + loop*"
-              << 16 / reShapeFactor << ")*" << params.fft_N[0] << " + idx];"
-              << std::endl;
+              << 16 / reShapeFactor << ")*" << params.fft_N[0] << " + idx];\n";
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "tmpm.y = inputA_I[iOffset + (idy + loop*"
-              << 16 / reShapeFactor << ")*" << params.fft_N[0] << " + idx];"
-              << std::endl;
+              << 16 / reShapeFactor << ")*" << params.fft_N[0] << " + idx];\n";
 
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "tmpt.x = inputA_R[iOffset + (lidy + loop*"
               << 16 / reShapeFactor << ")*" << params.fft_N[0]
-              << " + lidx + starting_index_yx];" << std::endl;
+              << " + lidx + starting_index_yx];\n";
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "tmpt.y = inputA_I[iOffset + (lidy + loop*"
               << 16 / reShapeFactor << ")*" << params.fft_N[0]
-              << " + lidx + starting_index_yx];" << std::endl;
+              << " + lidx + starting_index_yx];\n";
           break;
         case HCFFT_HERMITIAN_INTERLEAVED:
         case HCFFT_HERMITIAN_PLANAR:
@@ -3201,17 +3057,17 @@ hcfftStatus genTransposeKernelLeadingDimensionBatched(
         genTwiddleMathLeadingDimensionBatched(plHandle, params, transKernel,
                                               dtComplex, fwd);
 
-      StockhamGenerator::hcKernWrite(transKernel, 9) << "xy_s[index] = tmpm;" << std::endl;
-      StockhamGenerator::hcKernWrite(transKernel, 9) << "yx_s[index] = tmpt;" << std::endl;
-      StockhamGenerator::hcKernWrite(transKernel, 6) << "}" << std::endl;
-      StockhamGenerator::hcKernWrite(transKernel, 3) << "}" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 9) << "xy_s[index] = tmpm;\n";
+      StockhamGenerator::hcKernWrite(transKernel, 9) << "yx_s[index] = tmpt;\n";
+      StockhamGenerator::hcKernWrite(transKernel, 6) << "}\n";
+      StockhamGenerator::hcKernWrite(transKernel, 3) << "}\n";
 
-      StockhamGenerator::hcKernWrite(transKernel, 3) << "else{" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 3) << "else{\n";
       StockhamGenerator::hcKernWrite(transKernel, 6) << "for (size_t loop = 0; loop<"
                                   << reShapeFactor * reShapeFactor
-                                  << "; ++loop){" << std::endl;
+                                  << "; ++loop){\n";
       StockhamGenerator::hcKernWrite(transKernel, 9) << "index = lidy*" << 16 * reShapeFactor
-                                  << " + lidx + loop*256;" << std::endl;
+                                  << " + lidx + loop*256;\n";
 
       // Handle planar and interleaved right here
       switch (params.fft_inputLayout) {
@@ -3219,47 +3075,44 @@ hcfftStatus genTransposeKernelLeadingDimensionBatched(
         case HCFFT_REAL:
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "if ((idy + loop*" << 16 / reShapeFactor << ")<" << smaller_dim
-              << "&& idx<" << smaller_dim << ")" << std::endl;
+              << "&& idx<" << smaller_dim << ")\n";
           StockhamGenerator::hcKernWrite(transKernel, 12)
               << "tmpm = inputA[iOffset + (idy + loop*" << 16 / reShapeFactor
-              << ")*" << params.fft_N[0] << " + idx];" << std::endl;
+              << ")*" << params.fft_N[0] << " + idx];\n";
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "if ((t_gy_p *" << 16 * reShapeFactor << " + lidx)<"
               << smaller_dim << " && (t_gx_p * " << 16 * reShapeFactor
               << " + lidy + loop*" << 16 / reShapeFactor << ")<" << smaller_dim
-              << ") " << std::endl;
+              << ") \n";
           StockhamGenerator::hcKernWrite(transKernel, 12)
               << "tmpt = inputA[iOffset + (lidy + loop*" << 16 / reShapeFactor
-              << ")*" << params.fft_N[0] << " + lidx + starting_index_yx];"
-              << std::endl;
+              << ")*" << params.fft_N[0] << " + lidx + starting_index_yx];\n";
           break;
         case HCFFT_COMPLEX_PLANAR:
           dtInput = dtPlanar;
           dtOutput = dtPlanar;
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "if ((idy + loop*" << 16 / reShapeFactor << ")<" << smaller_dim
-              << "&& idx<" << smaller_dim << ") {" << std::endl;
+              << "&& idx<" << smaller_dim << ") {\n";
           StockhamGenerator::hcKernWrite(transKernel, 12)
               << "tmpm.x = inputA_R[iOffset + (idy + loop*"
-              << 16 / reShapeFactor << ")*" << params.fft_N[0] << " + idx];"
-              << std::endl;
+              << 16 / reShapeFactor << ")*" << params.fft_N[0] << " + idx];\n";
           StockhamGenerator::hcKernWrite(transKernel, 12)
               << "tmpm.y = inputA_I[iOffset + (idy + loop*"
-              << 16 / reShapeFactor << ")*" << params.fft_N[0] << " + idx]; }"
-              << std::endl;
+              << 16 / reShapeFactor << ")*" << params.fft_N[0] << " + idx]; }\n";
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "if ((t_gy_p *" << 16 * reShapeFactor << " + lidx)<"
               << smaller_dim << " && (t_gx_p * " << 16 * reShapeFactor
               << " + lidy + loop*" << 16 / reShapeFactor << ")<" << smaller_dim
-              << ") {" << std::endl;
+              << ") {\n";
           StockhamGenerator::hcKernWrite(transKernel, 12)
               << "tmpt.x = inputA_R[iOffset + (lidy + loop*"
               << 16 / reShapeFactor << ")*" << params.fft_N[0]
-              << " + lidx + starting_index_yx];" << std::endl;
+              << " + lidx + starting_index_yx];\n";
           StockhamGenerator::hcKernWrite(transKernel, 12)
               << "tmpt.y = inputA_I[iOffset + (lidy + loop*"
               << 16 / reShapeFactor << ")*" << params.fft_N[0]
-              << " + lidx + starting_index_yx]; }" << std::endl;
+              << " + lidx + starting_index_yx]; }\n";
           break;
         case HCFFT_HERMITIAN_INTERLEAVED:
         case HCFFT_HERMITIAN_PLANAR:
@@ -3273,56 +3126,54 @@ hcfftStatus genTransposeKernelLeadingDimensionBatched(
         genTwiddleMathLeadingDimensionBatched(plHandle, params, transKernel,
                                               dtComplex, fwd);
 
-      StockhamGenerator::hcKernWrite(transKernel, 9) << "xy_s[index] = tmpm;" << std::endl;
-      StockhamGenerator::hcKernWrite(transKernel, 9) << "yx_s[index] = tmpt;" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 9) << "xy_s[index] = tmpm;\n";
+      StockhamGenerator::hcKernWrite(transKernel, 9) << "yx_s[index] = tmpt;\n";
 
-      StockhamGenerator::hcKernWrite(transKernel, 9) << "}" << std::endl;
-      StockhamGenerator::hcKernWrite(transKernel, 3) << "}" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 9) << "}\n";
+      StockhamGenerator::hcKernWrite(transKernel, 3) << "}\n";
 
-      StockhamGenerator::hcKernWrite(transKernel, 3) << "" << std::endl;
-      StockhamGenerator::hcKernWrite(transKernel, 3) << "tidx.barrier.wait();" << std::endl;
-      StockhamGenerator::hcKernWrite(transKernel, 3) << "" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
+      StockhamGenerator::hcKernWrite(transKernel, 3) << "tidx.barrier.wait();\n";
+      StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
 
       // Step2: Write from shared to global
 
       StockhamGenerator::hcKernWrite(transKernel, 3) << "if (" << smaller_dim
                                   << " - (t_gx_p + 1) *" << 16 * reShapeFactor
-                                  << ">0){" << std::endl;
+                                  << ">0){\n";
       StockhamGenerator::hcKernWrite(transKernel, 6) << "for (size_t loop = 0; loop<"
                                   << reShapeFactor * reShapeFactor
-                                  << "; ++loop){" << std::endl;
+                                  << "; ++loop){\n";
       StockhamGenerator::hcKernWrite(transKernel, 9) << "index = lidx*" << 16 * reShapeFactor
                                   << " + lidy + " << 16 / reShapeFactor
-                                  << "*loop ;" << std::endl;
+                                  << "*loop ;\n";
 
       // Handle planar and interleaved right here
       switch (params.fft_outputLayout) {
         case HCFFT_COMPLEX_INTERLEAVED:
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "outputA[iOffset + (idy + loop*" << 16 / reShapeFactor << ")*"
-              << params.fft_N[0] << " + idx] = yx_s[index];" << std::endl;
+              << params.fft_N[0] << " + idx] = yx_s[index];\n";
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "outputA[iOffset + (lidy + loop*" << 16 / reShapeFactor << ")*"
               << params.fft_N[0]
-              << " + lidx + starting_index_yx] = xy_s[index]; " << std::endl;
+              << " + lidx + starting_index_yx] = xy_s[index]; \n";
           break;
         case HCFFT_COMPLEX_PLANAR:
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "outputA_R[iOffset + (idy + loop*" << 16 / reShapeFactor
-              << ")*" << params.fft_N[0] << " + idx] = yx_s[index].x;"
-              << std::endl;
+              << ")*" << params.fft_N[0] << " + idx] = yx_s[index].x;\n";
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "outputA_I[iOffset + (idy + loop*" << 16 / reShapeFactor
-              << ")*" << params.fft_N[0] << " + idx] = yx_s[index].y;"
-              << std::endl;
+              << ")*" << params.fft_N[0] << " + idx] = yx_s[index].y;\n";
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "outputA_R[iOffset + (lidy + loop*" << 16 / reShapeFactor
               << ")*" << params.fft_N[0]
-              << " + lidx + starting_index_yx] = xy_s[index].x; " << std::endl;
+              << " + lidx + starting_index_yx] = xy_s[index].x; \n";
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "outputA_I[iOffset + (lidy + loop*" << 16 / reShapeFactor
               << ")*" << params.fft_N[0]
-              << " + lidx + starting_index_yx] = xy_s[index].y; " << std::endl;
+              << " + lidx + starting_index_yx] = xy_s[index].y; \n";
           break;
         case HCFFT_HERMITIAN_INTERLEAVED:
         case HCFFT_HERMITIAN_PLANAR:
@@ -3333,62 +3184,60 @@ hcfftStatus genTransposeKernelLeadingDimensionBatched(
           return HCFFT_INVALID;
       }
 
-      StockhamGenerator::hcKernWrite(transKernel, 6) << "}" << std::endl;
-      StockhamGenerator::hcKernWrite(transKernel, 3) << "}" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 6) << "}\n";
+      StockhamGenerator::hcKernWrite(transKernel, 3) << "}\n";
 
-      StockhamGenerator::hcKernWrite(transKernel, 3) << "else{" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 3) << "else{\n";
       StockhamGenerator::hcKernWrite(transKernel, 6) << "for (size_t loop = 0; loop<"
                                   << reShapeFactor * reShapeFactor
-                                  << "; ++loop){" << std::endl;
+                                  << "; ++loop){\n";
 
       StockhamGenerator::hcKernWrite(transKernel, 9) << "index = lidx*" << 16 * reShapeFactor
                                   << " + lidy + " << 16 / reShapeFactor
-                                  << "*loop;" << std::endl;
+                                  << "*loop;\n";
 
       // Handle planar and interleaved right here
       switch (params.fft_outputLayout) {
         case HCFFT_COMPLEX_INTERLEAVED:
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "if ((idy + loop*" << 16 / reShapeFactor << ")<" << smaller_dim
-              << " && idx<" << smaller_dim << ")" << std::endl;
+              << " && idx<" << smaller_dim << ")\n";
           StockhamGenerator::hcKernWrite(transKernel, 12)
               << "outputA[iOffset + (idy + loop*" << 16 / reShapeFactor << ")*"
-              << params.fft_N[0] << " + idx] = yx_s[index]; " << std::endl;
+              << params.fft_N[0] << " + idx] = yx_s[index]; \n";
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "if ((t_gy_p * " << 16 * reShapeFactor << " + lidx)<"
               << smaller_dim << " && (t_gx_p * " << 16 * reShapeFactor
               << " + lidy + loop*" << 16 / reShapeFactor << ")<" << smaller_dim
-              << ")" << std::endl;
+              << ")\n";
           StockhamGenerator::hcKernWrite(transKernel, 12)
               << "outputA[iOffset + (lidy + loop*" << 16 / reShapeFactor << ")*"
               << params.fft_N[0]
-              << " + lidx + starting_index_yx] = xy_s[index];" << std::endl;
+              << " + lidx + starting_index_yx] = xy_s[index];\n";
           break;
         case HCFFT_COMPLEX_PLANAR:
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "if ((idy + loop*" << 16 / reShapeFactor << ")<" << smaller_dim
-              << " && idx<" << smaller_dim << ") {" << std::endl;
+              << " && idx<" << smaller_dim << ") {\n";
           StockhamGenerator::hcKernWrite(transKernel, 12)
               << "outputA_R[iOffset + (idy + loop*" << 16 / reShapeFactor
-              << ")*" << params.fft_N[0] << " + idx] = yx_s[index].x; "
-              << std::endl;
+              << ")*" << params.fft_N[0] << " + idx] = yx_s[index].x; \n";
           StockhamGenerator::hcKernWrite(transKernel, 12)
               << "outputA_I[iOffset + (idy + loop*" << 16 / reShapeFactor
-              << ")*" << params.fft_N[0] << " + idx] = yx_s[index].y; }"
-              << std::endl;
+              << ")*" << params.fft_N[0] << " + idx] = yx_s[index].y; }\n";
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "if ((t_gy_p * " << 16 * reShapeFactor << " + lidx)<"
               << smaller_dim << " && (t_gx_p * " << 16 * reShapeFactor
               << " + lidy + loop*" << 16 / reShapeFactor << ")<" << smaller_dim
-              << ") {" << std::endl;
+              << ") {\n";
           StockhamGenerator::hcKernWrite(transKernel, 12)
               << "outputA_R[iOffset + (lidy + loop*" << 16 / reShapeFactor
               << ")*" << params.fft_N[0]
-              << " + lidx + starting_index_yx] = xy_s[index].x;" << std::endl;
+              << " + lidx + starting_index_yx] = xy_s[index].x;\n";
           StockhamGenerator::hcKernWrite(transKernel, 12)
               << "outputA_I[iOffset + (lidy + loop*" << 16 / reShapeFactor
               << ")*" << params.fft_N[0]
-              << " + lidx + starting_index_yx] = xy_s[index].y; }" << std::endl;
+              << " + lidx + starting_index_yx] = xy_s[index].y; }\n";
           break;
         case HCFFT_HERMITIAN_INTERLEAVED:
         case HCFFT_HERMITIAN_PLANAR:
@@ -3399,10 +3248,10 @@ hcfftStatus genTransposeKernelLeadingDimensionBatched(
           return HCFFT_INVALID;
       }
 
-      StockhamGenerator::hcKernWrite(transKernel, 6) << "}" << std::endl;  // end for
-      StockhamGenerator::hcKernWrite(transKernel, 3) << "}" << std::endl;  // end else
+      StockhamGenerator::hcKernWrite(transKernel, 6) << "}\n";  // end for
+      StockhamGenerator::hcKernWrite(transKernel, 3) << "}\n";  // end else
     }
-    StockhamGenerator::hcKernWrite(transKernel, 0) << "}).wait();\n}}\n" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 0) << "}).wait();\n}}\n\n";
 
     strKernel = transKernel.str();
 
@@ -3410,4 +3259,28 @@ hcfftStatus genTransposeKernelLeadingDimensionBatched(
   }
   return HCFFT_SUCCEEDS;
 }
+
+void TransposeCost(const FFTPlan& plan, const FFTKernelGenKeyParams& params,
+                   size_t barriers, size_t perWorkItem, FFTKernelCost* cost) {
+  double elements = static_cast<double>(plan.batchSize);
+
+  for (size_t u = 0; u < plan.length.size(); u++) {
+    elements *= plan.length[u];
+  }
+
+  size_t width = (plan.precision == HCFFT_DOUBLE) ? 2 : 1;
+  cost->bytesRead = plan.LayoutBytes(plan.ipLayout, elements);
+  cost->bytesWritten = plan.LayoutBytes(plan.opLayout, elements);
+  cost->ldsBytes = 2.0 * elements * plan.ElementSize();
+  cost->barriers = barriers;
+  cost->registers = 2 * width * perWorkItem + 16;
+
+  // Twiddle lookup and complex multiply of the 3-step algorithm
+  if (params.fft_3StepTwiddle) {
+    cost->flops = 12.0 * elements;
+    cost->bytesRead += static_cast<double>(
+        StockhamGenerator::TwTableLargeSize(plan.large1D) *
+        plan.ElementSize());
+  }
+}
 }  // end of namespace hcfft_transpose_generator
@@ -39,59 +39,51 @@ struct tile {
   };
 };
 
-static void OffsetCalc(std::stringstream& transKernel,
+static void OffsetCalc(CodeEmitter& transKernel,
                        const FFTKernelGenKeyParams& params, bool input) {
   const size_t* stride = input ? params.fft_inStride : params.fft_outStride;
   std::string offset = input ? "iOffset" : "oOffset";
-  StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t " << offset << " = 0;" << std::endl;
-  StockhamGenerator::hcKernWrite(transKernel, 3) << "currDimIndex = groupIndex.y;" << std::endl;
+  StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t " << offset << " = 0;\n";
+  StockhamGenerator::hcKernWrite(transKernel, 3) << "currDimIndex = groupIndex.y;\n";
 
   for (size_t i = params.fft_DataDim - 2; i > 0; i--) {
     StockhamGenerator::hcKernWrite(transKernel, 3) << offset << " += (currDimIndex/numGroupsY_"
-                                << i << ")*" << stride[i + 1] << ";"
-                                << std::endl;
+                                << i << ")*" << stride[i + 1] << ";\n";
     StockhamGenerator::hcKernWrite(transKernel, 3) << "currDimIndex = currDimIndex % numGroupsY_"
-                                << i << ";" << std::endl;
+                                << i << ";\n";
   }
 
-  StockhamGenerator::hcKernWrite(transKernel, 3) << "rowSizeinUnits = " << stride[1] << ";"
-                              << std::endl;
+  StockhamGenerator::hcKernWrite(transKernel, 3) << "rowSizeinUnits = " << stride[1] << ";\n";
 
   if (params.transOutHorizontal) {
     if (input) {
       StockhamGenerator::hcKernWrite(transKernel, 3)
           << offset
-          << " += rowSizeinUnits * wgTileExtent.y * wgUnroll * groupIndex.x;"
-          << std::endl;
+          << " += rowSizeinUnits * wgTileExtent.y * wgUnroll * groupIndex.x;\n";
       StockhamGenerator::hcKernWrite(transKernel, 3)
-          << offset << " += currDimIndex * wgTileExtent.x;" << std::endl;
+          << offset << " += currDimIndex * wgTileExtent.x;\n";
     } else {
       StockhamGenerator::hcKernWrite(transKernel, 3)
-          << offset << " += rowSizeinUnits * wgTileExtent.x * currDimIndex;"
-          << std::endl;
+          << offset << " += rowSizeinUnits * wgTileExtent.x * currDimIndex;\n";
       StockhamGenerator::hcKernWrite(transKernel, 3)
-          << offset << " += groupIndex.x * wgTileExtent.y * wgUnroll;"
-          << std::endl;
+          << offset << " += groupIndex.x * wgTileExtent.y * wgUnroll;\n";
     }
   } else {
     if (input) {
       StockhamGenerator::hcKernWrite(transKernel, 3)
           << offset
-          << " += rowSizeinUnits * wgTileExtent.y * wgUnroll * currDimIndex;"
-          << std::endl;
+          << " += rowSizeinUnits * wgTileExtent.y * wgUnroll * currDimIndex;\n";
       StockhamGenerator::hcKernWrite(transKernel, 3)
-          << offset << " += groupIndex.x * wgTileExtent.x;" << std::endl;
+          << offset << " += groupIndex.x * wgTileExtent.x;\n";
     } else {
       StockhamGenerator::hcKernWrite(transKernel, 3)
-          << offset << " += rowSizeinUnits * wgTileExtent.x * groupIndex.x;"
-          << std::endl;
+          << offset << " += rowSizeinUnits * wgTileExtent.x * groupIndex.x;\n";
       StockhamGenerator::hcKernWrite(transKernel, 3)
-          << offset << " += currDimIndex * wgTileExtent.y * wgUnroll;"
-          << std::endl;
+          << offset << " += currDimIndex * wgTileExtent.y * wgUnroll;\n";
     }
   }
 
-  StockhamGenerator::hcKernWrite(transKernel, 3) << std::endl;
+  StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
 }
 
 // Small snippet of code that multiplies the twiddle factors into the
@@ -100,29 +92,25 @@ static void OffsetCalc(std::stringstream& transKernel,
 // transpose
 static hcfftStatus genTwiddleMath(const hcfftPlanHandle plHandle,
                                   const FFTKernelGenKeyParams& params,
-                                  std::stringstream& transKernel,
+                                  CodeEmitter& transKernel,
                                   const std::string& dtComplex, bool fwd) {
   StockhamGenerator::hcKernWrite(transKernel, 9)
       << dtComplex << " W = TW3step" << plHandle
       << "( (groupIndex.x * wgTileExtent.x + xInd) * (currDimIndex * "
          "wgTileExtent.y * wgUnroll + yInd) "
-      << ", " << StockhamGenerator::TwTableLargeName() << ");" << std::endl;
-  StockhamGenerator::hcKernWrite(transKernel, 9) << dtComplex << " T;" << std::endl;
+      << ", " << StockhamGenerator::TwTableLargeName() << ");\n";
+  StockhamGenerator::hcKernWrite(transKernel, 9) << dtComplex << " T;\n";
 
   if (fwd) {
-    StockhamGenerator::hcKernWrite(transKernel, 9) << "T.x = ( W.x * tmp.x ) - ( W.y * tmp.y );"
-                                << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 9) << "T.y = ( W.y * tmp.x ) + ( W.x * tmp.y );"
-                                << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 9) << "T.x = ( W.x * tmp.x ) - ( W.y * tmp.y );\n";
+    StockhamGenerator::hcKernWrite(transKernel, 9) << "T.y = ( W.y * tmp.x ) + ( W.x * tmp.y );\n";
   } else {
-    StockhamGenerator::hcKernWrite(transKernel, 9) << "T.x =  ( W.x * tmp.x ) + ( W.y * tmp.y );"
-                                << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 9) << "T.y = -( W.y * tmp.x ) + ( W.x * tmp.y );"
-                                << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 9) << "T.x =  ( W.x * tmp.x ) + ( W.y * tmp.y );\n";
+    StockhamGenerator::hcKernWrite(transKernel, 9) << "T.y = -( W.y * tmp.x ) + ( W.x * tmp.y );\n";
   }
 
-  StockhamGenerator::hcKernWrite(transKernel, 9) << "tmp.x = T.x;" << std::endl;
-  StockhamGenerator::hcKernWrite(transKernel, 9) << "tmp.y = T.y;" << std::endl;
+  StockhamGenerator::hcKernWrite(transKernel, 9) << "tmp.x = T.x;\n";
+  StockhamGenerator::hcKernWrite(transKernel, 9) << "tmp.y = T.y;\n";
   return HCFFT_SUCCEEDS;
 }
 
@@ -137,11 +125,11 @@ const std::string pmComplexOut("pmComplexOut");
 static hcfftStatus genTransposePrototype(
     FFTKernelGenKeyParams& params, const tile& lwSize,
     const std::string& dtPlanar, const std::string& dtComplex,
-    const std::string& funcName, std::stringstream& transKernel,
+    const std::string& funcName, CodeEmitter& transKernel,
     std::string& dtInput, std::string& dtOutput, bool genTwiddle) {
   uint arg = 0;
   // Declare and define the function
-  StockhamGenerator::hcKernWrite(transKernel, 0) << "extern \"C\"\n { void" << std::endl;
+  StockhamGenerator::hcKernWrite(transKernel, 0) << "extern \"C\"\n { void\n";
   StockhamGenerator::hcKernWrite(transKernel, 0)
       << funcName << "(  std::map<int, void*> vectArr, uint batchSize, "
                      "accelerator_view &acc_view, accelerator &acc) \n {";
@@ -301,9 +289,9 @@ static hcfftStatus genTransposeKernel(
     const size_t reShapeFactor, const size_t loopCount, const tile& blockSize,
     std::vector<size_t> gWorkSize, std::vector<size_t> lWorkSize,
     size_t count) {
-  // std::cout << " generate gcn transpose kernel "<< strKernel << std::endl;
+  // std::cout << " generate gcn transpose kernel "<< strKernel << "\n";
   strKernel.reserve(4096);
-  std::stringstream transKernel(std::stringstream::out);
+  CodeEmitter transKernel;
   // These strings represent the various data types we read or write in the
   // kernel, depending on how the plan
   // is configured
@@ -331,7 +319,7 @@ static hcfftStatus genTransposeKernel(
 
   //  If twiddle computation has been requested, generate the lookup function
   if (params.fft_3StepTwiddle) {
-    std::string str;
+    CodeEmitter str;
     genTwiddle = true;
 
     if (params.fft_precision == HCFFT_SINGLE) {
@@ -348,8 +336,8 @@ static hcfftStatus genTransposeKernel(
       twLarge.TwiddleLargeAV(twiddleslarge, acc);
     }
 
-    StockhamGenerator::hcKernWrite(transKernel, 0) << str << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 0) << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 0) << str.str() << "\n";
+    StockhamGenerator::hcKernWrite(transKernel, 0) << "\n";
   }
 
   if (params.fft_placeness == HCFFT_INPLACE) {
@@ -381,29 +369,24 @@ static hcfftStatus genTransposeKernel(
                                    "[=] (hc::tiled_index<2> tidx) [[hc]]\n\t "
                                    "{ ";
     StockhamGenerator::hcKernWrite(transKernel, 3)
-        << "const uint_2 localIndex( tidx.local[0] , tidx.local[1]); "
-        << std::endl;
+        << "const uint_2 localIndex( tidx.local[0] , tidx.local[1]); \n";
     StockhamGenerator::hcKernWrite(transKernel, 3)
-        << "const uint_2 localExtent( tidx.tile_dim[0], tidx.tile_dim[1]); "
-        << std::endl;
+        << "const uint_2 localExtent( tidx.tile_dim[0], tidx.tile_dim[1]); \n";
     StockhamGenerator::hcKernWrite(transKernel, 3)
-        << "const uint_2 groupIndex(tidx.tile[0] , tidx.tile[1]);" << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 3) << std::endl;
+        << "const uint_2 groupIndex(tidx.tile[0] , tidx.tile[1]);\n";
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
     StockhamGenerator::hcKernWrite(transKernel, 3)
         << "// Calculate the unit address (in terms of datatype) of the "
-           "beginning of the Tile for the WG block"
-        << std::endl;
+           "beginning of the Tile for the WG block\n";
     StockhamGenerator::hcKernWrite(transKernel, 3) << "// Transpose of input & output blocks "
-                                   "happens with the Offset calculation"
-                                << std::endl;
+                                   "happens with the Offset calculation\n";
     StockhamGenerator::hcKernWrite(transKernel, 3)
-        << "const size_t reShapeFactor = " << reShapeFactor << ";" << std::endl;
+        << "const size_t reShapeFactor = " << reShapeFactor << ";\n";
     StockhamGenerator::hcKernWrite(transKernel, 3) << "const size_t wgUnroll = " << loopCount
-                                << ";" << std::endl;
+                                << ";\n";
     StockhamGenerator::hcKernWrite(transKernel, 3)
         << "const uint_2 wgTileExtent (localExtent.x * reShapeFactor, "
-           "localExtent.y / reShapeFactor );"
-        << std::endl;
+           "localExtent.y / reShapeFactor );\n";
     // This is the size of a matrix in the y dimension in units of group size;
     // used to calculate stride[2] indexing
     // size_t numGroupsY = DivRoundingUp( params.fft_N[ 1 ], lwSize.y /
@@ -420,12 +403,12 @@ static hcfftStatus genTransposeKernel(
     }
 
     StockhamGenerator::hcKernWrite(transKernel, 3) << "const size_t numGroupsY_1"
-                                << " = " << numGroupsTemp << ";" << std::endl;
+                                << " = " << numGroupsTemp << ";\n";
 
     for (int i = 2; i < params.fft_DataDim - 1; i++) {
       numGroupsTemp *= params.fft_N[i];
       StockhamGenerator::hcKernWrite(transKernel, 3) << "const size_t numGroupsY_" << i << " = "
-                                  << numGroupsTemp << ";" << std::endl;
+                                  << numGroupsTemp << ";\n";
     }
 
     // Generate the amount of local data share we need
@@ -438,12 +421,10 @@ static hcfftStatus genTransposeKernel(
       case HCFFT_COMPLEX_PLANAR:
         StockhamGenerator::hcKernWrite(transKernel, 3)
             << "// LDS is always complex and allocated transposed: lds[ "
-               "wgTileExtent.y * wgUnroll ][ wgTileExtent.x ];"
-            << std::endl;
+               "wgTileExtent.y * wgUnroll ][ wgTileExtent.x ];\n";
         StockhamGenerator::hcKernWrite(transKernel, 3) << "tile_static " << dtComplex << " lds[ "
-                                    << ldsSize.x << " ][ " << ldsSize.y << " ];"
-                                    << std::endl
-                                    << std::endl;
+                                    << ldsSize.x << " ][ " << ldsSize.y << " ];\n"
+                                    << "\n";
         break;
 
       case HCFFT_HERMITIAN_INTERLEAVED:
@@ -452,24 +433,23 @@ static hcfftStatus genTransposeKernel(
 
       case HCFFT_REAL:
         StockhamGenerator::hcKernWrite(transKernel, 3) << "tile_static " << dtPlanar << " lds[ "
-                                    << ldsSize.x << " ][ " << ldsSize.y << " ];"
-                                    << std::endl
-                                    << std::endl;
+                                    << ldsSize.x << " ][ " << ldsSize.y << " ];\n"
+                                    << "\n";
         break;
     }
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t currDimIndex;" << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t rowSizeinUnits;" << std::endl
-                                << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t currDimIndex;\n";
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "size_t rowSizeinUnits;\n"
+                                << "\n";
     OffsetCalc(transKernel, params, true);
 
     switch (params.fft_inputLayout) {
       case HCFFT_COMPLEX_INTERLEAVED:
-        StockhamGenerator::hcKernWrite(transKernel, 3) << "uint inOffset = iOffset;" << std::endl;
+        StockhamGenerator::hcKernWrite(transKernel, 3) << "uint inOffset = iOffset;\n";
         break;
 
       case HCFFT_COMPLEX_PLANAR:
-        StockhamGenerator::hcKernWrite(transKernel, 3) << "uint inOffset = iOffset;" << std::endl;
+        StockhamGenerator::hcKernWrite(transKernel, 3) << "uint inOffset = iOffset;\n";
         break;
 
       case HCFFT_HERMITIAN_INTERLEAVED:
@@ -477,20 +457,20 @@ static hcfftStatus genTransposeKernel(
         return HCFFT_INVALID;
 
       case HCFFT_REAL:
-        StockhamGenerator::hcKernWrite(transKernel, 3) << "uint inOffset = iOffset;" << std::endl;
+        StockhamGenerator::hcKernWrite(transKernel, 3) << "uint inOffset = iOffset;\n";
         break;
     }
 
     // This is the loop reading through the Tile
     if (params.fft_inputLayout == HCFFT_REAL) {
-      StockhamGenerator::hcKernWrite(transKernel, 3) << dtPlanar << " tmp;" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 3) << dtPlanar << " tmp;\n";
     } else {
-      StockhamGenerator::hcKernWrite(transKernel, 3) << dtComplex << " tmp;" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 3) << dtComplex << " tmp;\n";
     }
 
     StockhamGenerator::hcKernWrite(transKernel, 3) << "rowSizeinUnits = " << params.fft_inStride[1]
-                                << ";" << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 3) << std::endl << std::endl;
+                                << ";\n";
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "\n" << "\n";
     //
     // Group index traversal is logical where X direction is horizontal in input
     // buffer and vertical in output buffer
@@ -531,120 +511,110 @@ static hcfftStatus genTransposeKernel(
         if (i == 0) {
           StockhamGenerator::hcKernWrite(transKernel, 3)
               << "if( (" << gIndexX << " == " << cornerGroupX << ") && ("
-              << gIndexY << " == " << cornerGroupY << ") )" << std::endl;
-          StockhamGenerator::hcKernWrite(transKernel, 3) << "{" << std::endl;
+              << gIndexY << " == " << cornerGroupY << ") )\n";
+          StockhamGenerator::hcKernWrite(transKernel, 3) << "{\n";
         } else if (i == 1) {
           if (!cornerGroupY) {
             continue;
           }
 
           StockhamGenerator::hcKernWrite(transKernel, 3) << "else if( " << gIndexX
-                                      << " == " << cornerGroupX << " )"
-                                      << std::endl;
-          StockhamGenerator::hcKernWrite(transKernel, 3) << "{" << std::endl;
+                                      << " == " << cornerGroupX << " )\n";
+          StockhamGenerator::hcKernWrite(transKernel, 3) << "{\n";
         } else if (i == 2) {
           if (!cornerGroupX) {
             continue;
           }
 
           StockhamGenerator::hcKernWrite(transKernel, 3) << "else if( " << gIndexY
-                                      << " == " << cornerGroupY << " )"
-                                      << std::endl;
-          StockhamGenerator::hcKernWrite(transKernel, 3) << "{" << std::endl;
+                                      << " == " << cornerGroupY << " )\n";
+          StockhamGenerator::hcKernWrite(transKernel, 3) << "{\n";
         } else {
           if ((!cornerGroupX) || (!cornerGroupY)) {
             continue;
           }
 
-          StockhamGenerator::hcKernWrite(transKernel, 3) << "else" << std::endl;
-          StockhamGenerator::hcKernWrite(transKernel, 3) << "{" << std::endl;
+          StockhamGenerator::hcKernWrite(transKernel, 3) << "else\n";
+          StockhamGenerator::hcKernWrite(transKernel, 3) << "{\n";
         }
       } else if (branchingInAny) {
         if (i == 0) {
           if (branchingInGroupX) {
             StockhamGenerator::hcKernWrite(transKernel, 3) << "if( " << gIndexX
-                                        << " == " << cornerGroupX << " )"
-                                        << std::endl;
-            StockhamGenerator::hcKernWrite(transKernel, 3) << "{" << std::endl;
+                                        << " == " << cornerGroupX << " )\n";
+            StockhamGenerator::hcKernWrite(transKernel, 3) << "{\n";
           } else {
             StockhamGenerator::hcKernWrite(transKernel, 3) << "if( " << gIndexY
-                                        << " == " << cornerGroupY << " )"
-                                        << std::endl;
-            StockhamGenerator::hcKernWrite(transKernel, 3) << "{" << std::endl;
+                                        << " == " << cornerGroupY << " )\n";
+            StockhamGenerator::hcKernWrite(transKernel, 3) << "{\n";
           }
         } else {
           if ((!cornerGroupX) || (!cornerGroupY)) {
             continue;
           }
 
-          StockhamGenerator::hcKernWrite(transKernel, 3) << "else" << std::endl;
-          StockhamGenerator::hcKernWrite(transKernel, 3) << "{" << std::endl;
+          StockhamGenerator::hcKernWrite(transKernel, 3) << "else\n";
+          StockhamGenerator::hcKernWrite(transKernel, 3) << "{\n";
         }
       }
 
-      StockhamGenerator::hcKernWrite(transKernel, 6) << "for( uint t=0; t < wgUnroll; t++ )"
-                                  << std::endl;
-      StockhamGenerator::hcKernWrite(transKernel, 6) << "{" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 6) << "for( uint t=0; t < wgUnroll; t++ )\n";
+      StockhamGenerator::hcKernWrite(transKernel, 6) << "{\n";
       StockhamGenerator::hcKernWrite(transKernel, 9)
           << "size_t xInd = localIndex.x + localExtent.x * ( localIndex.y % "
-             "wgTileExtent.y ); "
-          << std::endl;
+             "wgTileExtent.y ); \n";
       StockhamGenerator::hcKernWrite(transKernel, 9)
-          << "size_t yInd = localIndex.y/wgTileExtent.y + t * wgTileExtent.y; "
-          << std::endl;
+          << "size_t yInd = localIndex.y/wgTileExtent.y + t * wgTileExtent.y; \n";
       // Calculating the index seperately enables easier debugging through tools
       StockhamGenerator::hcKernWrite(transKernel, 9)
-          << "size_t gInd = xInd + rowSizeinUnits * yInd;" << std::endl;
+          << "size_t gInd = xInd + rowSizeinUnits * yInd;\n";
 
       if (branchingInBoth) {
         if (i == 0) {
-          StockhamGenerator::hcKernWrite(transKernel, 9) << std::endl;
+          StockhamGenerator::hcKernWrite(transKernel, 9) << "\n";
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "if( (" << wIndexX << "< " << wIndexXEnd << ") && (" << wIndexY
-              << " < " << wIndexYEnd << ") )" << std::endl;
-          StockhamGenerator::hcKernWrite(transKernel, 9) << "{" << std::endl;
+              << " < " << wIndexYEnd << ") )\n";
+          StockhamGenerator::hcKernWrite(transKernel, 9) << "{\n";
         } else if (i == 1) {
-          StockhamGenerator::hcKernWrite(transKernel, 9) << std::endl;
+          StockhamGenerator::hcKernWrite(transKernel, 9) << "\n";
           StockhamGenerator::hcKernWrite(transKernel, 9) << "if( (" << wIndexX << " < "
-                                      << wIndexXEnd << ") )" << std::endl;
-          StockhamGenerator::hcKernWrite(transKernel, 9) << "{" << std::endl;
+                                      << wIndexXEnd << ") )\n";
+          StockhamGenerator::hcKernWrite(transKernel, 9) << "{\n";
         } else if (i == 2) {
-          StockhamGenerator::hcKernWrite(transKernel, 9) << std::endl;
+          StockhamGenerator::hcKernWrite(transKernel, 9) << "\n";
           StockhamGenerator::hcKernWrite(transKernel, 9) << "if( (" << wIndexY << " < "
-                                      << wIndexYEnd << ") )" << std::endl;
-          StockhamGenerator::hcKernWrite(transKernel, 9) << "{" << std::endl;
+                                      << wIndexYEnd << ") )\n";
+          StockhamGenerator::hcKernWrite(transKernel, 9) << "{\n";
         } else {
-          StockhamGenerator::hcKernWrite(transKernel, 9) << "{" << std::endl;
+          StockhamGenerator::hcKernWrite(transKernel, 9) << "{\n";
         }
       } else if (branchingInAny) {
         if (i == 0) {
           if (branchingInGroupX) {
-            StockhamGenerator::hcKernWrite(transKernel, 9) << std::endl;
+            StockhamGenerator::hcKernWrite(transKernel, 9) << "\n";
             StockhamGenerator::hcKernWrite(transKernel, 9) << "if( (" << wIndexX << " < "
-                                        << wIndexXEnd << ") )" << std::endl;
-            StockhamGenerator::hcKernWrite(transKernel, 9) << "{" << std::endl;
+                                        << wIndexXEnd << ") )\n";
+            StockhamGenerator::hcKernWrite(transKernel, 9) << "{\n";
           } else {
-            StockhamGenerator::hcKernWrite(transKernel, 9) << std::endl;
+            StockhamGenerator::hcKernWrite(transKernel, 9) << "\n";
             StockhamGenerator::hcKernWrite(transKernel, 9) << "if( (" << wIndexY << " < "
-                                        << wIndexYEnd << ") )" << std::endl;
-            StockhamGenerator::hcKernWrite(transKernel, 9) << "{" << std::endl;
+                                        << wIndexYEnd << ") )\n";
+            StockhamGenerator::hcKernWrite(transKernel, 9) << "{\n";
           }
         } else {
-          StockhamGenerator::hcKernWrite(transKernel, 9) << "{" << std::endl;
+          StockhamGenerator::hcKernWrite(transKernel, 9) << "{\n";
         }
       }
 
       switch (params.fft_inputLayout) {
         case HCFFT_COMPLEX_INTERLEAVED: {
-          StockhamGenerator::hcKernWrite(transKernel, 9) << "tmp = pmComplexIn[ gInd + inOffset];"
-                                      << std::endl;
+          StockhamGenerator::hcKernWrite(transKernel, 9) << "tmp = pmComplexIn[ gInd + inOffset];\n";
         } break;
 
         case HCFFT_COMPLEX_PLANAR: {
-          StockhamGenerator::hcKernWrite(transKernel, 9) << "tmp.x = pmRealIn[ gInd + inOffset];"
-                                      << std::endl;
-          StockhamGenerator::hcKernWrite(transKernel, 9) << "tmp.y = pmImagIn[ gInd + inOffset];"
-                                      << std::endl;
+          StockhamGenerator::hcKernWrite(transKernel, 9) << "tmp.x = pmRealIn[ gInd + inOffset];\n";
+          StockhamGenerator::hcKernWrite(transKernel, 9) << "tmp.y = pmImagIn[ gInd + inOffset];\n";
         } break;
 
         case HCFFT_HERMITIAN_INTERLEAVED:
@@ -652,46 +622,44 @@ static hcfftStatus genTransposeKernel(
           return HCFFT_INVALID;
 
         case HCFFT_REAL:
-          StockhamGenerator::hcKernWrite(transKernel, 9) << "tmp = pmRealIn[ gInd + inOffset];"
-                                      << std::endl;
+          StockhamGenerator::hcKernWrite(transKernel, 9) << "tmp = pmRealIn[ gInd + inOffset];\n";
           break;
       }
 
-      StockhamGenerator::hcKernWrite(transKernel, 9) << "// Transpose of Tile data happens here"
-                                  << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 9) << "// Transpose of Tile data happens here\n";
 
       // If requested, generate the Twiddle math to multiply constant values
       if (params.fft_3StepTwiddle) {
         genTwiddleMath(plHandle, params, transKernel, dtComplex, fwd);
       }
 
-      StockhamGenerator::hcKernWrite(transKernel, 9) << "lds[ xInd ][ yInd ] = tmp; " << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 9) << "lds[ xInd ][ yInd ] = tmp; \n";
 
       if (branchingInAny) {
-        StockhamGenerator::hcKernWrite(transKernel, 9) << "}" << std::endl;
-        StockhamGenerator::hcKernWrite(transKernel, 9) << std::endl;
+        StockhamGenerator::hcKernWrite(transKernel, 9) << "}\n";
+        StockhamGenerator::hcKernWrite(transKernel, 9) << "\n";
       }
 
-      StockhamGenerator::hcKernWrite(transKernel, 6) << "}" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 6) << "}\n";
 
       if (branchingInAny) {
-        StockhamGenerator::hcKernWrite(transKernel, 3) << "}" << std::endl;
+        StockhamGenerator::hcKernWrite(transKernel, 3) << "}\n";
       }
     }
 
-    StockhamGenerator::hcKernWrite(transKernel, 3) << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 3) << "tidx.barrier.wait();" << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 3) << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "tidx.barrier.wait();\n";
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "\n";
     OffsetCalc(transKernel, params, false);
 
     switch (params.fft_outputLayout) {
       case HCFFT_COMPLEX_INTERLEAVED:
-        StockhamGenerator::hcKernWrite(transKernel, 3) << "uint outOffset = oOffset;" << std::endl
-                                    << std::endl;
+        StockhamGenerator::hcKernWrite(transKernel, 3) << "uint outOffset = oOffset;\n"
+                                    << "\n";
         break;
 
       case HCFFT_COMPLEX_PLANAR:
-        StockhamGenerator::hcKernWrite(transKernel, 3) << "uint outOffset = oOffset;" << std::endl;
+        StockhamGenerator::hcKernWrite(transKernel, 3) << "uint outOffset = oOffset;\n";
         break;
 
       case HCFFT_HERMITIAN_INTERLEAVED:
@@ -699,112 +667,103 @@ static hcfftStatus genTransposeKernel(
         return HCFFT_INVALID;
 
       case HCFFT_REAL:
-        StockhamGenerator::hcKernWrite(transKernel, 3) << "uint outOffset = oOffset;" << std::endl
-                                    << std::endl;
+        StockhamGenerator::hcKernWrite(transKernel, 3) << "uint outOffset = oOffset;\n"
+                                    << "\n";
         break;
     }
 
     // Write the transposed values from LDS into global memory
     StockhamGenerator::hcKernWrite(transKernel, 3)
-        << "rowSizeinUnits = " << params.fft_outStride[1] << ";" << std::endl;
+        << "rowSizeinUnits = " << params.fft_outStride[1] << ";\n";
     StockhamGenerator::hcKernWrite(transKernel, 3)
         << "const size_t transposeRatio = wgTileExtent.x / ( wgTileExtent.y * "
-           "wgUnroll );"
-        << std::endl;
+           "wgUnroll );\n";
     StockhamGenerator::hcKernWrite(transKernel, 3)
-        << "const size_t groupingPerY = wgUnroll / wgTileExtent.y;"
-        << std::endl;
-    StockhamGenerator::hcKernWrite(transKernel, 3) << std::endl << std::endl;
+        << "const size_t groupingPerY = wgUnroll / wgTileExtent.y;\n";
+    StockhamGenerator::hcKernWrite(transKernel, 3) << "\n" << "\n";
 
     for (size_t i = 0; i < branchBlocks; i++) {
       if (branchingInBoth) {
         if (i == 0) {
           StockhamGenerator::hcKernWrite(transKernel, 3)
               << "if( (" << gIndexX << " == " << cornerGroupX << ") && ("
-              << gIndexY << " == " << cornerGroupY << ") )" << std::endl;
-          StockhamGenerator::hcKernWrite(transKernel, 3) << "{" << std::endl;
+              << gIndexY << " == " << cornerGroupY << ") )\n";
+          StockhamGenerator::hcKernWrite(transKernel, 3) << "{\n";
         } else if (i == 1) {
           if (!cornerGroupY) {
             continue;
           }
 
           StockhamGenerator::hcKernWrite(transKernel, 3) << "else if( " << gIndexX
-                                      << " == " << cornerGroupX << " )"
-                                      << std::endl;
-          StockhamGenerator::hcKernWrite(transKernel, 3) << "{" << std::endl;
+                                      << " == " << cornerGroupX << " )\n";
+          StockhamGenerator::hcKernWrite(transKernel, 3) << "{\n";
         } else if (i == 2) {
           if (!cornerGroupX) {
             continue;
           }
 
           StockhamGenerator::hcKernWrite(transKernel, 3) << "else if( " << gIndexY
-                                      << " == " << cornerGroupY << " )"
-                                      << std::endl;
-          StockhamGenerator::hcKernWrite(transKernel, 3) << "{" << std::endl;
+                                      << " == " << cornerGroupY << " )\n";
+          StockhamGenerator::hcKernWrite(transKernel, 3) << "{\n";
         } else {
           if ((!cornerGroupX) || (!cornerGroupY)) {
             continue;
           }
 
-          StockhamGenerator::hcKernWrite(transKernel, 3) << "else" << std::endl;
-          StockhamGenerator::hcKernWrite(transKernel, 3) << "{" << std::endl;
+          StockhamGenerator::hcKernWrite(transKernel, 3) << "else\n";
+          StockhamGenerator::hcKernWrite(transKernel, 3) << "{\n";
         }
       } else if (branchingInAny) {
         if (i == 0) {
           if (branchingInGroupX) {
             StockhamGenerator::hcKernWrite(transKernel, 3) << "if( " << gIndexX
-                                        << " == " << cornerGroupX << " )"
-                                        << std::endl;
-            StockhamGenerator::hcKernWrite(transKernel, 3) << "{" << std::endl;
+                                        << " == " << cornerGroupX << " )\n";
+            StockhamGenerator::hcKernWrite(transKernel, 3) << "{\n";
           } else {
             StockhamGenerator::hcKernWrite(transKernel, 3) << "if( " << gIndexY
-                                        << " == " << cornerGroupY << " )"
-                                        << std::endl;
-            StockhamGenerator::hcKernWrite(transKernel, 3) << "{" << std::endl;
+                                        << " == " << cornerGroupY << " )\n";
+            StockhamGenerator::hcKernWrite(transKernel, 3) << "{\n";
           }
         } else {
           if ((!cornerGroupX) || (!cornerGroupY)) {
             continue;
           }
 
-          StockhamGenerator::hcKernWrite(transKernel, 3) << "else" << std::endl;
-          StockhamGenerator::hcKernWrite(transKernel, 3) << "{" << std::endl;
+          StockhamGenerator::hcKernWrite(transKernel, 3) << "else\n";
+          StockhamGenerator::hcKernWrite(transKernel, 3) << "{\n";
         }
       }
 
-      StockhamGenerator::hcKernWrite(transKernel, 6) << "for( uint t=0; t < wgUnroll; t++ )"
-                                  << std::endl;
-      StockhamGenerator::hcKernWrite(transKernel, 6) << "{" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 6) << "for( uint t=0; t < wgUnroll; t++ )\n";
+      StockhamGenerator::hcKernWrite(transKernel, 6) << "{\n";
       StockhamGenerator::hcKernWrite(transKernel, 9)
           << "size_t xInd = localIndex.x + localExtent.x * ( localIndex.y % "
-             "groupingPerY ); "
-          << std::endl;
+             "groupingPerY ); \n";
       StockhamGenerator::hcKernWrite(transKernel, 9) << "size_t yInd = localIndex.y/groupingPerY "
-                                     "+ t * (wgTileExtent.y * transposeRatio); "
-                                  << std::endl;
-      StockhamGenerator::hcKernWrite(transKernel, 9) << "tmp = lds[ yInd ][ xInd ]; " << std::endl;
+                                     "+ t * (wgTileExtent.y * transposeRatio); \n";
+      StockhamGenerator::hcKernWrite(transKernel, 9) << "tmp = lds[ yInd ][ xInd ]; \n";
       StockhamGenerator::hcKernWrite(transKernel, 9)
-          << "size_t gInd = xInd + rowSizeinUnits * yInd;" << std::endl;
+          << "size_t gInd = xInd + rowSizeinUnits * yInd;\n";
 
       if (branchingInBoth) {
         if (i == 0) {
-          StockhamGenerator::hcKernWrite(transKernel, 9) << std::endl;
+          StockhamGenerator::hcKernWrite(transKernel, 9) << "\n";
           StockhamGenerator::hcKernWrite(transKernel, 9)
               << "if( (" << wIndexY << " < " << wIndexXEnd << ") && ("
-              << wIndexX << " < " << wIndexYEnd << ") )" << std::endl;
-          StockhamGenerator::hcKernWrite(transKernel, 9) << "{" << std::endl;
+              << wIndexX << " < " << wIndexYEnd << ") )\n";
+          StockhamGenerator::hcKernWrite(transKernel, 9) << "{\n";
         } else if (i == 1) {
-          StockhamGenerator::hcKernWrite(transKernel, 9) << std::endl;
+          StockhamGenerator::hcKernWrite(transKernel, 9) << "\n";
           StockhamGenerator::hcKernWrite(transKernel, 9) << "if( (" << wIndexY << " < "
-                                      << wIndexXEnd << ") )" << std::endl;
-          StockhamGenerator::hcKernWrite(transKernel, 9) << "{" << std::endl;
+                                      << wIndexXEnd << ") )\n";
+          StockhamGenerator::hcKernWrite(transKernel, 9) << "{\n";
         } else if (i == 2) {
-          StockhamGenerator::hcKernWrite(transKernel, 9) << std::endl;
+          StockhamGenerator::hcKernWrite(transKernel, 9) << "\n";
           StockhamGenerator::hcKernWrite(transKernel, 9) << "if( (" << wIndexX << " < "
-                                      << wIndexYEnd << ") )" << std::endl;
-          StockhamGenerator::hcKernWrite(transKernel, 9) << "{" << std::endl;
+                                      << wIndexYEnd << ") )\n";
+          StockhamGenerator::hcKernWrite(transKernel, 9) << "{\n";
         } else {
-          StockhamGenerator::hcKernWrite(transKernel, 9) << "{" << std::endl;
+          StockhamGenerator::hcKernWrite(transKernel, 9) << "{\n";
         }
       } else if (branchingInAny) {
         std::string limitToWGForRealSpecial =
@@ -812,7 +771,7 @@ static hcfftStatus genTransposeKernel(
 
         if (i == 0) {
           if (branchingInGroupX) {
-            StockhamGenerator::hcKernWrite(transKernel, 9) << std::endl;
+            StockhamGenerator::hcKernWrite(transKernel, 9) << "\n";
 
             if (params.fft_realSpecial) {
               StockhamGenerator::hcKernWrite(transKernel, 9)
@@ -822,19 +781,18 @@ static hcfftStatus genTransposeKernel(
 
               if (wIndexXEnd > 1) {
                 StockhamGenerator::hcKernWrite(transKernel, 0) << "|| (" << wIndexY << " < "
-                                            << wIndexXEnd - 1 << ") )"
-                                            << std::endl;
+                                            << wIndexXEnd - 1 << ") )\n";
               } else {
-                StockhamGenerator::hcKernWrite(transKernel, 0) << ")" << std::endl;
+                StockhamGenerator::hcKernWrite(transKernel, 0) << ")\n";
               }
             } else {
               StockhamGenerator::hcKernWrite(transKernel, 9) << "if( (" << wIndexY << " < "
-                                          << wIndexXEnd << ") )" << std::endl;
+                                          << wIndexXEnd << ") )\n";
             }
 
-            StockhamGenerator::hcKernWrite(transKernel, 9) << "{" << std::endl;
+            StockhamGenerator::hcKernWrite(transKernel, 9) << "{\n";
           } else {
-            StockhamGenerator::hcKernWrite(transKernel, 9) << std::endl;
+            StockhamGenerator::hcKernWrite(transKernel, 9) << "\n";
 
             if (params.fft_realSpecial) {
               StockhamGenerator::hcKernWrite(transKernel, 9)
@@ -844,34 +802,31 @@ static hcfftStatus genTransposeKernel(
 
               if (wIndexYEnd > 1) {
                 StockhamGenerator::hcKernWrite(transKernel, 0) << "|| (" << wIndexX << " < "
-                                            << wIndexYEnd - 1 << ") )"
-                                            << std::endl;
+                                            << wIndexYEnd - 1 << ") )\n";
               } else {
-                StockhamGenerator::hcKernWrite(transKernel, 0) << ")" << std::endl;
+                StockhamGenerator::hcKernWrite(transKernel, 0) << ")\n";
               }
             } else {
               StockhamGenerator::hcKernWrite(transKernel, 9) << "if( (" << wIndexX << " < "
-                                          << wIndexYEnd << ") )" << std::endl;
+                                          << wIndexYEnd << ") )\n";
             }
 
-            StockhamGenerator::hcKernWrite(transKernel, 9) << "{" << std::endl;
+            StockhamGenerator::hcKernWrite(transKernel, 9) << "{\n";
           }
         } else {
-          StockhamGenerator::hcKernWrite(transKernel, 9) << "{" << std::endl;
+          StockhamGenerator::hcKernWrite(transKernel, 9) << "{\n";
         }
       }
 
       switch (params.fft_outputLayout) {
         case HCFFT_COMPLEX_INTERLEAVED:
           StockhamGenerator::hcKernWrite(transKernel, 9)
-              << "pmComplexOut[ gInd + outOffset] = tmp;" << std::endl;
+              << "pmComplexOut[ gInd + outOffset] = tmp;\n";
           break;
 
         case HCFFT_COMPLEX_PLANAR:
-          StockhamGenerator::hcKernWrite(transKernel, 9) << "pmRealOut[ gInd + outOffset] = tmp.x;"
-                                      << std::endl;
-          StockhamGenerator::hcKernWrite(transKernel, 9) << "pmImagOut[ gInd + outOffset] = tmp.y;"
-                                      << std::endl;
+          StockhamGenerator::hcKernWrite(transKernel, 9) << "pmRealOut[ gInd + outOffset] = tmp.x;\n";
+          StockhamGenerator::hcKernWrite(transKernel, 9) << "pmImagOut[ gInd + outOffset] = tmp.y;\n";
           break;
 
         case HCFFT_HERMITIAN_INTERLEAVED:
@@ -879,23 +834,22 @@ static hcfftStatus genTransposeKernel(
           return HCFFT_INVALID;
 
         case HCFFT_REAL:
-          StockhamGenerator::hcKernWrite(transKernel, 9) << "pmRealOut[ gInd + outOffset] = tmp;"
-                                      << std::endl;
+          StockhamGenerator::hcKernWrite(transKernel, 9) << "pmRealOut[ gInd + outOffset] = tmp;\n";
           break;
       }
 
       if (branchingInAny) {
-        StockhamGenerator::hcKernWrite(transKernel, 9) << "}" << std::endl;
+        StockhamGenerator::hcKernWrite(transKernel, 9) << "}\n";
       }
 
-      StockhamGenerator::hcKernWrite(transKernel, 6) << "}" << std::endl;
+      StockhamGenerator::hcKernWrite(transKernel, 6) << "}\n";
 
       if (branchingInAny) {
-        StockhamGenerator::hcKernWrite(transKernel, 3) << "}" << std::endl;
+        StockhamGenerator::hcKernWrite(transKernel, 3) << "}\n";
       }
     }
 
-    StockhamGenerator::hcKernWrite(transKernel, 0) << "}).wait();\n}}\n" << std::endl;
+    StockhamGenerator::hcKernWrite(transKernel, 0) << "}).wait();\n}}\n\n";
     strKernel = transKernel.str();
 
     if (!params.fft_3StepTwiddle) {
@@ -1006,7 +960,13 @@ hcfftStatus FFTPlan::GetWorkSizesPvt<Transpose_GCN>(
   this->GetKernelGenKeyPvt<Transpose_GCN>(fftParams);
   size_t loopCount = 0;
   tile blockSize = {0, 0};
-  CalculateBlockSize(fftParams.fft_precision, loopCount, blockSize);
+  hcfftStatus status =
+      CalculateBlockSize(fftParams.fft_precision, loopCount, blockSize);
+
+  if (status != HCFFT_SUCCEEDS) {
+    return status;
+  }
+
   // We need to make sure that the global work size is evenly divisible by the
   // local work size
   // Our transpose works in tiles, so divide tiles in each dimension to get
@@ -1037,6 +997,33 @@ hcfftStatus FFTPlan::GetWorkSizesPvt<Transpose_GCN>(
   return HCFFT_SUCCEEDS;
 }
 
+template <>
+hcfftStatus FFTPlan::GetKernelCostPvt<Transpose_GCN>(
+    FFTKernelCost* cost) const {
+  FFTKernelGenKeyParams fftParams;
+  std::vector<size_t> globalWS, localWS;
+  this->GetKernelGenKeyPvt<Transpose_GCN>(fftParams);
+  hcfftStatus status = this->GetWorkSizesPvt<Transpose_GCN>(globalWS, localWS);
+
+  if (status != HCFFT_SUCCEEDS) {
+    return status;
+  }
+
+  size_t loopCount = 0;
+  tile blockSize = {0, 0};
+  CalculateBlockSize(fftParams.fft_precision, loopCount, blockSize);
+  cost->gen = Transpose_GCN;
+  cost->name = fftParams.fft_3StepTwiddle ? "transpose_gcn_tw_fwd"
+                                          : "transpose_gcn";
+  cost->globalSize = globalWS[0] * globalWS[1];
+  cost->localSize = localWS[0] * localWS[1];
+  // One block per work group, staged through LDS behind a single barrier
+  hcfft_transpose_generator::TransposeCost(
+      *this, fftParams, 1,
+      blockSize.x * blockSize.y / (lwSize.x * lwSize.y), cost);
+  return HCFFT_SUCCEEDS;
+}
+
 //  Feed this generator the FFTPlan, and it returns the generated program as a
 //  string
 template <>
@@ -1052,7 +1039,13 @@ hcfftStatus FFTPlan::GenerateKernelPvt<Transpose_GCN>(
     CalculateBlockSize(fftParams.fft_precision, loopCount, blockSize);
     std::vector<size_t> gWorkSize;
     std::vector<size_t> lWorkSize;
-    this->GetWorkSizesPvt<Transpose_GCN>(gWorkSize, lWorkSize);
+    hcfftStatus status =
+        this->GetWorkSizesPvt<Transpose_GCN>(gWorkSize, lWorkSize);
+
+    if (status != HCFFT_SUCCEEDS) {
+      return status;
+    }
+
     std::string programHeader, programCode;
     programHeader = hcHeader();
     genTransposeKernel((void**)&twiddleslarge, acc, plHandle, fftParams,
@@ -30,16 +30,16 @@ THE SOFTWARE.
 namespace hcfft_transpose_generator {
 // generating string for calculating offset within sqaure transpose kernels
 // (genTransposeKernelBatched)
-void OffsetCalculation(std::stringstream& transKernel,
+void OffsetCalculation(CodeEmitter& transKernel,
                        const FFTKernelGenKeyParams& params, bool input);
 
 // generating string for calculating offset within sqaure transpose kernels
 // (genTransposeKernelLeadingDimensionBatched)
-void OffsetCalcLeadingDimensionBatched(std::stringstream& transKernel,
+void OffsetCalcLeadingDimensionBatched(CodeEmitter& transKernel,
                                        const FFTKernelGenKeyParams& params);
 
 // generating string for calculating offset within swap kernels (genSwapKernel)
-void Swap_OffsetCalc(std::stringstream& transKernel,
+void Swap_OffsetCalc(CodeEmitter& transKernel,
                      const FFTKernelGenKeyParams& params);
 
 // Small snippet of code that multiplies the twiddle factors into the
@@ -48,7 +48,7 @@ void Swap_OffsetCalc(std::stringstream& transKernel,
 // transpose
 hcfftStatus genTwiddleMath(const hcfftPlanHandle plHandle,
                            const FFTKernelGenKeyParams& params,
-                           std::stringstream& transKernel,
+                           CodeEmitter& transKernel,
                            const std::string& dtComplex, bool fwd);
 
 // Small snippet of code that multiplies the twiddle factors into the
@@ -57,12 +57,12 @@ hcfftStatus genTwiddleMath(const hcfftPlanHandle plHandle,
 // transpose
 hcfftStatus genTwiddleMathLeadingDimensionBatched(
     const hcfftPlanHandle plHandle, const FFTKernelGenKeyParams& params,
-    std::stringstream& transKernel, const std::string& dtComplex, bool fwd);
+    CodeEmitter& transKernel, const std::string& dtComplex, bool fwd);
 
 hcfftStatus genTransposePrototype(
     const FFTKernelGenKeyParams& params, const size_t& lwSize,
     const std::string& dtPlanar, const std::string& dtComplex,
-    const std::string& funcName, std::stringstream& transKernel,
+    const std::string& funcName, CodeEmitter& transKernel,
     std::string& dtInput, std::string& dtOutput, bool twiddleTransposeKernel);
 
 /* -> get_cycles function gets the swapping logic required for given row x col
@@ -129,6 +129,11 @@ hcfftStatus genTransposeKernelLeadingDimensionBatched(
     const size_t& lwSize, const size_t reShapeFactor,
     std::vector<size_t> gWorkSize, std::vector<size_t> lWorkSize, size_t count);
 
+// Static cost shared by the transpose generators: all data of the plan goes
+// through LDS once, each work-item holding 'perWorkItem' values of its tile
+void TransposeCost(const FFTPlan& plan, const FFTKernelGenKeyParams& params,
+                   size_t barriers, size_t perWorkItem, FFTKernelCost* cost);
+
 }  // end of namespace hcfft_transpose_generator
 
 #endif  // LIB_SRC_GENERATOR_TRANSPOSE_H_
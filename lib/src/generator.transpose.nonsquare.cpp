@@ -302,6 +302,34 @@ hcfftStatus FFTPlan::GetWorkSizesPvt<Transpose_NONSQUARE>(
   return HCFFT_SUCCEEDS;
 }
 
+template <>
+hcfftStatus FFTPlan::GetKernelCostPvt<Transpose_NONSQUARE>(
+    FFTKernelCost* cost) const {
+  FFTKernelGenKeyParams params;
+  std::vector<size_t> globalWS, localWS;
+  this->GetKernelGenKeyPvt<Transpose_NONSQUARE>(params);
+  this->GetWorkSizesPvt<Transpose_NONSQUARE>(globalWS, localWS);
+  cost->gen = Transpose_NONSQUARE;
+  cost->name = "transpose_nonsquare";
+
+  if ((params.nonSquareKernelType ==
+       NON_SQUARE_TRANS_TRANSPOSE_BATCHED_LEADING) &&
+      params.fft_3StepTwiddle) {
+    cost->name = "transpose_nonsquare_tw_fwd";
+  } else if (params.nonSquareKernelType ==
+             NON_SQUARE_TRANS_TRANSPOSE_BATCHED) {
+    cost->name = "transpose_square";
+  }
+
+  cost->globalSize = globalWS[0];
+  cost->localSize = localWS[0];
+  // Work groups swap a pair of tiles, with a barrier for each
+  size_t tileSize = 16 * reShapeFactor;
+  hcfft_transpose_generator::TransposeCost(
+      *this, params, 2, 2 * tileSize * tileSize / lwSize, cost);
+  return HCFFT_SUCCEEDS;
+}
+
 //  Feed this generator the FFTPlan, and it returns the generated program as a
 //  string
 
@@ -120,6 +120,25 @@ hcfftStatus FFTPlan::GetWorkSizesPvt<Transpose_SQUARE>(
   return HCFFT_SUCCEEDS;
 }
 
+template <>
+hcfftStatus FFTPlan::GetKernelCostPvt<Transpose_SQUARE>(
+    FFTKernelCost* cost) const {
+  FFTKernelGenKeyParams params;
+  std::vector<size_t> globalWS, localWS;
+  this->GetKernelGenKeyPvt<Transpose_SQUARE>(params);
+  this->GetWorkSizesPvt<Transpose_SQUARE>(globalWS, localWS);
+  cost->gen = Transpose_SQUARE;
+  cost->name = params.fft_3StepTwiddle ? "transpose_square_tw_fwd"
+                                       : "transpose_square";
+  cost->globalSize = globalWS[0];
+  cost->localSize = localWS[0];
+  // Work groups swap a pair of tiles, with a barrier for each
+  size_t tileSize = 16 * reShapeFactor;
+  hcfft_transpose_generator::TransposeCost(
+      *this, params, 2, 2 * tileSize * tileSize / lwSize, cost);
+  return HCFFT_SUCCEEDS;
+}
+
 //  Feed this generator the FFTPlan, and it returns the generated program as a
 //  string
 template <>
@@ -23,6 +23,7 @@ THE SOFTWARE.
 #include "include/hipfft.h"
 #include "include/hcfft.h"
 #include <iostream>
+#include <vector>
 
 #ifdef __cplusplus
 extern "C" {
@@ -77,6 +78,12 @@ hcfftType hipHIPFFTTypeToHCFFTType(hipfftType hipType) {
       return HCFFT_Z2D;
     case HIPFFT_Z2Z:
       return HCFFT_Z2Z;
+    case HIPFFT_R2C_HALF:
+      return HCFFT_R2C_HALF;
+    case HIPFFT_C2R_HALF:
+      return HCFFT_C2R_HALF;
+    case HIPFFT_C2C_HALF:
+      return HCFFT_C2C_HALF;
     default:
       throw "Unimplemented Type";
   }
@@ -127,10 +134,41 @@ hipfftResult hipfftPlan3d(hipfftHandle *plan, int nx, int ny, int nz,
       hcfftPlan3d(plan, nz, ny, nx, hipHIPFFTTypeToHCFFTType(type)));
 }
 
+// hipfft/cufft list the slowest axis first, hcfftPlanNd the fastest; NULL
+// embeds mean packed data and make the stride and distance arguments unused
 hipfftResult hipfftPlanMany(hipfftHandle *plan, int rank, int *n, int *inembed,
                             int istride, int idist, int *onembed, int ostride,
                             int odist, hipfftType type, int batch) {
-  return HIPFFT_RESULT_NOT_SUPPORTED;
+  if (n == NULL || rank < 1) {
+    return HIPFFT_INVALID_VALUE;
+  }
+
+  std::vector<int> length(rank), inStride(rank), outStride(rank);
+
+  for (int i = 0; i < rank; i++) {
+    length[i] = n[rank - 1 - i];
+  }
+
+  if (inembed != NULL) {
+    inStride[0] = istride;
+
+    for (int i = 1; i < rank; i++) {
+      inStride[i] = inStride[i - 1] * inembed[rank - i];
+    }
+  }
+
+  if (onembed != NULL) {
+    outStride[0] = ostride;
+
+    for (int i = 1; i < rank; i++) {
+      outStride[i] = outStride[i - 1] * onembed[rank - i];
+    }
+  }
+
+  return hipHCFFTResultToHIPFFTResult(hcfftPlanNd(
+      plan, rank, length.data(), inembed ? inStride.data() : NULL,
+      inembed ? idist : 0, onembed ? outStride.data() : NULL,
+      onembed ? odist : 0, batch, hipHIPFFTTypeToHCFFTType(type)));
 }
 
 /*hipFFT Extensible Plans*/
@@ -276,6 +314,23 @@ hipfftResult hipfftExecZ2D(hipfftHandle plan, hipfftDoubleComplex *idata,
       hcfftExecZ2D(plan, (hcfftDoubleComplex *)idata, odata));
 }
 
+hipfftResult hipfftExecC2CHalf(hipfftHandle plan, hipfftHalfComplex *idata,
+                               hipfftHalfComplex *odata, int direction) {
+  return hipHCFFTResultToHIPFFTResult(
+      hcfftExecC2CHalf(plan, idata, odata,
+                       hipHIPFFTDirectionToHCFFTDirection(direction)));
+}
+
+hipfftResult hipfftExecR2CHalf(hipfftHandle plan, hipfftHalf *idata,
+                               hipfftHalfComplex *odata) {
+  return hipHCFFTResultToHIPFFTResult(hcfftExecR2CHalf(plan, idata, odata));
+}
+
+hipfftResult hipfftExecC2RHalf(hipfftHandle plan, hipfftHalfComplex *idata,
+                               hipfftHalf *odata) {
+  return hipHCFFTResultToHIPFFTResult(hcfftExecC2RHalf(plan, idata, odata));
+}
+
 #ifdef __cplusplus
 }
 #endif
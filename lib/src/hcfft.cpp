@@ -20,6 +20,9 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 */
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
 #include "include/hcfft.h"
 #include "include/hcfftlib.h"
 
@@ -29,20 +32,36 @@ thread_local FFTPlan planObject;
 #else
 FFTPlan planObject;
 #endif
+// GPU accelerators in the order of hc::accelerator::get_all(), without the
+// CPU fallback
+static std::vector<hc::accelerator> GetGPUs() {
+  std::vector<hc::accelerator> accs = hc::accelerator::get_all();
+  std::vector<hc::accelerator> gpus;
+
+  for (size_t i = 0; i < accs.size(); i++) {
+    if (!accs[i].get_is_emulated()) {
+      gpus.push_back(accs[i]);
+    }
+  }
+
+  return gpus;
+}
+
 /* Function hcfftXtSetGPUs()
 Returns GPUs are to be used with the plan
 */
 hcfftResult hcfftXtSetGPUs(hc::accelerator& acc) {
-  std::vector<hc::accelerator> accs = hc::accelerator::get_all();
+  std::vector<hc::accelerator> gpus = GetGPUs();
 
-  if (accs.size() == 0) {
+  if (gpus.size() == 0) {
     std::wcout << "There is no acclerator!\n";
     // Since this case is to test on GPU device, skip if there is CPU only
     return HCFFT_SETUP_FAILED;
   }
 
-  assert(accs.size() && "Number of Accelerators == 0!");
-  acc = accs[1];
+  // Plans start on the default accelerator; hcfftSetStream() and
+  // hcfftXtSetAccelerators() move them
+  acc = hc::accelerator();
   return HCFFT_SUCCESS;
 }
 
@@ -140,6 +159,21 @@ hcfftResult hcfftPlan1d(hcfftHandle* plan, int nx, hcfftType type) {
       direction = HCFFT_BOTH;
       break;
 
+    case HCFFT_R2C_HALF:
+      precision = HCFFT_HALF;
+      direction = HCFFT_FORWARD;
+      break;
+
+    case HCFFT_C2R_HALF:
+      precision = HCFFT_HALF;
+      direction = HCFFT_BACKWARD;
+      break;
+
+    case HCFFT_C2C_HALF:
+      precision = HCFFT_HALF;
+      direction = HCFFT_BOTH;
+      break;
+
     default:
       // Invalid type
       return HCFFT_INVALID_VALUE;
@@ -174,12 +208,14 @@ hcfftResult hcfftPlan1d(hcfftHandle* plan, int nx, hcfftType type) {
   }
 
   hcfftLibType libType =
-      ((type == HCFFT_R2C || type == HCFFT_D2Z)
+      ((type == HCFFT_R2C || type == HCFFT_D2Z || type == HCFFT_R2C_HALF)
            ? HCFFT_R2CD2Z
-           : (type == HCFFT_C2R || type == HCFFT_Z2D)
+           : (type == HCFFT_C2R || type == HCFFT_Z2D || type == HCFFT_C2R_HALF)
                  ? HCFFT_C2RZ2D
-                 : (type == HCFFT_C2C || type == HCFFT_Z2Z) ? HCFFT_C2CZ2Z
-                                                            : (hcfftLibType)0);
+                 : (type == HCFFT_C2C || type == HCFFT_Z2Z ||
+                    type == HCFFT_C2C_HALF)
+                       ? HCFFT_C2CZ2Z
+                       : (hcfftLibType)0);
 
   switch (libType) {
     case HCFFT_R2CD2Z:
@@ -335,6 +371,21 @@ hcfftResult hcfftPlan2d(hcfftHandle* plan, int nx, int ny, hcfftType type) {
       direction = HCFFT_BOTH;
       break;
 
+    case HCFFT_R2C_HALF:
+      precision = HCFFT_HALF;
+      direction = HCFFT_FORWARD;
+      break;
+
+    case HCFFT_C2R_HALF:
+      precision = HCFFT_HALF;
+      direction = HCFFT_BACKWARD;
+      break;
+
+    case HCFFT_C2C_HALF:
+      precision = HCFFT_HALF;
+      direction = HCFFT_BOTH;
+      break;
+
     default:
       // Invalid type
       return HCFFT_INVALID_VALUE;
@@ -370,12 +421,14 @@ hcfftResult hcfftPlan2d(hcfftHandle* plan, int nx, int ny, hcfftType type) {
   }
 
   hcfftLibType libType =
-      ((type == HCFFT_R2C || type == HCFFT_D2Z)
+      ((type == HCFFT_R2C || type == HCFFT_D2Z || type == HCFFT_R2C_HALF)
            ? HCFFT_R2CD2Z
-           : (type == HCFFT_C2R || type == HCFFT_Z2D)
+           : (type == HCFFT_C2R || type == HCFFT_Z2D || type == HCFFT_C2R_HALF)
                  ? HCFFT_C2RZ2D
-                 : (type == HCFFT_C2C || type == HCFFT_Z2Z) ? HCFFT_C2CZ2Z
-                                                            : (hcfftLibType)0);
+                 : (type == HCFFT_C2C || type == HCFFT_Z2Z ||
+                    type == HCFFT_C2C_HALF)
+                       ? HCFFT_C2CZ2Z
+                       : (hcfftLibType)0);
 
   switch (libType) {
     case HCFFT_R2CD2Z:
@@ -540,6 +593,21 @@ hcfftResult hcfftPlan3d(hcfftHandle* plan, int nx, int ny, int nz,
       direction = HCFFT_BOTH;
       break;
 
+    case HCFFT_R2C_HALF:
+      precision = HCFFT_HALF;
+      direction = HCFFT_FORWARD;
+      break;
+
+    case HCFFT_C2R_HALF:
+      precision = HCFFT_HALF;
+      direction = HCFFT_BACKWARD;
+      break;
+
+    case HCFFT_C2C_HALF:
+      precision = HCFFT_HALF;
+      direction = HCFFT_BOTH;
+      break;
+
     default:
       // Invalid type
       return HCFFT_INVALID_VALUE;
@@ -576,12 +644,14 @@ hcfftResult hcfftPlan3d(hcfftHandle* plan, int nx, int ny, int nz,
   }
 
   hcfftLibType libType =
-      ((type == HCFFT_R2C || type == HCFFT_D2Z)
+      ((type == HCFFT_R2C || type == HCFFT_D2Z || type == HCFFT_R2C_HALF)
            ? HCFFT_R2CD2Z
-           : (type == HCFFT_C2R || type == HCFFT_Z2D)
+           : (type == HCFFT_C2R || type == HCFFT_Z2D || type == HCFFT_C2R_HALF)
                  ? HCFFT_C2RZ2D
-                 : (type == HCFFT_C2C || type == HCFFT_Z2Z) ? HCFFT_C2CZ2Z
-                                                            : (hcfftLibType)0);
+                 : (type == HCFFT_C2C || type == HCFFT_Z2Z ||
+                    type == HCFFT_C2C_HALF)
+                       ? HCFFT_C2CZ2Z
+                       : (hcfftLibType)0);
 
   switch (libType) {
     case HCFFT_R2CD2Z:
@@ -682,6 +752,214 @@ hcfftResult hcfftPlan3d(hcfftHandle* plan, int nx, int ny, int nz,
   return HCFFT_SUCCESS;
 }
 
+/* Function hcfftPlanNd()
+   Description:
+      Creates a rank-N FFT plan configuration from a length vector and optional
+   stride vectors. Axis 0 is the fastest varying. NULL strides select packed
+   data, and a zero distance is derived from the strides.
+
+   Return Values:
+   ----------------------------------------------------------------------------------------------
+   HCFFT_SUCCESS          hcFFT successfully created the FFT plan.
+   HCFFT_ALLOC_FAILED     The allocation of GPU resources for the plan failed.
+   HCFFT_INVALID_VALUE    One or more invalid parameters were passed to the API.
+   HCFFT_SETUP_FAILED     The hcFFT library failed to initialize.
+   HCFFT_INVALID_SIZE     The rank, one of the sizes or batch is not supported.
+*/
+
+hcfftResult hcfftPlanNd(hcfftHandle* plan, int rank, const int* n,
+                        const int* inStride, int iDist, const int* outStride,
+                        int oDist, int batch, hcfftType type) {
+  if (plan == NULL || n == NULL) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  if (rank < 1 || rank > HCFFT_MAXDIM || batch < 1) {
+    return HCFFT_INVALID_SIZE;
+  }
+
+  // Check the input type and set appropriate direction and precision
+  hcfftDirection direction;
+  hcfftPrecision precision;
+
+  switch (type) {
+    case HCFFT_R2C:
+      precision = HCFFT_SINGLE;
+      direction = HCFFT_FORWARD;
+      break;
+
+    case HCFFT_C2R:
+      precision = HCFFT_SINGLE;
+      direction = HCFFT_BACKWARD;
+      break;
+
+    case HCFFT_C2C:
+      precision = HCFFT_SINGLE;
+      direction = HCFFT_BOTH;
+      break;
+
+    case HCFFT_D2Z:
+      precision = HCFFT_DOUBLE;
+      direction = HCFFT_FORWARD;
+      break;
+
+    case HCFFT_Z2D:
+      precision = HCFFT_DOUBLE;
+      direction = HCFFT_BACKWARD;
+      break;
+
+    case HCFFT_Z2Z:
+      precision = HCFFT_DOUBLE;
+      direction = HCFFT_BOTH;
+      break;
+
+    case HCFFT_R2C_HALF:
+      precision = HCFFT_HALF;
+      direction = HCFFT_FORWARD;
+      break;
+
+    case HCFFT_C2R_HALF:
+      precision = HCFFT_HALF;
+      direction = HCFFT_BACKWARD;
+      break;
+
+    case HCFFT_C2C_HALF:
+      precision = HCFFT_HALF;
+      direction = HCFFT_BOTH;
+      break;
+
+    default:
+      // Invalid type
+      return HCFFT_INVALID_VALUE;
+  }
+
+  hcfftLibType libType =
+      ((type == HCFFT_R2C || type == HCFFT_D2Z || type == HCFFT_R2C_HALF)
+           ? HCFFT_R2CD2Z
+           : (type == HCFFT_C2R || type == HCFFT_Z2D || type == HCFFT_C2R_HALF)
+                 ? HCFFT_C2RZ2D
+                 : HCFFT_C2CZ2Z);
+  std::vector<size_t> length(rank);
+
+  for (int i = 0; i < rank; i++) {
+    if (n[i] <= 0) {
+      // invalid size
+      return HCFFT_INVALID_SIZE;
+    }
+
+    length[i] = n[i];
+  }
+
+  // Element counts of the input and output sides; the first axis of the
+  // complex side of a real transform is halved
+  std::vector<size_t> ipLength(length), opLength(length);
+
+  if (libType == HCFFT_R2CD2Z) {
+    opLength[0] = 1 + length[0] / 2;
+  } else if (libType == HCFFT_C2RZ2D) {
+    ipLength[0] = 1 + length[0] / 2;
+  }
+
+  std::vector<size_t> ipStrides(rank), opStrides(rank);
+  size_t ipDistance = 0, opDistance = 0;
+  size_t ipPacked = 1, opPacked = 1;
+
+  for (int i = 0; i < rank; i++) {
+    ipStrides[i] = inStride ? inStride[i] : ipPacked;
+    opStrides[i] = outStride ? outStride[i] : opPacked;
+    ipPacked *= ipLength[i];
+    opPacked *= opLength[i];
+
+    if (ipStrides[i] == 0 || opStrides[i] == 0) {
+      return HCFFT_INVALID_VALUE;
+    }
+
+    ipDistance = std::max(ipDistance, ipStrides[i] * ipLength[i]);
+    opDistance = std::max(opDistance, opStrides[i] * opLength[i]);
+  }
+
+  if (iDist > 0) {
+    ipDistance = iDist;
+  }
+
+  if (oDist > 0) {
+    opDistance = oDist;
+  }
+
+  // Allocate Rawplan
+  hcfftResult res = hcfftCreate(plan);
+
+  if (res != HCFFT_SUCCESS) {
+    return HCFFT_ALLOC_FAILED;
+  }
+
+  hc::accelerator acc;
+  res = hcfftXtSetGPUs(acc);
+
+  if (res != HCFFT_SUCCESS) {
+    return HCFFT_SETUP_FAILED;
+  }
+
+  hcfftStatus status = planObject.hcfftCreateDefaultPlan(
+      plan, rank, length.data(), direction, precision, libType);
+
+  if (status == HCFFT_ERROR || status == HCFFT_INVALID) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  status = planObject.hcfftSetPlanPrecision(*plan, precision);
+
+  if (status != HCFFT_SUCCEEDS) {
+    return HCFFT_SETUP_FAILED;
+  }
+
+  status = planObject.hcfftSetPlanTransposeResult(*plan, HCFFT_NOTRANSPOSE);
+
+  if (status != HCFFT_SUCCEEDS) {
+    return HCFFT_SETUP_FAILED;
+  }
+
+  status = planObject.hcfftSetResultLocation(*plan, HCFFT_OUTOFPLACE);
+
+  if (status != HCFFT_SUCCEEDS) {
+    return HCFFT_SETUP_FAILED;
+  }
+
+  status = planObject.hcfftSetPlanInStride(*plan, rank, ipStrides.data());
+
+  if (status != HCFFT_SUCCEEDS) {
+    return HCFFT_SETUP_FAILED;
+  }
+
+  status = planObject.hcfftSetPlanOutStride(*plan, rank, opStrides.data());
+
+  if (status != HCFFT_SUCCEEDS) {
+    return HCFFT_SETUP_FAILED;
+  }
+
+  status = planObject.hcfftSetPlanDistance(*plan, ipDistance, opDistance);
+
+  if (status != HCFFT_SUCCEEDS) {
+    return HCFFT_SETUP_FAILED;
+  }
+
+  status = planObject.hcfftSetPlanBatchSize(*plan, batch);
+
+  if (status != HCFFT_SUCCEEDS) {
+    return HCFFT_SETUP_FAILED;
+  }
+
+  if (libType == HCFFT_C2RZ2D) {
+    status = planObject.hcfftSetPlanScale(*plan, direction, 1.0);
+
+    if (status != HCFFT_SUCCEEDS) {
+      return HCFFT_SETUP_FAILED;
+    }
+  }
+
+  return HCFFT_SUCCESS;
+}
+
 /* Function hcfftDestroy()
    Description:
       Frees all GPU resources associated with a hcFFT plan and destroys the
@@ -755,30 +1033,18 @@ hcfftResult hcfftExecR2C(hcfftHandle plan, hcfftReal* idata,
   hcfftDirection dir = HCFFT_FORWARD;
   hcfftReal* odataR = (hcfftReal*)odata;
   hcfftStatus status;
-
-  if (idata == odataR) {
-    status = planObject.hcfftSetResultLocation(plan, HCFFT_INPLACE);
-
-    if (status != HCFFT_SUCCEEDS) {
-      return HCFFT_SETUP_FAILED;
-    }
-  }
-
-  status =
-      planObject.hcfftSetLayout(plan, HCFFT_REAL, HCFFT_HERMITIAN_INTERLEAVED);
-
-  if (status != HCFFT_SUCCEEDS) {
-    return HCFFT_SETUP_FAILED;
-  }
-
-  status = planObject.hcfftBakePlan(plan);
+  hcfftResLocation placeness =
+      (idata == odataR) ? HCFFT_INPLACE : HCFFT_OUTOFPLACE;
+  hcfftPlanHandle execPlan;
+  status = planObject.hcfftGetExecPlan(plan, placeness, HCFFT_REAL,
+                                       HCFFT_HERMITIAN_INTERLEAVED, &execPlan);
 
   if (status != HCFFT_SUCCEEDS) {
     return HCFFT_SETUP_FAILED;
   }
 
-  status =
-      planObject.hcfftEnqueueTransform<float>(plan, dir, idata, odataR, NULL);
+  status = planObject.hcfftEnqueueTransform<float>(execPlan, dir, idata,
+                                                   odataR, NULL);
 
   if (status != HCFFT_SUCCEEDS) {
     return HCFFT_EXEC_FAILED;
@@ -798,30 +1064,18 @@ hcfftResult hcfftExecD2Z(hcfftHandle plan, hcfftDoubleReal* idata,
   hcfftDirection dir = HCFFT_FORWARD;
   hcfftDoubleReal* odataR = (hcfftDoubleReal*)odata;
   hcfftStatus status;
-
-  if (idata == odataR) {
-    status = planObject.hcfftSetResultLocation(plan, HCFFT_INPLACE);
-
-    if (status != HCFFT_SUCCEEDS) {
-      return HCFFT_SETUP_FAILED;
-    }
-  }
-
-  status =
-      planObject.hcfftSetLayout(plan, HCFFT_REAL, HCFFT_HERMITIAN_INTERLEAVED);
-
-  if (status != HCFFT_SUCCEEDS) {
-    return HCFFT_SETUP_FAILED;
-  }
-
-  status = planObject.hcfftBakePlan(plan);
+  hcfftResLocation placeness =
+      (idata == odataR) ? HCFFT_INPLACE : HCFFT_OUTOFPLACE;
+  hcfftPlanHandle execPlan;
+  status = planObject.hcfftGetExecPlan(plan, placeness, HCFFT_REAL,
+                                       HCFFT_HERMITIAN_INTERLEAVED, &execPlan);
 
   if (status != HCFFT_SUCCEEDS) {
     return HCFFT_SETUP_FAILED;
   }
 
-  status =
-      planObject.hcfftEnqueueTransform<double>(plan, dir, idata, odataR, NULL);
+  status = planObject.hcfftEnqueueTransform<double>(execPlan, dir, idata,
+                                                    odataR, NULL);
 
   if (status != HCFFT_SUCCEEDS) {
     return HCFFT_EXEC_FAILED;
@@ -876,30 +1130,18 @@ hcfftResult hcfftExecC2R(hcfftHandle plan, hcfftComplex* idata,
   hcfftDirection dir = HCFFT_BACKWARD;
   hcfftReal* idataR = (hcfftReal*)idata;
   hcfftStatus status;
-
-  if (idataR == odata) {
-    status = planObject.hcfftSetResultLocation(plan, HCFFT_INPLACE);
-
-    if (status != HCFFT_SUCCEEDS) {
-      return HCFFT_SETUP_FAILED;
-    }
-  }
-
-  status =
-      planObject.hcfftSetLayout(plan, HCFFT_HERMITIAN_INTERLEAVED, HCFFT_REAL);
-
-  if (status != HCFFT_SUCCEEDS) {
-    return HCFFT_SETUP_FAILED;
-  }
-
-  status = planObject.hcfftBakePlan(plan);
+  hcfftResLocation placeness =
+      (idataR == odata) ? HCFFT_INPLACE : HCFFT_OUTOFPLACE;
+  hcfftPlanHandle execPlan;
+  status = planObject.hcfftGetExecPlan(
+      plan, placeness, HCFFT_HERMITIAN_INTERLEAVED, HCFFT_REAL, &execPlan);
 
   if (status != HCFFT_SUCCEEDS) {
     return HCFFT_SETUP_FAILED;
   }
 
-  status =
-      planObject.hcfftEnqueueTransform<float>(plan, dir, idataR, odata, NULL);
+  status = planObject.hcfftEnqueueTransform<float>(execPlan, dir, idataR,
+                                                   odata, NULL);
 
   if (status != HCFFT_SUCCEEDS) {
     return HCFFT_EXEC_FAILED;
@@ -919,30 +1161,18 @@ hcfftResult hcfftExecZ2D(hcfftHandle plan, hcfftDoubleComplex* idata,
   hcfftDirection dir = HCFFT_BACKWARD;
   hcfftDoubleReal* idataR = (hcfftDoubleReal*)idata;
   hcfftStatus status;
-
-  if (idataR == odata) {
-    status = planObject.hcfftSetResultLocation(plan, HCFFT_INPLACE);
-
-    if (status != HCFFT_SUCCEEDS) {
-      return HCFFT_SETUP_FAILED;
-    }
-  }
-
-  status =
-      planObject.hcfftSetLayout(plan, HCFFT_HERMITIAN_INTERLEAVED, HCFFT_REAL);
-
-  if (status != HCFFT_SUCCEEDS) {
-    return HCFFT_SETUP_FAILED;
-  }
-
-  status = planObject.hcfftBakePlan(plan);
+  hcfftResLocation placeness =
+      (idataR == odata) ? HCFFT_INPLACE : HCFFT_OUTOFPLACE;
+  hcfftPlanHandle execPlan;
+  status = planObject.hcfftGetExecPlan(
+      plan, placeness, HCFFT_HERMITIAN_INTERLEAVED, HCFFT_REAL, &execPlan);
 
   if (status != HCFFT_SUCCEEDS) {
     return HCFFT_SETUP_FAILED;
   }
 
-  status =
-      planObject.hcfftEnqueueTransform<double>(plan, dir, idataR, odata, NULL);
+  status = planObject.hcfftEnqueueTransform<double>(execPlan, dir, idataR,
+                                                    odata, NULL);
 
   if (status != HCFFT_SUCCEEDS) {
     return HCFFT_EXEC_FAILED;
@@ -993,30 +1223,19 @@ hcfftResult hcfftExecC2C(hcfftHandle plan, hcfftComplex* idata,
   hcfftReal* idataR = (hcfftReal*)idata;
   hcfftReal* odataR = (hcfftReal*)odata;
   hcfftStatus status;
-
-  if (idataR == odataR) {
-    status = planObject.hcfftSetResultLocation(plan, HCFFT_INPLACE);
-
-    if (status != HCFFT_SUCCEEDS) {
-      return HCFFT_SETUP_FAILED;
-    }
-  }
-
-  status = planObject.hcfftSetLayout(plan, HCFFT_COMPLEX_INTERLEAVED,
-                                     HCFFT_COMPLEX_INTERLEAVED);
-
-  if (status != HCFFT_SUCCEEDS) {
-    return HCFFT_SETUP_FAILED;
-  }
-
-  status = planObject.hcfftBakePlan(plan);
+  hcfftResLocation placeness =
+      (idataR == odataR) ? HCFFT_INPLACE : HCFFT_OUTOFPLACE;
+  hcfftPlanHandle execPlan;
+  status = planObject.hcfftGetExecPlan(plan, placeness,
+                                       HCFFT_COMPLEX_INTERLEAVED,
+                                       HCFFT_COMPLEX_INTERLEAVED, &execPlan);
 
   if (status != HCFFT_SUCCEEDS) {
     return HCFFT_SETUP_FAILED;
   }
 
   status = planObject.hcfftEnqueueTransform<float>(
-      plan, (hcfftDirection)direction, idataR, odataR, NULL);
+      execPlan, (hcfftDirection)direction, idataR, odataR, NULL);
 
   if (status != HCFFT_SUCCEEDS) {
     return HCFFT_EXEC_FAILED;
@@ -1036,30 +1255,915 @@ hcfftResult hcfftExecZ2Z(hcfftHandle plan, hcfftDoubleComplex* idata,
   hcfftDoubleReal* idataR = (hcfftDoubleReal*)idata;
   hcfftDoubleReal* odataR = (hcfftDoubleReal*)odata;
   hcfftStatus status;
+  hcfftResLocation placeness =
+      (idataR == odataR) ? HCFFT_INPLACE : HCFFT_OUTOFPLACE;
+  hcfftPlanHandle execPlan;
+  status = planObject.hcfftGetExecPlan(plan, placeness,
+                                       HCFFT_COMPLEX_INTERLEAVED,
+                                       HCFFT_COMPLEX_INTERLEAVED, &execPlan);
 
-  if (idataR == odataR) {
-    status = planObject.hcfftSetResultLocation(plan, HCFFT_INPLACE);
+  if (status != HCFFT_SUCCEEDS) {
+    return HCFFT_SETUP_FAILED;
+  }
 
-    if (status != HCFFT_SUCCEEDS) {
-      return HCFFT_SETUP_FAILED;
+  status = planObject.hcfftEnqueueTransform<double>(
+      execPlan, (hcfftDirection)direction, idataR, odataR, NULL);
+
+  if (status != HCFFT_SUCCEEDS) {
+    return HCFFT_EXEC_FAILED;
+  }
+
+  return HCFFT_SUCCESS;
+}
+
+/* Functions hcfftSpectralMAC() and hcfftSpectralMACZ()
+   Description:
+     Multi-channel spectral multiply-accumulate over spectra laid out as the
+   plan produces them:
+       odata[b][k][f] = sum_c idata[b][c][f] * wdata[k][c][f]
+*/
+
+hcfftResult hcfftSpectralMAC(hcfftHandle plan, int nImages, int nChannels,
+                             int nFilters, hcfftComplex* idata,
+                             hcfftComplex* wdata, hcfftComplex* odata,
+                             int flags) {
+  // Nullity check
+  if (idata == NULL || wdata == NULL || odata == NULL) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  // Output is accumulated while inputs are still being read
+  if (odata == idata || odata == wdata) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  if (nImages <= 0 || nChannels <= 0 || nFilters <= 0) {
+    return HCFFT_INVALID_SIZE;
+  }
+
+  hcfftStatus status = planObject.hcfftSpectralMAC<float>(
+      plan, nImages, nChannels, nFilters, (hcfftReal*)idata,
+      (hcfftReal*)wdata, (hcfftReal*)odata, flags & HCFFT_MAC_ACCUMULATE,
+      flags & HCFFT_MAC_CONJUGATE);
+
+  if (status == HCFFT_INVALID) {
+    return HCFFT_INVALID_VALUE;
+  } else if (status != HCFFT_SUCCEEDS) {
+    return HCFFT_EXEC_FAILED;
+  }
+
+  return HCFFT_SUCCESS;
+}
+
+hcfftResult hcfftSpectralMACZ(hcfftHandle plan, int nImages, int nChannels,
+                              int nFilters, hcfftDoubleComplex* idata,
+                              hcfftDoubleComplex* wdata,
+                              hcfftDoubleComplex* odata, int flags) {
+  // Nullity check
+  if (idata == NULL || wdata == NULL || odata == NULL) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  // Output is accumulated while inputs are still being read
+  if (odata == idata || odata == wdata) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  if (nImages <= 0 || nChannels <= 0 || nFilters <= 0) {
+    return HCFFT_INVALID_SIZE;
+  }
+
+  hcfftStatus status = planObject.hcfftSpectralMAC<double>(
+      plan, nImages, nChannels, nFilters, (hcfftDoubleReal*)idata,
+      (hcfftDoubleReal*)wdata, (hcfftDoubleReal*)odata,
+      flags & HCFFT_MAC_ACCUMULATE, flags & HCFFT_MAC_CONJUGATE);
+
+  if (status == HCFFT_INVALID) {
+    return HCFFT_INVALID_VALUE;
+  } else if (status != HCFFT_SUCCEEDS) {
+    return HCFFT_EXEC_FAILED;
+  }
+
+  return HCFFT_SUCCESS;
+}
+
+/* Functions hcfftXtSetCallback() and hcfftXtClearCallback()
+   Description:
+     Attach (remove) a user load or store callback that is compiled into the
+   kernels of the plan.
+*/
+
+hcfftResult hcfftXtSetCallback(hcfftHandle plan, const char* callbackSource,
+                               hcfftXtCallbackType cbType, void* callerInfo) {
+  // Nullity check
+  if (callbackSource == NULL || callbackSource[0] == '\0') {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  if (cbType != HCFFT_CB_LD && cbType != HCFFT_CB_ST) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  hcfftStatus status = planObject.hcfftSetPlanCallback(
+      plan, callbackSource, cbType == HCFFT_CB_ST, callerInfo);
+
+  if (status != HCFFT_SUCCEEDS) {
+    return HCFFT_SETUP_FAILED;
+  }
+
+  return HCFFT_SUCCESS;
+}
+
+hcfftResult hcfftXtClearCallback(hcfftHandle plan, hcfftXtCallbackType cbType) {
+  if (cbType != HCFFT_CB_LD && cbType != HCFFT_CB_ST) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  hcfftStatus status =
+      planObject.hcfftSetPlanCallback(plan, NULL, cbType == HCFFT_CB_ST, NULL);
+
+  if (status != HCFFT_SUCCEEDS) {
+    return HCFFT_SETUP_FAILED;
+  }
+
+  return HCFFT_SUCCESS;
+}
+
+/* Function hcfftXtSetColumnMethod()
+   Description:
+     Choose between transposes and strided column kernels for the column
+   passes of the plan.
+*/
+
+hcfftResult hcfftXtSetColumnMethod(hcfftHandle plan,
+                                   hcfftXtColumnMethod method) {
+  hcfftColumnMethod columnMethod;
+
+  switch (method) {
+    case HCFFT_XT_COLUMNS_AUTO:
+      columnMethod = HCFFT_COLUMNS_AUTO;
+      break;
+
+    case HCFFT_XT_COLUMNS_TRANSPOSE:
+      columnMethod = HCFFT_COLUMNS_TRANSPOSE;
+      break;
+
+    case HCFFT_XT_COLUMNS_STRIDED:
+      columnMethod = HCFFT_COLUMNS_STRIDED;
+      break;
+
+    default:
+      return HCFFT_INVALID_VALUE;
+  }
+
+  hcfftStatus status = planObject.hcfftSetPlanColumnMethod(plan, columnMethod);
+
+  if (status != HCFFT_SUCCEEDS) {
+    return HCFFT_SETUP_FAILED;
+  }
+
+  return HCFFT_SUCCESS;
+}
+
+/* Functions hcfftXtExecOutOfCoreC2C() and hcfftXtExecOutOfCoreZ2Z()
+   Description:
+     Stream a transform of host resident data through the accelerator in
+   device sized chunks.
+*/
+
+hcfftResult hcfftXtExecOutOfCoreC2C(hcfftHandle plan, hcfftComplex* idata,
+                                    hcfftComplex* odata, int direction) {
+  // Nullity check
+  if (idata == NULL || odata == NULL) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  hcfftStatus status = planObject.hcfftEnqueueOutOfCore<float>(
+      plan, (hcfftDirection)direction, (hcfftReal*)idata, (hcfftReal*)odata);
+
+  if (status == HCFFT_INVALID) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  if (status != HCFFT_SUCCEEDS) {
+    return HCFFT_EXEC_FAILED;
+  }
+
+  return HCFFT_SUCCESS;
+}
+
+hcfftResult hcfftXtExecOutOfCoreZ2Z(hcfftHandle plan,
+                                    hcfftDoubleComplex* idata,
+                                    hcfftDoubleComplex* odata, int direction) {
+  // Nullity check
+  if (idata == NULL || odata == NULL) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  hcfftStatus status = planObject.hcfftEnqueueOutOfCore<double>(
+      plan, (hcfftDirection)direction, (hcfftDoubleReal*)idata,
+      (hcfftDoubleReal*)odata);
+
+  if (status == HCFFT_INVALID) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  if (status != HCFFT_SUCCEEDS) {
+    return HCFFT_EXEC_FAILED;
+  }
+
+  return HCFFT_SUCCESS;
+}
+
+/* Functions hcfftExecHostC2C(), hcfftExecHostZ2Z(), hcfftExecHostR2C(),
+   hcfftExecHostD2Z(), hcfftExecHostC2R() and hcfftExecHostZ2D()
+   Description:
+     Execute a plan on host buffers, streaming the batch through the
+   accelerator in chunks.
+*/
+
+static hcfftResult HostResult(hcfftStatus status) {
+  if (status == HCFFT_INVALID) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  if (status != HCFFT_SUCCEEDS) {
+    return HCFFT_EXEC_FAILED;
+  }
+
+  return HCFFT_SUCCESS;
+}
+
+hcfftResult hcfftExecHostC2C(hcfftHandle plan, hcfftComplex* idata,
+                             hcfftComplex* odata, int direction) {
+  // Nullity check
+  if (idata == NULL || odata == NULL) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  hcfftStatus status = planObject.hcfftEnqueueHost<float>(
+      plan, (hcfftDirection)direction, HCFFT_COMPLEX_INTERLEAVED,
+      HCFFT_COMPLEX_INTERLEAVED, (hcfftReal*)idata, (hcfftReal*)odata);
+
+  return HostResult(status);
+}
+
+hcfftResult hcfftExecHostZ2Z(hcfftHandle plan, hcfftDoubleComplex* idata,
+                             hcfftDoubleComplex* odata, int direction) {
+  // Nullity check
+  if (idata == NULL || odata == NULL) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  hcfftStatus status = planObject.hcfftEnqueueHost<double>(
+      plan, (hcfftDirection)direction, HCFFT_COMPLEX_INTERLEAVED,
+      HCFFT_COMPLEX_INTERLEAVED, (hcfftDoubleReal*)idata,
+      (hcfftDoubleReal*)odata);
+
+  return HostResult(status);
+}
+
+hcfftResult hcfftExecHostR2C(hcfftHandle plan, hcfftReal* idata,
+                             hcfftComplex* odata) {
+  // Nullity check
+  if (idata == NULL || odata == NULL) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  hcfftStatus status = planObject.hcfftEnqueueHost<float>(
+      plan, HCFFT_FORWARD, HCFFT_REAL, HCFFT_HERMITIAN_INTERLEAVED, idata,
+      (hcfftReal*)odata);
+
+  return HostResult(status);
+}
+
+hcfftResult hcfftExecHostD2Z(hcfftHandle plan, hcfftDoubleReal* idata,
+                             hcfftDoubleComplex* odata) {
+  // Nullity check
+  if (idata == NULL || odata == NULL) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  hcfftStatus status = planObject.hcfftEnqueueHost<double>(
+      plan, HCFFT_FORWARD, HCFFT_REAL, HCFFT_HERMITIAN_INTERLEAVED, idata,
+      (hcfftDoubleReal*)odata);
+
+  return HostResult(status);
+}
+
+hcfftResult hcfftExecHostC2R(hcfftHandle plan, hcfftComplex* idata,
+                             hcfftReal* odata) {
+  // Nullity check
+  if (idata == NULL || odata == NULL) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  hcfftStatus status = planObject.hcfftEnqueueHost<float>(
+      plan, HCFFT_BACKWARD, HCFFT_HERMITIAN_INTERLEAVED, HCFFT_REAL,
+      (hcfftReal*)idata, odata);
+
+  return HostResult(status);
+}
+
+hcfftResult hcfftExecHostZ2D(hcfftHandle plan, hcfftDoubleComplex* idata,
+                             hcfftDoubleReal* odata) {
+  // Nullity check
+  if (idata == NULL || odata == NULL) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  hcfftStatus status = planObject.hcfftEnqueueHost<double>(
+      plan, HCFFT_BACKWARD, HCFFT_HERMITIAN_INTERLEAVED, HCFFT_REAL,
+      (hcfftDoubleReal*)idata, odata);
+
+  return HostResult(status);
+}
+
+/* Function hcfftXtSetAccelerators()
+   Description:
+     Select the accelerators host execution distributes the batch over.
+*/
+
+hcfftResult hcfftXtSetAccelerators(hcfftHandle plan, int nAccelerators,
+                                   const int* whichAccelerators) {
+  if (nAccelerators < 0 || (nAccelerators > 0 && whichAccelerators == NULL)) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  FFTDeviceSet* devices = NULL;
+
+  if (nAccelerators > 0) {
+    std::vector<hc::accelerator> gpus = GetGPUs();
+    std::vector<hc::accelerator> chosen;
+
+    for (int i = 0; i < nAccelerators; i++) {
+      int which = whichAccelerators[i];
+
+      if (which < 0 || which >= static_cast<int>(gpus.size()) ||
+          std::count(whichAccelerators, whichAccelerators + i, which)) {
+        return HCFFT_INVALID_VALUE;
+      }
+
+      chosen.push_back(gpus[which]);
     }
+
+    devices = new FFTAcceleratorSet(chosen);
   }
 
-  status = planObject.hcfftSetLayout(plan, HCFFT_COMPLEX_INTERLEAVED,
-                                     HCFFT_COMPLEX_INTERLEAVED);
+  hcfftStatus status = planObject.hcfftSetPlanDeviceSet(plan, devices);
 
   if (status != HCFFT_SUCCEEDS) {
+    delete devices;
     return HCFFT_SETUP_FAILED;
   }
 
-  status = planObject.hcfftBakePlan(plan);
+  return HCFFT_SUCCESS;
+}
+
+/* Function hcfftXtSetSimulatedAccelerators()
+   Description:
+     Distribute host execution over devices simulated on the default
+   accelerator.
+*/
+
+hcfftResult hcfftXtSetSimulatedAccelerators(hcfftHandle plan,
+                                            int nAccelerators,
+                                            const int* weights) {
+  if (nAccelerators < 0) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  FFTDeviceSet* devices = NULL;
+
+  if (nAccelerators > 0) {
+    std::vector<size_t> shares(nAccelerators, 1);
+    size_t total = 0;
+
+    for (int i = 0; weights != NULL && i < nAccelerators; i++) {
+      if (weights[i] < 0) {
+        return HCFFT_INVALID_VALUE;
+      }
+
+      shares[i] = weights[i];
+      total += shares[i];
+    }
+
+    if (weights != NULL && total == 0) {
+      return HCFFT_INVALID_VALUE;
+    }
+
+    devices = new FFTSimulatedDeviceSet(hc::accelerator(), shares);
+  }
+
+  hcfftStatus status = planObject.hcfftSetPlanDeviceSet(plan, devices);
 
   if (status != HCFFT_SUCCEEDS) {
+    delete devices;
     return HCFFT_SETUP_FAILED;
   }
 
-  status = planObject.hcfftEnqueueTransform<double>(
-      plan, (hcfftDirection)direction, idataR, odataR, NULL);
+  return HCFFT_SUCCESS;
+}
+
+/* Functions hcfftXtMallocDistributed() and hcfftXtFreeDistributed()
+   Description:
+     Allocate and free the slabs of a distributed 3D array.
+*/
+
+hcfftResult hcfftXtMallocDistributed(hcfftHandle plan,
+                                     hcfftXtDistributedArray** array) {
+  // Nullity check
+  if (array == NULL) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  hcfftStatus status = planObject.hcfftMallocDistributed(plan, array);
+
+  if (status == HCFFT_INVALID) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  if (status != HCFFT_SUCCEEDS) {
+    return HCFFT_ALLOC_FAILED;
+  }
+
+  return HCFFT_SUCCESS;
+}
+
+hcfftResult hcfftXtFreeDistributed(hcfftXtDistributedArray* array) {
+  // Nullity check
+  if (array == NULL) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  planObject.hcfftFreeDistributed(array);
+  return HCFFT_SUCCESS;
+}
+
+/* Functions hcfftXtCopyToDistributed() and hcfftXtCopyFromDistributed()
+   Description:
+     Copy a 3D array between the host and its slabs.
+*/
+
+hcfftResult hcfftXtCopyToDistributed(hcfftHandle plan,
+                                     hcfftXtDistributedArray* array,
+                                     const void* host) {
+  // Nullity check
+  if (array == NULL || host == NULL) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  hcfftStatus status = planObject.hcfftCopyDistributed(
+      plan, array, const_cast<void*>(host), true);
+  return HostResult(status);
+}
+
+hcfftResult hcfftXtCopyFromDistributed(hcfftHandle plan, void* host,
+                                       hcfftXtDistributedArray* array) {
+  // Nullity check
+  if (array == NULL || host == NULL) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  hcfftStatus status =
+      planObject.hcfftCopyDistributed(plan, array, host, false);
+  return HostResult(status);
+}
+
+/* Functions hcfftXtExecDistributedC2C() and hcfftXtExecDistributedZ2Z()
+   Description:
+     Transform a distributed 3D array in place.
+*/
+
+hcfftResult hcfftXtExecDistributedC2C(hcfftHandle plan,
+                                      hcfftXtDistributedArray* array,
+                                      int direction) {
+  // Nullity check
+  if (array == NULL) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  hcfftStatus status = planObject.hcfftEnqueueDistributed<float>(
+      plan, (hcfftDirection)direction, array);
+  return HostResult(status);
+}
+
+hcfftResult hcfftXtExecDistributedZ2Z(hcfftHandle plan,
+                                      hcfftXtDistributedArray* array,
+                                      int direction) {
+  // Nullity check
+  if (array == NULL) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  hcfftStatus status = planObject.hcfftEnqueueDistributed<double>(
+      plan, (hcfftDirection)direction, array);
+  return HostResult(status);
+}
+
+/* Function hcfftXtSetExchange()
+   Description:
+     Select the transport of the slab exchange of distributed transforms.
+*/
+
+hcfftResult hcfftXtSetExchange(hcfftHandle plan, hcfftXtExchange exchange) {
+  FFTExchange* transport = NULL;
+
+  switch (exchange) {
+    case HCFFT_XT_EXCHANGE_DEVICE:
+      transport = new FFTDeviceExchange();
+      break;
+
+    case HCFFT_XT_EXCHANGE_SHARED_MEMORY:
+      transport = new FFTSharedMemoryExchange();
+      break;
+
+    default:
+      return HCFFT_INVALID_VALUE;
+  }
+
+  hcfftStatus status = planObject.hcfftSetPlanExchange(plan, transport);
+
+  if (status != HCFFT_SUCCEEDS) {
+    delete transport;
+    return HCFFT_SETUP_FAILED;
+  }
+
+  return HCFFT_SUCCESS;
+}
+
+/* Function hcfftXtSetBackend()
+   Description:
+     Select accelerator or host execution of the plan.
+*/
+
+hcfftResult hcfftXtSetBackend(hcfftHandle plan, hcfftXtBackend backend) {
+  hcfftBackend planBackend;
+
+  switch (backend) {
+    case HCFFT_XT_BACKEND_AUTO:
+      planBackend = HCFFT_BACKEND_AUTO;
+      break;
+
+    case HCFFT_XT_BACKEND_ACCELERATOR:
+      planBackend = HCFFT_BACKEND_ACCELERATOR;
+      break;
+
+    case HCFFT_XT_BACKEND_HOST:
+      planBackend = HCFFT_BACKEND_HOST;
+      break;
+
+    default:
+      return HCFFT_INVALID_VALUE;
+  }
+
+  hcfftStatus status = planObject.hcfftSetPlanBackend(plan, planBackend);
+
+  if (status != HCFFT_SUCCEEDS) {
+    return HCFFT_SETUP_FAILED;
+  }
+
+  return HCFFT_SUCCESS;
+}
+
+/* Function hcfftXtSetOutOfCoreMemory()
+   Description:
+     Set the device memory budget of out-of-core and host execution.
+*/
+
+hcfftResult hcfftXtSetOutOfCoreMemory(hcfftHandle plan, size_t bytes) {
+  hcfftStatus status = planObject.hcfftSetPlanStreamMemory(plan, bytes);
+
+  if (status != HCFFT_SUCCEEDS) {
+    return HCFFT_SETUP_FAILED;
+  }
+
+  return HCFFT_SUCCESS;
+}
+
+/* Function hcfftGetPlanCostReport()
+   Description:
+     Report the static cost of the kernels of the plan.
+*/
+
+hcfftResult hcfftGetPlanCostReport(hcfftHandle plan,
+                                   const hcfftDeviceRoofline* device,
+                                   hcfftKernelCost* kernels, int* count) {
+  if (count == NULL) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  FFTRoofline roofline;
+
+  if (device != NULL) {
+    roofline.singleGflops = device->singleGflops;
+    roofline.doubleGflops = device->doubleGflops;
+    roofline.memoryGBs = device->memoryGBs;
+    roofline.ldsGBs = device->ldsGBs;
+    roofline.launchUs = device->launchUs;
+  }
+
+  std::vector<FFTKernelCost> costs;
+  hcfftStatus status = planObject.hcfftGetPlanCost(plan, roofline, &costs);
+
+  if (status != HCFFT_SUCCEEDS) {
+    return HCFFT_SETUP_FAILED;
+  }
+
+  // Fill no more entries than the caller has room for
+  size_t filled = 0;
+
+  if (kernels != NULL && *count > 0) {
+    filled = std::min<size_t>(*count, costs.size());
+  }
+
+  for (size_t i = 0; i < filled; i++) {
+    const FFTKernelCost& cost = costs[i];
+    hcfftKernelCost& out = kernels[i];
+    memset(&out, 0, sizeof(out));
+    strncpy(out.name, cost.name.c_str(), sizeof(out.name) - 1);
+
+    for (size_t p = 0; p < cost.radices.size() && p < 15; p++) {
+      out.radices[p] = static_cast<int>(cost.radices[p]);
+    }
+
+    out.globalSize = cost.globalSize;
+    out.localSize = cost.localSize;
+    out.flops = cost.flops;
+    out.bytesRead = cost.bytesRead;
+    out.bytesWritten = cost.bytesWritten;
+    out.ldsBytes = cost.ldsBytes;
+    out.barriers = cost.barriers;
+    out.registers = cost.registers;
+    out.seconds = cost.seconds;
+  }
+
+  *count = static_cast<int>(costs.size());
+  return HCFFT_SUCCESS;
+}
+
+/* Function hcfftExplainPlan()
+   Description:
+     Describe the sub-plan tree of the plan as JSON.
+*/
+
+hcfftResult hcfftExplainPlan(hcfftHandle plan, char* json, size_t* size) {
+  if (size == NULL) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  FFTPlanNode root;
+  hcfftStatus status = planObject.hcfftExplainPlan(plan, &root);
+
+  if (status != HCFFT_SUCCEEDS) {
+    return HCFFT_SETUP_FAILED;
+  }
+
+  std::string text = root.Json();
+
+  if (json != NULL && *size > 0) {
+    size_t copied = std::min<size_t>(*size - 1, text.size());
+    memcpy(json, text.c_str(), copied);
+    json[copied] = '\0';
+  }
+
+  *size = text.size() + 1;
+  return HCFFT_SUCCESS;
+}
+
+/* Functions hcfftProfileStart() and hcfftProfileStop()
+   Description:
+     Time the kernel launches in between and write them as a trace.
+*/
+
+hcfftResult hcfftProfileStart(const char* path) {
+  if (path == NULL || path[0] == '\0') {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  FFTProfiler::getInstance().Start(path);
+  return HCFFT_SUCCESS;
+}
+
+hcfftResult hcfftProfileStop() {
+  FFTProfiler& profiler = FFTProfiler::getInstance();
+
+  if (!profiler.Enabled()) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  hcfftStatus status = profiler.Stop();
+  return (status == HCFFT_SUCCEEDS) ? HCFFT_SUCCESS : HCFFT_EXEC_FAILED;
+}
+
+/* Functions hcfftGetPlanBakeTimes() and hcfftGetBakeTimes()
+   Description:
+     Report the time baking spent per phase for a plan or the process.
+*/
+
+static void CopyBakeTimes(const FFTBakeTimes& in, hcfftBakeTimes* out) {
+  static_assert(static_cast<int>(HCFFT_BAKE_PHASES) ==
+                    static_cast<int>(BAKE_PHASES),
+                "hcfftBakePhase follows FFTBakePhase");
+
+  for (int p = 0; p < HCFFT_BAKE_PHASES; p++) {
+    out->seconds[p] = in.seconds[p];
+    out->calls[p] = in.calls[p];
+  }
+
+  out->cacheHits = in.cacheHits;
+  out->cacheMisses = in.cacheMisses;
+}
+
+hcfftResult hcfftGetPlanBakeTimes(hcfftHandle plan, hcfftBakeTimes* times) {
+  if (times == NULL) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  FFTBakeTimes bakeTimes;
+  hcfftStatus status = planObject.hcfftGetPlanBakeTimes(plan, &bakeTimes);
+
+  if (status != HCFFT_SUCCEEDS) {
+    return HCFFT_INVALID_PLAN;
+  }
+
+  CopyBakeTimes(bakeTimes, times);
+  return HCFFT_SUCCESS;
+}
+
+hcfftResult hcfftGetBakeTimes(hcfftBakeTimes* times) {
+  if (times == NULL) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  CopyBakeTimes(FFTBakeTimer::Process(), times);
+  return HCFFT_SUCCESS;
+}
+
+/* Functions hcfftGetMetrics() and hcfftGetMetricsPrometheus()
+   Description:
+     Report the counters of the process, as a struct or as Prometheus text.
+*/
+
+hcfftResult hcfftGetMetrics(hcfftMetrics* metrics) {
+  static_assert(static_cast<int>(HCFFT_KERNEL_KINDS) == Stockham_Library + 1,
+                "hcfftKernelKind follows hcfftGenerators");
+  static_assert(HCFFT_EXEC_BUCKETS == FFT_EXEC_BUCKETS,
+                "hcfftMetrics has a slot per latency bucket");
+
+  if (metrics == NULL) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  int64_t values[METRIC_COUNT];
+  FFTMetrics::Read(values);
+
+  for (int k = 0; k < HCFFT_KERNEL_KINDS; k++) {
+    metrics->kernelsLaunched[k] = values[METRIC_KERNELS + k];
+  }
+
+  for (int b = 0; b < HCFFT_EXEC_BUCKETS; b++) {
+    metrics->execBuckets[b] = values[METRIC_EXEC_BUCKETS + b];
+  }
+
+  metrics->kernelBytes = static_cast<double>(values[METRIC_KERNEL_BYTES]);
+  metrics->execs = values[METRIC_EXECS];
+  metrics->execSeconds = values[METRIC_EXEC_NANOSECONDS] * 1.0e-9;
+  metrics->plansCreated = values[METRIC_PLANS_CREATED];
+  metrics->plansBaked = values[METRIC_PLANS_BAKED];
+  metrics->cacheHits = values[METRIC_CACHE_HITS];
+  metrics->cacheMisses = values[METRIC_CACHE_MISSES];
+  metrics->compiles = values[METRIC_COMPILES];
+  metrics->scratchBytes = values[METRIC_SCRATCH_BYTES];
+  metrics->twiddleBytes = values[METRIC_TWIDDLE_BYTES];
+  return HCFFT_SUCCESS;
+}
+
+hcfftResult hcfftGetMetricsPrometheus(char* text, size_t* size) {
+  if (size == NULL) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  std::string metrics = FFTMetrics::Prometheus();
+
+  if (text != NULL && *size > 0) {
+    size_t copied = std::min<size_t>(*size - 1, metrics.size());
+    memcpy(text, metrics.c_str(), copied);
+    text[copied] = '\0';
+  }
+
+  *size = metrics.size() + 1;
+  return HCFFT_SUCCESS;
+}
+
+/* Functions hcfftExecR2CHalf(), hcfftExecC2RHalf() and hcfftExecC2CHalf()
+   Description:
+     Execute a plan created with HCFFT_R2C_HALF, HCFFT_C2R_HALF or
+   HCFFT_C2C_HALF. Data is read and written as fp16, the transform itself is
+   computed in single precision.
+*/
+
+// Transforms are only generated for half storage by plans created for it
+static bool IsHalfPlan(hcfftHandle plan) {
+  hcfftPrecision precision;
+  hcfftStatus status = planObject.hcfftGetPlanPrecision(plan, &precision);
+  return status == HCFFT_SUCCEEDS && precision == HCFFT_HALF;
+}
+
+hcfftResult hcfftExecR2CHalf(hcfftHandle plan, hcfftHalf* idata,
+                             hcfftHalfComplex* odata) {
+  // Nullity check
+  if (idata == NULL || odata == NULL) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  if (!IsHalfPlan(plan)) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  hcfftDirection dir = HCFFT_FORWARD;
+  hcfftStatus status;
+  hcfftResLocation placeness =
+      ((void*)idata == (void*)odata) ? HCFFT_INPLACE : HCFFT_OUTOFPLACE;
+  hcfftPlanHandle execPlan;
+  status = planObject.hcfftGetExecPlan(plan, placeness, HCFFT_REAL,
+                                       HCFFT_HERMITIAN_INTERLEAVED, &execPlan);
+
+  if (status != HCFFT_SUCCEEDS) {
+    return HCFFT_SETUP_FAILED;
+  }
+
+  // The buffers are only handed through to the kernels, so the fp32
+  // instantiation serves fp16 storage as well
+  status = planObject.hcfftEnqueueTransform<float>(
+      execPlan, dir, (hcfftReal*)idata, (hcfftReal*)odata, NULL);
+
+  if (status != HCFFT_SUCCEEDS) {
+    return HCFFT_EXEC_FAILED;
+  }
+
+  return HCFFT_SUCCESS;
+}
+
+hcfftResult hcfftExecC2RHalf(hcfftHandle plan, hcfftHalfComplex* idata,
+                             hcfftHalf* odata) {
+  // Nullity check
+  if (idata == NULL || odata == NULL) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  if (!IsHalfPlan(plan)) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  hcfftDirection dir = HCFFT_BACKWARD;
+  hcfftStatus status;
+  hcfftResLocation placeness =
+      ((void*)idata == (void*)odata) ? HCFFT_INPLACE : HCFFT_OUTOFPLACE;
+  hcfftPlanHandle execPlan;
+  status = planObject.hcfftGetExecPlan(
+      plan, placeness, HCFFT_HERMITIAN_INTERLEAVED, HCFFT_REAL, &execPlan);
+
+  if (status != HCFFT_SUCCEEDS) {
+    return HCFFT_SETUP_FAILED;
+  }
+
+  status = planObject.hcfftEnqueueTransform<float>(
+      execPlan, dir, (hcfftReal*)idata, (hcfftReal*)odata, NULL);
+
+  if (status != HCFFT_SUCCEEDS) {
+    return HCFFT_EXEC_FAILED;
+  }
+
+  return HCFFT_SUCCESS;
+}
+
+hcfftResult hcfftExecC2CHalf(hcfftHandle plan, hcfftHalfComplex* idata,
+                             hcfftHalfComplex* odata, int direction) {
+  // Nullity check
+  if (idata == NULL || odata == NULL) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  if (!IsHalfPlan(plan)) {
+    return HCFFT_INVALID_VALUE;
+  }
+
+  hcfftStatus status;
+  hcfftResLocation placeness =
+      (idata == odata) ? HCFFT_INPLACE : HCFFT_OUTOFPLACE;
+  hcfftPlanHandle execPlan;
+  status = planObject.hcfftGetExecPlan(plan, placeness,
+                                       HCFFT_COMPLEX_INTERLEAVED,
+                                       HCFFT_COMPLEX_INTERLEAVED, &execPlan);
+
+  if (status != HCFFT_SUCCEEDS) {
+    return HCFFT_SETUP_FAILED;
+  }
+
+  status = planObject.hcfftEnqueueTransform<float>(
+      execPlan, (hcfftDirection)direction, (hcfftReal*)idata,
+      (hcfftReal*)odata, NULL);
 
   if (status != HCFFT_SUCCEEDS) {
     return HCFFT_EXEC_FAILED;
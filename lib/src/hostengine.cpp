@@ -0,0 +1,928 @@
+/*
+Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "include/hcfftlib.h"
+#include <math.h>
+#include <algorithm>
+#include <map>
+#include <thread>
+
+// Host execution
+//
+//   Plans running on the host bake no kernel. Every axis of the plan is a set
+//   of 1D lines transformed the way the generated kernels transform them:
+//   lengths a single kernel handles run the Stockham passes with the radices
+//   of that kernel (StockhamRadices()), longer ones are split into two sets
+//   of lines with twiddles in between, as large 1D transforms are on the
+//   accelerator.
+//
+//   Lines are transformed Lanes<T>::kCount at a time. They are gathered into
+//   planar buffers holding element e of lane l at e * kCount + l, so every
+//   butterfly works on all lanes with contiguous loops the compiler
+//   vectorizes. Consecutive lines of the outer axes are neighbours in memory,
+//   which turns the gather and scatter of those axes into blocked transposes.
+//   Groups of lines are spread over host threads. The passes are compiled
+//   for AVX-512, AVX2 and the baseline instruction set, picked at run time.
+
+namespace HostEngine {
+//  Transforms of at most this many elements run on the host when their data
+//  already is there, below the cost of the copies to the accelerator
+static const size_t kTinyElements = 2048;
+
+//  Elements a thread has to transform for one more thread to pay off
+static const size_t kThreadElements = 1 << 16;
+
+//  Largest radix of the generated kernels
+static const size_t kMaxRadix = 13;
+
+//  Lines transformed together: one 512-bit register of either component
+template <typename T>
+struct Lanes {
+  static const size_t kCount = 64 / sizeof(T);
+};
+
+//  Stockham passes of one length and direction
+template <typename T>
+struct LinePlan {
+  size_t length;
+  std::vector<size_t> radices;
+  //  Per pass of radix R after passes of LS elements, W^(k r) of the
+  //  length LS * R for k < LS and r < R, real and imaginary parts
+  std::vector<std::vector<T> > twiddles;
+  //  Per pass, the roots of unity of the radix
+  std::vector<std::vector<T> > roots;
+};
+
+static bool Factorable(size_t length) {
+  const size_t primes[] = {2, 3, 5, 7, 11, 13};
+
+  for (size_t p = 0; p < sizeof(primes) / sizeof(primes[0]); p++) {
+    while (length % primes[p] == 0) {
+      length /= primes[p];
+    }
+  }
+
+  return length == 1;
+}
+
+static lockRAII linePlanLock(_T("hostLinePlans"));
+
+template <typename T>
+static const LinePlan<T>* GetLinePlan(const FFTPlan* fftPlan, size_t length,
+                                      hcfftDirection dir) {
+  // Plans live as long as the process, like the loaded kernels
+  static std::map<std::vector<size_t>, LinePlan<T>*> plans;
+  std::vector<size_t> key(1, length);
+  key.push_back(dir);
+  key.push_back(fftPlan->envelope.limit_WorkGroupSize);
+  scopedLock pLock(linePlanLock, _T(" host line plans"));
+  typename std::map<std::vector<size_t>, LinePlan<T>*>::iterator it =
+      plans.find(key);
+
+  if (it != plans.end()) {
+    return it->second;
+  }
+
+  LinePlan<T>* plan = new LinePlan<T>;
+  plan->length = length;
+
+  if (length > 1) {
+    StockhamRadices(fftPlan->precision, fftPlan->envelope.limit_WorkGroupSize,
+                    length, &plan->radices);
+  }
+
+  const double TWO_PI = (dir == HCFFT_FORWARD)
+                            ? -6.283185307179586476925286766559
+                            : 6.283185307179586476925286766559;
+  size_t ls = 1;
+
+  for (size_t p = 0; p < plan->radices.size(); p++) {
+    size_t r = plan->radices[p];
+    std::vector<T> twiddles(2 * ls * r), roots(2 * r);
+
+    for (size_t k = 0; k < ls; k++) {
+      for (size_t q = 0; q < r; q++) {
+        double theta = TWO_PI * static_cast<double>(k * q) /
+                       static_cast<double>(ls * r);
+        twiddles[2 * (k * r + q)] = static_cast<T>(cos(theta));
+        twiddles[2 * (k * r + q) + 1] = static_cast<T>(sin(theta));
+      }
+    }
+
+    for (size_t q = 0; q < r; q++) {
+      double theta = TWO_PI * static_cast<double>(q) / static_cast<double>(r);
+      roots[2 * q] = static_cast<T>(cos(theta));
+      roots[2 * q + 1] = static_cast<T>(sin(theta));
+    }
+
+    plan->twiddles.push_back(twiddles);
+    plan->roots.push_back(roots);
+    ls *= r;
+  }
+
+  plans[key] = plan;
+  return plan;
+}
+
+//  Run the passes of a plan on the lanes gathered in work: real parts of the
+//  elements, imaginary parts, then a spare buffer of the same size. Returns
+//  the buffer (0 or 1) holding the result
+template <typename T>
+static inline __attribute__((always_inline)) size_t
+Passes(const LinePlan<T>* plan, T* work) {
+  const size_t V = Lanes<T>::kCount;
+  const size_t n = plan->length;
+  T* re[2] = {work, work + 2 * n * V};
+  T* im[2] = {work + n * V, work + 3 * n * V};
+  size_t src = 0;
+  size_t ls = 1;
+
+  for (size_t p = 0; p < plan->radices.size(); p++) {
+    const size_t r = plan->radices[p];
+    const size_t m = n / r;
+    const T* tw = &plan->twiddles[p][0];
+    const T* root = &plan->roots[p][0];
+    const T* inRe = re[src];
+    const T* inIm = im[src];
+    T* outRe = re[1 - src];
+    T* outIm = im[1 - src];
+
+    for (size_t j = 0; j < m; j++) {
+      const size_t k = j % ls;
+      const size_t out = (j - k) * r + k;
+      T xr[kMaxRadix][V], xi[kMaxRadix][V];
+
+      for (size_t q = 0; q < r; q++) {
+        const T wr = tw[2 * (k * r + q)];
+        const T wi = tw[2 * (k * r + q) + 1];
+        const T* ar = inRe + (j + q * m) * V;
+        const T* ai = inIm + (j + q * m) * V;
+
+        for (size_t l = 0; l < V; l++) {
+          xr[q][l] = ar[l] * wr - ai[l] * wi;
+          xi[q][l] = ar[l] * wi + ai[l] * wr;
+        }
+      }
+
+      if (r == 2) {
+        T* y0r = outRe + out * V;
+        T* y0i = outIm + out * V;
+        T* y1r = outRe + (out + ls) * V;
+        T* y1i = outIm + (out + ls) * V;
+
+        for (size_t l = 0; l < V; l++) {
+          y0r[l] = xr[0][l] + xr[1][l];
+          y0i[l] = xi[0][l] + xi[1][l];
+          y1r[l] = xr[0][l] - xr[1][l];
+          y1i[l] = xi[0][l] - xi[1][l];
+        }
+      } else if (r == 4) {
+        // W^1 of radix 4 is -i forward and i backward
+        const T s = root[3];
+        T* y0r = outRe + out * V;
+        T* y0i = outIm + out * V;
+        T* y1r = outRe + (out + ls) * V;
+        T* y1i = outIm + (out + ls) * V;
+        T* y2r = outRe + (out + 2 * ls) * V;
+        T* y2i = outIm + (out + 2 * ls) * V;
+        T* y3r = outRe + (out + 3 * ls) * V;
+        T* y3i = outIm + (out + 3 * ls) * V;
+
+        for (size_t l = 0; l < V; l++) {
+          T a0r = xr[0][l] + xr[2][l], a0i = xi[0][l] + xi[2][l];
+          T a1r = xr[0][l] - xr[2][l], a1i = xi[0][l] - xi[2][l];
+          T b0r = xr[1][l] + xr[3][l], b0i = xi[1][l] + xi[3][l];
+          T b1r = -s * (xi[1][l] - xi[3][l]);
+          T b1i = s * (xr[1][l] - xr[3][l]);
+          y0r[l] = a0r + b0r;
+          y0i[l] = a0i + b0i;
+          y1r[l] = a1r + b1r;
+          y1i[l] = a1i + b1i;
+          y2r[l] = a0r - b0r;
+          y2i[l] = a0i - b0i;
+          y3r[l] = a1r - b1r;
+          y3i[l] = a1i - b1i;
+        }
+      } else if (r == 8) {
+        // Two radix 4 butterflies on the even and odd inputs, W^k of radix 8
+        // joining them
+        const T s = root[5];
+        const T c = root[2];
+        T* y[8][2];
+
+        for (size_t q = 0; q < 8; q++) {
+          y[q][0] = outRe + (out + q * ls) * V;
+          y[q][1] = outIm + (out + q * ls) * V;
+        }
+
+        for (size_t l = 0; l < V; l++) {
+          T e0r = xr[0][l] + xr[4][l], e0i = xi[0][l] + xi[4][l];
+          T e1r = xr[0][l] - xr[4][l], e1i = xi[0][l] - xi[4][l];
+          T e2r = xr[2][l] + xr[6][l], e2i = xi[2][l] + xi[6][l];
+          T e3r = -s * (xi[2][l] - xi[6][l]);
+          T e3i = s * (xr[2][l] - xr[6][l]);
+          T o0r = xr[1][l] + xr[5][l], o0i = xi[1][l] + xi[5][l];
+          T o1r = xr[1][l] - xr[5][l], o1i = xi[1][l] - xi[5][l];
+          T o2r = xr[3][l] + xr[7][l], o2i = xi[3][l] + xi[7][l];
+          T o3r = -s * (xi[3][l] - xi[7][l]);
+          T o3i = s * (xr[3][l] - xr[7][l]);
+          // Even and odd radix 4 outputs
+          T a0r = e0r + e2r, a0i = e0i + e2i;
+          T a1r = e1r + e3r, a1i = e1i + e3i;
+          T a2r = e0r - e2r, a2i = e0i - e2i;
+          T a3r = e1r - e3r, a3i = e1i - e3i;
+          T b0r = o0r + o2r, b0i = o0i + o2i;
+          T b1r = o1r + o3r, b1i = o1i + o3i;
+          T b2r = o0r - o2r, b2i = o0i - o2i;
+          T b3r = o1r - o3r, b3i = o1i - o3i;
+          // W^1 = c (1 + s i), W^2 = s i, W^3 = c (-1 + s i)
+          T t1r = c * (b1r - s * b1i), t1i = c * (b1i + s * b1r);
+          T t2r = -s * b2i, t2i = s * b2r;
+          T t3r = -c * (b3r + s * b3i), t3i = c * (s * b3r - b3i);
+          y[0][0][l] = a0r + b0r;
+          y[0][1][l] = a0i + b0i;
+          y[4][0][l] = a0r - b0r;
+          y[4][1][l] = a0i - b0i;
+          y[1][0][l] = a1r + t1r;
+          y[1][1][l] = a1i + t1i;
+          y[5][0][l] = a1r - t1r;
+          y[5][1][l] = a1i - t1i;
+          y[2][0][l] = a2r + t2r;
+          y[2][1][l] = a2i + t2i;
+          y[6][0][l] = a2r - t2r;
+          y[6][1][l] = a2i - t2i;
+          y[3][0][l] = a3r + t3r;
+          y[3][1][l] = a3i + t3i;
+          y[7][0][l] = a3r - t3r;
+          y[7][1][l] = a3i - t3i;
+        }
+      } else {
+        for (size_t q = 0; q < r; q++) {
+          T* yr = outRe + (out + q * ls) * V;
+          T* yi = outIm + (out + q * ls) * V;
+
+          for (size_t l = 0; l < V; l++) {
+            yr[l] = xr[0][l];
+            yi[l] = xi[0][l];
+          }
+
+          for (size_t s = 1; s < r; s++) {
+            const T cr = root[2 * ((s * q) % r)];
+            const T ci = root[2 * ((s * q) % r) + 1];
+
+            for (size_t l = 0; l < V; l++) {
+              yr[l] += xr[s][l] * cr - xi[s][l] * ci;
+              yi[l] += xr[s][l] * ci + xi[s][l] * cr;
+            }
+          }
+        }
+      }
+    }
+
+    src = 1 - src;
+    ls *= r;
+  }
+
+  return src;
+}
+
+template <typename T>
+struct PassKernel {
+  typedef size_t (*Func)(const LinePlan<T>* plan, T* work);
+};
+
+template <typename T>
+static size_t PassesBaseline(const LinePlan<T>* plan, T* work) {
+  return Passes<T>(plan, work);
+}
+
+#if defined(__x86_64__)
+template <typename T>
+static __attribute__((target("avx2,fma"))) size_t
+PassesAVX2(const LinePlan<T>* plan, T* work) {
+  return Passes<T>(plan, work);
+}
+
+template <typename T>
+static __attribute__((target("avx512f"))) size_t
+PassesAVX512(const LinePlan<T>* plan, T* work) {
+  return Passes<T>(plan, work);
+}
+#endif
+
+template <typename T>
+static typename PassKernel<T>::Func SelectPasses() {
+#if defined(__x86_64__)
+  if (__builtin_cpu_supports("avx512f")) {
+    return PassesAVX512<T>;
+  }
+
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    return PassesAVX2<T>;
+  }
+#endif
+  return PassesBaseline<T>;
+}
+
+//  One loop over the lines of a set, strides in elements
+struct Loop {
+  size_t count;
+  size_t inStride;
+  size_t outStride;
+};
+
+//  A set of 1D transforms of one length, strides in elements: complex
+//  interleaved unless the line is real
+template <typename T>
+struct Lines {
+  size_t length;
+  const T* input;
+  T* output;
+  size_t inStride;          // between the elements of a line
+  size_t outStride;
+  std::vector<Loop> loops;  // over the lines, first fastest
+  bool realIn;              // input elements are real
+  bool hermitianIn;         // input holds elements 0 .. length / 2
+  bool realOut;             // only real parts are written
+  bool transform;           // false only gathers and scatters
+  size_t keep;              // elements written per line
+  T scale;
+  //  When not 0, output element k of the line at index m of loop 0 is
+  //  multiplied by W^(m k), W the root of unity of this length
+  size_t twiddleLength;
+
+  Lines()
+      : length(1),
+        input(NULL),
+        output(NULL),
+        inStride(1),
+        outStride(1),
+        realIn(false),
+        hermitianIn(false),
+        realOut(false),
+        transform(true),
+        keep(1),
+        scale(1),
+        twiddleLength(0) {}
+
+  size_t Count() const {
+    size_t count = 1;
+
+    for (size_t i = 0; i < loops.size(); i++) {
+      count *= loops[i].count;
+    }
+
+    return count;
+  }
+};
+
+//  Transform the groups of lanes [first, last) of a set of lines
+template <typename T>
+static void RunGroups(const Lines<T>* lines, const LinePlan<T>* plan,
+                      typename PassKernel<T>::Func passes, const T* twiddles,
+                      T sign, size_t first, size_t last) {
+  const size_t V = Lanes<T>::kCount;
+  const size_t n = lines->length;
+  const size_t count = lines->Count();
+  const size_t inWidth = lines->realIn ? 1 : 2;
+  const size_t outWidth = lines->realOut ? 1 : 2;
+  const size_t half = n / 2 + 1;
+  std::vector<T> work(4 * n * V);
+  size_t inOffset[V], outOffset[V], index[V];
+
+  for (size_t g = first; g < last; g++) {
+    size_t used = std::min(V, count - g * V);
+
+    for (size_t l = 0; l < used; l++) {
+      size_t line = g * V + l;
+      inOffset[l] = outOffset[l] = 0;
+      index[l] = lines->loops.empty() ? 0 : line % lines->loops[0].count;
+
+      for (size_t i = 0; i < lines->loops.size(); i++) {
+        size_t at = line % lines->loops[i].count;
+        line /= lines->loops[i].count;
+        inOffset[l] += at * lines->loops[i].inStride;
+        outOffset[l] += at * lines->loops[i].outStride;
+      }
+    }
+
+    // Gather, unused lanes transform zeros
+    T* re = &work[0];
+    T* im = re + n * V;
+
+    for (size_t e = 0; e < n; e++) {
+      size_t element = e;
+      T conj = 1;
+
+      if (lines->hermitianIn && e >= half) {
+        element = n - e;
+        conj = -1;
+      }
+
+      for (size_t l = 0; l < used; l++) {
+        const T* x =
+            lines->input +
+            (inOffset[l] + element * lines->inStride) * inWidth;
+        re[e * V + l] = x[0];
+        im[e * V + l] = lines->realIn ? 0 : conj * x[1];
+      }
+
+      for (size_t l = used; l < V; l++) {
+        re[e * V + l] = im[e * V + l] = 0;
+      }
+    }
+
+    size_t result = (lines->transform && n > 1) ? passes(plan, &work[0]) : 0;
+    re = &work[2 * result * n * V];
+    im = re + n * V;
+
+    // Scatter
+    for (size_t k = 0; k < lines->keep; k++) {
+      for (size_t l = 0; l < used; l++) {
+        T yr = re[k * V + l] * lines->scale;
+        T yi = im[k * V + l] * lines->scale;
+
+        if (twiddles) {
+          size_t t = (index[l] * k) % lines->twiddleLength;
+          T wr = twiddles[2 * t], wi = sign * twiddles[2 * t + 1];
+          T tr = yr * wr - yi * wi;
+          yi = yr * wi + yi * wr;
+          yr = tr;
+        }
+
+        T* y = lines->output + (outOffset[l] + k * lines->outStride) * outWidth;
+        y[0] = yr;
+
+        if (!lines->realOut) {
+          y[1] = yi;
+        }
+      }
+    }
+  }
+}
+
+//  Give the lines of a set packed input or output, length elements apart
+template <typename T>
+static void Pack(Lines<T>* lines, size_t length, bool output) {
+  size_t stride = length;
+
+  for (size_t i = 0; i < lines->loops.size(); i++) {
+    if (output) {
+      lines->loops[i].outStride = stride;
+    } else {
+      lines->loops[i].inStride = stride;
+    }
+
+    stride *= lines->loops[i].count;
+  }
+}
+
+//  First length of the split of a line too long for a single kernel: near
+//  the square root for powers of 2 and otherwise, as on the accelerator, and
+//  always one a single kernel handles. 0 when there is none
+static size_t SplitLength(size_t length, size_t threshold) {
+  if (IsPo2(length)) {
+    if (length > threshold * threshold) {
+      return threshold;
+    }
+
+    size_t in_1d = BitScanF(threshold);
+    size_t in_x = BitScanF(length);
+    size_t count = in_x / in_1d;
+
+    if (count * in_1d < in_x) {
+      count++;
+      in_1d = in_x / count;
+
+      if (in_1d * count < in_x) {
+        in_1d++;
+      }
+    }
+
+    return length >> in_1d;
+  }
+
+  size_t halfPowerLength = (size_t)1 << ((CeilPo2(length) + 1) / 2);
+
+  for (size_t f = std::min(halfPowerLength, threshold); f >= 2; f--) {
+    if ((length % f == 0) && Is1DPossible(f, threshold)) {
+      return f;
+    }
+  }
+
+  return 0;
+}
+
+template <typename T>
+static hcfftStatus RunLines(const FFTPlan* fftPlan, hcfftDirection dir,
+                            const Lines<T>& lines) {
+  const size_t n = lines.length;
+  const size_t count = lines.Count();
+  size_t threshold = 0;
+  fftPlan->GetMax1DLength(&threshold);
+
+  if (count == 0) {
+    return HCFFT_SUCCEEDS;
+  }
+
+  if (!lines.transform || Is1DPossible(n, threshold)) {
+    const size_t V = Lanes<T>::kCount;
+    const LinePlan<T>* plan =
+        lines.transform ? GetLinePlan<T>(fftPlan, n, dir) : NULL;
+    static typename PassKernel<T>::Func passes = SelectPasses<T>();
+    std::vector<T> twiddles;
+    T sign = (dir == HCFFT_FORWARD) ? -1 : 1;
+
+    if (lines.twiddleLength) {
+      const double TWO_PI = 6.283185307179586476925286766559;
+      twiddles.resize(2 * lines.twiddleLength);
+
+      for (size_t t = 0; t < lines.twiddleLength; t++) {
+        double theta = TWO_PI * static_cast<double>(t) /
+                       static_cast<double>(lines.twiddleLength);
+        twiddles[2 * t] = static_cast<T>(cos(theta));
+        twiddles[2 * t + 1] = static_cast<T>(sin(theta));
+      }
+    }
+
+    size_t groups = DivRoundingUp<size_t>(count, V);
+    size_t cores = std::max<size_t>(1, std::thread::hardware_concurrency());
+    size_t threads = std::min(
+        std::min(cores, groups),
+        std::max<size_t>(1, count * n / kThreadElements));
+    const T* tw = twiddles.empty() ? NULL : &twiddles[0];
+    std::vector<std::thread> workers;
+
+    for (size_t t = 1; t < threads; t++) {
+      workers.push_back(std::thread(RunGroups<T>, &lines, plan, passes, tw,
+                                    sign, groups * t / threads,
+                                    groups * (t + 1) / threads));
+    }
+
+    RunGroups<T>(&lines, plan, passes, tw, sign, 0, groups / threads);
+
+    for (size_t w = 0; w < workers.size(); w++) {
+      workers[w].join();
+    }
+
+    return HCFFT_SUCCEEDS;
+  }
+
+  if (lines.hermitianIn) {
+    // Split lines index the input in a different order, expand it first
+    std::vector<T> full(2 * n * count);
+    Lines<T> expand = lines;
+    expand.output = &full[0];
+    expand.outStride = 1;
+    expand.realOut = false;
+    expand.transform = false;
+    expand.keep = n;
+    expand.scale = 1;
+    Pack(&expand, n, true);
+    hcfftStatus status = RunLines(fftPlan, dir, expand);
+
+    if (status != HCFFT_SUCCEEDS) {
+      return status;
+    }
+
+    Lines<T> rest = lines;
+    rest.input = &full[0];
+    rest.inStride = 1;
+    rest.hermitianIn = false;
+    Pack(&rest, n, false);
+    return RunLines(fftPlan, dir, rest);
+  }
+
+  if (lines.keep < n) {
+    // Same for the output of part of the lines
+    std::vector<T> full(2 * n * count);
+    Lines<T> inner = lines;
+    inner.output = &full[0];
+    inner.outStride = 1;
+    inner.keep = n;
+    inner.scale = 1;
+    Pack(&inner, n, true);
+    hcfftStatus status = RunLines(fftPlan, dir, inner);
+
+    if (status != HCFFT_SUCCEEDS) {
+      return status;
+    }
+
+    Lines<T> copy = lines;
+    copy.input = &full[0];
+    copy.inStride = 1;
+    copy.realIn = false;
+    copy.transform = false;
+    Pack(&copy, n, false);
+    return RunLines(fftPlan, dir, copy);
+  }
+
+  // Lines of n = a * b elements: b lines of a elements (n1) at each offset
+  // n2, twiddled by W^(n2 k1), then a lines of b elements (n2) written to
+  // k1 + a * k2. Only the second set may split further
+  size_t a = SplitLength(n, threshold);
+
+  if (a == 0 || lines.twiddleLength) {
+    return HCFFT_INVALID;
+  }
+
+  size_t b = n / a;
+  std::vector<T> scratch(2 * n * count);
+  Loop inner1 = {b, lines.inStride, 1};
+  Lines<T> first = lines;
+  first.length = a;
+  first.inStride = b * lines.inStride;
+  first.output = &scratch[0];
+  first.outStride = b;
+  first.realOut = false;
+  first.keep = a;
+  first.scale = 1;
+  first.twiddleLength = n;
+  Pack(&first, n, true);
+  first.loops.insert(first.loops.begin(), inner1);
+  hcfftStatus status = RunLines(fftPlan, dir, first);
+
+  if (status != HCFFT_SUCCEEDS) {
+    return status;
+  }
+
+  Loop inner2 = {a, b, lines.outStride};
+  Lines<T> second = lines;
+  second.length = b;
+  second.input = &scratch[0];
+  second.inStride = 1;
+  second.outStride = a * lines.outStride;
+  second.realIn = false;
+  second.keep = b;
+  Pack(&second, n, false);
+  second.loops.insert(second.loops.begin(), inner2);
+  return RunLines(fftPlan, dir, second);
+}
+
+//  Lines along an axis of an array with these extents, then the batch
+static std::vector<Loop> AxisLoops(const std::vector<size_t>& extents,
+                                   size_t axis,
+                                   const std::vector<size_t>& inStride,
+                                   size_t inDist,
+                                   const std::vector<size_t>& outStride,
+                                   size_t outDist, size_t batch) {
+  std::vector<Loop> loops;
+
+  for (size_t d = 0; d < extents.size(); d++) {
+    if (d != axis) {
+      Loop loop = {extents[d], inStride[d], outStride[d]};
+      loops.push_back(loop);
+    }
+  }
+
+  Loop batches = {batch, inDist, outDist};
+  loops.push_back(batches);
+  return loops;
+}
+
+//  Elements an array spans, from its first to its last
+static size_t Span(const std::vector<size_t>& extents,
+                   const std::vector<size_t>& stride, size_t dist,
+                   size_t batch) {
+  size_t last = (batch - 1) * dist;
+
+  for (size_t d = 0; d < extents.size(); d++) {
+    last += (extents[d] - 1) * stride[d];
+  }
+
+  return last + 1;
+}
+
+static bool Supports(const FFTPlan* fftPlan) {
+  if (fftPlan->precision == HCFFT_HALF || !fftPlan->loadCallback.empty() ||
+      !fftPlan->storeCallback.empty() ||
+      fftPlan->transposeType != HCFFT_NOTRANSPOSE ||
+      fftPlan->ipLayout == HCFFT_COMPLEX_PLANAR ||
+      fftPlan->ipLayout == HCFFT_HERMITIAN_PLANAR ||
+      fftPlan->opLayout == HCFFT_COMPLEX_PLANAR ||
+      fftPlan->opLayout == HCFFT_HERMITIAN_PLANAR) {
+    return false;
+  }
+
+  for (size_t d = 0; d < fftPlan->length.size(); d++) {
+    if (!Factorable(fftPlan->length[d])) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+//  Run the plan on host memory
+template <typename T>
+static hcfftStatus Transform(const FFTPlan* fftPlan, hcfftDirection dir,
+                             const T* input, T* output) {
+  const size_t rank = fftPlan->length.size();
+  const std::vector<size_t>& length = fftPlan->length;
+  const T scale = static_cast<T>((dir == HCFFT_FORWARD)
+                                     ? fftPlan->forwardScale
+                                     : fftPlan->backwardScale);
+  const bool r2c = (fftPlan->ipLayout == HCFFT_REAL);
+  const bool c2r = (fftPlan->opLayout == HCFFT_REAL);
+  const size_t batch = fftPlan->batchSize;
+  // Hermitian arrays keep half of the first axis
+  std::vector<size_t> extents = length;
+
+  if (r2c || c2r) {
+    extents[0] = length[0] / 2 + 1;
+  }
+
+  hcfftStatus status = HCFFT_SUCCEEDS;
+
+  if (c2r) {
+    // Outer axes from the input to a packed Hermitian array, the first axis
+    // from there to the output
+    std::vector<T> packed;
+    const T* source = input;
+    std::vector<size_t> sourceStride = fftPlan->inStride;
+    size_t sourceDist = fftPlan->iDist;
+
+    if (rank > 1) {
+      std::vector<size_t> stride(rank, 1);
+
+      for (size_t d = 1; d < rank; d++) {
+        stride[d] = stride[d - 1] * extents[d - 1];
+      }
+
+      size_t dist = stride[rank - 1] * extents[rank - 1];
+      packed.resize(2 * dist * batch);
+
+      for (size_t d = 1; d < rank && status == HCFFT_SUCCEEDS; d++) {
+        Lines<T> lines;
+        lines.length = lines.keep = length[d];
+        lines.input = (d == 1) ? input : &packed[0];
+        lines.output = &packed[0];
+        lines.inStride = (d == 1) ? fftPlan->inStride[d] : stride[d];
+        lines.outStride = stride[d];
+        lines.loops = AxisLoops(extents, d,
+                                (d == 1) ? fftPlan->inStride : stride,
+                                (d == 1) ? fftPlan->iDist : dist, stride,
+                                dist, batch);
+        status = RunLines(fftPlan, dir, lines);
+      }
+
+      source = &packed[0];
+      sourceStride = stride;
+      sourceDist = dist;
+    }
+
+    Lines<T> lines;
+    lines.length = lines.keep = length[0];
+    lines.input = source;
+    lines.output = output;
+    lines.inStride = sourceStride[0];
+    lines.outStride = fftPlan->outStride[0];
+    lines.hermitianIn = true;
+    lines.realOut = true;
+    lines.scale = scale;
+    lines.loops = AxisLoops(extents, 0, sourceStride, sourceDist,
+                            fftPlan->outStride, fftPlan->oDist, batch);
+    return (status == HCFFT_SUCCEEDS) ? RunLines(fftPlan, dir, lines)
+                                      : status;
+  }
+
+  // The first axis from the input to the output, the others in place
+  for (size_t d = 0; d < rank && status == HCFFT_SUCCEEDS; d++) {
+    Lines<T> lines;
+    lines.length = length[d];
+    lines.keep = (d == 0) ? extents[0] : length[d];
+    lines.input = (d == 0) ? input : output;
+    lines.output = output;
+    lines.inStride = (d == 0) ? fftPlan->inStride[d] : fftPlan->outStride[d];
+    lines.outStride = fftPlan->outStride[d];
+    lines.realIn = r2c && (d == 0);
+    lines.scale = (d == rank - 1) ? scale : 1;
+    lines.loops =
+        AxisLoops(extents, d, (d == 0) ? fftPlan->inStride : fftPlan->outStride,
+                  (d == 0) ? fftPlan->iDist : fftPlan->oDist,
+                  fftPlan->outStride, fftPlan->oDist, batch);
+    status = RunLines(fftPlan, dir, lines);
+  }
+
+  return status;
+}
+};  // namespace HostEngine
+
+bool FFTPlan::RunsOnHost(bool hostData) const {
+  switch (backend) {
+    case HCFFT_BACKEND_HOST:
+      return true;
+
+    case HCFFT_BACKEND_ACCELERATOR:
+      return false;
+
+    default:
+      break;
+  }
+
+  if (!HostEngine::Supports(this)) {
+    return false;
+  }
+
+  // No accelerator to run on
+  if (acc.get_is_emulated()) {
+    return true;
+  }
+
+  size_t elements = batchSize;
+
+  for (size_t d = 0; d < length.size(); d++) {
+    elements *= length[d];
+  }
+
+  return hostData && (elements <= HostEngine::kTinyElements);
+}
+
+template <typename T>
+hcfftStatus FFTPlan::hcfftEnqueueOnHost(hcfftPlanHandle plHandle,
+                                        hcfftDirection dir, T* input,
+                                        T* output, bool deviceData) {
+  FFTRepo& fftRepo = FFTRepo::getInstance();
+  FFTPlan* fftPlan = NULL;
+  lockRAII* planLock = NULL;
+
+  if (fftRepo.getPlan(plHandle, fftPlan, planLock) != HCFFT_SUCCEEDS) {
+    return HCFFT_INVALID;
+  }
+
+  scopedLock sLock(*planLock, _T(" hcfftEnqueueOnHost"));
+  ARG_CHECK(input != NULL && output != NULL)
+
+  if ((sizeof(T) == sizeof(double)) != (fftPlan->precision == HCFFT_DOUBLE) ||
+      !HostEngine::Supports(fftPlan)) {
+    return HCFFT_INVALID;
+  }
+
+  // Memory of an emulated accelerator is host memory
+  if (!deviceData || fftPlan->acc.get_is_emulated()) {
+    return HostEngine::Transform<T>(fftPlan, dir, input, output);
+  }
+
+  // Device memory goes through host copies; the output is read as well so
+  // the gaps of strided layouts come back unchanged
+  std::vector<size_t> inExtents = fftPlan->length;
+  std::vector<size_t> outExtents = fftPlan->length;
+
+  if (fftPlan->opLayout == HCFFT_HERMITIAN_INTERLEAVED) {
+    outExtents[0] = outExtents[0] / 2 + 1;
+  }
+
+  if (fftPlan->ipLayout == HCFFT_HERMITIAN_INTERLEAVED) {
+    inExtents[0] = inExtents[0] / 2 + 1;
+  }
+
+  size_t inCount = HostEngine::Span(inExtents, fftPlan->inStride,
+                                    fftPlan->iDist, fftPlan->batchSize) *
+                   ((fftPlan->ipLayout == HCFFT_REAL) ? 1 : 2);
+  size_t outCount = HostEngine::Span(outExtents, fftPlan->outStride,
+                                     fftPlan->oDist, fftPlan->batchSize) *
+                    ((fftPlan->opLayout == HCFFT_REAL) ? 1 : 2);
+
+  if (input == output) {
+    std::vector<T> data(std::max(inCount, outCount));
+    fftPlan->acc_view.copy(input, &data[0], data.size() * sizeof(T));
+    hcfftStatus status =
+        HostEngine::Transform<T>(fftPlan, dir, &data[0], &data[0]);
+    fftPlan->acc_view.copy(&data[0], output, data.size() * sizeof(T));
+    return status;
+  }
+
+  std::vector<T> in(inCount), out(outCount);
+  fftPlan->acc_view.copy(input, &in[0], inCount * sizeof(T));
+  fftPlan->acc_view.copy(output, &out[0], outCount * sizeof(T));
+  hcfftStatus status = HostEngine::Transform<T>(fftPlan, dir, &in[0], &out[0]);
+  fftPlan->acc_view.copy(&out[0], output, outCount * sizeof(T));
+  return status;
+}
+
+// Template Initialization supporting just float and double types
+template hcfftStatus FFTPlan::hcfftEnqueueOnHost<float>(
+    hcfftPlanHandle plHandle, hcfftDirection dir, float* input, float* output,
+    bool deviceData);
+template hcfftStatus FFTPlan::hcfftEnqueueOnHost<double>(
+    hcfftPlanHandle plHandle, hcfftDirection dir, double* input,
+    double* output, bool deviceData);
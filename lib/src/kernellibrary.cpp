@@ -0,0 +1,788 @@
+/*
+Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "include/hcfftlib.h"
+#include <limits.h>
+#include <math.h>
+#include <algorithm>
+
+// Precompiled kernels
+//
+//   Complex interleaved transforms of up to three axes, each short enough for
+//   one tile to hold a line in LDS and made of the prime factors 2, 3, 5, 7,
+//   11 and 13, run on Stockham kernels that are part of libhcfft rather than
+//   generated and compiled when the plan is baked. The kernels are templates
+//   on the precision, the direction and the radix of each butterfly; the
+//   length, the strides, the radices of the passes and the twiddles are
+//   arguments. Baking such a plan only uploads its twiddle table, which saves
+//   the generation, the compilation and the loading of a kernel library, at
+//   the price of kernels that are not specialized for one length.
+//
+//   Every axis is one launch. A tile transforms linesPerTile lines of the axis
+//   with itemsPerLine work-items each: the lines are loaded into LDS, every
+//   pass reads one LDS buffer and writes the other, and the last buffer is
+//   stored with the scale of the plan. The first axis reads the input, the
+//   others run in place on the output.
+//
+//   Plans the kernels do not cover, and every plan when HCFFT_KERNEL_LIBRARY
+//   is set to 0, bake generated kernels as before.
+
+// Functions the kernels call are device functions to hcc; the host emulation
+// runs them as they are
+#ifdef HC_HOST_EMULATION
+#define HCFFT_KERNEL
+#else
+#define HCFFT_KERNEL [[hc]]
+#endif
+
+namespace KernelLibrary {
+//  LDS of a tile, two buffers of complex values
+static const size_t kLdsBytes = 32768;
+
+//  Passes of an axis; the shortest radix is 2, so this covers any length
+//  the LDS holds
+static const size_t kMaxPasses = 16;
+
+//  Axes the lines of one axis are spread over: the other axes and the batch
+static const size_t kMaxOuter = 3;
+
+//  Work-items per line, and per tile before more lines are added to it
+static const size_t kMaxItems = 256;
+static const size_t kTileItems = 64;
+
+//  Radices the kernels are instantiated for, in the order lengths are
+//  factored
+static const size_t kRadices[] = {8, 4, 2, 3, 5, 7, 11, 13};
+
+//  Complex values of one LDS buffer
+template <typename R>
+struct Elements {
+  static const size_t kCount = kLdsBytes / (4 * sizeof(R));
+};
+
+//  One launch: the lines of one axis of the plan. Twiddles and roots index
+//  the twiddle table of the plan in complex values
+struct Axis {
+  unsigned length;
+  unsigned passes;
+  unsigned radices[kMaxPasses];
+  unsigned twiddles[kMaxPasses];  // W^(k q) of the pass, LS * R of them
+  unsigned roots[kMaxPasses];     // roots of unity of the radix, R of them
+  unsigned itemsPerLine;
+  unsigned linesPerTile;
+  unsigned outer;
+  size_t lines;
+  size_t counts[kMaxOuter];
+  size_t inStrides[kMaxOuter];
+  size_t outStrides[kMaxOuter];
+  size_t inStride;  // between the elements of a line
+  size_t outStride;
+  double scale;
+
+  size_t Tiles() const { return (lines + linesPerTile - 1) / linesPerTile; }
+
+  size_t TileItems() const { return itemsPerLine * linesPerTile; }
+};
+
+static bool Radices(size_t length, std::vector<size_t>* radices) {
+  const size_t count = sizeof(kRadices) / sizeof(kRadices[0]);
+  radices->clear();
+
+  while (length > 1) {
+    size_t r = 0;
+
+    while ((r < count) && (length % kRadices[r])) {
+      r++;
+    }
+
+    if (r == count) {
+      return false;
+    }
+
+    radices->push_back(kRadices[r]);
+    length /= kRadices[r];
+  }
+
+  return true;
+}
+
+static size_t ElementsPerBuffer(hcfftPrecision precision) {
+  return (precision == HCFFT_DOUBLE) ? Elements<double>::kCount
+                                     : Elements<float>::kCount;
+}
+
+//  The launches of a plan, in the order they run, and the complex values of
+//  its twiddle table. Axes of length 1 are skipped unless all of them are
+static bool Axes(const FFTPlan* fftPlan, std::vector<Axis>* axes,
+                 size_t* tableCount) {
+  const size_t rank = fftPlan->length.size();
+  const size_t limit = ElementsPerBuffer(fftPlan->precision);
+  std::vector<size_t> active;
+  size_t table = 0;
+
+  for (size_t d = 0; d < rank; d++) {
+    if (fftPlan->length[d] > 1) {
+      active.push_back(d);
+    }
+  }
+
+  if (active.empty()) {
+    active.push_back(0);
+  }
+
+  axes->clear();
+
+  for (size_t i = 0; i < active.size(); i++) {
+    const size_t d = active[i];
+    const bool first = (i == 0);
+    const std::vector<size_t>& inStride =
+        first ? fftPlan->inStride : fftPlan->outStride;
+    const size_t iDist = first ? fftPlan->iDist : fftPlan->oDist;
+    std::vector<size_t> radices;
+
+    if ((fftPlan->length[d] > limit) ||
+        !Radices(fftPlan->length[d], &radices) ||
+        (radices.size() > kMaxPasses)) {
+      return false;
+    }
+
+    Axis axis;
+    axis.length = static_cast<unsigned>(fftPlan->length[d]);
+    axis.passes = static_cast<unsigned>(radices.size());
+    size_t ls = 1, maxRadix = 1;
+
+    for (size_t p = 0; p < radices.size(); p++) {
+      axis.radices[p] = static_cast<unsigned>(radices[p]);
+      axis.twiddles[p] = static_cast<unsigned>(table);
+      table += ls * radices[p];
+      axis.roots[p] = static_cast<unsigned>(table);
+      table += radices[p];
+      ls *= radices[p];
+      maxRadix = std::max(maxRadix, radices[p]);
+    }
+
+    axis.outer = 0;
+    axis.lines = 1;
+
+    for (size_t e = 0; e < rank; e++) {
+      if ((e != d) && (fftPlan->length[e] > 1)) {
+        axis.counts[axis.outer] = fftPlan->length[e];
+        axis.inStrides[axis.outer] = inStride[e];
+        axis.outStrides[axis.outer] = fftPlan->outStride[e];
+        axis.lines *= fftPlan->length[e];
+        axis.outer++;
+      }
+    }
+
+    if (fftPlan->batchSize > 1) {
+      axis.counts[axis.outer] = fftPlan->batchSize;
+      axis.inStrides[axis.outer] = iDist;
+      axis.outStrides[axis.outer] = fftPlan->oDist;
+      axis.lines *= fftPlan->batchSize;
+      axis.outer++;
+    }
+
+    axis.inStride = inStride[d];
+    axis.outStride = fftPlan->outStride[d];
+    axis.scale = 1;
+    axis.itemsPerLine = static_cast<unsigned>(
+        std::max<size_t>(1, std::min(kMaxItems, axis.length / maxRadix)));
+    axis.linesPerTile = static_cast<unsigned>(std::min(
+        std::min(std::max<size_t>(1, kTileItems / axis.itemsPerLine),
+                 limit / axis.length),
+        axis.lines));
+
+    // The grid of the launch is an int
+    if (axis.Tiles() > static_cast<size_t>(INT_MAX) / axis.TileItems()) {
+      return false;
+    }
+
+    axes->push_back(axis);
+  }
+
+  if (tableCount != NULL) {
+    *tableCount = table;
+  }
+
+  return true;
+}
+
+//  Floating point operations of one butterfly, as the kernels compute it
+static double ButterflyFlops(size_t radix) {
+  switch (radix) {
+    case 2:
+      return 4;
+
+    case 4:
+      return 16;
+
+    case 8:
+      return 56;
+
+    default:
+      return 8.0 * radix * (radix - 1);
+  }
+}
+
+//  Add the launch of one axis to cost; the first axis reads the input layout.
+//  Returns the largest radix of its passes
+static size_t AxisCost(const FFTPlan* fftPlan, const Axis& axis, bool first,
+                       FFTKernelCost* cost) {
+  double elements =
+      static_cast<double>(std::max<size_t>(1, fftPlan->batchSize));
+
+  for (size_t u = 0; u < fftPlan->length.size(); u++) {
+    elements *= fftPlan->length[u];
+  }
+
+  double lines = static_cast<double>(axis.lines);
+  size_t maxRadix = 1;
+  size_t ls = 1;
+
+  for (size_t p = 0; p < axis.passes; p++) {
+    size_t r = axis.radices[p];
+    double twiddles = (ls > 1) ? 6.0 * (r - 1) : 0.0;
+    cost->radices.push_back(r);
+    cost->flops += lines * static_cast<double>(axis.length / r) *
+                   (ButterflyFlops(r) + twiddles);
+    maxRadix = std::max(maxRadix, r);
+    ls *= r;
+  }
+
+  cost->bytesRead += fftPlan->LayoutBytes(
+      first ? fftPlan->ipLayout : fftPlan->opLayout, elements);
+  cost->bytesWritten += fftPlan->LayoutBytes(fftPlan->opLayout, elements);
+  cost->ldsBytes +=
+      elements * fftPlan->ElementSize() * (2.0 + 2.0 * axis.passes);
+  cost->barriers += 1 + axis.passes;
+  return maxRadix;
+}
+
+//  Forward twiddles and roots of every pass; the backward kernels conjugate
+//  them
+template <typename R>
+static void BuildTable(const std::vector<Axis>& axes, size_t count,
+                       std::vector<R>* table) {
+  const double TWO_PI = -6.283185307179586476925286766559;
+  table->assign(2 * count, 0);
+
+  for (size_t a = 0; a < axes.size(); a++) {
+    const Axis& axis = axes[a];
+    size_t ls = 1;
+
+    for (size_t p = 0; p < axis.passes; p++) {
+      size_t r = axis.radices[p];
+      R* twiddles = &(*table)[2 * axis.twiddles[p]];
+      R* roots = &(*table)[2 * axis.roots[p]];
+
+      for (size_t k = 0; k < ls; k++) {
+        for (size_t q = 0; q < r; q++) {
+          double theta = TWO_PI * static_cast<double>(k * q) /
+                         static_cast<double>(ls * r);
+          twiddles[2 * (k * r + q)] = static_cast<R>(cos(theta));
+          twiddles[2 * (k * r + q) + 1] = static_cast<R>(sin(theta));
+        }
+      }
+
+      for (size_t q = 0; q < r; q++) {
+        double theta =
+            TWO_PI * static_cast<double>(q) / static_cast<double>(r);
+        roots[2 * q] = static_cast<R>(cos(theta));
+        roots[2 * q + 1] = static_cast<R>(sin(theta));
+      }
+
+      ls *= r;
+    }
+  }
+}
+
+//  DFT of radix N in registers, from the roots of unity of the pass
+template <typename R, int N, bool FWD>
+struct Butterfly {
+  static void Run(R* re, R* im, const R* roots) HCFFT_KERNEL {
+    R yr[N], yi[N];
+
+    for (int s = 0; s < N; s++) {
+      R sr = re[0];
+      R si = im[0];
+
+      for (int q = 1; q < N; q++) {
+        int w = (s * q) % N;
+        R wr = roots[2 * w];
+        R wi = FWD ? roots[2 * w + 1] : -roots[2 * w + 1];
+        sr += re[q] * wr - im[q] * wi;
+        si += re[q] * wi + im[q] * wr;
+      }
+
+      yr[s] = sr;
+      yi[s] = si;
+    }
+
+    for (int s = 0; s < N; s++) {
+      re[s] = yr[s];
+      im[s] = yi[s];
+    }
+  }
+};
+
+template <typename R, bool FWD>
+struct Butterfly<R, 2, FWD> {
+  static void Run(R* re, R* im, const R*) HCFFT_KERNEL {
+    R tr = re[0] - re[1];
+    R ti = im[0] - im[1];
+    re[0] += re[1];
+    im[0] += im[1];
+    re[1] = tr;
+    im[1] = ti;
+  }
+};
+
+//  Radix 4 on the elements a, b, c and d of re and im, in place
+template <typename R, bool FWD>
+inline void Radix4(R* re, R* im, int a, int b, int c, int d) HCFFT_KERNEL {
+  R t0r = re[a] + re[c], t0i = im[a] + im[c];
+  R t1r = re[a] - re[c], t1i = im[a] - im[c];
+  R t2r = re[b] + re[d], t2i = im[b] + im[d];
+  R t3r = re[b] - re[d], t3i = im[b] - im[d];
+  re[a] = t0r + t2r;
+  im[a] = t0i + t2i;
+  re[c] = t0r - t2r;
+  im[c] = t0i - t2i;
+
+  // t1 -+ i t3
+  if (FWD) {
+    re[b] = t1r + t3i;
+    im[b] = t1i - t3r;
+    re[d] = t1r - t3i;
+    im[d] = t1i + t3r;
+  } else {
+    re[b] = t1r - t3i;
+    im[b] = t1i + t3r;
+    re[d] = t1r + t3i;
+    im[d] = t1i - t3r;
+  }
+}
+
+template <typename R, bool FWD>
+struct Butterfly<R, 4, FWD> {
+  static void Run(R* re, R* im, const R*) HCFFT_KERNEL {
+    Radix4<R, FWD>(re, im, 0, 1, 2, 3);
+  }
+};
+
+//  Radix 4 on the even and on the odd elements, combined with W8^k
+template <typename R, bool FWD>
+struct Butterfly<R, 8, FWD> {
+  static void Run(R* re, R* im, const R*) HCFFT_KERNEL {
+    const R c = static_cast<R>(0.70710678118654752440084436210485);
+    Radix4<R, FWD>(re, im, 0, 2, 4, 6);
+    Radix4<R, FWD>(re, im, 1, 3, 5, 7);
+    R er[4] = {re[0], re[2], re[4], re[6]};
+    R ei[4] = {im[0], im[2], im[4], im[6]};
+    R orr[4], oi[4];
+    orr[0] = re[1];
+    oi[0] = im[1];
+
+    if (FWD) {
+      orr[1] = c * (re[3] + im[3]);
+      oi[1] = c * (im[3] - re[3]);
+      orr[2] = im[5];
+      oi[2] = -re[5];
+      orr[3] = c * (im[7] - re[7]);
+      oi[3] = -c * (re[7] + im[7]);
+    } else {
+      orr[1] = c * (re[3] - im[3]);
+      oi[1] = c * (re[3] + im[3]);
+      orr[2] = -im[5];
+      oi[2] = re[5];
+      orr[3] = -c * (re[7] + im[7]);
+      oi[3] = c * (re[7] - im[7]);
+    }
+
+    for (int k = 0; k < 4; k++) {
+      re[k] = er[k] + orr[k];
+      im[k] = ei[k] + oi[k];
+      re[k + 4] = er[k] - orr[k];
+      im[k + 4] = ei[k] - oi[k];
+    }
+  }
+};
+
+//  One Stockham pass of radix N over a line in LDS, from src to dst:
+//  butterfly j of the m = L / N reads elements j + q m, twiddled by
+//  W^(k q) with k = j mod LS, and writes (j - k) N + k + q LS
+template <typename R, int N, bool FWD>
+inline void Pass(const Axis& axis, unsigned p, unsigned ls, unsigned item,
+                 const R* src, R* dst, const R* table) HCFFT_KERNEL {
+  const unsigned m = axis.length / N;
+  const R* twiddles = table + 2 * axis.twiddles[p];
+  const R* roots = table + 2 * axis.roots[p];
+
+  for (unsigned j = item; j < m; j += axis.itemsPerLine) {
+    const unsigned k = j % ls;
+    R re[N], im[N];
+
+    for (int q = 0; q < N; q++) {
+      re[q] = src[2 * (j + q * m)];
+      im[q] = src[2 * (j + q * m) + 1];
+    }
+
+    if (ls > 1) {
+      for (int q = 1; q < N; q++) {
+        R wr = twiddles[2 * (k * N + q)];
+        R wi = FWD ? twiddles[2 * (k * N + q) + 1]
+                   : -twiddles[2 * (k * N + q) + 1];
+        R xr = re[q];
+        re[q] = xr * wr - im[q] * wi;
+        im[q] = xr * wi + im[q] * wr;
+      }
+    }
+
+    Butterfly<R, N, FWD>::Run(re, im, roots);
+    const unsigned out = (j - k) * N + k;
+
+    for (int q = 0; q < N; q++) {
+      dst[2 * (out + q * ls)] = re[q];
+      dst[2 * (out + q * ls) + 1] = im[q];
+    }
+  }
+}
+
+template <typename R, bool FWD>
+inline void RunPass(const Axis& axis, unsigned p, unsigned ls, unsigned item,
+                    const R* src, R* dst, const R* table) HCFFT_KERNEL {
+  switch (axis.radices[p]) {
+    case 2:
+      Pass<R, 2, FWD>(axis, p, ls, item, src, dst, table);
+      break;
+
+    case 3:
+      Pass<R, 3, FWD>(axis, p, ls, item, src, dst, table);
+      break;
+
+    case 4:
+      Pass<R, 4, FWD>(axis, p, ls, item, src, dst, table);
+      break;
+
+    case 5:
+      Pass<R, 5, FWD>(axis, p, ls, item, src, dst, table);
+      break;
+
+    case 7:
+      Pass<R, 7, FWD>(axis, p, ls, item, src, dst, table);
+      break;
+
+    case 8:
+      Pass<R, 8, FWD>(axis, p, ls, item, src, dst, table);
+      break;
+
+    case 11:
+      Pass<R, 11, FWD>(axis, p, ls, item, src, dst, table);
+      break;
+
+    case 13:
+      Pass<R, 13, FWD>(axis, p, ls, item, src, dst, table);
+      break;
+
+    default:
+      break;
+  }
+}
+
+//  Transform every line of one axis; input and output may be the same
+template <typename R, bool FWD>
+static void Launch(hc::accelerator_view& view, const Axis axis,
+                   const R* input, R* output, const R* table) {
+  const int tileItems = static_cast<int>(axis.TileItems());
+  hc::extent<1> grid(static_cast<int>(axis.Tiles()) * tileItems);
+  hc::parallel_for_each(view, grid.tile(tileItems), [=](
+      hc::tiled_index<1> tidx) HCFFT_KERNEL {
+    tile_static R lds[4 * Elements<R>::kCount];
+    const unsigned me = tidx.local[0];
+    const unsigned slot = me / axis.itemsPerLine;
+    const unsigned item = me % axis.itemsPerLine;
+    const size_t line =
+        static_cast<size_t>(tidx.tile[0]) * axis.linesPerTile + slot;
+    // Work-items of the lines past the end wait at the barriers only
+    const bool active = (line < axis.lines);
+    const unsigned length = axis.length;
+    R* src = lds + 2 * slot * length;
+    R* dst = src + 2 * Elements<R>::kCount;
+    size_t inOffset = 0, outOffset = 0, rest = line;
+
+    for (unsigned d = 0; d < axis.outer; d++) {
+      size_t index = rest % axis.counts[d];
+      rest /= axis.counts[d];
+      inOffset += index * axis.inStrides[d];
+      outOffset += index * axis.outStrides[d];
+    }
+
+    if (active) {
+      for (unsigned e = item; e < length; e += axis.itemsPerLine) {
+        src[2 * e] = input[2 * (inOffset + e * axis.inStride)];
+        src[2 * e + 1] = input[2 * (inOffset + e * axis.inStride) + 1];
+      }
+    }
+
+    tidx.barrier.wait_with_tile_static_memory_fence();
+    unsigned ls = 1;
+
+    for (unsigned p = 0; p < axis.passes; p++) {
+      if (active) {
+        RunPass<R, FWD>(axis, p, ls, item, src, dst, table);
+      }
+
+      tidx.barrier.wait_with_tile_static_memory_fence();
+      ls *= axis.radices[p];
+      R* last = src;
+      src = dst;
+      dst = last;
+    }
+
+    if (active) {
+      const R scale = static_cast<R>(axis.scale);
+
+      for (unsigned e = item; e < length; e += axis.itemsPerLine) {
+        output[2 * (outOffset + e * axis.outStride)] = src[2 * e] * scale;
+        output[2 * (outOffset + e * axis.outStride) + 1] =
+            src[2 * e + 1] * scale;
+      }
+    }
+  }).wait();
+}
+
+template <typename R>
+static void UploadTable(FFTPlan* fftPlan, const std::vector<Axis>& axes,
+                        size_t count) {
+  // Lines of length 1 have no passes, but the table is allocated all the same
+  std::vector<R> table;
+  BuildTable<R>(axes, std::max<size_t>(1, count), &table);
+  size_t bytes = table.size() * sizeof(R);
+  fftPlan->twiddles = hc::am_alloc(bytes, fftPlan->acc, KernelAllocFlags());
+  assert(fftPlan->twiddles != NULL);
+  hc::accelerator_view accl_view = fftPlan->acc.get_default_view();
+  accl_view.copy(&table[0], fftPlan->twiddles, bytes);
+  FFTMetrics::Add(METRIC_TWIDDLE_BYTES, bytes);
+}
+};  // namespace KernelLibrary
+
+bool FFTPlan::LibraryPossible() const {
+  const char* value = getenv("HCFFT_KERNEL_LIBRARY");
+
+  if (value != NULL && atoi(value) == 0) {
+    return false;
+  }
+
+  // A column method asks for the decomposition of the generated kernels
+  if (columnMethod != HCFFT_COLUMNS_AUTO) {
+    return false;
+  }
+
+  if ((ipLayout != HCFFT_COMPLEX_INTERLEAVED) ||
+      (opLayout != HCFFT_COMPLEX_INTERLEAVED) ||
+      ((precision != HCFFT_SINGLE) && (precision != HCFFT_DOUBLE)) ||
+      (transposeType != HCFFT_NOTRANSPOSE) || (gen == Copy) ||
+      !loadCallback.empty() || !storeCallback.empty()) {
+    return false;
+  }
+
+  if (length.empty() || (length.size() > 3) ||
+      (inStride.size() < length.size()) ||
+      (outStride.size() < length.size())) {
+    return false;
+  }
+
+  // In-place plans of different layouts are rejected when they are baked
+  if ((location == HCFFT_INPLACE) &&
+      ((inStride != outStride) || (iDist != oDist))) {
+    return false;
+  }
+
+  std::vector<KernelLibrary::Axis> axes;
+  return KernelLibrary::Axes(this, &axes, NULL);
+}
+
+hcfftStatus FFTPlan::hcfftBakeLibrary() {
+  std::vector<KernelLibrary::Axis> axes;
+  size_t count = 0;
+
+  if (!KernelLibrary::Axes(this, &axes, &count)) {
+    return HCFFT_INVALID;
+  }
+
+  if (NULL != twiddles) {
+    if (hc::am_free(twiddles) != AM_SUCCESS) {
+      return HCFFT_INVALID;
+    }
+
+    twiddles = NULL;
+  }
+
+  if (NULL != twiddleslarge) {
+    if (hc::am_free(twiddleslarge) != AM_SUCCESS) {
+      return HCFFT_INVALID;
+    }
+
+    twiddleslarge = NULL;
+  }
+
+  {
+    FFTBakeTimer timer(BAKE_TWIDDLES);
+
+    if (precision == HCFFT_DOUBLE) {
+      KernelLibrary::UploadTable<double>(this, axes, count);
+    } else {
+      KernelLibrary::UploadTable<float>(this, axes, count);
+    }
+  }
+
+  gen = Stockham_Library;
+  launchBytes = 0;
+  baked = true;
+  return HCFFT_SUCCEEDS;
+}
+
+template <typename T>
+hcfftStatus FFTPlan::hcfftEnqueueLibrary(hcfftPlanHandle plHandle,
+                                         hcfftDirection dir, T* input,
+                                         T* output) {
+  FFTRepo& fftRepo = FFTRepo::getInstance();
+  FFTPlan* fftPlan = NULL;
+  lockRAII* planLock = NULL;
+
+  if (fftRepo.getPlan(plHandle, fftPlan, planLock) != HCFFT_SUCCEEDS) {
+    return HCFFT_INVALID;
+  }
+
+  scopedLock sLock(*planLock, _T(" hcfftEnqueueLibrary"));
+  // In-place plans write the input
+  T* result = (fftPlan->location == HCFFT_INPLACE) ? input : output;
+  ARG_CHECK(input != NULL && result != NULL)
+
+  if ((sizeof(T) == sizeof(double)) != (fftPlan->precision == HCFFT_DOUBLE) ||
+      (fftPlan->gen != Stockham_Library) || (fftPlan->twiddles == NULL)) {
+    return HCFFT_INVALID;
+  }
+
+  std::vector<KernelLibrary::Axis> axes;
+
+  if (!KernelLibrary::Axes(fftPlan, &axes, NULL)) {
+    return HCFFT_INVALID;
+  }
+
+  const T* table = static_cast<const T*>(fftPlan->twiddles);
+  FFTProfiler& profiler = FFTProfiler::getInstance();
+  bool profiling = profiler.Enabled();
+
+  for (size_t i = 0; i < axes.size(); i++) {
+    KernelLibrary::Axis& axis = axes[i];
+    const T* source = (i == 0) ? input : result;
+    double start = profiling ? profiler.Now() : 0;
+
+    if (i + 1 == axes.size()) {
+      axis.scale = (dir == HCFFT_FORWARD) ? fftPlan->forwardScale
+                                          : fftPlan->backwardScale;
+    }
+
+    if (dir == HCFFT_FORWARD) {
+      KernelLibrary::Launch<T, true>(fftPlan->acc_view, axis, source, result,
+                                     table);
+    } else {
+      KernelLibrary::Launch<T, false>(fftPlan->acc_view, axis, source, result,
+                                      table);
+    }
+
+    // Every axis is a launch of its own in the profile
+    if (profiling) {
+      double duration = profiler.Now() - start;
+      FFTKernelCost cost;
+      cost.gen = Stockham_Library;
+      cost.name = "fft_fwd";
+      KernelLibrary::AxisCost(fftPlan, axis, i == 0, &cost);
+      profiler.Record(fftPlan, cost, start, duration);
+    }
+
+    FFTMetrics::Add(static_cast<FFTMetric>(METRIC_KERNELS + Stockham_Library));
+  }
+
+  if (fftPlan->launchBytes == 0) {
+    FFTKernelCost cost;
+    fftPlan->GetKernelCost(&cost);
+    fftPlan->launchBytes = cost.bytesRead + cost.bytesWritten;
+  }
+
+  FFTMetrics::Add(METRIC_KERNEL_BYTES,
+                  static_cast<int64_t>(fftPlan->launchBytes));
+  return HCFFT_SUCCEEDS;
+}
+
+// Template Initialization supporting just float and double types
+template hcfftStatus FFTPlan::hcfftEnqueueLibrary<float>(
+    hcfftPlanHandle plHandle, hcfftDirection dir, float* input, float* output);
+template hcfftStatus FFTPlan::hcfftEnqueueLibrary<double>(
+    hcfftPlanHandle plHandle, hcfftDirection dir, double* input,
+    double* output);
+
+// The work sizes of the first launch
+template <>
+hcfftStatus FFTPlan::GetWorkSizesPvt<Stockham_Library>(
+    std::vector<size_t>& globalWS, std::vector<size_t>& localWS) const {
+  std::vector<KernelLibrary::Axis> axes;
+
+  if (!KernelLibrary::Axes(this, &axes, NULL)) {
+    return HCFFT_INVALID;
+  }
+
+  globalWS.clear();
+  localWS.clear();
+  globalWS.push_back(axes[0].Tiles() * axes[0].TileItems());
+  localWS.push_back(axes[0].TileItems());
+  return HCFFT_SUCCEEDS;
+}
+
+// All launches of the plan together
+template <>
+hcfftStatus FFTPlan::GetKernelCostPvt<Stockham_Library>(
+    FFTKernelCost* cost) const {
+  std::vector<KernelLibrary::Axis> axes;
+  size_t count = 0;
+
+  if (!KernelLibrary::Axes(this, &axes, &count)) {
+    return HCFFT_INVALID;
+  }
+
+  size_t maxRadix = 1;
+  cost->gen = Stockham_Library;
+  cost->name = "fft_fwd";
+  cost->globalSize = axes[0].Tiles() * axes[0].TileItems();
+  cost->localSize = axes[0].TileItems();
+  cost->bytesRead = static_cast<double>(count) * this->ElementSize();
+
+  for (size_t a = 0; a < axes.size(); a++) {
+    maxRadix = std::max(
+        maxRadix, KernelLibrary::AxisCost(this, axes[a], a == 0, cost));
+  }
+
+  // The values of a butterfly and their results
+  cost->registers = 4 * maxRadix * this->ElementSize() / 8;
+  return HCFFT_SUCCEEDS;
+}
@@ -0,0 +1,240 @@
+/*
+Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "include/hcfftlib.h"
+#include <atomic>
+#include <string>
+#include <vector>
+
+// Runtime metrics
+//
+//   Kernels launched per generator and the global memory they move, plan
+//   executions and their latency, plans created and baked, kernel cache hits,
+//   misses and compilations, the device scratch the plans hold and the
+//   twiddle bytes uploaded. Counting sits on the execution path, so every
+//   thread owns a shard of counters it updates with plain relaxed loads and
+//   stores. The shard list is only locked when a thread starts or exits and
+//   when the metrics are read.
+
+const double FFTExecBucketBounds[FFT_EXEC_BUCKETS - 1] = {
+    1.0e-5, 1.0e-4, 1.0e-3, 1.0e-2, 1.0e-1, 1.0, 10.0};
+
+struct FFTMetricShard {
+  std::atomic<int64_t> values[METRIC_COUNT];
+
+  FFTMetricShard() {
+    for (int m = 0; m < METRIC_COUNT; m++) {
+      values[m].store(0, std::memory_order_relaxed);
+    }
+  }
+};
+
+// Shards of the live threads and the sums the exited threads left
+struct FFTMetricRegistry {
+  lockRAII lock;
+  std::vector<FFTMetricShard*> shards;
+  int64_t retired[METRIC_COUNT];
+
+  FFTMetricRegistry() : lock(_T("FFTMetricRegistry")) {
+    for (int m = 0; m < METRIC_COUNT; m++) {
+      retired[m] = 0;
+    }
+  }
+};
+
+// Constructed on first use, plans may be created from static initializers
+static FFTMetricRegistry& Registry() {
+  static FFTMetricRegistry registry;
+  return registry;
+}
+
+#if __has_feature(cxx_thread_local)
+// Shard of a thread, registered on its first count and folded into the
+// retired sums when the thread exits
+class FFTThreadShard {
+ public:
+  FFTMetricShard shard;
+
+  FFTThreadShard() {
+    FFTMetricRegistry& registry = Registry();
+    scopedLock sLock(registry.lock, _T("FFTThreadShard"));
+    registry.shards.push_back(&shard);
+  }
+
+  ~FFTThreadShard() {
+    FFTMetricRegistry& registry = Registry();
+    scopedLock sLock(registry.lock, _T("~FFTThreadShard"));
+
+    for (int m = 0; m < METRIC_COUNT; m++) {
+      registry.retired[m] += shard.values[m].load(std::memory_order_relaxed);
+    }
+
+    for (size_t i = 0; i < registry.shards.size(); i++) {
+      if (registry.shards[i] == &shard) {
+        registry.shards.erase(registry.shards.begin() + i);
+        break;
+      }
+    }
+  }
+};
+
+void FFTMetrics::Add(FFTMetric metric, int64_t value) {
+  // The registry outlives the shards of every thread
+  Registry();
+  static thread_local FFTThreadShard threadShard;
+  std::atomic<int64_t>& slot = threadShard.shard.values[metric];
+  // Only the owning thread writes its shard
+  slot.store(slot.load(std::memory_order_relaxed) + value,
+             std::memory_order_relaxed);
+}
+#else
+void FFTMetrics::Add(FFTMetric metric, int64_t value) {
+  static FFTMetricShard shared;
+  static bool registered = false;
+
+  if (!registered) {
+    FFTMetricRegistry& registry = Registry();
+    scopedLock sLock(registry.lock, _T("FFTMetrics::Add"));
+
+    if (!registered) {
+      registry.shards.push_back(&shared);
+      registered = true;
+    }
+  }
+
+  shared.values[metric].fetch_add(value, std::memory_order_relaxed);
+}
+#endif
+
+void FFTMetrics::AddExec(double seconds) {
+  int bucket = 0;
+
+  while (bucket < FFT_EXEC_BUCKETS - 1 &&
+         seconds > FFTExecBucketBounds[bucket]) {
+    bucket++;
+  }
+
+  Add(METRIC_EXECS);
+  Add(METRIC_EXEC_NANOSECONDS, static_cast<int64_t>(seconds * 1.0e9));
+  Add(static_cast<FFTMetric>(METRIC_EXEC_BUCKETS + bucket));
+}
+
+void FFTMetrics::Read(int64_t values[METRIC_COUNT]) {
+  FFTMetricRegistry& registry = Registry();
+  scopedLock sLock(registry.lock, _T("FFTMetrics::Read"));
+
+  for (int m = 0; m < METRIC_COUNT; m++) {
+    values[m] = registry.retired[m];
+
+    for (size_t i = 0; i < registry.shards.size(); i++) {
+      const FFTMetricShard* shard = registry.shards[i];
+      values[m] += shard->values[m].load(std::memory_order_relaxed);
+    }
+  }
+}
+
+// One metric family: HELP and TYPE lines
+static void PrometheusFamily(std::string& text, const char* name,
+                             const char* type, const char* help) {
+  text += std::string("# HELP ") + name + " " + help + "\n";
+  text += std::string("# TYPE ") + name + " " + type + "\n";
+}
+
+static void PrometheusSample(std::string& text, const char* name,
+                             const std::string& labels, int64_t value) {
+  text += name;
+  text += labels.empty() ? "" : "{" + labels + "}";
+  text += " " + std::to_string(value) + "\n";
+}
+
+std::string FFTMetrics::Prometheus() {
+  int64_t values[METRIC_COUNT];
+  Read(values);
+  std::string text;
+
+  PrometheusFamily(text, "hcfft_kernels_launched_total", "counter",
+                   "Kernels launched, by generator.");
+
+  for (int g = Stockham; g <= Stockham_Library; g++) {
+    PrometheusSample(
+        text, "hcfft_kernels_launched_total",
+        std::string("generator=\"") +
+            GeneratorName(static_cast<hcfftGenerators>(g)) + "\"",
+        values[METRIC_KERNELS + g]);
+  }
+
+  PrometheusFamily(text, "hcfft_kernel_bytes_total", "counter",
+                   "Global memory read and written by the launched kernels.");
+  PrometheusSample(text, "hcfft_kernel_bytes_total", "",
+                   values[METRIC_KERNEL_BYTES]);
+
+  // Histogram buckets are cumulative
+  PrometheusFamily(text, "hcfft_exec_seconds", "histogram",
+                   "Latency of plan executions.");
+  int64_t cumulative = 0;
+
+  for (int b = 0; b < FFT_EXEC_BUCKETS; b++) {
+    char bound[32] = "+Inf";
+
+    if (b < FFT_EXEC_BUCKETS - 1) {
+      snprintf(bound, sizeof(bound), "%g", FFTExecBucketBounds[b]);
+    }
+
+    cumulative += values[METRIC_EXEC_BUCKETS + b];
+    PrometheusSample(text, "hcfft_exec_seconds_bucket",
+                     std::string("le=\"") + bound + "\"", cumulative);
+  }
+
+  char sum[64];
+  snprintf(sum, sizeof(sum), "hcfft_exec_seconds_sum %.9f\n",
+           values[METRIC_EXEC_NANOSECONDS] * 1.0e-9);
+  text += sum;
+  PrometheusSample(text, "hcfft_exec_seconds_count", "", values[METRIC_EXECS]);
+
+  struct {
+    FFTMetric metric;
+    const char* name;
+    const char* type;
+    const char* help;
+  } scalars[] = {
+      {METRIC_PLANS_CREATED, "hcfft_plans_created_total", "counter",
+       "Plans created."},
+      {METRIC_PLANS_BAKED, "hcfft_plans_baked_total", "counter",
+       "Plans baked."},
+      {METRIC_CACHE_HITS, "hcfft_kernel_cache_hits_total", "counter",
+       "Bakes that found their kernel library in the cache."},
+      {METRIC_CACHE_MISSES, "hcfft_kernel_cache_misses_total", "counter",
+       "Bakes that generated their kernel library."},
+      {METRIC_COMPILES, "hcfft_kernel_compiles_total", "counter",
+       "Kernel libraries compiled."},
+      {METRIC_SCRATCH_BYTES, "hcfft_scratch_bytes", "gauge",
+       "Device scratch buffers held by the plans."},
+      {METRIC_TWIDDLE_BYTES, "hcfft_twiddle_bytes_total", "counter",
+       "Twiddle tables uploaded to the device."}};
+
+  for (size_t i = 0; i < sizeof(scalars) / sizeof(scalars[0]); i++) {
+    PrometheusFamily(text, scalars[i].name, scalars[i].type, scalars[i].help);
+    PrometheusSample(text, scalars[i].name, "", values[scalars[i].metric]);
+  }
+
+  return text;
+}
@@ -0,0 +1,222 @@
+/*
+Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "include/hcfftlib.h"
+#include <thread>
+
+// Multi-accelerator execution
+//
+//   A plan with a device set splits the batch of host execution into one
+//   contiguous range of transforms per device, in proportion to the device
+//   weights. Every device streams its range through a copy of the plan bound
+//   to its accelerator and queue, which owns the staging buffers and chunk
+//   plans of the device, on a thread of its own.
+
+std::vector<size_t> FFTDeviceSet::Split(size_t batch) const {
+  size_t devices = Count();
+  size_t total = 0;
+
+  for (size_t d = 0; d < devices; d++) {
+    total += Weight(d);
+  }
+
+  std::vector<size_t> shares(devices, 0);
+  size_t given = 0;
+
+  for (size_t d = 0; d < devices; d++) {
+    shares[d] = total ? batch * Weight(d) / total : batch / devices;
+    given += shares[d];
+  }
+
+  // The rounding remainder goes one transform at a time to the devices in
+  // order, skipping the ones without weight
+  for (size_t d = 0; given < batch; d = (d + 1) % devices) {
+    if (Weight(d) || total == 0) {
+      shares[d]++;
+      given++;
+    }
+  }
+
+  return shares;
+}
+
+FFTAcceleratorSet::FFTAcceleratorSet(
+    const std::vector<hc::accelerator>& accsVal)
+    : accs(accsVal) {
+  for (size_t d = 0; d < accs.size(); d++) {
+    views.push_back(accs[d].get_default_view());
+  }
+}
+
+FFTSimulatedDeviceSet::FFTSimulatedDeviceSet(
+    const hc::accelerator& accVal, const std::vector<size_t>& weightsVal)
+    : acc(accVal), weights(weightsVal) {
+  for (size_t d = 0; d < weights.size(); d++) {
+    views.push_back(acc.create_view());
+  }
+}
+
+//  Copy the settings of the user plan to the plan of a device, a change
+//  invalidates its bake
+static void SyncDevicePlan(const FFTPlan* fftPlan, FFTPlan* devicePlan,
+                           size_t batch) {
+  bool same = (devicePlan->batchSize == batch) &&
+              (devicePlan->inStride == fftPlan->inStride) &&
+              (devicePlan->outStride == fftPlan->outStride) &&
+              (devicePlan->iDist == fftPlan->iDist) &&
+              (devicePlan->oDist == fftPlan->oDist) &&
+              (devicePlan->transposeType == fftPlan->transposeType) &&
+              (devicePlan->columnMethod == fftPlan->columnMethod) &&
+              (devicePlan->forwardScale == fftPlan->forwardScale) &&
+              (devicePlan->backwardScale == fftPlan->backwardScale) &&
+              (devicePlan->loadCallback == fftPlan->loadCallback) &&
+              (devicePlan->storeCallback == fftPlan->storeCallback) &&
+              (devicePlan->loadCallbackInfo == fftPlan->loadCallbackInfo) &&
+              (devicePlan->storeCallbackInfo == fftPlan->storeCallbackInfo);
+
+  if (same) {
+    return;
+  }
+
+  devicePlan->batchSize = batch;
+  devicePlan->inStride = fftPlan->inStride;
+  devicePlan->outStride = fftPlan->outStride;
+  devicePlan->iDist = fftPlan->iDist;
+  devicePlan->oDist = fftPlan->oDist;
+  devicePlan->transposeType = fftPlan->transposeType;
+  devicePlan->columnMethod = fftPlan->columnMethod;
+  devicePlan->forwardScale = fftPlan->forwardScale;
+  devicePlan->backwardScale = fftPlan->backwardScale;
+  devicePlan->loadCallback = fftPlan->loadCallback;
+  devicePlan->storeCallback = fftPlan->storeCallback;
+  devicePlan->loadCallbackInfo = fftPlan->loadCallbackInfo;
+  devicePlan->storeCallbackInfo = fftPlan->storeCallbackInfo;
+  devicePlan->baked = false;
+}
+
+template <typename T>
+static void RunDevice(FFTPlan* devicePlan, hcfftPlanHandle deviceHandle,
+                      hcfftDirection dir, hcfftIpLayout iLayout,
+                      hcfftOpLayout oLayout, T* hostInput, T* hostOutput,
+                      hcfftStatus* status) {
+  *status = devicePlan->hcfftEnqueueHost<T>(deviceHandle, dir, iLayout,
+                                            oLayout, hostInput, hostOutput);
+}
+
+template <typename T>
+hcfftStatus FFTPlan::hcfftEnqueueDevices(hcfftPlanHandle plHandle,
+                                         hcfftDirection dir,
+                                         hcfftIpLayout iLayout,
+                                         hcfftOpLayout oLayout, T* hostInput,
+                                         T* hostOutput) {
+  FFTRepo& fftRepo = FFTRepo::getInstance();
+  FFTPlan* fftPlan = NULL;
+  lockRAII* planLock = NULL;
+
+  if (fftRepo.getPlan(plHandle, fftPlan, planLock) != HCFFT_SUCCEEDS) {
+    return HCFFT_INVALID;
+  }
+
+  scopedLock sLock(*planLock, _T(" hcfftEnqueueDevices"));
+  FFTDeviceSet* devices = fftPlan->deviceSet;
+  ARG_CHECK(devices != NULL && devices->Count() > 0)
+  std::vector<size_t> shares = devices->Split(fftPlan->batchSize);
+  std::vector<FFTPlan*> plans(devices->Count(), NULL);
+  fftPlan->devicePlans.resize(devices->Count(), 0);
+
+  // Set every device up before any of them starts
+  for (size_t d = 0; d < devices->Count(); d++) {
+    if (shares[d] == 0) {
+      continue;
+    }
+
+    lockRAII* deviceLock = NULL;
+
+    if (fftPlan->devicePlans[d] == 0) {
+      hcfftStatus status = hcfftCreateDefaultPlan(
+          &fftPlan->devicePlans[d], fftPlan->Rank(), &fftPlan->length[0],
+          fftPlan->direction, fftPlan->precision, fftPlan->hcfftlibtype);
+
+      if (status != HCFFT_SUCCEEDS) {
+        fftPlan->devicePlans[d] = 0;
+        return status;
+      }
+
+      fftRepo.getPlan(fftPlan->devicePlans[d], plans[d], deviceLock);
+      plans[d]->precision = fftPlan->precision;
+      plans[d]->location = fftPlan->location;
+      plans[d]->gen = fftPlan->gen;
+      plans[d]->envelope = fftPlan->envelope;
+      plans[d]->originalLength = fftPlan->originalLength;
+      plans[d]->acc = devices->Accelerator(d);
+      plans[d]->acc_view = devices->View(d);
+    } else {
+      fftRepo.getPlan(fftPlan->devicePlans[d], plans[d], deviceLock);
+    }
+
+    SyncDevicePlan(fftPlan, plans[d], shares[d]);
+    plans[d]->streamMemory =
+        fftPlan->streamMemory ? fftPlan->streamMemory : devices->Memory(d);
+  }
+
+  size_t inElem = (iLayout == HCFFT_REAL) ? sizeof(T) : 2 * sizeof(T);
+  size_t outElem = (oLayout == HCFFT_REAL) ? sizeof(T) : 2 * sizeof(T);
+  std::vector<hcfftStatus> status(devices->Count(), HCFFT_SUCCEEDS);
+  std::vector<std::thread> workers;
+  size_t first = 0;
+
+  for (size_t d = 0; d < devices->Count(); d++) {
+    if (shares[d] == 0) {
+      continue;
+    }
+
+    // The range of the device in both host buffers
+    T* input = reinterpret_cast<T*>(reinterpret_cast<char*>(hostInput) +
+                                    first * fftPlan->iDist * inElem);
+    T* output = reinterpret_cast<T*>(reinterpret_cast<char*>(hostOutput) +
+                                     first * fftPlan->oDist * outElem);
+    workers.push_back(std::thread(RunDevice<T>, plans[d],
+                                  fftPlan->devicePlans[d], dir, iLayout,
+                                  oLayout, input, output, &status[d]));
+    first += shares[d];
+  }
+
+  for (size_t w = 0; w < workers.size(); w++) {
+    workers[w].join();
+  }
+
+  for (size_t d = 0; d < devices->Count(); d++) {
+    if (status[d] != HCFFT_SUCCEEDS) {
+      return status[d];
+    }
+  }
+
+  return HCFFT_SUCCEEDS;
+}
+
+// Template Initialization supporting just float and double types
+template hcfftStatus FFTPlan::hcfftEnqueueDevices<float>(
+    hcfftPlanHandle plHandle, hcfftDirection dir, hcfftIpLayout iLayout,
+    hcfftOpLayout oLayout, float* hostInput, float* hostOutput);
+template hcfftStatus FFTPlan::hcfftEnqueueDevices<double>(
+    hcfftPlanHandle plHandle, hcfftDirection dir, hcfftIpLayout iLayout,
+    hcfftOpLayout oLayout, double* hostInput, double* hostOutput);
@@ -288,6 +288,23 @@ hipfftResult hipfftExecZ2D(hipfftHandle plan, hipfftDoubleComplex *idata,
   return hipCUFFTResultToHIPFFTResult(cufftExecZ2D(plan, idata, odata));
 }
 
+// cuFFT runs fp16 transforms through the cufftXt interface only, which basic
+// plans cannot use
+hipfftResult hipfftExecC2CHalf(hipfftHandle plan, hipfftHalfComplex *idata,
+                               hipfftHalfComplex *odata, int direction) {
+  return HIPFFT_RESULT_NOT_SUPPORTED;
+}
+
+hipfftResult hipfftExecR2CHalf(hipfftHandle plan, hipfftHalf *idata,
+                               hipfftHalfComplex *odata) {
+  return HIPFFT_RESULT_NOT_SUPPORTED;
+}
+
+hipfftResult hipfftExecC2RHalf(hipfftHandle plan, hipfftHalfComplex *idata,
+                               hipfftHalf *odata) {
+  return HIPFFT_RESULT_NOT_SUPPORTED;
+}
+
 #ifdef __cplusplus
 }
 #endif
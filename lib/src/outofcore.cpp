@@ -0,0 +1,1048 @@
+/*
+Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "include/stockham.h"
+#include <dlfcn.h>
+#include <map>
+#include <thread>
+
+// Out-of-core execution
+//
+//   Transforms whose data lives in host memory and does not fit on the
+//   accelerator are computed in passes over the host buffers. Every pass
+//   streams device sized chunks through a few device slots and runs an
+//   in-core plan on each chunk:
+//
+//   - Slab pass: whole transforms over the leading axes whose volume fits a
+//     chunk, batched over the remaining axes. The chunk is contiguous in
+//     host memory.
+//   - Pencil pass: one further axis of length L with stride S. A chunk holds
+//     L rows of w neighbouring pencils; every row is a contiguous run of w
+//     elements on the host, so the pencils are gathered with L copies and
+//     transformed with a strided in-core plan.
+//   - An axis 0 too long for a chunk is split as N = N1 * N2 (four-step).
+//     The first pencil pass (length N1, stride N2) writes its pencils
+//     contiguously and multiplies them by the twiddle factors on the device;
+//     the second pencil pass (length N2, stride N1) then leaves the
+//     spectrum in natural order.
+//
+//   Chunks cycle through three slots: while one is being transformed, the
+//   next one is uploaded and the previous one downloaded on accelerator views
+//   of their own, so both copy directions overlap the compute. Chunks are
+//   packed into pinned staging buffers owned by the plan, and the packing
+//   runs on helper threads alongside the transform.
+//
+//   Host execution (hcfftExecHost*) streams the batch of any plan the same
+//   way, a few whole transforms per chunk.
+
+namespace OutOfCore {
+//  Device slots a pass cycles through
+static const size_t kSlots = 3;
+
+//  Chunks of device memory held back for the intermediate buffers of the
+//  in-core plans
+static const size_t kReservedChunks = 1;
+
+//  Fewest chunks a batch is split into by host execution, so that copies in
+//  both directions overlap the transforms
+static const size_t kMinChunks = 4;
+
+//  Twiddle multiplication of the four-step: element (j, k) of 'rows' rows of
+//  rowLength values is multiplied by W_N^((firstRow + j) * k)
+template <StockhamGenerator::Precision PR>
+class TwiddleKernel {
+  size_t length;     // N
+  size_t rowLength;  // N1
+  bool forward;
+
+ public:
+  TwiddleKernel(size_t lengthVal, size_t rowLengthVal, bool forwardVal)
+      : length(lengthVal), rowLength(rowLengthVal), forward(forwardVal) {}
+
+  void GenerateKernel(std::string& str) {
+    std::string r2Type = StockhamGenerator::RegBaseType<PR>(2);
+    std::string rType = StockhamGenerator::RegBaseType<PR>(1);
+    std::string rowLen = SztToStr(rowLength);
+    // Kernel begin
+    str += "extern \"C\"\n { void stream_twiddle";
+    str +=
+        "(std::map<int, void*> vectArr, uint batchSize, accelerator_view "
+        "&acc_view, accelerator &acc)";
+    str += "{\n\t";
+    str += r2Type;
+    str += " *gb = static_cast<";
+    str += r2Type;
+    str += "*> (vectArr[0]);\n\t";
+    // First row and row count of the chunk are passed by value
+    str += "unsigned long *rows = ";
+    str += "static_cast<unsigned long*> (vectArr[1]);\n\t";
+    str += "unsigned long firstRow = rows[0];\n\t";
+    str += "unsigned long count = rows[1] * ";
+    str += rowLen;
+    str += ";\n";
+    str += "\thc::extent<2> grdExt( ((count + 63) / 64) * 64, 1 ); \n";
+    str += "\thc::tiled_extent<2> t_ext = grdExt.tile( 64, 1);\n";
+    str +=
+        "\thc::parallel_for_each(acc_view, t_ext, [=] (hc::tiled_index<2> "
+        "tidx) [[hc]]\n\t {\n\t";
+    str += "unsigned long i = tidx.global[0];\n\t";
+    str += "if (i < count)\n\t{\n\t";
+    // The exponent is reduced exactly before the angle is formed in double
+    str += "unsigned long t = ((firstRow + i / ";
+    str += rowLen;
+    str += ") * (i % ";
+    str += rowLen;
+    str += ")) % ";
+    str += SztToStr(length);
+    str += ";\n\t";
+    str += "double ang = ";
+    str += forward ? "-" : "";
+    str += "6.283185307179586476925286766559 * (double)t / ";
+    str += SztToStr(length);
+    str += ".0;\n\t";
+    str += r2Type + " w = " + r2Type + "((" + rType +
+           ")hc::precise_math::cos(ang), (" + rType +
+           ")hc::precise_math::sin(ang));\n\t";
+    str += r2Type + " v = gb[i];\n\t";
+    str += "gb[i] = " + r2Type +
+           "(v.x * w.x - v.y * w.y, v.x * w.y + v.y * w.x);\n\t";
+    str += "}\n";
+    str += " }).wait();\n}}\n\n";
+  }
+};
+
+typedef void(FUNC_StreamTwiddle)(std::map<int, void*>* vectArr,
+                                 uint batchSize,
+                                 hc::accelerator_view& acc_view,
+                                 hc::accelerator& acc);
+//  Kernels already loaded in this process, keyed by shared object name
+static std::map<std::string, FUNC_StreamTwiddle*> twiddleKernels;
+static lockRAII twiddleLock(_T("streamTwiddle"));
+
+static hcfftStatus GetTwiddleKernel(hcfftPrecision precision, size_t length,
+                                    size_t rowLength, bool forward,
+                                    FUNC_StreamTwiddle** kernel) {
+  std::string kernellib = getKernelCacheDir();
+  kernellib += "/libstreamtw";
+  kernellib += (precision == HCFFT_DOUBLE) ? "D_" : "F_";
+  kernellib += SztToStr(length) + "_" + SztToStr(rowLength) + "_";
+  kernellib += forward ? "fwd" : "back";
+  kernellib += "_.so";
+  scopedLock kLock(twiddleLock, _T(" stream twiddle kernels"));
+  std::map<std::string, FUNC_StreamTwiddle*>::iterator it =
+      twiddleKernels.find(kernellib);
+
+  if (it != twiddleKernels.end()) {
+    *kernel = it->second;
+    return HCFFT_SUCCEEDS;
+  }
+
+  if (access(kernellib.c_str(), F_OK) == -1) {
+    std::string programCode = hcHeader();
+
+    if (precision == HCFFT_DOUBLE) {
+      TwiddleKernel<StockhamGenerator::P_DOUBLE> twKernel(length, rowLength,
+                                                          forward);
+      twKernel.GenerateKernel(programCode);
+    } else {
+      TwiddleKernel<StockhamGenerator::P_SINGLE> twKernel(length, rowLength,
+                                                          forward);
+      twKernel.GenerateKernel(programCode);
+    }
+
+    std::string pwd = getKernelCacheDir();
+    pwd += "/";
+    struct stat st = {0};
+
+    if (stat(pwd.c_str(), &st) == -1) {
+      mkdir(pwd.c_str(), 0777);
+    }
+
+    std::string filename = kernellib.substr(0, kernellib.size() - 3);
+    filename.replace(filename.rfind("libstreamtw"), 11, "streamtw");
+    filename += ".cpp";
+    FILE* fp = fopen(filename.c_str(), "w");
+
+    if (!fp) {
+      std::cout << " File " << filename << " open failed for writing "
+                << std::endl;
+      return HCFFT_ERROR;
+    }
+
+    fwrite(programCode.c_str(), programCode.size(), 1, fp);
+    fclose(fp);
+    hcfftStatus status = CompileSharedObject(filename, kernellib);
+    remove(filename.c_str());
+
+    if (status != HCFFT_SUCCEEDS) {
+      return HCFFT_ERROR;
+    }
+  }
+
+  void* handle = dlopen(kernellib.c_str(), RTLD_NOW);
+
+  if (!handle) {
+    std::cout << "Failed to load Kernel: " << kernellib << std::endl;
+    return HCFFT_ERROR;
+  }
+
+  *kernel = (FUNC_StreamTwiddle*)dlsym(handle, "stream_twiddle");
+
+  if (!*kernel) {
+    std::cout << "failed to locate stream_twiddle(): " << dlerror();
+    return HCFFT_ERROR;
+  }
+
+  twiddleKernels[kernellib] = *kernel;
+  return HCFFT_SUCCEEDS;
+}
+
+//  One pass over host data. Chunks are packed into a pinned staging buffer in
+//  the layout the device works on, so every chunk moves with a single copy
+//  in each direction.
+template <typename T>
+class StreamPass {
+ public:
+  virtual ~StreamPass() {}
+
+  virtual size_t Chunks() const = 0;
+
+  //  Pack the host data of a chunk into staging, returns its size in bytes
+  virtual size_t Gather(size_t chunk, T* staging) = 0;
+
+  //  Transform a chunk; the result is left in dev or in devOut
+  virtual hcfftStatus Compute(size_t chunk, T* dev, T* devOut, T** result,
+                              size_t* resultBytes) = 0;
+
+  //  Unpack a transformed chunk from staging to the host
+  virtual void Scatter(size_t chunk, const T* staging) = 0;
+};
+
+//  Device slots and copy queues of one streamed execution
+template <typename T>
+class StreamDevice {
+  void* deviceMem;
+  size_t deviceBytes;
+
+ public:
+  T* slots[kSlots];
+  T* slotsOut[kSlots];
+  hc::accelerator_view upView;
+  hc::accelerator_view downView;
+
+  StreamDevice(FFTPlan* fftPlan, size_t slotBytes, bool outOfPlace)
+      : upView(fftPlan->acc.create_view()),
+        downView(fftPlan->acc.create_view()) {
+    size_t slotElems = DivRoundingUp<size_t>(slotBytes, sizeof(T));
+    size_t buffers = outOfPlace ? 2 * kSlots : kSlots;
+    deviceBytes = buffers * slotElems * sizeof(T);
+    deviceMem = hc::am_alloc(deviceBytes, fftPlan->acc, KernelAllocFlags());
+
+    if (deviceMem) {
+      FFTMetrics::Add(METRIC_SCRATCH_BYTES, deviceBytes);
+    }
+
+    for (size_t s = 0; s < kSlots; s++) {
+      slots[s] = static_cast<T*>(deviceMem) + s * slotElems;
+      slotsOut[s] = outOfPlace ? slots[s] + kSlots * slotElems : slots[s];
+    }
+  }
+
+  ~StreamDevice() {
+    if (deviceMem) {
+      hc::am_free(deviceMem);
+      FFTMetrics::Add(METRIC_SCRATCH_BYTES, -static_cast<int64_t>(deviceBytes));
+    }
+  }
+
+  bool Valid() const { return deviceMem != NULL; }
+};
+
+//  Pinned staging buffers of the plan, one per copy direction
+template <typename T>
+static hcfftStatus GetStaging(FFTPlan* fftPlan, size_t bytes, T** stageIn,
+                              T** stageOut) {
+  size_t stageElems = DivRoundingUp<size_t>(bytes, sizeof(T));
+
+  if (fftPlan->stagingBufSize < 2 * stageElems * sizeof(T)) {
+    if (fftPlan->stagingBuffer) {
+      hc::am_free(fftPlan->stagingBuffer);
+      fftPlan->stagingBufSize = 0;
+    }
+
+    fftPlan->stagingBuffer =
+        hc::am_alloc(2 * stageElems * sizeof(T), fftPlan->acc, amHostPinned);
+
+    if (fftPlan->stagingBuffer == NULL) {
+      return HCFFT_ERROR;
+    }
+
+    fftPlan->stagingBufSize = 2 * stageElems * sizeof(T);
+  }
+
+  *stageIn = static_cast<T*>(fftPlan->stagingBuffer);
+  *stageOut = *stageIn + stageElems;
+  return HCFFT_SUCCEEDS;
+}
+
+template <typename T>
+static void Upload(StreamPass<T>* pass, size_t chunk, T* staging, T* dev,
+                   hc::accelerator_view* view) {
+  size_t bytes = pass->Gather(chunk, staging);
+  view->copy_async(staging, dev, bytes).wait();
+}
+
+template <typename T>
+static void Download(StreamPass<T>* pass, size_t chunk, T* dev, size_t bytes,
+                     T* staging, hc::accelerator_view* view) {
+  view->copy_async(dev, staging, bytes).wait();
+  pass->Scatter(chunk, staging);
+}
+
+//  Stream every chunk of a pass through the device slots. While chunk i is
+//  transformed, chunk i + 1 is staged and uploaded and chunk i - 1 is
+//  downloaded and unpacked by two helper threads; the three chunks occupy
+//  different slots and different host regions.
+template <typename T>
+static hcfftStatus RunPass(StreamPass<T>* pass, StreamDevice<T>* device,
+                           T* stageIn, T* stageOut) {
+  size_t chunks = pass->Chunks();
+  T* results[kSlots];
+  size_t resultBytes[kSlots];
+  hcfftStatus status = HCFFT_SUCCEEDS;
+
+  if (chunks == 0) {
+    return status;
+  }
+
+  Upload<T>(pass, 0, stageIn, device->slots[0], &device->upView);
+
+  for (size_t i = 0; i < chunks; i++) {
+    size_t slot = i % kSlots;
+    std::thread uploader, downloader;
+
+    if (i + 1 < chunks) {
+      uploader = std::thread(Upload<T>, pass, i + 1, stageIn,
+                             device->slots[(i + 1) % kSlots],
+                             &device->upView);
+    }
+
+    if (i > 0) {
+      size_t prev = (i - 1) % kSlots;
+      downloader = std::thread(Download<T>, pass, i - 1, results[prev],
+                               resultBytes[prev], stageOut,
+                               &device->downView);
+    }
+
+    status = pass->Compute(i, device->slots[slot], device->slotsOut[slot],
+                           &results[slot], &resultBytes[slot]);
+
+    if (uploader.joinable()) {
+      uploader.join();
+    }
+
+    if (downloader.joinable()) {
+      downloader.join();
+    }
+
+    if (status != HCFFT_SUCCEEDS) {
+      return status;
+    }
+  }
+
+  size_t last = (chunks - 1) % kSlots;
+  Download<T>(pass, chunks - 1, results[last], resultBytes[last], stageOut,
+              &device->downView);
+  return status;
+}
+
+//  Geometry of an in-core plan run on a chunk
+struct ChunkPlan {
+  std::vector<size_t> length;
+  size_t batch;
+  size_t inStride, iDist;    // stride of the first axis, distance
+  size_t outStride, oDist;
+  bool outOfPlace;
+  bool scaled;  // carries the scale of the user plan
+};
+
+template <typename T>
+class SlabPass : public StreamPass<T> {
+  FFTPlan* plan;
+  hcfftDirection dir;
+  const T* src;
+  T* dst;
+  size_t volume;  // elements of one transform
+  size_t blocks;  // transforms to stream
+  size_t perChunk;
+  ChunkPlan geometry;
+
+ public:
+  SlabPass(FFTPlan* planVal, hcfftDirection dirVal, const T* srcVal,
+           T* dstVal, const std::vector<size_t>& lengths, size_t blocksVal,
+           size_t chunkElems, bool scaled)
+      : plan(planVal), dir(dirVal), src(srcVal), dst(dstVal),
+        blocks(blocksVal) {
+    volume = 1;
+
+    for (size_t i = 0; i < lengths.size(); i++) {
+      volume *= lengths[i];
+    }
+
+    perChunk = std::min(blocks, chunkElems / volume);
+    geometry.length = lengths;
+    geometry.inStride = geometry.outStride = 1;
+    geometry.iDist = geometry.oDist = volume;
+    geometry.outOfPlace = false;
+    geometry.scaled = scaled;
+  }
+
+  size_t Chunks() const { return DivRoundingUp<size_t>(blocks, perChunk); }
+
+  size_t Count(size_t chunk) const {
+    return std::min(perChunk, blocks - chunk * perChunk);
+  }
+
+  size_t Gather(size_t chunk, T* staging) {
+    size_t bytes = Count(chunk) * volume * 2 * sizeof(T);
+    memcpy(staging, src + 2 * chunk * perChunk * volume, bytes);
+    return bytes;
+  }
+
+  hcfftStatus Compute(size_t chunk, T* dev, T* devOut, T** result,
+                      size_t* resultBytes);
+
+  void Scatter(size_t chunk, const T* staging) {
+    memcpy(dst + 2 * chunk * perChunk * volume, staging,
+           Count(chunk) * volume * 2 * sizeof(T));
+  }
+};
+
+template <typename T>
+class PencilPass : public StreamPass<T> {
+  FFTPlan* plan;
+  hcfftDirection dir;
+  const T* src;
+  T* dst;
+  size_t length;  // L
+  size_t stride;  // S
+  size_t outer;   // independent L x S blocks
+  size_t width;   // pencils per chunk
+  size_t twiddleLength;  // N of the four-step twiddles, 0 for none
+  bool scaled;
+
+ public:
+  PencilPass(FFTPlan* planVal, hcfftDirection dirVal, const T* srcVal,
+             T* dstVal, size_t lengthVal, size_t strideVal, size_t outerVal,
+             size_t chunkElems, size_t twiddleLengthVal, bool scaledVal)
+      : plan(planVal), dir(dirVal), src(srcVal), dst(dstVal),
+        length(lengthVal), stride(strideVal), outer(outerVal),
+        twiddleLength(twiddleLengthVal), scaled(scaledVal) {
+    width = std::min(stride, chunkElems / length);
+  }
+
+  size_t ChunksPerBlock() const {
+    return DivRoundingUp<size_t>(stride, width);
+  }
+
+  size_t Chunks() const { return outer * ChunksPerBlock(); }
+
+  //  Block, first pencil and pencil count of a chunk
+  void Locate(size_t chunk, size_t* block, size_t* first,
+              size_t* count) const {
+    *block = chunk / ChunksPerBlock();
+    *first = (chunk % ChunksPerBlock()) * width;
+    *count = std::min(width, stride - *first);
+  }
+
+  size_t Gather(size_t chunk, T* staging) {
+    size_t block, first, count;
+    Locate(chunk, &block, &first, &count);
+    const T* base = src + 2 * (block * stride * length + first);
+
+    for (size_t l = 0; l < length; l++) {
+      memcpy(staging + 2 * l * count, base + 2 * l * stride,
+             count * 2 * sizeof(T));
+    }
+
+    return count * length * 2 * sizeof(T);
+  }
+
+  hcfftStatus Compute(size_t chunk, T* dev, T* devOut, T** result,
+                      size_t* resultBytes);
+
+  void Scatter(size_t chunk, const T* staging) {
+    size_t block, first, count;
+    Locate(chunk, &block, &first, &count);
+
+    if (twiddleLength) {
+      // Pencils were written one after the other
+      memcpy(dst + 2 * (block * stride * length + first * length), staging,
+             count * length * 2 * sizeof(T));
+      return;
+    }
+
+    T* base = dst + 2 * (block * stride * length + first);
+
+    for (size_t l = 0; l < length; l++) {
+      memcpy(base + 2 * l * stride, staging + 2 * l * count,
+             count * 2 * sizeof(T));
+    }
+  }
+};
+
+//  Whole transforms of the user plan, 'count' at a time
+template <typename T>
+class BatchPass : public StreamPass<T> {
+  FFTPlan* plan;
+  hcfftDirection dir;
+  const T* src;
+  T* dst;
+  size_t inBytes, outBytes;  // host footprint of one transform
+  size_t batch;
+  size_t perChunk;
+  hcfftResLocation placeness;
+
+ public:
+  BatchPass(FFTPlan* planVal, hcfftDirection dirVal, const T* srcVal,
+            T* dstVal, size_t inBytesVal, size_t outBytesVal,
+            size_t perChunkVal)
+      : plan(planVal), dir(dirVal), src(srcVal), dst(dstVal),
+        inBytes(inBytesVal), outBytes(outBytesVal), perChunk(perChunkVal) {
+    batch = plan->batchSize;
+    placeness = (src == dst) ? HCFFT_INPLACE : HCFFT_OUTOFPLACE;
+  }
+
+  size_t Chunks() const { return DivRoundingUp<size_t>(batch, perChunk); }
+
+  size_t Count(size_t chunk) const {
+    return std::min(perChunk, batch - chunk * perChunk);
+  }
+
+  size_t Gather(size_t chunk, T* staging) {
+    size_t bytes = Count(chunk) * inBytes;
+    memcpy(staging, (const char*)src + chunk * perChunk * inBytes, bytes);
+    return bytes;
+  }
+
+  hcfftStatus Compute(size_t chunk, T* dev, T* devOut, T** result,
+                      size_t* resultBytes);
+
+  void Scatter(size_t chunk, const T* staging) {
+    memcpy((char*)dst + chunk * perChunk * outBytes, staging,
+           Count(chunk) * outBytes);
+  }
+};
+
+//  Bake (once) the in-core plan of a chunk geometry
+static hcfftStatus GetChunkPlan(FFTPlan* fftPlan, const ChunkPlan& geometry,
+                                hcfftPlanHandle* execHandle) {
+  std::vector<size_t> key(1, STREAM_CHUNK_PLAN);
+  key.insert(key.end(), geometry.length.begin(), geometry.length.end());
+  key.push_back(geometry.batch);
+  key.push_back(geometry.inStride);
+  key.push_back(geometry.iDist);
+  key.push_back(geometry.outStride);
+  key.push_back(geometry.oDist);
+  key.push_back(geometry.outOfPlace ? 1 : 0);
+  key.push_back(geometry.scaled ? 1 : 0);
+  FFTRepo& fftRepo = FFTRepo::getInstance();
+  std::map<std::vector<size_t>, hcfftPlanHandle>::iterator it =
+      fftPlan->streamPlans.find(key);
+  hcfftPlanHandle chunkHandle;
+
+  if (it != fftPlan->streamPlans.end()) {
+    chunkHandle = it->second;
+  } else {
+    hcfftStatus status = fftPlan->hcfftCreateDefaultPlan(
+        &chunkHandle, geometry.length.size(), &geometry.length[0],
+        HCFFT_BOTH, fftPlan->precision, HCFFT_C2CZ2Z);
+
+    if (status != HCFFT_SUCCEEDS) {
+      return status;
+    }
+
+    FFTPlan* chunkPlan = NULL;
+    lockRAII* chunkLock = NULL;
+    fftRepo.getPlan(chunkHandle, chunkPlan, chunkLock);
+    chunkPlan->precision = fftPlan->precision;
+    chunkPlan->location =
+        geometry.outOfPlace ? HCFFT_OUTOFPLACE : HCFFT_INPLACE;
+    chunkPlan->batchSize = geometry.batch;
+    // The leading axes of a slab stay packed, a pencil plan is 1D
+    chunkPlan->inStride[0] = geometry.inStride;
+    chunkPlan->outStride[0] = geometry.outStride;
+    chunkPlan->iDist = geometry.iDist;
+    chunkPlan->oDist = geometry.oDist;
+    chunkPlan->forwardScale = geometry.scaled ? fftPlan->forwardScale : 1.0;
+    chunkPlan->backwardScale = geometry.scaled ? fftPlan->backwardScale : 1.0;
+    chunkPlan->columnMethod = fftPlan->columnMethod;
+    chunkPlan->acc = fftPlan->acc;
+    chunkPlan->acc_view = fftPlan->acc_view;
+    fftPlan->streamPlans[key] = chunkHandle;
+  }
+
+  return fftPlan->hcfftGetExecPlan(
+      chunkHandle, geometry.outOfPlace ? HCFFT_OUTOFPLACE : HCFFT_INPLACE,
+      HCFFT_COMPLEX_INTERLEAVED, HCFFT_COMPLEX_INTERLEAVED, execHandle);
+}
+
+//  Bake (once) a copy of the user plan for a smaller batch
+static hcfftStatus GetBatchPlan(FFTPlan* fftPlan, size_t batch,
+                                hcfftResLocation placeness,
+                                hcfftPlanHandle* execHandle) {
+  std::vector<size_t> key(1, STREAM_BATCH_PLAN);
+  key.push_back(batch);
+  key.push_back(placeness);
+  FFTRepo& fftRepo = FFTRepo::getInstance();
+  std::map<std::vector<size_t>, hcfftPlanHandle>::iterator it =
+      fftPlan->streamPlans.find(key);
+  hcfftPlanHandle batchHandle;
+
+  if (it != fftPlan->streamPlans.end()) {
+    batchHandle = it->second;
+  } else {
+    hcfftStatus status = fftPlan->hcfftCreateDefaultPlan(
+        &batchHandle, fftPlan->Rank(), &fftPlan->length[0],
+        fftPlan->direction, fftPlan->precision, fftPlan->hcfftlibtype);
+
+    if (status != HCFFT_SUCCEEDS) {
+      return status;
+    }
+
+    FFTPlan* batchPlan = NULL;
+    lockRAII* batchLock = NULL;
+    fftRepo.getPlan(batchHandle, batchPlan, batchLock);
+    batchPlan->precision = fftPlan->precision;
+    batchPlan->location = placeness;
+    batchPlan->ipLayout = fftPlan->ipLayout;
+    batchPlan->opLayout = fftPlan->opLayout;
+    batchPlan->transposeType = fftPlan->transposeType;
+    batchPlan->columnMethod = fftPlan->columnMethod;
+    batchPlan->batchSize = batch;
+    batchPlan->inStride = fftPlan->inStride;
+    batchPlan->outStride = fftPlan->outStride;
+    batchPlan->iDist = fftPlan->iDist;
+    batchPlan->oDist = fftPlan->oDist;
+    batchPlan->forwardScale = fftPlan->forwardScale;
+    batchPlan->backwardScale = fftPlan->backwardScale;
+    batchPlan->gen = fftPlan->gen;
+    batchPlan->envelope = fftPlan->envelope;
+    batchPlan->originalLength = fftPlan->originalLength;
+    batchPlan->loadCallback = fftPlan->loadCallback;
+    batchPlan->storeCallback = fftPlan->storeCallback;
+    batchPlan->loadCallbackInfo = fftPlan->loadCallbackInfo;
+    batchPlan->storeCallbackInfo = fftPlan->storeCallbackInfo;
+    batchPlan->acc = fftPlan->acc;
+    batchPlan->acc_view = fftPlan->acc_view;
+    fftPlan->streamPlans[key] = batchHandle;
+  }
+
+  return fftPlan->hcfftGetExecPlan(batchHandle, placeness, fftPlan->ipLayout,
+                                   fftPlan->opLayout, execHandle);
+}
+
+template <typename T>
+hcfftStatus SlabPass<T>::Compute(size_t chunk, T* dev, T* devOut, T** result,
+                                 size_t* resultBytes) {
+  geometry.batch = Count(chunk);
+  hcfftPlanHandle execHandle;
+  hcfftStatus status = GetChunkPlan(plan, geometry, &execHandle);
+
+  if (status != HCFFT_SUCCEEDS) {
+    return status;
+  }
+
+  *result = dev;
+  *resultBytes = geometry.batch * volume * 2 * sizeof(T);
+  return plan->hcfftEnqueueTransform<T>(execHandle, dir, dev, dev, NULL);
+}
+
+template <typename T>
+hcfftStatus PencilPass<T>::Compute(size_t chunk, T* dev, T* devOut,
+                                   T** result, size_t* resultBytes) {
+  size_t block, first, count;
+  Locate(chunk, &block, &first, &count);
+  ChunkPlan geometry;
+  geometry.length.push_back(length);
+  geometry.batch = count;
+  geometry.inStride = count;
+  geometry.iDist = 1;
+  geometry.scaled = scaled;
+
+  if (twiddleLength) {
+    // Write the pencils one after the other
+    geometry.outStride = 1;
+    geometry.oDist = length;
+    geometry.outOfPlace = true;
+  } else {
+    geometry.outStride = count;
+    geometry.oDist = 1;
+    geometry.outOfPlace = false;
+  }
+
+  hcfftPlanHandle execHandle;
+  hcfftStatus status = GetChunkPlan(plan, geometry, &execHandle);
+
+  if (status != HCFFT_SUCCEEDS) {
+    return status;
+  }
+
+  *result = geometry.outOfPlace ? devOut : dev;
+  *resultBytes = count * length * 2 * sizeof(T);
+  status = plan->hcfftEnqueueTransform<T>(execHandle, dir, dev, *result, NULL);
+
+  if (status != HCFFT_SUCCEEDS || twiddleLength == 0) {
+    return status;
+  }
+
+  FUNC_StreamTwiddle* twiddle = NULL;
+  status = GetTwiddleKernel(plan->precision, twiddleLength, length,
+                            dir == HCFFT_FORWARD, &twiddle);
+
+  if (status != HCFFT_SUCCEEDS) {
+    return status;
+  }
+
+  unsigned long rows[2] = {first, count};
+  std::map<int, void*> vectArr;
+  vectArr.insert(std::make_pair(0, *result));
+  vectArr.insert(std::make_pair(1, rows));
+  twiddle(&vectArr, 1, plan->acc_view, plan->acc);
+  return HCFFT_SUCCEEDS;
+}
+
+template <typename T>
+hcfftStatus BatchPass<T>::Compute(size_t chunk, T* dev, T* devOut, T** result,
+                                  size_t* resultBytes) {
+  hcfftPlanHandle execHandle;
+  hcfftStatus status =
+      GetBatchPlan(plan, Count(chunk), placeness, &execHandle);
+
+  if (status != HCFFT_SUCCEEDS) {
+    return status;
+  }
+
+  *result = (placeness == HCFFT_INPLACE) ? dev : devOut;
+  *resultBytes = Count(chunk) * outBytes;
+  return plan->hcfftEnqueueTransform<T>(execHandle, dir, dev, *result, NULL);
+}
+
+//  Split N = N1 * N2 with both factors as close to sqrt(N) as possible
+static bool FourStepFactors(size_t length, size_t chunkElems, size_t* n1,
+                            size_t* n2) {
+  size_t best = 0;
+
+  for (size_t f = 2; f * f <= length; f++) {
+    if ((length % f == 0) && ((length / f) <= chunkElems)) {
+      best = f;
+    }
+  }
+
+  if (best == 0) {
+    return false;
+  }
+
+  *n1 = best;
+  *n2 = length / best;
+  return true;
+}
+
+static void DropStreamPlans(FFTPlan* fftPlan) {
+  for (std::map<std::vector<size_t>, hcfftPlanHandle>::iterator it =
+           fftPlan->streamPlans.begin();
+       it != fftPlan->streamPlans.end(); ++it) {
+    fftPlan->hcfftDestroyPlan(&it->second);
+  }
+
+  fftPlan->streamPlans.clear();
+}
+
+//  Device memory streamed execution of the plan may use
+static size_t StreamBudget(const FFTPlan* fftPlan) {
+  if (fftPlan->streamMemory) {
+    return fftPlan->streamMemory;
+  }
+
+  // get_dedicated_memory() reports KB
+  return fftPlan->acc.get_dedicated_memory() * 512;
+}
+};  // namespace OutOfCore
+
+template <typename T>
+hcfftStatus FFTPlan::hcfftEnqueueOutOfCore(hcfftPlanHandle plHandle,
+                                           hcfftDirection dir, T* hostInput,
+                                           T* hostOutput) {
+  FFTRepo& fftRepo = FFTRepo::getInstance();
+  FFTPlan* fftPlan = NULL;
+  lockRAII* planLock = NULL;
+
+  if (fftRepo.getPlan(plHandle, fftPlan, planLock) != HCFFT_SUCCEEDS) {
+    return HCFFT_INVALID;
+  }
+
+  scopedLock sLock(*planLock, _T(" hcfftEnqueueOutOfCore"));
+  ARG_CHECK(hostInput != NULL && hostOutput != NULL)
+
+  if ((sizeof(T) == sizeof(double)) != (fftPlan->precision == HCFFT_DOUBLE) ||
+      fftPlan->precision == HCFFT_HALF ||
+      fftPlan->hcfftlibtype != HCFFT_C2CZ2Z) {
+    return HCFFT_INVALID;
+  }
+
+  // Chunks are cut from packed data
+  size_t volume = 1;
+
+  for (size_t i = 0; i < fftPlan->length.size(); i++) {
+    if (fftPlan->inStride[i] != volume || fftPlan->outStride[i] != volume) {
+      return HCFFT_INVALID;
+    }
+
+    volume *= fftPlan->length[i];
+  }
+
+  if (fftPlan->iDist != volume || fftPlan->oDist != volume) {
+    return HCFFT_INVALID;
+  }
+
+  const size_t elemBytes = 2 * sizeof(T);
+  size_t budget = OutOfCore::StreamBudget(fftPlan);
+  const std::vector<size_t>& lengths = fftPlan->length;
+  size_t rank = lengths.size();
+  size_t chunkElems =
+      budget / elemBytes / (OutOfCore::kSlots + OutOfCore::kReservedChunks);
+  bool fourStep = lengths[0] > chunkElems;
+  size_t n1 = 0, n2 = 0;
+
+  if (fourStep) {
+    // The first four-step pass is out-of-place on the device
+    chunkElems = budget / elemBytes /
+                 (2 * OutOfCore::kSlots + OutOfCore::kReservedChunks);
+
+    if (hostInput == hostOutput ||
+        !OutOfCore::FourStepFactors(lengths[0], chunkElems, &n1, &n2)) {
+      return HCFFT_INVALID;
+    }
+  }
+
+  // Leading axes computed by the slab pass
+  size_t slabAxes = 0, slabVolume = 1;
+
+  while (!fourStep && slabAxes < rank && slabAxes < 3 &&
+         slabVolume * lengths[slabAxes] <= chunkElems) {
+    slabVolume *= lengths[slabAxes];
+    slabAxes++;
+  }
+
+  // Every remaining axis is a pencil pass
+  for (size_t i = (fourStep ? 1 : slabAxes); i < rank; i++) {
+    if (lengths[i] > chunkElems) {
+      return HCFFT_INVALID;
+    }
+  }
+
+  size_t slotBytes =
+      std::min(chunkElems, volume * fftPlan->batchSize) * elemBytes;
+  T* stageIn = NULL;
+  T* stageOut = NULL;
+
+  if (OutOfCore::GetStaging<T>(fftPlan, slotBytes, &stageIn, &stageOut) !=
+      HCFFT_SUCCEEDS) {
+    return HCFFT_ERROR;
+  }
+
+  OutOfCore::StreamDevice<T> device(fftPlan, slotBytes, fourStep);
+
+  if (!device.Valid()) {
+    return HCFFT_ERROR;
+  }
+
+  hcfftStatus status = HCFFT_SUCCEEDS;
+  const T* src = hostInput;
+  size_t firstAxis;
+
+  if (fourStep) {
+    size_t rows = volume / lengths[0] * fftPlan->batchSize;
+    // Pencils of length N1 and stride N2, twiddled and written contiguously
+    OutOfCore::PencilPass<T> columns(fftPlan, dir, src, hostOutput, n1, n2,
+                                     rows, chunkElems, lengths[0], false);
+    status = OutOfCore::RunPass<T>(&columns, &device, stageIn, stageOut);
+
+    if (status == HCFFT_SUCCEEDS) {
+      // Pencils of length N2 and stride N1, in natural order afterwards
+      OutOfCore::PencilPass<T> rowsPass(fftPlan, dir, hostOutput, hostOutput,
+                                        n2, n1, rows, chunkElems, 0, true);
+      status = OutOfCore::RunPass<T>(&rowsPass, &device, stageIn, stageOut);
+    }
+
+    firstAxis = 1;
+  } else {
+    std::vector<size_t> slabLengths(lengths.begin(),
+                                    lengths.begin() + slabAxes);
+    OutOfCore::SlabPass<T> slabs(fftPlan, dir, src, hostOutput, slabLengths,
+                                 volume / slabVolume * fftPlan->batchSize,
+                                 chunkElems, true);
+    status = OutOfCore::RunPass<T>(&slabs, &device, stageIn, stageOut);
+    firstAxis = slabAxes;
+  }
+
+  src = hostOutput;
+  size_t stride = 1;
+
+  for (size_t i = 0; i < firstAxis; i++) {
+    stride *= lengths[i];
+  }
+
+  for (size_t i = firstAxis; (i < rank) && (status == HCFFT_SUCCEEDS); i++) {
+    size_t outer = volume / (stride * lengths[i]) * fftPlan->batchSize;
+    OutOfCore::PencilPass<T> pencils(fftPlan, dir, src, hostOutput,
+                                     lengths[i], stride, outer, chunkElems, 0,
+                                     false);
+    status = OutOfCore::RunPass<T>(&pencils, &device, stageIn, stageOut);
+    stride *= lengths[i];
+  }
+
+  return status;
+}
+
+template <typename T>
+hcfftStatus FFTPlan::hcfftEnqueueHost(hcfftPlanHandle plHandle,
+                                      hcfftDirection dir,
+                                      hcfftIpLayout iLayout,
+                                      hcfftOpLayout oLayout, T* hostInput,
+                                      T* hostOutput) {
+  FFTRepo& fftRepo = FFTRepo::getInstance();
+  FFTPlan* fftPlan = NULL;
+  lockRAII* planLock = NULL;
+
+  if (fftRepo.getPlan(plHandle, fftPlan, planLock) != HCFFT_SUCCEEDS) {
+    return HCFFT_INVALID;
+  }
+
+  scopedLock sLock(*planLock, _T(" hcfftEnqueueHost"));
+  ARG_CHECK(hostInput != NULL && hostOutput != NULL)
+
+  if ((sizeof(T) == sizeof(double)) != (fftPlan->precision == HCFFT_DOUBLE) ||
+      fftPlan->precision == HCFFT_HALF) {
+    return HCFFT_INVALID;
+  }
+
+  if (fftPlan->RunsOnHost(true)) {
+    // The data already is where the host engine works
+    if (fftPlan->ipLayout != iLayout || fftPlan->opLayout != oLayout) {
+      hcfftStatus status = hcfftSetLayout(plHandle, iLayout, oLayout);
+
+      if (status != HCFFT_SUCCEEDS) {
+        return status;
+      }
+
+      fftPlan->baked = false;
+    }
+
+    return hcfftEnqueueOnHost<T>(plHandle, dir, hostInput, hostOutput, false);
+  }
+
+  if (fftPlan->deviceSet != NULL) {
+    return hcfftEnqueueDevices<T>(plHandle, dir, iLayout, oLayout, hostInput,
+                                  hostOutput);
+  }
+
+  if (!fftPlan->baked) {
+    // Chunk plans copy settings of the plan that changed since they were made
+    OutOfCore::DropStreamPlans(fftPlan);
+  }
+
+  // Bake the user plan for the layouts of the call, the chunks use copies
+  // of it with a smaller batch
+  hcfftPlanHandle execPlan;
+  hcfftResLocation placeness =
+      (hostInput == hostOutput) ? HCFFT_INPLACE : HCFFT_OUTOFPLACE;
+  hcfftStatus status =
+      hcfftGetExecPlan(plHandle, placeness, iLayout, oLayout, &execPlan);
+
+  if (status != HCFFT_SUCCEEDS) {
+    return status;
+  }
+
+  size_t inElem = (iLayout == HCFFT_REAL) ? sizeof(T) : 2 * sizeof(T);
+  size_t outElem = (oLayout == HCFFT_REAL) ? sizeof(T) : 2 * sizeof(T);
+  size_t inBytes = fftPlan->iDist * inElem;
+  size_t outBytes = fftPlan->oDist * outElem;
+
+  // Transforms of one chunk have to leave the host footprint of the others
+  // alone
+  if ((placeness == HCFFT_INPLACE) && (inBytes != outBytes)) {
+    return HCFFT_INVALID;
+  }
+
+  size_t deviceBytes = (placeness == HCFFT_INPLACE) ? inBytes
+                                                    : inBytes + outBytes;
+  size_t fit = OutOfCore::StreamBudget(fftPlan) /
+               (OutOfCore::kSlots + OutOfCore::kReservedChunks) / deviceBytes;
+
+  if (fit == 0) {
+    // Not even one transform fits a slot
+    if (fftPlan->hcfftlibtype == HCFFT_C2CZ2Z) {
+      return hcfftEnqueueOutOfCore<T>(plHandle, dir, hostInput, hostOutput);
+    }
+
+    return HCFFT_INVALID;
+  }
+
+  // Enough chunks to keep both copy directions busy
+  size_t perChunk =
+      std::min(fit, DivRoundingUp<size_t>(fftPlan->batchSize,
+                                          OutOfCore::kMinChunks));
+  size_t slotBytes = std::max(inBytes, outBytes) * perChunk;
+  T* stageIn = NULL;
+  T* stageOut = NULL;
+
+  if (OutOfCore::GetStaging<T>(fftPlan, slotBytes, &stageIn, &stageOut) !=
+      HCFFT_SUCCEEDS) {
+    return HCFFT_ERROR;
+  }
+
+  OutOfCore::StreamDevice<T> device(fftPlan, slotBytes,
+                                    placeness == HCFFT_OUTOFPLACE);
+
+  if (!device.Valid()) {
+    return HCFFT_ERROR;
+  }
+
+  OutOfCore::BatchPass<T> batches(fftPlan, dir, hostInput, hostOutput,
+                                  inBytes, outBytes, perChunk);
+  return OutOfCore::RunPass<T>(&batches, &device, stageIn, stageOut);
+}
+
+// Template Initialization supporting just float and double types
+template hcfftStatus FFTPlan::hcfftEnqueueOutOfCore<float>(
+    hcfftPlanHandle plHandle, hcfftDirection dir, float* hostInput,
+    float* hostOutput);
+template hcfftStatus FFTPlan::hcfftEnqueueOutOfCore<double>(
+    hcfftPlanHandle plHandle, hcfftDirection dir, double* hostInput,
+    double* hostOutput);
+template hcfftStatus FFTPlan::hcfftEnqueueHost<float>(
+    hcfftPlanHandle plHandle, hcfftDirection dir, hcfftIpLayout iLayout,
+    hcfftOpLayout oLayout, float* hostInput, float* hostOutput);
+template hcfftStatus FFTPlan::hcfftEnqueueHost<double>(
+    hcfftPlanHandle plHandle, hcfftDirection dir, hcfftIpLayout iLayout,
+    hcfftOpLayout oLayout, double* hostInput, double* hostOutput);
@@ -0,0 +1,383 @@
+/*
+Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "include/hcfftlib.h"
+#include <stdlib.h>
+#include <string>
+
+#if __has_feature(cxx_thread_local)
+// Innermost bake phase timed and outer bake scope of the thread
+static thread_local FFTBakeTimer* activeTimer = NULL;
+static thread_local FFTBakeTimes* scopeTimes = NULL;
+#else
+static FFTBakeTimer* activeTimer = NULL;
+static FFTBakeTimes* scopeTimes = NULL;
+#endif
+
+// Bake times of the whole process
+static lockRAII processBakeLock(_T("processBakeTimes"));
+static FFTBakeTimes processBakeTimes;
+
+// Allocations of the process so far, see FFTBakeTimer::SetAllocationCounter
+static size_t (*allocationCounter)() = NULL;
+
+static size_t Allocations() {
+  return allocationCounter ? allocationCounter() : 0;
+}
+
+// Kernel profiling
+//
+//   With HCFFT_PROFILE=<path> in the environment, or between
+//   hcfftProfileStart() and hcfftProfileStop(), every kernel a plan launches
+//   is timed. Each record carries the generator, lengths and batch of the
+//   sub-plan, and the bytes and flops hcfftGetPlanCostReport() counts for its
+//   kernel, from which the throughput of the launch follows. The records are
+//   written as Chrome trace events, for chrome://tracing or Perfetto, and as
+//   CSV next to the trace.
+//
+//   Baking is timed phase by phase: cache lookup, source generation, source
+//   write, compilation, twiddle tables, and on the first execution library
+//   load, entry point lookup and scratch allocation. Phases nest, generation
+//   contains the twiddle tables for instance, and each is charged its own
+//   time only. The times add up per plan and for the process.
+
+FFTProfiler::FFTProfiler()
+    : lock(_T("FFTProfiler")), enabled(false),
+      epoch(std::chrono::steady_clock::now()) {
+  const char* value = getenv("HCFFT_PROFILE");
+
+  if (value != NULL && value[0] != '\0') {
+    Start(value);
+  }
+}
+
+FFTProfiler::~FFTProfiler() {
+  if (enabled) {
+    Stop();
+  }
+}
+
+hcfftStatus FFTProfiler::Start(const std::string& tracePath) {
+  scopedLock sLock(lock, _T("FFTProfiler::Start"));
+  path = tracePath;
+  records.clear();
+  threads.clear();
+  epoch = std::chrono::steady_clock::now();
+  enabled = true;
+  return HCFFT_SUCCEEDS;
+}
+
+hcfftStatus FFTProfiler::Stop() {
+  scopedLock sLock(lock, _T("FFTProfiler::Stop"));
+
+  if (!enabled) {
+    return HCFFT_INVALID;
+  }
+
+  enabled = false;
+  std::string csvPath = path;
+  size_t dot = csvPath.rfind(".json");
+
+  if (dot != std::string::npos && dot + 5 == csvPath.size()) {
+    csvPath.erase(dot);
+  }
+
+  csvPath += ".csv";
+  hcfftStatus status = WriteTrace(path);
+
+  if (status == HCFFT_SUCCEEDS) {
+    status = WriteCsv(csvPath);
+  }
+
+  records.clear();
+  kernels.clear();
+  return status;
+}
+
+double FFTProfiler::Now() const {
+  std::chrono::duration<double, std::micro> elapsed =
+      std::chrono::steady_clock::now() - epoch;
+  return elapsed.count();
+}
+
+void FFTProfiler::Record(const FFTPlan* fftPlan, double start,
+                         double duration) {
+  scopedLock sLock(lock, _T("FFTProfiler::Record"));
+
+  if (!enabled) {
+    return;
+  }
+
+  //  Plans keep their handle when they are baked again for other lengths
+  FFTProfileRecord& kernel = kernels[fftPlan->plHandle];
+
+  if (kernel.name.empty() || kernel.length != fftPlan->length ||
+      kernel.batchSize != fftPlan->batchSize) {
+    FFTKernelCost cost;
+    fftPlan->GetKernelCost(&cost);
+    kernel.name = cost.name;
+    kernel.gen = fftPlan->gen;
+    kernel.plan = fftPlan->plHandle;
+    kernel.precision = fftPlan->precision;
+    kernel.length = fftPlan->length;
+    kernel.batchSize = fftPlan->batchSize;
+    kernel.bytes = cost.bytesRead + cost.bytesWritten;
+    kernel.flops = cost.flops;
+  }
+
+  std::map<std::thread::id, size_t>::iterator thread =
+      threads.insert(std::make_pair(std::this_thread::get_id(),
+                                    threads.size()))
+          .first;
+  FFTProfileRecord record = kernel;
+  record.thread = thread->second;
+  record.start = start;
+  record.duration = duration;
+  records.push_back(record);
+}
+
+void FFTProfiler::Record(const FFTPlan* fftPlan, const FFTKernelCost& cost,
+                         double start, double duration) {
+  scopedLock sLock(lock, _T("FFTProfiler::Record"));
+
+  if (!enabled) {
+    return;
+  }
+
+  FFTProfileRecord record;
+  record.name = cost.name;
+  record.gen = cost.gen;
+  record.plan = fftPlan->plHandle;
+  record.precision = fftPlan->precision;
+  record.length = fftPlan->length;
+  record.batchSize = fftPlan->batchSize;
+  record.bytes = cost.bytesRead + cost.bytesWritten;
+  record.flops = cost.flops;
+  record.thread = threads.insert(std::make_pair(std::this_thread::get_id(),
+                                                threads.size()))
+                      .first->second;
+  record.start = start;
+  record.duration = duration;
+  records.push_back(record);
+}
+
+// Lengths as "N0xN1x..."
+static std::string LengthName(const std::vector<size_t>& length) {
+  std::string name;
+
+  for (size_t i = 0; i < length.size(); i++) {
+    name += (i == 0 ? "" : "x") + std::to_string(length[i]);
+  }
+
+  return name;
+}
+
+// Throughput of a record in GB/s and GFLOP/s
+static double GBs(const FFTProfileRecord& record) {
+  return record.duration > 0 ? record.bytes / (record.duration * 1.0e3) : 0;
+}
+
+static double GFlops(const FFTProfileRecord& record) {
+  return record.duration > 0 ? record.flops / (record.duration * 1.0e3) : 0;
+}
+
+hcfftStatus FFTProfiler::WriteTrace(const std::string& tracePath) const {
+  FILE* file = fopen(tracePath.c_str(), "w");
+
+  if (file == NULL) {
+    return HCFFT_ERROR;
+  }
+
+  fprintf(file, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [");
+
+  for (size_t i = 0; i < records.size(); i++) {
+    const FFTProfileRecord& record = records[i];
+    fprintf(file,
+            "%s\n  {\"name\": \"%s\", \"cat\": \"%s\", \"ph\": \"X\", "
+            "\"ts\": %.3f, \"dur\": %.3f, \"pid\": %d, \"tid\": %zu, "
+            "\"args\": {\"plan\": %zu, \"precision\": \"%s\", "
+            "\"length\": \"%s\", \"batch\": %zu, \"bytes\": %.0f, "
+            "\"flops\": %.0f, \"GB/s\": %.3f, \"GFLOP/s\": %.3f}}",
+            (i == 0) ? "" : ",", record.name.c_str(),
+            GeneratorName(record.gen), record.start, record.duration,
+            static_cast<int>(getpid()), record.thread, record.plan,
+            PrecisionName(record.precision),
+            LengthName(record.length).c_str(), record.batchSize,
+            record.bytes, record.flops, GBs(record), GFlops(record));
+  }
+
+  fprintf(file, "\n]}\n");
+  return (fclose(file) == 0) ? HCFFT_SUCCEEDS : HCFFT_ERROR;
+}
+
+hcfftStatus FFTProfiler::WriteCsv(const std::string& csvPath) const {
+  FILE* file = fopen(csvPath.c_str(), "w");
+
+  if (file == NULL) {
+    return HCFFT_ERROR;
+  }
+
+  fprintf(file,
+          "kernel,generator,plan,precision,length,batch,thread,start_us,"
+          "duration_us,bytes,flops,gbs,gflops\n");
+
+  for (size_t i = 0; i < records.size(); i++) {
+    const FFTProfileRecord& record = records[i];
+    fprintf(file, "%s,%s,%zu,%s,%s,%zu,%zu,%.3f,%.3f,%.0f,%.0f,%.3f,%.3f\n",
+            record.name.c_str(), GeneratorName(record.gen), record.plan,
+            PrecisionName(record.precision),
+            LengthName(record.length).c_str(), record.batchSize,
+            record.thread, record.start, record.duration, record.bytes,
+            record.flops, GBs(record), GFlops(record));
+  }
+
+  return (fclose(file) == 0) ? HCFFT_SUCCEEDS : HCFFT_ERROR;
+}
+
+const char* BakePhaseName(FFTBakePhase phase) {
+  const char* names[] = {"cache_lookup", "generate", "write",    "compile",
+                         "dlopen",       "dlsym",    "twiddles", "scratch"};
+  return (phase < BAKE_PHASES) ? names[phase] : "unknown";
+}
+
+void FFTBakeTimes::Add(const FFTBakeTimes& other) {
+  for (int p = 0; p < BAKE_PHASES; p++) {
+    seconds[p] += other.seconds[p];
+    calls[p] += other.calls[p];
+    allocations[p] += other.allocations[p];
+  }
+
+  cacheHits += other.cacheHits;
+  cacheMisses += other.cacheMisses;
+}
+
+double FFTBakeTimes::Total() const {
+  double total = 0;
+
+  for (int p = 0; p < BAKE_PHASES; p++) {
+    total += seconds[p];
+  }
+
+  return total;
+}
+
+FFTBakeTimer::FFTBakeTimer(FFTBakePhase phase)
+    : phase(phase),
+      start(std::chrono::steady_clock::now()),
+      nested(0),
+      startAllocations(Allocations()),
+      nestedAllocations(0),
+      parent(activeTimer) {
+  activeTimer = this;
+}
+
+FFTBakeTimer::~FFTBakeTimer() {
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  size_t allocated = Allocations() - startAllocations;
+  activeTimer = parent;
+
+  if (parent != NULL) {
+    parent->nested += elapsed.count();
+    parent->nestedAllocations += allocated;
+  }
+
+  double seconds = elapsed.count() - nested;
+  allocated -= nestedAllocations;
+
+  if (scopeTimes != NULL) {
+    scopeTimes->seconds[phase] += seconds;
+    scopeTimes->calls[phase]++;
+    scopeTimes->allocations[phase] += allocated;
+  }
+
+  scopedLock sLock(processBakeLock, _T("FFTBakeTimer"));
+  processBakeTimes.seconds[phase] += seconds;
+  processBakeTimes.calls[phase]++;
+  processBakeTimes.allocations[phase] += allocated;
+}
+
+void FFTBakeTimer::CountCache(bool hit) {
+  if (scopeTimes != NULL) {
+    (hit ? scopeTimes->cacheHits : scopeTimes->cacheMisses)++;
+  }
+
+  scopedLock sLock(processBakeLock, _T("FFTBakeTimer::CountCache"));
+  (hit ? processBakeTimes.cacheHits : processBakeTimes.cacheMisses)++;
+}
+
+FFTBakeTimes FFTBakeTimer::Process() {
+  scopedLock sLock(processBakeLock, _T("FFTBakeTimer::Process"));
+  return processBakeTimes;
+}
+
+void FFTBakeTimer::SetAllocationCounter(size_t (*counter)()) {
+  allocationCounter = counter;
+}
+
+FFTBakeScope::FFTBakeScope(hcfftPlanHandle plHandle, FFTBakeTimes* planTimes,
+                           const char* action)
+    : plHandle(plHandle),
+      planTimes(planTimes),
+      action(action),
+      outer(scopeTimes == NULL) {
+  if (outer) {
+    scopeTimes = &collected;
+  }
+}
+
+FFTBakeScope::~FFTBakeScope() {
+  if (!outer) {
+    return;
+  }
+
+  scopeTimes = NULL;
+  planTimes->Add(collected);
+  const char* log = getenv("HCFFT_BAKE_LOG");
+  size_t calls = collected.cacheHits + collected.cacheMisses;
+
+  for (int p = 0; p < BAKE_PHASES; p++) {
+    calls += collected.calls[p];
+  }
+
+  // Executions after the first have nothing left to load
+  if (log == NULL || atoi(log) == 0 || calls == 0) {
+    return;
+  }
+
+  fprintf(stderr, "hcfft: %s plan %zu %.3f ms:", action, plHandle,
+          collected.Total() * 1.0e3);
+
+  for (int p = 0; p < BAKE_PHASES; p++) {
+    if (collected.calls[p] != 0) {
+      fprintf(stderr, " %s %.3f", BakePhaseName(static_cast<FFTBakePhase>(p)),
+              collected.seconds[p] * 1.0e3);
+    }
+  }
+
+  if (collected.cacheHits + collected.cacheMisses != 0) {
+    fprintf(stderr, ", kernel cache %s",
+            collected.cacheMisses != 0 ? "miss" : "hit");
+  }
+
+  fprintf(stderr, "\n");
+}
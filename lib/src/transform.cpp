@@ -22,16 +22,30 @@ THE SOFTWARE.
 
 #include "include/hcfftlib.h"
 #include <dlfcn.h>
+#include <functional>
 
 //  Static initialization of the repo lock variable
 lockRAII FFTRepo::lockRepo(_T( "FFTRepo"));
 
 //  Static initialization of the plan count variable
 size_t FFTRepo::planCount = 1;
+#if __has_feature(cxx_thread_local)
+// Baking and kernel loading state of the plan being processed by the thread
+static thread_local size_t beforeCompile = 99999999;
+static thread_local size_t countKernel, bakedPlanCount;
+static thread_local std::string sfilename, skernellib;
+static thread_local void* kernelHandle = NULL;
+#else
 static size_t beforeCompile = 99999999;
 static size_t countKernel, bakedPlanCount;
 static std::string sfilename, skernellib;
 static void* kernelHandle = NULL;
+#endif
+
+//  Plans sharing kernel sizes share the source and library files of the
+//  kernel cache, so baking and the first execution, which loads the library
+//  and removes the source, run one plan at a time
+static lockRAII kernelCacheLock(_T("kernelCache"));
 
 bool has_suffix(const std::string& s, const std::string& suffix) {
   return (s.size() >= suffix.size()) &&
@@ -40,12 +54,13 @@ bool has_suffix(const std::string& s, const std::string& suffix) {
 
 bool checkIfsoExist(hcfftDirection direction, hcfftPrecision precision,
                     std::vector<size_t> originalLength,
-                    hcfftLibType hcfftlibtype) {
+                    hcfftLibType hcfftlibtype, hcfftResLocation location,
+                    const std::string& tag) {
   DIR* d;
   struct dirent* dir;
-  std::string pwd = getHomeDir();
+  std::string pwd = getKernelCacheDir();
   bool soExist = false;
-  pwd += "/kernCache/";
+  pwd += "/";
   d = opendir(pwd.c_str());
 
   if (d) {
@@ -77,7 +92,8 @@ bool checkIfsoExist(hcfftDirection direction, hcfftPrecision precision,
         }
 
         if (!((datatype == "F" && precision == HCFFT_SINGLE) ||
-              (datatype == "D" && precision == HCFFT_DOUBLE))) {
+              (datatype == "D" && precision == HCFFT_DOUBLE) ||
+              (datatype == "H" && precision == HCFFT_HALF))) {
           continue;
         }
 
@@ -87,12 +103,32 @@ bool checkIfsoExist(hcfftDirection direction, hcfftPrecision precision,
           continue;
         }
 
+        // In-place libraries carry an 'I' after the library type
+        bool inplace = (libFile.size() > 16) && (libFile[16] == 'I');
+
+        if (inplace != (location == HCFFT_INPLACE)) {
+          continue;
+        }
+
         if (firstocc != std::string::npos) {
-          ++firstocc;
+          firstocc += inplace ? 2 : 1;
+
+          // Libraries with user callbacks are never reused
+          if (libFile.compare(firstocc, 2, "cb") == 0) {
+            continue;
+          }
+
           size_t iter = (libFile.substr(firstocc, length - firstocc)).find("_");
 
           while (iter != std::string::npos) {
-            size_t N = (size_t)stoi(libFile.substr(firstocc, iter));
+            std::string field = libFile.substr(firstocc, iter);
+
+            if (field.empty() ||
+                field.find_first_not_of("0123456789") != std::string::npos) {
+              break;
+            }
+
+            size_t N = strtoul(field.c_str(), NULL, 10);
 
             if (N != originalLength[i]) {
               break;
@@ -104,6 +140,12 @@ bool checkIfsoExist(hcfftDirection direction, hcfftPrecision precision,
           }
         }
 
+        // The decomposition tag follows the lengths
+        if ((firstocc == std::string::npos) ||
+            (libFile.substr(firstocc) != tag + ".so")) {
+          continue;
+        }
+
         if (i == originalLength.size()) {
           soExist = true;
           break;
@@ -127,12 +169,18 @@ hcfftStatus WriteKernel(const hcfftPlanHandle plHandle,
                         const hcfftGenerators gen,
                         const FFTKernelGenKeyParams& fftParams,
                         std::string filename, bool writeFlag) {
+  FFTBakeTimer timer(BAKE_WRITE);
   FFTRepo& fftRepo = FFTRepo::getInstance();
   std::string kernel;
   fftRepo.getProgramCode(gen, plHandle, fftParams, kernel);
+
+  if (KernelBuildStubbed()) {
+    return HCFFT_SUCCEEDS;
+  }
+
   FILE* fp;
-  std::string pwd = getHomeDir();
-  pwd += "/kernCache/";
+  std::string pwd = getKernelCacheDir();
+  pwd += "/";
   struct stat st = {0};
 
   if (stat(pwd.c_str(), &st) == -1) {
@@ -167,6 +215,439 @@ hcfftStatus WriteKernel(const hcfftPlanHandle plHandle,
   return HCFFT_SUCCEEDS;
 }
 
+#ifndef HCFFT_HOST_INCLUDE_DIR
+#define HCFFT_HOST_INCLUDE_DIR "/opt/rocm/hcfft/include/hc_host"
+#endif
+
+//  Build the generated source file with the host compiler against the hc
+//  emulation headers. HCFFT_HOST_CXX, HCFFT_HOST_CXXFLAGS and
+//  HCFFT_HOST_INCLUDE override the compiler, its optimization flags and the
+//  directory of the headers
+static hcfftStatus CompileHostSharedObject(const std::string& filename,
+                                           const std::string& kernellib) {
+  const char* compiler = getenv("HCFFT_HOST_CXX");
+  const char* flags = getenv("HCFFT_HOST_CXXFLAGS");
+  const char* include = getenv("HCFFT_HOST_INCLUDE");
+  std::string execCmd = compiler ? compiler : "c++";
+  execCmd += " -std=c++11 -fPIC -shared -pthread -w ";
+  execCmd += flags ? flags : "-O2";
+  execCmd += " -I";
+  execCmd += include ? include : HCFFT_HOST_INCLUDE_DIR;
+  execCmd += " " + filename + " -o " + kernellib;
+
+  if (system(execCmd.c_str()) != 0) {
+    std::cout << "Host build of " << filename << " failed" << std::endl;
+    return HCFFT_ERROR;
+  }
+
+  return HCFFT_SUCCEEDS;
+}
+
+static bool kernelBuildStub = false;
+
+void SetKernelBuildStub(bool stub) { kernelBuildStub = stub; }
+
+static bool KernelBuildStubEnv() {
+  const char* value = getenv("HCFFT_KERNEL_BUILD_STUB");
+  return (value != NULL) && (value[0] != '\0');
+}
+
+bool KernelBuildStubbed() {
+  static const bool stubEnv = KernelBuildStubEnv();
+  return kernelBuildStub || stubEnv;
+}
+
+//  Invoke hcc to build the generated source file into a shared object
+hcfftStatus CompileSharedObject(const std::string& filename,
+                                const std::string& kernellib) {
+  if (KernelBuildStubbed()) {
+    return HCFFT_SUCCEEDS;
+  }
+
+  FFTBakeTimer timer(BAKE_COMPILE);
+  FFTMetrics::Add(METRIC_COMPILES);
+
+  if (HostEmulation()) {
+    return CompileHostSharedObject(filename, kernellib);
+  }
+
+  // Check if the default compiler path exists
+  std::string execCmd;
+  char fname[256] = "/opt/rocm/hcc/bin/hcc";
+
+  if (access(getenv("HCC_HOME"), F_OK) != -1) {
+    // TODO(Neelakandan): This path shall be removed. User shall build from
+    // default path compiler doesn't exist in default path
+    // check if user has specified compiler build path
+    // build_mode = true;
+    char* compilerPath = getenv("HCC_HOME");
+    std::string Path(compilerPath);
+    Path.append("/bin/");
+    execCmd = Path + "hcc `" + Path +
+              "hcc-config --install --cxxflags --ldflags --shared` "
+              "-Wno-unused-command-line-argument -lhc_am " +
+              filename + " -o " + kernellib;
+  } else if (access(fname, F_OK) != -1) {
+    // compiler exists
+    // install_mode = true;
+    std::string Path = "/opt/rocm/hcc/bin/";
+    execCmd = Path + "hcc `" + Path +
+              "hcc-config --install --cxxflags --ldflags --shared` "
+              "-Wno-unused-command-line-argument " +
+              filename + " -o " + kernellib;
+  } else {
+    // No compiler found
+    std::cout << "HCC compiler not found" << std::endl;
+    return HCFFT_INVALID;
+  }
+
+  system(execCmd.c_str());
+  return HCFFT_SUCCEEDS;
+}
+
+// Tag that keeps kernel libraries with user callbacks apart from the plain
+// ones. checkIfsoExist skips libraries that carry it.
+static std::string CallbackTag(const FFTPlan* fftPlan) {
+  if (fftPlan->loadCallback.empty() && fftPlan->storeCallback.empty()) {
+    return "";
+  }
+
+  std::hash<std::string> hasher;
+  size_t key = hasher(fftPlan->loadCallback + '\n' + fftPlan->storeCallback);
+  return "cb" + SztToStr(key) + "_";
+}
+
+// Tag that keeps kernel libraries of the same lengths apart when the plan
+// settings decompose them into different kernels
+static std::string DecompositionTag(const FFTPlan* fftPlan) {
+  // The batch decides among others whether real transforms run in pairs,
+  // the strides and distances how the sub-plans address the data, and the
+  // scales are compiled into the last kernels
+  std::stringstream settings;
+  settings.precision(17);
+  settings << fftPlan->columnMethod << " " << fftPlan->batchSize;
+
+  for (size_t i = 0; i < fftPlan->inStride.size(); i++) {
+    settings << " i" << fftPlan->inStride[i];
+  }
+
+  for (size_t i = 0; i < fftPlan->outStride.size(); i++) {
+    settings << " o" << fftPlan->outStride[i];
+  }
+
+  settings << " " << fftPlan->iDist << " " << fftPlan->oDist;
+  settings << " " << fftPlan->forwardScale << " " << fftPlan->backwardScale;
+  std::hash<std::string> hasher;
+  return "d" + SztToStr(hasher(settings.str()));
+}
+
+// Hand the user callbacks down to a sub-plan. Loads belong to the kernel that
+// reads the user input, stores to the one that writes the user output.
+static void InheritCallbacks(const FFTPlan* parent, FFTPlan* child, bool load,
+                             bool store) {
+  if (load) {
+    child->loadCallback = parent->loadCallback;
+    child->loadCallbackInfo = parent->loadCallbackInfo;
+  }
+
+  if (store) {
+    child->storeCallback = parent->storeCallback;
+    child->storeCallbackInfo = parent->storeCallbackInfo;
+  }
+}
+
+// Batched 1D real transforms can run as half as many complex transforms, each
+// carrying two real signals in its real and imaginary parts
+static bool PairedRealPossible(const FFTPlan* fftPlan) {
+  bool r2c = (fftPlan->ipLayout == HCFFT_REAL) &&
+             (fftPlan->opLayout == HCFFT_HERMITIAN_INTERLEAVED);
+  bool c2r = (fftPlan->ipLayout == HCFFT_HERMITIAN_INTERLEAVED) &&
+             (fftPlan->opLayout == HCFFT_REAL);
+  return (r2c || c2r) && (fftPlan->length.size() == 1) &&
+         (fftPlan->batchSize > 1) && fftPlan->loadCallback.empty() &&
+         fftPlan->storeCallback.empty();
+}
+
+// Small interleaved 2D and 3D complex transforms run as one kernel when the
+// whole tile fits into LDS
+static bool LdsMultiDimPossible(const FFTPlan* fftPlan) {
+  // Transpose and copy sub-plans are 2D too, but must keep their generator
+  if ((fftPlan->gen != Stockham) && (fftPlan->gen != Stockham_LDS) &&
+      (fftPlan->gen != Stockham_Library)) {
+    return false;
+  }
+
+  if ((fftPlan->dimension != HCFFT_2D && fftPlan->dimension != HCFFT_3D) ||
+      (fftPlan->length.size() != fftPlan->Rank())) {
+    return false;
+  }
+
+  if ((fftPlan->ipLayout != HCFFT_COMPLEX_INTERLEAVED) ||
+      (fftPlan->opLayout != HCFFT_COMPLEX_INTERLEAVED) ||
+      (fftPlan->precision == HCFFT_HALF) ||
+      (fftPlan->transposeType != HCFFT_NOTRANSPOSE) ||
+      !fftPlan->loadCallback.empty() || !fftPlan->storeCallback.empty()) {
+    return false;
+  }
+
+  size_t count = 1;
+  std::vector<size_t> radices;
+
+  for (size_t i = 0; i < fftPlan->length.size(); i++) {
+    if (!LdsAxisRadices(fftPlan->length[i], &radices)) {
+      return false;
+    }
+
+    count *= fftPlan->length[i];
+  }
+
+  return count * fftPlan->ElementSize() <=
+         static_cast<size_t>(fftPlan->envelope.limit_LocalMemSize);
+}
+
+// Column planner. 'width' neighbouring columns of 'length' elements, 'count'
+// such sets in total, are either transformed in place by a blocked strided
+// kernel or by the alternative, which costs 'otherCost' coalesced passes over
+// the volume. A blocked pass reads and writes the volume once, but each row
+// segment it touches is only blockWidth elements long, and it launches one
+// work group per block.
+static bool BlockedColumnsPreferred(const FFTPlan* fftPlan, size_t length,
+                                    size_t width, size_t count,
+                                    double otherCost) {
+  if ((fftPlan->columnMethod == HCFFT_COLUMNS_TRANSPOSE) ||
+      (fftPlan->ipLayout != HCFFT_COMPLEX_INTERLEAVED) ||
+      (fftPlan->opLayout != HCFFT_COMPLEX_INTERLEAVED) ||
+      (fftPlan->precision == HCFFT_HALF)) {
+    return false;
+  }
+
+  size_t blockWidth = StockhamBlockWidth(fftPlan->precision, length);
+
+  if ((blockWidth == 0) || (width % blockWidth != 0)) {
+    return false;
+  }
+
+  if (fftPlan->columnMethod == HCFFT_COLUMNS_STRIDED) {
+    return true;
+  }
+
+  double segment = static_cast<double>(blockWidth * fftPlan->ElementSize());
+  double cost = std::max(1.0, ARBITRARY::TRANSACTION_BYTES / segment);
+  size_t groups = (width / blockWidth) * count;
+
+  if (groups < ARBITRARY::MIN_WORK_GROUPS) {
+    cost *= static_cast<double>(ARBITRARY::MIN_WORK_GROUPS) / groups;
+  }
+
+  return cost <= otherCost;
+}
+
+// Sub-plans a baked plan decomposed into; empty for single kernel plans.
+// roles, if given, receives the member of the plan holding each of them
+static std::vector<hcfftPlanHandle> SubPlans(
+    const FFTPlan* fftPlan, std::vector<std::string>* roles = NULL) {
+  hcfftPlanHandle handles[] = {fftPlan->planX,  fftPlan->planY,
+                               fftPlan->planZ,  fftPlan->planTX,
+                               fftPlan->planTY, fftPlan->planTZ,
+                               fftPlan->planRCcopy, fftPlan->planCopy};
+  const char* names[] = {"planX",  "planY",  "planZ",      "planTX",
+                         "planTY", "planTZ", "planRCcopy", "planCopy"};
+  std::vector<hcfftPlanHandle> subPlans;
+
+  for (size_t i = 0; i < sizeof(handles) / sizeof(handles[0]); i++) {
+    if (handles[i] != 0) {
+      subPlans.push_back(handles[i]);
+
+      if (roles != NULL) {
+        roles->push_back(names[i]);
+      }
+    }
+  }
+
+  subPlans.insert(subPlans.end(), fftPlan->axisPlans.begin(),
+                  fftPlan->axisPlans.end());
+
+  for (size_t i = 0; (roles != NULL) && (i < fftPlan->axisPlans.size());
+       i++) {
+    roles->push_back("axisPlans[" + std::to_string(i) + "]");
+  }
+
+  return subPlans;
+}
+
+// Count the kernels of a baked plan tree that carry a load or store callback
+static void CountCallbackKernels(hcfftPlanHandle plHandle, size_t& loads,
+                                 size_t& stores) {
+  FFTRepo& fftRepo = FFTRepo::getInstance();
+  FFTPlan* fftPlan = NULL;
+  lockRAII* planLock = NULL;
+  fftRepo.getPlan(plHandle, fftPlan, planLock);
+  std::vector<hcfftPlanHandle> subPlans = SubPlans(fftPlan);
+
+  for (size_t i = 0; i < subPlans.size(); i++) {
+    CountCallbackKernels(subPlans[i], loads, stores);
+  }
+
+  if (subPlans.empty()) {
+    loads += fftPlan->loadCallback.empty() ? 0 : 1;
+    stores += fftPlan->storeCallback.empty() ? 0 : 1;
+  }
+}
+
+// Half precision storage is only generated by the Stockham and copy kernels,
+// the transpose generators know fp32 and fp64 only. Half plans therefore run
+// one strided pass per axis, and every axis has to fit into a single kernel
+static bool HalfStorageSupported(const FFTPlan* fftPlan) {
+  size_t Large1DThreshold = 0;
+  fftPlan->GetMax1DLength(&Large1DThreshold);
+
+  for (size_t i = 0; i < fftPlan->length.size(); i++) {
+    if (!Is1DPossible(fftPlan->length[i], Large1DThreshold)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Append the cost of every kernel of a baked plan tree, sub-plans first
+static hcfftStatus CollectKernelCosts(hcfftPlanHandle plHandle,
+                                      const FFTRoofline& roofline,
+                                      std::vector<FFTKernelCost>* costs) {
+  FFTRepo& fftRepo = FFTRepo::getInstance();
+  FFTPlan* fftPlan = NULL;
+  lockRAII* planLock = NULL;
+  fftRepo.getPlan(plHandle, fftPlan, planLock);
+  std::vector<hcfftPlanHandle> subPlans = SubPlans(fftPlan);
+
+  for (size_t i = 0; i < subPlans.size(); i++) {
+    hcfftStatus status = CollectKernelCosts(subPlans[i], roofline, costs);
+
+    if (status != HCFFT_SUCCEEDS) {
+      return status;
+    }
+  }
+
+  if (!subPlans.empty()) {
+    return HCFFT_SUCCEEDS;
+  }
+
+  FFTKernelCost cost;
+  hcfftStatus status = fftPlan->GetKernelCost(&cost);
+
+  if (status != HCFFT_SUCCEEDS) {
+    return status;
+  }
+
+  cost.seconds = roofline.Seconds(cost, fftPlan->precision);
+  costs->push_back(cost);
+  return HCFFT_SUCCEEDS;
+}
+
+// Describe a baked plan tree into node, children in the order they run
+static hcfftStatus ExplainPlanTree(hcfftPlanHandle plHandle,
+                                   const std::string& role, FFTPlanNode* node) {
+  FFTRepo& fftRepo = FFTRepo::getInstance();
+  FFTPlan* fftPlan = NULL;
+  lockRAII* planLock = NULL;
+  fftRepo.getPlan(plHandle, fftPlan, planLock);
+  node->role = role;
+  node->handle = plHandle;
+  node->gen = fftPlan->gen;
+  node->dimension = fftPlan->Rank();
+  node->precision = fftPlan->precision;
+  node->direction = fftPlan->direction;
+  node->ipLayout = fftPlan->ipLayout;
+  node->opLayout = fftPlan->opLayout;
+  node->location = fftPlan->location;
+  node->backend = fftPlan->backend;
+  node->length = fftPlan->length;
+  node->inStride = fftPlan->inStride;
+  node->outStride = fftPlan->outStride;
+  node->iDist = fftPlan->iDist;
+  node->oDist = fftPlan->oDist;
+  node->batchSize = fftPlan->batchSize;
+  node->large1D = fftPlan->large1D;
+  node->large2D = fftPlan->large2D;
+  node->twiddleFront = fftPlan->twiddleFront;
+  node->transflag = fftPlan->transflag;
+  node->blockCompute = fftPlan->blockCompute;
+  node->blockComputeType = fftPlan->blockComputeType;
+  node->realSpecial = fftPlan->realSpecial;
+  node->realSpecial_Nr = fftPlan->realSpecial_Nr;
+  node->realPair = fftPlan->realPair;
+  node->RCsimple = fftPlan->RCsimple;
+  node->tmpBufSize = fftPlan->tmpBufSize;
+  node->tmpBufSizeRC = fftPlan->tmpBufSizeRC;
+  node->tmpBufSizeC2R = fftPlan->tmpBufSizeC2R;
+  std::vector<std::string> roles;
+  std::vector<hcfftPlanHandle> subPlans = SubPlans(fftPlan, &roles);
+  node->children.resize(subPlans.size());
+
+  for (size_t i = 0; i < subPlans.size(); i++) {
+    FFTPlanNode& child = node->children[i];
+    hcfftStatus status = ExplainPlanTree(subPlans[i], roles[i], &child);
+
+    if (status != HCFFT_SUCCEEDS) {
+      return status;
+    }
+
+    node->flops += child.flops;
+    node->bytes += child.bytes;
+  }
+
+  if (!node->Leaf()) {
+    return HCFFT_SUCCEEDS;
+  }
+
+  hcfftStatus status = fftPlan->GetWorkSizes(node->globalws, node->localws);
+
+  if (status != HCFFT_SUCCEEDS) {
+    return status;
+  }
+
+  status = fftPlan->GetKernelCost(&node->cost);
+
+  if (status != HCFFT_SUCCEEDS) {
+    return status;
+  }
+
+  node->flops = node->cost.flops;
+  node->bytes = node->cost.bytesRead + node->cost.bytesWritten;
+  return HCFFT_SUCCEEDS;
+}
+
+// Add the bake times of a plan and of every plan it runs through: sub-plans,
+// the placement variant and the plans of streamed and multi-device execution
+static void CollectBakeTimes(hcfftPlanHandle plHandle, FFTBakeTimes* times) {
+  FFTRepo& fftRepo = FFTRepo::getInstance();
+  FFTPlan* fftPlan = NULL;
+  lockRAII* planLock = NULL;
+
+  if (fftRepo.getPlan(plHandle, fftPlan, planLock) != HCFFT_SUCCEEDS) {
+    return;
+  }
+
+  times->Add(fftPlan->bakeTimes);
+  std::vector<hcfftPlanHandle> related = SubPlans(fftPlan);
+  related.insert(related.end(), fftPlan->devicePlans.begin(),
+                 fftPlan->devicePlans.end());
+
+  for (std::map<std::vector<size_t>, hcfftPlanHandle>::const_iterator it =
+           fftPlan->streamPlans.begin();
+       it != fftPlan->streamPlans.end(); it++) {
+    related.push_back(it->second);
+  }
+
+  if (fftPlan->placementPlan != 0) {
+    related.push_back(fftPlan->placementPlan);
+  }
+
+  for (size_t i = 0; i < related.size(); i++) {
+    CollectBakeTimes(related[i], times);
+  }
+}
+
 //  Compile the kernels that this plan uses, and store into the plan
 hcfftStatus CompileKernels(const hcfftPlanHandle plHandle,
                            const hcfftGenerators gen, FFTPlan* fftPlan,
@@ -185,11 +666,13 @@ hcfftStatus CompileKernels(const hcfftPlanHandle plHandle,
   bool c2h = ((fftParams.fft_outputLayout == HCFFT_HERMITIAN_PLANAR) ||
               (fftParams.fft_outputLayout == HCFFT_HERMITIAN_INTERLEAVED));
   bool buildFwdKernel = (gen == Stockham || gen == Transpose_GCN ||
-                         gen == Transpose_SQUARE || gen == Transpose_NONSQUARE)
+                         gen == Transpose_SQUARE ||
+                         gen == Transpose_NONSQUARE || gen == Stockham_LDS)
                             ? ((!real_transform) || r2c_transform)
                             : (r2c_transform || c2h) || (!(h2c || c2h));
   bool buildBwdKernel = (gen == Stockham || gen == Transpose_GCN ||
-                         gen == Transpose_SQUARE || gen == Transpose_NONSQUARE)
+                         gen == Transpose_SQUARE ||
+                         gen == Transpose_NONSQUARE || gen == Stockham_LDS)
                             ? ((!real_transform) || c2r_transform)
                             : (c2r_transform || h2c) || (!(h2c || c2h));
   bool writeFlag = false;
@@ -205,6 +688,8 @@ hcfftStatus CompileKernels(const hcfftPlanHandle plHandle,
 
   if (fftParams.fft_precision == HCFFT_SINGLE) {
     type += "F";
+  } else if (fftParams.fft_precision == HCFFT_HALF) {
+    type += "H";
   } else {
     type += "D";
   }
@@ -218,13 +703,31 @@ hcfftStatus CompileKernels(const hcfftPlanHandle plHandle,
   }
 
   if (beforeCompile != plHandleOrigin) {
-    fftPlan->filename = getHomeDir();
+    FFTPlan* originPlan = NULL;
+
+    if (plHandleOrigin != 0) {
+      lockRAII* originLock = NULL;
+      fftRepo.getPlan(plHandleOrigin, originPlan, originLock);
+
+      // In-place and out-of-place kernels of the same sizes are cached side
+      // by side
+      if (originPlan->location == HCFFT_INPLACE) {
+        type += "I";
+      }
+    }
+
+    fftPlan->filename = getKernelCacheDir();
     fftPlan->kernellib = fftPlan->filename;
-    fftPlan->filename += "/kernCache/kernel";
-    fftPlan->kernellib += "/kernCache/libkernel";
+    fftPlan->filename += "/kernel";
+    fftPlan->kernellib += "/libkernel";
     fftPlan->filename += type;
     fftPlan->kernellib += type;
 
+    if (originPlan != NULL) {
+      fftPlan->filename += CallbackTag(originPlan);
+      fftPlan->kernellib += CallbackTag(originPlan);
+    }
+
     for (int i = 0; i < originalLength.size(); i++) {
       fftPlan->filename += SztToStr(originalLength[i]);
       fftPlan->kernellib += SztToStr(originalLength[i]);
@@ -232,6 +735,11 @@ hcfftStatus CompileKernels(const hcfftPlanHandle plHandle,
       fftPlan->kernellib += "_";
     }
 
+    if (originPlan != NULL) {
+      fftPlan->filename += DecompositionTag(originPlan);
+      fftPlan->kernellib += DecompositionTag(originPlan);
+    }
+
     fftPlan->filename += ".cpp";
     fftPlan->kernellib += ".so";
     sfilename = fftPlan->filename;
@@ -245,37 +753,12 @@ hcfftStatus CompileKernels(const hcfftPlanHandle plHandle,
 
   if (!exist) {
     WriteKernel(plHandle, gen, fftParams, fftPlan->filename, writeFlag);
-    // Check if the default compiler path exists
-    std::string execCmd;
-    char fname[256] = "/opt/rocm/hcc/bin/hcc";
-
-    if (access(getenv("HCC_HOME"), F_OK) != -1) {
-      // TODO(Neelakandan): This path shall be removed. User shall build from
-      // default path compiler doesn't exist in default path
-      // check if user has specified compiler build path
-      // build_mode = true;
-      char* compilerPath = getenv("HCC_HOME");
-      std::string Path(compilerPath);
-      Path.append("/bin/");
-      execCmd = Path + "hcc `" + Path +
-                "hcc-config --install --cxxflags --ldflags --shared` "
-                "-Wno-unused-command-line-argument -lhc_am " +
-                fftPlan->filename + " -o " + fftPlan->kernellib;
-    } else if (access(fname, F_OK) != -1) {
-      // compiler exists
-      // install_mode = true;
-      std::string Path = "/opt/rocm/hcc/bin/";
-      execCmd = Path + "hcc `" + Path +
-                "hcc-config --install --cxxflags --ldflags --shared` "
-                "-Wno-unused-command-line-argument " +
-                fftPlan->filename + " -o " + fftPlan->kernellib;
-    } else {
-      // No compiler found
-      std::cout << "HCC compiler not found" << std::endl;
-      return HCFFT_INVALID;
-    }
+    hcfftStatus status =
+        CompileSharedObject(fftPlan->filename, fftPlan->kernellib);
 
-    system(execCmd.c_str());
+    if (status != HCFFT_SUCCEEDS) {
+      return status;
+    }
   }
 
   // get a kernel object handle for a kernel with the given name
@@ -321,15 +804,14 @@ hcfftStatus FFTPlan::GetEnvelope(const FFTEnvelope** ppEnvelope) const {
 }
 
 hcfftStatus hcfftCreateDefaultPlanInternal(hcfftPlanHandle* plHandle,
-                                           hcfftDim dimension,
-                                           const size_t* length) {
+                                           size_t rank, const size_t* length) {
   if (length == NULL) {
     return HCFFT_ERROR;
   }
 
-  size_t lenX = 1, lenY = 1, lenZ = 1;
+  size_t lenX = 1, lenY = 1, lenZ = 1, lenN = 1;
 
-  switch (dimension) {
+  switch (rank) {
     case HCFFT_1D: {
       if (length[0] == 0) {
         return HCFFT_ERROR;
@@ -357,22 +839,39 @@ hcfftStatus hcfftCreateDefaultPlanInternal(hcfftPlanHandle* plHandle,
       lenZ = length[2];
     } break;
 
-    default:
-      return HCFFT_ERROR;
-      break;
+    default: {
+      if (rank == 0 || rank > HCFFT_MAXDIM) {
+        return HCFFT_ERROR;
+      }
+
+      for (size_t i = 0; i < rank; i++) {
+        if (length[i] == 0) {
+          return HCFFT_ERROR;
+        }
+      }
+
+      lenX = length[0];
+      lenY = length[1];
+      lenZ = length[2];
+
+      for (size_t i = 3; i < rank; i++) {
+        lenN *= length[i];
+      }
+    } break;
   }
 
   FFTPlan* fftPlan = NULL;
   FFTRepo& fftRepo = FFTRepo::getInstance();
   fftRepo.createPlan(plHandle, fftPlan);
   fftPlan->baked = false;
-  fftPlan->dimension = dimension;
+  fftPlan->dimension = DimOfRank(rank);
   fftPlan->location = HCFFT_INPLACE;
   fftPlan->ipLayout = HCFFT_COMPLEX_INTERLEAVED;
   fftPlan->opLayout = HCFFT_COMPLEX_INTERLEAVED;
   fftPlan->precision = HCFFT_SINGLE;
   fftPlan->forwardScale = 1.0;
-  fftPlan->backwardScale = 1.0 / static_cast<double>(lenX * lenY * lenZ);
+  fftPlan->backwardScale =
+      1.0 / static_cast<double>(lenX * lenY * lenZ * lenN);
   fftPlan->batchSize = 1;
   fftPlan->gen = Stockham;  // default setting
   fftPlan->SetEnvelope();
@@ -383,7 +882,7 @@ hcfftStatus hcfftCreateDefaultPlanInternal(hcfftPlanHandle* plHandle,
   fftRepo.getPlan(*plHandle, fftPlan, planLock);
   planLock->setName(tstream.str());
 
-  switch (dimension) {
+  switch (rank) {
     case HCFFT_1D: {
       fftPlan->length.push_back(lenX);
       fftPlan->inStride.push_back(1);
@@ -416,6 +915,21 @@ hcfftStatus hcfftCreateDefaultPlanInternal(hcfftPlanHandle* plHandle,
       fftPlan->iDist = lenX * lenY * lenZ;
       fftPlan->oDist = lenX * lenY * lenZ;
     } break;
+
+    default: {
+      // Rank-N plans start out packed, axis 0 being the fastest varying
+      size_t stride = 1;
+
+      for (size_t i = 0; i < rank; i++) {
+        fftPlan->length.push_back(length[i]);
+        fftPlan->inStride.push_back(stride);
+        fftPlan->outStride.push_back(stride);
+        stride *= length[i];
+      }
+
+      fftPlan->iDist = stride;
+      fftPlan->oDist = stride;
+    } break;
   }
 
   fftPlan->plHandle = *plHandle;
@@ -425,9 +939,13 @@ hcfftStatus hcfftCreateDefaultPlanInternal(hcfftPlanHandle* plHandle,
 // This external entry-point should not be called from within the library. Use
 // hcfftCreateDefaultPlanInternal instead.
 hcfftStatus FFTPlan::hcfftCreateDefaultPlan(
-    hcfftPlanHandle* plHandle, const hcfftDim dim, const size_t* hcLengths,
+    hcfftPlanHandle* plHandle, const size_t rank, const size_t* hcLengths,
     hcfftDirection dir, hcfftPrecision precision, hcfftLibType libType) {
-  hcfftStatus ret = hcfftCreateDefaultPlanInternal(plHandle, dim, hcLengths);
+  if (HostEmulationRequested() && !HostEmulation()) {
+    return HCFFT_INVALID;
+  }
+
+  hcfftStatus ret = hcfftCreateDefaultPlanInternal(plHandle, rank, hcLengths);
 
   if (ret == HCFFT_SUCCEEDS) {
     FFTRepo& fftRepo = FFTRepo::getInstance();
@@ -438,12 +956,13 @@ hcfftStatus FFTPlan::hcfftCreateDefaultPlan(
     fftPlan->plHandleOrigin = *plHandle;
     fftPlan->originalLength.clear();
 
-    for (int i = 0; i < dim; i++) {
+    for (size_t i = 0; i < rank; i++) {
       fftPlan->originalLength.push_back(hcLengths[i]);
     }
 
     fftPlan->userPlan = true;
     fftPlan->hcfftlibtype = libType;
+    FFTMetrics::Add(METRIC_PLANS_CREATED);
   }
 
   return ret;
@@ -484,10 +1003,32 @@ hcfftStatus FFTPlan::hcfftEnqueueTransform(hcfftPlanHandle plHandle,
   lockRAII* planLock = NULL;
   fftRepo.getPlan(plHandle, fftPlan, planLock);
   scopedLock sLock(*planLock, _T(" hcfftEnqueueTransform"));
+  FFTExecMetric execMetric;
+
+  if (fftPlan->RunsOnHost(false)) {
+    return hcfftEnqueueOnHost<T>(plHandle, dir, hcInputBuffers,
+                                 hcOutputBuffers, true);
+  }
+
+  // The precompiled kernels have no library to load
+  if (fftPlan->gen == Stockham_Library) {
+    return hcfftEnqueueLibrary<T>(plHandle, dir, hcInputBuffers,
+                                  hcOutputBuffers);
+  }
+
   countKernel = 0;
+  bool firstRun = (fftPlan->transformed == false);
+  // The first run loads the library and removes the source under the kernel
+  // cache lock, later runs only re-enter the plan lock
+  scopedLock cLock(firstRun ? kernelCacheLock : *planLock,
+                   _T(" hcfftEnqueueTransform"));
 
-  if (fftPlan->transformed == false) {
+  // Loading the kernels counts as part of baking the plan
+  FFTBakeScope bakeScope(plHandle, &fftPlan->bakeTimes, "load");
+
+  if (firstRun) {
     char* err = (char*)calloc(128, 2);
+    FFTBakeTimer timer(BAKE_DLOPEN);
     kernelHandle = dlopen(fftPlan->kernellib.c_str(), RTLD_NOW);
 
     if (!kernelHandle) {
@@ -499,7 +1040,11 @@ hcfftStatus FFTPlan::hcfftEnqueueTransform(hcfftPlanHandle plHandle,
 
   status = hcfftEnqueueTransformInternal<T>(plHandle, dir, hcInputBuffers,
                                             hcOutputBuffers, hcTmpBuffers);
-  remove(fftPlan->filename.c_str());
+
+  if (firstRun) {
+    remove(fftPlan->filename.c_str());
+  }
+
   fftPlan->transformed = true;
   return status;
 }
@@ -553,11 +1098,16 @@ hcfftStatus FFTPlan::hcfftEnqueueTransformInternal(hcfftPlanHandle plHandle,
     // For outofplace operation, we have the choice not to create intermediate
     // buffer
     // input ->(col+Transpose) output ->(col) output
-    fftPlan->intBuffer = hc::am_alloc(fftPlan->tmpBufSize, fftPlan->acc, 0);
+    FFTBakeTimer timer(BAKE_SCRATCH);
+    fftPlan->intBuffer = hc::am_alloc(fftPlan->tmpBufSize, fftPlan->acc,
+                                       KernelAllocFlags());
 
     if (fftPlan->intBuffer == NULL) {
       return HCFFT_INVALID;
     }
+
+    fftPlan->scratchBytes += fftPlan->tmpBufSize;
+    FFTMetrics::Add(METRIC_SCRATCH_BYTES, fftPlan->tmpBufSize);
   }
 
   if (hcTmpBuffers == NULL && fftPlan->intBuffer != NULL) {
@@ -565,20 +1115,29 @@ hcfftStatus FFTPlan::hcfftEnqueueTransformInternal(hcfftPlanHandle plHandle,
   }
 
   if (fftPlan->intBufferRC == NULL && fftPlan->tmpBufSizeRC > 0) {
-    fftPlan->intBufferRC = hc::am_alloc(fftPlan->tmpBufSizeRC, fftPlan->acc, 0);
+    FFTBakeTimer timer(BAKE_SCRATCH);
+    fftPlan->intBufferRC = hc::am_alloc(fftPlan->tmpBufSizeRC, fftPlan->acc,
+                                         KernelAllocFlags());
 
     if (fftPlan->intBufferRC == NULL) {
       return HCFFT_INVALID;
     }
+
+    fftPlan->scratchBytes += fftPlan->tmpBufSizeRC;
+    FFTMetrics::Add(METRIC_SCRATCH_BYTES, fftPlan->tmpBufSizeRC);
   }
 
   if (fftPlan->intBufferC2R == NULL && fftPlan->tmpBufSizeC2R > 0) {
+    FFTBakeTimer timer(BAKE_SCRATCH);
     fftPlan->intBufferC2R =
-        hc::am_alloc(fftPlan->tmpBufSizeC2R, fftPlan->acc, 0);
+        hc::am_alloc(fftPlan->tmpBufSizeC2R, fftPlan->acc, KernelAllocFlags());
 
     if (fftPlan->intBufferC2R == NULL) {
       return HCFFT_INVALID;
     }
+
+    fftPlan->scratchBytes += fftPlan->tmpBufSizeC2R;
+    FFTMetrics::Add(METRIC_SCRATCH_BYTES, fftPlan->tmpBufSizeC2R);
   }
 
   //  The largest vector we can transform in a single pass
@@ -589,7 +1148,38 @@ hcfftStatus FFTPlan::hcfftEnqueueTransformInternal(hcfftPlanHandle plHandle,
   fftPlan->GetMax1DLength(&Large1DThreshold);
   BUG_CHECK(Large1DThreshold > 1);
 
-  if (fftPlan->gen != Copy) switch (fftPlan->dimension) {
+  if (!fftPlan->axisPlans.empty()) {
+    size_t passes = fftPlan->axisPlans.size();
+    bool inplace = (fftPlan->location == HCFFT_INPLACE);
+
+    if (fftPlan->opLayout == HCFFT_REAL && !inplace) {
+      // input ->(complex axes) staging ->(real axis) output
+      T* staging = (T*)fftPlan->intBufferC2R;
+
+      for (size_t i = 0; i < passes; i++) {
+        T* src = (i == 0) ? hcInputBuffers : staging;
+        T* dst = (i == 0) ? staging
+                          : (i == passes - 1) ? hcOutputBuffers : NULL;
+        hcfftEnqueueTransformInternal<T>(fftPlan->axisPlans[i], dir, src, dst,
+                                         hcTmpBuffers);
+      }
+    } else {
+      // The first pass moves the data, the others run in place on the result
+      T* result = inplace ? hcInputBuffers : hcOutputBuffers;
+
+      for (size_t i = 0; i < passes; i++) {
+        T* src = (i == 0) ? hcInputBuffers : result;
+        T* dst = (i == 0 && !inplace) ? hcOutputBuffers : NULL;
+        hcfftEnqueueTransformInternal<T>(fftPlan->axisPlans[i], dir, src, dst,
+                                         hcTmpBuffers);
+      }
+    }
+
+    return HCFFT_SUCCEEDS;
+  }
+
+  if (fftPlan->gen != Copy && fftPlan->gen != Stockham_LDS)
+    switch (fftPlan->dimension) {
       case HCFFT_1D: {
         if (Is1DPossible(fftPlan->length[0], Large1DThreshold)) {
           break;
@@ -640,6 +1230,27 @@ hcfftStatus FFTPlan::hcfftEnqueueTransformInternal(hcfftPlanHandle plHandle,
                                              (T*)fftPlan->intBufferRC,
                                              hcOutputBuffers, NULL);
           }
+        } else if (fftPlan->realPair) {
+          // pack the real pairs (or both hermitian halves) into the RC buffer
+          hcfftEnqueueTransformInternal<T>(fftPlan->planCopy, dir,
+                                           hcInputBuffers,
+                                           (T*)fftPlan->intBufferRC,
+                                           hcTmpBuffers);
+          // one complex FFT per pair, INPLACE
+          hcfftEnqueueTransformInternal<T>(fftPlan->planX, dir,
+                                           (T*)fftPlan->intBufferRC, NULL,
+                                           hcTmpBuffers);
+
+          // split the pairs into the user layout
+          if (fftPlan->location == HCFFT_INPLACE) {
+            hcfftEnqueueTransformInternal<T>(fftPlan->planRCcopy, dir,
+                                             (T*)fftPlan->intBufferRC,
+                                             hcInputBuffers, hcTmpBuffers);
+          } else {
+            hcfftEnqueueTransformInternal<T>(fftPlan->planRCcopy, dir,
+                                             (T*)fftPlan->intBufferRC,
+                                             hcOutputBuffers, hcTmpBuffers);
+          }
         } else if (fftPlan->ipLayout == HCFFT_REAL) {
           // First pass
           // column with twiddle first, OUTOFPLACE, + transpose
@@ -948,7 +1559,9 @@ hcfftStatus FFTPlan::hcfftEnqueueTransformInternal(hcfftPlanHandle plHandle,
             }
           }
         } else {
-          if ((fftPlan->large2D || fftPlan->length.size() > 2) &&
+          // Rows run in place on the output whenever the columns do
+          if ((fftPlan->stridedColumns || fftPlan->large2D ||
+               fftPlan->length.size() > 2) &&
               (fftPlan->ipLayout != HCFFT_REAL) &&
               (fftPlan->opLayout != HCFFT_REAL)) {
             if (fftPlan->location == HCFFT_INPLACE) {
@@ -1581,7 +2194,8 @@ hcfftStatus FFTPlan::hcfftEnqueueTransformInternal(hcfftPlanHandle plHandle,
   }
 
   if (fftPlan->gen == Stockham || fftPlan->gen == Transpose_GCN ||
-      fftPlan->gen == Transpose_SQUARE || fftPlan->gen == Transpose_NONSQUARE) {
+      fftPlan->gen == Transpose_SQUARE || fftPlan->gen == Transpose_NONSQUARE ||
+      fftPlan->gen == Stockham_LDS) {
     if (fftPlan->twiddles != NULL) {
       vectArr.insert(std::make_pair(uarg++, fftPlan->twiddles));
     }
@@ -1591,7 +2205,13 @@ hcfftStatus FFTPlan::hcfftEnqueueTransformInternal(hcfftPlanHandle plHandle,
     }
   }
 
+  if (fftParams.fft_hasLoadCallback || fftParams.fft_hasStoreCallback) {
+    vectArr.insert(std::make_pair(uarg++, fftPlan->loadCallbackInfo));
+    vectArr.insert(std::make_pair(uarg++, fftPlan->storeCallbackInfo));
+  }
+
   if (fftPlan->transformed == false) {
+    FFTBakeTimer timer(BAKE_DLSYM);
     typedef void(FUNC_FFTFwd)(std::map<int, void*> * vectArr, uint batchSize,
                               hc::accelerator_view & acc_view,
                               hc::accelerator & acc);
@@ -1604,7 +2224,9 @@ hcfftStatus FFTPlan::hcfftEnqueueTransformInternal(hcfftPlanHandle plHandle,
                      : false;
       std::string funcName = "copy_";
 
-      if (h2c) {
+      if (fftPlan->realPair) {
+        funcName += "pair";
+      } else if (h2c) {
         funcName += "h2c";
       } else {
         funcName += "c2h";
@@ -1625,7 +2247,7 @@ hcfftStatus FFTPlan::hcfftEnqueueTransformInternal(hcfftPlanHandle plHandle,
       }
 
       free(err);
-    } else if (fftPlan->gen == Stockham) {
+    } else if (fftPlan->gen == Stockham || fftPlan->gen == Stockham_LDS) {
       if (dir == HCFFT_FORWARD) {
         std::string funcName = "fft_fwd";
         funcName += std::to_string(countKernel);
@@ -1754,7 +2376,25 @@ hcfftStatus FFTPlan::hcfftEnqueueTransformInternal(hcfftPlanHandle plHandle,
   }
 
   BUG_CHECK(gWorkSize.size() == lWorkSize.size());
+  FFTProfiler& profiler = FFTProfiler::getInstance();
+  bool profiling = profiler.Enabled();
+  double start = profiling ? profiler.Now() : 0;
   fftPlan->kernelPtr(&vectArr, batch, fftPlan->acc_view, fftPlan->acc);
+
+  if (profiling) {
+    profiler.Record(fftPlan, start, profiler.Now() - start);
+  }
+
+  if (fftPlan->launchBytes == 0) {
+    FFTKernelCost cost;
+    fftPlan->GetKernelCost(&cost);
+    fftPlan->launchBytes = cost.bytesRead + cost.bytesWritten;
+  }
+
+  FFTMetrics::Add(static_cast<FFTMetric>(METRIC_KERNELS + fftPlan->gen));
+  FFTMetrics::Add(METRIC_KERNEL_BYTES,
+                  static_cast<int64_t>(fftPlan->launchBytes));
+
   countKernel++;
   return status;
 }
@@ -1767,7 +2407,6 @@ template hcfftStatus FFTPlan::hcfftEnqueueTransformInternal<double>(
     double* hcOutputBuffers, double* hcTmpBuffers);
 
 hcfftStatus FFTPlan::hcfftBakePlan(hcfftPlanHandle plHandle) {
-  bakedPlanCount = 0;
   FFTRepo& fftRepo = FFTRepo::getInstance();
   FFTPlan* fftPlan = NULL;
   lockRAII* planLock = NULL;
@@ -1778,20 +2417,131 @@ hcfftStatus FFTPlan::hcfftBakePlan(hcfftPlanHandle plHandle) {
     return HCFFT_SUCCEEDS;
   }
 
-  fftPlan->exist =
-      checkIfsoExist(fftPlan->direction, fftPlan->precision,
-                     fftPlan->originalLength, fftPlan->hcfftlibtype);
-  hcfftStatus status = hcfftBakePlanInternal(plHandle);
-  fftPlan->filename = sfilename;
-  fftPlan->kernellib = skernellib;
-  return status;
-}
+  scopedLock cLock(kernelCacheLock, _T("hcfftBakePlan"));
+  FFTBakeScope bakeScope(plHandle, &fftPlan->bakeTimes, "bake");
+  bakedPlanCount = 0;
 
-hcfftStatus FFTPlan::hcfftBakePlanInternal(hcfftPlanHandle plHandle) {
-  FFTRepo& fftRepo = FFTRepo::getInstance();
-  FFTPlan* fftPlan = NULL;
-  lockRAII* planLock = NULL;
-  fftRepo.getPlan(plHandle, fftPlan, planLock);
+  //  Plans the precompiled kernels cover generate and compile nothing. The
+  //  library runs one launch per axis, so tiles that fit into LDS keep their
+  //  single generated kernel
+  if (!LdsMultiDimPossible(fftPlan) && fftPlan->LibraryPossible()) {
+    // The precompiled kernels are always found in the kernel cache
+    FFTBakeTimer::CountCache(true);
+    FFTMetrics::Add(METRIC_CACHE_HITS);
+    hcfftStatus status = fftPlan->hcfftBakeLibrary();
+
+    if (status == HCFFT_SUCCEEDS) {
+      FFTMetrics::Add(METRIC_PLANS_BAKED);
+    }
+
+    return status;
+  }
+
+  if (fftPlan->gen == Stockham_Library) {
+    fftPlan->gen = Stockham;
+  }
+
+  // Reject half plans before any of their kernels is generated or built
+  if (fftPlan->precision == HCFFT_HALF && !HalfStorageSupported(fftPlan)) {
+    return HCFFT_INVALID;
+  }
+
+  bool callbacks =
+      !(fftPlan->loadCallback.empty() && fftPlan->storeCallback.empty());
+
+  if (callbacks) {
+    // Callback sources are baked into the kernels, so never reuse a cached
+    // library and always regenerate the source file
+    fftPlan->exist = false;
+    beforeCompile = 99999999;
+  } else if (KernelBuildStubbed()) {
+    // Generate every kernel, nothing is built to be found later
+    fftPlan->exist = false;
+  } else {
+    FFTBakeTimer timer(BAKE_CACHE_LOOKUP);
+    fftPlan->exist =
+        checkIfsoExist(fftPlan->direction, fftPlan->precision,
+                       fftPlan->originalLength, fftPlan->hcfftlibtype,
+                       fftPlan->location, DecompositionTag(fftPlan));
+  }
+
+  FFTBakeTimer::CountCache(fftPlan->exist);
+  FFTMetrics::Add(fftPlan->exist ? METRIC_CACHE_HITS : METRIC_CACHE_MISSES);
+
+  hcfftStatus status = hcfftBakePlanInternal(plHandle);
+
+  if (status == HCFFT_SUCCEEDS) {
+    FFTMetrics::Add(METRIC_PLANS_BAKED);
+  }
+
+  fftPlan->filename = sfilename;
+  fftPlan->kernellib = skernellib;
+
+  if (status == HCFFT_SUCCEEDS && callbacks) {
+    // Only decompositions whose first and last kernels touch the user
+    // buffers directly can honour the callbacks
+    size_t loads = 0, stores = 0;
+    CountCallbackKernels(plHandle, loads, stores);
+
+    if ((!fftPlan->loadCallback.empty() && loads == 0) ||
+        (!fftPlan->storeCallback.empty() && stores == 0)) {
+      fftPlan->baked = false;
+      return HCFFT_INVALID;
+    }
+  }
+
+  return status;
+}
+
+// Create the 1D pass over one axis of a rank-N plan. The other axes follow as
+// extra lengths, so a single launch covers the whole volume.
+static FFTPlan* CreateAxisPlan(FFTPlan* fftPlan, hcfftPlanHandle* plHandle,
+                               size_t axis, const std::vector<size_t>& lengths,
+                               const std::vector<size_t>& inStride,
+                               size_t iDist,
+                               const std::vector<size_t>& outStride,
+                               size_t oDist) {
+  FFTRepo& fftRepo = FFTRepo::getInstance();
+  hcfftCreateDefaultPlanInternal(plHandle, HCFFT_1D, &lengths[axis]);
+  FFTPlan* axisPlan = NULL;
+  lockRAII* axisLock = NULL;
+  fftRepo.getPlan(*plHandle, axisPlan, axisLock);
+  axisPlan->plHandleOrigin = fftPlan->plHandleOrigin;
+  axisPlan->inStride[0] = inStride[axis];
+  axisPlan->outStride[0] = outStride[axis];
+
+  for (size_t index = 0; index < lengths.size(); index++) {
+    if (index == axis) {
+      continue;
+    }
+
+    axisPlan->length.push_back(lengths[index]);
+    axisPlan->inStride.push_back(inStride[index]);
+    axisPlan->outStride.push_back(outStride[index]);
+  }
+
+  axisPlan->iDist = iDist;
+  axisPlan->oDist = oDist;
+  axisPlan->precision = fftPlan->precision;
+  axisPlan->forwardScale = 1.0f;
+  axisPlan->backwardScale = 1.0f;
+  axisPlan->tmpBufSize = fftPlan->tmpBufSize;
+  axisPlan->gen = fftPlan->gen;
+  axisPlan->envelope = fftPlan->envelope;
+  axisPlan->batchSize = fftPlan->batchSize;
+  axisPlan->hcfftlibtype = fftPlan->hcfftlibtype;
+  axisPlan->originalLength = fftPlan->originalLength;
+  axisPlan->acc = fftPlan->acc;
+  axisPlan->exist = fftPlan->exist;
+  fftPlan->axisPlans.push_back(*plHandle);
+  return axisPlan;
+}
+
+hcfftStatus FFTPlan::hcfftBakePlanInternal(hcfftPlanHandle plHandle) {
+  FFTRepo& fftRepo = FFTRepo::getInstance();
+  FFTPlan* fftPlan = NULL;
+  lockRAII* planLock = NULL;
+  fftRepo.getPlan(plHandle, fftPlan, planLock);
   scopedLock sLock(*planLock, _T("hcfftBakePlanInternal"));
 
   // if we have already baked the plan and nothing has changed since, we're done
@@ -1826,7 +2576,7 @@ hcfftStatus FFTPlan::hcfftBakePlanInternal(hcfftPlanHandle plHandle) {
   size_t SP_MAX_LEN = 1 << 24;
   size_t DP_MAX_LEN = 1 << 22;
 
-  if ((fftPlan->precision == HCFFT_SINGLE) &&
+  if ((fftPlan->precision != HCFFT_DOUBLE) &&
       (maxLengthInAnyDim > SP_MAX_LEN) && rc) {
     return HCFFT_INVALID;
   }
@@ -1877,6 +2627,11 @@ hcfftStatus FFTPlan::hcfftBakePlanInternal(hcfftPlanHandle plHandle) {
     fftPlan->intBufferC2R = NULL;
   }
 
+  FFTMetrics::Add(METRIC_SCRATCH_BYTES,
+                  -static_cast<int64_t>(fftPlan->scratchBytes));
+  fftPlan->scratchBytes = 0;
+  fftPlan->launchBytes = 0;
+
   if (fftPlan->userPlan) {  // confirm it is top-level plan (user plan)
     if (fftPlan->location == HCFFT_INPLACE) {
       if ((fftPlan->ipLayout == HCFFT_HERMITIAN_PLANAR) ||
@@ -1890,7 +2645,7 @@ hcfftStatus FFTPlan::hcfftBakePlanInternal(hcfftPlanHandle plHandle) {
       if ((fftPlan->ipLayout != HCFFT_REAL) &&
           (fftPlan->opLayout != HCFFT_REAL)) {
         // check strides
-        for (size_t i = 0; i < fftPlan->dimension; i++)
+        for (size_t i = 0; i < fftPlan->Rank(); i++)
           if (fftPlan->inStride[i] != fftPlan->outStride[i]) {
             return HCFFT_INVALID;
           }
@@ -1915,7 +2670,9 @@ hcfftStatus FFTPlan::hcfftBakePlanInternal(hcfftPlanHandle plHandle) {
 
   // Compress the plan by discarding length '1' dimensions
   // decision to pick generator
-  if (fftPlan->userPlan && !rc) {  // confirm it is top-level plan (user plan)
+  // confirm it is top-level plan (user plan); plans above 3 dimensions keep
+  // their axes
+  if (fftPlan->userPlan && !rc && fftPlan->Rank() <= HCFFT_3D) {
     size_t dmnsn = fftPlan->dimension;
     bool pow2flag = true;
 
@@ -1977,6 +2734,172 @@ hcfftStatus FFTPlan::hcfftBakePlanInternal(hcfftPlanHandle plHandle) {
   fftPlan->GetMax1DLength(&Large1DThreshold);
   BUG_CHECK(Large1DThreshold > 1);
 
+  //  Plans above 3 dimensions, and half precision plans above 1 dimension,
+  //  run one strided 1D pass per axis. Real transforms do the real axis first
+  //  (R2C) or last (C2R) and complex passes over the halved volume for the
+  //  rest.
+  if (fftPlan->Rank() > HCFFT_3D ||
+      (fftPlan->precision == HCFFT_HALF && fftPlan->Rank() > HCFFT_1D)) {
+    bool r2c = (fftPlan->ipLayout == HCFFT_REAL);
+    bool c2r = (fftPlan->opLayout == HCFFT_REAL);
+    size_t rank = fftPlan->length.size();
+
+    if ((fftPlan->ipLayout == HCFFT_HERMITIAN_PLANAR) ||
+        (fftPlan->opLayout == HCFFT_HERMITIAN_PLANAR)) {
+      return HCFFT_INVALID;
+    }
+
+    for (size_t i = 0; i < fftPlan->axisPlans.size(); i++) {
+      hcfftDestroyPlan(&fftPlan->axisPlans[i]);
+    }
+
+    fftPlan->axisPlans.clear();
+    // Extents of the complex side of the transform
+    std::vector<size_t> cLength(fftPlan->length);
+
+    if (r2c || c2r) {
+      cLength[0] = 1 + fftPlan->length[0] / 2;
+    }
+
+    // Packed strides of the complex side, used to stage out-of-place C2R
+    std::vector<size_t> packed(rank);
+    size_t packedDist = 1;
+    bool large = false;
+
+    for (size_t i = 0; i < rank; i++) {
+      packed[i] = packedDist;
+      packedDist *= cLength[i];
+      large = large || !Is1DPossible(fftPlan->length[i], Large1DThreshold);
+    }
+
+    if (fftPlan->tmpBufSize == 0 && large) {
+      fftPlan->tmpBufSize =
+          packedDist * fftPlan->batchSize * fftPlan->ElementSize();
+    }
+
+    if (c2r && (fftPlan->tmpBufSizeC2R == 0) &&
+        (fftPlan->location == HCFFT_OUTOFPLACE)) {
+      fftPlan->tmpBufSizeC2R =
+          packedDist * fftPlan->batchSize * fftPlan->ElementSize();
+    }
+
+    hcfftIpLayout cLayout = r2c ? fftPlan->opLayout : fftPlan->ipLayout;
+
+    if (cLayout == HCFFT_HERMITIAN_INTERLEAVED) {
+      cLayout = HCFFT_COMPLEX_INTERLEAVED;
+    }
+
+    hcfftStatus status = HCFFT_SUCCEEDS;
+
+    if (c2r) {
+      bool inplace = (fftPlan->location == HCFFT_INPLACE);
+
+      // Complex axes, last to first: input->staging, then staging in place
+      for (size_t axis = rank - 1; axis > 0; axis--) {
+        bool first = (axis == rank - 1);
+        hcfftPlanHandle axisHandle = 0;
+        FFTPlan* axisPlan = NULL;
+
+        if (inplace || !first) {
+          const std::vector<size_t>& stride =
+              inplace ? fftPlan->inStride : packed;
+          size_t dist = inplace ? fftPlan->iDist : packedDist;
+          axisPlan = CreateAxisPlan(fftPlan, &axisHandle, axis, cLength,
+                                    stride, dist, stride, dist);
+          axisPlan->location = HCFFT_INPLACE;
+        } else {
+          axisPlan = CreateAxisPlan(fftPlan, &axisHandle, axis, cLength,
+                                    fftPlan->inStride, fftPlan->iDist, packed,
+                                    packedDist);
+          axisPlan->location = HCFFT_OUTOFPLACE;
+        }
+
+        axisPlan->ipLayout = cLayout;
+        axisPlan->opLayout = cLayout;
+        InheritCallbacks(fftPlan, axisPlan, first, false);
+        status = hcfftBakePlanInternal(axisHandle);
+
+        if (status != HCFFT_SUCCEEDS) {
+          return status;
+        }
+      }
+
+      // Real axis: staging (or input) -> output
+      hcfftPlanHandle axisHandle = 0;
+      FFTPlan* axisPlan = CreateAxisPlan(
+          fftPlan, &axisHandle, 0, fftPlan->length,
+          inplace ? fftPlan->inStride : packed,
+          inplace ? fftPlan->iDist : packedDist, fftPlan->outStride,
+          fftPlan->oDist);
+      axisPlan->location = fftPlan->location;
+      axisPlan->ipLayout = HCFFT_HERMITIAN_INTERLEAVED;
+      axisPlan->opLayout = HCFFT_REAL;
+      axisPlan->backwardScale = fftPlan->backwardScale;
+      InheritCallbacks(fftPlan, axisPlan, false, true);
+      status = hcfftBakePlanInternal(axisHandle);
+    } else {
+      // First axis: input -> output (R2C or C2C), then output in place
+      for (size_t axis = 0; axis < rank; axis++) {
+        bool first = (axis == 0);
+        bool last = (axis == rank - 1);
+        hcfftPlanHandle axisHandle = 0;
+        FFTPlan* axisPlan = NULL;
+
+        if (first) {
+          axisPlan = CreateAxisPlan(
+              fftPlan, &axisHandle, axis, r2c ? fftPlan->length : cLength,
+              fftPlan->inStride, fftPlan->iDist, fftPlan->outStride,
+              fftPlan->oDist);
+          axisPlan->location = fftPlan->location;
+          axisPlan->ipLayout = fftPlan->ipLayout;
+          axisPlan->opLayout = fftPlan->opLayout;
+        } else {
+          axisPlan = CreateAxisPlan(fftPlan, &axisHandle, axis, cLength,
+                                    fftPlan->outStride, fftPlan->oDist,
+                                    fftPlan->outStride, fftPlan->oDist);
+          axisPlan->location = HCFFT_INPLACE;
+          axisPlan->ipLayout = r2c ? cLayout : fftPlan->opLayout;
+          axisPlan->opLayout = r2c ? cLayout : fftPlan->opLayout;
+        }
+
+        if (last) {
+          axisPlan->forwardScale = fftPlan->forwardScale;
+          axisPlan->backwardScale = fftPlan->backwardScale;
+        }
+
+        InheritCallbacks(fftPlan, axisPlan, first, last);
+        status = hcfftBakePlanInternal(axisHandle);
+
+        if (status != HCFFT_SUCCEEDS) {
+          return status;
+        }
+      }
+    }
+
+    if (status == HCFFT_SUCCEEDS) {
+      fftPlan->baked = true;
+    }
+
+    return status;
+  }
+
+  //  Small 2D and 3D tiles skip the row/transpose/column decomposition and
+  //  run every axis inside one work group
+  if (fftPlan->gen == Stockham_LDS) {
+    fftPlan->gen = Stockham;
+  }
+
+  if (LdsMultiDimPossible(fftPlan)) {
+    fftPlan->gen = Stockham_LDS;
+    fftPlan->GenerateKernel(plHandle, fftRepo, bakedPlanCount, fftPlan->exist);
+    CompileKernels(plHandle, fftPlan->gen, fftPlan, fftPlan->plHandleOrigin,
+                   fftPlan->exist, fftPlan->originalLength,
+                   fftPlan->hcfftlibtype);
+    bakedPlanCount++;
+    fftPlan->baked = true;
+    return HCFFT_SUCCEEDS;
+  }
+
   //  Verify that the data passed to us is packed
   switch (fftPlan->dimension) {
     case HCFFT_1D: {
@@ -2195,6 +3118,16 @@ hcfftStatus FFTPlan::hcfftBakePlanInternal(hcfftPlanHandle plHandle) {
             break;
           }
 
+          // Four-step in two kernels when both factors fit a single kernel:
+          // the column FFTs read the input strided and apply the large
+          // twiddles in registers, the row FFTs write the output strided. This
+          // replaces the transpose/row/transpose/row/transpose chain.
+          if ((fftPlan->columnMethod != HCFFT_COLUMNS_TRANSPOSE) &&
+              Is1DPossible(hcLengths[0], Large1DThreshold) &&
+              Is1DPossible(hcLengths[1], Large1DThreshold)) {
+            break;
+          }
+
           size_t biggerDim =
               hcLengths[0] > hcLengths[1] ? hcLengths[0] : hcLengths[1];
           size_t smallerDim =
@@ -2755,6 +3688,94 @@ hcfftStatus FFTPlan::hcfftBakePlanInternal(hcfftPlanHandle plHandle) {
           fftPlan->transflag = true;
           fftPlan->baked = true;
           return HCFFT_SUCCEEDS;
+        } else if (PairedRealPossible(fftPlan)) {
+          // Two real signals per complex transform: pack the pairs into the
+          // RC buffer, transform them in place and split the result into the
+          // user layout
+          size_t pairs = DivRoundingUp<size_t>(fftPlan->batchSize, 2);
+          fftPlan->realPair = true;
+
+          if (fftPlan->tmpBufSizeRC == 0) {
+            fftPlan->tmpBufSizeRC =
+                fftPlan->length[0] * pairs * fftPlan->ElementSize();
+          }
+
+          hcfftCreateDefaultPlanInternal(&fftPlan->planCopy, HCFFT_1D,
+                                         &fftPlan->length[0]);
+          FFTPlan* packPlan = NULL;
+          lockRAII* packLock = NULL;
+          fftRepo.getPlan(fftPlan->planCopy, packPlan, packLock);
+          packPlan->location = HCFFT_OUTOFPLACE;
+          packPlan->ipLayout = fftPlan->ipLayout;
+          packPlan->opLayout = HCFFT_COMPLEX_INTERLEAVED;
+          packPlan->precision = fftPlan->precision;
+          packPlan->forwardScale = 1.0f;
+          packPlan->backwardScale = 1.0f;
+          packPlan->tmpBufSize = 0;
+          packPlan->batchSize = fftPlan->batchSize;
+          packPlan->gen = Copy;
+          packPlan->realPair = true;
+          packPlan->envelope = fftPlan->envelope;
+          packPlan->inStride[0] = fftPlan->inStride[0];
+          packPlan->iDist = fftPlan->iDist;
+          packPlan->outStride[0] = 1;
+          packPlan->oDist = fftPlan->length[0];
+          packPlan->hcfftlibtype = fftPlan->hcfftlibtype;
+          packPlan->originalLength = fftPlan->originalLength;
+          packPlan->acc = fftPlan->acc;
+          packPlan->exist = fftPlan->exist;
+          packPlan->plHandleOrigin = fftPlan->plHandleOrigin;
+          hcfftBakePlanInternal(fftPlan->planCopy);
+          // complex FFT of the pairs, in place in the RC buffer
+          hcfftCreateDefaultPlanInternal(&fftPlan->planX, HCFFT_1D,
+                                         &fftPlan->length[0]);
+          FFTPlan* pairPlan = NULL;
+          lockRAII* pairLock = NULL;
+          fftRepo.getPlan(fftPlan->planX, pairPlan, pairLock);
+          pairPlan->location = HCFFT_INPLACE;
+          pairPlan->ipLayout = HCFFT_COMPLEX_INTERLEAVED;
+          pairPlan->opLayout = HCFFT_COMPLEX_INTERLEAVED;
+          pairPlan->precision = fftPlan->precision;
+          pairPlan->forwardScale = fftPlan->forwardScale;
+          pairPlan->backwardScale = fftPlan->backwardScale;
+          pairPlan->tmpBufSize = 0;
+          pairPlan->batchSize = pairs;
+          pairPlan->gen = fftPlan->gen;
+          pairPlan->envelope = fftPlan->envelope;
+          pairPlan->iDist = fftPlan->length[0];
+          pairPlan->oDist = fftPlan->length[0];
+          pairPlan->hcfftlibtype = fftPlan->hcfftlibtype;
+          pairPlan->originalLength = fftPlan->originalLength;
+          pairPlan->acc = fftPlan->acc;
+          pairPlan->exist = fftPlan->exist;
+          pairPlan->plHandleOrigin = fftPlan->plHandleOrigin;
+          hcfftBakePlanInternal(fftPlan->planX);
+          hcfftCreateDefaultPlanInternal(&fftPlan->planRCcopy, HCFFT_1D,
+                                         &fftPlan->length[0]);
+          FFTPlan* splitPlan = NULL;
+          lockRAII* splitLock = NULL;
+          fftRepo.getPlan(fftPlan->planRCcopy, splitPlan, splitLock);
+          splitPlan->location = HCFFT_OUTOFPLACE;
+          splitPlan->ipLayout = HCFFT_COMPLEX_INTERLEAVED;
+          splitPlan->opLayout = fftPlan->opLayout;
+          splitPlan->precision = fftPlan->precision;
+          splitPlan->forwardScale = 1.0f;
+          splitPlan->backwardScale = 1.0f;
+          splitPlan->tmpBufSize = 0;
+          splitPlan->batchSize = fftPlan->batchSize;
+          splitPlan->gen = Copy;
+          splitPlan->realPair = true;
+          splitPlan->envelope = fftPlan->envelope;
+          splitPlan->inStride[0] = 1;
+          splitPlan->iDist = fftPlan->length[0];
+          splitPlan->outStride[0] = fftPlan->outStride[0];
+          splitPlan->oDist = fftPlan->oDist;
+          splitPlan->hcfftlibtype = fftPlan->hcfftlibtype;
+          splitPlan->originalLength = fftPlan->originalLength;
+          splitPlan->acc = fftPlan->acc;
+          splitPlan->exist = fftPlan->exist;
+          splitPlan->plHandleOrigin = fftPlan->plHandleOrigin;
+          hcfftBakePlanInternal(fftPlan->planRCcopy);
         } else if (fftPlan->ipLayout == HCFFT_REAL) {
           if (fftPlan->tmpBufSizeRC == 0) {
             fftPlan->tmpBufSizeRC =
@@ -3639,6 +4660,19 @@ hcfftStatus FFTPlan::hcfftBakePlanInternal(hcfftPlanHandle plHandle) {
         fftPlan->large2D = true;
       }
 
+      // Columns run in place on the output with a blocked strided kernel
+      // when that is cheaper than transposing them into rows and back
+      size_t columnSets = fftPlan->batchSize;
+
+      for (size_t index = 2; index < fftPlan->length.size(); index++) {
+        columnSets *= fftPlan->length[index];
+      }
+
+      fftPlan->stridedColumns =
+          (fftPlan->outStride[0] == 1) &&
+          (fftPlan->transposeType == HCFFT_NOTRANSPOSE) &&
+          BlockedColumnsPreferred(fftPlan, length1, length0, columnSets, 3.0);
+
       while (1 && (fftPlan->ipLayout != HCFFT_REAL) &&
              (fftPlan->opLayout != HCFFT_REAL)) {
         // break;
@@ -3646,6 +4680,10 @@ hcfftStatus FFTPlan::hcfftBakePlanInternal(hcfftPlanHandle plHandle) {
           break;
         }
 
+        if (fftPlan->stridedColumns) {
+          break;
+        }
+
         if (!(IsPo2(fftPlan->length[0])) || !(IsPo2(fftPlan->length[1]))) {
           break;
         }
@@ -4487,7 +5525,8 @@ hcfftStatus FFTPlan::hcfftBakePlanInternal(hcfftPlanHandle plHandle) {
           hcfftBakePlanInternal(fftPlan->planX);
         }
       } else {
-        if (fftPlan->tmpBufSize == 0 && fftPlan->length.size() <= 2) {
+        if (fftPlan->tmpBufSize == 0 && fftPlan->length.size() <= 2 &&
+            !fftPlan->stridedColumns) {
           fftPlan->tmpBufSize =
               length0 * length1 * fftPlan->batchSize * fftPlan->ElementSize();
         }
@@ -4500,7 +5539,8 @@ hcfftStatus FFTPlan::hcfftBakePlanInternal(hcfftPlanHandle plHandle) {
         fftRepo.getPlan(fftPlan->planX, rowPlan, rowLock);
         rowPlan->ipLayout = fftPlan->ipLayout;
 
-        if (fftPlan->large2D || fftPlan->length.size() > 2) {
+        if (fftPlan->stridedColumns || fftPlan->large2D ||
+            fftPlan->length.size() > 2) {
           rowPlan->opLayout = fftPlan->opLayout;
           rowPlan->location = fftPlan->location;
           rowPlan->outStride[0] = fftPlan->outStride[0];
@@ -4543,6 +5583,7 @@ hcfftStatus FFTPlan::hcfftBakePlanInternal(hcfftPlanHandle plHandle) {
         rowPlan->originalLength = fftPlan->originalLength;
         rowPlan->acc = fftPlan->acc;
         rowPlan->exist = fftPlan->exist;
+        InheritCallbacks(fftPlan, rowPlan, true, false);
         hcfftBakePlanInternal(fftPlan->planX);
         // create col plan
         hcfftCreateDefaultPlanInternal(&fftPlan->planY, HCFFT_1D,
@@ -4551,7 +5592,8 @@ hcfftStatus FFTPlan::hcfftBakePlanInternal(hcfftPlanHandle plHandle) {
         lockRAII* colLock = NULL;
         fftRepo.getPlan(fftPlan->planY, colPlan, colLock);
 
-        if (fftPlan->large2D || fftPlan->length.size() > 2) {
+        if (fftPlan->stridedColumns || fftPlan->large2D ||
+            fftPlan->length.size() > 2) {
           colPlan->ipLayout = fftPlan->opLayout;
           colPlan->location = HCFFT_INPLACE;
           colPlan->inStride[0] = fftPlan->outStride[1];
@@ -4592,10 +5634,17 @@ hcfftStatus FFTPlan::hcfftBakePlanInternal(hcfftPlanHandle plHandle) {
           colPlan->outStride.push_back(fftPlan->outStride[2]);
         }
 
+        // Load blocks of neighbouring columns with coalesced row segments
+        if (fftPlan->stridedColumns) {
+          colPlan->blockCompute = true;
+          colPlan->blockComputeType = BCT_C2C;
+        }
+
         colPlan->hcfftlibtype = fftPlan->hcfftlibtype;
         colPlan->originalLength = fftPlan->originalLength;
         colPlan->acc = fftPlan->acc;
         colPlan->exist = fftPlan->exist;
+        InheritCallbacks(fftPlan, colPlan, false, true);
         hcfftBakePlanInternal(fftPlan->planY);
       }
 
@@ -5275,6 +6324,8 @@ hcfftStatus FFTPlan::hcfftBakePlanInternal(hcfftPlanHandle plHandle) {
         xyPlan->originalLength = fftPlan->originalLength;
         xyPlan->acc = fftPlan->acc;
         xyPlan->exist = fftPlan->exist;
+        xyPlan->columnMethod = fftPlan->columnMethod;
+        InheritCallbacks(fftPlan, xyPlan, true, false);
         hcfftBakePlanInternal(fftPlan->planX);
         hcLengths[0] = fftPlan->length[2];
         hcLengths[1] = hcLengths[2] = 0;
@@ -5309,10 +6360,27 @@ hcfftStatus FFTPlan::hcfftBakePlanInternal(hcfftPlanHandle plHandle) {
         colPlan->outStride.push_back(fftPlan->outStride[1]);
         colPlan->iDist = fftPlan->oDist;
         colPlan->oDist = fftPlan->oDist;
+
+        // Depth columns are strided whichever way they are computed; the
+        // unblocked kernel moves a single element per row segment
+        double unblockedCost = std::max(
+            1.0, static_cast<double>(ARBITRARY::TRANSACTION_BYTES) /
+                     fftPlan->ElementSize());
+
+        if ((fftPlan->outStride[0] == 1) &&
+            BlockedColumnsPreferred(fftPlan, fftPlan->length[2],
+                                    fftPlan->length[0],
+                                    fftPlan->length[1] * fftPlan->batchSize,
+                                    unblockedCost)) {
+          colPlan->blockCompute = true;
+          colPlan->blockComputeType = BCT_C2C;
+        }
+
         colPlan->hcfftlibtype = fftPlan->hcfftlibtype;
         colPlan->originalLength = fftPlan->originalLength;
         colPlan->acc = fftPlan->acc;
         colPlan->exist = fftPlan->exist;
+        InheritCallbacks(fftPlan, colPlan, false, true);
         hcfftBakePlanInternal(fftPlan->planZ);
       }
 
@@ -5405,6 +6473,31 @@ hcfftStatus FFTPlan::hcfftSetPlanScale(hcfftPlanHandle plHandle,
   return HCFFT_SUCCEEDS;
 }
 
+hcfftStatus FFTPlan::hcfftSetPlanCallback(hcfftPlanHandle plHandle,
+                                          const char* source, bool store,
+                                          void* callerInfo) {
+  FFTRepo& fftRepo = FFTRepo::getInstance();
+  FFTPlan* fftPlan = NULL;
+  lockRAII* planLock = NULL;
+  fftRepo.getPlan(plHandle, fftPlan, planLock);
+  scopedLock sLock(*planLock, _T(" hcfftSetPlanCallback"));
+  //  The callback source is compiled into the kernels, so the plan has to be
+  //  baked and loaded again
+  fftPlan->baked = false;
+  fftPlan->transformed = false;
+  std::string src = source ? source : "";
+
+  if (store) {
+    fftPlan->storeCallback = src;
+    fftPlan->storeCallbackInfo = src.empty() ? NULL : callerInfo;
+  } else {
+    fftPlan->loadCallback = src;
+    fftPlan->loadCallbackInfo = src.empty() ? NULL : callerInfo;
+  }
+
+  return HCFFT_SUCCEEDS;
+}
+
 hcfftStatus FFTPlan::hcfftGetPlanBatchSize(const hcfftPlanHandle plHandle,
                                            size_t* batchsize) {
   FFTRepo& fftRepo = FFTRepo::getInstance();
@@ -5448,8 +6541,9 @@ hcfftStatus FFTPlan::hcfftGetPlanDim(const hcfftPlanHandle plHandle,
       *size = 2;
     } break;
 
+    // Plans above 3 dimensions are HCFFT_3D too
     case HCFFT_3D: {
-      *size = 3;
+      *size = static_cast<int>(fftPlan->Rank());
     } break;
 
     default:
@@ -5461,7 +6555,7 @@ hcfftStatus FFTPlan::hcfftGetPlanDim(const hcfftPlanHandle plHandle,
 }
 
 hcfftStatus FFTPlan::hcfftSetPlanDim(hcfftPlanHandle plHandle,
-                                     const hcfftDim dim) {
+                                     const size_t rank) {
   FFTRepo& fftRepo = FFTRepo::getInstance();
   FFTPlan* fftPlan = NULL;
   lockRAII* planLock = NULL;
@@ -5470,7 +6564,7 @@ hcfftStatus FFTPlan::hcfftSetPlanDim(hcfftPlanHandle plHandle,
 
   // We resize the vectors in the plan to keep their sizes consistent with the
   // value of the dimension
-  switch (dim) {
+  switch (rank) {
     case HCFFT_1D: {
       fftPlan->length.resize(1);
       fftPlan->inStride.resize(1);
@@ -5489,20 +6583,26 @@ hcfftStatus FFTPlan::hcfftSetPlanDim(hcfftPlanHandle plHandle,
       fftPlan->outStride.resize(3);
     } break;
 
-    default:
-      return HCFFT_ERROR;
-      break;
+    default: {
+      if (rank == 0 || rank > HCFFT_MAXDIM) {
+        return HCFFT_ERROR;
+      }
+
+      fftPlan->length.resize(rank);
+      fftPlan->inStride.resize(rank);
+      fftPlan->outStride.resize(rank);
+    } break;
   }
 
   //  If we modify the state of the plan, we assume that we can't trust any
   //  pre-calculated contents anymore
   fftPlan->baked = false;
-  fftPlan->dimension = dim;
+  fftPlan->dimension = DimOfRank(rank);
   return HCFFT_SUCCEEDS;
 }
 
 hcfftStatus FFTPlan::hcfftGetPlanLength(const hcfftPlanHandle plHandle,
-                                        const hcfftDim dim, size_t* hcLengths) {
+                                        const size_t rank, size_t* hcLengths) {
   FFTRepo& fftRepo = FFTRepo::getInstance();
   FFTPlan* fftPlan = NULL;
   lockRAII* planLock = NULL;
@@ -5517,7 +6617,7 @@ hcfftStatus FFTPlan::hcfftGetPlanLength(const hcfftPlanHandle plHandle,
     return HCFFT_ERROR;
   }
 
-  switch (dim) {
+  switch (rank) {
     case HCFFT_1D: {
       hcLengths[0] = fftPlan->length[0];
     } break;
@@ -5541,16 +6641,22 @@ hcfftStatus FFTPlan::hcfftGetPlanLength(const hcfftPlanHandle plHandle,
       hcLengths[2] = fftPlan->length[2];
     } break;
 
-    default:
-      return HCFFT_ERROR;
-      break;
+    default: {
+      if (rank > HCFFT_MAXDIM || fftPlan->length.size() < rank) {
+        return HCFFT_ERROR;
+      }
+
+      for (size_t i = 0; i < rank; i++) {
+        hcLengths[i] = fftPlan->length[i];
+      }
+    } break;
   }
 
   return HCFFT_SUCCEEDS;
 }
 
 hcfftStatus FFTPlan::hcfftSetPlanLength(hcfftPlanHandle plHandle,
-                                        const hcfftDim dim,
+                                        const size_t rank,
                                         const size_t* hcLengths) {
   FFTRepo& fftRepo = FFTRepo::getInstance();
   FFTPlan* fftPlan = NULL;
@@ -5566,7 +6672,7 @@ hcfftStatus FFTPlan::hcfftSetPlanLength(hcfftPlanHandle plHandle,
   //  shrink dimension
   fftPlan->length.clear();
 
-  switch (dim) {
+  switch (rank) {
     case HCFFT_1D: {
       //  Minimum length size is 1
       if (hcLengths[0] == 0) {
@@ -5597,12 +6703,23 @@ hcfftStatus FFTPlan::hcfftSetPlanLength(hcfftPlanHandle plHandle,
       fftPlan->length.push_back(hcLengths[2]);
     } break;
 
-    default:
-      return HCFFT_ERROR;
-      break;
+    default: {
+      if (rank == 0 || rank > HCFFT_MAXDIM) {
+        return HCFFT_ERROR;
+      }
+
+      //  Minimum length size is 1
+      for (size_t i = 0; i < rank; i++) {
+        if (hcLengths[i] == 0) {
+          return HCFFT_ERROR;
+        }
+
+        fftPlan->length.push_back(hcLengths[i]);
+      }
+    } break;
   }
 
-  fftPlan->dimension = dim;
+  fftPlan->dimension = DimOfRank(rank);
   //  If we modify the state of the plan, we assume that we can't trust any
   //  pre-calculated contents anymore
   fftPlan->baked = false;
@@ -5610,7 +6727,7 @@ hcfftStatus FFTPlan::hcfftSetPlanLength(hcfftPlanHandle plHandle,
 }
 
 hcfftStatus FFTPlan::hcfftGetPlanInStride(const hcfftPlanHandle plHandle,
-                                          const hcfftDim dim,
+                                          const size_t rank,
                                           size_t* hcStrides) {
   FFTRepo& fftRepo = FFTRepo::getInstance();
   FFTPlan* fftPlan = NULL;
@@ -5622,7 +6739,7 @@ hcfftStatus FFTPlan::hcfftGetPlanInStride(const hcfftPlanHandle plHandle,
     return HCFFT_ERROR;
   }
 
-  switch (dim) {
+  switch (rank) {
     case HCFFT_1D: {
       if (fftPlan->inStride.size() > 0) {
         hcStrides[0] = fftPlan->inStride[0];
@@ -5650,16 +6767,22 @@ hcfftStatus FFTPlan::hcfftGetPlanInStride(const hcfftPlanHandle plHandle,
       }
     } break;
 
-    default:
-      return HCFFT_ERROR;
-      break;
+    default: {
+      if (rank > HCFFT_MAXDIM || fftPlan->inStride.size() < rank) {
+        return HCFFT_ERROR;
+      }
+
+      for (size_t i = 0; i < rank; i++) {
+        hcStrides[i] = fftPlan->inStride[i];
+      }
+    } break;
   }
 
   return HCFFT_SUCCEEDS;
 }
 
 hcfftStatus FFTPlan::hcfftSetPlanInStride(hcfftPlanHandle plHandle,
-                                          const hcfftDim dim,
+                                          const size_t rank,
                                           size_t* hcStrides) {
   FFTRepo& fftRepo = FFTRepo::getInstance();
   FFTPlan* fftPlan = NULL;
@@ -5675,7 +6798,7 @@ hcfftStatus FFTPlan::hcfftSetPlanInStride(hcfftPlanHandle plHandle,
   //  shrink dimension
   fftPlan->inStride.clear();
 
-  switch (dim) {
+  switch (rank) {
     case HCFFT_1D: {
       fftPlan->inStride.push_back(hcStrides[0]);
     } break;
@@ -5691,9 +6814,15 @@ hcfftStatus FFTPlan::hcfftSetPlanInStride(hcfftPlanHandle plHandle,
       fftPlan->inStride.push_back(hcStrides[2]);
     } break;
 
-    default:
-      return HCFFT_ERROR;
-      break;
+    default: {
+      if (rank == 0 || rank > HCFFT_MAXDIM) {
+        return HCFFT_ERROR;
+      }
+
+      for (size_t i = 0; i < rank; i++) {
+        fftPlan->inStride.push_back(hcStrides[i]);
+      }
+    } break;
   }
 
   //  If we modify the state of the plan, we assume that we can't trust any
@@ -5703,7 +6832,7 @@ hcfftStatus FFTPlan::hcfftSetPlanInStride(hcfftPlanHandle plHandle,
 }
 
 hcfftStatus FFTPlan::hcfftGetPlanOutStride(const hcfftPlanHandle plHandle,
-                                           const hcfftDim dim,
+                                           const size_t rank,
                                            size_t* hcStrides) {
   FFTRepo& fftRepo = FFTRepo::getInstance();
   FFTPlan* fftPlan = NULL;
@@ -5715,7 +6844,7 @@ hcfftStatus FFTPlan::hcfftGetPlanOutStride(const hcfftPlanHandle plHandle,
     return HCFFT_ERROR;
   }
 
-  switch (dim) {
+  switch (rank) {
     case HCFFT_1D: {
       if (fftPlan->outStride.size() > 0) {
         hcStrides[0] = fftPlan->outStride[0];
@@ -5743,16 +6872,22 @@ hcfftStatus FFTPlan::hcfftGetPlanOutStride(const hcfftPlanHandle plHandle,
       }
     } break;
 
-    default:
-      return HCFFT_ERROR;
-      break;
+    default: {
+      if (rank > HCFFT_MAXDIM || fftPlan->outStride.size() < rank) {
+        return HCFFT_ERROR;
+      }
+
+      for (size_t i = 0; i < rank; i++) {
+        hcStrides[i] = fftPlan->outStride[i];
+      }
+    } break;
   }
 
   return HCFFT_SUCCEEDS;
 }
 
 hcfftStatus FFTPlan::hcfftSetPlanOutStride(hcfftPlanHandle plHandle,
-                                           const hcfftDim dim,
+                                           const size_t rank,
                                            size_t* hcStrides) {
   FFTRepo& fftRepo = FFTRepo::getInstance();
   FFTPlan* fftPlan = NULL;
@@ -5764,7 +6899,7 @@ hcfftStatus FFTPlan::hcfftSetPlanOutStride(hcfftPlanHandle plHandle,
     return HCFFT_ERROR;
   }
 
-  switch (dim) {
+  switch (rank) {
     case HCFFT_1D: {
       fftPlan->outStride[0] = hcStrides[0];
     } break;
@@ -5780,9 +6915,17 @@ hcfftStatus FFTPlan::hcfftSetPlanOutStride(hcfftPlanHandle plHandle,
       fftPlan->outStride[2] = hcStrides[2];
     } break;
 
-    default:
-      return HCFFT_ERROR;
-      break;
+    default: {
+      if (rank == 0 || rank > HCFFT_MAXDIM) {
+        return HCFFT_ERROR;
+      }
+
+      fftPlan->outStride.resize(rank);
+
+      for (size_t i = 0; i < rank; i++) {
+        fftPlan->outStride[i] = hcStrides[i];
+      }
+    } break;
   }
 
   //  If we modify the state of the plan, we assume that we can't trust any
@@ -5924,6 +7067,128 @@ hcfftStatus FFTPlan::hcfftSetResultLocation(hcfftPlanHandle plHandle,
   return HCFFT_SUCCEEDS;
 }
 
+// Bring the placement variant of a user plan in line with its settings. It
+// bakes lazily on first use.
+static void SyncPlacementPlan(const FFTPlan* fftPlan, FFTPlan* variant) {
+  variant->dimension = fftPlan->dimension;
+  variant->length = fftPlan->length;
+  variant->inStride = fftPlan->inStride;
+  variant->outStride = fftPlan->outStride;
+  variant->iDist = fftPlan->iDist;
+  variant->oDist = fftPlan->oDist;
+  variant->batchSize = fftPlan->batchSize;
+  variant->ipLayout = fftPlan->ipLayout;
+  variant->opLayout = fftPlan->opLayout;
+  variant->direction = fftPlan->direction;
+  variant->location = (fftPlan->location == HCFFT_INPLACE) ? HCFFT_OUTOFPLACE
+                                                           : HCFFT_INPLACE;
+  variant->transposeType = fftPlan->transposeType;
+  variant->columnMethod = fftPlan->columnMethod;
+  variant->precision = fftPlan->precision;
+  variant->forwardScale = fftPlan->forwardScale;
+  variant->backwardScale = fftPlan->backwardScale;
+  variant->gen = fftPlan->gen;
+  variant->envelope = fftPlan->envelope;
+  variant->acc = fftPlan->acc;
+  variant->acc_view = fftPlan->acc_view;
+  variant->originalLength = fftPlan->originalLength;
+  variant->hcfftlibtype = fftPlan->hcfftlibtype;
+  variant->loadCallback = fftPlan->loadCallback;
+  variant->storeCallback = fftPlan->storeCallback;
+  variant->loadCallbackInfo = fftPlan->loadCallbackInfo;
+  variant->storeCallbackInfo = fftPlan->storeCallbackInfo;
+  variant->userPlan = true;
+  variant->baked = false;
+  variant->transformed = false;
+}
+
+// Resolve the baked plan that executes the requested placement and layout.
+// A user plan is baked for the placement of its first execution, the other
+// placement goes to placementPlan. Once both are baked execution does no
+// planning work, whichever placement it asks for.
+hcfftStatus FFTPlan::hcfftGetExecPlan(hcfftPlanHandle plHandle,
+                                      hcfftResLocation placeness,
+                                      hcfftIpLayout iLayout,
+                                      hcfftOpLayout oLayout,
+                                      hcfftPlanHandle* execHandle) {
+  FFTRepo& fftRepo = FFTRepo::getInstance();
+  FFTPlan* fftPlan = NULL;
+  lockRAII* planLock = NULL;
+  fftRepo.getPlan(plHandle, fftPlan, planLock);
+  scopedLock sLock(*planLock, _T(" hcfftGetExecPlan"));
+  hcfftStatus status = HCFFT_SUCCEEDS;
+
+  if (fftPlan->ipLayout != iLayout || fftPlan->opLayout != oLayout) {
+    status = hcfftSetLayout(plHandle, iLayout, oLayout);
+
+    if (status != HCFFT_SUCCEEDS) {
+      return status;
+    }
+
+    fftPlan->baked = false;
+  }
+
+  if (fftPlan->RunsOnHost(false)) {
+    // Host execution bakes nothing and takes either placement
+    fftPlan->location = placeness;
+    *execHandle = plHandle;
+    return HCFFT_SUCCEEDS;
+  }
+
+  if (fftPlan->baked == false) {
+    // Either the first execution or the settings changed since the last one
+    fftPlan->location = placeness;
+    status = hcfftBakePlan(plHandle);
+
+    if (status != HCFFT_SUCCEEDS) {
+      return status;
+    }
+
+    if (fftPlan->placementPlan) {
+      FFTPlan* variant = NULL;
+      lockRAII* variantLock = NULL;
+      fftRepo.getPlan(fftPlan->placementPlan, variant, variantLock);
+      scopedLock vLock(*variantLock, _T(" hcfftGetExecPlan"));
+      SyncPlacementPlan(fftPlan, variant);
+    }
+  }
+
+  if (fftPlan->location == placeness) {
+    *execHandle = plHandle;
+    return HCFFT_SUCCEEDS;
+  }
+
+  FFTPlan* variant = NULL;
+  lockRAII* variantLock = NULL;
+
+  if (fftPlan->placementPlan == 0) {
+    status = hcfftCreateDefaultPlanInternal(
+        &fftPlan->placementPlan, fftPlan->Rank(), &fftPlan->length[0]);
+
+    if (status != HCFFT_SUCCEEDS) {
+      return status;
+    }
+
+    fftRepo.getPlan(fftPlan->placementPlan, variant, variantLock);
+    // Kernels of the variant go to their own library
+    variant->plHandleOrigin = fftPlan->placementPlan;
+    SyncPlacementPlan(fftPlan, variant);
+  } else {
+    fftRepo.getPlan(fftPlan->placementPlan, variant, variantLock);
+  }
+
+  // The stream may have moved without invalidating the bake
+  variant->acc_view = fftPlan->acc_view;
+  status = hcfftBakePlan(fftPlan->placementPlan);
+
+  if (status != HCFFT_SUCCEEDS) {
+    return status;
+  }
+
+  *execHandle = fftPlan->placementPlan;
+  return HCFFT_SUCCEEDS;
+}
+
 hcfftStatus FFTPlan::hcfftGetPlanTransposeResult(
     const hcfftPlanHandle plHandle, hcfftResTransposed* transposed) {
   FFTRepo& fftRepo = FFTRepo::getInstance();
@@ -5949,9 +7214,187 @@ hcfftStatus FFTPlan::hcfftSetPlanTransposeResult(
   return HCFFT_SUCCEEDS;
 }
 
+hcfftStatus FFTPlan::hcfftGetPlanColumnMethod(const hcfftPlanHandle plHandle,
+                                              hcfftColumnMethod* method) {
+  FFTRepo& fftRepo = FFTRepo::getInstance();
+  FFTPlan* fftPlan = NULL;
+  lockRAII* planLock = NULL;
+  fftRepo.getPlan(plHandle, fftPlan, planLock);
+  scopedLock sLock(*planLock, _T(" hcfftGetPlanColumnMethod"));
+  *method = fftPlan->columnMethod;
+  return HCFFT_SUCCEEDS;
+}
+
+hcfftStatus FFTPlan::hcfftSetPlanColumnMethod(hcfftPlanHandle plHandle,
+                                              hcfftColumnMethod method) {
+  FFTRepo& fftRepo = FFTRepo::getInstance();
+  FFTPlan* fftPlan = NULL;
+  lockRAII* planLock = NULL;
+  fftRepo.getPlan(plHandle, fftPlan, planLock);
+  scopedLock sLock(*planLock, _T(" hcfftSetPlanColumnMethod"));
+  //  The column method decides how the plan is decomposed
+  fftPlan->baked = false;
+  fftPlan->columnMethod = method;
+  return HCFFT_SUCCEEDS;
+}
+
+hcfftStatus FFTPlan::hcfftGetPlanStreamMemory(const hcfftPlanHandle plHandle,
+                                              size_t* bytes) {
+  FFTRepo& fftRepo = FFTRepo::getInstance();
+  FFTPlan* fftPlan = NULL;
+  lockRAII* planLock = NULL;
+  fftRepo.getPlan(plHandle, fftPlan, planLock);
+  scopedLock sLock(*planLock, _T(" hcfftGetPlanStreamMemory"));
+  *bytes = fftPlan->streamMemory;
+  return HCFFT_SUCCEEDS;
+}
+
+hcfftStatus FFTPlan::hcfftSetPlanStreamMemory(hcfftPlanHandle plHandle,
+                                              size_t bytes) {
+  FFTRepo& fftRepo = FFTRepo::getInstance();
+  FFTPlan* fftPlan = NULL;
+  lockRAII* planLock = NULL;
+  fftRepo.getPlan(plHandle, fftPlan, planLock);
+  scopedLock sLock(*planLock, _T(" hcfftSetPlanStreamMemory"));
+  //  Only the chunking of out-of-core execution depends on the budget, the
+  //  in-core bake stays valid
+  fftPlan->streamMemory = bytes;
+  return HCFFT_SUCCEEDS;
+}
+
+hcfftStatus FFTPlan::hcfftSetPlanDeviceSet(hcfftPlanHandle plHandle,
+                                           FFTDeviceSet* devices) {
+  FFTRepo& fftRepo = FFTRepo::getInstance();
+  FFTPlan* fftPlan = NULL;
+  lockRAII* planLock = NULL;
+  fftRepo.getPlan(plHandle, fftPlan, planLock);
+  scopedLock sLock(*planLock, _T(" hcfftSetPlanDeviceSet"));
+
+  //  Device plans are bound to the accelerators of the previous set
+  for (size_t i = 0; i < fftPlan->devicePlans.size(); i++) {
+    if (fftPlan->devicePlans[i]) {
+      hcfftDestroyPlan(&fftPlan->devicePlans[i]);
+    }
+  }
+
+  fftPlan->devicePlans.clear();
+  std::map<std::vector<size_t>, hcfftPlanHandle>::iterator it =
+      fftPlan->streamPlans.begin();
+
+  //  So are the slab plans of distributed transforms
+  while (it != fftPlan->streamPlans.end()) {
+    if (it->first[0] == STREAM_SLAB_PLAN) {
+      hcfftDestroyPlan(&it->second);
+      fftPlan->streamPlans.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+
+  delete fftPlan->deviceSet;
+  fftPlan->deviceSet = devices;
+  return HCFFT_SUCCEEDS;
+}
+
+hcfftStatus FFTPlan::hcfftSetPlanExchange(hcfftPlanHandle plHandle,
+                                          FFTExchange* transport) {
+  FFTRepo& fftRepo = FFTRepo::getInstance();
+  FFTPlan* fftPlan = NULL;
+  lockRAII* planLock = NULL;
+  fftRepo.getPlan(plHandle, fftPlan, planLock);
+  scopedLock sLock(*planLock, _T(" hcfftSetPlanExchange"));
+  delete fftPlan->exchange;
+  fftPlan->exchange = transport;
+  return HCFFT_SUCCEEDS;
+}
+
+hcfftStatus FFTPlan::hcfftGetPlanBackend(const hcfftPlanHandle plHandle,
+                                         hcfftBackend* backend) {
+  FFTRepo& fftRepo = FFTRepo::getInstance();
+  FFTPlan* fftPlan = NULL;
+  lockRAII* planLock = NULL;
+  fftRepo.getPlan(plHandle, fftPlan, planLock);
+  scopedLock sLock(*planLock, _T(" hcfftGetPlanBackend"));
+  *backend = fftPlan->backend;
+  return HCFFT_SUCCEEDS;
+}
+
+hcfftStatus FFTPlan::hcfftSetPlanBackend(hcfftPlanHandle plHandle,
+                                         hcfftBackend backend) {
+  FFTRepo& fftRepo = FFTRepo::getInstance();
+  FFTPlan* fftPlan = NULL;
+  lockRAII* planLock = NULL;
+  fftRepo.getPlan(plHandle, fftPlan, planLock);
+  scopedLock sLock(*planLock, _T(" hcfftSetPlanBackend"));
+  //  Host plans are not baked, the accelerator needs a fresh bake
+  fftPlan->baked = false;
+  fftPlan->backend = backend;
+  return HCFFT_SUCCEEDS;
+}
+
+hcfftStatus FFTPlan::hcfftGetPlanCost(hcfftPlanHandle plHandle,
+                                      const FFTRoofline& roofline,
+                                      std::vector<FFTKernelCost>* costs) {
+  FFTRepo& fftRepo = FFTRepo::getInstance();
+  FFTPlan* fftPlan = NULL;
+  lockRAII* planLock = NULL;
+  fftRepo.getPlan(plHandle, fftPlan, planLock);
+  scopedLock sLock(*planLock, _T(" hcfftGetPlanCost"));
+
+  //  The kernels are only known once the plan is baked
+  if (fftPlan->baked == false) {
+    hcfftStatus status = hcfftBakePlan(plHandle);
+
+    if (status != HCFFT_SUCCEEDS) {
+      return status;
+    }
+  }
+
+  costs->clear();
+  return CollectKernelCosts(plHandle, roofline, costs);
+}
+
+hcfftStatus FFTPlan::hcfftExplainPlan(hcfftPlanHandle plHandle,
+                                      FFTPlanNode* root) {
+  FFTRepo& fftRepo = FFTRepo::getInstance();
+  FFTPlan* fftPlan = NULL;
+  lockRAII* planLock = NULL;
+  fftRepo.getPlan(plHandle, fftPlan, planLock);
+  scopedLock sLock(*planLock, _T(" hcfftExplainPlan"));
+
+  //  The decomposition is only decided when the plan is baked
+  if (fftPlan->baked == false) {
+    hcfftStatus status = hcfftBakePlan(plHandle);
+
+    if (status != HCFFT_SUCCEEDS) {
+      return status;
+    }
+  }
+
+  *root = FFTPlanNode();
+  return ExplainPlanTree(plHandle, "plan", root);
+}
+
+hcfftStatus FFTPlan::hcfftGetPlanBakeTimes(hcfftPlanHandle plHandle,
+                                           FFTBakeTimes* times) {
+  FFTRepo& fftRepo = FFTRepo::getInstance();
+  FFTPlan* fftPlan = NULL;
+  lockRAII* planLock = NULL;
+
+  if (fftRepo.getPlan(plHandle, fftPlan, planLock) != HCFFT_SUCCEEDS) {
+    return HCFFT_INVALID;
+  }
+
+  scopedLock sLock(*planLock, _T(" hcfftGetPlanBakeTimes"));
+  *times = FFTBakeTimes();
+  CollectBakeTimes(plHandle, times);
+  return HCFFT_SUCCEEDS;
+}
+
 hcfftStatus FFTPlan::GetMax1DLength(size_t* longest) const {
   switch (gen) {
     case Stockham:
+    case Stockham_LDS:
       return GetMax1DLengthPvt<Stockham>(longest);
 
     case Copy: {
@@ -5987,6 +7430,9 @@ hcfftStatus FFTPlan::GetKernelGenKey(FFTKernelGenKeyParams& params) const {
     case Copy:
       return GetKernelGenKeyPvt<Copy>(params);
 
+    case Stockham_LDS:
+      return GetKernelGenKeyPvt<Stockham_LDS>(params);
+
     case Transpose_GCN:
       return GetKernelGenKeyPvt<Transpose_GCN>(params);
 
@@ -6010,6 +7456,12 @@ hcfftStatus FFTPlan::GetWorkSizes(std::vector<size_t>& globalws,
     case Copy:
       return GetWorkSizesPvt<Copy>(globalws, localws);
 
+    case Stockham_LDS:
+      return GetWorkSizesPvt<Stockham_LDS>(globalws, localws);
+
+    case Stockham_Library:
+      return GetWorkSizesPvt<Stockham_Library>(globalws, localws);
+
     case Transpose_GCN:
       return GetWorkSizesPvt<Transpose_GCN>(globalws, localws);
 
@@ -6024,9 +7476,39 @@ hcfftStatus FFTPlan::GetWorkSizes(std::vector<size_t>& globalws,
   }
 }
 
+hcfftStatus FFTPlan::GetKernelCost(FFTKernelCost* cost) const {
+  switch (gen) {
+    case Stockham:
+      return GetKernelCostPvt<Stockham>(cost);
+
+    case Copy:
+      return GetKernelCostPvt<Copy>(cost);
+
+    case Stockham_LDS:
+      return GetKernelCostPvt<Stockham_LDS>(cost);
+
+    case Stockham_Library:
+      return GetKernelCostPvt<Stockham_Library>(cost);
+
+    case Transpose_GCN:
+      return GetKernelCostPvt<Transpose_GCN>(cost);
+
+    case Transpose_NONSQUARE:
+      return GetKernelCostPvt<Transpose_NONSQUARE>(cost);
+
+    case Transpose_SQUARE:
+      return GetKernelCostPvt<Transpose_SQUARE>(cost);
+
+    default:
+      return HCFFT_ERROR;
+  }
+}
+
 hcfftStatus FFTPlan::GenerateKernel(const hcfftPlanHandle plHandle,
                                     FFTRepo& fftRepo, size_t count,
                                     bool exist) const {
+  FFTBakeTimer timer(BAKE_GENERATE);
+
   switch (gen) {
     case Stockham:
       return GenerateKernelPvt<Stockham>(plHandle, fftRepo, count, exist);
@@ -6034,6 +7516,9 @@ hcfftStatus FFTPlan::GenerateKernel(const hcfftPlanHandle plHandle,
     case Copy:
       return GenerateKernelPvt<Copy>(plHandle, fftRepo, count, exist);
 
+    case Stockham_LDS:
+      return GenerateKernelPvt<Stockham_LDS>(plHandle, fftRepo, count, exist);
+
     case Transpose_GCN:
       return GenerateKernelPvt<Transpose_GCN>(plHandle, fftRepo, count, exist);
 
@@ -6093,6 +7578,36 @@ hcfftStatus FFTPlan::hcfftDestroyPlan(hcfftPlanHandle* plHandle) {
     hcfftDestroyPlan(&fftPlan->planCopy);
   }
 
+  for (size_t i = 0; i < fftPlan->axisPlans.size(); i++) {
+    hcfftDestroyPlan(&fftPlan->axisPlans[i]);
+  }
+
+  fftPlan->axisPlans.clear();
+
+  for (std::map<std::vector<size_t>, hcfftPlanHandle>::iterator it =
+           fftPlan->streamPlans.begin();
+       it != fftPlan->streamPlans.end(); ++it) {
+    hcfftDestroyPlan(&it->second);
+  }
+
+  fftPlan->streamPlans.clear();
+
+  for (size_t i = 0; i < fftPlan->devicePlans.size(); i++) {
+    if (fftPlan->devicePlans[i]) {
+      hcfftDestroyPlan(&fftPlan->devicePlans[i]);
+    }
+  }
+
+  fftPlan->devicePlans.clear();
+  delete fftPlan->deviceSet;
+  fftPlan->deviceSet = NULL;
+  delete fftPlan->exchange;
+  fftPlan->exchange = NULL;
+
+  if (fftPlan->placementPlan) {
+    hcfftDestroyPlan(&fftPlan->placementPlan);
+  }
+
   fftPlan->ReleaseBuffers();
 
   if (kernelHandle) {
@@ -6137,6 +7652,18 @@ hcfftStatus FFTPlan::ReleaseBuffers() {
     intBufferC2R = NULL;
   }
 
+  FFTMetrics::Add(METRIC_SCRATCH_BYTES, -static_cast<int64_t>(scratchBytes));
+  scratchBytes = 0;
+
+  if (NULL != stagingBuffer) {
+    if (hc::am_free(stagingBuffer) != AM_SUCCESS) {
+      return HCFFT_INVALID;
+    }
+
+    stagingBuffer = NULL;
+    stagingBufSize = 0;
+  }
+
   if (NULL != twiddles) {
     if (hc::am_free(twiddles) != AM_SUCCESS) {
       return HCFFT_INVALID;
@@ -6157,10 +7684,281 @@ hcfftStatus FFTPlan::ReleaseBuffers() {
 }
 
 size_t FFTPlan::ElementSize() const {
+  if (precision == HCFFT_HALF) {
+    // Two fp16 components
+    return 2 * sizeof(short);
+  }
+
   return ((precision == HCFFT_DOUBLE) ? sizeof(std::complex<double>)
                                       : sizeof(std::complex<float>));
 }
 
+double FFTPlan::LayoutBytes(hcfftIpLayout layout, double elements) const {
+  double bytes = elements * ElementSize();
+  return (layout == HCFFT_REAL) ? bytes / 2 : bytes;
+}
+
+double FFTRoofline::Seconds(const FFTKernelCost& cost,
+                            hcfftPrecision precision) const {
+  double gflops = (precision == HCFFT_DOUBLE) ? doubleGflops : singleGflops;
+  double compute = cost.flops / (gflops * 1.0e9);
+  double memory = (cost.bytesRead + cost.bytesWritten) / (memoryGBs * 1.0e9);
+  double lds = cost.ldsBytes / (ldsGBs * 1.0e9);
+  return launchUs * 1.0e-6 + std::max(compute, std::max(memory, lds));
+}
+
+// Names the JSON of hcfftExplainPlan gives the plan enumerations
+const char* GeneratorName(hcfftGenerators gen) {
+  switch (gen) {
+    case Stockham:
+      return "Stockham";
+
+    case Transpose_GCN:
+      return "Transpose_GCN";
+
+    case Transpose_SQUARE:
+      return "Transpose_SQUARE";
+
+    case Transpose_NONSQUARE:
+      return "Transpose_NONSQUARE";
+
+    case Copy:
+      return "Copy";
+
+    case Stockham_LDS:
+      return "Stockham_LDS";
+
+    case Stockham_Library:
+      return "Stockham_Library";
+
+    default:
+      return "unknown";
+  }
+}
+
+static const char* LayoutName(hcfftIpLayout layout) {
+  switch (layout) {
+    case HCFFT_COMPLEX_INTERLEAVED:
+      return "complex_interleaved";
+
+    case HCFFT_COMPLEX_PLANAR:
+      return "complex_planar";
+
+    case HCFFT_HERMITIAN_INTERLEAVED:
+      return "hermitian_interleaved";
+
+    case HCFFT_HERMITIAN_PLANAR:
+      return "hermitian_planar";
+
+    case HCFFT_REAL:
+      return "real";
+
+    default:
+      return "unknown";
+  }
+}
+
+const char* PrecisionName(hcfftPrecision precision) {
+  switch (precision) {
+    case HCFFT_SINGLE:
+      return "single";
+
+    case HCFFT_DOUBLE:
+      return "double";
+
+    case HCFFT_HALF:
+      return "half";
+
+    default:
+      return "unknown";
+  }
+}
+
+static const char* DirectionName(hcfftDirection direction) {
+  switch (direction) {
+    case HCFFT_FORWARD:
+      return "forward";
+
+    case HCFFT_BACKWARD:
+      return "backward";
+
+    default:
+      return "both";
+  }
+}
+
+static const char* BackendName(hcfftBackend backend) {
+  switch (backend) {
+    case HCFFT_BACKEND_ACCELERATOR:
+      return "accelerator";
+
+    case HCFFT_BACKEND_HOST:
+      return "host";
+
+    default:
+      return "auto";
+  }
+}
+
+static const char* BlockComputeName(BlockComputeType type) {
+  switch (type) {
+    case BCT_C2R:
+      return "column_to_row";
+
+    case BCT_R2C:
+      return "row_to_column";
+
+    default:
+      return "column_to_column";
+  }
+}
+
+// Append '"key": ' on a new line indented by indent
+static void JsonKey(std::string* json, size_t indent, const char* key,
+                    bool first = false) {
+  *json += first ? "\n" : ",\n";
+  json->append(indent, ' ');
+  *json += "\"";
+  *json += key;
+  *json += "\": ";
+}
+
+static std::string JsonString(const std::string& value) {
+  return "\"" + value + "\"";
+}
+
+static std::string JsonNumber(double value) {
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "%.15g", value);
+  return buffer;
+}
+
+static std::string JsonBool(bool value) { return value ? "true" : "false"; }
+
+static std::string JsonSizes(const std::vector<size_t>& values) {
+  std::string json = "[";
+
+  for (size_t i = 0; i < values.size(); i++) {
+    json += (i == 0 ? "" : ", ") + std::to_string(values[i]);
+  }
+
+  return json + "]";
+}
+
+static void JsonPlanNode(const FFTPlanNode& node, size_t indent,
+                         std::string* json) {
+  size_t in = indent + 2;
+  *json += "{";
+  JsonKey(json, in, "role", true);
+  *json += JsonString(node.role);
+  JsonKey(json, in, "handle");
+  *json += std::to_string(node.handle);
+  JsonKey(json, in, "generator");
+  *json += JsonString(GeneratorName(node.gen));
+  JsonKey(json, in, "dimension");
+  *json += std::to_string(static_cast<int>(node.dimension));
+  JsonKey(json, in, "precision");
+  *json += JsonString(PrecisionName(node.precision));
+  JsonKey(json, in, "direction");
+  *json += JsonString(DirectionName(node.direction));
+  JsonKey(json, in, "inputLayout");
+  *json += JsonString(LayoutName(node.ipLayout));
+  JsonKey(json, in, "outputLayout");
+  *json += JsonString(LayoutName(node.opLayout));
+  JsonKey(json, in, "inPlace");
+  *json += JsonBool(node.location == HCFFT_INPLACE);
+  JsonKey(json, in, "backend");
+  *json += JsonString(BackendName(node.backend));
+  JsonKey(json, in, "length");
+  *json += JsonSizes(node.length);
+  JsonKey(json, in, "inStride");
+  *json += JsonSizes(node.inStride);
+  JsonKey(json, in, "outStride");
+  *json += JsonSizes(node.outStride);
+  JsonKey(json, in, "iDist");
+  *json += std::to_string(node.iDist);
+  JsonKey(json, in, "oDist");
+  *json += std::to_string(node.oDist);
+  JsonKey(json, in, "batchSize");
+  *json += std::to_string(node.batchSize);
+  JsonKey(json, in, "large1D");
+  *json += std::to_string(node.large1D);
+  JsonKey(json, in, "large2D");
+  *json += JsonBool(node.large2D);
+  JsonKey(json, in, "twiddleFront");
+  *json += JsonBool(node.twiddleFront);
+  JsonKey(json, in, "transflag");
+  *json += JsonBool(node.transflag);
+  JsonKey(json, in, "blockCompute");
+  *json += JsonBool(node.blockCompute);
+
+  if (node.blockCompute) {
+    JsonKey(json, in, "blockComputeType");
+    *json += JsonString(BlockComputeName(node.blockComputeType));
+  }
+
+  JsonKey(json, in, "realSpecial");
+  *json += JsonBool(node.realSpecial);
+
+  if (node.realSpecial) {
+    JsonKey(json, in, "realSpecial_Nr");
+    *json += std::to_string(node.realSpecial_Nr);
+  }
+
+  JsonKey(json, in, "realPair");
+  *json += JsonBool(node.realPair);
+  JsonKey(json, in, "RCsimple");
+  *json += JsonBool(node.RCsimple);
+  JsonKey(json, in, "scratchBytes");
+  *json += "{\"tmpBuf\": " + std::to_string(node.tmpBufSize) +
+           ", \"tmpBufRC\": " + std::to_string(node.tmpBufSizeRC) +
+           ", \"tmpBufC2R\": " + std::to_string(node.tmpBufSizeC2R) + "}";
+  JsonKey(json, in, "flops");
+  *json += JsonNumber(node.flops);
+  JsonKey(json, in, "bytes");
+  *json += JsonNumber(node.bytes);
+
+  if (node.Leaf()) {
+    JsonKey(json, in, "kernel");
+    *json += JsonString(node.cost.name);
+    JsonKey(json, in, "radices");
+    *json += JsonSizes(node.cost.radices);
+    JsonKey(json, in, "globalWorkSize");
+    *json += JsonSizes(node.globalws);
+    JsonKey(json, in, "localWorkSize");
+    *json += JsonSizes(node.localws);
+    JsonKey(json, in, "bytesRead");
+    *json += JsonNumber(node.cost.bytesRead);
+    JsonKey(json, in, "bytesWritten");
+    *json += JsonNumber(node.cost.bytesWritten);
+    JsonKey(json, in, "ldsBytes");
+    *json += JsonNumber(node.cost.ldsBytes);
+  } else {
+    JsonKey(json, in, "children");
+    *json += "[";
+
+    for (size_t i = 0; i < node.children.size(); i++) {
+      *json += (i == 0) ? "\n" : ",\n";
+      json->append(in + 2, ' ');
+      JsonPlanNode(node.children[i], in + 2, json);
+    }
+
+    *json += "\n";
+    json->append(in, ' ');
+    *json += "]";
+  }
+
+  *json += "\n";
+  json->append(indent, ' ');
+  *json += "}";
+}
+
+std::string FFTPlanNode::Json() const {
+  std::string json;
+  JsonPlanNode(*this, 0, &json);
+  return json;
+}
+
 /*---------------------------FFTPlan-----------------------------------*/
 
 /*---------------------------FFTRepo-----------------------------------*/
@@ -35,8 +35,8 @@ while read line; do
 #Check if executable exixts
  if [ -x $path2exe ]; then
    echo $path2exe $N1value $N2value
-#Generate ATP file
-   runcmd="$path2exe $N1value $N2value >> $path2outdir/output_$datetime.txt"
+#Generate ATP file, with the time of every kernel in kernels_*.json and .csv
+   runcmd="HCFFT_PROFILE=$path2outdir/kernels_$datetime.json $path2exe $N1value $N2value >> $path2outdir/output_$datetime.txt"
    echo $runcmd
    eval $runcmd
    filename="output_$datetime.txt"
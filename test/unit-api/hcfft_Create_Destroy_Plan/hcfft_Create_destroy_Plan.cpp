@@ -100,3 +100,17 @@ TEST(hcfft_Create_Destroy_Plan, create_destroy_3D_plan_C2C) {
   status = hcfftDestroy(plan);
   EXPECT_EQ(status, HCFFT_SUCCESS);
 }
+
+// Host kernels need a library built with HCFFT_HOST_EMULATION; this one is
+// built by hcc
+TEST(hcfft_Create_Destroy_Plan, create_plan_host_emulation_rejected) {
+  hcfftHandle plan;
+  setenv("HCFFT_HOST_EMULATION", "1", 1);
+  hcfftResult status = hcfftPlan2d(&plan, VECTOR_SIZE, VECTOR_SIZE, HCFFT_C2C);
+  EXPECT_EQ(status, HCFFT_INVALID_VALUE);
+  unsetenv("HCFFT_HOST_EMULATION");
+  status = hcfftPlan2d(&plan, VECTOR_SIZE, VECTOR_SIZE, HCFFT_C2C);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  status = hcfftDestroy(plan);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+}
@@ -0,0 +1,78 @@
+/*
+Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "include/hcfft.h"
+#include "../gtest/gtest.h"
+#include <hc_am.hpp>
+#include "include/hcfftlib.h"
+#include "./helper_functions.h"
+
+// Baking and the first execution are timed phase by phase
+TEST(hcfft_1D_transform_test, func_bake_times_1D_C2C) {
+  // Longer than the precompiled kernels, so the plan is generated and built
+  int N = my_argc > 1 ? atoi(my_argv[1]) : 4096;
+  hcfftBakeTimes before;
+  EXPECT_EQ(hcfftGetBakeTimes(&before), HCFFT_SUCCESS);
+  hcfftHandle plan;
+  hcfftResult status = hcfftPlan1d(&plan, N, HCFFT_C2C);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  std::vector<hc::accelerator> accs = hc::accelerator::get_all();
+  assert(accs.size() && "Number of Accelerators == 0!");
+  hcfftComplex* idata = hc::am_alloc(N * sizeof(hcfftComplex), accs[1], 0);
+  hcfftComplex* odata = hc::am_alloc(N * sizeof(hcfftComplex), accs[1], 0);
+  status = hcfftExecC2C(plan, idata, odata, HCFFT_FORWARD);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  hcfftBakeTimes times;
+  EXPECT_EQ(hcfftGetPlanBakeTimes(plan, NULL), HCFFT_INVALID_VALUE);
+  status = hcfftGetPlanBakeTimes(plan, &times);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  // One kernel library, generated or found in the cache, loaded once
+  EXPECT_EQ(times.cacheHits + times.cacheMisses, 1);
+  EXPECT_GE(times.calls[HCFFT_BAKE_GENERATE], 1);
+  EXPECT_GE(times.calls[HCFFT_BAKE_TWIDDLES], 1);
+  EXPECT_EQ(times.calls[HCFFT_BAKE_DLOPEN], 1);
+  EXPECT_GE(times.calls[HCFFT_BAKE_DLSYM], 1);
+  EXPECT_EQ(times.calls[HCFFT_BAKE_COMPILE], times.cacheMisses);
+
+  for (int p = 0; p < HCFFT_BAKE_PHASES; p++) {
+    EXPECT_GE(times.seconds[p], 0.0);
+  }
+
+  // A second execution loads nothing
+  status = hcfftExecC2C(plan, idata, odata, HCFFT_FORWARD);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  hcfftBakeTimes again;
+  status = hcfftGetPlanBakeTimes(plan, &again);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  EXPECT_EQ(again.calls[HCFFT_BAKE_DLOPEN], 1);
+  // The process totals include the plan
+  hcfftBakeTimes after;
+  EXPECT_EQ(hcfftGetBakeTimes(&after), HCFFT_SUCCESS);
+  EXPECT_EQ(after.calls[HCFFT_BAKE_DLOPEN] - before.calls[HCFFT_BAKE_DLOPEN],
+            1);
+  EXPECT_GE(after.cacheHits + after.cacheMisses,
+            before.cacheHits + before.cacheMisses + 1);
+  status = hcfftDestroy(plan);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  hc::am_free(idata);
+  hc::am_free(odata);
+}
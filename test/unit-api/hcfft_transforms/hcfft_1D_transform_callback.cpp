@@ -0,0 +1,127 @@
+/*
+Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "include/hcfft.h"
+#include "../gtest/gtest.h"
+#include <fftw3.h>
+#include <hc_am.hpp>
+#include "include/hcfftlib.h"
+#include "./helper_functions.h"
+
+
+// Windowing folded into the read of the transform and scaling into the write
+static const char* loadSrc =
+    "[[hc]] float_2 hcfft_load_callback(float_2* buffer, size_t offset,\n"
+    "                                   void* info) {\n"
+    "  return buffer[offset] * ((float*)info)[offset];\n"
+    "}\n";
+
+static const char* storeSrc =
+    "[[hc]] void hcfft_store_callback(float_2* buffer, size_t offset,\n"
+    "                                 float_2 value, void* info) {\n"
+    "  buffer[offset] = value * ((float*)info)[0];\n"
+    "}\n";
+
+TEST(hcfft_1D_transform_test, func_correct_1D_transform_callback) {
+  size_t N1;
+  N1 = my_argc > 1 ? atoi(my_argv[1]) : 1024;
+  hcfftHandle plan;
+  hcfftResult status = hcfftPlan1d(&plan, N1, HCFFT_C2C);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  int hSize = N1;
+  const float outScale = 0.5f;
+  hcfftComplex* input = (hcfftComplex*)calloc(hSize, sizeof(hcfftComplex));
+  hcfftComplex* output = (hcfftComplex*)calloc(hSize, sizeof(hcfftComplex));
+  float* window = (float*)calloc(hSize, sizeof(float));
+
+  // Populate the input and the window
+  for (int i = 0; i < hSize; i++) {
+    input[i].x = i % 8;
+    input[i].y = i % 16;
+    window[i] = 0.5f - 0.5f * cos(2.0 * M_PI * i / hSize);
+  }
+
+  std::vector<hc::accelerator> accs = hc::accelerator::get_all();
+  assert(accs.size() && "Number of Accelerators == 0!");
+  hc::accelerator_view accl_view = accs[1].get_default_view();
+  hcfftComplex* idata = hc::am_alloc(hSize * sizeof(hcfftComplex), accs[1], 0);
+  accl_view.copy(input, idata, sizeof(hcfftComplex) * hSize);
+  hcfftComplex* odata = hc::am_alloc(hSize * sizeof(hcfftComplex), accs[1], 0);
+  accl_view.copy(output, odata, sizeof(hcfftComplex) * hSize);
+  float* wdata = hc::am_alloc(hSize * sizeof(float), accs[1], 0);
+  accl_view.copy(window, wdata, sizeof(float) * hSize);
+  float* sdata = hc::am_alloc(sizeof(float), accs[1], 0);
+  accl_view.copy(&outScale, sdata, sizeof(float));
+  status = hcfftXtSetCallback(plan, loadSrc, HCFFT_CB_LD, wdata);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  status = hcfftXtSetCallback(plan, storeSrc, HCFFT_CB_ST, sdata);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  status = hcfftExecC2C(plan, idata, odata, HCFFT_FORWARD);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  accl_view.copy(odata, output, sizeof(hcfftComplex) * hSize);
+  status = hcfftDestroy(plan);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  // FFTW work flow
+  // input output arrays
+  fftwf_complex *fftw_in, *fftw_out;
+  int lengths[1] = {hSize};
+  fftwf_plan p;
+  fftw_in = (fftwf_complex*)fftwf_malloc(sizeof(fftwf_complex) * hSize);
+  fftw_out = (fftwf_complex*)fftwf_malloc(sizeof(fftwf_complex) * hSize);
+  // Populate windowed inputs
+  for (int i = 0; i < hSize; i++) {
+    fftw_in[i][0] = input[i].x * window[i];
+    fftw_in[i][1] = input[i].y * window[i];
+  }
+  // 1D forward plan
+  p = fftwf_plan_many_dft(1, lengths, 1, fftw_in, NULL, 1, 0, fftw_out, NULL, 1,
+                          0, FFTW_FORWARD, FFTW_ESTIMATE);
+  fftwf_execute(p);
+  // Apply the store scaling
+  for (int i = 0; i < hSize; i++) {
+    fftw_out[i][0] *= outScale;
+    fftw_out[i][1] *= outScale;
+  }
+  // Check RMSE: If fails go for pointwise comparison
+  if (JudgeRMSEAccuracyComplex<fftwf_complex, hcfftComplex>(fftw_out, output,
+                                                            hSize)) {
+    // Check Real Outputs
+    for (int i = 0; i < hSize; i++) {
+      EXPECT_NEAR(fftw_out[i][0], output[i].x, 0.1);
+    }
+    // Check Imaginary Outputs
+    for (int i = 0; i < hSize; i++) {
+      EXPECT_NEAR(fftw_out[i][1], output[i].y, 0.1);
+    }
+  }
+  // Free up resources
+  fftwf_destroy_plan(p);
+  fftwf_free(fftw_in);
+  fftwf_free(fftw_out);
+  free(input);
+  free(output);
+  free(window);
+  hc::am_free(idata);
+  hc::am_free(odata);
+  hc::am_free(wdata);
+  hc::am_free(sdata);
+}
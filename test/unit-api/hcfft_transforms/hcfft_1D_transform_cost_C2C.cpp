@@ -0,0 +1,67 @@
+/*
+Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "include/hcfft.h"
+#include "../gtest/gtest.h"
+#include <cmath>
+#include "./helper_functions.h"
+
+// The cost report describes the kernels of a plan without running them
+TEST(hcfft_1D_transform_test, func_cost_report_1D_C2C) {
+  int N = my_argc > 1 ? atoi(my_argv[1]) : 1024;
+  hcfftHandle plan;
+  hcfftResult status = hcfftPlan1d(&plan, N, HCFFT_C2C);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  int count = 0;
+  status = hcfftGetPlanCostReport(plan, NULL, NULL, &count);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  ASSERT_EQ(count, 1);
+  hcfftKernelCost cost;
+  status = hcfftGetPlanCostReport(plan, NULL, &cost, &count);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  EXPECT_STREQ(cost.name, "fft_fwd");
+  int length = 1;
+
+  for (int p = 0; p < 16 && cost.radices[p] != 0; p++) {
+    length *= cost.radices[p];
+  }
+
+  EXPECT_EQ(length, N);
+  // Radix 4 and 8 butterflies stay below the 5 N log2(N) of radix 2
+  double radix2 = 5.0 * N * log2(static_cast<double>(N));
+  EXPECT_GT(cost.flops, 0.5 * radix2);
+  EXPECT_LE(cost.flops, radix2);
+  EXPECT_GE(cost.bytesRead, N * sizeof(hcfftComplex));
+  EXPECT_EQ(cost.bytesWritten, N * sizeof(hcfftComplex));
+  EXPECT_GT(cost.ldsBytes, 0);
+  EXPECT_GT(cost.seconds, 5.0e-6);
+  // A slower memory makes the kernel memory bound
+  hcfftDeviceRoofline device = {12288.0, 768.0, 0.001, 12288.0, 0.0};
+  hcfftKernelCost slow;
+  status = hcfftGetPlanCostReport(plan, &device, &slow, &count);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  EXPECT_NEAR(slow.seconds,
+              (slow.bytesRead + slow.bytesWritten) / (device.memoryGBs * 1e9),
+              1e-9 * slow.seconds);
+  status = hcfftDestroy(plan);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+}
@@ -0,0 +1,93 @@
+/*
+Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "include/hcfft.h"
+#include "../gtest/gtest.h"
+#include <fftw3.h>
+#include <hc_am.hpp>
+#include "include/hcfftlib.h"
+#include "./helper_functions.h"
+
+// Host buffers are streamed through the accelerator a few transforms at a
+// time
+TEST(hcfft_1D_transform_test, func_correct_1D_transform_host_R2C) {
+  int N1 = my_argc > 1 ? atoi(my_argv[1]) : 1024;
+  int batch = my_argc > 2 ? atoi(my_argv[2]) : 37;
+  // HCFFT work flow
+  hcfftHandle plan;
+  hcfftResult status =
+      hcfftPlanNd(&plan, 1, &N1, NULL, 0, NULL, 0, batch, HCFFT_R2C);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  int Rsize = N1 * batch;
+  int Csize = ((N1 / 2) + 1) * batch;
+  hcfftReal* input = (hcfftReal*)calloc(Rsize, sizeof(hcfftReal));
+  hcfftComplex* output = (hcfftComplex*)calloc(Csize, sizeof(hcfftComplex));
+
+  // Populate the input
+  for (int i = 0; i < Rsize; i++) {
+    input[i] = (i % 8) + (i / N1);
+  }
+
+  // No device allocation or copy on the caller side
+  status = hcfftExecHostR2C(plan, input, output);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  status = hcfftDestroy(plan);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+
+  // FFTW work flow
+  // input output arrays
+  float* in;
+  fftwf_complex* out;
+  int lengths[1] = {N1};
+  fftwf_plan p;
+  in = (float*)fftwf_malloc(sizeof(float) * Rsize);
+  out = (fftwf_complex*)fftwf_malloc(sizeof(fftwf_complex) * Csize);
+
+  // Populate inputs
+  for (int i = 0; i < Rsize; i++) {
+    in[i] = input[i];
+  }
+
+  // 1D forward plan
+  p = fftwf_plan_many_dft_r2c(1, lengths, batch, in, NULL, 1, N1, out, NULL,
+                              1, (N1 / 2) + 1, FFTW_ESTIMATE | FFTW_R2HC);
+  // Execute R2C
+  fftwf_execute(p);
+  // Check RMSE: If fails go for pointwise comparison
+  if (JudgeRMSEAccuracyComplex<fftwf_complex, hcfftComplex>(out, output,
+                                                            Csize)) {
+    // Check Real Outputs
+    for (int i = 0; i < Csize; i++) {
+      EXPECT_NEAR(out[i][0], output[i].x, 0.1);
+    }
+    // Check Imaginary Outputs
+    for (int i = 0; i < Csize; i++) {
+      EXPECT_NEAR(out[i][1], output[i].y, 0.1);
+    }
+  }
+  // Free up resources
+  fftwf_destroy_plan(p);
+  fftwf_free(in);
+  fftwf_free(out);
+  free(input);
+  free(output);
+}
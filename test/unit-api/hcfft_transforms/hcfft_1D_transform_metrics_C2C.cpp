@@ -0,0 +1,93 @@
+/*
+Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "include/hcfft.h"
+#include "../gtest/gtest.h"
+#include <hc_am.hpp>
+#include <string>
+#include <thread>
+#include "include/hcfftlib.h"
+#include "./helper_functions.h"
+
+// Kernels, executions and bakes add to the process metrics
+TEST(hcfft_1D_transform_test, func_metrics_1D_C2C) {
+  int N = my_argc > 1 ? atoi(my_argv[1]) : 1024;
+  hcfftMetrics before;
+  EXPECT_EQ(hcfftGetMetrics(NULL), HCFFT_INVALID_VALUE);
+  EXPECT_EQ(hcfftGetMetrics(&before), HCFFT_SUCCESS);
+  hcfftHandle plan;
+  hcfftResult status = hcfftPlan1d(&plan, N, HCFFT_C2C);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  std::vector<hc::accelerator> accs = hc::accelerator::get_all();
+  assert(accs.size() && "Number of Accelerators == 0!");
+  hcfftComplex* idata = hc::am_alloc(N * sizeof(hcfftComplex), accs[1], 0);
+  hcfftComplex* odata = hc::am_alloc(N * sizeof(hcfftComplex), accs[1], 0);
+  status = hcfftExecC2C(plan, idata, odata, HCFFT_FORWARD);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  // A second execution from another thread is counted once it is read
+  std::thread worker([&] {
+    EXPECT_EQ(hcfftExecC2C(plan, idata, odata, HCFFT_FORWARD), HCFFT_SUCCESS);
+  });
+  worker.join();
+  hcfftMetrics after;
+  EXPECT_EQ(hcfftGetMetrics(&after), HCFFT_SUCCESS);
+  EXPECT_EQ(after.plansCreated - before.plansCreated, 1);
+  EXPECT_GE(after.plansBaked - before.plansBaked, 1);
+  EXPECT_GE(after.cacheHits + after.cacheMisses,
+            before.cacheHits + before.cacheMisses + 1);
+  EXPECT_EQ(after.execs - before.execs, 2);
+  size_t launched = 0;
+  size_t bucketed = 0;
+
+  for (int k = 0; k < HCFFT_KERNEL_KINDS; k++) {
+    launched += after.kernelsLaunched[k] - before.kernelsLaunched[k];
+  }
+
+  for (int b = 0; b < HCFFT_EXEC_BUCKETS; b++) {
+    bucketed += after.execBuckets[b] - before.execBuckets[b];
+  }
+
+  EXPECT_GE(launched, 2);
+  EXPECT_EQ(bucketed, 2);
+  // Every launch reads and writes at least the N complex values
+  EXPECT_GE(after.kernelBytes - before.kernelBytes,
+            4.0 * N * sizeof(hcfftComplex));
+  EXPECT_GT(after.execSeconds, before.execSeconds);
+  EXPECT_GT(after.twiddleBytes, 0);
+  // The Prometheus text gives the same counters
+  size_t size = 0;
+  EXPECT_EQ(hcfftGetMetricsPrometheus(NULL, NULL), HCFFT_INVALID_VALUE);
+  EXPECT_EQ(hcfftGetMetricsPrometheus(NULL, &size), HCFFT_SUCCESS);
+  std::vector<char> text(size);
+  EXPECT_EQ(hcfftGetMetricsPrometheus(&text[0], &size), HCFFT_SUCCESS);
+  std::string prometheus(&text[0]);
+  EXPECT_NE(prometheus.find("# TYPE hcfft_exec_seconds histogram"),
+            std::string::npos);
+  EXPECT_NE(prometheus.find("hcfft_exec_seconds_bucket{le=\"+Inf\"}"),
+            std::string::npos);
+  EXPECT_NE(prometheus.find("hcfft_kernels_launched_total{generator="),
+            std::string::npos);
+  status = hcfftDestroy(plan);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  hc::am_free(idata);
+  hc::am_free(odata);
+}
@@ -0,0 +1,94 @@
+/*
+Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "include/hcfft.h"
+#include "../gtest/gtest.h"
+#include <fftw3.h>
+#include <hc_am.hpp>
+#include "include/hcfftlib.h"
+#include "./helper_functions.h"
+
+// Uneven shares over three simulated devices, one of them idle
+TEST(hcfft_1D_transform_test, func_correct_1D_transform_multidevice_C2C) {
+  int N1 = my_argc > 1 ? atoi(my_argv[1]) : 1024;
+  int batch = my_argc > 2 ? atoi(my_argv[2]) : 37;
+  // HCFFT work flow
+  hcfftHandle plan;
+  hcfftResult status =
+      hcfftPlanNd(&plan, 1, &N1, NULL, 0, NULL, 0, batch, HCFFT_C2C);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  int weights[4] = {1, 0, 2, 3};
+  status = hcfftXtSetSimulatedAccelerators(plan, 4, weights);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  int hSize = N1 * batch;
+  hcfftComplex* input = (hcfftComplex*)calloc(hSize, sizeof(hcfftComplex));
+  hcfftComplex* output = (hcfftComplex*)calloc(hSize, sizeof(hcfftComplex));
+
+  // Populate the input
+  for (int i = 0; i < hSize; i++) {
+    input[i].x = (i % 8) + (i / N1);
+    input[i].y = i % 16;
+  }
+
+  status = hcfftExecHostC2C(plan, input, output, HCFFT_FORWARD);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  status = hcfftDestroy(plan);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+
+  // FFTW work flow
+  // input output arrays
+  fftwf_complex *fftw_in, *fftw_out;
+  int lengths[1] = {N1};
+  fftwf_plan p;
+  fftw_in = (fftwf_complex*)fftwf_malloc(sizeof(fftwf_complex) * hSize);
+  fftw_out = (fftwf_complex*)fftwf_malloc(sizeof(fftwf_complex) * hSize);
+
+  // Populate inputs
+  for (int i = 0; i < hSize; i++) {
+    fftw_in[i][0] = input[i].x;
+    fftw_in[i][1] = input[i].y;
+  }
+
+  // 1D forward plan
+  p = fftwf_plan_many_dft(1, lengths, batch, fftw_in, NULL, 1, N1, fftw_out,
+                          NULL, 1, N1, FFTW_FORWARD, FFTW_ESTIMATE);
+  // Execute C2C
+  fftwf_execute(p);
+  // Check RMSE: If fails go for pointwise comparison
+  if (JudgeRMSEAccuracyComplex<fftwf_complex, hcfftComplex>(fftw_out, output,
+                                                            hSize)) {
+    // Check Real Outputs
+    for (int i = 0; i < hSize; i++) {
+      EXPECT_NEAR(fftw_out[i][0], output[i].x, 0.1);
+    }
+    // Check Imaginary Outputs
+    for (int i = 0; i < hSize; i++) {
+      EXPECT_NEAR(fftw_out[i][1], output[i].y, 0.1);
+    }
+  }
+  // Free up resources
+  fftwf_destroy_plan(p);
+  fftwf_free(fftw_in);
+  fftwf_free(fftw_out);
+  free(input);
+  free(output);
+}
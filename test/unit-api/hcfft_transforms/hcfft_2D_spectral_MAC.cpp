@@ -0,0 +1,94 @@
+/*
+Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "include/hcfft.h"
+#include "../gtest/gtest.h"
+#include <hc_am.hpp>
+#include "include/hcfftlib.h"
+#include "./helper_functions.h"
+
+TEST(hcfft_2D_transform_test, func_correct_2D_spectral_MAC) {
+  size_t N1, N2;
+  N1 = my_argc > 1 ? atoi(my_argv[1]) : 25;
+  N2 = my_argc > 2 ? atoi(my_argv[2]) : 25;
+  const int B = 2, C = 3, K = 4;
+  hcfftHandle plan;
+  hcfftResult status = hcfftPlan2d(&plan, N1, N2, HCFFT_R2C);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  // Spectra in the hermitian layout of the R2C plan
+  int bins = N2 * (1 + N1 / 2);
+  hcfftComplex* input = (hcfftComplex*)calloc(B * C * bins, sizeof(hcfftComplex));
+  hcfftComplex* weights = (hcfftComplex*)calloc(K * C * bins, sizeof(hcfftComplex));
+  hcfftComplex* output = (hcfftComplex*)calloc(B * K * bins, sizeof(hcfftComplex));
+
+  // Populate the inputs
+  for (int i = 0; i < B * C * bins; i++) {
+    input[i].x = (i % 7) - 3;
+    input[i].y = (i % 5) - 2;
+  }
+
+  for (int i = 0; i < K * C * bins; i++) {
+    weights[i].x = (i % 3) - 1;
+    weights[i].y = (i % 4) * 0.5f;
+  }
+
+  std::vector<hc::accelerator> accs = hc::accelerator::get_all();
+  assert(accs.size() && "Number of Accelerators == 0!");
+  hc::accelerator_view accl_view = accs[1].get_default_view();
+  hcfftComplex* idata = hc::am_alloc(B * C * bins * sizeof(hcfftComplex), accs[1], 0);
+  accl_view.copy(input, idata, sizeof(hcfftComplex) * B * C * bins);
+  hcfftComplex* wdata = hc::am_alloc(K * C * bins * sizeof(hcfftComplex), accs[1], 0);
+  accl_view.copy(weights, wdata, sizeof(hcfftComplex) * K * C * bins);
+  hcfftComplex* odata = hc::am_alloc(B * K * bins * sizeof(hcfftComplex), accs[1], 0);
+  status = hcfftSpectralMAC(plan, B, C, K, idata, wdata, odata, HCFFT_MAC_DEFAULT);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  accl_view.copy(odata, output, sizeof(hcfftComplex) * B * K * bins);
+  status = hcfftDestroy(plan);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+
+  // Host reference
+  for (int b = 0; b < B; b++) {
+    for (int k = 0; k < K; k++) {
+      for (int f = 0; f < bins; f++) {
+        float re = 0.0f, im = 0.0f;
+
+        for (int c = 0; c < C; c++) {
+          hcfftComplex x = input[(b * C + c) * bins + f];
+          hcfftComplex w = weights[(k * C + c) * bins + f];
+          re += x.x * w.x - x.y * w.y;
+          im += x.x * w.y + x.y * w.x;
+        }
+
+        EXPECT_NEAR(re, output[(b * K + k) * bins + f].x, 0.01);
+        EXPECT_NEAR(im, output[(b * K + k) * bins + f].y, 0.01);
+      }
+    }
+  }
+
+  // Free up resources
+  free(input);
+  free(weights);
+  free(output);
+  hc::am_free(idata);
+  hc::am_free(wdata);
+  hc::am_free(odata);
+}
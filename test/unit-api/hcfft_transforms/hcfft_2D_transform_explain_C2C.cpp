@@ -0,0 +1,62 @@
+/*
+Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "include/hcfft.h"
+#include "../gtest/gtest.h"
+#include <string>
+#include <vector>
+#include "./helper_functions.h"
+
+// hcfftExplainPlan describes the sub-plans a 2D plan is baked into
+TEST(hcfft_2D_transform_test, func_explain_2D_C2C) {
+  // Rows longer than the precompiled kernels are decomposed into sub-plans
+  int N1 = my_argc > 1 ? atoi(my_argv[1]) : 4096;
+  int N2 = my_argc > 2 ? atoi(my_argv[2]) : 512;
+  hcfftHandle plan;
+  hcfftResult status = hcfftPlan2d(&plan, N1, N2, HCFFT_C2C);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  size_t size = 0;
+  status = hcfftExplainPlan(plan, NULL, &size);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  ASSERT_GT(size, 1);
+  std::vector<char> json(size);
+  status = hcfftExplainPlan(plan, &json[0], &size);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  EXPECT_EQ(json.size(), size);
+  std::string text(&json[0]);
+  EXPECT_EQ(text.size() + 1, size);
+  EXPECT_EQ(text[0], '{');
+  EXPECT_EQ(text[text.size() - 1], '}');
+  EXPECT_NE(text.find("\"role\": \"plan\""), std::string::npos);
+  EXPECT_NE(text.find("\"children\""), std::string::npos);
+  EXPECT_NE(text.find("\"role\": \"planX\""), std::string::npos);
+  EXPECT_NE(text.find("\"kernel\": \"fft_fwd\""), std::string::npos);
+  // A short buffer receives the beginning of the JSON
+  char head[8];
+  size_t headSize = sizeof(head);
+  status = hcfftExplainPlan(plan, head, &headSize);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  EXPECT_EQ(headSize, size);
+  EXPECT_EQ(std::string(head), text.substr(0, sizeof(head) - 1));
+  status = hcfftDestroy(plan);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+}
@@ -0,0 +1,96 @@
+/*
+Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "include/hcfft.h"
+#include "../gtest/gtest.h"
+#include <fftw3.h>
+#include <hc_am.hpp>
+#include "include/hcfftlib.h"
+#include "./helper_functions.h"
+
+// The default size is one the row/column decomposition would transpose
+TEST(hcfft_2D_transform_test, func_correct_2D_transform_half_C2C) {
+  size_t N1, N2;
+  N1 = my_argc > 1 ? atoi(my_argv[1]) : 128;
+  N2 = my_argc > 2 ? atoi(my_argv[2]) : 64;
+  hcfftHandle plan;
+  hcfftResult status = hcfftPlan2d(&plan, N1, N2, HCFFT_C2C_HALF);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  int hSize = N1 * N2;
+  hcfftHalfComplex* input =
+      (hcfftHalfComplex*)calloc(hSize, sizeof(hcfftHalfComplex));
+  hcfftHalfComplex* output =
+      (hcfftHalfComplex*)calloc(hSize, sizeof(hcfftHalfComplex));
+
+  // Populate the input
+  for (int i = 0; i < hSize; i++) {
+    input[i].x = FloatToHalf((i % 8) / 8.0f - 0.5f);
+    input[i].y = FloatToHalf((i % 13) / 16.0f - 0.5f);
+  }
+
+  std::vector<hc::accelerator> accs = hc::accelerator::get_all();
+  assert(accs.size() && "Number of Accelerators == 0!");
+  hc::accelerator_view accl_view = accs[1].get_default_view();
+  hcfftHalfComplex* idata =
+      hc::am_alloc(hSize * sizeof(hcfftHalfComplex), accs[1], 0);
+  accl_view.copy(input, idata, sizeof(hcfftHalfComplex) * hSize);
+  hcfftHalfComplex* odata =
+      hc::am_alloc(hSize * sizeof(hcfftHalfComplex), accs[1], 0);
+  accl_view.copy(output, odata, sizeof(hcfftHalfComplex) * hSize);
+  status = hcfftExecC2CHalf(plan, idata, odata, HCFFT_FORWARD);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  accl_view.copy(odata, output, sizeof(hcfftHalfComplex) * hSize);
+  status = hcfftDestroy(plan);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  // FFTW work flow
+  // input output arrays
+  fftwf_complex *fftw_in, *fftw_out;
+  fftwf_plan p;
+  fftw_in = (fftwf_complex*)fftwf_malloc(sizeof(fftwf_complex) * hSize);
+  fftw_out = (fftwf_complex*)fftwf_malloc(sizeof(fftwf_complex) * hSize);
+  // Populate inputs with the values the half input represents
+  for (int i = 0; i < hSize; i++) {
+    fftw_in[i][0] = HalfToFloat(input[i].x);
+    fftw_in[i][1] = HalfToFloat(input[i].y);
+  }
+  // 2D forward plan
+  p = fftwf_plan_dft_2d(N2, N1, fftw_in, fftw_out, FFTW_FORWARD, FFTW_ESTIMATE);
+  fftwf_execute(p);
+  // Every pass rounds to fp16, so compare against the spacing at the peak
+  float peak = 0;
+  for (int i = 0; i < hSize; i++) {
+    peak = std::max(peak, fabsf(fftw_out[i][0]));
+    peak = std::max(peak, fabsf(fftw_out[i][1]));
+  }
+  for (int i = 0; i < hSize; i++) {
+    EXPECT_NEAR(fftw_out[i][0], HalfToFloat(output[i].x), 0.01 + peak * 2e-3);
+    EXPECT_NEAR(fftw_out[i][1], HalfToFloat(output[i].y), 0.01 + peak * 2e-3);
+  }
+  // Free up resources
+  fftwf_destroy_plan(p);
+  fftwf_free(fftw_in);
+  fftwf_free(fftw_out);
+  free(input);
+  free(output);
+  hc::am_free(idata);
+  hc::am_free(odata);
+}
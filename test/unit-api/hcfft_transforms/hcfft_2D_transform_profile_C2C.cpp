@@ -0,0 +1,83 @@
+/*
+Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "include/hcfft.h"
+#include "../gtest/gtest.h"
+#include <hc_am.hpp>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "include/hcfftlib.h"
+#include "./helper_functions.h"
+
+// Every kernel launched between hcfftProfileStart and hcfftProfileStop is
+// written to the trace and the CSV
+TEST(hcfft_2D_transform_test, func_profile_2D_C2C) {
+  size_t N1, N2;
+  N1 = my_argc > 1 ? atoi(my_argv[1]) : 1024;
+  N2 = my_argc > 2 ? atoi(my_argv[2]) : 512;
+  hcfftHandle plan;
+  hcfftResult status = hcfftPlan2d(&plan, N1, N2, HCFFT_C2C);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  int hSize = N1 * N2;
+  std::vector<hc::accelerator> accs = hc::accelerator::get_all();
+  assert(accs.size() && "Number of Accelerators == 0!");
+  hcfftComplex* idata = hc::am_alloc(hSize * sizeof(hcfftComplex), accs[1], 0);
+  hcfftComplex* odata = hc::am_alloc(hSize * sizeof(hcfftComplex), accs[1], 0);
+  EXPECT_EQ(hcfftProfileStop(), HCFFT_INVALID_VALUE);
+  EXPECT_EQ(hcfftProfileStart("hcfft_profile_2D_C2C.json"), HCFFT_SUCCESS);
+  status = hcfftExecC2C(plan, idata, odata, HCFFT_FORWARD);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  EXPECT_EQ(hcfftProfileStop(), HCFFT_SUCCESS);
+  status = hcfftDestroy(plan);
+  EXPECT_EQ(status, HCFFT_SUCCESS);
+  hc::am_free(idata);
+  hc::am_free(odata);
+  std::ifstream trace("hcfft_profile_2D_C2C.json");
+  std::stringstream json;
+  json << trace.rdbuf();
+  EXPECT_NE(json.str().find("\"traceEvents\""), std::string::npos);
+  EXPECT_NE(json.str().find("\"name\": \"fft_fwd\""), std::string::npos);
+  std::ifstream csv("hcfft_profile_2D_C2C.csv");
+  std::string line;
+  ASSERT_TRUE(static_cast<bool>(std::getline(csv, line)));
+  EXPECT_EQ(line.find("kernel,generator,plan,"), 0);
+  int launches = 0;
+
+  while (std::getline(csv, line)) {
+    launches++;
+    // Bytes of the launch are the tenth column
+    std::stringstream fields(line);
+    std::string field;
+
+    for (int c = 0; c < 10; c++) {
+      std::getline(fields, field, ',');
+    }
+
+    EXPECT_GT(atof(field.c_str()), 0.0);
+  }
+
+  // One row pass and one column pass at least
+  EXPECT_GE(launches, 2);
+  remove("hcfft_profile_2D_C2C.json");
+  remove("hcfft_profile_2D_C2C.csv");
+}
@@ -24,6 +24,7 @@ THE SOFTWARE.
 #define TEST_UNIT_API_HCFFT_TRANSFORMS_HELPER_FUNCTIONS_H_
 #include <math.h>
 #include <stdlib.h>
+#include <string.h>
 
 double rmse_tolerance = 0.00002;
 const double magnitude_lower_limit = 1.0E-100;
@@ -102,5 +103,44 @@ inline bool JudgeRMSEAccuracyReal(T* expected, S* actual,
   return 0;
 }
 
+// IEEE 754 binary16 conversions for the half precision tests
+inline unsigned short FloatToHalf(float f) {
+  unsigned int bits;
+  memcpy(&bits, &f, sizeof(bits));
+  unsigned short sign = (bits >> 16) & 0x8000;
+  int exponent = static_cast<int>((bits >> 23) & 0xff) - 127 + 15;
+  unsigned int mantissa = bits & 0x7fffff;
+  if (exponent <= 0) {
+    // Flush the few subnormal values the tests produce to zero
+    return sign;
+  }
+  if (exponent >= 31) {
+    return sign | 0x7c00;
+  }
+  // Round to nearest
+  unsigned int half = (exponent << 10) | (mantissa >> 13);
+  if (mantissa & 0x1000) {
+    half++;
+  }
+  return sign | half;
+}
+
+inline float HalfToFloat(unsigned short h) {
+  unsigned int sign = (h & 0x8000) << 16;
+  unsigned int exponent = (h >> 10) & 0x1f;
+  unsigned int mantissa = h & 0x3ff;
+  unsigned int bits;
+  if (exponent == 0) {
+    bits = sign;
+  } else if (exponent == 31) {
+    bits = sign | 0x7f800000 | (mantissa << 13);
+  } else {
+    bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+  }
+  float f;
+  memcpy(&f, &bits, sizeof(f));
+  return f;
+}
+
 #endif  // TEST_UNIT_API_HCFFT_TRANSFORMS_HELPER_FUNCTIONS_H_
 
@@ -0,0 +1,609 @@
+/*
+Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+// hcfft-bench: time transforms over shapes, types, placements and batches
+//
+//   hcfft-bench [options]
+//
+// Every case creates its plan and times the first execution, which bakes the
+// plan, compiles or loads its kernels and runs them: the cold numbers. It then
+// runs --warmup executions untimed and --reps executions timed one by one, the
+// steady state, reported as min, median, p90, p99, mean and deviation. The
+// generated kernels wait for their completion, so host time is kernel time.
+// GFLOP/s counts 5 N log2 N per complex transform and half that per real one;
+// GB/s counts the input read and the output written once.
+//
+// Shapes come from --size, --sweep and --input (the rows of
+// test/FFT_benchmark_Convolution_Networks/Input.txt), n0 being the fastest
+// axis; without any of them 1D, 2D and 3D power of two sweeps are run.
+
+#include "include/hcfft.h"
+#include <hc_am.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static void Usage() {
+  fprintf(stderr,
+          "usage: hcfft-bench [options]\n"
+          "  --size N0[xN1[xN2]]     one shape, repeatable\n"
+          "  --sweep R:LO:HI         powers of two from LO to HI on R axes\n"
+          "  --input FILE            shapes, one per line\n"
+          "  --types T,...           c2c,z2z,r2c,c2r,d2z,z2d (all)\n"
+          "  --placement P,...       inplace,outofplace (both)\n"
+          "  --batch B,...           batch sizes (1)\n"
+          "  --warmup N              untimed executions (5)\n"
+          "  --reps N                timed executions (25)\n"
+          "  --json FILE             write the results as JSON\n"
+          "  --csv FILE              write the results as CSV\n");
+}
+
+// HCFFT_FORWARD of hcfftlib.h; the public header takes an int direction
+static const int kForward = -1;
+
+struct BenchType {
+  const char* name;
+  hcfftType type;
+  bool real;     // one side of the transform is real
+  bool forward;  // the real side is the input
+  size_t realBytes;
+};
+
+static const BenchType kTypes[] = {
+    {"c2c", HCFFT_C2C, false, true, sizeof(float)},
+    {"z2z", HCFFT_Z2Z, false, true, sizeof(double)},
+    {"r2c", HCFFT_R2C, true, true, sizeof(float)},
+    {"c2r", HCFFT_C2R, true, false, sizeof(float)},
+    {"d2z", HCFFT_D2Z, true, true, sizeof(double)},
+    {"z2d", HCFFT_Z2D, true, false, sizeof(double)}};
+
+struct BenchCase {
+  std::vector<int> n;
+  const BenchType* type;
+  bool inplace;
+  int batch;
+
+  std::string Key() const {
+    std::string key = std::string(type->name) +
+                      (inplace ? "_inplace_" : "_outofplace_");
+
+    for (size_t i = 0; i < n.size(); i++) {
+      key += (i == 0 ? "" : "x") + std::to_string(n[i]);
+    }
+
+    return key + "_b" + std::to_string(batch);
+  }
+};
+
+struct BenchResult {
+  BenchCase bench;
+  hcfftResult status;
+  double createSeconds;  // plan creation
+  double coldSeconds;    // first execution, bake and kernel load included
+  double bakeSeconds;    // as hcfftGetPlanBakeTimes() reports it
+  bool cacheHit;         // the kernels were found in the kernel cache
+  std::vector<double> seconds;  // steady state executions, sorted
+  double gflops;
+  double gbs;
+
+  BenchResult()
+      : status(HCFFT_SUCCESS),
+        createSeconds(0),
+        coldSeconds(0),
+        bakeSeconds(0),
+        cacheHit(false),
+        gflops(0),
+        gbs(0) {}
+
+  // Nearest rank percentile of the steady state times
+  double Percentile(double p) const {
+    if (seconds.empty()) {
+      return 0;
+    }
+
+    size_t rank = static_cast<size_t>(ceil(p / 100.0 * seconds.size()));
+    return seconds[std::max<size_t>(rank, 1) - 1];
+  }
+
+  double Mean() const {
+    double sum = 0;
+
+    for (size_t i = 0; i < seconds.size(); i++) {
+      sum += seconds[i];
+    }
+
+    return seconds.empty() ? 0 : sum / seconds.size();
+  }
+
+  double Deviation() const {
+    double mean = Mean();
+    double sum = 0;
+
+    for (size_t i = 0; i < seconds.size(); i++) {
+      sum += (seconds[i] - mean) * (seconds[i] - mean);
+    }
+
+    return (seconds.size() < 2) ? 0 : sqrt(sum / (seconds.size() - 1));
+  }
+};
+
+static double Now() {
+  std::chrono::duration<double> now =
+      std::chrono::steady_clock::now().time_since_epoch();
+  return now.count();
+}
+
+static std::vector<std::string> Split(const std::string& text, char sep) {
+  std::vector<std::string> items;
+  std::stringstream stream(text);
+  std::string item;
+
+  while (std::getline(stream, item, sep)) {
+    if (!item.empty()) {
+      items.push_back(item);
+    }
+  }
+
+  return items;
+}
+
+static bool ParseShape(const std::string& text, std::vector<int>* n) {
+  std::vector<std::string> axes = Split(text, 'x');
+  n->clear();
+
+  for (size_t i = 0; i < axes.size(); i++) {
+    n->push_back(atoi(axes[i].c_str()));
+
+    if (n->back() < 1) {
+      return false;
+    }
+  }
+
+  return !n->empty() && n->size() <= 3;
+}
+
+static void Sweep(int rank, int lo, int hi,
+                  std::vector<std::vector<int> >* shapes) {
+  for (int size = lo; size <= hi; size *= 2) {
+    shapes->push_back(std::vector<int>(rank, size));
+  }
+}
+
+static bool ReadShapes(const char* path,
+                       std::vector<std::vector<int> >* shapes) {
+  std::ifstream file(path);
+  std::string line;
+
+  if (!file) {
+    return false;
+  }
+
+  while (std::getline(file, line)) {
+    std::stringstream stream(line);
+    std::vector<int> n;
+    int size;
+
+    while (stream >> size) {
+      n.push_back(size);
+    }
+
+    if (!n.empty() && n.size() <= 3) {
+      shapes->push_back(n);
+    }
+  }
+
+  return true;
+}
+
+static hcfftResult Exec(hcfftHandle plan, const BenchType& type, void* in,
+                        void* out) {
+  switch (type.type) {
+    case HCFFT_C2C:
+      return hcfftExecC2C(plan, static_cast<hcfftComplex*>(in),
+                          static_cast<hcfftComplex*>(out), kForward);
+
+    case HCFFT_Z2Z:
+      return hcfftExecZ2Z(plan, static_cast<hcfftDoubleComplex*>(in),
+                          static_cast<hcfftDoubleComplex*>(out), kForward);
+
+    case HCFFT_R2C:
+      return hcfftExecR2C(plan, static_cast<hcfftReal*>(in),
+                          static_cast<hcfftComplex*>(out));
+
+    case HCFFT_C2R:
+      return hcfftExecC2R(plan, static_cast<hcfftComplex*>(in),
+                          static_cast<hcfftReal*>(out));
+
+    case HCFFT_D2Z:
+      return hcfftExecD2Z(plan, static_cast<hcfftDoubleReal*>(in),
+                          static_cast<hcfftDoubleComplex*>(out));
+
+    case HCFFT_Z2D:
+      return hcfftExecZ2D(plan, static_cast<hcfftDoubleComplex*>(in),
+                          static_cast<hcfftDoubleReal*>(out));
+
+    default:
+      return HCFFT_INVALID_VALUE;
+  }
+}
+
+// Random input in [-0.5, 0.5)
+template <typename T>
+static void Fill(hc::accelerator& acc, void* buffer, size_t bytes) {
+  std::vector<T> host(bytes / sizeof(T));
+
+  for (size_t i = 0; i < host.size(); i++) {
+    host[i] = static_cast<T>(rand()) / RAND_MAX - 0.5;
+  }
+
+  acc.get_default_view().copy(&host[0], buffer, host.size() * sizeof(T));
+}
+
+static BenchResult Run(const BenchCase& bench, hc::accelerator& acc,
+                       int warmup, int reps) {
+  BenchResult result;
+  result.bench = bench;
+  const BenchType& type = *bench.type;
+  size_t points = 1;
+
+  for (size_t i = 0; i < bench.n.size(); i++) {
+    points *= bench.n[i];
+  }
+
+  // Real data is padded to the Hermitian length when in place
+  size_t hermitian = (points / bench.n[0]) * (bench.n[0] / 2 + 1);
+  size_t complexBytes = 2 * type.realBytes;
+  size_t realSide = points * type.realBytes;
+  size_t complexSide = (type.real ? hermitian : points) * complexBytes;
+  size_t inBytes = type.real && type.forward ? realSide : complexSide;
+  size_t outBytes = type.real && !type.forward ? realSide : complexSide;
+  size_t bufferBytes =
+      bench.inplace ? std::max(inBytes, hermitian * complexBytes) : inBytes;
+  void* in = hc::am_alloc(bufferBytes * bench.batch, acc, 0);
+  void* out = in;
+
+  if (!bench.inplace) {
+    out = hc::am_alloc(outBytes * bench.batch, acc, 0);
+  }
+
+  if (in == NULL || out == NULL) {
+    result.status = HCFFT_ALLOC_FAILED;
+  } else if (type.realBytes == sizeof(double)) {
+    Fill<double>(acc, in, bufferBytes * bench.batch);
+  } else {
+    Fill<float>(acc, in, bufferBytes * bench.batch);
+  }
+
+  hcfftHandle plan;
+  double start = Now();
+
+  if (result.status == HCFFT_SUCCESS) {
+    result.status =
+        hcfftPlanNd(&plan, static_cast<int>(bench.n.size()), &bench.n[0], NULL,
+                    0, NULL, 0, bench.batch, type.type);
+    result.createSeconds = Now() - start;
+  }
+
+  if (result.status == HCFFT_SUCCESS) {
+    start = Now();
+    result.status = Exec(plan, type, in, out);
+    result.coldSeconds = Now() - start;
+    hcfftBakeTimes times;
+
+    if (hcfftGetPlanBakeTimes(plan, &times) == HCFFT_SUCCESS) {
+      for (int p = 0; p < HCFFT_BAKE_PHASES; p++) {
+        result.bakeSeconds += times.seconds[p];
+      }
+
+      result.cacheHit = (times.cacheMisses == 0);
+    }
+
+    for (int i = 0; (i < warmup) && (result.status == HCFFT_SUCCESS); i++) {
+      result.status = Exec(plan, type, in, out);
+    }
+
+    for (int i = 0; (i < reps) && (result.status == HCFFT_SUCCESS); i++) {
+      start = Now();
+      result.status = Exec(plan, type, in, out);
+      result.seconds.push_back(Now() - start);
+    }
+
+    hcfftDestroy(plan);
+  }
+
+  if (in != NULL) {
+    hc::am_free(in);
+  }
+
+  if (out != NULL && out != in) {
+    hc::am_free(out);
+  }
+
+  std::sort(result.seconds.begin(), result.seconds.end());
+  double median = result.Percentile(50);
+
+  if (result.status == HCFFT_SUCCESS && median > 0) {
+    double flops = (type.real ? 2.5 : 5.0) * points * log2(points);
+    result.gflops = flops * bench.batch / median * 1.0e-9;
+    result.gbs = (inBytes + outBytes) * bench.batch / median * 1.0e-9;
+  }
+
+  return result;
+}
+
+static std::string JsonEscape(const std::string& text) {
+  std::string escaped;
+
+  for (size_t i = 0; i < text.size(); i++) {
+    if (text[i] == '"' || text[i] == '\\') {
+      escaped += '\\';
+    }
+
+    if (static_cast<unsigned char>(text[i]) >= 0x20) {
+      escaped += text[i];
+    }
+  }
+
+  return escaped;
+}
+
+static bool WriteJson(const char* path, const std::string& device, int warmup,
+                      int reps, const std::vector<BenchResult>& results) {
+  FILE* file = fopen(path, "w");
+
+  if (file == NULL) {
+    return false;
+  }
+
+  fprintf(file,
+          "{\"benchmark\": \"hcfft-bench\", \"device\": \"%s\", "
+          "\"warmup\": %d, \"reps\": %d, \"cases\": [",
+          JsonEscape(device).c_str(), warmup, reps);
+
+  for (size_t i = 0; i < results.size(); i++) {
+    const BenchResult& r = results[i];
+    std::string lengths;
+
+    for (size_t a = 0; a < r.bench.n.size(); a++) {
+      lengths += (a == 0 ? "" : ", ") + std::to_string(r.bench.n[a]);
+    }
+
+    fprintf(file,
+            "%s\n  {\"key\": \"%s\", \"type\": \"%s\", \"placement\": \"%s\", "
+            "\"lengths\": [%s], \"batch\": %d, \"status\": %d, "
+            "\"cold\": {\"create_s\": %.9f, \"first_exec_s\": %.9f, "
+            "\"bake_s\": %.9f, \"cache_hit\": %s}, "
+            "\"steady\": {\"min_s\": %.9f, \"median_s\": %.9f, "
+            "\"p90_s\": %.9f, \"p99_s\": %.9f, \"mean_s\": %.9f, "
+            "\"stddev_s\": %.9f}, \"gflops\": %.3f, \"gbs\": %.3f}",
+            (i == 0) ? "" : ",", r.bench.Key().c_str(), r.bench.type->name,
+            r.bench.inplace ? "inplace" : "outofplace", lengths.c_str(),
+            r.bench.batch, static_cast<int>(r.status), r.createSeconds,
+            r.coldSeconds, r.bakeSeconds, r.cacheHit ? "true" : "false",
+            r.Percentile(0), r.Percentile(50), r.Percentile(90),
+            r.Percentile(99), r.Mean(), r.Deviation(), r.gflops, r.gbs);
+  }
+
+  fprintf(file, "\n]}\n");
+  return fclose(file) == 0;
+}
+
+static bool WriteCsv(const char* path,
+                     const std::vector<BenchResult>& results) {
+  FILE* file = fopen(path, "w");
+
+  if (file == NULL) {
+    return false;
+  }
+
+  fprintf(file,
+          "key,type,placement,lengths,batch,status,create_s,first_exec_s,"
+          "bake_s,cache_hit,min_s,median_s,p90_s,p99_s,mean_s,stddev_s,"
+          "gflops,gbs\n");
+
+  for (size_t i = 0; i < results.size(); i++) {
+    const BenchResult& r = results[i];
+    std::string lengths;
+
+    for (size_t a = 0; a < r.bench.n.size(); a++) {
+      lengths += (a == 0 ? "" : "x") + std::to_string(r.bench.n[a]);
+    }
+
+    fprintf(file,
+            "%s,%s,%s,%s,%d,%d,%.9f,%.9f,%.9f,%d,%.9f,%.9f,%.9f,%.9f,%.9f,"
+            "%.9f,%.3f,%.3f\n",
+            r.bench.Key().c_str(), r.bench.type->name,
+            r.bench.inplace ? "inplace" : "outofplace", lengths.c_str(),
+            r.bench.batch, static_cast<int>(r.status), r.createSeconds,
+            r.coldSeconds, r.bakeSeconds, r.cacheHit ? 1 : 0, r.Percentile(0),
+            r.Percentile(50), r.Percentile(90), r.Percentile(99), r.Mean(),
+            r.Deviation(), r.gflops, r.gbs);
+  }
+
+  return fclose(file) == 0;
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<std::vector<int> > shapes;
+  std::vector<const BenchType*> types;
+  std::vector<bool> placements;
+  std::vector<int> batches;
+  int warmup = 5;
+  int reps = 25;
+  const char* jsonPath = NULL;
+  const char* csvPath = NULL;
+
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    std::string value = (i + 1 < argc) ? argv[i + 1] : "";
+    bool valid = !value.empty();
+    std::vector<int> n;
+
+    if (arg == "--size" && valid && ParseShape(value, &n)) {
+      shapes.push_back(n);
+    } else if (arg == "--sweep" && valid) {
+      std::vector<std::string> fields = Split(value, ':');
+      valid = (fields.size() == 3);
+
+      if (valid) {
+        int rank = atoi(fields[0].c_str());
+        int lo = atoi(fields[1].c_str());
+        valid = (rank >= 1) && (rank <= 3) && (lo >= 1);
+        Sweep(rank, lo, atoi(fields[2].c_str()), &shapes);
+      }
+    } else if (arg == "--input" && valid) {
+      valid = ReadShapes(value.c_str(), &shapes);
+    } else if (arg == "--types" && valid) {
+      std::vector<std::string> names = Split(value, ',');
+
+      for (size_t t = 0; t < names.size(); t++) {
+        size_t k = 0;
+
+        while (k < sizeof(kTypes) / sizeof(kTypes[0]) &&
+               names[t] != kTypes[k].name) {
+          k++;
+        }
+
+        valid = valid && (k < sizeof(kTypes) / sizeof(kTypes[0]));
+
+        if (valid) {
+          types.push_back(&kTypes[k]);
+        }
+      }
+    } else if (arg == "--placement" && valid) {
+      std::vector<std::string> names = Split(value, ',');
+
+      for (size_t p = 0; p < names.size(); p++) {
+        valid = valid && (names[p] == "inplace" || names[p] == "outofplace");
+        placements.push_back(names[p] == "inplace");
+      }
+    } else if (arg == "--batch" && valid) {
+      std::vector<std::string> sizes = Split(value, ',');
+
+      for (size_t b = 0; b < sizes.size(); b++) {
+        batches.push_back(atoi(sizes[b].c_str()));
+        valid = valid && (batches.back() > 0);
+      }
+    } else if (arg == "--warmup" && valid) {
+      warmup = atoi(value.c_str());
+    } else if (arg == "--reps" && valid) {
+      reps = atoi(value.c_str());
+      valid = (reps > 0);
+    } else if (arg == "--json" && valid) {
+      jsonPath = argv[i + 1];
+    } else if (arg == "--csv" && valid) {
+      csvPath = argv[i + 1];
+    } else {
+      valid = false;
+    }
+
+    if (!valid) {
+      Usage();
+      return 1;
+    }
+
+    i++;
+  }
+
+  if (shapes.empty()) {
+    Sweep(1, 16, 1 << 20, &shapes);
+    Sweep(2, 32, 2048, &shapes);
+    Sweep(3, 16, 128, &shapes);
+  }
+
+  for (size_t t = 0; types.empty() && t < sizeof(kTypes) / sizeof(kTypes[0]);
+       t++) {
+    types.push_back(&kTypes[t]);
+  }
+
+  if (placements.empty()) {
+    placements.push_back(false);
+    placements.push_back(true);
+  }
+
+  if (batches.empty()) {
+    batches.push_back(1);
+  }
+
+  std::vector<hc::accelerator> accs = hc::accelerator::get_all();
+
+  if (accs.empty()) {
+    fprintf(stderr, "hcfft-bench: no accelerator\n");
+    return 1;
+  }
+
+  // Accelerator 0 is the CPU fallback when a device is present
+  hc::accelerator acc = accs[accs.size() > 1 ? 1 : 0];
+  std::wstring description = acc.get_description();
+  std::string device(description.begin(), description.end());
+  std::vector<BenchResult> results;
+  printf("# %s, %d warmup, %d timed executions\n", device.c_str(), warmup,
+         reps);
+  printf("%-34s %10s %10s %10s %10s %10s %10s\n", "case", "cold ms",
+         "bake ms", "median us", "p90 us", "GFLOP/s", "GB/s");
+
+  for (size_t s = 0; s < shapes.size(); s++) {
+    for (size_t t = 0; t < types.size(); t++) {
+      for (size_t p = 0; p < placements.size(); p++) {
+        for (size_t b = 0; b < batches.size(); b++) {
+          BenchCase bench;
+          bench.n = shapes[s];
+          bench.type = types[t];
+          bench.inplace = placements[p];
+          bench.batch = batches[b];
+          results.push_back(Run(bench, acc, warmup, reps));
+          const BenchResult& r = results.back();
+
+          if (r.status != HCFFT_SUCCESS) {
+            printf("%-34s failed (%d)\n", bench.Key().c_str(), r.status);
+            continue;
+          }
+
+          printf("%-34s %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f\n",
+                 bench.Key().c_str(), r.coldSeconds * 1.0e3,
+                 r.bakeSeconds * 1.0e3, r.Percentile(50) * 1.0e6,
+                 r.Percentile(90) * 1.0e6, r.gflops, r.gbs);
+          fflush(stdout);
+        }
+      }
+    }
+  }
+
+  if (jsonPath && !WriteJson(jsonPath, device, warmup, reps, results)) {
+    fprintf(stderr, "hcfft-bench: cannot write %s\n", jsonPath);
+    return 1;
+  }
+
+  if (csvPath && !WriteCsv(csvPath, results)) {
+    fprintf(stderr, "hcfft-bench: cannot write %s\n", csvPath);
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,381 @@
+/*
+Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+// hcfft-cost: print the static cost of the kernels of a plan
+//
+//   hcfft-cost [options] <c2c|z2z|r2c|c2r|d2z|z2d> n0 [n1 [n2]]
+//   hcfft-cost [options] --suite FILE
+//
+// n0 is the fastest varying axis. The plan is baked but never executed, so
+// with a library built with HCFFT_HOST_EMULATION no GPU is needed, and with
+// HCFFT_KERNEL_BUILD_STUB=1 no compiler either. --explain prints the sub-plan
+// tree of hcfftExplainPlan() instead of the table. --suite costs one plan per
+// line of FILE, each line holding the type, lengths and --batch of a plan,
+// and --json writes the totals of every plan for tools/hcfft_perf_gate.py.
+
+#include "include/hcfft.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static void Usage() {
+  fprintf(stderr,
+          "usage: hcfft-cost [options] <c2c|z2z|r2c|c2r|d2z|z2d> n0 [n1 [n2]]\n"
+          "       hcfft-cost [options] --suite FILE\n"
+          "  --batch N        transforms in the batch (1)\n"
+          "  --explain        print the plan tree as JSON\n"
+          "  --suite FILE     cost the plans of FILE, one per line\n"
+          "  --json FILE      write the totals of the plans as JSON\n"
+          "  --sp-gflops F    fp32 peak of the device\n"
+          "  --dp-gflops F    fp64 peak of the device\n"
+          "  --mem-gbs F      global memory bandwidth\n"
+          "  --lds-gbs F      LDS bandwidth of all compute units\n"
+          "  --launch-us F    fixed cost of a kernel launch\n");
+}
+
+static const char* const kTypeNames[] = {"c2c", "z2z", "r2c",
+                                         "c2r", "d2z", "z2d"};
+static const hcfftType kTypes[] = {HCFFT_C2C, HCFFT_Z2Z, HCFFT_R2C,
+                                   HCFFT_C2R, HCFFT_D2Z, HCFFT_Z2D};
+
+static bool ParseType(const std::string& name, hcfftType* type) {
+  for (size_t i = 0; i < sizeof(kTypes) / sizeof(kTypes[0]); i++) {
+    if (name == kTypeNames[i]) {
+      *type = kTypes[i];
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// One plan to cost
+struct CostCase {
+  std::string name;
+  hcfftType type;
+  std::vector<int> n;
+  int batch;
+
+  CostCase() : type(HCFFT_C2C), batch(1) {}
+
+  // Same key as hcfft-bench, less the placement the plan does not fix
+  std::string Key() const {
+    std::string key = name + "_";
+
+    for (size_t i = 0; i < n.size(); i++) {
+      key += (i == 0 ? "" : "x") + std::to_string(n[i]);
+    }
+
+    return key + "_b" + std::to_string(batch);
+  }
+};
+
+// Parses "type n0 [n1 [n2]]" and --batch out of args; anything else is
+// left for the caller in rest
+static bool ParseCase(const std::vector<std::string>& args, CostCase* plan,
+                      std::vector<std::string>* rest) {
+  bool typeSet = false;
+
+  for (size_t i = 0; i < args.size(); i++) {
+    const std::string& arg = args[i];
+
+    if ((arg == "--batch") && (i + 1 < args.size())) {
+      plan->batch = atoi(args[++i].c_str());
+    } else if (!typeSet && ParseType(arg, &plan->type)) {
+      plan->name = arg;
+      typeSet = true;
+    } else if (typeSet && (atoi(arg.c_str()) > 0)) {
+      plan->n.push_back(atoi(arg.c_str()));
+    } else {
+      rest->push_back(arg);
+    }
+  }
+
+  return typeSet && !plan->n.empty() && (plan->n.size() <= 3) &&
+         (plan->batch >= 1);
+}
+
+static bool ReadSuite(const char* path, std::vector<CostCase>* cases) {
+  std::ifstream file(path);
+  std::string line;
+
+  if (!file) {
+    fprintf(stderr, "hcfft-cost: cannot read %s\n", path);
+    return false;
+  }
+
+  for (int number = 1; std::getline(file, line); number++) {
+    std::istringstream tokens(line.substr(0, line.find('#')));
+    std::vector<std::string> args;
+    std::vector<std::string> rest;
+    std::string token;
+
+    while (tokens >> token) {
+      args.push_back(token);
+    }
+
+    if (args.empty()) {
+      continue;
+    }
+
+    CostCase plan;
+
+    if (!ParseCase(args, &plan, &rest) || !rest.empty()) {
+      fprintf(stderr, "hcfft-cost: %s:%d: invalid plan\n", path, number);
+      return false;
+    }
+
+    cases->push_back(plan);
+  }
+
+  return true;
+}
+
+static hcfftResult CostPlan(const CostCase& plan,
+                            const hcfftDeviceRoofline& device,
+                            std::vector<hcfftKernelCost>* kernels) {
+  hcfftHandle handle;
+  std::vector<int> n = plan.n;
+  hcfftResult status = hcfftPlanNd(&handle, static_cast<int>(n.size()), &n[0],
+                                   NULL, 0, NULL, 0, plan.batch, plan.type);
+
+  if (status != HCFFT_SUCCESS) {
+    return status;
+  }
+
+  int count = 0;
+  status = hcfftGetPlanCostReport(handle, &device, NULL, &count);
+  kernels->resize(count > 0 ? count : 1);
+
+  if (status == HCFFT_SUCCESS) {
+    status = hcfftGetPlanCostReport(handle, &device, &(*kernels)[0], &count);
+  }
+
+  kernels->resize(status == HCFFT_SUCCESS ? count : 0);
+  hcfftDestroy(handle);
+  return status;
+}
+
+static hcfftKernelCost Total(const std::vector<hcfftKernelCost>& kernels) {
+  hcfftKernelCost total;
+  memset(&total, 0, sizeof(total));
+
+  for (size_t k = 0; k < kernels.size(); k++) {
+    total.flops += kernels[k].flops;
+    total.bytesRead += kernels[k].bytesRead;
+    total.bytesWritten += kernels[k].bytesWritten;
+    total.ldsBytes += kernels[k].ldsBytes;
+    total.barriers += kernels[k].barriers;
+    total.seconds += kernels[k].seconds;
+  }
+
+  return total;
+}
+
+static void PrintTable(const std::vector<hcfftKernelCost>& kernels) {
+  printf("%-28s %-14s %10s %12s %12s %12s %12s %4s %4s %10s\n", "kernel",
+         "radices", "work-items", "flops", "read", "written", "lds", "bar",
+         "regs", "us");
+
+  for (size_t k = 0; k < kernels.size(); k++) {
+    const hcfftKernelCost& cost = kernels[k];
+    std::string radices;
+
+    for (int p = 0; (p < 16) && (cost.radices[p] != 0); p++) {
+      radices += (p == 0 ? "" : "x") + std::to_string(cost.radices[p]);
+    }
+
+    printf("%-28s %-14s %10zu %12.0f %12.0f %12.0f %12.0f %4zu %4zu %10.2f\n",
+           cost.name, radices.empty() ? "-" : radices.c_str(), cost.globalSize,
+           cost.flops, cost.bytesRead, cost.bytesWritten, cost.ldsBytes,
+           cost.barriers, cost.registers, cost.seconds * 1.0e6);
+  }
+
+  hcfftKernelCost total = Total(kernels);
+  printf("%-28s %-14s %10s %12.0f %12.0f %12.0f %12.0f %4s %4s %10.2f\n",
+         "total", "", "", total.flops, total.bytesRead, total.bytesWritten,
+         total.ldsBytes, "", "", total.seconds * 1.0e6);
+}
+
+struct CostResult {
+  CostCase plan;
+  hcfftResult status;
+  std::vector<hcfftKernelCost> kernels;
+};
+
+static bool WriteJson(const char* path, const hcfftDeviceRoofline& device,
+                      const std::vector<CostResult>& results) {
+  FILE* file = fopen(path, "w");
+
+  if (file == NULL) {
+    return false;
+  }
+
+  fprintf(file,
+          "{\"benchmark\": \"hcfft-cost\", \"device\": {\"sp_gflops\": %g, "
+          "\"dp_gflops\": %g, \"mem_gbs\": %g, \"lds_gbs\": %g, "
+          "\"launch_us\": %g}, \"cases\": [",
+          device.singleGflops, device.doubleGflops, device.memoryGBs,
+          device.ldsGBs, device.launchUs);
+
+  for (size_t i = 0; i < results.size(); i++) {
+    const CostResult& r = results[i];
+    hcfftKernelCost total = Total(r.kernels);
+    fprintf(file,
+            "%s\n  {\"key\": \"%s\", \"status\": %d, \"kernels\": %zu, "
+            "\"flops\": %.0f, \"bytes_read\": %.0f, \"bytes_written\": %.0f, "
+            "\"lds_bytes\": %.0f, \"barriers\": %zu, \"seconds\": %.9e}",
+            (i == 0) ? "" : ",", r.plan.Key().c_str(),
+            static_cast<int>(r.status), r.kernels.size(), total.flops,
+            total.bytesRead, total.bytesWritten, total.ldsBytes,
+            total.barriers, total.seconds);
+  }
+
+  fprintf(file, "\n]}\n");
+  return fclose(file) == 0;
+}
+
+int main(int argc, char* argv[]) {
+  // gfx900 class defaults, the same the library assumes for a NULL device
+  hcfftDeviceRoofline device = {12288.0, 768.0, 484.0, 12288.0, 5.0};
+  struct {
+    const char* flag;
+    double* value;
+  } rates[] = {{"--sp-gflops", &device.singleGflops},
+               {"--dp-gflops", &device.doubleGflops},
+               {"--mem-gbs", &device.memoryGBs},
+               {"--lds-gbs", &device.ldsGBs},
+               {"--launch-us", &device.launchUs}};
+  bool explain = false;
+  const char* suitePath = NULL;
+  const char* jsonPath = NULL;
+  std::vector<std::string> args;
+
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool matched = false;
+
+    for (size_t r = 0; r < sizeof(rates) / sizeof(rates[0]); r++) {
+      if ((arg == rates[r].flag) && (i + 1 < argc)) {
+        *rates[r].value = atof(argv[++i]);
+        matched = true;
+      }
+    }
+
+    if (matched) {
+      continue;
+    }
+
+    if (arg == "--explain") {
+      explain = true;
+    } else if ((arg == "--suite") && (i + 1 < argc)) {
+      suitePath = argv[++i];
+    } else if ((arg == "--json") && (i + 1 < argc)) {
+      jsonPath = argv[++i];
+    } else {
+      args.push_back(arg);
+    }
+  }
+
+  std::vector<CostCase> cases;
+
+  if (suitePath != NULL) {
+    if (!args.empty() || explain || !ReadSuite(suitePath, &cases)) {
+      Usage();
+      return 1;
+    }
+  } else {
+    CostCase plan;
+    std::vector<std::string> rest;
+
+    if (!ParseCase(args, &plan, &rest) || !rest.empty()) {
+      Usage();
+      return 1;
+    }
+
+    cases.push_back(plan);
+  }
+
+  if (explain) {
+    hcfftHandle plan;
+    std::vector<int> n = cases[0].n;
+    hcfftResult status =
+        hcfftPlanNd(&plan, static_cast<int>(n.size()), &n[0], NULL, 0, NULL, 0,
+                    cases[0].batch, cases[0].type);
+
+    if (status != HCFFT_SUCCESS) {
+      fprintf(stderr, "hcfft-cost: plan creation failed (%d)\n", status);
+      return 1;
+    }
+
+    size_t size = 0;
+    status = hcfftExplainPlan(plan, NULL, &size);
+    std::vector<char> json(size + 1);
+
+    if (status == HCFFT_SUCCESS) {
+      status = hcfftExplainPlan(plan, &json[0], &size);
+    }
+
+    if (status != HCFFT_SUCCESS) {
+      fprintf(stderr, "hcfft-cost: explain failed (%d)\n", status);
+      hcfftDestroy(plan);
+      return 1;
+    }
+
+    printf("%s\n", &json[0]);
+    hcfftDestroy(plan);
+    return 0;
+  }
+
+  std::vector<CostResult> results(cases.size());
+  int failed = 0;
+
+  for (size_t i = 0; i < cases.size(); i++) {
+    CostResult& r = results[i];
+    r.plan = cases[i];
+    r.status = CostPlan(r.plan, device, &r.kernels);
+
+    if (r.status != HCFFT_SUCCESS) {
+      fprintf(stderr, "hcfft-cost: %s: cost report failed (%d)\n",
+              r.plan.Key().c_str(), r.status);
+      failed++;
+      continue;
+    }
+
+    if (cases.size() > 1) {
+      printf("%s%s\n", (i == 0) ? "" : "\n", r.plan.Key().c_str());
+    }
+
+    PrintTable(r.kernels);
+  }
+
+  if ((jsonPath != NULL) && !WriteJson(jsonPath, device, results)) {
+    fprintf(stderr, "hcfft-cost: cannot write %s\n", jsonPath);
+    return 1;
+  }
+
+  return (failed == 0) ? 0 : 1;
+}
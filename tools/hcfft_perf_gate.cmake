@@ -0,0 +1,24 @@
+# Runs a benchmark tool with --json and compares its results to the baseline
+# with hcfft_perf_gate.py, for the regression gates of CTest:
+#
+#   cmake -DTOOL=<tool> [-DTOOL_ARGS="<args>"] -DPYTHON=<python> -DGATE=<script>
+#         [-DGATE_ARGS="<args>"] -DBASELINE=<file or dir> -DCURRENT=<json>
+#         -P hcfft_perf_gate.cmake
+
+separate_arguments(TOOL_ARGS UNIX_COMMAND "${TOOL_ARGS}")
+separate_arguments(GATE_ARGS UNIX_COMMAND "${GATE_ARGS}")
+
+execute_process(COMMAND ${TOOL} ${TOOL_ARGS} --json ${CURRENT}
+                RESULT_VARIABLE TOOL_RESULT
+                OUTPUT_QUIET)
+
+if (NOT TOOL_RESULT EQUAL 0)
+  message(FATAL_ERROR "${TOOL} failed (${TOOL_RESULT})")
+endif()
+
+execute_process(COMMAND ${PYTHON} ${GATE} ${GATE_ARGS} ${BASELINE} ${CURRENT}
+                RESULT_VARIABLE GATE_RESULT)
+
+if (NOT GATE_RESULT EQUAL 0)
+  message(FATAL_ERROR "performance regression against ${BASELINE}")
+endif()
@@ -0,0 +1,257 @@
+#!/usr/bin/env python
+# Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+
+# hcfft_perf_gate.py: compare benchmark results to a committed baseline
+#
+#   hcfft_perf_gate.py [options] BASELINE CURRENT
+#
+# CURRENT is the --json output of hcfft-bench, hcfft-plan-bench or hcfft-cost.
+# BASELINE is a file of the same benchmark, or a directory holding one file
+# per device, BASELINE/<device>/<benchmark>.json, the device being --device,
+# the device string of CURRENT or "default". Cases are matched by key and
+# every metric is lower is better:
+#
+#   - times, the --statistic of the timed runs, regress when they grow by
+#     more than --threshold of the baseline and, where the baseline reports a
+#     deviation, by more than --sigma of it.
+#   - counts (flops, bytes, kernels, allocations) regress when they grow by
+#     more than --count-threshold, exactly by default.
+#
+# A case that failed, or that is in the baseline but not in CURRENT, is a
+# regression as well. The regressed shapes are printed as a table and the
+# exit status is 1; 2 on unreadable input. --update writes CURRENT as the
+# baseline instead of comparing.
+
+from __future__ import print_function
+
+import argparse
+import json
+import os
+import re
+import shutil
+import sys
+
+# (metric, deviation metric or None, is a count) per benchmark; {stat} is
+# the --statistic of the times
+METRICS = {
+    "hcfft-bench": [("steady.{stat}_s", "steady.stddev_s", False)],
+    "hcfft-plan-bench": [("phases.bake.{stat}_s", "phases.bake.stddev_s",
+                          False),
+                         ("phases.bake.allocations", None, True)],
+    "hcfft-cost": [("kernels", None, True),
+                   ("flops", None, True),
+                   ("bytes_read", None, True),
+                   ("bytes_written", None, True),
+                   ("lds_bytes", None, True),
+                   ("barriers", None, True),
+                   ("seconds", None, False)],
+}
+
+
+def Benchmark(results):
+  name = results.get("benchmark")
+
+  # hcfft-bench wrote no benchmark field at first
+  if name is None and "device" in results:
+    name = "hcfft-bench"
+
+  if name not in METRICS:
+    raise ValueError("unknown benchmark %r" % name)
+
+  return name
+
+
+def Device(results, override):
+  if override:
+    return override
+
+  device = results.get("device")
+
+  if not device or isinstance(device, dict):
+    return "default"
+
+  return re.sub(r"[^a-z0-9]+", "-", device.lower()).strip("-")
+
+
+def Lookup(case, path):
+  value = case
+
+  for part in path.split("."):
+    if not isinstance(value, dict) or part not in value:
+      return None
+
+    value = value[part]
+
+  return float(value)
+
+
+def Load(path):
+  with open(path) as f:
+    return json.load(f)
+
+
+def Change(base, current):
+  if base == 0:
+    return "new" if current > 0 else "+0.0%"
+
+  return "%+.1f%%" % (100.0 * (current - base) / base)
+
+
+def Format(value, count):
+  if count:
+    return "%.0f" % value
+
+  return "%.3f us" % (value * 1.0e6)
+
+
+def Compare(baseline, current, args):
+  metrics = [(m[0].format(stat=args.statistic), m[1], m[2])
+             for m in METRICS[Benchmark(current)]]
+
+  if args.metric:
+    names = [m[0] for m in metrics]
+    metrics = [m for m in metrics if m[0] in args.metric]
+    unknown = [m for m in args.metric if m not in names]
+
+    if unknown:
+      raise ValueError("unknown metric %s" % ", ".join(unknown))
+
+  base_cases = dict((c["key"], c) for c in baseline["cases"])
+  current_cases = dict((c["key"], c) for c in current["cases"])
+  regressions = []
+  improved = 0
+
+  for key in sorted(base_cases):
+    base = base_cases[key]
+
+    if key not in current_cases:
+      if not args.allow_missing:
+        regressions.append((key, "missing", "", "", ""))
+
+      continue
+
+    case = current_cases[key]
+
+    if case.get("status", 0) != 0 and base.get("status", 0) == 0:
+      regressions.append((key, "status", "0", str(case["status"]), ""))
+      continue
+
+    for metric, deviation, count in metrics:
+      old = Lookup(base, metric)
+      new = Lookup(case, metric)
+
+      if old is None or new is None:
+        continue
+
+      if count:
+        limit = old * (1.0 + args.count_threshold)
+      else:
+        limit = old * (1.0 + args.threshold)
+        noise = Lookup(base, deviation) if deviation else None
+
+        if noise is not None:
+          limit = max(limit, old + args.sigma * noise)
+
+      if new > limit:
+        regressions.append((key, metric, Format(old, count),
+                            Format(new, count), Change(old, new)))
+      elif new < old:
+        improved += 1
+
+  added = len([k for k in current_cases if k not in base_cases])
+  return regressions, improved, added
+
+
+def PrintTable(rows):
+  header = ("shape", "metric", "baseline", "current", "change")
+  widths = [max(len(r[i]) for r in [header] + rows) for i in range(5)]
+
+  for row in [header] + rows:
+    print("  ".join(row[i].ljust(widths[i]) if i < 2 else
+                    row[i].rjust(widths[i]) for i in range(5)).rstrip())
+
+
+def main():
+  parser = argparse.ArgumentParser(
+      description="Compare hcfft benchmark JSON to a committed baseline.")
+  parser.add_argument("baseline", help="baseline file or directory")
+  parser.add_argument("current", help="--json output of the benchmark")
+  parser.add_argument("--threshold", type=float, default=0.10,
+                      help="relative growth of a time that regresses (0.10)")
+  parser.add_argument("--sigma", type=float, default=3.0,
+                      help="baseline deviations a time must grow by (3)")
+  parser.add_argument("--statistic", choices=["median", "min"],
+                      default="median",
+                      help="statistic of the timed runs compared (median)")
+  parser.add_argument("--count-threshold", type=float, default=0.0,
+                      help="relative growth of a count that regresses (0)")
+  parser.add_argument("--metric", action="append",
+                      help="compare only this metric, repeatable")
+  parser.add_argument("--device", help="device directory of the baseline")
+  parser.add_argument("--allow-missing", action="store_true",
+                      help="ignore baseline cases missing from CURRENT")
+  parser.add_argument("--update", action="store_true",
+                      help="write CURRENT as the baseline")
+  args = parser.parse_args()
+
+  try:
+    current = Load(args.current)
+    benchmark = Benchmark(current)
+    path = args.baseline
+
+    if os.path.isdir(path):
+      path = os.path.join(path, Device(current, args.device),
+                          benchmark + ".json")
+
+    if args.update:
+      if os.path.dirname(path) and not os.path.isdir(os.path.dirname(path)):
+        os.makedirs(os.path.dirname(path))
+
+      shutil.copyfile(args.current, path)
+      print("%s: baseline updated" % path)
+      return 0
+
+    baseline = Load(path)
+
+    if Benchmark(baseline) != benchmark:
+      raise ValueError("%s holds %s results" % (path, Benchmark(baseline)))
+
+    regressions, improved, added = Compare(baseline, current, args)
+  except (IOError, OSError, ValueError, KeyError) as e:
+    print("hcfft_perf_gate: %s" % e, file=sys.stderr)
+    return 2
+
+  print("%s: %d cases against %s: %d regressed, %d new, %d metrics improved" %
+        (benchmark, len(current["cases"]), path,
+         len(set(r[0] for r in regressions)), added, improved))
+
+  if regressions:
+    print("")
+    PrintTable(regressions)
+    print("")
+    print("Rerun with --update to accept the new numbers as the baseline.")
+    return 1
+
+  return 0
+
+
+if __name__ == "__main__":
+  sys.exit(main())
@@ -0,0 +1,450 @@
+/*
+Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+// hcfft-plan-bench: time plan creation and baking on the host
+//
+//   hcfft-plan-bench [options]
+//
+// Cold starts are dominated by host work: the decomposition of the plan into
+// sub-plans and the generation of the kernel sources. This benchmark bakes
+// plans over a matrix of shapes and types with the kernel build stubbed, so
+// no kernel is written, compiled or loaded, and reports per phase the median
+// time and the heap allocations made through operator new:
+//
+//   create     hcfftPlanNd()
+//   decompose  baking less the timed phases below, the planning logic
+//   generate   kernel source generation
+//   twiddles   twiddle table computation and upload
+//   write      hand-off of the generated source
+//   bake       the whole bake
+//   destroy    hcfftDestroy()
+//
+// Twiddles are uploaded to the accelerator, so machines without one run the
+// library built with HCFFT_HOST_EMULATION.
+
+#include "include/hcfft.h"
+#include "include/hcfftlib.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Heap allocations of the process, operator new being replaced below
+static std::atomic<size_t> allocations(0);
+
+void* operator new(size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  void* memory = malloc(size ? size : 1);
+
+  if (memory == NULL) {
+    throw std::bad_alloc();
+  }
+
+  return memory;
+}
+
+void operator delete(void* memory) noexcept { free(memory); }
+
+static size_t Allocations() {
+  return allocations.load(std::memory_order_relaxed);
+}
+
+static void Usage() {
+  fprintf(stderr,
+          "usage: hcfft-plan-bench [options]\n"
+          "  --size N0[xN1[xN2]]     one shape, repeatable\n"
+          "  --types T,...           c2c,z2z,r2c,c2r,d2z,z2d (c2c,r2c,c2r)\n"
+          "  --placement P,...       inplace,outofplace (outofplace)\n"
+          "  --warmup N              untimed bakes per case (1)\n"
+          "  --reps N                timed bakes per case (10)\n"
+          "  --json FILE             write the results as JSON\n");
+}
+
+enum Phase {
+  PHASE_CREATE,
+  PHASE_DECOMPOSE,
+  PHASE_GENERATE,
+  PHASE_TWIDDLES,
+  PHASE_WRITE,
+  PHASE_BAKE,
+  PHASE_DESTROY,
+  PHASES
+};
+
+static const char* kPhaseNames[PHASES] = {"create",   "decompose", "generate",
+                                          "twiddles", "write",     "bake",
+                                          "destroy"};
+
+struct PlanType {
+  const char* name;
+  hcfftType type;
+  hcfftIpLayout iLayout;
+  hcfftOpLayout oLayout;
+};
+
+static const PlanType kTypes[] = {
+    {"c2c", HCFFT_C2C, HCFFT_COMPLEX_INTERLEAVED, HCFFT_COMPLEX_INTERLEAVED},
+    {"z2z", HCFFT_Z2Z, HCFFT_COMPLEX_INTERLEAVED, HCFFT_COMPLEX_INTERLEAVED},
+    {"r2c", HCFFT_R2C, HCFFT_REAL, HCFFT_HERMITIAN_INTERLEAVED},
+    {"c2r", HCFFT_C2R, HCFFT_HERMITIAN_INTERLEAVED, HCFFT_REAL},
+    {"d2z", HCFFT_D2Z, HCFFT_REAL, HCFFT_HERMITIAN_INTERLEAVED},
+    {"z2d", HCFFT_Z2D, HCFFT_HERMITIAN_INTERLEAVED, HCFFT_REAL}};
+
+struct PlanCase {
+  std::vector<int> n;
+  const PlanType* type;
+  bool inplace;
+
+  std::string Key() const {
+    std::string key = std::string(type->name) +
+                      (inplace ? "_inplace_" : "_outofplace_");
+
+    for (size_t i = 0; i < n.size(); i++) {
+      key += (i == 0 ? "" : "x") + std::to_string(n[i]);
+    }
+
+    return key;
+  }
+};
+
+struct PlanResult {
+  PlanCase plan;
+  hcfftStatus status;
+  std::vector<double> seconds[PHASES];  // one per timed bake, sorted
+  size_t allocations[PHASES];           // of the last timed bake
+
+  PlanResult() : status(HCFFT_SUCCEEDS) {
+    for (int p = 0; p < PHASES; p++) {
+      allocations[p] = 0;
+    }
+  }
+
+  double Median(int phase) const {
+    const std::vector<double>& times = seconds[phase];
+    return times.empty() ? 0 : times[(times.size() - 1) / 2];
+  }
+
+  double Min(int phase) const {
+    return seconds[phase].empty() ? 0 : seconds[phase][0];
+  }
+
+  double Deviation(int phase) const {
+    const std::vector<double>& times = seconds[phase];
+    double mean = 0;
+    double sum = 0;
+
+    for (size_t i = 0; i < times.size(); i++) {
+      mean += times[i] / times.size();
+    }
+
+    for (size_t i = 0; i < times.size(); i++) {
+      sum += (times[i] - mean) * (times[i] - mean);
+    }
+
+    return (times.size() < 2) ? 0 : sqrt(sum / (times.size() - 1));
+  }
+};
+
+static double Now() {
+  std::chrono::duration<double> now =
+      std::chrono::steady_clock::now().time_since_epoch();
+  return now.count();
+}
+
+static std::vector<std::string> Split(const std::string& text, char sep) {
+  std::vector<std::string> items;
+  std::stringstream stream(text);
+  std::string item;
+
+  while (std::getline(stream, item, sep)) {
+    if (!item.empty()) {
+      items.push_back(item);
+    }
+  }
+
+  return items;
+}
+
+// Create, bake and destroy one plan, timing each phase and counting its
+// allocations
+static hcfftStatus BakeOnce(const PlanCase& plan, double seconds[PHASES],
+                            size_t allocated[PHASES]) {
+  FFTPlan planner;
+  hcfftHandle handle;
+  size_t allocs = Allocations();
+  double start = Now();
+  hcfftResult result =
+      hcfftPlanNd(&handle, static_cast<int>(plan.n.size()), &plan.n[0], NULL,
+                  0, NULL, 0, 1, plan.type->type);
+  seconds[PHASE_CREATE] = Now() - start;
+  allocated[PHASE_CREATE] = Allocations() - allocs;
+
+  if (result != HCFFT_SUCCESS) {
+    return HCFFT_INVALID;
+  }
+
+  hcfftPlanHandle execHandle;
+  allocs = Allocations();
+  start = Now();
+  hcfftStatus status = planner.hcfftGetExecPlan(
+      handle, plan.inplace ? HCFFT_INPLACE : HCFFT_OUTOFPLACE,
+      plan.type->iLayout, plan.type->oLayout, &execHandle);
+  seconds[PHASE_BAKE] = Now() - start;
+  allocated[PHASE_BAKE] = Allocations() - allocs;
+  FFTBakeTimes times;
+
+  if (status == HCFFT_SUCCEEDS) {
+    status = planner.hcfftGetPlanBakeTimes(handle, &times);
+  }
+
+  struct {
+    Phase phase;
+    FFTBakePhase bakePhase;
+  } timed[] = {{PHASE_GENERATE, BAKE_GENERATE},
+               {PHASE_TWIDDLES, BAKE_TWIDDLES},
+               {PHASE_WRITE, BAKE_WRITE}};
+  seconds[PHASE_DECOMPOSE] = seconds[PHASE_BAKE];
+  allocated[PHASE_DECOMPOSE] = allocated[PHASE_BAKE];
+
+  for (size_t i = 0; i < sizeof(timed) / sizeof(timed[0]); i++) {
+    seconds[timed[i].phase] = times.seconds[timed[i].bakePhase];
+    allocated[timed[i].phase] = times.allocations[timed[i].bakePhase];
+    seconds[PHASE_DECOMPOSE] -= seconds[timed[i].phase];
+    allocated[PHASE_DECOMPOSE] -= allocated[timed[i].phase];
+  }
+
+  allocs = Allocations();
+  start = Now();
+  hcfftDestroy(handle);
+  seconds[PHASE_DESTROY] = Now() - start;
+  allocated[PHASE_DESTROY] = Allocations() - allocs;
+  return status;
+}
+
+static PlanResult Run(const PlanCase& plan, int warmup, int reps) {
+  PlanResult result;
+  result.plan = plan;
+
+  for (int i = 0; (i < warmup + reps) && (result.status == HCFFT_SUCCEEDS);
+       i++) {
+    double seconds[PHASES];
+    size_t allocated[PHASES];
+    result.status = BakeOnce(plan, seconds, allocated);
+
+    for (int p = 0; (i >= warmup) && (p < PHASES); p++) {
+      result.seconds[p].push_back(seconds[p]);
+      result.allocations[p] = allocated[p];
+    }
+  }
+
+  for (int p = 0; p < PHASES; p++) {
+    std::sort(result.seconds[p].begin(), result.seconds[p].end());
+  }
+
+  return result;
+}
+
+static bool WriteJson(const char* path, int warmup, int reps,
+                      const std::vector<PlanResult>& results) {
+  FILE* file = fopen(path, "w");
+
+  if (file == NULL) {
+    return false;
+  }
+
+  fprintf(file,
+          "{\"benchmark\": \"hcfft-plan-bench\", \"warmup\": %d, "
+          "\"reps\": %d, \"cases\": [",
+          warmup, reps);
+
+  for (size_t i = 0; i < results.size(); i++) {
+    const PlanResult& r = results[i];
+    fprintf(file, "%s\n  {\"key\": \"%s\", \"status\": %d, \"phases\": {",
+            (i == 0) ? "" : ",", r.plan.Key().c_str(),
+            static_cast<int>(r.status));
+
+    for (int p = 0; p < PHASES; p++) {
+      fprintf(file,
+              "%s\"%s\": {\"median_s\": %.9f, \"min_s\": %.9f, "
+              "\"stddev_s\": %.9f, \"allocations\": %zu}",
+              (p == 0) ? "" : ", ", kPhaseNames[p], r.Median(p), r.Min(p),
+              r.Deviation(p), r.allocations[p]);
+    }
+
+    fprintf(file, "}}");
+  }
+
+  fprintf(file, "\n]}\n");
+  return fclose(file) == 0;
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<std::vector<int> > shapes;
+  std::vector<const PlanType*> types;
+  std::vector<bool> placements;
+  int warmup = 1;
+  int reps = 10;
+  const char* jsonPath = NULL;
+
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    std::string value = (i + 1 < argc) ? argv[i + 1] : "";
+    bool valid = !value.empty();
+
+    if (arg == "--size" && valid) {
+      std::vector<std::string> axes = Split(value, 'x');
+      std::vector<int> n;
+
+      for (size_t a = 0; a < axes.size(); a++) {
+        n.push_back(atoi(axes[a].c_str()));
+        valid = valid && (n.back() > 0);
+      }
+
+      valid = valid && !n.empty() && (n.size() <= 3);
+      shapes.push_back(n);
+    } else if (arg == "--types" && valid) {
+      std::vector<std::string> names = Split(value, ',');
+
+      for (size_t t = 0; t < names.size(); t++) {
+        size_t k = 0;
+
+        while (k < sizeof(kTypes) / sizeof(kTypes[0]) &&
+               names[t] != kTypes[k].name) {
+          k++;
+        }
+
+        valid = valid && (k < sizeof(kTypes) / sizeof(kTypes[0]));
+
+        if (valid) {
+          types.push_back(&kTypes[k]);
+        }
+      }
+    } else if (arg == "--placement" && valid) {
+      std::vector<std::string> names = Split(value, ',');
+
+      for (size_t p = 0; p < names.size(); p++) {
+        valid = valid && (names[p] == "inplace" || names[p] == "outofplace");
+        placements.push_back(names[p] == "inplace");
+      }
+    } else if (arg == "--warmup" && valid) {
+      warmup = atoi(value.c_str());
+    } else if (arg == "--reps" && valid) {
+      reps = atoi(value.c_str());
+      valid = (reps > 0);
+    } else if (arg == "--json" && valid) {
+      jsonPath = argv[i + 1];
+    } else {
+      valid = false;
+    }
+
+    if (!valid) {
+      Usage();
+      return 1;
+    }
+
+    i++;
+  }
+
+  if (shapes.empty()) {
+    // Single kernel, mixed radix, large 1D and the 2D and 3D decompositions
+    const char* defaults[] = {"64",       "1000",       "4096",
+                              "65536",    "1048576",    "4194304",
+                              "64x64",    "100x60",     "1024x1024",
+                              "2048x64",  "12x10x8",    "64x64x64",
+                              "256x256x256"};
+
+    for (size_t s = 0; s < sizeof(defaults) / sizeof(defaults[0]); s++) {
+      std::vector<std::string> axes = Split(defaults[s], 'x');
+      std::vector<int> n;
+
+      for (size_t a = 0; a < axes.size(); a++) {
+        n.push_back(atoi(axes[a].c_str()));
+      }
+
+      shapes.push_back(n);
+    }
+  }
+
+  if (types.empty()) {
+    types.push_back(&kTypes[0]);
+    types.push_back(&kTypes[2]);
+    types.push_back(&kTypes[3]);
+  }
+
+  if (placements.empty()) {
+    placements.push_back(false);
+  }
+
+  SetKernelBuildStub(true);
+  FFTBakeTimer::SetAllocationCounter(Allocations);
+  std::vector<PlanResult> results;
+  printf("# median us (allocations) of %d bakes after %d warmup\n", reps,
+         warmup);
+  printf("%-32s", "case");
+
+  for (int p = 0; p < PHASES; p++) {
+    printf(" %18s", kPhaseNames[p]);
+  }
+
+  printf("\n");
+
+  for (size_t s = 0; s < shapes.size(); s++) {
+    for (size_t t = 0; t < types.size(); t++) {
+      for (size_t p = 0; p < placements.size(); p++) {
+        PlanCase plan;
+        plan.n = shapes[s];
+        plan.type = types[t];
+        plan.inplace = placements[p];
+        results.push_back(Run(plan, warmup, reps));
+        const PlanResult& r = results.back();
+
+        if (r.status != HCFFT_SUCCEEDS) {
+          printf("%-32s failed (%d)\n", plan.Key().c_str(), r.status);
+          continue;
+        }
+
+        printf("%-32s", plan.Key().c_str());
+
+        for (int phase = 0; phase < PHASES; phase++) {
+          printf(" %10.1f (%5zu)", r.Median(phase) * 1.0e6,
+                 r.allocations[phase]);
+        }
+
+        printf("\n");
+        fflush(stdout);
+      }
+    }
+  }
+
+  if (jsonPath && !WriteJson(jsonPath, warmup, reps, results)) {
+    fprintf(stderr, "hcfft-plan-bench: cannot write %s\n", jsonPath);
+    return 1;
+  }
+
+  return 0;
+}